@@ -0,0 +1,276 @@
+/**
+ * @file audio-resampler.cpp
+ * @brief Implementation of the adaptive-ratio polyphase resampler
+ */
+
+#include "audio-resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(OBSWEBRTC_SIMD_X86)
+#include <immintrin.h>
+#elif defined(OBSWEBRTC_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+/** Filter cutoff relative to Nyquist; the transition band ends just below it */
+constexpr double kCutoff = 0.88;
+
+/** Kaiser window shape; 8 gives about 80 dB of stopband attenuation */
+constexpr double kKaiserBeta = 8.0;
+
+constexpr double kPi = 3.14159265358979323846;
+
+using DotFunction = float (*)(const float*, const float*, size_t);
+
+float dotScalarFrom(const float* a, const float* b, size_t size, size_t i, float sum) {
+    for (; i < size; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+float dotScalar(const float* a, const float* b, size_t size) {
+    return dotScalarFrom(a, b, size, 0, 0.0f);
+}
+
+#if defined(OBSWEBRTC_SIMD_X86)
+
+float horizontalSum(__m128 v) {
+    const __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+float dotSse2(const float* a, const float* b, size_t size) {
+    // Two accumulators hide the add latency
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    return dotScalarFrom(a, b, size, i, horizontalSum(_mm_add_ps(sum0, sum1)));
+}
+
+OBSWEBRTC_TARGET_AVX2
+float dotAvx2(const float* a, const float* b, size_t size) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        sum0 = _mm256_add_ps(sum0,
+                             _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        sum1 = _mm256_add_ps(
+            sum1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    for (; i + 8 <= size; i += 8) {
+        sum0 = _mm256_add_ps(sum0,
+                             _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    const __m256 sum = _mm256_add_ps(sum0, sum1);
+    const __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    return dotScalarFrom(a, b, size, i, horizontalSum(half));
+}
+
+#elif defined(OBSWEBRTC_SIMD_NEON)
+
+float dotNeon(const float* a, const float* b, size_t size) {
+    float32x4_t sum0 = vdupq_n_f32(0.0f);
+    float32x4_t sum1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        sum0 = vmlaq_f32(sum0, vld1q_f32(a + i), vld1q_f32(b + i));
+        sum1 = vmlaq_f32(sum1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    const float32x4_t sum = vaddq_f32(sum0, sum1);
+    float32x2_t pairs = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+    pairs = vpadd_f32(pairs, pairs);
+    return dotScalarFrom(a, b, size, i, vget_lane_f32(pairs, 0));
+}
+
+#endif
+
+DotFunction dotFunctionFor(SimdLevel level) {
+    switch (level) {
+#if defined(OBSWEBRTC_SIMD_X86)
+        case SimdLevel::SSE2:
+            return dotSse2;
+        case SimdLevel::AVX2:
+            return dotAvx2;
+#elif defined(OBSWEBRTC_SIMD_NEON)
+        case SimdLevel::NEON:
+            return dotNeon;
+#endif
+        default:
+            return dotScalar;
+    }
+}
+
+/**
+ * @brief Zeroth-order modified Bessel function of the first kind (power series)
+ */
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50 && term > sum * 1e-12; k++) {
+        const double factor = x / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Windowed sinc at a distance of @p u input samples from the output position
+ */
+double kernel(double u, double halfWidth) {
+    const double window = u / halfWidth;
+    if (window <= -1.0 || window >= 1.0) {
+        return 0.0;
+    }
+    const double x = kCutoff * u;
+    const double sinc = x == 0.0 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+    return kCutoff * sinc * besselI0(kKaiserBeta * std::sqrt(1.0 - window * window)) /
+           besselI0(kKaiserBeta);
+}
+
+}  // namespace
+
+float dotProduct(const float* a, const float* b, size_t size) {
+    static const DotFunction dotFunction = dotFunctionFor(detectSimdLevel());
+    return dotFunction(a, b, size);
+}
+
+float dotProduct(const float* a, const float* b, size_t size, SimdLevel level) {
+    if (!isSimdLevelSupported(level)) {
+        throw std::invalid_argument(std::string("SIMD level not supported: ") +
+                                    simdLevelName(level));
+    }
+    return dotFunctionFor(level)(a, b, size);
+}
+
+AdaptiveResampler::AdaptiveResampler(size_t channels)
+    : channels_(channels)
+    , history_(channels)
+    , coefficients_((constants::kResamplerPhases + 1) * constants::kResamplerTaps)
+    , dot_(dotFunctionFor(detectSimdLevel())) {
+    if (channels == 0) {
+        throw std::invalid_argument("Resampler needs at least one channel");
+    }
+
+    // Row p holds the taps for an output position p / phases past an input
+    // sample; tap j weighs the input sample (halfTaps - 1 - j) + p / phases
+    // before the output position. Each row is normalized to unity DC gain.
+    constexpr size_t taps = constants::kResamplerTaps;
+    constexpr size_t halfTaps = taps / 2;
+    for (size_t phase = 0; phase <= constants::kResamplerPhases; phase++) {
+        const double fraction =
+            static_cast<double>(phase) / static_cast<double>(constants::kResamplerPhases);
+        float* row = coefficients_.data() + phase * taps;
+        double sum = 0.0;
+        for (size_t tap = 0; tap < taps; tap++) {
+            const double u =
+                fraction + static_cast<double>(halfTaps - 1) - static_cast<double>(tap);
+            const double value = kernel(u, static_cast<double>(halfTaps));
+            row[tap] = static_cast<float>(value);
+            sum += value;
+        }
+        for (size_t tap = 0; tap < taps; tap++) {
+            row[tap] = static_cast<float>(row[tap] / sum);
+        }
+    }
+
+    reset();
+}
+
+void AdaptiveResampler::setRatio(double ratio) {
+    if (!(std::fabs(ratio - 1.0) <= constants::kMaxResamplerRatioDeviation)) {
+        throw std::invalid_argument("Resampling ratio out of range: " + std::to_string(ratio));
+    }
+    ratio_ = ratio;
+    step_ = 1.0 / ratio;
+}
+
+size_t AdaptiveResampler::maxOutputFrames(size_t inputFrames) const {
+    const double available = static_cast<double>(buffered_ + inputFrames) - position_;
+    return static_cast<size_t>(std::max(available, 0.0) * ratio_) + 2;
+}
+
+size_t AdaptiveResampler::process(const float* const* input, size_t frames, float* const* output,
+                                  size_t capacity) {
+    constexpr size_t taps = constants::kResamplerTaps;
+    constexpr size_t halfTaps = taps / 2;
+    constexpr double phases = static_cast<double>(constants::kResamplerPhases);
+
+    for (size_t channel = 0; channel < channels_; channel++) {
+        std::vector<float>& history = history_[channel];
+        if (history.size() < buffered_ + frames) {
+            history.resize(buffered_ + frames);
+        }
+        if (frames > 0) {
+            std::memcpy(history.data() + buffered_, input[channel], frames * sizeof(float));
+        }
+    }
+    buffered_ += frames;
+
+    // An output at position t needs the input up to floor(t) + halfTaps
+    size_t produced = 0;
+    while (produced < capacity) {
+        const size_t index = static_cast<size_t>(position_);
+        if (index + halfTaps >= buffered_) {
+            break;
+        }
+
+        const double phase = (position_ - static_cast<double>(index)) * phases;
+        const size_t row = std::min(static_cast<size_t>(phase), constants::kResamplerPhases - 1);
+        const float blend = static_cast<float>(phase - static_cast<double>(row));
+        const float* lower = coefficients_.data() + row * taps;
+        const float* upper = lower + taps;
+        const size_t first = index + 1 - halfTaps;
+
+        for (size_t channel = 0; channel < channels_; channel++) {
+            const float* samples = history_[channel].data() + first;
+            const float a = dot_(samples, lower, taps);
+            const float b = dot_(samples, upper, taps);
+            output[channel][produced] = a + blend * (b - a);
+        }
+        produced++;
+        position_ += step_;
+    }
+
+    // Keep only the history the next output position still reaches back to
+    const size_t consumed = std::min(static_cast<size_t>(position_) + 1 - halfTaps, buffered_);
+    if (consumed > 0) {
+        for (std::vector<float>& history : history_) {
+            std::memmove(history.data(), history.data() + consumed,
+                         (buffered_ - consumed) * sizeof(float));
+        }
+        buffered_ -= consumed;
+        position_ -= static_cast<double>(consumed);
+    }
+    return produced;
+}
+
+void AdaptiveResampler::reset() {
+    // Start with half a filter of silence, so the first output sample lands
+    // on the first input sample
+    constexpr size_t history = constants::kResamplerTaps / 2 - 1;
+    for (std::vector<float>& channel : history_) {
+        channel.assign(std::max(channel.size(), history), 0.0f);
+    }
+    buffered_ = history;
+    position_ = static_cast<double>(history);
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,130 @@
+/**
+ * @file audio-resampler.hpp
+ * @brief Adaptive-ratio audio resampling for clock drift compensation
+ *
+ * This module provides:
+ * - A streaming polyphase resampler for planar float audio whose ratio can
+ *   change between calls without discontinuities, for corrections of a few
+ *   hundred ppm to match a remote clock to the local one
+ * - A SIMD float dot product kernel (SSE2/AVX2/NEON with a scalar fallback)
+ */
+
+#pragma once
+
+#include "constants.hpp"
+#include "simd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Sum of a[i] * b[i]
+ *
+ * Uses the best kernel for this CPU.
+ */
+float dotProduct(const float* a, const float* b, size_t size);
+
+/**
+ * @brief Sum of a[i] * b[i] with a specific kernel
+ *
+ * For tests and benchmarks; production code should use the dispatching overload.
+ * Kernels sum in different orders, so results differ in the last bits.
+ *
+ * @throws std::invalid_argument if the CPU does not support the level
+ */
+float dotProduct(const float* a, const float* b, size_t size, SimdLevel level);
+
+/**
+ * @brief Streaming resampler with a continuously adjustable ratio
+ *
+ * Output samples are taken at input positions 1/ratio apart and interpolated
+ * with a Kaiser-windowed sinc of kResamplerTaps taps. The filter is tabulated
+ * at kResamplerPhases fractional positions, and the two tabulated phases
+ * around each output position are blended linearly, so the ratio is not
+ * restricted to fractions and can change on every call. The cutoff sits
+ * below Nyquist to leave room for the filter's transition band; the ratio is
+ * limited to 1 ± kMaxResamplerRatioDeviation, which keeps aliasing out of
+ * the passband.
+ *
+ * The first output sample lands on the first input sample. Output lags input
+ * by half the filter (kResamplerTaps / 2 samples), which is held back until
+ * the samples after it arrive.
+ *
+ * Buffers grow to the largest chunk seen and are reused, so steady-state
+ * processing does not allocate. Not thread-safe.
+ *
+ * Example usage:
+ * @code
+ * AdaptiveResampler resampler(2);
+ * resampler.setRatio(1.0 - driftPpm * 1e-6);
+ * const size_t frames = resampler.process(input, inputFrames, output,
+ *                                         resampler.maxOutputFrames(inputFrames));
+ * @endcode
+ */
+class AdaptiveResampler {
+public:
+    /**
+     * @brief Construct a resampler at ratio 1
+     * @param channels Number of planes processed together
+     * @throws std::invalid_argument if channels is 0
+     */
+    explicit AdaptiveResampler(size_t channels);
+
+    /**
+     * @brief Set output frames per input frame
+     * @param ratio Ratio for the samples processed from now on
+     * @throws std::invalid_argument if the ratio is outside 1 ± kMaxResamplerRatioDeviation
+     */
+    void setRatio(double ratio);
+
+    /**
+     * @brief Get the current ratio
+     */
+    double getRatio() const { return ratio_; }
+
+    /**
+     * @brief Get the number of planes processed together
+     */
+    size_t getChannels() const { return channels_; }
+
+    /**
+     * @brief Upper bound on the frames process() produces for a chunk at the current ratio
+     */
+    size_t maxOutputFrames(size_t inputFrames) const;
+
+    /**
+     * @brief Resample a chunk
+     * @param input One plane per channel, @p frames samples each
+     * @param frames Input samples per channel
+     * @param output One plane per channel, room for @p capacity samples each
+     * @param capacity Most samples to write per channel; input not consumed
+     *        for lack of room is kept and produced by the next call
+     * @return Samples written per channel
+     */
+    size_t process(const float* const* input, size_t frames, float* const* output,
+                   size_t capacity);
+
+    /**
+     * @brief Drop buffered input, e.g. at a discontinuity; the ratio is kept
+     */
+    void reset();
+
+private:
+    using DotFunction = float (*)(const float*, const float*, size_t);
+
+    size_t channels_;
+    double ratio_ = 1.0;
+    double step_ = 1.0;       // Input samples per output sample
+    double position_ = 0.0;   // Input position of the next output sample, in history_
+    size_t buffered_ = 0;     // Samples per channel in history_
+    std::vector<std::vector<float>> history_;  // Per channel: filter history plus new input
+    std::vector<float> coefficients_;          // (kResamplerPhases + 1) rows of kResamplerTaps
+    DotFunction dot_;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,211 @@
+/**
+ * @file bandwidth-estimator.cpp
+ * @brief Implementation of the send-side bandwidth estimator
+ */
+
+#include "bandwidth-estimator.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+/** How long RTT samples contribute to the baseline (minimum) RTT */
+constexpr int64_t kBaseRttWindowMs = 10000;
+
+/** How long a REMB value stays in force without being refreshed */
+constexpr int64_t kRembTimeoutMs = 5000;
+
+/** Longest gap credited to a single increase step */
+constexpr int64_t kMaxIncreaseStepMs = 1000;
+
+/** Minimum spacing between delay-triggered decreases */
+constexpr int64_t kDelayBackoffIntervalMs = 300;
+
+/** Cap on probing relative to the measured send rate */
+constexpr double kMaxSendRateHeadroom = 1.5;
+
+}  // namespace
+
+BandwidthEstimatorConfig BandwidthEstimatorConfig::fromEncoderConfig(
+    const HardwareEncoderConfig& encoder) {
+    BandwidthEstimatorConfig config;
+    config.startBitrateKbps = encoder.bitrate;
+    config.maxBitrateKbps = std::max(encoder.bitrate, encoder.maxBitrate);
+    config.minBitrateKbps = std::min(constants::kMinVideoBitrateKbps, encoder.bitrate);
+    return config;
+}
+
+/**
+ * @brief Internal implementation of BandwidthEstimator
+ */
+class BandwidthEstimator::Impl {
+public:
+    explicit Impl(const BandwidthEstimatorConfig& config) : config_(config) {
+        if (config_.minBitrateKbps <= 0) {
+            throw std::invalid_argument("Minimum bitrate must be positive");
+        }
+        if (config_.maxBitrateKbps < config_.minBitrateKbps) {
+            throw std::invalid_argument("Maximum bitrate must not be below minimum bitrate");
+        }
+        targetKbps_ = clamp(static_cast<double>(config_.startBitrateKbps));
+    }
+
+    void onPacketSent(size_t bytes, int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sentHistory_.emplace_back(nowMs, bytes);
+        sentBytesInWindow_ += bytes;
+        pruneSendHistory(nowMs);
+    }
+
+    bool onReceiverReport(double fractionLost, int64_t rttMs, int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const double loss = std::min(1.0, std::max(0.0, fractionLost));
+        const int64_t baseRtt = updateBaseRtt(rttMs, nowMs);
+        const double sendRate = sendRateKbps(nowMs);
+        const double reference = sendRate > 0.0 ? sendRate : targetKbps_;
+
+        bool delayOveruse = false;
+        if (rttMs >= 0 && baseRtt >= 0 && rttMs - baseRtt > config_.delayOveruseMs &&
+            nowMs - lastDelayBackoffMs_ >= std::max<int64_t>(kDelayBackoffIntervalMs, rttMs)) {
+            delayOveruse = true;
+            lastDelayBackoffMs_ = nowMs;
+        }
+
+        double target = targetKbps_;
+        if (loss > config_.lossDecreaseThreshold || delayOveruse) {
+            // Back off below what the path actually delivered
+            const double delivered = reference * (1.0 - loss);
+            target = std::min(target, config_.backoffFactor * delivered);
+        } else if (loss < config_.lossIncreaseThreshold && lastReportMs_ >= 0) {
+            const int64_t stepMs =
+                std::min(kMaxIncreaseStepMs, std::max<int64_t>(0, nowMs - lastReportMs_));
+            target *= 1.0 + config_.increasePerSecond * stepMs / 1000.0;
+            if (sendRate > 0.0) {
+                // Don't probe far beyond what the encoder actually produces
+                target = std::min(target, std::max(targetKbps_, kMaxSendRateHeadroom * sendRate));
+            }
+        }
+
+        lastReportMs_ = nowMs;
+        return applyTarget(target, nowMs);
+    }
+
+    bool onRemb(uint64_t bitrateBps, int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rembKbps_ = static_cast<double>(bitrateBps) / 1000.0;
+        lastRembMs_ = nowMs;
+        return applyTarget(targetKbps_, nowMs);
+    }
+
+    int getTargetBitrateKbps() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<int>(targetKbps_);
+    }
+
+    int getSendRateKbps(int64_t nowMs) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<int>(sendRateKbps(nowMs));
+    }
+
+private:
+    double clamp(double kbps) const {
+        return std::min(static_cast<double>(config_.maxBitrateKbps),
+                        std::max(static_cast<double>(config_.minBitrateKbps), kbps));
+    }
+
+    bool applyTarget(double target, int64_t nowMs) {
+        if (lastRembMs_ >= 0 && nowMs - lastRembMs_ <= kRembTimeoutMs) {
+            target = std::min(target, rembKbps_);
+        }
+        target = clamp(target);
+
+        const bool changed = static_cast<int>(target) != static_cast<int>(targetKbps_);
+        targetKbps_ = target;
+        return changed;
+    }
+
+    int64_t updateBaseRtt(int64_t rttMs, int64_t nowMs) {
+        if (rttMs >= 0) {
+            // Monotonic deque: front is the minimum RTT within the window
+            while (!rttHistory_.empty() && rttHistory_.back().second >= rttMs) {
+                rttHistory_.pop_back();
+            }
+            rttHistory_.emplace_back(nowMs, rttMs);
+        }
+        while (!rttHistory_.empty() && nowMs - rttHistory_.front().first > kBaseRttWindowMs) {
+            rttHistory_.pop_front();
+        }
+        return rttHistory_.empty() ? -1 : rttHistory_.front().second;
+    }
+
+    void pruneSendHistory(int64_t nowMs) const {
+        while (!sentHistory_.empty() &&
+               nowMs - sentHistory_.front().first > constants::kSendRateWindowMs) {
+            sentBytesInWindow_ -= sentHistory_.front().second;
+            sentHistory_.pop_front();
+        }
+    }
+
+    double sendRateKbps(int64_t nowMs) const {
+        pruneSendHistory(nowMs);
+        if (sentHistory_.empty()) {
+            return 0.0;
+        }
+        // bytes * 8 / ms = kbps
+        return static_cast<double>(sentBytesInWindow_) * constants::kBitsPerByte /
+               constants::kSendRateWindowMs;
+    }
+
+    BandwidthEstimatorConfig config_;
+    double targetKbps_ = 0.0;
+
+    int64_t lastReportMs_ = -1;
+    int64_t lastDelayBackoffMs_ = -1000000;
+    std::deque<std::pair<int64_t, int64_t>> rttHistory_;  // (time, rtt) increasing rtt
+
+    double rembKbps_ = 0.0;
+    int64_t lastRembMs_ = -1;
+
+    mutable std::deque<std::pair<int64_t, size_t>> sentHistory_;  // (time, bytes)
+    mutable size_t sentBytesInWindow_ = 0;
+
+    mutable std::mutex mutex_;
+};
+
+// BandwidthEstimator implementation
+
+BandwidthEstimator::BandwidthEstimator(const BandwidthEstimatorConfig& config)
+    : impl_(std::make_unique<Impl>(config)) {}
+
+BandwidthEstimator::~BandwidthEstimator() = default;
+
+void BandwidthEstimator::onPacketSent(size_t bytes, int64_t nowMs) {
+    impl_->onPacketSent(bytes, nowMs);
+}
+
+bool BandwidthEstimator::onReceiverReport(double fractionLost, int64_t rttMs, int64_t nowMs) {
+    return impl_->onReceiverReport(fractionLost, rttMs, nowMs);
+}
+
+bool BandwidthEstimator::onRemb(uint64_t bitrateBps, int64_t nowMs) {
+    return impl_->onRemb(bitrateBps, nowMs);
+}
+
+int BandwidthEstimator::getTargetBitrateKbps() const {
+    return impl_->getTargetBitrateKbps();
+}
+
+int BandwidthEstimator::getSendRateKbps(int64_t nowMs) const {
+    return impl_->getSendRateKbps(nowMs);
+}
+
+}  // namespace core
+}  // namespace obswebrtc
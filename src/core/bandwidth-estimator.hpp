@@ -0,0 +1,136 @@
+/**
+ * @file bandwidth-estimator.hpp
+ * @brief Send-side bandwidth estimation from RTCP feedback
+ *
+ * This module provides:
+ * - GCC-style loss-based rate control from RTCP receiver reports
+ * - Delay-based overuse detection from RTT growth over the baseline RTT
+ * - REMB (receiver estimated maximum bitrate) capping
+ * - A target video bitrate clamped to the encoder's configured range
+ */
+
+#pragma once
+
+#include "constants.hpp"
+#include "hardware-encoder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Configuration for BandwidthEstimator
+ */
+struct BandwidthEstimatorConfig {
+    int startBitrateKbps = 2500;
+    int minBitrateKbps = constants::kMinVideoBitrateKbps;
+    int maxBitrateKbps = 5000;
+
+    double lossIncreaseThreshold = 0.02;  // Loss below this probes upward
+    double lossDecreaseThreshold = 0.10;  // Loss above this backs off
+    double increasePerSecond = 0.08;      // Multiplicative increase while probing
+    double backoffFactor = 0.85;          // On overuse: target = factor * delivered rate
+    int delayOveruseMs = 60;              // RTT rise over the baseline that counts as overuse
+
+    /**
+     * @brief Derive bounds from an encoder configuration
+     *
+     * Starts at the encoder bitrate and never exceeds its maxBitrate. The
+     * floor is kMinVideoBitrateKbps (or the encoder bitrate, if lower) so
+     * quality can degrade gracefully on a bad uplink.
+     *
+     * @param encoder Encoder configuration
+     * @return Estimator configuration with start/min/max filled in
+     */
+    static BandwidthEstimatorConfig fromEncoderConfig(const HardwareEncoderConfig& encoder);
+};
+
+/**
+ * @brief Send-side bandwidth estimator
+ *
+ * Combines three signals into a target video bitrate:
+ * - Loss (RTCP RR fraction lost): above lossDecreaseThreshold the target
+ *   drops to backoffFactor times the rate that actually got through, which
+ *   converges in one report interval after a capacity drop; below
+ *   lossIncreaseThreshold the target grows by increasePerSecond.
+ * - Delay: an RTT more than delayOveruseMs above the minimum RTT seen in
+ *   the last few seconds means a queue is building, and is treated like loss.
+ * - REMB: the receiver's estimate caps the target.
+ *
+ * Time is passed in explicitly (milliseconds on any monotonic clock) so the
+ * estimator can be driven by a simulated network. All methods are thread-safe.
+ *
+ * Example usage:
+ * @code
+ * BandwidthEstimator estimator(BandwidthEstimatorConfig::fromEncoderConfig(encoderConfig));
+ *
+ * estimator.onPacketSent(bytes, nowMs);                         // send path
+ * estimator.onReceiverReport(fractionLost, rttMs, nowMs);       // RTCP RR
+ * encoder.setBitrate(estimator.getTargetBitrateKbps());
+ * @endcode
+ */
+class BandwidthEstimator {
+public:
+    /**
+     * @brief Construct an estimator
+     * @param config Estimator configuration
+     * @throws std::invalid_argument if the bitrate bounds are inconsistent
+     */
+    explicit BandwidthEstimator(const BandwidthEstimatorConfig& config);
+
+    /**
+     * @brief Destructor
+     */
+    ~BandwidthEstimator();
+
+    // Delete copy constructor and assignment operator (non-copyable)
+    BandwidthEstimator(const BandwidthEstimator&) = delete;
+    BandwidthEstimator& operator=(const BandwidthEstimator&) = delete;
+
+    /**
+     * @brief Record media bytes put on the wire
+     * @param bytes Bytes sent
+     * @param nowMs Current time in milliseconds
+     */
+    void onPacketSent(size_t bytes, int64_t nowMs);
+
+    /**
+     * @brief Process a receiver report about the video stream
+     * @param fractionLost Fraction of packets lost since the previous report (0..1)
+     * @param rttMs Round-trip time in milliseconds, or -1 if unknown
+     * @param nowMs Current time in milliseconds
+     * @return true if the target bitrate changed
+     */
+    bool onReceiverReport(double fractionLost, int64_t rttMs, int64_t nowMs);
+
+    /**
+     * @brief Process a REMB message
+     * @param bitrateBps Receiver estimated maximum bitrate in bits per second
+     * @param nowMs Current time in milliseconds
+     * @return true if the target bitrate changed
+     */
+    bool onRemb(uint64_t bitrateBps, int64_t nowMs);
+
+    /**
+     * @brief Get the current target video bitrate
+     * @return Target bitrate in kbps, within [minBitrateKbps, maxBitrateKbps]
+     */
+    int getTargetBitrateKbps() const;
+
+    /**
+     * @brief Get the measured send rate
+     * @param nowMs Current time in milliseconds
+     * @return Send rate over the last kSendRateWindowMs in kbps
+     */
+    int getSendRateKbps(int64_t nowMs) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
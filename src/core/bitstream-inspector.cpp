@@ -0,0 +1,585 @@
+/**
+ * @file bitstream-inspector.cpp
+ * @brief Implementation of the keyframe and resolution inspector
+ */
+
+#include "bitstream-inspector.hpp"
+#include "nal-parser.hpp"
+
+#include <cstring>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+constexpr size_t kStartCodeSize = 3;
+
+constexpr uint8_t kH264NalIdr = 5;
+constexpr uint8_t kH264NalSlice = 1;
+constexpr uint8_t kH264NalSps = 7;
+
+constexpr uint8_t kAv1ObuSequenceHeader = 1;
+constexpr uint8_t kAv1ObuFrameHeader = 3;
+constexpr uint8_t kAv1ObuFrame = 6;
+
+/**
+ * @brief MSB-first bit reader, optionally dropping H.264 emulation prevention bytes
+ */
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size, bool emulationPrevention = false)
+        : data_(data), size_(size), emulationPrevention_(emulationPrevention) {}
+
+    bool bit(uint32_t& value) {
+        if (bit_ == 0) {
+            // 00 00 03 in a NAL unit: the 03 only keeps start codes out of the payload
+            if (emulationPrevention_ && zeros_ >= 2 && byte_ < size_ && data_[byte_] == 0x03) {
+                byte_++;
+                zeros_ = 0;
+            }
+            if (byte_ >= size_) {
+                return false;
+            }
+        }
+
+        value = (data_[byte_] >> (7 - bit_)) & 1;
+        if (++bit_ == 8) {
+            zeros_ = data_[byte_] == 0 ? zeros_ + 1 : 0;
+            bit_ = 0;
+            byte_++;
+        }
+        return true;
+    }
+
+    bool bits(int count, uint32_t& value) {
+        value = 0;
+        for (int i = 0; i < count; i++) {
+            uint32_t next;
+            if (!bit(next)) {
+                return false;
+            }
+            value = (value << 1) | next;
+        }
+        return true;
+    }
+
+    bool skip(int count) {
+        uint32_t ignored;
+        for (int i = 0; i < count; i++) {
+            if (!bit(ignored)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Unsigned exp-Golomb, ue(v) */
+    bool ue(uint32_t& value) {
+        int leadingZeros = 0;
+        uint32_t next = 0;
+        while (bit(next) && next == 0) {
+            if (++leadingZeros > 31) {
+                return false;
+            }
+        }
+        if (next != 1) {
+            return false;
+        }
+        uint32_t suffix;
+        if (!bits(leadingZeros, suffix)) {
+            return false;
+        }
+        value = static_cast<uint32_t>((uint64_t(1) << leadingZeros) - 1 + suffix);
+        return true;
+    }
+
+    /** Signed exp-Golomb, se(v) */
+    bool se(int32_t& value) {
+        uint32_t coded;
+        if (!ue(coded)) {
+            return false;
+        }
+        value = (coded & 1) ? static_cast<int32_t>((coded + 1) / 2)
+                            : -static_cast<int32_t>(coded / 2);
+        return true;
+    }
+
+    /** AV1 uvlc() */
+    bool uvlc(uint32_t& value) {
+        int leadingZeros = 0;
+        uint32_t next = 0;
+        while (bit(next) && next == 0) {
+            leadingZeros++;
+        }
+        if (next != 1) {
+            return false;
+        }
+        if (leadingZeros >= 32) {
+            value = 0xFFFFFFFF;
+            return skip(leadingZeros);
+        }
+        uint32_t suffix;
+        if (!bits(leadingZeros, suffix)) {
+            return false;
+        }
+        value = static_cast<uint32_t>((uint64_t(1) << leadingZeros) - 1 + suffix);
+        return true;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    bool emulationPrevention_;
+    size_t byte_ = 0;
+    int bit_ = 0;
+    int zeros_ = 0;
+};
+
+bool skipH264ScalingList(BitReader& reader, int size) {
+    int32_t lastScale = 8;
+    int32_t nextScale = 8;
+    for (int i = 0; i < size; i++) {
+        if (nextScale != 0) {
+            int32_t delta;
+            if (!reader.se(delta)) {
+                return false;
+            }
+            nextScale = (lastScale + delta + 256) % 256;
+        }
+        lastScale = nextScale == 0 ? lastScale : nextScale;
+    }
+    return true;
+}
+
+bool hasH264ChromaSyntax(uint32_t profileIdc) {
+    switch (profileIdc) {
+        case 100: case 110: case 122: case 244: case 44:
+        case 83: case 86: case 118: case 128: case 138:
+        case 139: case 134: case 135:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief VP8 frame tag and keyframe header (RFC 6386, 9.1)
+ */
+bool parseVp8Header(const uint8_t* data, size_t size, bool& keyframe, uint32_t& width,
+                    uint32_t& height) {
+    if (size < 3) {
+        return false;
+    }
+    keyframe = (data[0] & 0x01) == 0;
+    if (!keyframe) {
+        return true;
+    }
+    if (size < 10 || data[3] != 0x9D || data[4] != 0x01 || data[5] != 0x2A) {
+        return false;
+    }
+    width = (data[6] | (data[7] << 8)) & 0x3FFF;
+    height = (data[8] | (data[9] << 8)) & 0x3FFF;
+    return width != 0 && height != 0;
+}
+
+/**
+ * @brief VP9 uncompressed header up to frame_size() (VP9 bitstream spec, 6.2)
+ */
+bool parseVp9Header(const uint8_t* data, size_t size, bool& keyframe, uint32_t& width,
+                    uint32_t& height) {
+    BitReader reader(data, size);
+    uint32_t frameMarker, profileLow, profileHigh, value;
+    if (!reader.bits(2, frameMarker) || frameMarker != 2 || !reader.bits(1, profileLow) ||
+        !reader.bits(1, profileHigh)) {
+        return false;
+    }
+    const uint32_t profile = (profileHigh << 1) | profileLow;
+    if (profile == 3 && !reader.skip(1)) {  // reserved_zero
+        return false;
+    }
+    keyframe = false;
+    if (!reader.bits(1, value)) {  // show_existing_frame
+        return false;
+    }
+    if (value == 1) {
+        return true;
+    }
+    if (!reader.bits(1, value)) {  // frame_type: 0 = KEY_FRAME
+        return false;
+    }
+    keyframe = value == 0;
+    if (!keyframe) {
+        return true;
+    }
+
+    uint32_t syncCode, colorSpace;
+    if (!reader.skip(2) ||  // show_frame, error_resilient_mode
+        !reader.bits(24, syncCode) || syncCode != 0x498342) {
+        return false;
+    }
+    if (profile >= 2 && !reader.skip(1)) {  // ten_or_twelve_bit
+        return false;
+    }
+    if (!reader.bits(3, colorSpace)) {
+        return false;
+    }
+    const bool extraChromaBits = profile == 1 || profile == 3;
+    if (colorSpace != 7) {  // Not CS_RGB: color_range, then subsampling_x/y + reserved
+        if (!reader.skip(1) || (extraChromaBits && !reader.skip(3))) {
+            return false;
+        }
+    } else if (extraChromaBits && !reader.skip(1)) {
+        return false;
+    }
+
+    uint32_t widthMinus1, heightMinus1;
+    if (!reader.bits(16, widthMinus1) || !reader.bits(16, heightMinus1)) {
+        return false;
+    }
+    width = widthMinus1 + 1;
+    height = heightMinus1 + 1;
+    return true;
+}
+
+/**
+ * @brief AV1 sequence_header_obu() up to max_frame_height_minus_1 (AV1 spec, 5.5)
+ */
+bool parseAv1SequenceHeader(const uint8_t* data, size_t size, bool& reducedStillPicture,
+                            uint32_t& width, uint32_t& height) {
+    BitReader reader(data, size);
+    uint32_t value;
+    if (!reader.skip(4) ||  // seq_profile, still_picture
+        !reader.bits(1, value)) {
+        return false;
+    }
+    reducedStillPicture = value == 1;
+
+    if (reducedStillPicture) {
+        if (!reader.skip(5)) {  // seq_level_idx[0]
+            return false;
+        }
+    } else {
+        uint32_t timingInfoPresent, decoderModelInfoPresent = 0, bufferDelayLengthMinus1 = 0;
+        if (!reader.bits(1, timingInfoPresent)) {
+            return false;
+        }
+        if (timingInfoPresent) {
+            uint32_t equalPictureInterval;
+            if (!reader.skip(64) ||  // num_units_in_display_tick, time_scale
+                !reader.bits(1, equalPictureInterval) ||
+                (equalPictureInterval && !reader.uvlc(value)) ||
+                !reader.bits(1, decoderModelInfoPresent)) {
+                return false;
+            }
+            if (decoderModelInfoPresent &&
+                (!reader.bits(5, bufferDelayLengthMinus1) ||
+                 !reader.skip(32 + 5 + 5))) {  // decoding tick, removal/presentation time lengths
+                return false;
+            }
+        }
+
+        uint32_t initialDisplayDelayPresent, operatingPointsMinus1;
+        if (!reader.bits(1, initialDisplayDelayPresent) || !reader.bits(5, operatingPointsMinus1)) {
+            return false;
+        }
+        for (uint32_t i = 0; i <= operatingPointsMinus1; i++) {
+            uint32_t levelIdx;
+            if (!reader.skip(12) ||  // operating_point_idc
+                !reader.bits(5, levelIdx) || (levelIdx > 7 && !reader.skip(1))) {  // seq_tier
+                return false;
+            }
+            if (decoderModelInfoPresent) {
+                if (!reader.bits(1, value)) {  // decoder_model_present_for_this_op
+                    return false;
+                }
+                const int delayBits = static_cast<int>(bufferDelayLengthMinus1) + 1;
+                if (value && !reader.skip(2 * delayBits + 1)) {  // operating_parameters_info()
+                    return false;
+                }
+            }
+            if (initialDisplayDelayPresent) {
+                if (!reader.bits(1, value) || (value && !reader.skip(4))) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    uint32_t widthBitsMinus1, heightBitsMinus1, widthMinus1, heightMinus1;
+    if (!reader.bits(4, widthBitsMinus1) || !reader.bits(4, heightBitsMinus1) ||
+        !reader.bits(static_cast<int>(widthBitsMinus1) + 1, widthMinus1) ||
+        !reader.bits(static_cast<int>(heightBitsMinus1) + 1, heightMinus1)) {
+        return false;
+    }
+    width = widthMinus1 + 1;
+    height = heightMinus1 + 1;
+    return true;
+}
+
+/**
+ * @brief Whether an AV1 frame header starts a key frame (AV1 spec, 5.9.2)
+ */
+bool isAv1KeyFrameHeader(const uint8_t* data, size_t size, bool reducedStillPicture) {
+    if (reducedStillPicture) {
+        return true;
+    }
+    BitReader reader(data, size);
+    uint32_t showExistingFrame, frameType;
+    return reader.bits(1, showExistingFrame) && showExistingFrame == 0 &&
+           reader.bits(2, frameType) && frameType == 0;  // KEY_FRAME
+}
+
+bool readLeb128(const uint8_t* data, size_t size, size_t& offset, uint64_t& value) {
+    value = 0;
+    for (int i = 0; i < 8; i++) {
+        if (offset >= size) {
+            return false;
+        }
+        const uint8_t byte = data[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+bool parseH264SpsResolution(const uint8_t* nal, size_t size, uint32_t& width, uint32_t& height) {
+    if (size < 4 || (nal[0] & 0x1F) != kH264NalSps) {
+        return false;
+    }
+
+    BitReader reader(nal + 1, size - 1, true);
+    uint32_t profileIdc, value;
+    if (!reader.bits(8, profileIdc) || !reader.skip(16) ||  // constraint flags, level_idc
+        !reader.ue(value)) {                                 // seq_parameter_set_id
+        return false;
+    }
+
+    uint32_t chromaFormatIdc = 1;
+    uint32_t separateColourPlane = 0;
+    if (hasH264ChromaSyntax(profileIdc)) {
+        if (!reader.ue(chromaFormatIdc) || chromaFormatIdc > 3 ||
+            (chromaFormatIdc == 3 && !reader.bits(1, separateColourPlane)) ||
+            !reader.ue(value) || !reader.ue(value) ||  // bit_depth_luma/chroma_minus8
+            !reader.skip(1) ||                          // qpprime_y_zero_transform_bypass_flag
+            !reader.bits(1, value)) {                   // seq_scaling_matrix_present_flag
+            return false;
+        }
+        if (value) {
+            const int lists = chromaFormatIdc == 3 ? 12 : 8;
+            for (int i = 0; i < lists; i++) {
+                uint32_t present;
+                if (!reader.bits(1, present) ||
+                    (present && !skipH264ScalingList(reader, i < 6 ? 16 : 64))) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    uint32_t pocType;
+    if (!reader.ue(value) ||  // log2_max_frame_num_minus4
+        !reader.ue(pocType)) {
+        return false;
+    }
+    if (pocType == 0) {
+        if (!reader.ue(value)) {  // log2_max_pic_order_cnt_lsb_minus4
+            return false;
+        }
+    } else if (pocType == 1) {
+        int32_t offset;
+        uint32_t cycle;
+        if (!reader.skip(1) || !reader.se(offset) || !reader.se(offset) || !reader.ue(cycle) ||
+            cycle > 255) {
+            return false;
+        }
+        for (uint32_t i = 0; i < cycle; i++) {
+            if (!reader.se(offset)) {
+                return false;
+            }
+        }
+    }
+
+    uint32_t widthInMbsMinus1, heightInMapUnitsMinus1, frameMbsOnly, cropping;
+    if (!reader.ue(value) || !reader.skip(1) ||  // max_num_ref_frames, gaps_in_frame_num
+        !reader.ue(widthInMbsMinus1) || !reader.ue(heightInMapUnitsMinus1) ||
+        !reader.bits(1, frameMbsOnly) || (!frameMbsOnly && !reader.skip(1)) ||
+        !reader.skip(1) ||  // direct_8x8_inference_flag
+        !reader.bits(1, cropping)) {
+        return false;
+    }
+
+    uint32_t cropLeft = 0, cropRight = 0, cropTop = 0, cropBottom = 0;
+    if (cropping && (!reader.ue(cropLeft) || !reader.ue(cropRight) || !reader.ue(cropTop) ||
+                     !reader.ue(cropBottom))) {
+        return false;
+    }
+
+    // Crop offsets count chroma samples (and field pairs when interlaced)
+    const bool chroma = chromaFormatIdc != 0 && !separateColourPlane;
+    const uint64_t cropUnitX = chroma && chromaFormatIdc < 3 ? 2 : 1;
+    const uint64_t cropUnitY = (chroma && chromaFormatIdc == 1 ? 2 : 1) * (2 - frameMbsOnly);
+
+    const uint64_t codedWidth = (uint64_t(widthInMbsMinus1) + 1) * 16;
+    const uint64_t codedHeight = (uint64_t(heightInMapUnitsMinus1) + 1) * 16 * (2 - frameMbsOnly);
+    const uint64_t cropX = cropUnitX * (uint64_t(cropLeft) + cropRight);
+    const uint64_t cropY = cropUnitY * (uint64_t(cropTop) + cropBottom);
+    if (cropX >= codedWidth || cropY >= codedHeight || codedWidth > 0xFFFF ||
+        codedHeight > 0xFFFF) {
+        return false;
+    }
+
+    width = static_cast<uint32_t>(codedWidth - cropX);
+    height = static_cast<uint32_t>(codedHeight - cropY);
+    return true;
+}
+
+BitstreamInspector::BitstreamInspector(BitstreamCodec codec) : codec_(codec) {}
+
+BitstreamFrameInfo BitstreamInspector::inspect(const uint8_t* data, size_t size) {
+    stats_.framesInspected++;
+
+    BitstreamFrameInfo info;
+    switch (codec_) {
+        case BitstreamCodec::H264:
+            inspectH264(data, size, info);
+            break;
+        case BitstreamCodec::VP8:
+            inspectVp8(data, size, info);
+            break;
+        case BitstreamCodec::VP9:
+            inspectVp9(data, size, info);
+            break;
+        case BitstreamCodec::AV1:
+            inspectAv1(data, size, info);
+            break;
+    }
+
+    info.width = width_;
+    info.height = height_;
+    return info;
+}
+
+void BitstreamInspector::reset() {
+    width_ = 0;
+    height_ = 0;
+    parameterSet_.clear();
+    av1ReducedStillPicture_ = false;
+}
+
+void BitstreamInspector::inspectH264(const uint8_t* data, size_t size, BitstreamFrameInfo& info) {
+    if (!data) {
+        return;
+    }
+
+    // Parameter sets precede the first slice, which decides the frame type, so
+    // the scan stops there instead of walking the whole access unit
+    size_t pos = findAnnexBStartCode(data, size);
+    while (pos + kStartCodeSize < size) {
+        const size_t begin = pos + kStartCodeSize;
+        const uint8_t type = data[begin] & 0x1F;
+        if (type == kH264NalIdr || type == kH264NalSlice) {
+            info.keyframe = type == kH264NalIdr;
+            return;
+        }
+
+        const size_t next = begin + findAnnexBStartCode(data + begin, size - begin);
+        if (type == kH264NalSps) {
+            // Drop trailing_zero_8bits and the leading zero of a 4-byte start code
+            size_t end = next;
+            while (end > begin && data[end - 1] == 0) {
+                end--;
+            }
+            if (parameterSetChanged(data + begin, end - begin)) {
+                uint32_t width = 0, height = 0;
+                const bool parsed =
+                    parseH264SpsResolution(data + begin, end - begin, width, height);
+                setResolution(parsed, width, height);
+            }
+        }
+        pos = next;
+    }
+}
+
+void BitstreamInspector::inspectVp8(const uint8_t* data, size_t size, BitstreamFrameInfo& info) {
+    uint32_t width = 0, height = 0;
+    const bool parsed = parseVp8Header(data, size, info.keyframe, width, height);
+    if (info.keyframe || !parsed) {
+        setResolution(parsed, width, height);
+    }
+}
+
+void BitstreamInspector::inspectVp9(const uint8_t* data, size_t size, BitstreamFrameInfo& info) {
+    uint32_t width = 0, height = 0;
+    const bool parsed = parseVp9Header(data, size, info.keyframe, width, height);
+    if (info.keyframe || !parsed) {
+        setResolution(parsed, width, height);
+    }
+}
+
+void BitstreamInspector::inspectAv1(const uint8_t* data, size_t size, BitstreamFrameInfo& info) {
+    size_t offset = 0;
+    while (offset < size) {
+        const uint8_t header = data[offset++];
+        const uint8_t type = (header >> 3) & 0x0F;
+        if (header & 0x04) {
+            offset++;  // obu_extension_header
+        }
+
+        uint64_t obuSize = 0;
+        if (header & 0x02) {
+            if (!readLeb128(data, size, offset, obuSize)) {
+                stats_.headerErrors++;
+                return;
+            }
+        } else {
+            obuSize = offset < size ? size - offset : 0;
+        }
+        if (offset > size || obuSize > size - offset) {
+            stats_.headerErrors++;
+            return;
+        }
+
+        const uint8_t* obu = data + offset;
+        const size_t obuBytes = static_cast<size_t>(obuSize);
+        if (type == kAv1ObuSequenceHeader && parameterSetChanged(obu, obuBytes)) {
+            uint32_t width = 0, height = 0;
+            const bool parsed =
+                parseAv1SequenceHeader(obu, obuBytes, av1ReducedStillPicture_, width, height);
+            setResolution(parsed, width, height);
+        } else if (type == kAv1ObuFrameHeader || type == kAv1ObuFrame) {
+            info.keyframe = isAv1KeyFrameHeader(obu, obuBytes, av1ReducedStillPicture_);
+            return;
+        }
+        offset += obuBytes;
+    }
+}
+
+bool BitstreamInspector::parameterSetChanged(const uint8_t* data, size_t size) {
+    if (parameterSet_.size() == size &&
+        (size == 0 || std::memcmp(parameterSet_.data(), data, size) == 0)) {
+        stats_.headersCached++;
+        return false;
+    }
+    parameterSet_.assign(data, data + size);
+    return true;
+}
+
+void BitstreamInspector::setResolution(bool parsed, uint32_t width, uint32_t height) {
+    if (!parsed) {
+        // Parse it again next time rather than trusting the cache
+        parameterSet_.clear();
+        stats_.headerErrors++;
+        return;
+    }
+    width_ = width;
+    height_ = height;
+    stats_.headersParsed++;
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,136 @@
+/**
+ * @file bitstream-inspector.hpp
+ * @brief Keyframe flag and resolution of received video without decoding
+ *
+ * This module provides:
+ * - An H.264 SPS parser (exp-Golomb, high profiles, cropping) for the coded
+ *   picture size
+ * - VP8 and VP9 frame header and AV1 sequence/frame header parsers for the
+ *   keyframe flag and frame size
+ * - A per-stream inspector that caches the last parameter set, so only
+ *   frames that change it are parsed again
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Video bitstream formats the inspector understands
+ */
+enum class BitstreamCodec {
+    H264,  ///< Annex-B access units
+    VP8,   ///< One frame (RFC 6386)
+    VP9,   ///< One frame or superframe
+    AV1    ///< Temporal unit of OBUs with obu_has_size_field (low overhead format)
+};
+
+/**
+ * @brief What the inspector learned about one frame
+ */
+struct BitstreamFrameInfo {
+    bool keyframe = false;
+    uint32_t width = 0;   // Of the last parameter set or keyframe seen; 0 until then
+    uint32_t height = 0;
+};
+
+/**
+ * @brief Counters for a BitstreamInspector
+ */
+struct BitstreamInspectorStats {
+    uint64_t framesInspected = 0;
+    uint64_t headersParsed = 0;   // Parameter sets / keyframe headers actually parsed
+    uint64_t headersCached = 0;   // Parameter sets skipped because they were unchanged
+    uint64_t headerErrors = 0;    // Headers that could not be parsed
+};
+
+/**
+ * @brief Picture size from an H.264 sequence parameter set
+ *
+ * Handles every profile's SPS syntax (chroma format, scaling lists, picture
+ * order count types), interlaced coding and frame cropping.
+ *
+ * @param nal SPS NAL unit, header byte included, with emulation prevention bytes
+ * @param size Size in bytes
+ * @param width Receives the cropped width in pixels
+ * @param height Receives the cropped height in pixels
+ * @return false if the SPS is truncated or malformed
+ */
+bool parseH264SpsResolution(const uint8_t* nal, size_t size, uint32_t& width, uint32_t& height);
+
+/**
+ * @brief Reads the keyframe flag and resolution of one stream's frames
+ *
+ * H.264 keyframes are access units with an IDR slice, and the size comes
+ * from the SPS. VP8 and VP9 carry the size in keyframe headers. AV1 carries
+ * it in the sequence header and the keyframe flag in the frame header. Only
+ * headers are read, at most the first few dozen bytes of a frame. An SPS or
+ * AV1 sequence header identical to the previous one is recognised by a byte
+ * compare and not parsed again. Keep one inspector per received stream
+ * (SSRC).
+ *
+ * Not thread-safe: meant to be driven by the thread that receives the stream.
+ *
+ * Example usage:
+ * @code
+ * BitstreamInspector inspector(BitstreamCodec::H264);
+ * BitstreamFrameInfo info = inspector.inspect(accessUnit.data(), accessUnit.size());
+ * frame.keyframe = info.keyframe;
+ * frame.width = info.width;
+ * frame.height = info.height;
+ * @endcode
+ */
+class BitstreamInspector {
+public:
+    /**
+     * @brief Construct an inspector for one stream
+     * @param codec Bitstream format of the stream
+     */
+    explicit BitstreamInspector(BitstreamCodec codec);
+
+    /**
+     * @brief Inspect one frame
+     * @param data Frame in the codec's format (see BitstreamCodec)
+     * @param size Size in bytes
+     * @return Keyframe flag and the stream's current resolution
+     */
+    BitstreamFrameInfo inspect(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Get parse counters
+     */
+    BitstreamInspectorStats getStats() const { return stats_; }
+
+    /**
+     * @brief Forget the cached parameter set and resolution (e.g. on a new stream)
+     */
+    void reset();
+
+private:
+    void inspectH264(const uint8_t* data, size_t size, BitstreamFrameInfo& info);
+    void inspectVp8(const uint8_t* data, size_t size, BitstreamFrameInfo& info);
+    void inspectVp9(const uint8_t* data, size_t size, BitstreamFrameInfo& info);
+    void inspectAv1(const uint8_t* data, size_t size, BitstreamFrameInfo& info);
+
+    /**
+     * @brief Whether a parameter set differs from the cached one (and cache it)
+     */
+    bool parameterSetChanged(const uint8_t* data, size_t size);
+
+    void setResolution(bool parsed, uint32_t width, uint32_t height);
+
+    BitstreamCodec codec_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    std::vector<uint8_t> parameterSet_;   // Last SPS / AV1 sequence header
+    bool av1ReducedStillPicture_ = false;  // From the cached sequence header
+    BitstreamInspectorStats stats_;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
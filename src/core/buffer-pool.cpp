@@ -0,0 +1,298 @@
+/**
+ * @file buffer-pool.cpp
+ * @brief Implementation of pooled, refcounted receive buffers
+ */
+
+#include "buffer-pool.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Header in front of every buffer's bytes, in the same allocation
+ */
+struct alignas(16) BufferSlice::Block {
+    std::atomic<size_t> refs{1};
+    BufferPool::State* pool = nullptr;  // Null for unpooled buffers
+    size_t capacity = 0;
+    size_t sizeClass = 0;
+
+    uint8_t* bytes() { return reinterpret_cast<uint8_t*>(this + 1); }
+};
+
+/**
+ * @brief Pool state, kept alive by the pool and by every buffer it handed out
+ */
+struct BufferPool::State {
+    explicit State(const BufferPoolConfig& poolConfig) : config(poolConfig) {}
+
+    BufferPoolConfig config;
+    std::atomic<size_t> refs{1};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> reuses{0};
+
+    std::mutex mutex;
+    bool open = true;  // False once the BufferPool is destroyed
+    std::vector<std::vector<BufferSlice::Block*>> freeLists;  // Per size class, preallocated
+    size_t freeBuffers = 0;
+};
+
+namespace {
+
+using Block = BufferSlice::Block;
+
+Block* allocateBlock(BufferPool::State* pool, size_t capacity, size_t sizeClass) {
+    void* memory = ::operator new(sizeof(Block) + capacity);
+    Block* block = new (memory) Block();
+    block->pool = pool;
+    block->capacity = capacity;
+    block->sizeClass = sizeClass;
+    return block;
+}
+
+void freeBlock(Block* block) {
+    block->~Block();
+    ::operator delete(static_cast<void*>(block));
+}
+
+void unrefState(BufferPool::State* state) {
+    if (state->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete state;
+    }
+}
+
+/**
+ * @brief Return a buffer whose last reference is gone
+ */
+void recycleBlock(Block* block) {
+    BufferPool::State* pool = block->pool;
+    if (!pool) {
+        freeBlock(block);
+        return;
+    }
+
+    bool kept = false;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        auto& freeList = pool->freeLists[block->sizeClass];
+        if (pool->open && freeList.size() < pool->config.maxFreeBuffers) {
+            freeList.push_back(block);
+            pool->freeBuffers++;
+            kept = true;
+        }
+    }
+    if (!kept) {
+        freeBlock(block);
+    }
+    unrefState(pool);
+}
+
+}  // namespace
+
+// BufferSlice implementation
+
+BufferSlice::BufferSlice(const BufferSlice& other) noexcept
+    : block_(other.block_), data_(other.data_), size_(other.size_) {
+    if (block_) {
+        block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+BufferSlice::BufferSlice(BufferSlice&& other) noexcept
+    : block_(std::exchange(other.block_, nullptr)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+BufferSlice& BufferSlice::operator=(const BufferSlice& other) noexcept {
+    if (this != &other) {
+        BufferSlice copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+BufferSlice& BufferSlice::operator=(BufferSlice&& other) noexcept {
+    if (this != &other) {
+        release();
+        block_ = std::exchange(other.block_, nullptr);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+BufferSlice::~BufferSlice() {
+    release();
+}
+
+void BufferSlice::release() noexcept {
+    if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        recycleBlock(block_);
+    }
+    block_ = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+}
+
+BufferSlice BufferSlice::copyOf(const uint8_t* data, size_t size) {
+    if (!data || size == 0) {
+        return BufferSlice();
+    }
+    Block* block = allocateBlock(nullptr, size, 0);
+    std::memcpy(block->bytes(), data, size);
+    return BufferSlice(block, block->bytes(), size);
+}
+
+BufferSlice BufferSlice::subslice(size_t offset, size_t size) const {
+    if (offset > size_ || size > size_ - offset) {
+        throw std::out_of_range("Slice range exceeds the buffer");
+    }
+    if (size == 0) {
+        return BufferSlice();
+    }
+    BufferSlice slice(*this);
+    slice.data_ += offset;
+    slice.size_ = size;
+    return slice;
+}
+
+size_t BufferSlice::useCount() const {
+    return block_ ? block_->refs.load(std::memory_order_relaxed) : 0;
+}
+
+// PooledBuffer implementation
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept
+    : block_(std::exchange(other.block_, nullptr)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept {
+    if (this != &other) {
+        BufferSlice(block_, data_, size_).release();
+        block_ = std::exchange(other.block_, nullptr);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+PooledBuffer::~PooledBuffer() {
+    BufferSlice(block_, data_, size_).release();
+}
+
+void PooledBuffer::truncate(size_t size) {
+    if (size > size_) {
+        throw std::out_of_range("Cannot grow a pooled buffer");
+    }
+    size_ = size;
+}
+
+BufferSlice PooledBuffer::share() && {
+    BufferSlice slice(block_, data_, size_);
+    block_ = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+    return slice;
+}
+
+// BufferPool implementation
+
+BufferPool::BufferPool(const BufferPoolConfig& config) : state_(nullptr) {
+    if (config.minBufferSize == 0 || config.minBufferSize > config.maxBufferSize) {
+        throw std::invalid_argument("Buffer pool sizes must satisfy 0 < min <= max");
+    }
+
+    state_ = new State(config);
+    size_t classes = 1;
+    for (size_t capacity = config.minBufferSize; capacity < config.maxBufferSize; capacity <<= 1) {
+        classes++;
+    }
+    state_->freeLists.resize(classes);
+    for (auto& freeList : state_->freeLists) {
+        freeList.reserve(config.maxFreeBuffers);  // Recycling never allocates
+    }
+}
+
+BufferPool::~BufferPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->open = false;
+        for (auto& freeList : state_->freeLists) {
+            for (Block* block : freeList) {
+                freeBlock(block);
+            }
+            freeList.clear();
+        }
+        state_->freeBuffers = 0;
+    }
+    unrefState(state_);
+}
+
+PooledBuffer BufferPool::acquire(size_t size) {
+    if (size == 0) {
+        return PooledBuffer();
+    }
+
+    if (size > state_->config.maxBufferSize) {
+        state_->allocations.fetch_add(1, std::memory_order_relaxed);
+        Block* block = allocateBlock(nullptr, size, 0);
+        return PooledBuffer(block, block->bytes(), size);
+    }
+
+    size_t sizeClass = 0;
+    size_t capacity = state_->config.minBufferSize;
+    while (capacity < size) {
+        capacity <<= 1;
+        sizeClass++;
+    }
+
+    Block* block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        auto& freeList = state_->freeLists[sizeClass];
+        if (!freeList.empty()) {
+            block = freeList.back();
+            freeList.pop_back();
+            state_->freeBuffers--;
+        }
+    }
+
+    if (block) {
+        state_->reuses.fetch_add(1, std::memory_order_relaxed);
+        block->refs.store(1, std::memory_order_relaxed);
+    } else {
+        state_->allocations.fetch_add(1, std::memory_order_relaxed);
+        block = allocateBlock(state_, capacity, sizeClass);
+    }
+    state_->refs.fetch_add(1, std::memory_order_relaxed);
+    return PooledBuffer(block, block->bytes(), size);
+}
+
+BufferSlice BufferPool::copy(const uint8_t* data, size_t size) {
+    if (!data || size == 0) {
+        return BufferSlice();
+    }
+    PooledBuffer buffer = acquire(size);
+    std::memcpy(buffer.data(), data, size);
+    return std::move(buffer).share();
+}
+
+BufferPoolStats BufferPool::getStats() const {
+    BufferPoolStats stats;
+    stats.allocations = state_->allocations.load(std::memory_order_relaxed);
+    stats.reuses = state_->reuses.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    stats.freeBuffers = state_->freeBuffers;
+    return stats;
+}
+
+}  // namespace core
+}  // namespace obswebrtc
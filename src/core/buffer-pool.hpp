@@ -0,0 +1,213 @@
+/**
+ * @file buffer-pool.hpp
+ * @brief Pooled, refcounted frame buffers for the receive path
+ *
+ * This module provides:
+ * - BufferSlice, a read-only, refcounted view of received bytes that is
+ *   passed between threads by bumping a counter instead of copying
+ * - BufferPool, which recycles the buffers behind slices in power-of-two
+ *   size classes so steady-state reception does not allocate
+ */
+
+#pragma once
+
+#include "constants.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+class BufferPool;
+
+/**
+ * @brief Read-only, refcounted view of a byte range
+ *
+ * Copying a slice shares the underlying buffer; the buffer goes back to its
+ * pool (or is freed) when the last slice referencing it is destroyed, on
+ * whichever thread that happens. Slices may outlive the pool that produced
+ * them. The bytes must not be modified once a slice exists.
+ */
+class BufferSlice {
+public:
+    BufferSlice() = default;
+    BufferSlice(const BufferSlice& other) noexcept;
+    BufferSlice(BufferSlice&& other) noexcept;
+    BufferSlice& operator=(const BufferSlice& other) noexcept;
+    BufferSlice& operator=(BufferSlice&& other) noexcept;
+    ~BufferSlice();
+
+    /**
+     * @brief Copy bytes into a standalone (unpooled) slice
+     *
+     * For callers without a pool, e.g. tests and one-off buffers.
+     */
+    static BufferSlice copyOf(const uint8_t* data, size_t size);
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const uint8_t* begin() const { return data_; }
+    const uint8_t* end() const { return data_ + size_; }
+    uint8_t operator[](size_t index) const { return data_[index]; }
+
+    /**
+     * @brief Get a view of part of this slice, sharing the same buffer
+     * @param offset Start within this slice
+     * @param size Length in bytes
+     * @throws std::out_of_range if the range exceeds this slice
+     */
+    BufferSlice subslice(size_t offset, size_t size) const;
+
+    /**
+     * @brief Copy the bytes into a vector
+     */
+    std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(begin(), end()); }
+
+    /**
+     * @brief Get the number of slices sharing the buffer (0 for an empty slice)
+     */
+    size_t useCount() const;
+
+    struct Block;  // Buffer header, defined in buffer-pool.cpp
+
+private:
+    friend class BufferPool;
+    friend class PooledBuffer;
+
+    BufferSlice(Block* block, const uint8_t* data, size_t size) noexcept
+        : block_(block), data_(data), size_(size) {}
+
+    void release() noexcept;
+
+    Block* block_ = nullptr;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Writable buffer from a BufferPool, before it is shared
+ *
+ * Move-only. Fill it, then turn it into a BufferSlice with share(); dropping
+ * it without sharing returns the buffer to the pool.
+ */
+class PooledBuffer {
+public:
+    PooledBuffer() = default;
+    PooledBuffer(PooledBuffer&& other) noexcept;
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+    ~PooledBuffer();
+
+    uint8_t* data() { return data_; }
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Shrink the usable size (e.g. after writing less than requested)
+     * @throws std::out_of_range if size exceeds the current size
+     */
+    void truncate(size_t size);
+
+    /**
+     * @brief Hand the buffer over to a read-only slice; leaves this empty
+     */
+    BufferSlice share() &&;
+
+private:
+    friend class BufferPool;
+
+    PooledBuffer(BufferSlice::Block* block, uint8_t* data, size_t size) noexcept
+        : block_(block), data_(data), size_(size) {}
+
+    BufferSlice::Block* block_ = nullptr;
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Configuration for BufferPool
+ */
+struct BufferPoolConfig {
+    size_t minBufferSize = constants::kMinPooledBufferSize;  // Smallest size class
+    size_t maxBufferSize = constants::kMaxPooledBufferSize;  // Larger requests bypass the pool
+    size_t maxFreeBuffers = constants::kDefaultBufferPoolFreeBuffers;  // Kept per size class
+};
+
+/**
+ * @brief Counters for a BufferPool
+ */
+struct BufferPoolStats {
+    uint64_t allocations = 0;  // Buffers allocated from the heap
+    uint64_t reuses = 0;       // Requests served from a free list
+    size_t freeBuffers = 0;    // Buffers currently waiting for reuse
+};
+
+/**
+ * @brief Size-class pool of refcounted receive buffers
+ *
+ * Requests are rounded up to a power of two between minBufferSize and
+ * maxBufferSize and served from that class's free list, so once the pool has
+ * warmed up a received frame costs one copy from the network and no
+ * allocation. Each class keeps at most maxFreeBuffers returned buffers;
+ * surplus ones and requests above maxBufferSize go straight to the heap.
+ *
+ * Thread-safe: buffers are taken on network threads and returned on
+ * whichever thread drops the last slice.
+ *
+ * Example usage:
+ * @code
+ * BufferPool pool;
+ *
+ * VideoFrame frame;
+ * frame.data = pool.copy(payload, payloadSize);  // The only copy
+ * queue.push(frame);                             // Shares the buffer
+ * @endcode
+ */
+class BufferPool {
+public:
+    /**
+     * @brief Construct a pool
+     * @param config Pool configuration
+     * @throws std::invalid_argument if minBufferSize is 0 or above maxBufferSize
+     */
+    explicit BufferPool(const BufferPoolConfig& config = BufferPoolConfig());
+
+    /**
+     * @brief Destroy the pool; slices still in use stay valid
+     */
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Take a writable buffer of at least the given size
+     * @param size Size in bytes
+     */
+    PooledBuffer acquire(size_t size);
+
+    /**
+     * @brief Copy bytes into a pooled buffer and share it
+     * @param data Source bytes
+     * @param size Size in bytes
+     * @return Slice over the copy (empty if size is 0)
+     */
+    BufferSlice copy(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Get the pool's counters
+     */
+    BufferPoolStats getStats() const;
+
+    struct State;  // Shared with outstanding buffers, defined in buffer-pool.cpp
+
+private:
+    State* state_;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,208 @@
+/**
+ * @file clock-drift.cpp
+ * @brief Implementation of clock drift estimation and audio clock sync
+ */
+
+#include "clock-drift.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+constexpr double kNsPerMs = 1e6;
+
+double clampPpm(double ppm, double limit) {
+    return std::min(std::max(ppm, -limit), limit);
+}
+
+}  // namespace
+
+ClockDriftEstimator::ClockDriftEstimator() : window_(constants::kClockDriftWindowIntervals) {}
+
+void ClockDriftEstimator::update(uint64_t mediaNs, uint64_t arrivalNs) {
+    const int64_t offsetNs = static_cast<int64_t>(arrivalNs - mediaNs);
+    if (!started_) {
+        started_ = true;
+        originNs_ = arrivalNs;
+        originOffsetNs_ = offsetNs;
+    }
+    if (arrivalNs < originNs_) {
+        return;  // Clock went backwards; not monotonic input
+    }
+
+    const double offsetMs = static_cast<double>(offsetNs - originOffsetNs_) / kNsPerMs;
+    const uint64_t intervalNs = static_cast<uint64_t>(constants::kClockDriftIntervalMs) * 1000000;
+    if (intervalOpen_ && arrivalNs >= intervalStartNs_ + intervalNs) {
+        closeInterval();
+    }
+    if (!intervalOpen_) {
+        intervalOpen_ = true;
+        intervalStartNs_ = arrivalNs;
+        intervalMinMs_ = offsetMs;
+    } else {
+        intervalMinMs_ = std::min(intervalMinMs_, offsetMs);
+    }
+}
+
+void ClockDriftEstimator::closeInterval() {
+    intervalOpen_ = false;
+
+    Interval interval;
+    interval.timeMs = static_cast<double>(intervalStartNs_ - originNs_) / kNsPerMs;
+    interval.offsetMs = intervalMinMs_;
+
+    if (count_ > 0) {
+        double expectedMs;
+        if (haveLine_) {
+            expectedMs = intercept_ + slope_ * interval.timeMs;
+        } else {
+            expectedMs = window_[(head_ + count_ - 1) % window_.size()].offsetMs;
+        }
+        if (std::fabs(interval.offsetMs - expectedMs) > constants::kClockDriftResetMs) {
+            restartWindow();
+        }
+    }
+
+    if (count_ == window_.size()) {
+        head_ = (head_ + 1) % window_.size();
+        count_--;
+    }
+    window_[(head_ + count_) % window_.size()] = interval;
+    count_++;
+    fit();
+}
+
+void ClockDriftEstimator::restartWindow() {
+    head_ = 0;
+    count_ = 0;
+    haveLine_ = false;
+    restarts_++;
+}
+
+void ClockDriftEstimator::fit() {
+    if (count_ < 2) {
+        return;
+    }
+
+    // Least squares around the means, which keeps the sums well conditioned
+    double meanTime = 0.0;
+    double meanOffset = 0.0;
+    for (size_t i = 0; i < count_; i++) {
+        const Interval& interval = window_[(head_ + i) % window_.size()];
+        meanTime += interval.timeMs;
+        meanOffset += interval.offsetMs;
+    }
+    meanTime /= static_cast<double>(count_);
+    meanOffset /= static_cast<double>(count_);
+
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (size_t i = 0; i < count_; i++) {
+        const Interval& interval = window_[(head_ + i) % window_.size()];
+        const double dt = interval.timeMs - meanTime;
+        covariance += dt * (interval.offsetMs - meanOffset);
+        variance += dt * dt;
+    }
+    if (variance <= 0.0) {
+        return;
+    }
+
+    slope_ = covariance / variance;
+    intercept_ = meanOffset - slope_ * meanTime;
+    haveLine_ = true;
+
+    // A fast sender's timestamps gain on the arrival times: the offset shrinks
+    if (count_ >= constants::kClockDriftMinIntervals) {
+        driftPpm_ = clampPpm(-slope_ * 1e6, constants::kMaxAudioClockDriftPpm);
+        hasEstimate_ = true;
+    }
+}
+
+void ClockDriftEstimator::reset() {
+    head_ = 0;
+    count_ = 0;
+    started_ = false;
+    intervalOpen_ = false;
+    haveLine_ = false;
+    hasEstimate_ = false;
+    driftPpm_ = 0.0;
+}
+
+AudioClockSync::AudioClockSync(const AudioClockSyncConfig& config) : config_(config) {
+    if (config.sampleRate == 0) {
+        throw std::invalid_argument("Audio clock sync needs a sample rate");
+    }
+    if (config.targetDepthMs < 0) {
+        throw std::invalid_argument("Audio clock sync target depth cannot be negative");
+    }
+    if (config.maxDepthErrorMs <= 0) {
+        throw std::invalid_argument("Audio clock sync depth error limit must be positive");
+    }
+}
+
+double AudioClockSync::update(uint64_t mediaNs, uint32_t frames, uint64_t nowNs) {
+    estimator_.update(mediaNs, nowNs);
+    stats_.framesIn += frames;
+
+    const double targetNs = static_cast<double>(config_.targetDepthMs) * kNsPerMs;
+    const double maxErrorNs = static_cast<double>(config_.maxDepthErrorMs) * kNsPerMs;
+    const double depthNs =
+        synced_ ? static_cast<double>(static_cast<int64_t>(timelineNs() - nowNs)) : 0.0;
+    if (!synced_ || std::fabs(depthNs - targetNs) > maxErrorNs) {
+        synced_ = true;
+        originNs_ = nowNs + static_cast<uint64_t>(config_.targetDepthMs) * 1000000;
+        framesSinceOrigin_ = 0;
+        smoothedDepthNs_ = targetNs;
+        stats_.resyncs++;
+    } else {
+        // Exponential smoothing with a time constant, whatever the chunk size
+        const double chunkNs = static_cast<double>(frames) * 1e9 / config_.sampleRate;
+        const double weight =
+            std::min(chunkNs / (constants::kAudioSyncSmoothingMs * kNsPerMs), 1.0);
+        smoothedDepthNs_ += weight * (depthNs - smoothedDepthNs_);
+    }
+
+    const double errorNs = targetNs - smoothedDepthNs_;
+    const double correctionPpm =
+        clampPpm(errorNs / (constants::kAudioSyncCorrectionMs * kNsPerMs) * 1e6,
+                 constants::kMaxAudioSyncCorrectionPpm);
+    const double driftPpm = estimator_.getDriftPpm();
+    const double ratio = (1.0 + correctionPpm * 1e-6) / (1.0 + driftPpm * 1e-6);
+
+    stats_.driftPpm = driftPpm;
+    stats_.correctionPpm = correctionPpm;
+    stats_.ratio = ratio;
+    stats_.depthMs = smoothedDepthNs_ / kNsPerMs;
+    return ratio;
+}
+
+uint64_t AudioClockSync::advance(size_t frames) {
+    const uint64_t timestampNs = timelineNs();
+    framesSinceOrigin_ += frames;
+    stats_.framesOut += frames;
+    return timestampNs;
+}
+
+AudioClockSyncStats AudioClockSync::getStats() const {
+    return stats_;
+}
+
+void AudioClockSync::reset() {
+    estimator_.reset();
+    synced_ = false;
+}
+
+uint64_t AudioClockSync::timelineNs() const {
+    // In whole seconds and a remainder, so 64 bits hold days of frames * 10^9
+    const uint64_t rate = config_.sampleRate;
+    return originNs_ + framesSinceOrigin_ / rate * 1000000000ULL +
+           framesSinceOrigin_ % rate * 1000000000ULL / rate;
+}
+
+}  // namespace core
+}  // namespace obswebrtc
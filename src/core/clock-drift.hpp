@@ -0,0 +1,208 @@
+/**
+ * @file clock-drift.hpp
+ * @brief Remote audio clock drift estimation and compensation
+ *
+ * This module provides:
+ * - A drift estimator that compares the progression of received media
+ *   timestamps with local monotonic arrival times
+ * - Audio clock sync: received audio is rescheduled onto the local clock at a
+ *   fixed depth ahead of it, with a resampling ratio that follows the
+ *   sender's drift and corrects the remaining depth error
+ */
+
+#pragma once
+
+#include "constants.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Estimates how fast a sender's media clock runs relative to the local clock
+ *
+ * Each sample is the offset between a chunk's local arrival time and its
+ * media timestamp. Network and scheduling delays only ever add to that
+ * offset, so the estimator keeps the minimum offset of each
+ * kClockDriftIntervalMs interval, and fits a line through the last
+ * kClockDriftWindowIntervals minima by least squares. The slope is the drift.
+ * A jump of more than kClockDriftResetMs from the fitted line (a new stream,
+ * or the jitter buffer changing its delay) restarts the window; the previous
+ * estimate is reported until the new window has kClockDriftMinIntervals.
+ *
+ * Not thread-safe.
+ */
+class ClockDriftEstimator {
+public:
+    ClockDriftEstimator();
+
+    /**
+     * @brief Add a timestamped arrival
+     * @param mediaNs Media timestamp on the sender's clock (unwrapped)
+     * @param arrivalNs Arrival time on the local monotonic clock
+     */
+    void update(uint64_t mediaNs, uint64_t arrivalNs);
+
+    /**
+     * @brief Get the drift: positive when the sender's clock runs fast
+     * @return Parts per million, clamped to ±kMaxAudioClockDriftPpm; 0 until the first estimate
+     */
+    double getDriftPpm() const { return driftPpm_; }
+
+    /**
+     * @brief Check whether getDriftPpm() is based on measurements yet
+     */
+    bool hasEstimate() const { return hasEstimate_; }
+
+    /**
+     * @brief Number of times the window restarted after an offset jump
+     */
+    uint64_t getRestarts() const { return restarts_; }
+
+    /**
+     * @brief Forget all measurements and the estimate
+     */
+    void reset();
+
+private:
+    struct Interval {
+        double timeMs = 0.0;    // Local time of the interval start, relative to origin
+        double offsetMs = 0.0;  // Minimum arrival offset in the interval
+    };
+
+    void closeInterval();
+    void restartWindow();
+    void fit();
+
+    std::vector<Interval> window_;  // Ring of the most recent intervals
+    size_t head_ = 0;               // Oldest interval in window_
+    size_t count_ = 0;
+
+    bool started_ = false;
+    uint64_t originNs_ = 0;       // Local time all interval times are relative to
+    int64_t originOffsetNs_ = 0;  // Offset all interval offsets are relative to
+    bool intervalOpen_ = false;
+    uint64_t intervalStartNs_ = 0;
+    double intervalMinMs_ = 0.0;
+
+    // Fitted line through the window, for the jump check
+    bool haveLine_ = false;
+    double slope_ = 0.0;      // Offset ms per local ms
+    double intercept_ = 0.0;  // Offset ms at local time 0
+
+    bool hasEstimate_ = false;
+    double driftPpm_ = 0.0;
+    uint64_t restarts_ = 0;
+};
+
+/**
+ * @brief Configuration for AudioClockSync
+ */
+struct AudioClockSyncConfig {
+    uint32_t sampleRate = constants::kDefaultAudioSampleRate;  // Of the chunks, in and out
+    int targetDepthMs = constants::kDefaultAudioSyncTargetMs;  // Scheduled ahead of the clock
+    // Depth error that resyncs the timeline at once instead of resampling towards the target
+    int maxDepthErrorMs = constants::kDefaultAudioSyncMaxErrorMs;
+};
+
+/**
+ * @brief State of an AudioClockSync
+ */
+struct AudioClockSyncStats {
+    double driftPpm = 0.0;       // Estimated sender clock drift (positive = sender fast)
+    double correctionPpm = 0.0;  // Depth correction applied on top of the drift
+    double ratio = 1.0;          // Output frames per input frame of the last chunk
+    double depthMs = 0.0;        // Smoothed depth ahead of the local clock
+    uint64_t framesIn = 0;
+    uint64_t framesOut = 0;
+    uint64_t resyncs = 0;        // Timeline restarts, including the first chunk
+};
+
+/**
+ * @brief Moves received audio from the sender's clock onto the local clock
+ *
+ * A remote sender's sample clock runs a little faster or slower than the
+ * local one (±100 ppm is common), so audio played with the sender's
+ * timestamps slowly gains latency or runs dry: 200 ppm is 0.7 s per hour.
+ * AudioClockSync schedules audio on a local timeline instead. Every output
+ * frame advances it by exactly one sample period, and the timeline is kept
+ * targetDepthMs ahead of the local clock at the moment each chunk is
+ * handed over. Keeping it there takes resampling by
+ *
+ *     ratio = (1 + correction) / (1 + drift)
+ *
+ * where the drift comes from a ClockDriftEstimator and the correction is
+ * proportional to the smoothed depth error, removing it over about
+ * kAudioSyncCorrectionMs. Corrections stay below ~0.2%, far under audible
+ * pitch change. When the depth is off by more than maxDepthErrorMs (the
+ * first chunk, an outage, a burst after a stall) the timeline restarts at
+ * the target depth.
+ *
+ * Each chunk takes two calls, around the resampler that applies the ratio.
+ * Time is passed in by the caller, which makes the controller deterministic
+ * to test. Not thread-safe.
+ *
+ * Example usage:
+ * @code
+ * AudioClockSync sync(config);
+ * AdaptiveResampler resampler(channels);
+ *
+ * // For every decoded chunk
+ * resampler.setRatio(sync.update(chunk.timestampNs, chunk.frames, os_gettime_ns()));
+ * const size_t frames = resampler.process(chunk.planes, chunk.frames, output, capacity);
+ * const uint64_t timestampNs = sync.advance(frames);  // On the local clock
+ * @endcode
+ */
+class AudioClockSync {
+public:
+    /**
+     * @brief Construct a clock sync
+     * @param config Sync configuration
+     * @throws std::invalid_argument unless sampleRate > 0, targetDepthMs >= 0 and
+     *         maxDepthErrorMs > 0
+     */
+    explicit AudioClockSync(const AudioClockSyncConfig& config = AudioClockSyncConfig());
+
+    /**
+     * @brief Account for a chunk handed over at @p nowNs and get its resampling ratio
+     * @param mediaNs Timestamp of the chunk on the sender's clock
+     * @param frames Samples per channel in the chunk
+     * @param nowNs Current time on the local monotonic clock
+     * @return Output frames per input frame to resample the chunk with
+     */
+    double update(uint64_t mediaNs, uint32_t frames, uint64_t nowNs);
+
+    /**
+     * @brief Place resampled frames on the local timeline
+     * @param frames Frames the resampler produced for the chunk
+     * @return Local timestamp of the first of them
+     */
+    uint64_t advance(size_t frames);
+
+    /**
+     * @brief Get drift, depth and counters
+     */
+    AudioClockSyncStats getStats() const;
+
+    /**
+     * @brief Forget the timeline and drift estimate; the next chunk resyncs
+     */
+    void reset();
+
+private:
+    uint64_t timelineNs() const;
+
+    AudioClockSyncConfig config_;
+    ClockDriftEstimator estimator_;
+    bool synced_ = false;
+    uint64_t originNs_ = 0;        // Local time of the first frame since the last resync
+    uint64_t framesSinceOrigin_ = 0;
+    double smoothedDepthNs_ = 0.0;
+    AudioClockSyncStats stats_;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
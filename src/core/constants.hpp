@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace obswebrtc {
@@ -30,6 +31,200 @@ constexpr int kMinAudioBitrateKbps = 16;
 /** Maximum audio bitrate in kbps */
 constexpr int kMaxAudioBitrateKbps = 128;
 
+// =============================================================================
+// RTP
+// =============================================================================
+
+/** RTP clock rate for video payloads in Hz (RFC 6184 / RFC 7741) */
+constexpr uint32_t kVideoRtpClockRate = 90000;
+
+/** RTP clock rate for Opus payloads in Hz (RFC 7587) */
+constexpr uint32_t kOpusRtpClockRate = 48000;
+
+/** Default dynamic RTP payload type for video */
+constexpr uint8_t kDefaultVideoPayloadType = 96;
+
+/** Default dynamic RTP payload type for Opus audio */
+constexpr uint8_t kDefaultAudioPayloadType = 111;
+
+/** Size of the fixed RTP header in bytes (RFC 3550) */
+constexpr size_t kRtpHeaderSize = 12;
+
+/** Default largest RTP payload; leaves room for headers, SRTP and TURN under a 1280 byte MTU */
+constexpr size_t kDefaultRtpMaxPayloadSize = 1200;
+
+/** Default minimum time between encoder keyframes forced by receiver PLI/FIR */
+constexpr int kDefaultKeyframeRequestIntervalMs = 500;
+
+/** Default dynamic RTP payload type for video retransmissions (RFC 4588) */
+constexpr uint8_t kDefaultRtxPayloadType = 97;
+
+/** Bytes an RTX packet adds to the original: the original sequence number (RFC 4588) */
+constexpr size_t kRtxOverheadSize = 2;
+
+/** Largest RTP packet kept for retransmission (Ethernet MTU) */
+constexpr size_t kMaxRtpPacketSize = 1500;
+
+/** Default age limit of the retransmission history; older packets are not resent */
+constexpr int kDefaultRtxHistoryMs = 1000;
+
+/** Bounds on the retransmission history size in packets */
+constexpr size_t kMinRtxHistoryPackets = 64;
+constexpr size_t kMaxRtxHistoryPackets = 32768;
+
+/** Default dynamic RTP payload type for FlexFEC repair packets */
+constexpr uint8_t kDefaultFecPayloadType = 98;
+
+/** Default FEC packets per media packet on a loss-free link */
+constexpr double kDefaultFecProtectionRatio = 0.1;
+
+/** Default ceiling on the FEC protection ratio as loss rises */
+constexpr double kDefaultMaxFecProtectionRatio = 0.5;
+
+/** Protection ratio per unit of reported loss (one parity packet per group survives one loss) */
+constexpr double kFecLossMultiplier = 2.0;
+
+/** Most media packets one FEC packet protects (15 + 31 bit FlexFEC masks) */
+constexpr size_t kMaxFecGroupSize = 46;
+
+// =============================================================================
+// Send Pipeline
+// =============================================================================
+
+/** Default depth of the encoder-to-network video send queue in packets (~8 s at 60 fps) */
+constexpr size_t kDefaultSendQueueDepth = 512;
+
+/** Depth of the separate audio send queue in packets (~5 s of 20 ms Opus) */
+constexpr size_t kAudioSendQueueDepth = 256;
+
+/** Default send queue fill (fraction of its depth) above which non-reference frames are dropped */
+constexpr double kDefaultNonReferenceDropThreshold = 0.25;
+
+/** Default send queue fill above which the rest of the GOP is dropped */
+constexpr double kDefaultGopDropThreshold = 0.5;
+
+/** Upper bound on how long the idle send worker sleeps between queue checks */
+constexpr int kSendWorkerIdleWaitMs = 2;
+
+/** Default pacing rate relative to the target bitrate (headroom for bitrate overshoot) */
+constexpr double kDefaultPacingMultiplier = 2.5;
+
+/** Default pacer bucket depth in milliseconds of data at the pacing rate */
+constexpr int kDefaultPacerMaxBurstMs = 5;
+
+/** Default queue delay above which the pacer drains without pacing */
+constexpr int kDefaultPacerMaxQueueDelayMs = 1000;
+
+/** Default pacer release tick for WebRTCOutput: packets due within it leave together */
+constexpr int kDefaultPacerBatchIntervalMs = 2;
+
+// =============================================================================
+// Receive Pipeline
+// =============================================================================
+
+/** Smallest buffer size class of the receive buffer pool (an Opus frame fits) */
+constexpr size_t kMinPooledBufferSize = 256;
+
+/** Largest buffer size class of the receive buffer pool; bigger frames are not pooled */
+constexpr size_t kMaxPooledBufferSize = 4 * 1024 * 1024;
+
+/** Default number of free buffers the receive pool keeps per size class */
+constexpr size_t kDefaultBufferPoolFreeBuffers = 16;
+
+/** Default capacity of a receiving source's video frame queue (~130 ms at 60 fps) */
+constexpr size_t kDefaultSourceVideoQueueFrames = 8;
+
+/** Default capacity of a receiving source's audio frame queue (320 ms of 20 ms Opus frames) */
+constexpr size_t kDefaultSourceAudioQueueFrames = 16;
+
+/** Minimum interval between receive queue drop reports in the log */
+constexpr int kSourceQueueReportIntervalMs = 10000;
+
+/** Default decoder thread count for received video (0 = one per core, slice threading) */
+constexpr int kDefaultVideoDecoderThreads = 0;
+
+/** Default threads converting a picture to RGBA on the CPU (0 = one per core) */
+constexpr size_t kDefaultYuvConvertThreads = 0;
+
+/** Most threads a picture is split across for RGBA conversion */
+constexpr size_t kMaxYuvConvertThreads = 8;
+
+/** Fewest pixels per row band worth handing to another thread (1080p: up to 3 bands) */
+constexpr size_t kYuvConvertMinBandPixels = 512 * 1024;
+
+/** Most channels the receive-side Opus decoder outputs (OBS mono or stereo) */
+constexpr size_t kMaxAudioDecoderChannels = 2;
+
+/** Longest Opus packet in milliseconds; sizes the decoder's sample buffers */
+constexpr int kMaxOpusPacketMs = 120;
+
+/** Default longest gap of lost audio filled by concealment; longer outages resync */
+constexpr int kDefaultAudioMaxConcealMs = 100;
+
+/** Default depth received audio is scheduled ahead of the local clock by the audio clock sync */
+constexpr int kDefaultAudioSyncTargetMs = 60;
+
+/** Default distance from the target depth beyond which audio timing resyncs instead of adapting */
+constexpr int kDefaultAudioSyncMaxErrorMs = 250;
+
+/** Time constant of the smoothing applied to the measured audio depth */
+constexpr int kAudioSyncSmoothingMs = 2000;
+
+/** Time in which the resampling correction removes a depth error (P controller time constant) */
+constexpr int kAudioSyncCorrectionMs = 30000;
+
+/** Largest depth correction applied on top of the drift estimate, in ppm */
+constexpr double kMaxAudioSyncCorrectionPpm = 1000.0;
+
+/** Largest sender clock drift the estimator reports, in ppm (crystals are specified to ~100) */
+constexpr double kMaxAudioClockDriftPpm = 1000.0;
+
+/** Length of the intervals whose minimum arrival offset the drift estimator fits a line to */
+constexpr int kClockDriftIntervalMs = 1000;
+
+/** Intervals in the drift estimator's regression window (5 minutes) */
+constexpr size_t kClockDriftWindowIntervals = 300;
+
+/** Intervals the drift estimator needs before it reports an estimate */
+constexpr size_t kClockDriftMinIntervals = 30;
+
+/** Arrival offset step that restarts the drift estimator (new stream, jitter buffer change) */
+constexpr int kClockDriftResetMs = 50;
+
+/** Filter length of the adaptive audio resampler (windowed sinc, half before and half after) */
+constexpr size_t kResamplerTaps = 48;
+
+/** Fractional positions the resampler's filter is tabulated at; positions between interpolate */
+constexpr size_t kResamplerPhases = 256;
+
+/** Largest deviation of the resampling ratio from 1; the filter is made for small corrections */
+constexpr double kMaxResamplerRatioDeviation = 0.01;
+
+/** Default lower bound of the receive jitter buffer's adaptive delay (0 = follow jitter only) */
+constexpr int kDefaultJitterBufferMinDelayMs = 0;
+
+/** Default upper bound of the receive jitter buffer's adaptive delay */
+constexpr int kDefaultJitterBufferMaxDelayMs = 500;
+
+/** Default number of RTP packets a receive jitter buffer can hold */
+constexpr size_t kDefaultJitterBufferPackets = 1024;
+
+/** Recent packet transit times the jitter buffer derives its target delay from */
+constexpr size_t kJitterBufferDelaySamples = 512;
+
+// =============================================================================
+// Congestion Control
+// =============================================================================
+
+/** Lowest video bitrate adaptive bitrate will ask the encoder for, in kbps */
+constexpr int kMinVideoBitrateKbps = 300;
+
+/** Window over which the actual send rate is measured */
+constexpr int kSendRateWindowMs = 1000;
+
+/** Smallest relative change (percent) worth reconfiguring the encoder for */
+constexpr int kBitrateUpdateThresholdPercent = 5;
+
 // =============================================================================
 // Network Calculations
 // =============================================================================
@@ -0,0 +1,251 @@
+/**
+ * @file fec-encoder.cpp
+ * @brief Implementation of FlexFEC encoding and the SIMD XOR kernels
+ */
+
+#include "fec-encoder.hpp"
+#include "rtp-packetizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#if defined(OBSWEBRTC_SIMD_X86)
+#include <immintrin.h>
+#elif defined(OBSWEBRTC_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+/** FEC header with one SSRC and a 15-bit mask; the 31-bit mask adds 4 bytes */
+constexpr size_t kFecHeaderSize = 20;
+constexpr size_t kFecLongMaskSize = 4;
+constexpr size_t kFecShortMaskBits = 15;
+
+using XorFunction = void (*)(uint8_t*, const uint8_t*, size_t);
+
+void xorScalarFrom(uint8_t* dst, const uint8_t* src, size_t size, size_t i) {
+    for (; i + 8 <= size; i += 8) {
+        uint64_t a;
+        uint64_t b;
+        std::memcpy(&a, dst + i, 8);
+        std::memcpy(&b, src + i, 8);
+        a ^= b;
+        std::memcpy(dst + i, &a, 8);
+    }
+    for (; i < size; i++) {
+        dst[i] ^= src[i];
+    }
+}
+
+void xorScalar(uint8_t* dst, const uint8_t* src, size_t size) {
+    xorScalarFrom(dst, src, size, 0);
+}
+
+#if defined(OBSWEBRTC_SIMD_X86)
+
+void xorSse2(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(a, b));
+    }
+    xorScalarFrom(dst, src, size, i);
+}
+
+OBSWEBRTC_TARGET_AVX2
+void xorAvx2(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, b));
+    }
+    xorScalarFrom(dst, src, size, i);
+}
+
+#elif defined(OBSWEBRTC_SIMD_NEON)
+
+void xorNeon(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+    }
+    xorScalarFrom(dst, src, size, i);
+}
+
+#endif
+
+XorFunction xorFunctionFor(SimdLevel level) {
+    switch (level) {
+#if defined(OBSWEBRTC_SIMD_X86)
+        case SimdLevel::SSE2:
+            return xorSse2;
+        case SimdLevel::AVX2:
+            return xorAvx2;
+#elif defined(OBSWEBRTC_SIMD_NEON)
+        case SimdLevel::NEON:
+            return xorNeon;
+#endif
+        default:
+            return xorScalar;
+    }
+}
+
+uint32_t readU32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+void writeU16(uint8_t* data, uint16_t value) {
+    data[0] = static_cast<uint8_t>(value >> 8);
+    data[1] = static_cast<uint8_t>(value);
+}
+
+void writeU32(uint8_t* data, uint32_t value) {
+    data[0] = static_cast<uint8_t>(value >> 24);
+    data[1] = static_cast<uint8_t>(value >> 16);
+    data[2] = static_cast<uint8_t>(value >> 8);
+    data[3] = static_cast<uint8_t>(value);
+}
+
+size_t targetGroupSize(double ratio) {
+    const auto size = static_cast<size_t>(std::lround(1.0 / ratio));
+    return std::min(std::max<size_t>(size, 1), constants::kMaxFecGroupSize);
+}
+
+}  // namespace
+
+void xorBytes(uint8_t* dst, const uint8_t* src, size_t size) {
+    static const XorFunction xorFunction = xorFunctionFor(detectSimdLevel());
+    xorFunction(dst, src, size);
+}
+
+void xorBytes(uint8_t* dst, const uint8_t* src, size_t size, SimdLevel level) {
+    if (!isSimdLevelSupported(level)) {
+        throw std::invalid_argument(std::string("SIMD level not supported: ") +
+                                    simdLevelName(level));
+    }
+    xorFunctionFor(level)(dst, src, size);
+}
+
+double fecProtectionRatioForLoss(double lossRate, double baseRatio, double maxRatio) {
+    const double ratio = std::max(baseRatio, lossRate * constants::kFecLossMultiplier);
+    return std::min(ratio, maxRatio);
+}
+
+FlexFecEncoder::FlexFecEncoder(const FlexFecConfig& config)
+    : config_(config), ratio_(config.protectionRatio),
+      sequenceNumber_(static_cast<uint16_t>(std::random_device{}())) {
+    if (!(config_.protectionRatio >= 0.0 && config_.protectionRatio <= 1.0)) {
+        throw std::invalid_argument("FEC protection ratio must be between 0 and 1");
+    }
+    if (config_.maxPacketSize <= constants::kRtpHeaderSize) {
+        throw std::invalid_argument("FEC packet size is too small");
+    }
+    parity_.assign(config_.maxPacketSize - constants::kRtpHeaderSize, 0);
+}
+
+void FlexFecEncoder::setProtectionRatio(double ratio) {
+    ratio_.store(std::min(std::max(ratio, 0.0), 1.0), std::memory_order_relaxed);
+}
+
+double FlexFecEncoder::getProtectionRatio() const {
+    return ratio_.load(std::memory_order_relaxed);
+}
+
+bool FlexFecEncoder::addPacket(const uint8_t* packet, size_t size, std::vector<uint8_t>& fecPacket) {
+    if (!packet || size < constants::kRtpHeaderSize || size > config_.maxPacketSize ||
+        (packet[0] >> 6) != 2 || readU32(packet + 8) != config_.mediaSsrc) {
+        return false;
+    }
+
+    const double ratio = ratio_.load(std::memory_order_relaxed);
+    if (ratio <= 0.0) {
+        resetGroup();
+        return false;
+    }
+
+    const uint16_t sequenceNumber = static_cast<uint16_t>((packet[2] << 8) | packet[3]);
+    if (groupSize_ > 0 && sequenceNumber != static_cast<uint16_t>(sequenceBase_ + groupSize_)) {
+        // Masks describe consecutive packets only; the partial group is lost
+        resetGroup();
+    }
+    if (groupSize_ == 0) {
+        sequenceBase_ = sequenceNumber;
+    }
+
+    // Recovery fields: header bits, length and timestamp, then everything
+    // after the fixed header (CSRCs, extensions, payload, padding)
+    const size_t payloadSize = size - constants::kRtpHeaderSize;
+    headerRecovery_[0] ^= packet[0];
+    headerRecovery_[1] ^= packet[1];
+    lengthRecovery_ ^= static_cast<uint16_t>(payloadSize);
+    lastTimestamp_ = readU32(packet + 4);
+    timestampRecovery_ ^= lastTimestamp_;
+    xorBytes(parity_.data(), packet + constants::kRtpHeaderSize, payloadSize);
+    parityLength_ = std::max(parityLength_, payloadSize);
+    groupSize_++;
+
+    const size_t target = targetGroupSize(ratio);
+    const bool endOfFrame = (packet[1] & 0x80) != 0;
+    if (groupSize_ < target && !(endOfFrame && groupSize_ * 2 >= target)) {
+        return false;
+    }
+
+    writeFecPacket(fecPacket);
+    resetGroup();
+    return true;
+}
+
+void FlexFecEncoder::resetGroup() {
+    std::fill(parity_.begin(), parity_.begin() + parityLength_, 0);
+    parityLength_ = 0;
+    groupSize_ = 0;
+    headerRecovery_[0] = 0;
+    headerRecovery_[1] = 0;
+    lengthRecovery_ = 0;
+    timestampRecovery_ = 0;
+}
+
+void FlexFecEncoder::writeFecPacket(std::vector<uint8_t>& fecPacket) {
+    const bool longMask = groupSize_ > kFecShortMaskBits;
+    const size_t headerSize = kFecHeaderSize + (longMask ? kFecLongMaskSize : 0);
+    fecPacket.resize(constants::kRtpHeaderSize + headerSize + parityLength_);
+
+    uint8_t* out = fecPacket.data();
+    writeRtpHeader(out, config_.payloadType, false, sequenceNumber_++, lastTimestamp_,
+                   config_.fecSsrc);
+
+    uint8_t* header = out + constants::kRtpHeaderSize;
+    header[0] = headerRecovery_[0] & 0x3F;  // R = 0, F = 0: flexible mask
+    header[1] = headerRecovery_[1];
+    writeU16(header + 2, lengthRecovery_);
+    writeU32(header + 4, timestampRecovery_);
+    writeU32(header + 8, 1u << 24);  // SSRCCount = 1, reserved
+    writeU32(header + 12, config_.mediaSsrc);
+    writeU16(header + 16, sequenceBase_);
+
+    // Mask bit i (MSB first after the k bit) protects sequenceBase_ + i; k marks the last word
+    if (longMask) {
+        const size_t rest = groupSize_ - kFecShortMaskBits;
+        writeU16(header + 18, 0x7FFF);
+        writeU32(header + 20, 0x80000000u | (((1u << rest) - 1) << (31 - rest)));
+    } else {
+        writeU16(header + 18, static_cast<uint16_t>(0x8000u | (((1u << groupSize_) - 1)
+                                                               << (kFecShortMaskBits - groupSize_))));
+    }
+
+    std::memcpy(header + headerSize, parity_.data(), parityLength_);
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,131 @@
+/**
+ * @file fec-encoder.hpp
+ * @brief FlexFEC forward error correction for outgoing video
+ *
+ * This module provides:
+ * - A streaming FlexFEC encoder (draft-ietf-payload-flexible-fec-scheme-03,
+ *   negotiated as "flexfec-03" by libwebrtc receivers) that protects groups
+ *   of consecutive media packets with one XOR parity packet on its own SSRC
+ * - A SIMD byte-wise XOR kernel (SSE2/AVX2/NEON with a scalar fallback)
+ * - The protection ratio policy that follows reported packet loss
+ */
+
+#pragma once
+
+#include "constants.hpp"
+#include "simd.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief XOR src into dst (dst[i] ^= src[i])
+ *
+ * Uses the best kernel for this CPU.
+ */
+void xorBytes(uint8_t* dst, const uint8_t* src, size_t size);
+
+/**
+ * @brief XOR src into dst with a specific kernel
+ *
+ * For tests and benchmarks; production code should use the dispatching overload.
+ *
+ * @throws std::invalid_argument if the CPU does not support the level
+ */
+void xorBytes(uint8_t* dst, const uint8_t* src, size_t size, SimdLevel level);
+
+/**
+ * @brief Protection ratio for a reported loss rate
+ * @param lossRate Fraction of packets lost (0-1)
+ * @param baseRatio Ratio on a loss-free link
+ * @param maxRatio Ceiling
+ * @return max(baseRatio, lossRate * kFecLossMultiplier), clamped to maxRatio
+ */
+double fecProtectionRatioForLoss(double lossRate, double baseRatio, double maxRatio);
+
+/**
+ * @brief Configuration for FlexFecEncoder
+ */
+struct FlexFecConfig {
+    uint32_t mediaSsrc = 0;  // SSRC of the protected stream
+    uint32_t fecSsrc = 0;    // SSRC of the repair stream
+    uint8_t payloadType = constants::kDefaultFecPayloadType;
+    double protectionRatio = constants::kDefaultFecProtectionRatio;
+    size_t maxPacketSize = constants::kMaxRtpPacketSize;  // Largest media packet protected
+};
+
+/**
+ * @brief Streaming FlexFEC encoder for one media SSRC
+ *
+ * Media packets are XORed into a running parity as they are sent, so
+ * nothing is buffered or allocated per packet. A group closes, producing
+ * one FEC packet, when it reaches round(1 / protectionRatio) packets (at
+ * most kMaxFecGroupSize), or at the end of a frame (RTP marker) once it is
+ * at least half that size; a smaller group continues into the next frame.
+ * Any single lost packet of a group can be rebuilt from the others and the
+ * FEC packet without waiting a round trip for a retransmission.
+ *
+ * Not thread-safe, except setProtectionRatio() which may be called from
+ * any thread.
+ */
+class FlexFecEncoder {
+public:
+    /**
+     * @brief Construct an encoder
+     * @param config Encoder configuration
+     * @throws std::invalid_argument if the ratio is outside [0, 1] or the packet
+     *         size cannot hold an RTP header
+     */
+    explicit FlexFecEncoder(const FlexFecConfig& config);
+
+    /**
+     * @brief Change the number of FEC packets per media packet
+     * @param ratio Protection ratio, clamped to [0, 1]; 0 stops FEC
+     */
+    void setProtectionRatio(double ratio);
+
+    /**
+     * @brief Get the current protection ratio
+     */
+    double getProtectionRatio() const;
+
+    /**
+     * @brief Protect one outgoing media packet
+     *
+     * Packets of other SSRCs, truncated packets and packets larger than
+     * maxPacketSize are skipped; a sequence number gap closes the group.
+     *
+     * @param packet RTP packet as sent (before SRTP)
+     * @param size Packet size in bytes
+     * @param fecPacket Receives a FEC packet to send after this one (reuse
+     *        the vector so its buffer is kept)
+     * @return true if fecPacket was written
+     */
+    bool addPacket(const uint8_t* packet, size_t size, std::vector<uint8_t>& fecPacket);
+
+private:
+    void resetGroup();
+    void writeFecPacket(std::vector<uint8_t>& fecPacket);
+
+    FlexFecConfig config_;
+    std::atomic<double> ratio_;
+    uint16_t sequenceNumber_;
+
+    // Running parity of the current group
+    size_t groupSize_ = 0;
+    uint16_t sequenceBase_ = 0;
+    uint8_t headerRecovery_[2] = {0, 0};  // V/P/X/CC and M/PT bytes
+    uint16_t lengthRecovery_ = 0;
+    uint32_t timestampRecovery_ = 0;
+    uint32_t lastTimestamp_ = 0;
+    size_t parityLength_ = 0;      // Longest payload (everything after the fixed header) so far
+    std::vector<uint8_t> parity_;  // maxPacketSize - kRtpHeaderSize bytes
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,114 @@
+/**
+ * @file frame-drop-policy.cpp
+ * @brief Implementation of congestion-aware frame dropping
+ */
+
+#include "frame-drop-policy.hpp"
+#include "nal-parser.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+constexpr uint8_t kH264NonIdrSlice = 1;
+constexpr uint8_t kH264IdrSlice = 5;
+constexpr size_t kStartCodeSize = 3;
+
+size_t thresholdPackets(size_t queueDepth, double threshold) {
+    return static_cast<size_t>(std::ceil(static_cast<double>(queueDepth) * threshold));
+}
+
+}  // namespace
+
+FrameClass classifyH264Frame(const uint8_t* data, size_t size) {
+    if (!data) {
+        return FrameClass::Reference;
+    }
+
+    size_t pos = findAnnexBStartCode(data, size);
+    while (pos + kStartCodeSize < size) {
+        const uint8_t header = data[pos + kStartCodeSize];
+        const uint8_t type = header & 0x1F;
+        if (type >= kH264NonIdrSlice && type <= kH264IdrSlice) {
+            if (type == kH264IdrSlice) {
+                return FrameClass::Keyframe;
+            }
+            return (header & 0x60) == 0 ? FrameClass::NonReference : FrameClass::Reference;
+        }
+
+        const size_t next = pos + kStartCodeSize;
+        pos = next + findAnnexBStartCode(data + next, size - next);
+    }
+    return FrameClass::Reference;
+}
+
+FrameDropPolicy::FrameDropPolicy(const FrameDropPolicyConfig& config) {
+    if (config.queueDepth == 0) {
+        throw std::invalid_argument("Frame drop policy needs a queue depth");
+    }
+    if (!(config.nonReferenceThreshold > 0.0 &&
+          config.nonReferenceThreshold <= config.gopThreshold && config.gopThreshold <= 1.0)) {
+        throw std::invalid_argument(
+            "Frame drop thresholds must satisfy 0 < non-reference <= GOP <= 1");
+    }
+
+    nonReferencePackets_ = thresholdPackets(config.queueDepth, config.nonReferenceThreshold);
+    gopPackets_ = thresholdPackets(config.queueDepth, config.gopThreshold);
+}
+
+FrameDropAction FrameDropPolicy::onVideoFrame(FrameClass frameClass, size_t queuedPackets) {
+    if (frameClass == FrameClass::Keyframe) {
+        // Decodable on its own: the episode is over
+        droppingGop_ = false;
+        keyframeRequested_ = false;
+        return FrameDropAction::Send;
+    }
+
+    if (droppingGop_) {
+        if (queuedPackets < nonReferencePackets_) {
+            requestKeyframe();
+        }
+        return FrameDropAction::Drop;
+    }
+
+    if (queuedPackets >= gopPackets_) {
+        droppingGop_ = true;
+        return FrameDropAction::Drop;
+    }
+
+    if (frameClass == FrameClass::NonReference && queuedPackets >= nonReferencePackets_) {
+        return FrameDropAction::Drop;
+    }
+    return FrameDropAction::Send;
+}
+
+void FrameDropPolicy::onOverflow() {
+    droppingGop_ = true;
+    requestKeyframe();
+}
+
+bool FrameDropPolicy::takeKeyframeRequest() {
+    const bool pending = keyframeRequestPending_;
+    keyframeRequestPending_ = false;
+    return pending;
+}
+
+void FrameDropPolicy::reset() {
+    droppingGop_ = false;
+    keyframeRequested_ = false;
+    keyframeRequestPending_ = false;
+}
+
+void FrameDropPolicy::requestKeyframe() {
+    if (!keyframeRequested_) {
+        keyframeRequested_ = true;
+        keyframeRequestPending_ = true;
+    }
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,141 @@
+/**
+ * @file frame-drop-policy.hpp
+ * @brief Congestion-aware video frame dropping for the send queue
+ *
+ * This module provides:
+ * - Classification of H.264 access units into keyframes, reference frames
+ *   and disposable (nal_ref_idc == 0) frames from the first slice header
+ * - A staged drop policy driven by send queue occupancy: disposable frames
+ *   first, then the rest of the GOP, then a request for a fresh keyframe
+ */
+
+#pragma once
+
+#include "constants.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief What losing a video frame costs the decoder
+ */
+enum class FrameClass {
+    Keyframe,     ///< Decodable on its own; ends any dropping
+    Reference,    ///< Later frames predict from it; dropping breaks the GOP
+    NonReference  ///< Nothing predicts from it; safe to drop
+};
+
+/**
+ * @brief Classify an H.264 Annex-B access unit
+ *
+ * Looks at the NAL header of the first slice only: all slices of a picture
+ * share its nal_ref_idc, so the scan stops early and stays cheap.
+ *
+ * @param data Annex-B access unit
+ * @param size Size in bytes
+ * @return Keyframe for IDR slices, NonReference for nal_ref_idc == 0 slices,
+ *         Reference otherwise (including access units without a slice)
+ */
+FrameClass classifyH264Frame(const uint8_t* data, size_t size);
+
+/**
+ * @brief Configuration for FrameDropPolicy
+ */
+struct FrameDropPolicyConfig {
+    size_t queueDepth = constants::kDefaultSendQueueDepth;  // packets
+    // Queue fill, as a fraction of queueDepth, at which each stage starts
+    double nonReferenceThreshold = constants::kDefaultNonReferenceDropThreshold;
+    double gopThreshold = constants::kDefaultGopDropThreshold;
+};
+
+/**
+ * @brief Decision for one video frame
+ */
+enum class FrameDropAction {
+    Send,
+    Drop
+};
+
+/**
+ * @brief Staged load shedding for video frames entering a send queue
+ *
+ * Below nonReferenceThreshold every frame is sent. Above it, disposable
+ * frames are dropped; nothing else depends on them, so the picture only
+ * loses smoothness. Above gopThreshold, or when the queue overflows, every
+ * frame up to the next keyframe is dropped, since the first lost reference
+ * frame makes the rest of the GOP undecodable anyway. A keyframe request is
+ * then raised once per episode: right away on overflow, otherwise once the
+ * queue has drained below nonReferenceThreshold, so the viewer does not wait
+ * for the encoder's next scheduled keyframe.
+ *
+ * Audio is never passed to the policy. Not thread-safe: meant to be driven
+ * by the single thread feeding the queue.
+ *
+ * Example usage:
+ * @code
+ * FrameDropPolicy policy(config);
+ *
+ * if (policy.onVideoFrame(classifyH264Frame(data, size), queue.size()) == FrameDropAction::Drop) {
+ *     dropped++;
+ * } else if (!queue.tryPush(frame)) {
+ *     policy.onOverflow();
+ * }
+ * if (policy.takeKeyframeRequest()) encoder.requestKeyframe();
+ * @endcode
+ */
+class FrameDropPolicy {
+public:
+    /**
+     * @brief Construct a policy
+     * @param config Policy configuration
+     * @throws std::invalid_argument if queueDepth is 0 or the thresholds do not
+     *         satisfy 0 < nonReferenceThreshold <= gopThreshold <= 1
+     */
+    explicit FrameDropPolicy(const FrameDropPolicyConfig& config = FrameDropPolicyConfig());
+
+    /**
+     * @brief Decide whether to queue a video frame
+     * @param frameClass Class of the frame
+     * @param queuedPackets Packets in the queue before this frame
+     * @return Drop if the frame should be discarded
+     */
+    FrameDropAction onVideoFrame(FrameClass frameClass, size_t queuedPackets);
+
+    /**
+     * @brief Report that the queue rejected a keyframe or reference frame
+     *
+     * Drops the rest of the GOP and raises a keyframe request.
+     */
+    void onOverflow();
+
+    /**
+     * @brief Take the pending keyframe request, if any
+     * @return true at most once per dropping episode
+     */
+    bool takeKeyframeRequest();
+
+    /**
+     * @brief Check whether frames are being dropped until the next keyframe
+     */
+    bool isDroppingGop() const { return droppingGop_; }
+
+    /**
+     * @brief Forget any dropping episode (e.g. on restart)
+     */
+    void reset();
+
+private:
+    void requestKeyframe();
+
+    size_t nonReferencePackets_;
+    size_t gopPackets_;
+    bool droppingGop_ = false;
+    bool keyframeRequested_ = false;  // Raised during this episode
+    bool keyframeRequestPending_ = false;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,250 @@
+/**
+ * @file frame-queue.hpp
+ * @brief Bounded, drop-aware frame queue for the receive side
+ *
+ * This module provides:
+ * - A fixed-capacity FIFO of received frames between the network thread and
+ *   the consumer, so a stalled consumer cannot grow latency or memory
+ * - Keyframe-aware overflow handling for video: disposable frames go first,
+ *   and once a reference frame is lost the rest of the GOP is skipped and the
+ *   next keyframe replaces whatever is still queued
+ * - Drop-oldest overflow handling for independent frames such as audio
+ * - Depth, high-water mark and drop counters for diagnostics
+ */
+
+#pragma once
+
+#include "frame-drop-policy.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Counters for a FrameQueue
+ */
+struct FrameQueueStats {
+    size_t depth = 0;     // Frames currently queued
+    size_t capacity = 0;  // Maximum number of queued frames
+    size_t maxDepth = 0;  // Highest depth seen
+    uint64_t pushed = 0;   // Frames offered to the queue
+    uint64_t dropped = 0;  // Frames discarded, incoming or evicted
+};
+
+/**
+ * @brief Bounded FIFO of received frames with keyframe-aware dropping
+ *
+ * Storage is allocated once at construction; popped slots are reset, so
+ * frames holding pooled buffers give them back as soon as they leave the
+ * queue. When the queue is full:
+ *
+ * - pushVideo() first evicts the oldest queued NonReference frame, since
+ *   nothing predicts from it. An incoming NonReference frame is dropped
+ *   instead. An incoming Reference frame that does not fit is dropped and,
+ *   because every later frame of the GOP predicts from it, so are all
+ *   following non-keyframes. An incoming keyframe never waits: it discards
+ *   the queued backlog, which it supersedes, so the consumer jumps straight
+ *   to the newest decodable picture.
+ * - push() evicts the oldest frame, for frames that decode independently.
+ *
+ * Thread-safe; meant for one producer (the network thread) and one consumer
+ * (the render or tick thread).
+ *
+ * Example usage:
+ * @code
+ * FrameQueue<VideoFrame> queue(constants::kDefaultSourceVideoQueueFrames);
+ *
+ * // Network thread
+ * queue.pushVideo(frame, classifyH264Frame(frame.data.data(), frame.data.size()));
+ *
+ * // Render thread: drain, showing only the newest frame
+ * VideoFrame frame;
+ * while (queue.pop(frame)) {
+ *     latest = std::move(frame);
+ * }
+ * @endcode
+ *
+ * @tparam Frame Frame type; must be default constructible and move assignable
+ */
+template <typename Frame>
+class FrameQueue {
+public:
+    /**
+     * @brief Construct a queue holding at most @p capacity frames
+     * @param capacity Maximum number of queued frames
+     * @throws std::invalid_argument if capacity is 0
+     */
+    explicit FrameQueue(size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("FrameQueue capacity must be positive");
+        }
+        slots_.resize(capacity);
+        classes_.resize(capacity, FrameClass::Reference);
+    }
+
+    FrameQueue(const FrameQueue&) = delete;
+    FrameQueue& operator=(const FrameQueue&) = delete;
+
+    /**
+     * @brief Queue a video frame, dropping by decoder impact on overflow
+     * @param frame Frame to queue
+     * @param frameClass Class of the frame, e.g. from classifyH264Frame()
+     * @return false if the incoming frame was dropped
+     */
+    bool pushVideo(Frame frame, FrameClass frameClass) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.pushed++;
+
+        if (frameClass == FrameClass::Keyframe) {
+            awaitingKeyframe_ = false;
+            if (count_ == slots_.size()) {
+                stats_.dropped += count_;
+                clearLocked();
+            }
+            appendLocked(std::move(frame), frameClass);
+            return true;
+        }
+
+        if (awaitingKeyframe_) {
+            stats_.dropped++;
+            return false;
+        }
+
+        if (count_ == slots_.size()) {
+            if (frameClass == FrameClass::NonReference || !evictNonReferenceLocked()) {
+                // A lost reference frame makes the rest of the GOP undecodable
+                awaitingKeyframe_ = frameClass == FrameClass::Reference;
+                stats_.dropped++;
+                return false;
+            }
+        }
+
+        appendLocked(std::move(frame), frameClass);
+        return true;
+    }
+
+    /**
+     * @brief Queue an independently decodable frame, evicting the oldest on overflow
+     * @param frame Frame to queue
+     */
+    void push(Frame frame) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.pushed++;
+
+        if (count_ == slots_.size()) {
+            slots_[head_] = Frame();
+            head_ = (head_ + 1) % slots_.size();
+            count_--;
+            stats_.dropped++;
+        }
+        appendLocked(std::move(frame), FrameClass::Keyframe);
+    }
+
+    /**
+     * @brief Take the oldest queued frame
+     * @param out Receives the frame
+     * @return false if the queue was empty
+     */
+    bool pop(Frame& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_ == 0) {
+            return false;
+        }
+        out = std::move(slots_[head_]);
+        slots_[head_] = Frame();
+        head_ = (head_ + 1) % slots_.size();
+        count_--;
+        return true;
+    }
+
+    /**
+     * @brief Get the number of queued frames
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+    /**
+     * @brief Check whether video frames are skipped until the next keyframe
+     */
+    bool isAwaitingKeyframe() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return awaitingKeyframe_;
+    }
+
+    /**
+     * @brief Get the queue's counters
+     */
+    FrameQueueStats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        FrameQueueStats stats = stats_;
+        stats.depth = count_;
+        stats.capacity = slots_.size();
+        return stats;
+    }
+
+    /**
+     * @brief Discard all queued frames (e.g. on restart); counters are kept
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clearLocked();
+        awaitingKeyframe_ = false;
+    }
+
+private:
+    size_t slotIndex(size_t position) const { return (head_ + position) % slots_.size(); }
+
+    void appendLocked(Frame&& frame, FrameClass frameClass) {
+        const size_t index = slotIndex(count_);
+        slots_[index] = std::move(frame);
+        classes_[index] = frameClass;
+        count_++;
+        stats_.maxDepth = std::max(stats_.maxDepth, count_);
+    }
+
+    bool evictNonReferenceLocked() {
+        for (size_t position = 0; position < count_; position++) {
+            if (classes_[slotIndex(position)] != FrameClass::NonReference) {
+                continue;
+            }
+            // Close the gap, keeping the remaining frames in order
+            for (size_t next = position + 1; next < count_; next++) {
+                slots_[slotIndex(next - 1)] = std::move(slots_[slotIndex(next)]);
+                classes_[slotIndex(next - 1)] = classes_[slotIndex(next)];
+            }
+            count_--;
+            slots_[slotIndex(count_)] = Frame();
+            stats_.dropped++;
+            return true;
+        }
+        return false;
+    }
+
+    void clearLocked() {
+        for (size_t position = 0; position < count_; position++) {
+            slots_[slotIndex(position)] = Frame();
+        }
+        head_ = 0;
+        count_ = 0;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<Frame> slots_;
+    std::vector<FrameClass> classes_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    bool awaitingKeyframe_ = false;
+    FrameQueueStats stats_;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,136 @@
+/**
+ * @file h264-parameter-sets.cpp
+ * @brief Implementation of the H.264 SPS/PPS cache
+ */
+
+#include "h264-parameter-sets.hpp"
+
+#include <algorithm>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+constexpr uint8_t kH264NalTypeIdr = 5;
+constexpr uint8_t kH264NalTypeSps = 7;
+constexpr uint8_t kH264NalTypePps = 8;
+constexpr uint8_t kH264NalTypeStapA = 24;
+
+constexpr uint8_t kAvcCVersion = 1;
+constexpr size_t kAvcCHeaderSize = 6;  // Up to and including numOfSequenceParameterSets
+constexpr size_t kStapASizeFieldSize = 2;
+constexpr size_t kMaxStapANalSize = 0xFFFF;
+
+uint16_t readU16(const uint8_t* data) {
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+}  // namespace
+
+bool H264ParameterSetCache::setExtradata(const uint8_t* data, size_t size) {
+    reset();
+    if (!data || size == 0) {
+        return false;
+    }
+
+    if (data[0] == kAvcCVersion && size >= kAvcCHeaderSize) {
+        // AVCDecoderConfigurationRecord (ISO/IEC 14496-15, 5.2.4.1)
+        size_t offset = kAvcCHeaderSize;
+        const size_t spsCount = data[5] & 0x1F;
+        for (size_t set = 0; set < 2; set++) {
+            const size_t count = set == 0 ? spsCount : (offset < size ? data[offset++] : 0);
+            for (size_t i = 0; i < count; i++) {
+                if (offset + 2 > size) {
+                    break;
+                }
+                const size_t length = readU16(data + offset);
+                offset += 2;
+                if (length == 0 || offset + length > size) {
+                    break;
+                }
+                store(set == 0 ? sps_ : pps_, data + offset, length);
+                offset += length;
+            }
+        }
+    } else {
+        for (const auto& nal : splitAnnexB(data, size)) {
+            if (nal.h264Type() == kH264NalTypeSps) {
+                store(sps_, nal.data, nal.size);
+            } else if (nal.h264Type() == kH264NalTypePps) {
+                store(pps_, nal.data, nal.size);
+            }
+        }
+    }
+
+    buildStapA();
+    return hasParameterSets();
+}
+
+bool H264ParameterSetCache::update(const std::vector<NalUnitView>& accessUnit) {
+    bool hasIdr = false;
+    bool hasSps = false;
+    bool hasPps = false;
+
+    for (const auto& nal : accessUnit) {
+        switch (nal.h264Type()) {
+            case kH264NalTypeIdr:
+                hasIdr = true;
+                break;
+            case kH264NalTypeSps:
+                hasSps = true;
+                store(sps_, nal.data, nal.size);
+                break;
+            case kH264NalTypePps:
+                hasPps = true;
+                store(pps_, nal.data, nal.size);
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (dirty_) {
+        buildStapA();
+    }
+    return hasIdr && !(hasSps && hasPps) && hasParameterSets();
+}
+
+void H264ParameterSetCache::reset() {
+    sps_.clear();
+    pps_.clear();
+    stapA_.clear();
+    dirty_ = false;
+}
+
+void H264ParameterSetCache::store(std::vector<uint8_t>& slot, const uint8_t* nal, size_t size) {
+    if (size == 0 || size > kMaxStapANalSize) {
+        return;
+    }
+    if (slot.size() == size && std::equal(slot.begin(), slot.end(), nal)) {
+        return;  // Repeated unchanged, the common case
+    }
+    slot.assign(nal, nal + size);
+    dirty_ = true;
+}
+
+void H264ParameterSetCache::buildStapA() {
+    dirty_ = false;
+    stapA_.clear();
+    if (!hasParameterSets()) {
+        return;
+    }
+
+    // F = 0, NRI = the highest of the aggregated units (RFC 6184, 5.7.1)
+    const uint8_t nri = std::max(sps_[0] & 0x60, pps_[0] & 0x60);
+    stapA_.reserve(1 + 2 * kStapASizeFieldSize + sps_.size() + pps_.size());
+    stapA_.push_back(static_cast<uint8_t>(nri | kH264NalTypeStapA));
+    for (const auto* nal : {&sps_, &pps_}) {
+        stapA_.push_back(static_cast<uint8_t>(nal->size() >> 8));
+        stapA_.push_back(static_cast<uint8_t>(nal->size()));
+        stapA_.insert(stapA_.end(), nal->begin(), nal->end());
+    }
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,98 @@
+/**
+ * @file h264-parameter-sets.hpp
+ * @brief H.264 SPS/PPS cache for repeating parameter sets ahead of IDRs
+ *
+ * This module provides:
+ * - Parsing of encoder extradata (Annex-B or avcC) into SPS and PPS
+ * - Tracking of in-band parameter set updates from the access units sent
+ * - A prebuilt STAP-A payload (RFC 6184, section 5.7.1) carrying the
+ *   cached SPS and PPS, to send ahead of IDRs that arrive without them
+ */
+
+#pragma once
+
+#include "nal-parser.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Cache of the current H.264 SPS and PPS
+ *
+ * Some OBS encoders only put SPS/PPS in their extradata, so a receiver that
+ * joins mid-stream (e.g. a late SFU subscriber) cannot decode anything until
+ * the stream restarts. The cache is seeded from the extradata, follows the
+ * parameter sets the encoder sends in-band, and tells the packetizer when an
+ * IDR needs them repeated. Holds one SPS and one PPS, as OBS's single-layer
+ * encoders emit.
+ *
+ * Not thread-safe: use one instance per packetizer, from one thread at a time.
+ *
+ * Example usage:
+ * @code
+ * H264ParameterSetCache cache;
+ * cache.setExtradata(extraData, extraDataSize);
+ *
+ * splitAnnexB(frame, size, nalUnits);
+ * if (cache.update(nalUnits)) {
+ *     sendPayload(cache.stapA());  // Before the frame's own payloads
+ * }
+ * @endcode
+ */
+class H264ParameterSetCache {
+public:
+    /**
+     * @brief Seed the cache from encoder extradata
+     *
+     * Accepts Annex-B (start code prefixed NAL units) and avcC
+     * (AVCDecoderConfigurationRecord). Replaces whatever was cached.
+     *
+     * @param data Extradata
+     * @param size Size in bytes
+     * @return true if both an SPS and a PPS were found
+     */
+    bool setExtradata(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Observe one access unit about to be sent
+     *
+     * In-band SPS/PPS replace the cached ones.
+     *
+     * @param accessUnit NAL units of the access unit, in stream order
+     * @return true if the access unit has an IDR slice but lacks an SPS or a
+     *         PPS, and the cache holds both: send stapA() ahead of it
+     */
+    bool update(const std::vector<NalUnitView>& accessUnit);
+
+    /**
+     * @brief Check whether both an SPS and a PPS are cached
+     */
+    bool hasParameterSets() const { return !sps_.empty() && !pps_.empty(); }
+
+    /**
+     * @brief Get the STAP-A payload carrying the cached SPS and PPS
+     * @return Payload bytes, empty until hasParameterSets()
+     */
+    const std::vector<uint8_t>& stapA() const { return stapA_; }
+
+    /**
+     * @brief Forget the cached parameter sets
+     */
+    void reset();
+
+private:
+    void store(std::vector<uint8_t>& slot, const uint8_t* nal, size_t size);
+    void buildStapA();
+
+    std::vector<uint8_t> sps_;
+    std::vector<uint8_t> pps_;
+    std::vector<uint8_t> stapA_;  // Rebuilt only when a parameter set changes
+    bool dirty_ = false;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -8,12 +8,35 @@
 
 #include "http-client.hpp"
 
+#include <mutex>
 #include <stdexcept>
+#include <utility>
 
 namespace obswebrtc {
 namespace core {
 
+namespace {
+
+std::mutex transportMutex;
+HTTPTransport transportOverride;  // Guarded by transportMutex
+
+HTTPTransport currentTransport() {
+    std::lock_guard<std::mutex> lock(transportMutex);
+    return transportOverride;
+}
+
+}  // namespace
+
+void HTTPClient::setTransport(HTTPTransport transport) {
+    std::lock_guard<std::mutex> lock(transportMutex);
+    transportOverride = std::move(transport);
+}
+
 HTTPResponse HTTPClient::post(const std::string& url, const HTTPRequest& request) {
+    if (HTTPTransport transport = currentTransport()) {
+        return transport("POST", url, request);
+    }
+
     // Stub implementation for testing
     // In production, implement using libcurl or similar HTTP client
     HTTPResponse response;
@@ -85,6 +108,10 @@ HTTPResponse HTTPClient::post(const std::string& url, const HTTPRequest& request
 }
 
 HTTPResponse HTTPClient::patch(const std::string& url, const HTTPRequest& request) {
+    if (HTTPTransport transport = currentTransport()) {
+        return transport("PATCH", url, request);
+    }
+
     // Stub implementation for testing
     HTTPResponse response;
     response.statusCode = 204;  // No Content
@@ -92,6 +119,10 @@ HTTPResponse HTTPClient::patch(const std::string& url, const HTTPRequest& reques
 }
 
 HTTPResponse HTTPClient::del(const std::string& url, const HTTPRequest& request) {
+    if (HTTPTransport transport = currentTransport()) {
+        return transport("DELETE", url, request);
+    }
+
     // Stub implementation for testing
     HTTPResponse response;
     response.statusCode = 200;
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -32,6 +33,17 @@ struct HTTPResponse {
     std::string body;
 };
 
+/**
+ * @brief Replacement transport for HTTPClient requests
+ *
+ * Receives the method ("POST", "PATCH" or "DELETE"), the URL and the
+ * request, and returns the response or throws std::runtime_error like a
+ * network error would. Tests and benchmarks use it to put a fake server
+ * behind WHIPClient/WHEPClient, e.g. one with a realistic round trip.
+ */
+using HTTPTransport = std::function<HTTPResponse(const std::string& method, const std::string& url,
+                                                 const HTTPRequest& request)>;
+
 /**
  * @brief HTTP client utility class
  *
@@ -67,6 +79,15 @@ public:
      * @throws std::runtime_error on network errors
      */
     static HTTPResponse del(const std::string& url, const HTTPRequest& request);
+
+    /**
+     * @brief Route every request through a replacement transport
+     *
+     * Applies process-wide to requests started after the call. Thread-safe.
+     *
+     * @param transport Transport to use; empty restores the built-in one
+     */
+    static void setTransport(HTTPTransport transport);
 };
 
 }  // namespace core
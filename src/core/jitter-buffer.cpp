@@ -0,0 +1,628 @@
+/**
+ * @file jitter-buffer.cpp
+ * @brief Implementation of the adaptive receive jitter buffer
+ */
+
+#include "jitter-buffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+// Share of recent transits the target delay covers. Set high because a
+// frame is only complete once its slowest packet is in.
+constexpr double kDelayPercentile = 0.99;
+
+// Fraction of the gap closed per frame when the target delay shrinks
+constexpr double kDelayDecay = 0.02;
+
+// RFC 3550, 6.4.1: jitter estimate gain
+constexpr double kJitterGain = 1.0 / 16.0;
+
+constexpr uint8_t kNalTypeMask = 0x1F;
+constexpr uint8_t kNalStapA = 24;
+constexpr uint8_t kNalFuA = 28;
+constexpr uint8_t kFuStartBit = 0x80;
+constexpr uint8_t kStartCode[4] = {0x00, 0x00, 0x00, 0x01};
+
+// RFC 7741, 4.2: VP8 payload descriptor bits
+constexpr uint8_t kVp8Extended = 0x80;          // X
+constexpr uint8_t kVp8StartOfPartition = 0x10;  // S
+constexpr uint8_t kVp8PartitionMask = 0x07;     // PID
+constexpr uint8_t kVp8PictureId = 0x80;         // I
+constexpr uint8_t kVp8Tl0PicIdx = 0x40;         // L
+constexpr uint8_t kVp8TidKeyIdx = 0x30;         // T|K
+constexpr uint8_t kVp8LongPictureId = 0x80;     // M
+
+// RFC 9628, 4.2: VP9 payload descriptor bits
+constexpr uint8_t kVp9PictureId = 0x80;      // I
+constexpr uint8_t kVp9InterPicture = 0x40;   // P
+constexpr uint8_t kVp9Layers = 0x20;         // L
+constexpr uint8_t kVp9FlexibleMode = 0x10;   // F
+constexpr uint8_t kVp9StartOfFrame = 0x08;   // B
+constexpr uint8_t kVp9Scalability = 0x02;    // V
+constexpr uint8_t kVp9LongPictureId = 0x80;  // M
+constexpr uint8_t kVp9MoreDiffs = 0x01;      // N in a P_DIFF byte
+constexpr uint8_t kVp9SpatialLayersShift = 5;
+constexpr uint8_t kVp9Resolutions = 0x10;   // Y
+constexpr uint8_t kVp9PictureGroup = 0x08;  // G
+constexpr uint8_t kVp9ReferenceCountShift = 2;
+constexpr uint8_t kVp9ReferenceCountMask = 0x03;
+
+/**
+ * @brief Walk the NAL units of a frame's H.264 payloads
+ *
+ * Calls sink.nal(header, data, size) for every NAL unit start and
+ * sink.append(data, size) for the rest of a fragmented one.
+ */
+template <typename Sink>
+void walkH264Payloads(const JitterFrame& frame, Sink& sink) {
+    bool inFragment = false;
+
+    for (const BufferSlice& payload : frame.payloads) {
+        const uint8_t* data = payload.data();
+        const size_t size = payload.size();
+        if (size == 0) {
+            continue;
+        }
+
+        const uint8_t type = data[0] & kNalTypeMask;
+        if (type == kNalFuA) {
+            if (size < 2) {
+                inFragment = false;
+                continue;
+            }
+            if (data[1] & kFuStartBit) {
+                const uint8_t header =
+                    static_cast<uint8_t>((data[0] & 0xE0) | (data[1] & kNalTypeMask));
+                sink.nal(header, data + 2, size - 2);
+                inFragment = true;
+            } else if (inFragment) {
+                sink.append(data + 2, size - 2);
+            }
+            continue;
+        }
+
+        inFragment = false;
+        if (type == kNalStapA) {
+            size_t offset = 1;
+            while (offset + 2 <= size) {
+                const size_t length = (static_cast<size_t>(data[offset]) << 8) | data[offset + 1];
+                offset += 2;
+                if (length == 0 || offset + length > size) {
+                    break;
+                }
+                sink.nal(data[offset], data + offset + 1, length - 1);
+                offset += length;
+            }
+        } else if (type >= 1 && type <= 23) {
+            sink.nal(data[0], data + 1, size - 1);
+        }
+    }
+}
+
+struct SizeSink {
+    void nal(uint8_t, const uint8_t*, size_t size) { total += sizeof(kStartCode) + 1 + size; }
+    void append(const uint8_t*, size_t size) { total += size; }
+
+    size_t total = 0;
+};
+
+struct WriteSink {
+    void nal(uint8_t header, const uint8_t* data, size_t size) {
+        std::memcpy(out, kStartCode, sizeof(kStartCode));
+        out += sizeof(kStartCode);
+        *out++ = header;
+        append(data, size);
+    }
+
+    void append(const uint8_t* data, size_t size) {
+        std::memcpy(out, data, size);
+        out += size;
+    }
+
+    uint8_t* out;
+};
+
+/**
+ * @brief Get the size of the VP8 payload descriptor (RFC 7741, 4.2)
+ * @return The descriptor size, or 0 if the payload is malformed
+ */
+size_t vp8DescriptorSize(const uint8_t* data, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t offset = 1;
+    if (data[0] & kVp8Extended) {
+        if (size < 2) {
+            return 0;
+        }
+        const uint8_t extension = data[1];
+        offset = 2;
+        if (extension & kVp8PictureId) {
+            if (offset >= size) {
+                return 0;
+            }
+            offset += (data[offset] & kVp8LongPictureId) ? 2 : 1;
+        }
+        if (extension & kVp8Tl0PicIdx) {
+            offset++;
+        }
+        if (extension & kVp8TidKeyIdx) {
+            offset++;
+        }
+    }
+    return offset < size ? offset : 0;
+}
+
+/**
+ * @brief Get the size of the VP9 payload descriptor (RFC 9628, 4.2)
+ * @return The descriptor size, or 0 if the payload is malformed
+ */
+size_t vp9DescriptorSize(const uint8_t* data, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    const uint8_t flags = data[0];
+    size_t offset = 1;
+    if (flags & kVp9PictureId) {
+        if (offset >= size) {
+            return 0;
+        }
+        offset += (data[offset] & kVp9LongPictureId) ? 2 : 1;
+    }
+    if (flags & kVp9Layers) {
+        // Layer indices, plus TL0PICIDX in non-flexible mode
+        offset += (flags & kVp9FlexibleMode) ? 1 : 2;
+    }
+    if ((flags & kVp9FlexibleMode) && (flags & kVp9InterPicture)) {
+        // Reference indices (P_DIFF), up to three
+        for (int count = 0;; count++) {
+            if (offset >= size || count == 3) {
+                return 0;
+            }
+            if (!(data[offset++] & kVp9MoreDiffs)) {
+                break;
+            }
+        }
+    }
+    if (flags & kVp9Scalability) {
+        if (offset >= size) {
+            return 0;
+        }
+        const uint8_t header = data[offset++];
+        if (header & kVp9Resolutions) {
+            const size_t spatialLayers = (header >> kVp9SpatialLayersShift) + 1;
+            offset += spatialLayers * 4;  // WIDTH and HEIGHT per layer
+        }
+        if (header & kVp9PictureGroup) {
+            if (offset >= size) {
+                return 0;
+            }
+            const size_t pictures = data[offset++];
+            for (size_t picture = 0; picture < pictures; picture++) {
+                if (offset >= size) {
+                    return 0;
+                }
+                const uint8_t references =
+                    (data[offset] >> kVp9ReferenceCountShift) & kVp9ReferenceCountMask;
+                offset += 1 + references;
+            }
+        }
+    }
+    return offset < size ? offset : 0;
+}
+
+/**
+ * @brief Reassemble a frame whose payloads are one descriptor plus a slice of
+ *        the frame each (VP8, VP9)
+ */
+BufferSlice assembleDescribedFrame(const JitterFrame& frame, BufferPool& pool,
+                                   size_t (*descriptorSize)(const uint8_t*, size_t)) {
+    size_t total = 0;
+    for (const BufferSlice& payload : frame.payloads) {
+        const size_t skip = descriptorSize(payload.data(), payload.size());
+        if (skip > 0) {
+            total += payload.size() - skip;
+        }
+    }
+    if (total == 0) {
+        return BufferSlice();
+    }
+
+    PooledBuffer buffer = pool.acquire(total);
+    WriteSink writer{buffer.data()};
+    for (const BufferSlice& payload : frame.payloads) {
+        const size_t skip = descriptorSize(payload.data(), payload.size());
+        if (skip > 0) {
+            writer.append(payload.data() + skip, payload.size() - skip);
+        }
+    }
+    return std::move(buffer).share();
+}
+
+}  // namespace
+
+JitterBuffer::JitterBuffer(const JitterBufferConfig& config) : config_(config) {
+    if (config_.minDelayMs < 0 || config_.maxDelayMs < config_.minDelayMs) {
+        throw std::invalid_argument("Jitter buffer delay bounds must satisfy 0 <= min <= max");
+    }
+    if (config_.clockRate == 0) {
+        throw std::invalid_argument("Jitter buffer clock rate must be positive");
+    }
+    if (config_.capacity == 0) {
+        throw std::invalid_argument("Jitter buffer capacity must be positive");
+    }
+
+    slots_.resize(config_.capacity);
+    transits_.reserve(constants::kJitterBufferDelaySamples);
+    scratch_.reserve(constants::kJitterBufferDelaySamples);
+    targetDelayMs_ = config_.minDelayMs;
+}
+
+bool JitterBuffer::insert(uint16_t sequence, uint32_t timestamp, bool marker, BufferSlice payload,
+                          int64_t arrivalMs) {
+    stats_.packetsReceived++;
+
+    int64_t extSequence = sequence;
+    int64_t extTimestamp = timestamp;
+    bool newFrame = false;
+    if (!started_) {
+        started_ = true;
+        cursor_ = extSequence;
+        highestSequence_ = extSequence;
+        highestTimestamp_ = extTimestamp;
+        newFrame = true;
+    } else {
+        // Unwrap relative to the latest packet: the nearer of the candidates wins
+        extSequence = highestSequence_ +
+                      static_cast<int16_t>(sequence - static_cast<uint16_t>(highestSequence_));
+        extTimestamp = lastTimestamp_ +
+                       static_cast<int32_t>(timestamp - static_cast<uint32_t>(lastTimestamp_));
+    }
+    const int64_t capacity = static_cast<int64_t>(config_.capacity);
+
+    if (extSequence < cursor_) {
+        // Before the first release the stream may simply have started earlier
+        if (released_ || highestSequence_ - extSequence >= capacity) {
+            stats_.packetsLate++;
+            return false;
+        }
+        cursor_ = extSequence;
+    } else if (extSequence >= cursor_ + capacity) {
+        // Too far ahead to keep alongside the backlog: give the backlog up.
+        // Packets were skipped even with nothing buffered, so the new cursor
+        // may be mid-frame.
+        if (buffered_ > 0) {
+            discard(cursor_, highestSequence_ + 1);
+            discontinuity_ = true;
+        }
+        if (released_) {
+            stats_.framesLost++;
+            discontinuity_ = true;
+            resynchronizing_ = true;
+        }
+        cursor_ = extSequence;
+        highestSequence_ = extSequence;
+    }
+
+    Slot& slot = slots_[slotIndex(extSequence)];
+    if (slot.used) {
+        stats_.packetsDuplicate++;
+        return false;
+    }
+    if (extSequence < highestSequence_) {
+        stats_.packetsReordered++;
+    }
+
+    slot.used = true;
+    slot.sequence = extSequence;
+    slot.timestamp = extTimestamp;
+    slot.marker = marker;
+    slot.frameStart =
+        config_.singlePacketFrames ||
+        (config_.isFrameStart && config_.isFrameStart(payload.data(), payload.size()));
+    slot.payload = std::move(payload);
+    buffered_++;
+
+    highestSequence_ = std::max(highestSequence_, extSequence);
+    lastTimestamp_ = extTimestamp;
+    if (extTimestamp > highestTimestamp_) {
+        highestTimestamp_ = extTimestamp;
+        newFrame = true;
+    }
+
+    updateDelay(static_cast<double>(arrivalMs) - rtpMs(extTimestamp), newFrame);
+    return true;
+}
+
+bool JitterBuffer::pop(int64_t nowMs, JitterFrame& frame) {
+    for (;;) {
+        const Plan next = plan();
+        if (next.action == Action::Wait || nowMs < next.atMs) {
+            return false;
+        }
+
+        const bool startup = !released_ || resynchronizing_;
+        released_ = true;
+        resynchronizing_ = false;
+        if (next.action == Action::Skip) {
+            discard(cursor_, next.end);
+            cursor_ = next.end;
+            if (!startup) {
+                stats_.framesLost++;
+            }
+            discontinuity_ = true;
+            continue;
+        }
+
+        const int64_t timestamp = find(cursor_)->timestamp;
+        frame.timestamp = static_cast<uint32_t>(timestamp);
+        frame.payloads.clear();
+        for (int64_t sequence = cursor_; sequence <= next.end; sequence++) {
+            Slot& slot = slots_[slotIndex(sequence)];
+            frame.payloads.push_back(std::move(slot.payload));
+            slot.payload = BufferSlice();
+            slot.used = false;
+            buffered_--;
+        }
+        frame.discontinuity = discontinuity_;
+        discontinuity_ = false;
+        cursor_ = next.end + 1;
+
+        stats_.framesReleased++;
+        stats_.currentDelayMs = static_cast<int>(
+            std::llround(static_cast<double>(nowMs) - (rtpMs(timestamp) + baselineMs_)));
+        return true;
+    }
+}
+
+int64_t JitterBuffer::nextReleaseMs() const {
+    const Plan next = plan();
+    return next.action == Action::Wait ? -1 : next.atMs;
+}
+
+JitterBufferStats JitterBuffer::getStats() const {
+    JitterBufferStats stats = stats_;
+    stats.targetDelayMs = static_cast<int>(std::llround(targetDelayMs_));
+    return stats;
+}
+
+void JitterBuffer::reset() {
+    for (Slot& slot : slots_) {
+        slot = Slot();
+    }
+    buffered_ = 0;
+    started_ = false;
+    released_ = false;
+    resynchronizing_ = false;
+    discontinuity_ = false;
+    cursor_ = 0;
+    highestSequence_ = 0;
+    lastTimestamp_ = 0;
+    highestTimestamp_ = 0;
+
+    transits_.clear();
+    transitIndex_ = 0;
+    baselineMs_ = 0.0;
+    targetDelayMs_ = config_.minDelayMs;
+    haveFrameTransit_ = false;
+    stats_.currentDelayMs = 0;
+    stats_.jitterMs = 0.0;
+}
+
+JitterBuffer::Plan JitterBuffer::plan() const {
+    Plan next;
+    if (buffered_ == 0) {
+        return next;
+    }
+
+    // Before the first release, or after a jump, the cursor may be the
+    // middle of a frame whose start was never received
+    const Slot* first = find(cursor_);
+    if (first && ((released_ && !resynchronizing_) || first->frameStart)) {
+        // Walk the frame at the cursor while its packets are contiguous
+        int64_t sequence = cursor_;
+        for (const Slot* slot = first; slot; slot = find(++sequence)) {
+            if (slot->timestamp != first->timestamp) {
+                next.end = sequence - 1;  // Marker lost, but the next frame began
+                break;
+            }
+            if (slot->marker || config_.singlePacketFrames) {
+                next.end = sequence;
+                break;
+            }
+        }
+        if (find(sequence)) {
+            next.action = Action::Release;
+            next.atMs = playoutMs(first->timestamp);
+            return next;
+        }
+
+        // A packet is missing: the frame is given up at its playout time,
+        // provided we can tell where the next frame starts
+        const int64_t boundary = nextBoundary(sequence);
+        if (boundary >= 0) {
+            next.action = Action::Skip;
+            next.atMs = playoutMs(first->timestamp);
+            next.end = boundary;
+        }
+        return next;
+    }
+
+    // The start of the frame is missing: skip to the first frame that
+    // begins after the earliest packet we do have
+    int64_t present = cursor_;
+    while (present <= highestSequence_ && !find(present)) {
+        present++;
+    }
+    const int64_t boundary = nextBoundary(present);
+    if (present <= highestSequence_ && boundary >= 0) {
+        next.action = Action::Skip;
+        next.atMs = playoutMs(find(present)->timestamp);
+        next.end = boundary;
+    }
+    return next;
+}
+
+const JitterBuffer::Slot* JitterBuffer::find(int64_t sequence) const {
+    const Slot& slot = slots_[slotIndex(sequence)];
+    return slot.used && slot.sequence == sequence ? &slot : nullptr;
+}
+
+int64_t JitterBuffer::nextBoundary(int64_t from) const {
+    for (int64_t sequence = from; sequence <= highestSequence_; sequence++) {
+        const Slot* slot = find(sequence);
+        if (!slot) {
+            continue;
+        }
+        if (slot->frameStart) {
+            return sequence;
+        }
+        const Slot* previous = find(sequence - 1);
+        if (previous && (previous->marker || previous->timestamp != slot->timestamp)) {
+            return sequence;
+        }
+    }
+    return -1;
+}
+
+size_t JitterBuffer::slotIndex(int64_t sequence) const {
+    const int64_t capacity = static_cast<int64_t>(config_.capacity);
+    return static_cast<size_t>(((sequence % capacity) + capacity) % capacity);
+}
+
+double JitterBuffer::rtpMs(int64_t timestamp) const {
+    return static_cast<double>(timestamp) * 1000.0 / config_.clockRate;
+}
+
+int64_t JitterBuffer::playoutMs(int64_t timestamp) const {
+    return std::llround(rtpMs(timestamp) + baselineMs_ + targetDelayMs_);
+}
+
+void JitterBuffer::updateDelay(double transitMs, bool newFrame) {
+    if (transits_.size() < constants::kJitterBufferDelaySamples) {
+        transits_.push_back(transitMs);
+    } else {
+        transits_[transitIndex_] = transitMs;
+        transitIndex_ = (transitIndex_ + 1) % transits_.size();
+    }
+
+    if (!newFrame) {
+        return;
+    }
+
+    // Interarrival jitter, measured on the first packet of each frame
+    if (haveFrameTransit_) {
+        const double difference = std::fabs(transitMs - lastFrameTransitMs_);
+        stats_.jitterMs += (difference - stats_.jitterMs) * kJitterGain;
+    }
+    lastFrameTransitMs_ = transitMs;
+    haveFrameTransit_ = true;
+
+    scratch_.assign(transits_.begin(), transits_.end());
+    baselineMs_ = *std::min_element(scratch_.begin(), scratch_.end());
+    const size_t rank = static_cast<size_t>(kDelayPercentile * (scratch_.size() - 1));
+    std::nth_element(scratch_.begin(), scratch_.begin() + rank, scratch_.end());
+
+    const double wanted = std::min(std::max(scratch_[rank] - baselineMs_,
+                                            static_cast<double>(config_.minDelayMs)),
+                                   static_cast<double>(config_.maxDelayMs));
+    if (wanted > targetDelayMs_) {
+        targetDelayMs_ = wanted;
+    } else {
+        targetDelayMs_ += (wanted - targetDelayMs_) * kDelayDecay;
+    }
+}
+
+void JitterBuffer::discard(int64_t from, int64_t to) {
+    if (to - from >= static_cast<int64_t>(config_.capacity)) {
+        for (Slot& slot : slots_) {
+            slot = Slot();
+        }
+        buffered_ = 0;
+        return;
+    }
+    for (int64_t sequence = from; sequence < to; sequence++) {
+        Slot& slot = slots_[slotIndex(sequence)];
+        if (slot.used && slot.sequence == sequence) {
+            slot = Slot();
+            buffered_--;
+        }
+    }
+}
+
+bool isH264FrameStart(const uint8_t* payload, size_t size) {
+    if (size == 0) {
+        return false;
+    }
+
+    uint8_t type = payload[0] & kNalTypeMask;
+    const uint8_t* body = payload + 1;
+    size_t bodySize = size - 1;
+    if (type == kNalStapA) {
+        return true;
+    }
+    if (type == kNalFuA) {
+        if (size < 2 || !(payload[1] & kFuStartBit)) {
+            return false;
+        }
+        type = payload[1] & kNalTypeMask;
+        body = payload + 2;
+        bodySize = size - 2;
+    }
+
+    switch (type) {
+        case 1:  // Non-IDR slice
+        case 5:  // IDR slice
+            // first_mb_in_slice is ue(v): a leading 1 bit encodes 0
+            return bodySize > 0 && (body[0] & 0x80);
+        case 6:  // SEI
+        case 7:  // SPS
+        case 8:  // PPS
+        case 9:  // Access unit delimiter
+            return true;
+        default:
+            return false;
+    }
+}
+
+BufferSlice assembleH264AccessUnit(const JitterFrame& frame, BufferPool& pool) {
+    SizeSink size;
+    walkH264Payloads(frame, size);
+    if (size.total == 0) {
+        return BufferSlice();
+    }
+
+    PooledBuffer buffer = pool.acquire(size.total);
+    WriteSink writer{buffer.data()};
+    walkH264Payloads(frame, writer);
+    return std::move(buffer).share();
+}
+
+bool isVp8FrameStart(const uint8_t* payload, size_t size) {
+    return size > 0 && (payload[0] & kVp8StartOfPartition) &&
+           (payload[0] & kVp8PartitionMask) == 0;
+}
+
+BufferSlice assembleVp8Frame(const JitterFrame& frame, BufferPool& pool) {
+    return assembleDescribedFrame(frame, pool, vp8DescriptorSize);
+}
+
+bool isVp9FrameStart(const uint8_t* payload, size_t size) {
+    return size > 0 && (payload[0] & kVp9StartOfFrame);
+}
+
+BufferSlice assembleVp9Frame(const JitterFrame& frame, BufferPool& pool) {
+    return assembleDescribedFrame(frame, pool, vp9DescriptorSize);
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,261 @@
+/**
+ * @file jitter-buffer.hpp
+ * @brief Adaptive receive jitter buffer with reordering
+ *
+ * This module provides:
+ * - Reordering of incoming RTP packets by (unwrapped) sequence number
+ * - Frame assembly: packets sharing an RTP timestamp are released together
+ *   once the frame is complete, and frames that miss their playout time are
+ *   skipped and flagged so the consumer can ask for a keyframe
+ * - A target delay that follows measured network jitter between a minimum
+ *   (for low-latency use) and a maximum
+ * - Reassembly of H.264 RTP payloads (RFC 6184) into Annex-B access units
+ */
+
+#pragma once
+
+#include "buffer-pool.hpp"
+#include "constants.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Configuration for JitterBuffer
+ */
+struct JitterBufferConfig {
+    int minDelayMs = constants::kDefaultJitterBufferMinDelayMs;
+    int maxDelayMs = constants::kDefaultJitterBufferMaxDelayMs;
+    uint32_t clockRate = constants::kVideoRtpClockRate;  // RTP clock of the stream
+    size_t capacity = constants::kDefaultJitterBufferPackets;  // Packets buffered at most
+    bool singlePacketFrames = false;  // Every packet is a whole frame (e.g. Opus)
+
+    // Optional: whether a payload certainly begins a frame (e.g. isH264FrameStart).
+    // Lets output start at once and resume right after a loss; without it,
+    // frame starts are only known from the marker bit of the previous packet.
+    std::function<bool(const uint8_t* payload, size_t size)> isFrameStart;
+};
+
+/**
+ * @brief Counters and delay of a JitterBuffer
+ */
+struct JitterBufferStats {
+    int targetDelayMs = 0;    // Adaptive delay frames are held for
+    int currentDelayMs = 0;   // Delay of the last released frame beyond the fastest path
+    double jitterMs = 0.0;    // Interarrival jitter (RFC 3550, 6.4.1) between frames
+    uint64_t packetsReceived = 0;
+    uint64_t packetsLate = 0;       // Arrived after their frame was released or skipped
+    uint64_t packetsDuplicate = 0;
+    uint64_t packetsReordered = 0;  // Arrived after a higher sequence number
+    uint64_t framesReleased = 0;
+    uint64_t framesLost = 0;  // Skipped because packets were still missing at playout time
+};
+
+/**
+ * @brief One frame released by the jitter buffer
+ */
+struct JitterFrame {
+    uint32_t timestamp = 0;              // RTP timestamp
+    std::vector<BufferSlice> payloads;   // RTP payloads in sequence order
+    bool discontinuity = false;          // Frames were lost before this one
+};
+
+/**
+ * @brief Reorders RTP packets and releases complete frames at an adaptive delay
+ *
+ * Every packet's transit time (arrival minus RTP time) is recorded. The
+ * fastest recent transit is the baseline, and the target delay is the 99th
+ * percentile of recent transits above it, clamped to [minDelayMs, maxDelayMs].
+ * The target rises at once when jitter grows and decays slowly when it
+ * shrinks. A frame is released at its RTP time plus baseline plus target
+ * delay, once all of its packets are in: consecutive sequence numbers from
+ * the frame start up to the marker bit or the next timestamp. A frame still
+ * missing packets at that time is skipped, together with any frame whose
+ * start was lost, and the next released frame carries `discontinuity`.
+ * Output starts with the first frame whose start is certain (after a marker
+ * bit, or as told by isFrameStart), since the stream may have been joined
+ * mid-frame. A sequence jump too far ahead to buffer is a loss and resumes
+ * output the same way.
+ *
+ * Time is passed in by the caller, which makes the buffer deterministic to
+ * test. Not thread-safe: meant to be driven under the owner's lock.
+ *
+ * Example usage:
+ * @code
+ * JitterBuffer buffer(config);
+ *
+ * // Network thread
+ * buffer.insert(sequence, timestamp, marker, pool.copy(payload, size), nowMs());
+ *
+ * // Release thread, woken at buffer.nextReleaseMs() or on insert
+ * JitterFrame frame;
+ * while (buffer.pop(nowMs(), frame)) {
+ *     deliver(assembleH264AccessUnit(frame, pool));
+ * }
+ * @endcode
+ */
+class JitterBuffer {
+public:
+    /**
+     * @brief Construct a jitter buffer
+     * @param config Buffer configuration
+     * @throws std::invalid_argument unless 0 <= minDelayMs <= maxDelayMs,
+     *         clockRate > 0 and capacity > 0
+     */
+    explicit JitterBuffer(const JitterBufferConfig& config = JitterBufferConfig());
+
+    /**
+     * @brief Add a received RTP packet
+     * @param sequence RTP sequence number
+     * @param timestamp RTP timestamp
+     * @param marker RTP marker bit (last packet of a video frame)
+     * @param payload RTP payload
+     * @param arrivalMs Arrival time on a monotonic millisecond clock
+     * @return false if the packet was late or a duplicate and was discarded
+     */
+    bool insert(uint16_t sequence, uint32_t timestamp, bool marker, BufferSlice payload,
+                int64_t arrivalMs);
+
+    /**
+     * @brief Take the next frame if its playout time has come
+     * @param nowMs Current time on the arrival clock
+     * @param frame Receives the frame
+     * @return false if no frame is due yet
+     */
+    bool pop(int64_t nowMs, JitterFrame& frame);
+
+    /**
+     * @brief Get the time at which pop() can next make progress
+     * @return Time on the arrival clock, or -1 if that waits for more packets
+     */
+    int64_t nextReleaseMs() const;
+
+    /**
+     * @brief Get delay and counters
+     */
+    JitterBufferStats getStats() const;
+
+    /**
+     * @brief Drop all packets and timing state (e.g. on a new stream); counters are kept
+     */
+    void reset();
+
+private:
+    struct Slot {
+        bool used = false;
+        int64_t sequence = 0;   // Unwrapped
+        int64_t timestamp = 0;  // Unwrapped
+        bool marker = false;
+        bool frameStart = false;  // Known to begin a frame
+        BufferSlice payload;
+    };
+
+    enum class Action { Wait, Release, Skip };
+
+    struct Plan {
+        Action action = Action::Wait;
+        int64_t atMs = -1;   // When the action becomes due
+        int64_t end = 0;     // Release: last sequence of the frame; Skip: new cursor
+    };
+
+    Plan plan() const;
+    const Slot* find(int64_t sequence) const;
+    int64_t nextBoundary(int64_t from) const;
+    size_t slotIndex(int64_t sequence) const;
+    double rtpMs(int64_t timestamp) const;
+    int64_t playoutMs(int64_t timestamp) const;
+    void updateDelay(double transitMs, bool newFrame);
+    void discard(int64_t from, int64_t to);
+
+    JitterBufferConfig config_;
+    std::vector<Slot> slots_;
+    size_t buffered_ = 0;
+
+    bool started_ = false;
+    bool released_ = false;  // A frame was released or skipped since the start
+    // The cursor was moved past lost packets: like at the start, wait for a
+    // frame start that is certain
+    bool resynchronizing_ = false;
+    int64_t cursor_ = 0;     // First sequence not yet released; always a frame start
+    int64_t highestSequence_ = 0;
+    int64_t lastTimestamp_ = 0;    // Unwrapped, of the latest packet
+    int64_t highestTimestamp_ = 0;
+    bool discontinuity_ = false;
+
+    std::vector<double> transits_;  // Ring of recent transit times in ms
+    size_t transitIndex_ = 0;
+    std::vector<double> scratch_;   // Percentile workspace
+    double baselineMs_ = 0.0;
+    double targetDelayMs_ = 0.0;
+    double lastFrameTransitMs_ = 0.0;
+    bool haveFrameTransit_ = false;
+
+    JitterBufferStats stats_;
+};
+
+/**
+ * @brief Reassemble one frame of H.264 RTP payloads into an Annex-B access unit
+ *
+ * Handles single NAL unit packets, STAP-A and FU-A (RFC 6184, 5.6-5.8).
+ * Malformed payloads are skipped.
+ *
+ * @param frame Frame released by a JitterBuffer
+ * @param pool Pool the access unit is written into
+ * @return The access unit (empty if no NAL unit could be recovered)
+ */
+BufferSlice assembleH264AccessUnit(const JitterFrame& frame, BufferPool& pool);
+
+/**
+ * @brief Check whether an H.264 RTP payload begins an access unit
+ *
+ * True for STAP-A, for an AUD, SEI, SPS or PPS, and for the first slice of a
+ * picture (first_mb_in_slice == 0), sent whole or as the first FU-A fragment.
+ *
+ * @param payload RTP payload
+ * @param size Payload size in bytes
+ */
+bool isH264FrameStart(const uint8_t* payload, size_t size);
+
+/**
+ * @brief Reassemble one frame of VP8 RTP payloads (RFC 7741)
+ *
+ * Strips each payload descriptor and joins the rest. Malformed payloads are
+ * skipped.
+ *
+ * @param frame Frame released by a JitterBuffer
+ * @param pool Pool the frame is written into
+ * @return The frame (empty if no payload could be recovered)
+ */
+BufferSlice assembleVp8Frame(const JitterFrame& frame, BufferPool& pool);
+
+/**
+ * @brief Check whether a VP8 RTP payload begins a frame
+ *
+ * True for the start of partition 0 (S set, PID 0).
+ */
+bool isVp8FrameStart(const uint8_t* payload, size_t size);
+
+/**
+ * @brief Reassemble one frame of VP9 RTP payloads (RFC 9628)
+ *
+ * Strips each payload descriptor, including a scalability structure, and
+ * joins the rest. Malformed payloads are skipped.
+ *
+ * @param frame Frame released by a JitterBuffer
+ * @param pool Pool the frame is written into
+ * @return The frame (empty if no payload could be recovered)
+ */
+BufferSlice assembleVp9Frame(const JitterFrame& frame, BufferPool& pool);
+
+/**
+ * @brief Check whether a VP9 RTP payload begins a frame (B bit set)
+ */
+bool isVp9FrameStart(const uint8_t* payload, size_t size);
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,93 @@
+/**
+ * @file keyframe-request-throttle.cpp
+ * @brief Implementation of keyframe request rate limiting
+ */
+
+#include "keyframe-request-throttle.hpp"
+
+#include <mutex>
+#include <stdexcept>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Private implementation (PIMPL pattern)
+ */
+class KeyframeRequestThrottle::Impl {
+public:
+    explicit Impl(const KeyframeRequestThrottleConfig& config) : config_(config) {
+        if (config_.minIntervalMs < 0) {
+            throw std::invalid_argument("Keyframe request interval cannot be negative");
+        }
+    }
+
+    bool onRequest(int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (inQuietPeriod(nowMs)) {
+            pending_ = true;
+            return false;
+        }
+        lastKeyframeMs_ = nowMs;
+        pending_ = false;
+        return true;
+    }
+
+    bool poll(int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!pending_ || inQuietPeriod(nowMs)) {
+            return false;
+        }
+        lastKeyframeMs_ = nowMs;
+        pending_ = false;
+        return true;
+    }
+
+    void onKeyframeSent(int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Receivers that asked before this keyframe will decode from it
+        lastKeyframeMs_ = nowMs;
+        pending_ = false;
+    }
+
+    bool hasPendingRequest() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_;
+    }
+
+private:
+    bool inQuietPeriod(int64_t nowMs) const {
+        return lastKeyframeMs_ >= 0 && nowMs - lastKeyframeMs_ < config_.minIntervalMs;
+    }
+
+    KeyframeRequestThrottleConfig config_;
+    int64_t lastKeyframeMs_ = -1;  // Last keyframe requested or sent
+    bool pending_ = false;
+    mutable std::mutex mutex_;
+};
+
+// KeyframeRequestThrottle public interface implementation
+
+KeyframeRequestThrottle::KeyframeRequestThrottle(const KeyframeRequestThrottleConfig& config)
+    : impl_(std::make_unique<Impl>(config)) {}
+
+KeyframeRequestThrottle::~KeyframeRequestThrottle() = default;
+
+bool KeyframeRequestThrottle::onRequest(int64_t nowMs) {
+    return impl_->onRequest(nowMs);
+}
+
+bool KeyframeRequestThrottle::poll(int64_t nowMs) {
+    return impl_->poll(nowMs);
+}
+
+void KeyframeRequestThrottle::onKeyframeSent(int64_t nowMs) {
+    impl_->onKeyframeSent(nowMs);
+}
+
+bool KeyframeRequestThrottle::hasPendingRequest() const {
+    return impl_->hasPendingRequest();
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,102 @@
+/**
+ * @file keyframe-request-throttle.hpp
+ * @brief Coalescing and rate limiting of receiver keyframe requests
+ *
+ * This module provides:
+ * - A throttle between RTCP PLI/FIR from receivers and the encoder, so a
+ *   burst of late joiners costs one IDR instead of one per request
+ * - Deferral: a request inside the quiet period is remembered and forwarded
+ *   when the period ends, unless a keyframe went out in the meantime
+ */
+
+#pragma once
+
+#include "constants.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Configuration for KeyframeRequestThrottle
+ */
+struct KeyframeRequestThrottleConfig {
+    // Minimum time between keyframes forced on the encoder, and the time a
+    // sent keyframe satisfies later requests for
+    int minIntervalMs = constants::kDefaultKeyframeRequestIntervalMs;
+};
+
+/**
+ * @brief Rate limiter for encoder keyframe requests
+ *
+ * Every keyframe, requested or scheduled, starts a quiet period of
+ * minIntervalMs. Requests during the quiet period are coalesced into one
+ * pending request, which poll() releases when the period ends; a keyframe
+ * sent before then satisfies it.
+ *
+ * Time is passed in explicitly (milliseconds on any monotonic clock). All
+ * methods are thread-safe.
+ *
+ * Example usage:
+ * @code
+ * KeyframeRequestThrottle throttle;
+ *
+ * if (throttle.onRequest(nowMs)) encoder.requestKeyframe();  // RTCP PLI/FIR
+ * if (throttle.poll(nowMs)) encoder.requestKeyframe();       // send loop
+ * if (packet.keyframe) throttle.onKeyframeSent(nowMs);
+ * @endcode
+ */
+class KeyframeRequestThrottle {
+public:
+    /**
+     * @brief Construct a throttle
+     * @param config Throttle configuration
+     * @throws std::invalid_argument if minIntervalMs is negative
+     */
+    explicit KeyframeRequestThrottle(
+        const KeyframeRequestThrottleConfig& config = KeyframeRequestThrottleConfig());
+
+    ~KeyframeRequestThrottle();
+
+    // Delete copy constructor and assignment operator (non-copyable)
+    KeyframeRequestThrottle(const KeyframeRequestThrottle&) = delete;
+    KeyframeRequestThrottle& operator=(const KeyframeRequestThrottle&) = delete;
+
+    /**
+     * @brief Handle a keyframe request from a receiver
+     * @param nowMs Current time in milliseconds
+     * @return true if the encoder should produce a keyframe now; false if the
+     *         request was coalesced into a pending one
+     */
+    bool onRequest(int64_t nowMs);
+
+    /**
+     * @brief Release a pending request whose quiet period has ended
+     * @param nowMs Current time in milliseconds
+     * @return true if the encoder should produce a keyframe now
+     */
+    bool poll(int64_t nowMs);
+
+    /**
+     * @brief Note a keyframe leaving for the network
+     *
+     * Satisfies pending requests and starts a new quiet period.
+     *
+     * @param nowMs Current time in milliseconds
+     */
+    void onKeyframeSent(int64_t nowMs);
+
+    /**
+     * @brief Check whether a coalesced request is waiting
+     */
+    bool hasPendingRequest() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,220 @@
+/**
+ * @file nal-parser.cpp
+ * @brief Implementation of Annex-B start code scanning and NAL unit splitting
+ */
+
+#include "nal-parser.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#if defined(OBSWEBRTC_SIMD_X86)
+#include <immintrin.h>
+#elif defined(OBSWEBRTC_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+constexpr size_t kStartCodeSize = 3;
+
+using ScanFunction = size_t (*)(const uint8_t*, size_t);
+
+inline unsigned countTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+/**
+ * @brief Scalar scan starting with `i` as the candidate position of the 01 byte
+ *
+ * Looks at every third byte: a byte above 1 cannot be part of a start code
+ * ending within the next two positions.
+ */
+size_t scanScalarFrom(const uint8_t* data, size_t size, size_t i) {
+    while (i < size) {
+        if (data[i] > 1) {
+            i += 3;
+        } else if (data[i] == 1) {
+            if (data[i - 1] == 0 && data[i - 2] == 0) {
+                return i - 2;
+            }
+            i += 3;
+        } else {
+            i++;
+        }
+    }
+    return size;
+}
+
+size_t scanScalar(const uint8_t* data, size_t size) {
+    if (size < kStartCodeSize) {
+        return size;
+    }
+    return scanScalarFrom(data, size, 2);
+}
+
+#if defined(OBSWEBRTC_SIMD_X86)
+
+// Vector kernels test 16/32 candidate positions j at once for
+// data[j] == 1 && data[j - 1] == 0 && data[j - 2] == 0 using three
+// overlapping unaligned loads
+
+size_t scanSse2(const uint8_t* data, size_t size) {
+    if (size < kStartCodeSize) {
+        return size;
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+
+    size_t j = 2;
+    for (; j + 16 <= size; j += 16) {
+        const __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + j));
+        const __m128i prev1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + j - 1));
+        const __m128i prev2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + j - 2));
+
+        const __m128i match = _mm_and_si128(
+            _mm_cmpeq_epi8(cur, one),
+            _mm_and_si128(_mm_cmpeq_epi8(prev1, zero), _mm_cmpeq_epi8(prev2, zero)));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(match));
+        if (mask != 0) {
+            return j + countTrailingZeros(mask) - 2;
+        }
+    }
+
+    return scanScalarFrom(data, size, j);
+}
+
+OBSWEBRTC_TARGET_AVX2
+size_t scanAvx2(const uint8_t* data, size_t size) {
+    if (size < kStartCodeSize) {
+        return size;
+    }
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+
+    size_t j = 2;
+    for (; j + 32 <= size; j += 32) {
+        const __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + j));
+        const __m256i prev1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + j - 1));
+        const __m256i prev2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + j - 2));
+
+        const __m256i match = _mm256_and_si256(
+            _mm256_cmpeq_epi8(cur, one),
+            _mm256_and_si256(_mm256_cmpeq_epi8(prev1, zero), _mm256_cmpeq_epi8(prev2, zero)));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(match));
+        if (mask != 0) {
+            return j + countTrailingZeros(mask) - 2;
+        }
+    }
+
+    return scanScalarFrom(data, size, j);
+}
+
+#elif defined(OBSWEBRTC_SIMD_NEON)
+
+size_t scanNeon(const uint8_t* data, size_t size) {
+    if (size < kStartCodeSize) {
+        return size;
+    }
+
+    const uint8x16_t zero = vdupq_n_u8(0);
+    const uint8x16_t one = vdupq_n_u8(1);
+
+    size_t j = 2;
+    for (; j + 16 <= size; j += 16) {
+        const uint8x16_t cur = vld1q_u8(data + j);
+        const uint8x16_t prev1 = vld1q_u8(data + j - 1);
+        const uint8x16_t prev2 = vld1q_u8(data + j - 2);
+
+        const uint8x16_t match =
+            vandq_u8(vceqq_u8(cur, one), vandq_u8(vceqq_u8(prev1, zero), vceqq_u8(prev2, zero)));
+        const uint64x2_t lanes = vreinterpretq_u64_u8(match);
+        if ((vgetq_lane_u64(lanes, 0) | vgetq_lane_u64(lanes, 1)) != 0) {
+            // No movemask on NEON; the block is known to contain a match
+            return scanScalarFrom(data, j + 16, j);
+        }
+    }
+
+    return scanScalarFrom(data, size, j);
+}
+
+#endif
+
+ScanFunction scanFunctionFor(SimdLevel level) {
+    switch (level) {
+#if defined(OBSWEBRTC_SIMD_X86)
+        case SimdLevel::SSE2:
+            return scanSse2;
+        case SimdLevel::AVX2:
+            return scanAvx2;
+#elif defined(OBSWEBRTC_SIMD_NEON)
+        case SimdLevel::NEON:
+            return scanNeon;
+#endif
+        default:
+            return scanScalar;
+    }
+}
+
+}  // namespace
+
+size_t findAnnexBStartCode(const uint8_t* data, size_t size) {
+    static const ScanFunction scan = scanFunctionFor(detectSimdLevel());
+    return scan(data, size);
+}
+
+size_t findAnnexBStartCode(const uint8_t* data, size_t size, SimdLevel level) {
+    if (!isSimdLevelSupported(level)) {
+        throw std::invalid_argument(std::string("SIMD level not supported: ") +
+                                    simdLevelName(level));
+    }
+    return scanFunctionFor(level)(data, size);
+}
+
+void splitAnnexB(const uint8_t* data, size_t size, std::vector<NalUnitView>& nalUnits) {
+    nalUnits.clear();
+    if (!data) {
+        return;
+    }
+
+    size_t pos = findAnnexBStartCode(data, size);
+    while (pos < size) {
+        const size_t begin = pos + kStartCodeSize;
+        const size_t next = begin + findAnnexBStartCode(data + begin, size - begin);
+
+        // Drop trailing_zero_8bits and the leading zero of a 4-byte start code
+        size_t end = next;
+        while (end > begin && data[end - 1] == 0) {
+            end--;
+        }
+        if (end > begin) {
+            nalUnits.push_back({data + begin, end - begin});
+        }
+
+        pos = next;
+    }
+}
+
+std::vector<NalUnitView> splitAnnexB(const uint8_t* data, size_t size) {
+    std::vector<NalUnitView> nalUnits;
+    splitAnnexB(data, size, nalUnits);
+    return nalUnits;
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,84 @@
+/**
+ * @file nal-parser.hpp
+ * @brief Annex-B start code scanning and NAL unit splitting
+ *
+ * This module provides:
+ * - A start code scanner with SSE2/AVX2/NEON kernels and a scalar fallback,
+ *   selected at runtime
+ * - Zero-copy splitting of an Annex-B access unit into NAL unit spans
+ */
+
+#pragma once
+
+#include "simd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief View of one NAL unit inside an Annex-B buffer
+ *
+ * Points into the caller's buffer, which must outlive the view.
+ */
+struct NalUnitView {
+    const uint8_t* data = nullptr;  // NAL header byte (start code excluded)
+    size_t size = 0;                // Size in bytes, trailing zero bytes excluded
+
+    /**
+     * @brief Get the H.264 nal_unit_type (1 = non-IDR slice, 5 = IDR, 7 = SPS, 8 = PPS)
+     */
+    uint8_t h264Type() const { return data[0] & 0x1F; }
+};
+
+/**
+ * @brief Find the next Annex-B start code (00 00 01)
+ *
+ * A 4-byte start code (00 00 00 01) is found as its 3-byte suffix.
+ * Uses the best kernel for this CPU.
+ *
+ * @param data Buffer to scan
+ * @param size Size in bytes
+ * @return Offset of the first 00 of the start code, or size if there is none
+ */
+size_t findAnnexBStartCode(const uint8_t* data, size_t size);
+
+/**
+ * @brief Find the next Annex-B start code with a specific kernel
+ *
+ * For tests and benchmarks; production code should use the dispatching overload.
+ *
+ * @param data Buffer to scan
+ * @param size Size in bytes
+ * @param level Kernel to use
+ * @return Offset of the first 00 of the start code, or size if there is none
+ * @throws std::invalid_argument if the CPU does not support the level
+ */
+size_t findAnnexBStartCode(const uint8_t* data, size_t size, SimdLevel level);
+
+/**
+ * @brief Split an Annex-B access unit into NAL units without copying
+ *
+ * Bytes before the first start code are ignored. Empty NAL units (adjacent
+ * start codes) are skipped.
+ *
+ * @param data Annex-B buffer
+ * @param size Size in bytes
+ * @param nalUnits Receives the NAL units in stream order (cleared first, so
+ *        the vector can be reused across frames without reallocating)
+ */
+void splitAnnexB(const uint8_t* data, size_t size, std::vector<NalUnitView>& nalUnits);
+
+/**
+ * @brief Split an Annex-B access unit into NAL units without copying
+ * @param data Annex-B buffer
+ * @param size Size in bytes
+ * @return NAL units in stream order
+ */
+std::vector<NalUnitView> splitAnnexB(const uint8_t* data, size_t size);
+
+}  // namespace core
+}  // namespace obswebrtc
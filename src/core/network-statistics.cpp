@@ -6,6 +6,7 @@
 #include "network-statistics.hpp"
 #include "constants.hpp"
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <sstream>
@@ -24,6 +25,8 @@ public:
           lastFrameRateCalculation_(std::chrono::steady_clock::now()),
           lastBytesSent_(0),
           lastBytesReceived_(0),
+          lastPayloadCopies_(0),
+          lastPayloadBytesCopied_(0),
           lastFramesReceived_(0) {}
 
     NetworkStats getCurrentStats() const {
@@ -90,6 +93,66 @@ public:
         stats_.framesDropped++;
     }
 
+    void recordKeyframeRequestReceived() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.keyframeRequestsReceived++;
+    }
+
+    void recordKeyframeRequestForwarded() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.keyframeRequestsForwarded++;
+    }
+
+    void recordKeyframeRequestUnserved() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.keyframeRequestsUnserved++;
+    }
+
+    void recordRetransmission(uint64_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.retransmissionHits++;
+        stats_.bytesRetransmitted += bytes;
+    }
+
+    void recordRetransmissionMiss() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.retransmissionMisses++;
+    }
+
+    void recordFecPacketSent(uint64_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.fecPacketsSent++;
+        stats_.fecBytesSent += bytes;
+    }
+
+    void updateFecProtectionRatio(double ratio) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.fecProtectionRatio = ratio;
+    }
+
+    void updateSendPacketLoss(double lossRate) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.sendPacketLossRate = lossRate;
+    }
+
+    void recordPayloadCopy(uint64_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.payloadCopies++;
+        stats_.payloadBytesCopied += bytes;
+    }
+
+    void recordPacerQueueDelay(double delayMs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pacerDelaySumMs_ += delayMs;
+        pacerDelayCount_++;
+        pacerMaxDelayMs_ = std::max(pacerMaxDelayMs_, delayMs);
+    }
+
+    void recordPacerBurst(uint64_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pacerMaxBurstBytes_ = std::max(pacerMaxBurstBytes_, bytes);
+    }
+
     void calculateBitrates() {
         std::lock_guard<std::mutex> lock(mutex_);
 
@@ -108,9 +171,25 @@ public:
             uint64_t bytesReceivedDelta = stats_.bytesReceived - lastBytesReceived_;
             stats_.receiveBitrateKbps = static_cast<uint32_t>((bytesReceivedDelta * 8) / elapsed);
 
+            // Calculate payload copy rates per second
+            double elapsedSec = static_cast<double>(elapsed) / constants::kMsPerSecond;
+            stats_.payloadCopiesPerSecond =
+                static_cast<double>(stats_.payloadCopies - lastPayloadCopies_) / elapsedSec;
+            stats_.payloadBytesCopiedPerSecond =
+                static_cast<double>(stats_.payloadBytesCopied - lastPayloadBytesCopied_) / elapsedSec;
+
+            // Publish pacer metrics for the interval
+            stats_.pacerQueueDelayMs =
+                pacerDelayCount_ > 0 ? pacerDelaySumMs_ / pacerDelayCount_ : 0.0;
+            stats_.pacerMaxQueueDelayMs = pacerMaxDelayMs_;
+            stats_.pacerMaxBurstBytes = pacerMaxBurstBytes_;
+            resetPacerInterval();
+
             // Update last values
             lastBytesSent_ = stats_.bytesSent;
             lastBytesReceived_ = stats_.bytesReceived;
+            lastPayloadCopies_ = stats_.payloadCopies;
+            lastPayloadBytesCopied_ = stats_.payloadBytesCopied;
             lastBitrateCalculation_ = now;
         }
     }
@@ -137,7 +216,10 @@ public:
         stats_ = NetworkStats{};
         lastBytesSent_ = 0;
         lastBytesReceived_ = 0;
+        lastPayloadCopies_ = 0;
+        lastPayloadBytesCopied_ = 0;
         lastFramesReceived_ = 0;
+        resetPacerInterval();
         lastBitrateCalculation_ = std::chrono::steady_clock::now();
         lastFrameRateCalculation_ = std::chrono::steady_clock::now();
     }
@@ -163,6 +245,13 @@ public:
     }
 
 private:
+    void resetPacerInterval() {
+        pacerDelaySumMs_ = 0.0;
+        pacerDelayCount_ = 0;
+        pacerMaxDelayMs_ = 0.0;
+        pacerMaxBurstBytes_ = 0;
+    }
+
     NetworkStats stats_;
     mutable std::mutex mutex_;
 
@@ -170,6 +259,14 @@ private:
     std::chrono::steady_clock::time_point lastBitrateCalculation_;
     uint64_t lastBytesSent_;
     uint64_t lastBytesReceived_;
+    uint64_t lastPayloadCopies_;
+    uint64_t lastPayloadBytesCopied_;
+
+    // Pacer metrics accumulated over the current bitrate interval
+    double pacerDelaySumMs_ = 0.0;
+    uint64_t pacerDelayCount_ = 0;
+    double pacerMaxDelayMs_ = 0.0;
+    uint64_t pacerMaxBurstBytes_ = 0;
 
     // For frame rate calculation
     std::chrono::steady_clock::time_point lastFrameRateCalculation_;
@@ -229,6 +326,50 @@ void NetworkStatisticsCollector::recordFrameDropped() {
     impl_->recordFrameDropped();
 }
 
+void NetworkStatisticsCollector::recordKeyframeRequestReceived() {
+    impl_->recordKeyframeRequestReceived();
+}
+
+void NetworkStatisticsCollector::recordKeyframeRequestForwarded() {
+    impl_->recordKeyframeRequestForwarded();
+}
+
+void NetworkStatisticsCollector::recordKeyframeRequestUnserved() {
+    impl_->recordKeyframeRequestUnserved();
+}
+
+void NetworkStatisticsCollector::recordRetransmission(uint64_t bytes) {
+    impl_->recordRetransmission(bytes);
+}
+
+void NetworkStatisticsCollector::recordRetransmissionMiss() {
+    impl_->recordRetransmissionMiss();
+}
+
+void NetworkStatisticsCollector::recordFecPacketSent(uint64_t bytes) {
+    impl_->recordFecPacketSent(bytes);
+}
+
+void NetworkStatisticsCollector::updateFecProtectionRatio(double ratio) {
+    impl_->updateFecProtectionRatio(ratio);
+}
+
+void NetworkStatisticsCollector::updateSendPacketLoss(double lossRate) {
+    impl_->updateSendPacketLoss(lossRate);
+}
+
+void NetworkStatisticsCollector::recordPayloadCopy(uint64_t bytes) {
+    impl_->recordPayloadCopy(bytes);
+}
+
+void NetworkStatisticsCollector::recordPacerQueueDelay(double delayMs) {
+    impl_->recordPacerQueueDelay(delayMs);
+}
+
+void NetworkStatisticsCollector::recordPacerBurst(uint64_t bytes) {
+    impl_->recordPacerBurst(bytes);
+}
+
 void NetworkStatisticsCollector::calculateBitrates() {
     impl_->calculateBitrates();
 }
@@ -269,6 +410,20 @@ std::string NetworkStatisticsFormatter::formatStats(const NetworkStats& stats) {
     oss << "  Packets Lost: " << stats.packetsLost << "\n";
     oss << "  Frame Rate: " << std::fixed << std::setprecision(1) << stats.frameRate << " fps\n";
     oss << "  Frames Dropped: " << stats.framesDropped << "\n";
+    oss << "  Keyframe Requests: " << stats.keyframeRequestsReceived << " ("
+        << stats.keyframeRequestsForwarded << " forwarded, " << stats.keyframeRequestsUnserved
+        << " unserved)\n";
+    oss << "  Retransmissions: " << stats.retransmissionHits << " ("
+        << formatBytes(stats.bytesRetransmitted) << ", " << stats.retransmissionMisses
+        << " missed)\n";
+    oss << "  FEC Packets: " << stats.fecPacketsSent << " (" << formatBytes(stats.fecBytesSent)
+        << ", ratio " << std::fixed << std::setprecision(2) << stats.fecProtectionRatio
+        << ", remote loss " << formatPacketLoss(stats.sendPacketLossRate) << ")\n";
+    oss << "  Payload Copies: " << stats.payloadCopies << " ("
+        << formatBytes(stats.payloadBytesCopied) << ")\n";
+    oss << "  Pacer Delay: " << std::fixed << std::setprecision(1) << stats.pacerQueueDelayMs
+        << " ms (max " << stats.pacerMaxQueueDelayMs << " ms, burst "
+        << formatBytes(stats.pacerMaxBurstBytes) << ")\n";
 
     return oss.str();
 }
@@ -48,6 +48,33 @@ struct NetworkStats {
     uint64_t framesReceived = 0;
     uint64_t framesDropped = 0;
     double frameRate = 0.0;  // Frames per second
+
+    // Receiver keyframe requests (RTCP PLI/FIR)
+    uint64_t keyframeRequestsReceived = 0;
+    uint64_t keyframeRequestsForwarded = 0;  // Passed on to the encoder after throttling
+    uint64_t keyframeRequestsUnserved = 0;   // Encoder could not force one; next scheduled keyframe
+
+    // NACK retransmissions (RTX)
+    uint64_t retransmissionHits = 0;    // NACKed packets resent from the history
+    uint64_t retransmissionMisses = 0;  // NACKed packets no longer in the history
+    uint64_t bytesRetransmitted = 0;
+
+    // Forward error correction (FlexFEC) and the loss it follows
+    uint64_t fecPacketsSent = 0;
+    uint64_t fecBytesSent = 0;
+    double fecProtectionRatio = 0.0;  // FEC packets per media packet
+    double sendPacketLossRate = 0.0;  // Percentage (0-100) the receiver reports for our video
+
+    // Payload copy accounting (media pipeline)
+    uint64_t payloadCopies = 0;
+    uint64_t payloadBytesCopied = 0;
+    double payloadCopiesPerSecond = 0.0;       // Calculated with bitrates
+    double payloadBytesCopiedPerSecond = 0.0;  // Calculated with bitrates
+
+    // Send pacer (calculated with bitrates, over the same interval)
+    double pacerQueueDelayMs = 0.0;     // Average time packets waited in the pacer
+    double pacerMaxQueueDelayMs = 0.0;  // Longest time a packet waited in the pacer
+    uint64_t pacerMaxBurstBytes = 0;    // Largest run of bytes released back-to-back
 };
 
 /**
@@ -137,10 +164,77 @@ public:
      */
     void recordFrameDropped();
 
+    /**
+     * @brief Record a keyframe request (PLI/FIR) received from a peer
+     */
+    void recordKeyframeRequestReceived();
+
+    /**
+     * @brief Record a keyframe request passed on to the encoder
+     */
+    void recordKeyframeRequestForwarded();
+
+    /**
+     * @brief Record a keyframe request the encoder could not act on
+     */
+    void recordKeyframeRequestUnserved();
+
+    /**
+     * @brief Record a NACKed packet resent from the retransmission history
+     * @param bytes Size of the retransmission in bytes
+     */
+    void recordRetransmission(uint64_t bytes);
+
+    /**
+     * @brief Record a NACKed packet that was no longer in the history
+     */
+    void recordRetransmissionMiss();
+
+    /**
+     * @brief Record a FEC packet sent
+     * @param bytes Size of the FEC packet in bytes
+     */
+    void recordFecPacketSent(uint64_t bytes);
+
+    /**
+     * @brief Update the FEC protection ratio in use
+     * @param ratio FEC packets per media packet (0-1)
+     */
+    void updateFecProtectionRatio(double ratio);
+
+    /**
+     * @brief Update the loss the receiver reports for sent video (RTCP RR)
+     * @param lossRate Loss percentage (0-100)
+     */
+    void updateSendPacketLoss(double lossRate);
+
+    /**
+     * @brief Record a copy of media payload bytes
+     *
+     * Called wherever the media pipeline duplicates an encoded payload, so the
+     * cost of copies is visible alongside the bitrate.
+     *
+     * @param bytes Number of bytes copied
+     */
+    void recordPayloadCopy(uint64_t bytes);
+
+    /**
+     * @brief Record how long a packet waited in the send pacer
+     * @param delayMs Time between enqueue and release in milliseconds
+     */
+    void recordPacerQueueDelay(double delayMs);
+
+    /**
+     * @brief Record a burst released by the send pacer
+     * @param bytes Bytes released back-to-back without the pacer waiting
+     */
+    void recordPacerBurst(uint64_t bytes);
+
     /**
      * @brief Calculate current bitrates
      *
-     * Call periodically to update bitrate calculations.
+     * Call periodically to update bitrate calculations. Payload copy rates
+     * and pacer queue delay/burst metrics are calculated over the same interval.
      */
     void calculateBitrates();
 
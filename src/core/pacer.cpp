@@ -0,0 +1,271 @@
+/**
+ * @file pacer.cpp
+ * @brief Implementation of the token-bucket pacer
+ */
+
+#include "pacer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Internal implementation of Pacer
+ */
+class Pacer::Impl {
+public:
+    explicit Impl(const PacerConfig& config) : config_(config) {
+        if (config_.targetBitrateKbps <= 0) {
+            throw std::invalid_argument("Pacer target bitrate must be positive");
+        }
+        if (config_.pacingMultiplier <= 0.0) {
+            throw std::invalid_argument("Pacing multiplier must be positive");
+        }
+        // A tick longer than the bucket would cap each batch below the pacing rate
+        if (config_.batchIntervalMs < 0 || config_.batchIntervalMs > config_.maxBurstMs) {
+            throw std::invalid_argument("Pacer batch interval must be within [0, maxBurstMs]");
+        }
+
+        tokens_ = bucketCapacity();
+        lastRefill_ = Clock::now();
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        wakeCondition_.notify_all();
+        thread_.join();
+    }
+
+    void enqueue(PacerLane lane, size_t bytes, SendFunction send) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto& queue = lane == PacerLane::Audio ? audioQueue_ : videoQueue_;
+            queue.push_back({bytes, Clock::now(), std::move(send)});
+            queuedBytes_ += bytes;
+        }
+        wakeCondition_.notify_one();
+    }
+
+    void clear() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        audioQueue_.clear();
+        videoQueue_.clear();
+        queuedBytes_ = 0;
+        idleCondition_.wait(lock, [this]() { return !sending_; });
+    }
+
+    void setTargetBitrate(int bitrateKbps) {
+        if (bitrateKbps <= 0) {
+            throw std::invalid_argument("Pacer target bitrate must be positive");
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_.targetBitrateKbps = bitrateKbps;
+        }
+        wakeCondition_.notify_one();
+    }
+
+    int getTargetBitrate() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return config_.targetBitrateKbps;
+    }
+
+    void setPacingMultiplier(double multiplier) {
+        if (multiplier <= 0.0) {
+            throw std::invalid_argument("Pacing multiplier must be positive");
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_.pacingMultiplier = multiplier;
+        }
+        wakeCondition_.notify_one();
+    }
+
+    double getPacingRateKbps() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return config_.targetBitrateKbps * config_.pacingMultiplier;
+    }
+
+    size_t getQueuedPackets() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return audioQueue_.size() + videoQueue_.size();
+    }
+
+    size_t getQueuedBytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queuedBytes_;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct QueuedPacket {
+        size_t bytes;
+        Clock::time_point enqueued;
+        SendFunction send;
+    };
+
+    // Pacing rate in bytes per millisecond (kbps / 8 = bytes per ms)
+    double bytesPerMs() const {
+        return config_.targetBitrateKbps * config_.pacingMultiplier / constants::kBitsPerByte;
+    }
+
+    double bucketCapacity() const {
+        return bytesPerMs() * config_.maxBurstMs;
+    }
+
+    void refill(Clock::time_point now) {
+        const double elapsedMs = std::chrono::duration<double, std::milli>(now - lastRefill_).count();
+        tokens_ = std::min(bucketCapacity(), tokens_ + elapsedMs * bytesPerMs());
+        lastRefill_ = now;
+    }
+
+    void endBurst() {
+        if (burstBytes_ > 0 && config_.statistics) {
+            config_.statistics->recordPacerBurst(burstBytes_);
+        }
+        burstBytes_ = 0;
+    }
+
+    // Queue to release from next, or nullptr if the bucket says wait
+    std::deque<QueuedPacket>* nextQueue(Clock::time_point now) {
+        if (!audioQueue_.empty()) {
+            return &audioQueue_;
+        }
+        if (!videoQueue_.empty() &&
+            (tokens_ > 0.0 || now - videoQueue_.front().enqueued >
+                                  std::chrono::milliseconds(config_.maxQueueDelayMs))) {
+            return &videoQueue_;
+        }
+        return nullptr;
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (running_) {
+            if (audioQueue_.empty() && videoQueue_.empty()) {
+                endBurst();
+                wakeCondition_.wait(lock, [this]() {
+                    return !running_ || !audioQueue_.empty() || !videoQueue_.empty();
+                });
+                continue;
+            }
+
+            const auto now = Clock::now();
+            refill(now);
+
+            // One packet per wakeup, or everything due when batching
+            while (std::deque<QueuedPacket>* queue = nextQueue(now)) {
+                QueuedPacket& packet = queue->front();
+                queuedBytes_ -= packet.bytes;
+                tokens_ -= static_cast<double>(packet.bytes);
+                burstBytes_ += packet.bytes;
+                batch_.push_back(std::move(packet));
+                queue->pop_front();
+                if (config_.batchIntervalMs == 0) {
+                    break;
+                }
+            }
+
+            if (batch_.empty()) {
+                // Sleep until the bucket is positive again, at least one tick
+                // when batching (or until audio arrives)
+                endBurst();
+                const double waitMs =
+                    std::max(-tokens_ / bytesPerMs(), static_cast<double>(config_.batchIntervalMs));
+                const auto wakeAt =
+                    now + std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double, std::milli>(waitMs));
+                wakeCondition_.wait_until(lock, wakeAt, [this]() {
+                    return !running_ || !audioQueue_.empty();
+                });
+                continue;
+            }
+
+            sending_ = true;
+            lock.unlock();
+
+            for (auto& packet : batch_) {
+                if (config_.statistics) {
+                    config_.statistics->recordPacerQueueDelay(
+                        std::chrono::duration<double, std::milli>(now - packet.enqueued).count());
+                }
+                packet.send();
+            }
+            batch_.clear();
+
+            lock.lock();
+            sending_ = false;
+            idleCondition_.notify_all();
+        }
+    }
+
+    PacerConfig config_;
+    std::deque<QueuedPacket> audioQueue_;
+    std::deque<QueuedPacket> videoQueue_;
+    std::vector<QueuedPacket> batch_;  // Released this wakeup; only touched by the pacer thread
+    size_t queuedBytes_ = 0;
+    double tokens_ = 0.0;  // May go negative: the packet that overdraws is still sent
+    Clock::time_point lastRefill_;
+    uint64_t burstBytes_ = 0;
+    bool running_ = true;
+    bool sending_ = false;
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable wakeCondition_;
+    std::condition_variable idleCondition_;
+};
+
+// Pacer implementation
+
+Pacer::Pacer(const PacerConfig& config) : impl_(std::make_unique<Impl>(config)) {}
+
+Pacer::~Pacer() = default;
+
+void Pacer::enqueue(PacerLane lane, size_t bytes, SendFunction send) {
+    impl_->enqueue(lane, bytes, std::move(send));
+}
+
+void Pacer::clear() {
+    impl_->clear();
+}
+
+void Pacer::setTargetBitrate(int bitrateKbps) {
+    impl_->setTargetBitrate(bitrateKbps);
+}
+
+int Pacer::getTargetBitrate() const {
+    return impl_->getTargetBitrate();
+}
+
+void Pacer::setPacingMultiplier(double multiplier) {
+    impl_->setPacingMultiplier(multiplier);
+}
+
+double Pacer::getPacingRateKbps() const {
+    return impl_->getPacingRateKbps();
+}
+
+size_t Pacer::getQueuedPackets() const {
+    return impl_->getQueuedPackets();
+}
+
+size_t Pacer::getQueuedBytes() const {
+    return impl_->getQueuedBytes();
+}
+
+}  // namespace core
+}  // namespace obswebrtc
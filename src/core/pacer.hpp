@@ -0,0 +1,159 @@
+/**
+ * @file pacer.hpp
+ * @brief Token-bucket pacer for outgoing RTP packets
+ *
+ * This module provides:
+ * - Spreading of outgoing packets over time at a configurable pacing rate
+ * - A priority lane for audio so large video frames never delay it
+ * - A queue delay cap that drains at line rate when the pacer falls behind
+ * - Optional per-tick batching that releases all due packets in one wakeup
+ * - Queue delay and burst size reporting through NetworkStatisticsCollector
+ */
+
+#pragma once
+
+#include "constants.hpp"
+#include "network-statistics.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Pacer queue a packet is placed on
+ */
+enum class PacerLane {
+    Audio,  ///< Released ahead of video, never waits for budget
+    Video   ///< Released as the token bucket allows
+};
+
+/**
+ * @brief Configuration for Pacer
+ */
+struct PacerConfig {
+    int targetBitrateKbps = 2500;  // Media target bitrate (e.g. the encoder bitrate)
+    double pacingMultiplier = constants::kDefaultPacingMultiplier;  // Pacing rate = target * multiplier
+    int maxBurstMs = constants::kDefaultPacerMaxBurstMs;            // Bucket depth in ms at pacing rate
+    int maxQueueDelayMs = constants::kDefaultPacerMaxQueueDelayMs;  // Drain without pacing above this
+
+    // Release tick in ms (0 = wake per packet). With a tick, a backlogged pacer
+    // wakes once per tick and sends everything the bucket allows back to back.
+    int batchIntervalMs = 0;
+
+    // Optional statistics sink for queue delay and burst metrics (must outlive the pacer)
+    NetworkStatisticsCollector* statistics = nullptr;
+};
+
+/**
+ * @brief Token-bucket packet pacer
+ *
+ * Packets are queued together with a send function and released from a
+ * dedicated pacer thread. Tokens (bytes) accrue at the pacing rate up to
+ * maxBurstMs worth of data; a video packet is released while the bucket is
+ * positive and its size is charged against it, so a large keyframe leaves as
+ * a stream of small bursts instead of one line-rate burst. Audio packets are
+ * released immediately and still charged, so total output stays near the
+ * pacing rate.
+ *
+ * By default a backlogged pacer sleeps until the bucket is positive again,
+ * i.e. it wakes once per packet. At high bitrates that is thousands of
+ * wakeups a second; with batchIntervalMs set, it sleeps at least one tick and
+ * then releases every packet the refilled bucket covers as one batch, so the
+ * packets reach the transport together at the cost of tick-sized bursts.
+ *
+ * Example usage:
+ * @code
+ * PacerConfig config;
+ * config.targetBitrateKbps = 2500;
+ * Pacer pacer(config);
+ *
+ * pacer.enqueue(PacerLane::Video, packet->size(), [packet, send]() { send(packet); });
+ * @endcode
+ */
+class Pacer {
+public:
+    /**
+     * @brief Function that puts one packet on the wire
+     */
+    using SendFunction = std::function<void()>;
+
+    /**
+     * @brief Construct a pacer and start its thread
+     * @param config Pacer configuration
+     * @throws std::invalid_argument if bitrate or multiplier are not positive,
+     *         or batchIntervalMs is outside [0, maxBurstMs]
+     */
+    explicit Pacer(const PacerConfig& config);
+
+    /**
+     * @brief Destructor - stops the pacer thread and discards queued packets
+     */
+    ~Pacer();
+
+    // Delete copy constructor and assignment operator (non-copyable)
+    Pacer(const Pacer&) = delete;
+    Pacer& operator=(const Pacer&) = delete;
+
+    /**
+     * @brief Queue a packet for paced sending
+     * @param lane Queue to place the packet on
+     * @param bytes Packet size charged against the bucket
+     * @param send Function invoked on the pacer thread to send the packet
+     */
+    void enqueue(PacerLane lane, size_t bytes, SendFunction send);
+
+    /**
+     * @brief Discard all queued packets
+     *
+     * Waits for a send in progress to finish, so after clear() returns no
+     * previously queued send function will run. Must not be called from a
+     * send function.
+     */
+    void clear();
+
+    /**
+     * @brief Set the media target bitrate
+     * @param bitrateKbps Target bitrate in kbps
+     * @throws std::invalid_argument if bitrate <= 0
+     */
+    void setTargetBitrate(int bitrateKbps);
+
+    /**
+     * @brief Get the media target bitrate
+     * @return Target bitrate in kbps
+     */
+    int getTargetBitrate() const;
+
+    /**
+     * @brief Set the pacing multiplier
+     * @param multiplier Pacing rate relative to the target bitrate
+     * @throws std::invalid_argument if multiplier <= 0
+     */
+    void setPacingMultiplier(double multiplier);
+
+    /**
+     * @brief Get the effective pacing rate
+     * @return Target bitrate times pacing multiplier, in kbps
+     */
+    double getPacingRateKbps() const;
+
+    /**
+     * @brief Get the number of queued packets (both lanes)
+     */
+    size_t getQueuedPackets() const;
+
+    /**
+     * @brief Get the number of queued bytes (both lanes)
+     */
+    size_t getQueuedBytes() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
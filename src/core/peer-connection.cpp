@@ -4,17 +4,385 @@
  */
 
 #include "peer-connection.hpp"
+#include "bitstream-inspector.hpp"
 #include "constants.hpp"
+#include "sdp-parser.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <mutex>
+#include <random>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 #include <vector>
 
 namespace obswebrtc {
 namespace core {
 
+namespace {
+
+/**
+ * @brief Locate the payload of an RTP packet
+ * @param packet Raw RTP packet
+ * @param payloadOffset Receives the payload offset
+ * @param payloadSize Receives the payload size
+ * @param timestamp Receives the RTP timestamp
+ * @param sequence Receives the RTP sequence number
+ * @param marker Receives the RTP marker bit
+ * @return false if the packet is not a well-formed RTP packet (e.g. RTCP)
+ */
+bool locateRtpPayload(const rtc::binary& packet, size_t& payloadOffset, size_t& payloadSize,
+                      uint32_t& timestamp, uint16_t& sequence, bool& marker) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(packet.data());
+    const size_t size = packet.size();
+
+    if (size < constants::kRtpHeaderSize || (bytes[0] >> 6) != 2) {
+        return false;
+    }
+
+    // RTCP shares the port when rtcp-mux is used. RFC 5761, 4: a second byte
+    // of 192-223 is RTCP, which is why RTP avoids payload types 64-95.
+    if (bytes[1] >= 192 && bytes[1] <= 223) {
+        return false;
+    }
+
+    size_t offset = constants::kRtpHeaderSize + (bytes[0] & 0x0F) * 4;
+    if (bytes[0] & 0x10) {
+        // Header extension: 4 byte header followed by length * 4 bytes
+        if (size < offset + 4) {
+            return false;
+        }
+        const size_t extensionWords = (static_cast<size_t>(bytes[offset + 2]) << 8) | bytes[offset + 3];
+        offset += 4 + extensionWords * 4;
+    }
+
+    size_t end = size;
+    if (bytes[0] & 0x20) {
+        // Padding: last byte holds the padding length
+        const uint8_t padding = bytes[size - 1];
+        if (padding > end) {
+            return false;
+        }
+        end -= padding;
+    }
+
+    if (offset >= end) {
+        return false;
+    }
+
+    payloadOffset = offset;
+    payloadSize = end - offset;
+    timestamp = (static_cast<uint32_t>(bytes[4]) << 24) | (static_cast<uint32_t>(bytes[5]) << 16) |
+                (static_cast<uint32_t>(bytes[6]) << 8) | static_cast<uint32_t>(bytes[7]);
+    sequence = static_cast<uint16_t>((bytes[2] << 8) | bytes[3]);
+    marker = (bytes[1] & 0x80) != 0;
+    return true;
+}
+
+/**
+ * @brief Check whether an outgoing message is RTCP rather than RTP
+ */
+bool isRtcpMessage(const rtc::Message& message) {
+    if (message.type == rtc::Message::Control) {
+        return true;
+    }
+    // RTCP packet types 200-206 (SR, RR, SDES, BYE, APP, RTPFB, PSFB)
+    return message.size() >= 2 && std::to_integer<uint8_t>(message[1]) >= 200 &&
+           std::to_integer<uint8_t>(message[1]) <= 206;
+}
+
+int64_t steadyNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Media handler that hands outgoing RTP packets to a Pacer
+ *
+ * Added last to a send track's chain, after packetization and RTCP
+ * bookkeeping. RTCP passes through unpaced.
+ */
+class PacingHandler final : public rtc::MediaHandler {
+public:
+    PacingHandler(std::shared_ptr<Pacer> pacer, PacerLane lane)
+        : pacer_(std::move(pacer)), lane_(lane) {}
+
+    void outgoing(rtc::message_vector& messages, const rtc::message_callback& send) override {
+        rtc::message_vector unpaced;
+        for (auto& message : messages) {
+            if (!message || isRtcpMessage(*message)) {
+                unpaced.push_back(std::move(message));
+                continue;
+            }
+
+            const size_t bytes = message->size();
+            pacer_->enqueue(lane_, bytes, [send, message]() { send(message); });
+        }
+        messages.swap(unpaced);
+    }
+
+private:
+    std::shared_ptr<Pacer> pacer_;
+    PacerLane lane_;
+};
+
+/**
+ * @brief Media handler that packetizes VP8/VP9/AV1 frames into RTP packets
+ *
+ * First in a send track's chain, in place of a libdatachannel packetizer.
+ * The codec-specific payload format comes from a VideoRtpPacketizer; this
+ * handler adds the RTP header from the track's RtpPacketizationConfig.
+ */
+class VideoPayloadHandler final : public rtc::MediaHandler {
+public:
+    VideoPayloadHandler(std::unique_ptr<VideoRtpPacketizer> packetizer,
+                        std::shared_ptr<rtc::RtpPacketizationConfig> rtpConfig)
+        : packetizer_(std::move(packetizer)), rtpConfig_(std::move(rtpConfig)) {}
+
+    void outgoing(rtc::message_vector& messages, const rtc::message_callback&) override {
+        rtc::message_vector packets;
+        for (const auto& message : messages) {
+            if (!message || message->type == rtc::Message::Control) {
+                packets.push_back(message);
+                continue;
+            }
+
+            if (!packetizer_->packetize(reinterpret_cast<const uint8_t*>(message->data()),
+                                        message->size(), frame_)) {
+                continue;
+            }
+
+            for (const auto& payload : frame_.payloads) {
+                auto packet = rtc::make_message(constants::kRtpHeaderSize + payload.size);
+                writeHeader(reinterpret_cast<uint8_t*>(packet->data()), payload.marker);
+                std::memcpy(packet->data() + constants::kRtpHeaderSize, frame_.data(payload),
+                            payload.size);
+                packets.push_back(std::move(packet));
+            }
+        }
+        messages.swap(packets);
+    }
+
+private:
+    void writeHeader(uint8_t* header, bool marker) {
+        writeRtpHeader(header, rtpConfig_->payloadType, marker, rtpConfig_->sequenceNumber++,
+                       rtpConfig_->timestamp, rtpConfig_->ssrc);
+    }
+
+    std::unique_ptr<VideoRtpPacketizer> packetizer_;
+    std::shared_ptr<rtc::RtpPacketizationConfig> rtpConfig_;
+    PacketizedFrame frame_;  // Reused; outgoing() runs under the track's send mutex
+};
+
+/**
+ * @brief Media handler that reports incoming RTCP feedback about a send track
+ *
+ * Observes receiver reports and REMB without consuming them, so the
+ * libdatachannel handlers (e.g. the NACK responder) still see every message.
+ */
+class RtcpFeedbackHandler final : public rtc::MediaHandler {
+public:
+    RtcpFeedbackHandler(MediaType type, uint32_t ssrc, RtcpFeedbackCallback callback)
+        : type_(type), ssrc_(ssrc), callback_(std::move(callback)) {}
+
+    void incoming(rtc::message_vector& messages, const rtc::message_callback&) override {
+        for (const auto& message : messages) {
+            if (!message || !isRtcpMessage(*message)) {
+                continue;
+            }
+
+            const uint32_t arrival = compactNtpNow();
+            RtcpFeedback feedback;
+            if (!parseRtcpFeedback(reinterpret_cast<const uint8_t*>(message->data()),
+                                   message->size(), feedback)) {
+                continue;
+            }
+
+            // Keep only what is about this track
+            feedback.reportBlocks.erase(
+                std::remove_if(feedback.reportBlocks.begin(), feedback.reportBlocks.end(),
+                               [this](const RtcpReportBlock& block) { return block.ssrc != ssrc_; }),
+                feedback.reportBlocks.end());
+            if (feedback.hasRemb && !feedback.rembSsrcs.empty() &&
+                std::find(feedback.rembSsrcs.begin(), feedback.rembSsrcs.end(), ssrc_) ==
+                    feedback.rembSsrcs.end()) {
+                feedback.hasRemb = false;
+            }
+            feedback.keyframeRequestSsrcs.erase(
+                std::remove_if(feedback.keyframeRequestSsrcs.begin(),
+                               feedback.keyframeRequestSsrcs.end(),
+                               [this](uint32_t ssrc) { return ssrc != ssrc_; }),
+                feedback.keyframeRequestSsrcs.end());
+            if (feedback.reportBlocks.empty() && !feedback.hasRemb &&
+                feedback.keyframeRequestSsrcs.empty()) {
+                continue;
+            }
+
+            int64_t rttMs = -1;
+            for (const auto& block : feedback.reportBlocks) {
+                rttMs = std::max(rttMs, calculateRttMs(block, arrival));
+            }
+            callback_(type_, feedback, rttMs);
+        }
+    }
+
+private:
+    MediaType type_;
+    uint32_t ssrc_;
+    RtcpFeedbackCallback callback_;
+};
+
+/**
+ * @brief Media handler that answers generic NACKs with RTX retransmissions
+ *
+ * Takes the place of libdatachannel's RtcpNackResponder on video tracks with
+ * an RTX SSRC. Outgoing RTP is copied into a preallocated RtpPacketHistory
+ * before pacing; NACKed packets still in the history are resent on the RTX
+ * stream (RFC 4588), unpaced, and the rest are counted as misses.
+ */
+class RtxNackResponder final : public rtc::MediaHandler {
+public:
+    RtxNackResponder(const MediaTrackConfig& config, NetworkStatisticsCollector* statistics)
+        : history_(config.rtxHistory), ssrc_(config.ssrc), rtxSsrc_(config.rtxSsrc),
+          rtxPayloadType_(config.rtxPayloadType), statistics_(statistics),
+          rtxSequenceNumber_(static_cast<uint16_t>(std::random_device{}())) {}
+
+    void outgoing(rtc::message_vector& messages, const rtc::message_callback&) override {
+        const int64_t nowMs = steadyNowMs();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& message : messages) {
+            if (!message || isRtcpMessage(*message)) {
+                continue;
+            }
+            history_.store(reinterpret_cast<const uint8_t*>(message->data()), message->size(),
+                           nowMs);
+        }
+    }
+
+    void incoming(rtc::message_vector& messages, const rtc::message_callback& send) override {
+        for (const auto& message : messages) {
+            if (!message || !isRtcpMessage(*message)) {
+                continue;
+            }
+
+            RtcpFeedback feedback;
+            if (!parseRtcpFeedback(reinterpret_cast<const uint8_t*>(message->data()),
+                                   message->size(), feedback) ||
+                feedback.nacks.empty()) {
+                continue;
+            }
+
+            // Send outside the lock: the transport may call back into outgoing()
+            for (auto& retransmission : retransmit(feedback.nacks)) {
+                send(std::move(retransmission));
+            }
+        }
+    }
+
+private:
+    rtc::message_vector retransmit(const std::vector<RtcpNack>& nacks) {
+        const int64_t nowMs = steadyNowMs();
+        rtc::message_vector retransmissions;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& nack : nacks) {
+            if (nack.mediaSsrc != ssrc_) {
+                continue;
+            }
+
+            size_t size = 0;
+            const uint8_t* packet = history_.find(nack.sequenceNumber, nowMs, size);
+            rtc::message_ptr rtx;
+            size_t written = 0;
+            if (packet) {
+                rtx = rtc::make_message(size + constants::kRtxOverheadSize);
+                written = writeRtxPacket(packet, size, rtxPayloadType_, rtxSequenceNumber_,
+                                         rtxSsrc_, reinterpret_cast<uint8_t*>(rtx->data()));
+            }
+            if (written == 0) {
+                if (statistics_) {
+                    statistics_->recordRetransmissionMiss();
+                }
+                continue;
+            }
+
+            rtxSequenceNumber_++;
+            rtx->resize(written);
+            if (statistics_) {
+                statistics_->recordRetransmission(written);
+            }
+            retransmissions.push_back(std::move(rtx));
+        }
+        return retransmissions;
+    }
+
+    RtpPacketHistory history_;  // Guarded by mutex_
+    uint32_t ssrc_;
+    uint32_t rtxSsrc_;
+    uint8_t rtxPayloadType_;
+    NetworkStatisticsCollector* statistics_;
+    uint16_t rtxSequenceNumber_;  // Guarded by mutex_
+    std::mutex mutex_;
+};
+
+/**
+ * @brief Media handler that follows outgoing video with FlexFEC packets
+ *
+ * Sits after the NACK responder, so FEC packets are neither stored for
+ * retransmission nor counted in sender reports, and before pacing, so
+ * they share the video lane with the packets they protect.
+ */
+class FecHandler final : public rtc::MediaHandler {
+public:
+    FecHandler(const MediaTrackConfig& config, NetworkStatisticsCollector* statistics)
+        : encoder_(fecConfig(config)), statistics_(statistics) {}
+
+    void outgoing(rtc::message_vector& messages, const rtc::message_callback&) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rtc::message_vector protectedMessages;
+        protectedMessages.reserve(messages.size() + messages.size() / 2 + 1);
+        for (auto& message : messages) {
+            const bool media = message && !isRtcpMessage(*message);
+            if (media && encoder_.addPacket(reinterpret_cast<const uint8_t*>(message->data()),
+                                            message->size(), fecPacket_)) {
+                protectedMessages.push_back(std::move(message));
+                auto fec = rtc::make_message(fecPacket_.size());
+                std::memcpy(fec->data(), fecPacket_.data(), fecPacket_.size());
+                if (statistics_) {
+                    statistics_->recordFecPacketSent(fecPacket_.size());
+                }
+                protectedMessages.push_back(std::move(fec));
+            } else {
+                protectedMessages.push_back(std::move(message));
+            }
+        }
+        messages.swap(protectedMessages);
+    }
+
+    void setProtectionRatio(double ratio) { encoder_.setProtectionRatio(ratio); }
+
+private:
+    static FlexFecConfig fecConfig(const MediaTrackConfig& config) {
+        FlexFecConfig fecConfig;
+        fecConfig.mediaSsrc = config.ssrc;
+        fecConfig.fecSsrc = config.fecSsrc;
+        fecConfig.payloadType = config.fecPayloadType;
+        fecConfig.protectionRatio = config.fecProtectionRatio;
+        return fecConfig;
+    }
+
+    FlexFecEncoder encoder_;  // Guarded by mutex_, except setProtectionRatio()
+    std::vector<uint8_t> fecPacket_;  // Reused; guarded by mutex_
+    NetworkStatisticsCollector* statistics_;
+    std::mutex mutex_;
+};
+
+}  // namespace
+
 /**
  * @brief Private implementation (PIMPL pattern)
  */
@@ -23,6 +391,14 @@ public:
     explicit Impl(const PeerConnectionConfig& config)
         : config_(config), state_(ConnectionState::New), hasRemoteDescription_(false),
           remoteDescriptionSdp_(""), pendingCandidates_(), offerCount_(0) {
+        if (config.jitterBufferMinDelayMs < 0 ||
+            config.jitterBufferMaxDelayMs < config.jitterBufferMinDelayMs) {
+            throw std::invalid_argument("Jitter buffer delay bounds must satisfy 0 <= min <= max");
+        }
+        if (config.minKeyframeRequestIntervalMs < 0) {
+            throw std::invalid_argument("Keyframe request interval cannot be negative");
+        }
+
         try {
             // Configure libdatachannel
             rtc::Configuration rtcConfig;
@@ -246,12 +622,20 @@ public:
     }
 
     void close() {
+        // Outside mutex_: frame callbacks on the release thread may call back in
+        stopReleaseThread();
+
         std::lock_guard<std::mutex> lock(mutex_);
 
         if (peerConnection_) {
             log(LogLevel::Info, "Closing PeerConnection");
 
             try {
+                // Drop paced packets before the tracks they would be sent on go away
+                if (config_.pacer) {
+                    config_.pacer->clear();
+                }
+
                 // Close and clear all tracks
                 for (auto& track : tracks_) {
                     if (track) {
@@ -259,6 +643,8 @@ public:
                     }
                 }
                 tracks_.clear();
+                videoSendTrack_.reset();
+                audioSendTrack_.reset();
 
                 // Close and clear all data channels
                 if (dataChannel_) {
@@ -310,7 +696,349 @@ public:
         return remoteDescriptionSdp_;
     }
 
+    void addTrack(const MediaTrackConfig& trackConfig) {
+        const bool videoCodec = trackConfig.codec != MediaCodec::Opus;
+        if ((trackConfig.type == MediaType::Video) != videoCodec) {
+            throw std::invalid_argument("Track codec does not match track media type");
+        }
+
+        if (trackConfig.prepacketized && trackConfig.type != MediaType::Video) {
+            throw std::invalid_argument("Only video tracks can be prepacketized");
+        }
+
+        if (trackConfig.rtxSsrc != 0) {
+            if (trackConfig.type != MediaType::Video) {
+                throw std::invalid_argument("Only video tracks can use RTX");
+            }
+            if (trackConfig.rtxSsrc == trackConfig.ssrc ||
+                trackConfig.rtxPayloadType == trackConfig.payloadType) {
+                throw std::invalid_argument("RTX SSRC and payload type must differ from the media's");
+            }
+        }
+
+        if (trackConfig.fecSsrc != 0) {
+            if (trackConfig.type != MediaType::Video) {
+                throw std::invalid_argument("Only video tracks can use FEC");
+            }
+            if (trackConfig.fecSsrc == trackConfig.ssrc ||
+                trackConfig.fecSsrc == trackConfig.rtxSsrc ||
+                trackConfig.fecPayloadType == trackConfig.payloadType ||
+                (trackConfig.rtxSsrc != 0 &&
+                 trackConfig.fecPayloadType == trackConfig.rtxPayloadType)) {
+                throw std::invalid_argument(
+                    "FEC SSRC and payload type must differ from the media's and RTX's");
+            }
+        }
+
+        if (trackConfig.mid.empty()) {
+            throw std::invalid_argument("Track mid cannot be empty");
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (!peerConnection_) {
+            throw std::runtime_error("Cannot add track to a closed PeerConnection");
+        }
+
+        auto& slot = sendTrackSlot(trackConfig.type);
+        if (slot) {
+            throw std::runtime_error("A send track already exists for this media type");
+        }
+
+        try {
+            auto sendTrack = std::make_shared<SendTrack>();
+            sendTrack->config = trackConfig;
+
+            std::shared_ptr<rtc::MediaHandler> packetizer;
+            if (trackConfig.type == MediaType::Video) {
+                rtc::Description::Video media(trackConfig.mid, rtc::Description::Direction::SendOnly);
+                switch (trackConfig.codec) {
+                    case MediaCodec::VP8:
+                        media.addVP8Codec(trackConfig.payloadType);
+                        break;
+                    case MediaCodec::VP9:
+                        media.addVP9Codec(trackConfig.payloadType);
+                        break;
+                    case MediaCodec::AV1:
+                        media.addAV1Codec(trackConfig.payloadType);
+                        break;
+                    default:
+                        media.addH264Codec(trackConfig.payloadType);
+                        break;
+                }
+                media.addSSRC(trackConfig.ssrc, trackConfig.cname, trackConfig.streamId,
+                              trackConfig.mid);
+                if (trackConfig.rtxSsrc != 0) {
+                    media.addRtxCodec(trackConfig.rtxPayloadType, trackConfig.payloadType,
+                                      constants::kVideoRtpClockRate);
+                    media.addSSRC(trackConfig.rtxSsrc, trackConfig.cname, trackConfig.streamId,
+                                  trackConfig.mid);
+                    media.addAttribute("ssrc-group:FID " + std::to_string(trackConfig.ssrc) + " " +
+                                       std::to_string(trackConfig.rtxSsrc));
+                }
+                if (trackConfig.fecSsrc != 0) {
+                    // libwebrtc's name and default repair window (10 s in microseconds)
+                    media.addVideoCodec(trackConfig.fecPayloadType, "flexfec-03",
+                                        "repair-window=10000000");
+                    media.addSSRC(trackConfig.fecSsrc, trackConfig.cname, trackConfig.streamId,
+                                  trackConfig.mid);
+                    media.addAttribute("ssrc-group:FEC-FR " + std::to_string(trackConfig.ssrc) +
+                                       " " + std::to_string(trackConfig.fecSsrc));
+                }
+
+                sendTrack->track = peerConnection_->addTrack(media);
+                sendTrack->clockRate = constants::kVideoRtpClockRate;
+                sendTrack->rtpConfig = std::make_shared<rtc::RtpPacketizationConfig>(
+                    trackConfig.ssrc, trackConfig.cname, trackConfig.payloadType,
+                    sendTrack->clockRate);
+
+                // Prepacketized tracks get payloads from sendPacketizedFrame() and
+                // only need the RTCP handlers
+                switch (trackConfig.prepacketized ? MediaCodec::Opus : trackConfig.codec) {
+                    case MediaCodec::Opus:
+                        break;
+                    case MediaCodec::VP8:
+                        packetizer = std::make_shared<VideoPayloadHandler>(
+                            std::make_unique<Vp8RtpPacketizer>(), sendTrack->rtpConfig);
+                        break;
+                    case MediaCodec::VP9:
+                        packetizer = std::make_shared<VideoPayloadHandler>(
+                            std::make_unique<Vp9RtpPacketizer>(), sendTrack->rtpConfig);
+                        break;
+                    case MediaCodec::AV1:
+                        packetizer = std::make_shared<VideoPayloadHandler>(
+                            std::make_unique<Av1RtpPacketizer>(), sendTrack->rtpConfig);
+                        break;
+                    default: {
+                        // The same packetizer WebRTCOutput uses for prepacketized tracks
+                        auto h264 = std::make_unique<H264RtpPacketizer>();
+                        h264->setParameterSets(trackConfig.extradata.data(),
+                                               trackConfig.extradata.size());
+                        packetizer = std::make_shared<VideoPayloadHandler>(std::move(h264),
+                                                                           sendTrack->rtpConfig);
+                        break;
+                    }
+                }
+            } else {
+                rtc::Description::Audio media(trackConfig.mid, rtc::Description::Direction::SendOnly);
+                media.addOpusCodec(trackConfig.payloadType);
+                media.addSSRC(trackConfig.ssrc, trackConfig.cname, trackConfig.streamId,
+                              trackConfig.mid);
+
+                sendTrack->track = peerConnection_->addTrack(media);
+                sendTrack->clockRate = constants::kOpusRtpClockRate;
+                sendTrack->rtpConfig = std::make_shared<rtc::RtpPacketizationConfig>(
+                    trackConfig.ssrc, trackConfig.cname, trackConfig.payloadType,
+                    sendTrack->clockRate);
+
+                packetizer = std::make_shared<rtc::OpusRtpPacketizer>(sendTrack->rtpConfig);
+            }
+
+            auto chain = std::make_shared<rtc::RtcpSrReporter>(sendTrack->rtpConfig);
+            if (trackConfig.rtxSsrc != 0) {
+                chain->addToChain(std::make_shared<RtxNackResponder>(trackConfig, config_.statistics));
+            } else {
+                chain->addToChain(std::make_shared<rtc::RtcpNackResponder>());
+            }
+            if (trackConfig.fecSsrc != 0) {
+                sendTrack->fec = std::make_shared<FecHandler>(trackConfig, config_.statistics);
+                chain->addToChain(sendTrack->fec);
+            }
+            if (config_.pacer) {
+                chain->addToChain(std::make_shared<PacingHandler>(
+                    config_.pacer,
+                    trackConfig.type == MediaType::Audio ? PacerLane::Audio : PacerLane::Video));
+            }
+            if (config_.rtcpFeedbackCallback) {
+                chain->addToChain(std::make_shared<RtcpFeedbackHandler>(
+                    trackConfig.type, trackConfig.ssrc, config_.rtcpFeedbackCallback));
+            }
+            if (packetizer) {
+                packetizer->addToChain(chain);
+                sendTrack->track->setMediaHandler(packetizer);
+            } else {
+                sendTrack->track->setMediaHandler(chain);
+            }
+
+            tracks_.push_back(sendTrack->track);
+            slot = sendTrack;
+
+            log(LogLevel::Info, "Send track added: " + trackConfig.mid);
+        } catch (const std::exception& e) {
+            log(LogLevel::Error, std::string("Failed to add track: ") + e.what());
+            throw std::runtime_error(std::string("Failed to add track: ") + e.what());
+        }
+    }
+
+    bool sendFrame(MediaType type, const uint8_t* data, size_t size, int64_t timestampUs) {
+        if (!data || size == 0) {
+            return false;
+        }
+
+        std::shared_ptr<SendTrack> sendTrack;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sendTrack = sendTrackSlot(type);
+        }
+
+        if (!sendTrack || sendTrack->config.prepacketized || !sendTrack->track->isOpen()) {
+            return false;
+        }
+
+        // The packetizer reads the RTP timestamp from the shared config, so the
+        // timestamp update and the send must not interleave with another frame
+        std::lock_guard<std::mutex> sendLock(sendTrack->sendMutex);
+        updateRtpTimestamp(*sendTrack, timestampUs);
+
+        try {
+            sendTrack->track->send(reinterpret_cast<const rtc::byte*>(data), size);
+        } catch (const std::exception& e) {
+            log(LogLevel::Warning, std::string("Failed to send frame: ") + e.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool sendPacketizedFrame(MediaType type, const PacketizedFrame& frame, int64_t timestampUs) {
+        if (frame.payloads.empty()) {
+            return false;
+        }
+
+        std::shared_ptr<SendTrack> sendTrack;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sendTrack = sendTrackSlot(type);
+        }
+
+        if (!sendTrack || !sendTrack->config.prepacketized || !sendTrack->track->isOpen()) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> sendLock(sendTrack->sendMutex);
+        updateRtpTimestamp(*sendTrack, timestampUs);
+
+        auto& rtpConfig = *sendTrack->rtpConfig;
+        try {
+            for (const auto& payload : frame.payloads) {
+                // Every connection needs its own copy: SRTP encrypts in place
+                rtc::binary packet(constants::kRtpHeaderSize + payload.size);
+                auto* bytes = reinterpret_cast<uint8_t*>(packet.data());
+                writeRtpHeader(bytes, rtpConfig.payloadType, payload.marker,
+                               rtpConfig.sequenceNumber++, rtpConfig.timestamp, rtpConfig.ssrc);
+                std::memcpy(bytes + constants::kRtpHeaderSize, frame.data(payload), payload.size);
+                sendTrack->track->send(std::move(packet));
+            }
+        } catch (const std::exception& e) {
+            log(LogLevel::Warning, std::string("Failed to send frame: ") + e.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    void setFecProtectionRatio(double ratio) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (videoSendTrack_ && videoSendTrack_->fec) {
+            videoSendTrack_->fec->setProtectionRatio(ratio);
+        }
+    }
+
+    JitterBufferStats getJitterBufferStats(MediaType type) const {
+        std::lock_guard<std::mutex> lock(receiveMutex_);
+        const auto& receiveTrack =
+            type == MediaType::Video ? videoReceiveTrack_ : audioReceiveTrack_;
+        return receiveTrack ? receiveTrack->buffer.getStats() : JitterBufferStats();
+    }
+
+    bool requestKeyframe() {
+        std::shared_ptr<ReceiveTrack> receiveTrack;
+        {
+            std::lock_guard<std::mutex> lock(receiveMutex_);
+            receiveTrack = videoReceiveTrack_;
+        }
+        return receiveTrack && sendKeyframeRequest(*receiveTrack);
+    }
+
 private:
+    /**
+     * @brief Outgoing track and its packetization state
+     */
+    struct SendTrack {
+        MediaTrackConfig config;
+        std::shared_ptr<rtc::Track> track;
+        std::shared_ptr<rtc::RtpPacketizationConfig> rtpConfig;
+        std::shared_ptr<FecHandler> fec;  // Video tracks with a FEC SSRC
+        uint32_t clockRate = 0;
+        int64_t firstTimestampUs = -1;
+        std::mutex sendMutex;  // Serializes timestamp update + send per track
+    };
+
+    std::shared_ptr<SendTrack>& sendTrackSlot(MediaType type) {
+        return type == MediaType::Video ? videoSendTrack_ : audioSendTrack_;
+    }
+
+    /**
+     * @brief Received track and the jitter buffer its RTP goes through
+     */
+    struct ReceiveTrack {
+        ReceiveTrack(MediaType mediaType, std::shared_ptr<rtc::Track> rtcTrack,
+                     const JitterBufferConfig& bufferConfig, BitstreamCodec codec,
+                     const AudioCodecDescriptor& audio)
+            : type(mediaType)
+            , track(std::move(rtcTrack))
+            , buffer(bufferConfig)
+            , videoCodec(codec)
+            , inspector(codec)
+            , audioCodec(audio) {}
+
+        MediaType type;
+        std::weak_ptr<rtc::Track> track;  // For keyframe requests; the track owns this
+        JitterBuffer buffer;  // Guarded by receiveMutex_
+        const BitstreamCodec videoCodec;  // From the SDP at negotiation; video tracks only
+        BitstreamInspector inspector;  // Release thread only
+        const AudioCodecDescriptor audioCodec;  // From the SDP at negotiation; audio tracks only
+        std::atomic<int64_t> lastKeyframeRequestMs{-1};  // Video; steady clock
+    };
+
+    /**
+     * @brief Send a PLI for a received track, at most once per minKeyframeRequestIntervalMs
+     */
+    bool sendKeyframeRequest(ReceiveTrack& receiveTrack) {
+        const int64_t nowMs = steadyNowMs();
+        int64_t lastMs = receiveTrack.lastKeyframeRequestMs.load();
+        do {
+            if (lastMs >= 0 && nowMs - lastMs < config_.minKeyframeRequestIntervalMs) {
+                return false;
+            }
+        } while (!receiveTrack.lastKeyframeRequestMs.compare_exchange_weak(lastMs, nowMs));
+
+        auto track = receiveTrack.track.lock();
+        if (!track) {
+            return false;
+        }
+        try {
+            return track->requestKeyframe();
+        } catch (const std::exception& e) {
+            log(LogLevel::Warning, std::string("Failed to request keyframe: ") + e.what());
+            return false;
+        }
+    }
+
+    /**
+     * @brief Set the track's RTP timestamp for a frame; caller holds sendMutex
+     */
+    static void updateRtpTimestamp(SendTrack& sendTrack, int64_t timestampUs) {
+        if (sendTrack.firstTimestampUs < 0) {
+            sendTrack.firstTimestampUs = timestampUs;
+        }
+
+        const int64_t elapsedUs = std::max<int64_t>(0, timestampUs - sendTrack.firstTimestampUs);
+        const uint64_t elapsedTicks = static_cast<uint64_t>(elapsedUs) * sendTrack.clockRate / 1000000;
+        sendTrack.rtpConfig->timestamp =
+            sendTrack.rtpConfig->startTimestamp + static_cast<uint32_t>(elapsedTicks);
+    }
+
     void setupCallbacks() {
         // State change callback
         peerConnection_->onStateChange([this](rtc::PeerConnection::State rtcState) {
@@ -380,59 +1108,287 @@ private:
             tracks_.push_back(track);
         }
 
-        // Set up frame callback
-        track->onFrame([this, mediaType](rtc::binary data, rtc::FrameInfo frameInfo) {
-            handleFrame(data, frameInfo, mediaType);
-        });
+        MediaType type;
+        if (mediaType == "video") {
+            type = MediaType::Video;
+        } else if (mediaType == "audio") {
+            type = MediaType::Audio;
+        } else {
+            log(LogLevel::Warning, "Unknown media type: " + mediaType);
+            return;
+        }
+
+        // The receiving session answers with receiver reports; RTP itself
+        // goes through a jitter buffer, which reorders it and reassembles
+        // frames before they are handed out on the release thread
+        BitstreamCodec videoCodec = BitstreamCodec::H264;
+        if (type == MediaType::Video && !describeReceivedVideo(description, videoCodec)) {
+            return;
+        }
+        track->setMediaHandler(std::make_shared<rtc::RtcpReceivingSession>());
+        auto receiveTrack =
+            addReceiveTrack(type, track, videoCodec, describeReceivedAudio(type, description));
+
+        track->onMessage(
+            [this, receiveTrack](rtc::binary packet) { receivePacket(*receiveTrack, packet); },
+            nullptr);
 
         log(LogLevel::Debug, "Track handler registered for: " + std::string(track->mid()));
     }
 
-    void handleFrame(const rtc::binary& data, const rtc::FrameInfo& frameInfo, const std::string& mediaType) {
-        try {
-            if (mediaType == "video") {
-                handleVideoFrame(data, frameInfo);
-            } else if (mediaType == "audio") {
-                handleAudioFrame(data, frameInfo);
+    /**
+     * @brief Read the codec parameters of a received audio track, once per track
+     *
+     * Frames only copy fields out of the result, so SDP strings are never
+     * looked at on the frame path. Without an Opus section the defaults stay.
+     */
+    AudioCodecDescriptor describeReceivedAudio(MediaType type,
+                                               const rtc::Description::Media& description) {
+        AudioCodecDescriptor codec;
+        if (type != MediaType::Audio) {
+            return codec;
+        }
+
+        const std::vector<SdpMediaSection> sections =
+            parseSdpMediaSections(description.generateSdp("\r\n"));
+        if (!sections.empty()) {
+            codec = describeAudioCodec(sections.front());
+        }
+        if (!codec.negotiated) {
+            log(LogLevel::Warning, "No Opus parameters in the audio section; assuming " +
+                                       std::to_string(codec.channels) + " channels");
+            return codec;
+        }
+
+        log(LogLevel::Info,
+            "Audio negotiated: Opus PT " + std::to_string(codec.payloadType) + ", " +
+                std::to_string(codec.channels) + " channel(s), capture up to " +
+                std::to_string(codec.maxCaptureRate) + " Hz, in-band FEC " +
+                (codec.inbandFec ? "on" : "off") +
+                (codec.ptimeMs > 0 ? ", ptime " + std::to_string(codec.ptimeMs) + " ms" : ""));
+        return codec;
+    }
+
+    /**
+     * @brief Pick the codec of a received video track, once per track
+     *
+     * Takes the most preferred payload type that frames can be reassembled
+     * for: H.264, VP8 or VP9. The frame-start check, the reassembly and the
+     * keyframe detection all follow it. AV1 is not reassembled on receive.
+     *
+     * @return false if the section offers none of them
+     */
+    bool describeReceivedVideo(const rtc::Description::Media& description,
+                               BitstreamCodec& codec) {
+        const std::vector<SdpMediaSection> sections =
+            parseSdpMediaSections(description.generateSdp("\r\n"));
+        bool offersAv1 = false;
+        if (!sections.empty()) {
+            for (const SdpCodec& offered : sections.front().codecs) {
+                if (offered.is("AV1")) {
+                    offersAv1 = true;
+                    continue;
+                }
+                if (offered.is("H264")) {
+                    codec = BitstreamCodec::H264;
+                } else if (offered.is("VP8")) {
+                    codec = BitstreamCodec::VP8;
+                } else if (offered.is("VP9")) {
+                    codec = BitstreamCodec::VP9;
+                } else {
+                    continue;
+                }
+                log(LogLevel::Info, "Video negotiated: " + offered.name + " PT " +
+                                        std::to_string(offered.payloadType));
+                return true;
+            }
+        }
+
+        if (offersAv1) {
+            log(LogLevel::Warning,
+                "Video negotiated AV1, which cannot be received; ignoring the track");
+        } else {
+            log(LogLevel::Warning, "No H264, VP8 or VP9 in the video section; ignoring the track");
+        }
+        return false;
+    }
+
+    std::shared_ptr<ReceiveTrack> addReceiveTrack(MediaType type,
+                                                  const std::shared_ptr<rtc::Track>& track,
+                                                  BitstreamCodec videoCodec,
+                                                  const AudioCodecDescriptor& audioCodec) {
+        JitterBufferConfig bufferConfig;
+        bufferConfig.minDelayMs = config_.jitterBufferMinDelayMs;
+        bufferConfig.maxDelayMs = config_.jitterBufferMaxDelayMs;
+        if (type == MediaType::Audio) {
+            // Opus carries exactly one frame per RTP packet
+            bufferConfig.clockRate = audioCodec.clockRate;
+            bufferConfig.singlePacketFrames = true;
+        } else if (videoCodec == BitstreamCodec::VP8) {
+            bufferConfig.isFrameStart = isVp8FrameStart;
+        } else if (videoCodec == BitstreamCodec::VP9) {
+            bufferConfig.isFrameStart = isVp9FrameStart;
+        } else {
+            bufferConfig.isFrameStart = isH264FrameStart;
+        }
+        auto receiveTrack =
+            std::make_shared<ReceiveTrack>(type, track, bufferConfig, videoCodec, audioCodec);
+
+        std::lock_guard<std::mutex> lock(receiveMutex_);
+        (type == MediaType::Video ? videoReceiveTrack_ : audioReceiveTrack_) = receiveTrack;
+        if (!releaseThread_.joinable() && !releaseStopped_) {
+            releaseThread_ = std::thread(
+                [this, detached = releaseDetached_]() { releaseLoop(*detached); });
+        }
+        return receiveTrack;
+    }
+
+    void receivePacket(ReceiveTrack& receiveTrack, const rtc::binary& packet) {
+        size_t payloadOffset = 0;
+        size_t payloadSize = 0;
+        uint32_t timestamp = 0;
+        uint16_t sequence = 0;
+        bool marker = false;
+        if (!locateRtpPayload(packet, payloadOffset, payloadSize, timestamp, sequence, marker)) {
+            return;
+        }
+
+        // The one copy out of libdatachannel's buffer
+        BufferSlice payload = receivePool_.copy(
+            reinterpret_cast<const uint8_t*>(packet.data()) + payloadOffset, payloadSize);
+        {
+            std::lock_guard<std::mutex> lock(receiveMutex_);
+            receiveTrack.buffer.insert(sequence, timestamp, marker, std::move(payload),
+                                       steadyNowMs());
+        }
+        releaseCondition_.notify_one();
+    }
+
+    /**
+     * @brief Release thread: hands out frames as their playout time comes
+     *
+     * @param detached Set once a frame callback stopped the thread; owned by
+     *        the thread too, since the callback may have destroyed this
+     */
+    void releaseLoop(const std::atomic<bool>& detached) {
+        JitterFrame frame;
+        std::unique_lock<std::mutex> lock(receiveMutex_);
+        while (!releaseStopped_) {
+            int64_t wakeMs = -1;
+            for (const auto& receiveTrack : {videoReceiveTrack_, audioReceiveTrack_}) {
+                if (!receiveTrack) {
+                    continue;
+                }
+                while (receiveTrack->buffer.pop(steadyNowMs(), frame)) {
+                    lock.unlock();
+                    deliverFrame(*receiveTrack, frame);
+                    if (detached) {
+                        return;  // Nothing of this may be touched any more
+                    }
+                    lock.lock();
+                }
+                const int64_t releaseMs = receiveTrack->buffer.nextReleaseMs();
+                if (releaseMs >= 0 && (wakeMs < 0 || releaseMs < wakeMs)) {
+                    wakeMs = releaseMs;
+                }
+            }
+
+            if (releaseStopped_) {
+                break;
+            }
+            if (wakeMs < 0) {
+                releaseCondition_.wait(lock);
             } else {
-                log(LogLevel::Warning, "Unknown media type: " + mediaType);
+                releaseCondition_.wait_until(
+                    lock, std::chrono::steady_clock::time_point(std::chrono::milliseconds(wakeMs)));
+            }
+        }
+    }
+
+    void stopReleaseThread() {
+        {
+            std::lock_guard<std::mutex> lock(receiveMutex_);
+            releaseStopped_ = true;
+        }
+        releaseCondition_.notify_all();
+        if (releaseThread_.get_id() == std::this_thread::get_id()) {
+            // Stopped from a frame callback, which may go on to destroy the
+            // connection: the loop exits once the callback returns
+            *releaseDetached_ = true;
+            releaseThread_.detach();
+        } else if (releaseThread_.joinable()) {
+            releaseThread_.join();
+        }
+    }
+
+    void deliverFrame(ReceiveTrack& receiveTrack, const JitterFrame& frame) {
+        try {
+            if (receiveTrack.type == MediaType::Audio) {
+                for (const BufferSlice& payload : frame.payloads) {
+                    handleAudioFrame(receiveTrack.audioCodec, payload, frame.timestamp);
+                }
+                return;
+            }
+
+            // Frames were lost: what follows cannot be decoded until the next keyframe
+            if (frame.discontinuity) {
+                sendKeyframeRequest(receiveTrack);
+            }
+
+            BufferSlice accessUnit = assembleVideoFrame(receiveTrack.videoCodec, frame);
+            if (!accessUnit.empty()) {
+                const BitstreamFrameInfo info =
+                    receiveTrack.inspector.inspect(accessUnit.data(), accessUnit.size());
+                handleVideoFrame(accessUnit, frame.timestamp, info);
             }
         } catch (const std::exception& e) {
             log(LogLevel::Error, std::string("Error handling frame: ") + e.what());
         }
     }
 
-    void handleVideoFrame(const rtc::binary& data, const rtc::FrameInfo& frameInfo) {
+    BufferSlice assembleVideoFrame(BitstreamCodec codec, const JitterFrame& frame) {
+        switch (codec) {
+            case BitstreamCodec::VP8:
+                return assembleVp8Frame(frame, receivePool_);
+            case BitstreamCodec::VP9:
+                return assembleVp9Frame(frame, receivePool_);
+            default:
+                return assembleH264AccessUnit(frame, receivePool_);
+        }
+    }
+
+    void handleVideoFrame(const BufferSlice& data, uint32_t timestamp,
+                          const BitstreamFrameInfo& info) {
         if (!config_.videoFrameCallback) {
             return;
         }
 
+        // Consumers share the assembled access unit
         VideoFrame frame;
-        frame.data.resize(data.size());
-        std::memcpy(frame.data.data(), data.data(), data.size());
-        frame.timestamp = frameInfo.timestamp;
-        frame.keyframe = false; // TODO: Detect keyframe from RTP packet
-        frame.width = 0;  // TODO: Parse from codec-specific data
-        frame.height = 0; // TODO: Parse from codec-specific data
+        frame.data = data;
+        frame.timestamp = timestamp;
+        frame.keyframe = info.keyframe;
+        frame.width = info.width;  // 0 until the first SPS arrives
+        frame.height = info.height;
 
-        log(LogLevel::Debug, "Video frame received: " + std::to_string(data.size()) + " bytes, timestamp: " + std::to_string(frameInfo.timestamp));
+        log(LogLevel::Debug, "Video frame received: " + std::to_string(data.size()) + " bytes, timestamp: " + std::to_string(timestamp));
 
         config_.videoFrameCallback(frame);
     }
 
-    void handleAudioFrame(const rtc::binary& data, const rtc::FrameInfo& frameInfo) {
+    void handleAudioFrame(const AudioCodecDescriptor& codec, const BufferSlice& data,
+                          uint32_t timestamp) {
         if (!config_.audioFrameCallback) {
             return;
         }
 
         AudioFrame frame;
-        frame.data.resize(data.size());
-        std::memcpy(frame.data.data(), data.data(), data.size());
-        frame.timestamp = frameInfo.timestamp;
-        frame.sampleRate = constants::kDefaultAudioSampleRate; // TODO: Parse from SDP or codec configuration
-        frame.channels = constants::kDefaultAudioChannels;     // TODO: Parse from SDP or codec configuration
+        frame.data = data;
+        frame.timestamp = timestamp;
+        frame.sampleRate = codec.clockRate;
+        frame.channels = codec.channels;
 
-        log(LogLevel::Debug, "Audio frame received: " + std::to_string(data.size()) + " bytes, timestamp: " + std::to_string(frameInfo.timestamp));
+        log(LogLevel::Debug, "Audio frame received: " + std::to_string(data.size()) + " bytes, timestamp: " + std::to_string(timestamp));
 
         config_.audioFrameCallback(frame);
     }
@@ -517,16 +1473,29 @@ private:
     }
 
     PeerConnectionConfig config_;
+    BufferPool receivePool_;  // Received frame payloads; outlives the connection's callbacks
     std::shared_ptr<rtc::PeerConnection> peerConnection_;
     std::shared_ptr<rtc::DataChannel> dataChannel_;  // Keep reference to data channel
     std::vector<std::shared_ptr<rtc::DataChannel>> additionalDataChannels_;  // Additional data channels for renegotiation
     std::vector<std::shared_ptr<rtc::Track>> tracks_;  // Keep references to media tracks
+    std::shared_ptr<SendTrack> videoSendTrack_;  // Outgoing video track (if added)
+    std::shared_ptr<SendTrack> audioSendTrack_;  // Outgoing audio track (if added)
     ConnectionState state_;
     bool hasRemoteDescription_;
     std::string remoteDescriptionSdp_;
     std::vector<std::pair<std::string, std::string>> pendingCandidates_;  // Buffered candidates
     int offerCount_;  // Track number of offers for renegotiation detection
     mutable std::mutex mutex_;  // Mutable for const methods
+
+    // Receive path: jitter buffers and the thread that releases their frames
+    std::shared_ptr<ReceiveTrack> videoReceiveTrack_;
+    std::shared_ptr<ReceiveTrack> audioReceiveTrack_;
+    std::thread releaseThread_;
+    std::shared_ptr<std::atomic<bool>> releaseDetached_ =
+        std::make_shared<std::atomic<bool>>(false);
+    bool releaseStopped_ = false;
+    std::condition_variable releaseCondition_;
+    mutable std::mutex receiveMutex_;  // Guards the receive tracks and their buffers
 };
 
 // Public interface implementation
@@ -574,5 +1543,30 @@ std::string PeerConnection::getRemoteDescription() const {
     return impl_->getRemoteDescription();
 }
 
+void PeerConnection::addTrack(const MediaTrackConfig& config) {
+    impl_->addTrack(config);
+}
+
+bool PeerConnection::sendFrame(MediaType type, const uint8_t* data, size_t size, int64_t timestampUs) {
+    return impl_->sendFrame(type, data, size, timestampUs);
+}
+
+bool PeerConnection::sendPacketizedFrame(MediaType type, const PacketizedFrame& frame,
+                                         int64_t timestampUs) {
+    return impl_->sendPacketizedFrame(type, frame, timestampUs);
+}
+
+void PeerConnection::setFecProtectionRatio(double ratio) {
+    impl_->setFecProtectionRatio(ratio);
+}
+
+JitterBufferStats PeerConnection::getJitterBufferStats(MediaType type) const {
+    return impl_->getJitterBufferStats(type);
+}
+
+bool PeerConnection::requestKeyframe() {
+    return impl_->requestKeyframe();
+}
+
 }  // namespace core
 }  // namespace obswebrtc
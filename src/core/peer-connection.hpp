@@ -9,8 +9,19 @@
 
 #pragma once
 
+#include "buffer-pool.hpp"
+#include "constants.hpp"
+#include "fec-encoder.hpp"
+#include "jitter-buffer.hpp"
+#include "pacer.hpp"
+#include "rtcp-feedback.hpp"
+#include "rtp-packet-history.hpp"
+#include "rtp-packetizer.hpp"
+
 #include <rtc/rtc.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -50,11 +61,66 @@ enum class SdpType {
     Answer
 };
 
+/**
+ * @brief Media type of an outgoing track
+ */
+enum class MediaType {
+    Video,
+    Audio
+};
+
+/**
+ * @brief Codec carried by an outgoing track
+ */
+enum class MediaCodec {
+    H264,
+    VP8,
+    VP9,
+    AV1,
+    Opus
+};
+
+/**
+ * @brief Configuration for an outgoing (send-only) media track
+ */
+struct MediaTrackConfig {
+    MediaType type = MediaType::Video;
+    MediaCodec codec = MediaCodec::H264;
+    std::string mid;                           // Media stream identification tag
+    uint32_t ssrc = 0;                         // RTP synchronization source
+    uint8_t payloadType = 96;                  // RTP payload type
+    std::string cname = "obs-webrtc-link";     // RTCP canonical name
+    std::string streamId = "obs-webrtc-link";  // msid stream identifier
+
+    // Video only: frames arrive already packetized through sendPacketizedFrame()
+    // (e.g. shared by several connections), so the track has no packetizer
+    bool prepacketized = false;
+
+    // Video only, H.264: encoder extradata (Annex-B or avcC). Its SPS/PPS, or
+    // later in-band ones, are sent as a STAP-A ahead of IDRs that lack them
+    std::vector<uint8_t> extradata;
+
+    // Video only: answer NACKs with RTX (RFC 4588) from a history bounded by
+    // rtxHistory. 0 keeps libdatachannel's responder, which resends in-stream
+    uint32_t rtxSsrc = 0;
+    uint8_t rtxPayloadType = constants::kDefaultRtxPayloadType;
+    RtpPacketHistoryConfig rtxHistory;
+
+    // Video only: protect the stream with FlexFEC (flexfec-03) on its own
+    // SSRC. 0 disables FEC; the ratio can change with setFecProtectionRatio()
+    uint32_t fecSsrc = 0;
+    uint8_t fecPayloadType = constants::kDefaultFecPayloadType;
+    double fecProtectionRatio = constants::kDefaultFecProtectionRatio;
+};
+
 /**
  * @brief Video frame structure
+ *
+ * `data` shares a pooled receive buffer: copying the frame does not copy
+ * the payload.
  */
 struct VideoFrame {
-    std::vector<uint8_t> data;
+    BufferSlice data;  // Access unit as received (Annex-B for H.264)
     uint32_t width;
     uint32_t height;
     uint64_t timestamp;
@@ -63,11 +129,13 @@ struct VideoFrame {
 
 /**
  * @brief Audio frame structure
+ *
+ * `data` shares a pooled receive buffer, like VideoFrame.
  */
 struct AudioFrame {
-    std::vector<uint8_t> data;
-    uint32_t sampleRate;
-    uint32_t channels;
+    BufferSlice data;  // Encoded frame as received (one Opus packet)
+    uint32_t sampleRate;  // RTP clock rate of the negotiated codec
+    uint32_t channels;    // Channels the sender negotiated (Opus sprop-stereo/stereo)
     uint64_t timestamp;
 };
 
@@ -81,6 +149,8 @@ using IceCandidateCallback =
 using LocalDescriptionCallback = std::function<void(SdpType type, const std::string& sdp)>;
 using VideoFrameCallback = std::function<void(const VideoFrame& frame)>;
 using AudioFrameCallback = std::function<void(const AudioFrame& frame)>;
+using RtcpFeedbackCallback =
+    std::function<void(MediaType type, const RtcpFeedback& feedback, int64_t rttMs)>;
 
 /**
  * @brief Configuration for PeerConnection
@@ -93,6 +163,27 @@ struct PeerConnectionConfig {
     LocalDescriptionCallback localDescriptionCallback;
     VideoFrameCallback videoFrameCallback;
     AudioFrameCallback audioFrameCallback;
+
+    // Optional pacer for outgoing RTP of send tracks (unpaced if null)
+    std::shared_ptr<Pacer> pacer;
+
+    // Optional RTCP feedback about send tracks (report blocks and keyframe
+    // requests filtered to the track's SSRC; rttMs is -1 when no report block
+    // carried an SR reference)
+    RtcpFeedbackCallback rtcpFeedbackCallback;
+
+    // Optional statistics sink for retransmission hits and misses (must
+    // outlive the PeerConnection)
+    NetworkStatisticsCollector* statistics = nullptr;
+
+    // Bounds of the receive jitter buffers' adaptive delay; a low minimum
+    // trades smoothness on jittery networks for latency
+    int jitterBufferMinDelayMs = constants::kDefaultJitterBufferMinDelayMs;
+    int jitterBufferMaxDelayMs = constants::kDefaultJitterBufferMaxDelayMs;
+
+    // Receive side: keyframe requests (PLI) for the received video track are
+    // sent at most once per interval, however many consumers ask
+    int minKeyframeRequestIntervalMs = constants::kDefaultKeyframeRequestIntervalMs;
 };
 
 /**
@@ -122,6 +213,7 @@ public:
     /**
      * @brief Construct a new PeerConnection
      * @param config Configuration for the peer connection
+     * @throws std::invalid_argument if the jitter buffer delay bounds are invalid
      * @throws std::runtime_error if initialization fails
      */
     explicit PeerConnection(const PeerConnectionConfig& config);
@@ -207,6 +299,93 @@ public:
      */
     std::string getRemoteDescription() const;
 
+    /**
+     * @brief Add a send-only media track
+     *
+     * Video tracks are packetized with the core/rtp-packetizer.hpp packetizer
+     * for their codec, unless they are prepacketized, and Opus with
+     * libdatachannel's. Every track reports RTCP sender reports.
+     * Tracks must be added before createOffer() so they are part of the offer.
+     *
+     * @param config Track configuration
+     * @throws std::invalid_argument if the codec does not match the media type
+     * @throws std::runtime_error if the track cannot be created
+     */
+    void addTrack(const MediaTrackConfig& config);
+
+    /**
+     * @brief Send an encoded access unit on a send track
+     *
+     * For H.264 the data must be Annex-B (start code delimited). The
+     * timestamp is converted to the track's RTP clock relative to the first
+     * frame sent on that track.
+     *
+     * Calls for the same media type must not overlap; different media types
+     * may be sent from different threads. When a pacer is configured the
+     * resulting RTP packets are queued on it (audio on the priority lane)
+     * instead of being sent immediately.
+     *
+     * @param type Media type of the track to send on
+     * @param data Encoded frame data
+     * @param size Size of the encoded frame in bytes
+     * @param timestampUs Presentation timestamp in microseconds
+     * @return true if the frame was handed to the transport, false if no such
+     *         track exists or the track is not open yet
+     */
+    bool sendFrame(MediaType type, const uint8_t* data, size_t size, int64_t timestampUs);
+
+    /**
+     * @brief Send a frame that was packetized by the caller
+     *
+     * Only for tracks added with MediaTrackConfig::prepacketized. Each
+     * payload gets this track's RTP header (SSRC, payload type, its own
+     * sequence number and timestamp), so one PacketizedFrame can be sent on
+     * several PeerConnections. Timestamps, threading and pacing behave as
+     * in sendFrame().
+     *
+     * @param type Media type of the track to send on
+     * @param frame RTP payloads of one frame
+     * @param timestampUs Presentation timestamp in microseconds
+     * @return true if the frame was handed to the transport, false if no such
+     *         prepacketized track exists or the track is not open yet
+     */
+    bool sendPacketizedFrame(MediaType type, const PacketizedFrame& frame, int64_t timestampUs);
+
+    /**
+     * @brief Change the FEC protection ratio of the video track
+     *
+     * Takes effect from the next packet. No-op if the video track was added
+     * without a FEC SSRC. Thread-safe.
+     *
+     * @param ratio FEC packets per media packet, clamped to [0, 1]
+     */
+    void setFecProtectionRatio(double ratio);
+
+    /**
+     * @brief Get the receive jitter buffer state of a received track
+     *
+     * Received RTP is reordered and held in a jitter buffer per media type
+     * before it reaches videoFrameCallback or audioFrameCallback (see
+     * core/jitter-buffer.hpp). Thread-safe.
+     *
+     * @param type Media type of the received track
+     * @return Delay and counters, all zero if no such track was received
+     */
+    JitterBufferStats getJitterBufferStats(MediaType type) const;
+
+    /**
+     * @brief Ask the sender of the received video track for a keyframe
+     *
+     * Sends an RTCP PLI, at most once per minKeyframeRequestIntervalMs; the
+     * jitter buffer's own requests after lost frames count towards the same
+     * limit. Consumers that skip frames until the next keyframe (e.g. a
+     * decoder queue that overflowed) call this while they wait. Thread-safe.
+     *
+     * @return true if a request was sent, false if no video track was
+     *         received or a request went out less than the interval ago
+     */
+    bool requestKeyframe();
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
@@ -0,0 +1,190 @@
+/**
+ * @file rtcp-feedback.cpp
+ * @brief Implementation of RTCP feedback parsing
+ */
+
+#include "rtcp-feedback.hpp"
+
+#include <chrono>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+constexpr uint8_t kRtcpSenderReport = 200;
+constexpr uint8_t kRtcpReceiverReport = 201;
+constexpr uint8_t kRtcpTransportFeedback = 205;
+constexpr uint8_t kRtcpPayloadFeedback = 206;
+constexpr uint8_t kRtpfbNackFormat = 1;
+constexpr uint8_t kPsfbPliFormat = 1;
+constexpr uint8_t kPsfbFirFormat = 4;
+constexpr uint8_t kPsfbRembFormat = 15;
+
+constexpr size_t kRtcpHeaderSize = 4;
+constexpr size_t kSenderInfoSize = 20;
+constexpr size_t kReportBlockSize = 24;
+constexpr size_t kFirEntrySize = 8;
+constexpr size_t kNackEntrySize = 4;
+
+/** Seconds between the NTP epoch (1900) and the Unix epoch (1970) */
+constexpr uint64_t kNtpUnixOffsetSec = 2208988800ULL;
+
+uint32_t readU32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+uint32_t readU24(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) |
+           static_cast<uint32_t>(p[2]);
+}
+
+void parseReportBlocks(const uint8_t* p, size_t available, uint8_t count,
+                       std::vector<RtcpReportBlock>& out) {
+    for (uint8_t i = 0; i < count && available >= kReportBlockSize; i++) {
+        RtcpReportBlock block;
+        block.ssrc = readU32(p);
+        block.fractionLost = p[4];
+        const uint32_t lost = readU24(p + 5);
+        block.cumulativeLost = (lost & 0x800000) ? static_cast<int32_t>(lost | 0xFF000000)
+                                                 : static_cast<int32_t>(lost);
+        block.highestSequence = readU32(p + 8);
+        block.jitter = readU32(p + 12);
+        block.lastSenderReport = readU32(p + 16);
+        block.delaySinceLastSr = readU32(p + 20);
+        out.push_back(block);
+
+        p += kReportBlockSize;
+        available -= kReportBlockSize;
+    }
+}
+
+void parseRemb(const uint8_t* fci, size_t available, RtcpFeedback& feedback) {
+    // "REMB" | num SSRC (8) | BR exp (6) | BR mantissa (18) | SSRC list
+    if (available < 8 || fci[0] != 'R' || fci[1] != 'E' || fci[2] != 'M' || fci[3] != 'B') {
+        return;
+    }
+
+    const uint8_t ssrcCount = fci[4];
+    const uint8_t exponent = fci[5] >> 2;
+    const uint32_t mantissa = readU24(fci + 5) & 0x3FFFF;
+
+    feedback.hasRemb = true;
+    feedback.rembBitrateBps =
+        exponent >= 46 ? UINT64_MAX : static_cast<uint64_t>(mantissa) << exponent;
+    feedback.rembSsrcs.clear();
+    for (uint8_t i = 0; i < ssrcCount && available >= 8 + (i + 1) * 4u; i++) {
+        feedback.rembSsrcs.push_back(readU32(fci + 8 + i * 4));
+    }
+}
+
+}  // namespace
+
+bool parseRtcpFeedback(const uint8_t* data, size_t size, RtcpFeedback& feedback) {
+    if (!data) {
+        return false;
+    }
+
+    bool parsedAny = false;
+    size_t offset = 0;
+
+    while (size - offset >= kRtcpHeaderSize) {
+        const uint8_t* header = data + offset;
+        if ((header[0] >> 6) != 2) {
+            break;
+        }
+
+        const uint8_t count = header[0] & 0x1F;
+        const uint8_t packetType = header[1];
+        const size_t length = (static_cast<size_t>((header[2] << 8) | header[3]) + 1) * 4;
+        if (length > size - offset) {
+            break;
+        }
+
+        const uint8_t* body = header + kRtcpHeaderSize;
+        const size_t bodySize = length - kRtcpHeaderSize;
+
+        switch (packetType) {
+            case kRtcpSenderReport:
+                // Sender SSRC + sender info, then report blocks
+                if (bodySize >= 4 + kSenderInfoSize) {
+                    parseReportBlocks(body + 4 + kSenderInfoSize, bodySize - 4 - kSenderInfoSize,
+                                      count, feedback.reportBlocks);
+                }
+                break;
+            case kRtcpReceiverReport:
+                if (bodySize >= 4) {
+                    parseReportBlocks(body + 4, bodySize - 4, count, feedback.reportBlocks);
+                }
+                break;
+            case kRtcpTransportFeedback:
+                // Sender SSRC + media SSRC, then (PID, BLP) pairs: PID is lost, and
+                // bit i of BLP marks PID + i + 1 as lost too
+                if (count == kRtpfbNackFormat && bodySize >= 8) {
+                    const uint32_t mediaSsrc = readU32(body + 4);
+                    for (size_t entry = 8; entry + kNackEntrySize <= bodySize;
+                         entry += kNackEntrySize) {
+                        const uint16_t pid = static_cast<uint16_t>((body[entry] << 8) | body[entry + 1]);
+                        const uint16_t blp =
+                            static_cast<uint16_t>((body[entry + 2] << 8) | body[entry + 3]);
+                        feedback.nacks.push_back({mediaSsrc, pid});
+                        for (int bit = 0; bit < 16; bit++) {
+                            if (blp & (1 << bit)) {
+                                feedback.nacks.push_back(
+                                    {mediaSsrc, static_cast<uint16_t>(pid + bit + 1)});
+                            }
+                        }
+                    }
+                }
+                break;
+            case kRtcpPayloadFeedback:
+                // Sender SSRC + media SSRC, then FCI
+                if (bodySize < 8) {
+                    break;
+                }
+                if (count == kPsfbRembFormat) {
+                    parseRemb(body + 8, bodySize - 8, feedback);
+                } else if (count == kPsfbPliFormat) {
+                    feedback.keyframeRequestSsrcs.push_back(readU32(body + 4));
+                } else if (count == kPsfbFirFormat) {
+                    // FIR names the media sources in its FCI entries (SSRC, seq nr, reserved)
+                    for (size_t entry = 8; entry + kFirEntrySize <= bodySize; entry += kFirEntrySize) {
+                        feedback.keyframeRequestSsrcs.push_back(readU32(body + entry));
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+
+        parsedAny = true;
+        offset += length;
+    }
+
+    return parsedAny;
+}
+
+uint32_t compactNtpNow() {
+    const auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count();
+    const uint64_t seconds = static_cast<uint64_t>(micros / 1000000) + kNtpUnixOffsetSec;
+    const uint64_t fraction = (static_cast<uint64_t>(micros % 1000000) << 32) / 1000000;
+    return static_cast<uint32_t>(((seconds & 0xFFFF) << 16) | (fraction >> 16));
+}
+
+int64_t calculateRttMs(const RtcpReportBlock& block, uint32_t compactNtpArrival) {
+    if (block.lastSenderReport == 0) {
+        return -1;
+    }
+
+    // Unsigned wrap-around arithmetic in 1/65536 s units
+    const uint32_t rtt = compactNtpArrival - block.lastSenderReport - block.delaySinceLastSr;
+    if (rtt > 0x80000000u) {
+        return 0;  // Clock jitter made it (slightly) negative
+    }
+    return (static_cast<int64_t>(rtt) * 1000) >> 16;
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,84 @@
+/**
+ * @file rtcp-feedback.hpp
+ * @brief Parsing of RTCP feedback received on send tracks
+ *
+ * This module provides:
+ * - Compound RTCP parsing (RFC 3550 SR/RR report blocks)
+ * - Receiver Estimated Maximum Bitrate (REMB, draft-alvestrand-rmcat-remb)
+ * - Keyframe requests: PLI (RFC 4585) and FIR (RFC 5104)
+ * - Generic NACK (RFC 4585), expanded to one entry per lost packet
+ * - Round-trip time calculation from report block LSR/DLSR
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief One reception report block from an SR or RR (RFC 3550 section 6.4)
+ */
+struct RtcpReportBlock {
+    uint32_t ssrc = 0;                // Source the report is about (our send SSRC)
+    uint8_t fractionLost = 0;         // Fraction lost since last report, in 1/256
+    int32_t cumulativeLost = 0;       // Total packets lost (signed 24-bit)
+    uint32_t highestSequence = 0;     // Extended highest sequence number received
+    uint32_t jitter = 0;              // Interarrival jitter in RTP timestamp units
+    uint32_t lastSenderReport = 0;    // LSR: middle 32 bits of the NTP time of our last SR
+    uint32_t delaySinceLastSr = 0;    // DLSR: in units of 1/65536 seconds
+};
+
+/**
+ * @brief One packet reported lost by a generic NACK
+ */
+struct RtcpNack {
+    uint32_t mediaSsrc = 0;       // Source the lost packet belongs to
+    uint16_t sequenceNumber = 0;  // RTP sequence number of the lost packet
+};
+
+/**
+ * @brief Feedback extracted from one compound RTCP packet
+ */
+struct RtcpFeedback {
+    std::vector<RtcpReportBlock> reportBlocks;
+    bool hasRemb = false;
+    uint64_t rembBitrateBps = 0;       // Receiver estimated maximum bitrate
+    std::vector<uint32_t> rembSsrcs;   // Media SSRCs the REMB applies to
+    std::vector<uint32_t> keyframeRequestSsrcs;  // Media SSRCs asked for a keyframe (PLI/FIR)
+    std::vector<RtcpNack> nacks;                 // Packets asked for retransmission
+};
+
+/**
+ * @brief Parse a (compound) RTCP packet
+ *
+ * Unknown packet types are skipped. Parsing stops at the first malformed
+ * packet, keeping whatever was extracted before it.
+ *
+ * @param data RTCP packet bytes
+ * @param size Size in bytes
+ * @param feedback Receives the extracted feedback (appended to)
+ * @return true if at least one RTCP packet was parsed
+ */
+bool parseRtcpFeedback(const uint8_t* data, size_t size, RtcpFeedback& feedback);
+
+/**
+ * @brief Get the current time as a compact (middle 32 bits) NTP timestamp
+ *
+ * Uses the system clock, which is the clock RTCP sender reports are stamped with.
+ */
+uint32_t compactNtpNow();
+
+/**
+ * @brief Compute round-trip time from a report block (RFC 3550 section 6.4.1)
+ * @param block Report block about one of our send streams
+ * @param compactNtpArrival Compact NTP time the report arrived
+ * @return RTT in milliseconds, or -1 if the block carries no SR reference
+ */
+int64_t calculateRttMs(const RtcpReportBlock& block, uint32_t compactNtpArrival);
+
+}  // namespace core
+}  // namespace obswebrtc
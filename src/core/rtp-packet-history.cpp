@@ -0,0 +1,135 @@
+/**
+ * @file rtp-packet-history.cpp
+ * @brief Implementation of the RTP retransmission history
+ */
+
+#include "rtp-packet-history.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+size_t historyCapacity(const RtpPacketHistoryConfig& config) {
+    // kbps * ms / 8 = bytes in the window at the maximum rate
+    const uint64_t windowBytes =
+        static_cast<uint64_t>(config.maxBitrateKbps) * config.windowMs / constants::kBitsPerByte;
+    const uint64_t packets = windowBytes / constants::kDefaultRtpMaxPayloadSize + 1;
+
+    size_t capacity = constants::kMinRtxHistoryPackets;
+    while (capacity < packets && capacity < constants::kMaxRtxHistoryPackets) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/**
+ * @brief Size of the RTP header including CSRCs and the extension
+ * @return 0 if the packet is too short for the header it declares
+ */
+size_t rtpHeaderSize(const uint8_t* packet, size_t size) {
+    if (size < constants::kRtpHeaderSize || (packet[0] >> 6) != 2) {
+        return 0;
+    }
+
+    size_t headerSize = constants::kRtpHeaderSize + (packet[0] & 0x0F) * 4;
+    if (packet[0] & 0x10) {
+        if (size < headerSize + 4) {
+            return 0;
+        }
+        const size_t extensionWords =
+            (static_cast<size_t>(packet[headerSize + 2]) << 8) | packet[headerSize + 3];
+        headerSize += 4 + extensionWords * 4;
+    }
+    return headerSize <= size ? headerSize : 0;
+}
+
+}  // namespace
+
+RtpPacketHistory::RtpPacketHistory(const RtpPacketHistoryConfig& config) : config_(config) {
+    if (config_.windowMs <= 0) {
+        throw std::invalid_argument("Retransmission history window must be positive");
+    }
+    if (config_.maxBitrateKbps <= 0) {
+        throw std::invalid_argument("Retransmission history bitrate must be positive");
+    }
+    if (config_.maxPacketSize < constants::kRtpHeaderSize) {
+        throw std::invalid_argument("Retransmission history packet size is too small");
+    }
+
+    const size_t capacity = historyCapacity(config_);
+    slots_.resize(capacity);
+    storage_.resize(capacity * config_.maxPacketSize);
+    mask_ = capacity - 1;
+}
+
+void RtpPacketHistory::store(const uint8_t* packet, size_t size, int64_t nowMs) {
+    if (!packet || size < constants::kRtpHeaderSize || size > config_.maxPacketSize) {
+        return;
+    }
+
+    const uint16_t sequenceNumber = static_cast<uint16_t>((packet[2] << 8) | packet[3]);
+    const size_t index = sequenceNumber & mask_;
+    Slot& slot = slots_[index];
+    std::memcpy(storage_.data() + index * config_.maxPacketSize, packet, size);
+    slot.sentMs = nowMs;
+    slot.size = static_cast<uint32_t>(size);
+    slot.sequenceNumber = sequenceNumber;
+}
+
+const uint8_t* RtpPacketHistory::find(uint16_t sequenceNumber, int64_t nowMs, size_t& size) const {
+    const size_t index = sequenceNumber & mask_;
+    const Slot& slot = slots_[index];
+    if (slot.size == 0 || slot.sequenceNumber != sequenceNumber ||
+        nowMs - slot.sentMs > config_.windowMs) {
+        return nullptr;
+    }
+
+    size = slot.size;
+    return storage_.data() + index * config_.maxPacketSize;
+}
+
+void RtpPacketHistory::clear() {
+    std::fill(slots_.begin(), slots_.end(), Slot());
+}
+
+size_t writeRtxPacket(const uint8_t* packet, size_t size, uint8_t rtxPayloadType,
+                      uint16_t rtxSequenceNumber, uint32_t rtxSsrc, uint8_t* out) {
+    const size_t headerSize = packet ? rtpHeaderSize(packet, size) : 0;
+    if (headerSize == 0) {
+        return 0;
+    }
+
+    size_t payloadEnd = size;
+    if (packet[0] & 0x20) {
+        const uint8_t padding = packet[size - 1];
+        if (padding > size - headerSize) {
+            return 0;
+        }
+        payloadEnd -= padding;
+    }
+
+    std::memcpy(out, packet, headerSize);
+    out[0] &= ~0x20;  // Padding is not carried over
+    out[1] = static_cast<uint8_t>((packet[1] & 0x80) | (rtxPayloadType & 0x7F));
+    out[2] = static_cast<uint8_t>(rtxSequenceNumber >> 8);
+    out[3] = static_cast<uint8_t>(rtxSequenceNumber);
+    out[8] = static_cast<uint8_t>(rtxSsrc >> 24);
+    out[9] = static_cast<uint8_t>(rtxSsrc >> 16);
+    out[10] = static_cast<uint8_t>(rtxSsrc >> 8);
+    out[11] = static_cast<uint8_t>(rtxSsrc);
+
+    // Original sequence number, then the original payload
+    out[headerSize] = packet[2];
+    out[headerSize + 1] = packet[3];
+    std::memcpy(out + headerSize + constants::kRtxOverheadSize, packet + headerSize,
+                payloadEnd - headerSize);
+    return payloadEnd + constants::kRtxOverheadSize;
+}
+
+}  // namespace core
+}  // namespace obswebrtc
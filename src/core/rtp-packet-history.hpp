@@ -0,0 +1,114 @@
+/**
+ * @file rtp-packet-history.hpp
+ * @brief Bounded history of sent RTP packets for NACK retransmission
+ *
+ * This module provides:
+ * - A preallocated ring of sent packets indexed by sequence number, sized
+ *   for a time window at a maximum bitrate
+ * - RTX packet construction (RFC 4588) from a stored packet
+ */
+
+#pragma once
+
+#include "constants.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Configuration for RtpPacketHistory
+ */
+struct RtpPacketHistoryConfig {
+    int windowMs = constants::kDefaultRtxHistoryMs;  // Packets older than this are not resent
+    int maxBitrateKbps = 5000;                       // Highest send rate the window must cover
+    size_t maxPacketSize = constants::kMaxRtpPacketSize;
+};
+
+/**
+ * @brief Ring of recently sent RTP packets for one SSRC
+ *
+ * Slots are indexed by sequence number modulo the capacity, so storing and
+ * looking up are O(1) and a newer packet silently replaces the one
+ * capacity sequence numbers before it. The capacity covers windowMs at
+ * maxBitrateKbps in full-size packets, rounded up to a power of two and
+ * clamped to [kMinRtxHistoryPackets, kMaxRtxHistoryPackets]; all packet
+ * storage is allocated up front.
+ *
+ * Not thread-safe: the owner serializes store() and find().
+ */
+class RtpPacketHistory {
+public:
+    /**
+     * @brief Construct a history
+     * @param config History configuration
+     * @throws std::invalid_argument if the window, bitrate or packet size is not positive
+     */
+    explicit RtpPacketHistory(const RtpPacketHistoryConfig& config = RtpPacketHistoryConfig());
+
+    /**
+     * @brief Remember a sent RTP packet
+     *
+     * Packets shorter than an RTP header or larger than maxPacketSize are
+     * ignored.
+     *
+     * @param packet Complete RTP packet (before SRTP)
+     * @param size Packet size in bytes
+     * @param nowMs Send time in milliseconds
+     */
+    void store(const uint8_t* packet, size_t size, int64_t nowMs);
+
+    /**
+     * @brief Look up a packet for retransmission
+     * @param sequenceNumber RTP sequence number asked for
+     * @param nowMs Current time in milliseconds
+     * @param size Receives the packet size on a hit
+     * @return The stored packet, or nullptr if it was never stored, has been
+     *         overwritten or is older than the window. Valid until the next
+     *         store().
+     */
+    const uint8_t* find(uint16_t sequenceNumber, int64_t nowMs, size_t& size) const;
+
+    /**
+     * @brief Forget all packets (e.g. after an SSRC change)
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of packet slots
+     */
+    size_t getCapacity() const { return slots_.size(); }
+
+private:
+    struct Slot {
+        int64_t sentMs = 0;
+        uint32_t size = 0;  // 0 = empty
+        uint16_t sequenceNumber = 0;
+    };
+
+    RtpPacketHistoryConfig config_;
+    std::vector<Slot> slots_;
+    std::vector<uint8_t> storage_;  // capacity * maxPacketSize bytes
+    size_t mask_ = 0;
+};
+
+/**
+ * @brief Build an RTX packet (RFC 4588) from an original RTP packet
+ *
+ * Copies the original header (CSRCs and extensions included) with the RTX
+ * payload type, sequence number and SSRC, then the original sequence
+ * number, then the original payload. Padding is dropped.
+ *
+ * @param packet Original RTP packet
+ * @param size Original packet size
+ * @param out Destination, at least size + constants::kRtxOverheadSize bytes
+ * @return Bytes written, or 0 if the original is not a well-formed RTP packet
+ */
+size_t writeRtxPacket(const uint8_t* packet, size_t size, uint8_t rtxPayloadType,
+                      uint16_t rtxSequenceNumber, uint32_t rtxSsrc, uint8_t* out);
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,419 @@
+/**
+ * @file rtp-packetizer.cpp
+ * @brief Implementation of H.264, VP8, VP9 and AV1 RTP packetization
+ */
+
+#include "rtp-packetizer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+/** Smallest payload that leaves room for a descriptor and some data */
+constexpr size_t kMinPayloadSize = 16;
+
+constexpr uint8_t kH264NalTypeIdr = 5;
+constexpr uint8_t kH264NalTypeFuA = 28;
+constexpr size_t kH264FuAHeaderSize = 2;
+
+constexpr size_t kVp8DescriptorSize = 4;
+constexpr size_t kVp9MaxDescriptorSize = 4;
+
+constexpr uint8_t kAv1ObuSequenceHeader = 1;
+constexpr uint8_t kAv1ObuTemporalDelimiter = 2;
+constexpr uint8_t kAv1ObuTileList = 8;
+constexpr uint8_t kAv1ObuPadding = 15;
+
+/**
+ * @brief Number of fragments needed for a frame
+ *
+ * Fragments are then sized evenly (fragmentSize) to avoid a tiny trailing packet.
+ */
+size_t fragmentCount(size_t size, size_t capacity) {
+    return (size + capacity - 1) / capacity;
+}
+
+size_t fragmentSize(size_t size, size_t count, size_t index) {
+    return size / count + (index < size % count ? 1 : 0);
+}
+
+/**
+ * @brief MSB-first bit reader for codec headers
+ */
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    bool read(int bits, uint32_t& value) {
+        value = 0;
+        for (int i = 0; i < bits; i++) {
+            if (bit_ >= size_ * 8) {
+                return false;
+            }
+            value = (value << 1) | ((data_[bit_ / 8] >> (7 - bit_ % 8)) & 1);
+            bit_++;
+        }
+        return true;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t bit_ = 0;
+};
+
+/**
+ * @brief Check a VP9 uncompressed header for frame_type == KEY_FRAME
+ */
+bool isVp9Keyframe(const uint8_t* frame, size_t size) {
+    BitReader reader(frame, size);
+    uint32_t frameMarker, profileLow, profileHigh, value;
+    if (!reader.read(2, frameMarker) || frameMarker != 2 || !reader.read(1, profileLow) ||
+        !reader.read(1, profileHigh)) {
+        return false;
+    }
+    if (profileHigh == 1 && profileLow == 1 && !reader.read(1, value)) {  // reserved_zero
+        return false;
+    }
+    if (!reader.read(1, value) || value == 1) {  // show_existing_frame
+        return false;
+    }
+    return reader.read(1, value) && value == 0;  // frame_type: 0 = KEY_FRAME
+}
+
+size_t leb128Size(size_t value) {
+    size_t bytes = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
+
+void writeLeb128(std::vector<uint8_t>& out, size_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool readLeb128(const uint8_t* data, size_t size, size_t& offset, uint64_t& value) {
+    value = 0;
+    for (int i = 0; i < 8; i++) {
+        if (offset >= size) {
+            return false;
+        }
+        const uint8_t byte = data[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief An OBU as sent in RTP: rewritten header bytes plus the payload span
+ */
+struct Av1ObuElement {
+    uint8_t header[2];
+    size_t headerSize;
+    const uint8_t* payload;
+    size_t payloadSize;
+
+    size_t size() const { return headerSize + payloadSize; }
+
+    void append(std::vector<uint8_t>& out, size_t offset, size_t count) const {
+        while (count > 0 && offset < headerSize) {
+            out.push_back(header[offset++]);
+            count--;
+        }
+        const uint8_t* begin = payload + (offset - headerSize);
+        out.insert(out.end(), begin, begin + count);
+    }
+};
+
+}  // namespace
+
+void writeRtpHeader(uint8_t* header, uint8_t payloadType, bool marker, uint16_t sequenceNumber,
+                    uint32_t timestamp, uint32_t ssrc) {
+    header[0] = 0x80;  // Version 2, no padding, extension or CSRCs
+    header[1] = static_cast<uint8_t>((marker ? 0x80 : 0x00) | (payloadType & 0x7F));
+    header[2] = static_cast<uint8_t>(sequenceNumber >> 8);
+    header[3] = static_cast<uint8_t>(sequenceNumber);
+    header[4] = static_cast<uint8_t>(timestamp >> 24);
+    header[5] = static_cast<uint8_t>(timestamp >> 16);
+    header[6] = static_cast<uint8_t>(timestamp >> 8);
+    header[7] = static_cast<uint8_t>(timestamp);
+    header[8] = static_cast<uint8_t>(ssrc >> 24);
+    header[9] = static_cast<uint8_t>(ssrc >> 16);
+    header[10] = static_cast<uint8_t>(ssrc >> 8);
+    header[11] = static_cast<uint8_t>(ssrc);
+}
+
+// VideoRtpPacketizer implementation
+
+VideoRtpPacketizer::VideoRtpPacketizer(size_t maxPayloadSize) : maxPayloadSize_(maxPayloadSize) {
+    if (maxPayloadSize_ < kMinPayloadSize) {
+        throw std::invalid_argument("Maximum RTP payload size is too small");
+    }
+}
+
+// H264RtpPacketizer implementation
+
+H264RtpPacketizer::H264RtpPacketizer(size_t maxPayloadSize) : VideoRtpPacketizer(maxPayloadSize) {}
+
+bool H264RtpPacketizer::packetize(const uint8_t* frame, size_t size, PacketizedFrame& out) {
+    out.clear();
+    if (!frame || size == 0) {
+        return false;
+    }
+
+    splitAnnexB(frame, size, nalUnits_);
+    if (nalUnits_.empty()) {
+        return false;
+    }
+
+    // SPS/PPS for late joiners, aggregated into one packet ahead of the IDR.
+    // Only this small payload is added; the frame is packetized as usual
+    const bool idrNeedsParameterSets = parameterSets_.update(nalUnits_);
+    const std::vector<uint8_t>& stapA = parameterSets_.stapA();
+    const bool injectParameterSets = idrNeedsParameterSets && stapA.size() <= maxPayloadSize_;
+    out.buffer.reserve((injectParameterSets ? stapA.size() : 0) + size +
+                       (size / (maxPayloadSize_ - kH264FuAHeaderSize) + 1) * kH264FuAHeaderSize);
+    if (injectParameterSets) {
+        out.payloads.push_back({0, stapA.size(), false});
+        out.buffer.insert(out.buffer.end(), stapA.begin(), stapA.end());
+    }
+
+    for (const auto& nal : nalUnits_) {
+        out.keyframe |= nal.h264Type() == kH264NalTypeIdr;
+
+        if (nal.size <= maxPayloadSize_) {
+            // Single NAL unit packet
+            out.payloads.push_back({out.buffer.size(), nal.size, false});
+            out.buffer.insert(out.buffer.end(), nal.data, nal.data + nal.size);
+            continue;
+        }
+
+        // FU-A: the NAL header is replaced by the FU indicator and FU header
+        const uint8_t nalHeader = nal.data[0];
+        const uint8_t* body = nal.data + 1;
+        const size_t bodySize = nal.size - 1;
+        const size_t count = fragmentCount(bodySize, maxPayloadSize_ - kH264FuAHeaderSize);
+
+        size_t offset = 0;
+        for (size_t i = 0; i < count; i++) {
+            const size_t chunk = fragmentSize(bodySize, count, i);
+            const size_t start = out.buffer.size();
+
+            uint8_t fuHeader = nalHeader & 0x1F;
+            fuHeader |= i == 0 ? 0x80 : 0x00;          // S
+            fuHeader |= i == count - 1 ? 0x40 : 0x00;  // E
+            out.buffer.push_back(static_cast<uint8_t>((nalHeader & 0xE0) | kH264NalTypeFuA));
+            out.buffer.push_back(fuHeader);
+            out.buffer.insert(out.buffer.end(), body + offset, body + offset + chunk);
+
+            out.payloads.push_back({start, kH264FuAHeaderSize + chunk, false});
+            offset += chunk;
+        }
+    }
+
+    out.payloads.back().marker = true;
+    return true;
+}
+
+bool H264RtpPacketizer::setParameterSets(const uint8_t* extradata, size_t size) {
+    return parameterSets_.setExtradata(extradata, size);
+}
+
+// Vp8RtpPacketizer implementation
+
+Vp8RtpPacketizer::Vp8RtpPacketizer(size_t maxPayloadSize) : VideoRtpPacketizer(maxPayloadSize) {}
+
+bool Vp8RtpPacketizer::packetize(const uint8_t* frame, size_t size, PacketizedFrame& out) {
+    out.clear();
+    if (!frame || size == 0) {
+        return false;
+    }
+
+    // Frame tag: inverse key frame flag in bit 0
+    out.keyframe = (frame[0] & 0x01) == 0;
+
+    const size_t count = fragmentCount(size, maxPayloadSize_ - kVp8DescriptorSize);
+    out.buffer.reserve(size + count * kVp8DescriptorSize);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        const size_t chunk = fragmentSize(size, count, i);
+        const size_t start = out.buffer.size();
+
+        // X=1 | S (start of partition 0) ; I=1 ; M=1 + 15-bit PictureID
+        out.buffer.push_back(static_cast<uint8_t>(0x80 | (i == 0 ? 0x10 : 0x00)));
+        out.buffer.push_back(0x80);
+        out.buffer.push_back(static_cast<uint8_t>(0x80 | (pictureId_ >> 8)));
+        out.buffer.push_back(static_cast<uint8_t>(pictureId_ & 0xFF));
+        out.buffer.insert(out.buffer.end(), frame + offset, frame + offset + chunk);
+
+        out.payloads.push_back({start, kVp8DescriptorSize + chunk, i == count - 1});
+        offset += chunk;
+    }
+
+    pictureId_ = (pictureId_ + 1) & 0x7FFF;
+    return true;
+}
+
+// Vp9RtpPacketizer implementation
+
+Vp9RtpPacketizer::Vp9RtpPacketizer(size_t maxPayloadSize) : VideoRtpPacketizer(maxPayloadSize) {}
+
+bool Vp9RtpPacketizer::packetize(const uint8_t* frame, size_t size, PacketizedFrame& out) {
+    out.clear();
+    if (!frame || size == 0) {
+        return false;
+    }
+
+    out.keyframe = isVp9Keyframe(frame, size);
+    const bool interPredicted = !out.keyframe;
+    const size_t descriptorSize = interPredicted ? kVp9MaxDescriptorSize : kVp9MaxDescriptorSize - 1;
+
+    const size_t count = fragmentCount(size, maxPayloadSize_ - descriptorSize);
+    out.buffer.reserve(size + count * descriptorSize);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        const size_t chunk = fragmentSize(size, count, i);
+        const size_t start = out.buffer.size();
+
+        // I=1 | P | F=1 (flexible mode) | B (begin) | E (end)
+        uint8_t flags = 0x80 | 0x10;
+        flags |= interPredicted ? 0x40 : 0x00;
+        flags |= i == 0 ? 0x08 : 0x00;
+        flags |= i == count - 1 ? 0x04 : 0x00;
+        out.buffer.push_back(flags);
+        out.buffer.push_back(static_cast<uint8_t>(0x80 | (pictureId_ >> 8)));
+        out.buffer.push_back(static_cast<uint8_t>(pictureId_ & 0xFF));
+        if (interPredicted) {
+            out.buffer.push_back(1 << 1);  // P_DIFF = 1 (previous picture), N = 0
+        }
+        out.buffer.insert(out.buffer.end(), frame + offset, frame + offset + chunk);
+
+        out.payloads.push_back({start, descriptorSize + chunk, i == count - 1});
+        offset += chunk;
+    }
+
+    pictureId_ = (pictureId_ + 1) & 0x7FFF;
+    return true;
+}
+
+// Av1RtpPacketizer implementation
+
+Av1RtpPacketizer::Av1RtpPacketizer(size_t maxPayloadSize) : VideoRtpPacketizer(maxPayloadSize) {}
+
+bool Av1RtpPacketizer::packetize(const uint8_t* frame, size_t size, PacketizedFrame& out) {
+    out.clear();
+    if (!frame || size == 0) {
+        return false;
+    }
+
+    // Parse the temporal unit into the OBU elements to send
+    std::vector<Av1ObuElement> elements;
+    size_t offset = 0;
+    while (offset < size) {
+        const uint8_t obuHeader = frame[offset];
+        const uint8_t obuType = (obuHeader >> 3) & 0x0F;
+        const bool hasExtension = (obuHeader & 0x04) != 0;
+        const bool hasSizeField = (obuHeader & 0x02) != 0;
+
+        Av1ObuElement element;
+        element.header[0] = obuHeader & ~0x02;  // Size fields are stripped (section 4.3)
+        element.headerSize = 1;
+        offset++;
+        if (hasExtension) {
+            if (offset >= size) {
+                return false;
+            }
+            element.header[1] = frame[offset++];
+            element.headerSize = 2;
+        }
+
+        uint64_t payloadSize = size - offset;
+        if (hasSizeField && (!readLeb128(frame, size, offset, payloadSize) ||
+                             payloadSize > size - offset)) {
+            return false;
+        }
+        element.payload = frame + offset;
+        element.payloadSize = static_cast<size_t>(payloadSize);
+        offset += element.payloadSize;
+
+        if (obuType == kAv1ObuSequenceHeader) {
+            out.keyframe = true;
+        }
+        if (obuType != kAv1ObuTemporalDelimiter && obuType != kAv1ObuTileList &&
+            obuType != kAv1ObuPadding) {
+            elements.push_back(element);
+        }
+    }
+
+    if (elements.empty()) {
+        return false;
+    }
+    out.buffer.reserve(size + (size / (maxPayloadSize_ - 2) + 1) * 4);
+
+    // Aggregate with W = 0: every OBU element carries a LEB128 length
+    size_t packetStart = 0;
+    size_t remaining = 0;
+    auto beginPacket = [&](bool continuation) {
+        packetStart = out.buffer.size();
+        uint8_t aggregationHeader = continuation ? 0x80 : 0x00;  // Z
+        if (out.payloads.empty() && out.keyframe) {
+            aggregationHeader |= 0x08;  // N: first packet of a coded video sequence
+        }
+        out.buffer.push_back(aggregationHeader);
+        remaining = maxPayloadSize_ - 1;
+    };
+    auto endPacket = [&](bool continues) {
+        if (continues) {
+            out.buffer[packetStart] |= 0x40;  // Y
+        }
+        out.payloads.push_back({packetStart, out.buffer.size() - packetStart, false});
+    };
+
+    beginPacket(false);
+    for (const auto& element : elements) {
+        const size_t total = element.size();
+        size_t done = 0;
+        while (done < total) {
+            if (remaining < 2) {
+                // No room for a length byte plus data
+                endPacket(done > 0);
+                beginPacket(done > 0);
+            }
+
+            size_t chunk = std::min(total - done, remaining - 1);
+            while (leb128Size(chunk) + chunk > remaining) {
+                chunk--;
+            }
+            writeLeb128(out.buffer, chunk);
+            element.append(out.buffer, done, chunk);
+            done += chunk;
+            remaining -= leb128Size(chunk) + chunk;
+
+            if (done < total) {
+                endPacket(true);
+                beginPacket(true);
+            }
+        }
+    }
+    endPacket(false);
+    out.payloads.back().marker = true;
+    return true;
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,183 @@
+/**
+ * @file rtp-packetizer.hpp
+ * @brief RTP payload formats for H.264, VP8, VP9 and AV1
+ *
+ * This module provides:
+ * - H.264 single NAL unit and FU-A packetization (RFC 6184), with SPS/PPS
+ *   repeated as a STAP-A ahead of IDRs that lack them
+ * - VP8 payload descriptor packetization (RFC 7741)
+ * - VP9 flexible-mode packetization (RFC 9628)
+ * - AV1 OBU aggregation and fragmentation (AV1 RTP payload specification)
+ *
+ * The packetizers only produce RTP payloads; the RTP header is written by
+ * the caller (PeerConnection, see writeRtpHeader()) so sequence numbers and
+ * timestamps stay in one place, and one packetized frame can be sent on
+ * several RTP streams.
+ */
+
+#pragma once
+
+#include "constants.hpp"
+#include "h264-parameter-sets.hpp"
+#include "nal-parser.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief One RTP payload inside a PacketizedFrame buffer
+ */
+struct RtpPayload {
+    size_t offset = 0;    // Start in PacketizedFrame::buffer
+    size_t size = 0;      // Payload size in bytes (descriptor included)
+    bool marker = false;  // RTP marker bit: last packet of the frame
+};
+
+/**
+ * @brief RTP payloads for one video frame
+ *
+ * All payloads share one buffer so a frame costs a single allocation once
+ * the buffer has grown to the largest frame size. Reuse across frames.
+ */
+struct PacketizedFrame {
+    std::vector<uint8_t> buffer;
+    std::vector<RtpPayload> payloads;
+    bool keyframe = false;  // Detected from the bitstream
+
+    void clear() {
+        buffer.clear();
+        payloads.clear();
+        keyframe = false;
+    }
+
+    const uint8_t* data(const RtpPayload& payload) const { return buffer.data() + payload.offset; }
+};
+
+/**
+ * @brief Write a fixed 12-byte RTP header (version 2, no CSRCs or extensions)
+ * @param header Destination, at least constants::kRtpHeaderSize bytes
+ */
+void writeRtpHeader(uint8_t* header, uint8_t payloadType, bool marker, uint16_t sequenceNumber,
+                    uint32_t timestamp, uint32_t ssrc);
+
+/**
+ * @brief Base class for codec-specific video RTP packetizers
+ *
+ * Not thread-safe: use one instance per track, from one thread at a time.
+ */
+class VideoRtpPacketizer {
+public:
+    /**
+     * @brief Construct a packetizer
+     * @param maxPayloadSize Largest RTP payload to produce, in bytes
+     * @throws std::invalid_argument if maxPayloadSize is too small to carry data
+     */
+    explicit VideoRtpPacketizer(size_t maxPayloadSize);
+
+    virtual ~VideoRtpPacketizer() = default;
+
+    /**
+     * @brief Split one encoded frame into RTP payloads
+     * @param frame Encoded frame (VP8/VP9 frame or AV1 temporal unit)
+     * @param size Frame size in bytes
+     * @param out Receives the payloads (cleared first)
+     * @return false if the frame is empty or malformed and nothing should be sent
+     */
+    virtual bool packetize(const uint8_t* frame, size_t size, PacketizedFrame& out) = 0;
+
+    /**
+     * @brief Get the largest payload size this packetizer produces
+     */
+    size_t getMaxPayloadSize() const { return maxPayloadSize_; }
+
+protected:
+    size_t maxPayloadSize_;
+};
+
+/**
+ * @brief H.264 packetizer (RFC 6184, packetization-mode=1)
+ *
+ * Takes an Annex-B access unit. NAL units that fit are sent as single NAL
+ * unit packets, larger ones as evenly sized FU-A fragments. Produces the
+ * same packets as libdatachannel's H264RtpPacketizer, but into a reusable
+ * PacketizedFrame.
+ *
+ * An IDR that arrives without SPS/PPS is preceded by a STAP-A carrying the
+ * last ones seen, in-band or from setParameterSets(), so receivers joining
+ * mid-stream can start decoding at any keyframe.
+ */
+class H264RtpPacketizer final : public VideoRtpPacketizer {
+public:
+    explicit H264RtpPacketizer(size_t maxPayloadSize = constants::kDefaultRtpMaxPayloadSize);
+
+    bool packetize(const uint8_t* frame, size_t size, PacketizedFrame& out) override;
+
+    /**
+     * @brief Seed the parameter sets repeated ahead of IDRs
+     * @param extradata Encoder extradata (Annex-B or avcC)
+     * @param size Size in bytes
+     * @return true if both an SPS and a PPS were found
+     */
+    bool setParameterSets(const uint8_t* extradata, size_t size);
+
+private:
+    std::vector<NalUnitView> nalUnits_;  // Reused per frame
+    H264ParameterSetCache parameterSets_;
+};
+
+/**
+ * @brief VP8 packetizer (RFC 7741)
+ *
+ * Every payload carries a 4-byte descriptor with a 15-bit PictureID. The
+ * frame is split into equally sized fragments regardless of partition
+ * boundaries, which RFC 7741 allows.
+ */
+class Vp8RtpPacketizer final : public VideoRtpPacketizer {
+public:
+    explicit Vp8RtpPacketizer(size_t maxPayloadSize = constants::kDefaultRtpMaxPayloadSize);
+
+    bool packetize(const uint8_t* frame, size_t size, PacketizedFrame& out) override;
+
+private:
+    uint16_t pictureId_ = 0;
+};
+
+/**
+ * @brief VP9 packetizer in flexible mode (RFC 9628)
+ *
+ * Single spatial/temporal layer. Inter frames reference the previous
+ * picture (P_DIFF = 1), which matches real-time libvpx output without
+ * alt-ref frames.
+ */
+class Vp9RtpPacketizer final : public VideoRtpPacketizer {
+public:
+    explicit Vp9RtpPacketizer(size_t maxPayloadSize = constants::kDefaultRtpMaxPayloadSize);
+
+    bool packetize(const uint8_t* frame, size_t size, PacketizedFrame& out) override;
+
+private:
+    uint16_t pictureId_ = 0;
+};
+
+/**
+ * @brief AV1 packetizer (AV1 RTP payload specification, section 4)
+ *
+ * Takes a temporal unit in low-overhead bitstream format (OBUs with size
+ * fields, as produced by OBS's AV1 encoders). Temporal delimiter, tile list
+ * and padding OBUs are dropped, obu_size fields are stripped, and the
+ * remaining OBUs are aggregated into as few packets as fit, fragmenting
+ * across packets where needed.
+ */
+class Av1RtpPacketizer final : public VideoRtpPacketizer {
+public:
+    explicit Av1RtpPacketizer(size_t maxPayloadSize = constants::kDefaultRtpMaxPayloadSize);
+
+    bool packetize(const uint8_t* frame, size_t size, PacketizedFrame& out) override;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,285 @@
+/**
+ * @file sdp-parser.cpp
+ * @brief Implementation of the SDP media section parser
+ */
+
+#include "sdp-parser.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+/** Largest integer accepted in a numeric field; guards the conversion below */
+constexpr uint32_t kMaxSdpNumber = 10000000;
+
+std::string trim(const std::string& text, size_t begin, size_t end) {
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) {
+        begin++;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+        end--;
+    }
+    return text.substr(begin, end - begin);
+}
+
+std::string lowercase(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+/**
+ * @brief Parse a whole field of decimal digits
+ */
+bool parseNumber(const std::string& text, uint32_t& value) {
+    if (text.empty()) {
+        return false;
+    }
+    uint32_t result = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        result = result * 10 + static_cast<uint32_t>(c - '0');
+        if (result > kMaxSdpNumber) {
+            return false;
+        }
+    }
+    value = result;
+    return true;
+}
+
+/**
+ * @brief Split "a=<name>:<pt> <rest>" values into the payload type and the rest
+ */
+bool splitPayloadType(const std::string& value, int& payloadType, std::string& rest) {
+    const size_t space = value.find(' ');
+    uint32_t number = 0;
+    if (space == std::string::npos || !parseNumber(value.substr(0, space), number) ||
+        number > 127) {
+        return false;
+    }
+    payloadType = static_cast<int>(number);
+    rest = trim(value, space + 1, value.size());
+    return true;
+}
+
+SdpCodec* codecFor(SdpMediaSection& section, int payloadType) {
+    for (SdpCodec& codec : section.codecs) {
+        if (codec.payloadType == payloadType) {
+            return &codec;
+        }
+    }
+    return nullptr;
+}
+
+void parseMediaLine(const std::string& value, SdpMediaSection& section) {
+    // <media> <port> <proto> <fmt> ...
+    std::vector<std::string> fields;
+    size_t position = 0;
+    while (position < value.size()) {
+        const size_t end = std::min(value.find(' ', position), value.size());
+        if (end > position) {
+            fields.push_back(value.substr(position, end - position));
+        }
+        position = end + 1;
+    }
+    if (fields.empty()) {
+        return;
+    }
+
+    section.type = fields[0];
+    for (size_t i = 3; i < fields.size(); i++) {
+        uint32_t payloadType = 0;
+        // Non-RTP sections list other formats (e.g. "webrtc-datachannel")
+        if (parseNumber(fields[i], payloadType) && payloadType <= 127 &&
+            !codecFor(section, static_cast<int>(payloadType))) {
+            SdpCodec codec;
+            codec.payloadType = static_cast<int>(payloadType);
+            section.codecs.push_back(codec);
+        }
+    }
+}
+
+void parseRtpmap(const std::string& value, SdpMediaSection& section) {
+    // <pt> <name>/<clock rate>[/<channels>]
+    int payloadType = -1;
+    std::string encoding;
+    if (!splitPayloadType(value, payloadType, encoding)) {
+        return;
+    }
+    SdpCodec* codec = codecFor(section, payloadType);
+    const size_t slash = encoding.find('/');
+    if (!codec || slash == std::string::npos || slash == 0) {
+        return;
+    }
+
+    const size_t secondSlash = encoding.find('/', slash + 1);
+    const size_t rateEnd = secondSlash == std::string::npos ? encoding.size() : secondSlash;
+    uint32_t clockRate = 0;
+    uint32_t channels = 1;
+    // A zero clock rate would later divide RTP time by zero
+    if (!parseNumber(encoding.substr(slash + 1, rateEnd - slash - 1), clockRate) ||
+        clockRate == 0) {
+        return;
+    }
+    if (secondSlash != std::string::npos &&
+        (!parseNumber(encoding.substr(secondSlash + 1), channels) || channels == 0)) {
+        return;
+    }
+    codec->name = encoding.substr(0, slash);
+    codec->clockRate = clockRate;
+    codec->channels = channels;
+}
+
+void parseFmtp(const std::string& value, SdpMediaSection& section) {
+    // <pt> key=value;key=value;...
+    int payloadType = -1;
+    std::string parameters;
+    if (!splitPayloadType(value, payloadType, parameters)) {
+        return;
+    }
+    SdpCodec* codec = codecFor(section, payloadType);
+    if (!codec) {
+        return;
+    }
+
+    size_t position = 0;
+    while (position <= parameters.size()) {
+        const size_t end = std::min(parameters.find(';', position), parameters.size());
+        const size_t equals = parameters.find('=', position);
+        if (equals != std::string::npos && equals < end) {
+            std::string key = lowercase(trim(parameters, position, equals));
+            if (!key.empty()) {
+                codec->parameters.emplace_back(std::move(key),
+                                               trim(parameters, equals + 1, end));
+            }
+        }
+        position = end + 1;
+    }
+}
+
+int parseDuration(const std::string& value) {
+    // Whole milliseconds; fractional ptime values ("20.0") round down
+    const std::string whole = value.substr(0, value.find('.'));
+    uint32_t ms = 0;
+    return parseNumber(whole, ms) ? static_cast<int>(ms) : 0;
+}
+
+/**
+ * @brief Whether an Opus fmtp flag is set, if it is present at all
+ */
+bool flagParameter(const SdpCodec& codec, const std::string& key, bool& present) {
+    const std::string* value = codec.parameter(key);
+    present = value != nullptr;
+    return present && *value == "1";
+}
+
+}  // namespace
+
+bool SdpCodec::is(const std::string& codecName) const {
+    return name.size() == codecName.size() && lowercase(name) == lowercase(codecName);
+}
+
+const std::string* SdpCodec::parameter(const std::string& key) const {
+    for (const auto& entry : parameters) {
+        if (entry.first == key) {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+const SdpCodec* SdpMediaSection::findCodec(const std::string& codecName) const {
+    for (const SdpCodec& codec : codecs) {
+        if (codec.is(codecName)) {
+            return &codec;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<SdpMediaSection> parseSdpMediaSections(const std::string& sdp) {
+    std::vector<SdpMediaSection> sections;
+    size_t position = 0;
+    while (position < sdp.size()) {
+        const size_t end = std::min(sdp.find('\n', position), sdp.size());
+        const std::string line = trim(sdp, position, end);
+        position = end + 1;
+
+        if (line.size() < 2 || line[1] != '=') {
+            continue;
+        }
+        if (line[0] == 'm') {
+            sections.emplace_back();
+            parseMediaLine(line.substr(2), sections.back());
+            continue;
+        }
+        if (line[0] != 'a' || sections.empty()) {
+            continue;  // Session-level lines
+        }
+
+        // a=<attribute>[:<value>]
+        SdpMediaSection& section = sections.back();
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        const std::string attribute = line.substr(2, colon - 2);
+        const std::string value = trim(line, colon + 1, line.size());
+        if (attribute == "rtpmap") {
+            parseRtpmap(value, section);
+        } else if (attribute == "fmtp") {
+            parseFmtp(value, section);
+        } else if (attribute == "mid") {
+            section.mid = value;
+        } else if (attribute == "ptime") {
+            section.ptimeMs = parseDuration(value);
+        } else if (attribute == "maxptime") {
+            section.maxPtimeMs = parseDuration(value);
+        }
+    }
+    return sections;
+}
+
+AudioCodecDescriptor describeAudioCodec(const SdpMediaSection& section) {
+    AudioCodecDescriptor descriptor;
+    const SdpCodec* opus = section.findCodec("opus");
+    if (!opus) {
+        return descriptor;
+    }
+
+    descriptor.negotiated = true;
+    descriptor.payloadType = opus->payloadType;
+    descriptor.clockRate = opus->clockRate;
+
+    bool spropPresent = false;
+    bool stereoPresent = false;
+    const bool spropStereo = flagParameter(*opus, "sprop-stereo", spropPresent);
+    const bool stereo = flagParameter(*opus, "stereo", stereoPresent);
+    descriptor.channels = (spropPresent ? spropStereo : stereo) ? 2 : 1;
+
+    bool fecPresent = false;
+    descriptor.inbandFec = flagParameter(*opus, "useinbandfec", fecPresent);
+
+    uint32_t captureRate = 0;
+    const std::string* captureValue = opus->parameter("sprop-maxcapturerate");
+    if (captureValue && parseNumber(*captureValue, captureRate) && captureRate > 0) {
+        descriptor.maxCaptureRate = std::min(captureRate, descriptor.clockRate);
+    }
+
+    // a=ptime, or the ptime fmtp parameter some senders use instead
+    descriptor.ptimeMs = section.ptimeMs;
+    const std::string* ptimeValue = opus->parameter("ptime");
+    if (descriptor.ptimeMs == 0 && ptimeValue) {
+        descriptor.ptimeMs = parseDuration(*ptimeValue);
+    }
+    return descriptor;
+}
+
+}  // namespace core
+}  // namespace obswebrtc
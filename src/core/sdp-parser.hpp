@@ -0,0 +1,109 @@
+/**
+ * @file sdp-parser.hpp
+ * @brief Codec parameters of negotiated SDP media sections
+ *
+ * This module provides:
+ * - A lenient parser for the m=, a=mid, a=rtpmap, a=fmtp, a=ptime and
+ *   a=maxptime lines of an SDP, one entry per media section
+ * - An audio codec descriptor derived from a media section (Opus stereo,
+ *   sprop-stereo, sprop-maxcapturerate, useinbandfec, ptime), meant to be
+ *   computed once at negotiation and cached with the track
+ */
+
+#pragma once
+
+#include "constants.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief One payload type of a media section
+ */
+struct SdpCodec {
+    int payloadType = -1;
+    std::string name;        // Encoding name as in a=rtpmap (e.g. "opus"); empty without one
+    uint32_t clockRate = 0;  // RTP clock rate; 0 without a=rtpmap
+    uint32_t channels = 1;   // a=rtpmap encoding parameters; 1 when absent
+    // a=fmtp parameters in order, keys lowercased
+    std::vector<std::pair<std::string, std::string>> parameters;
+
+    /**
+     * @brief Check whether the codec is @p codecName (case-insensitive)
+     */
+    bool is(const std::string& codecName) const;
+
+    /**
+     * @brief Look up an fmtp parameter
+     * @param key Parameter name, lowercase
+     * @return The value, or nullptr if the parameter is absent
+     */
+    const std::string* parameter(const std::string& key) const;
+};
+
+/**
+ * @brief The codec lines of one m= section
+ */
+struct SdpMediaSection {
+    std::string type;  // "audio", "video", "application", ...
+    std::string mid;
+    // Payload types in m= line order, the preferred one first
+    std::vector<SdpCodec> codecs;
+    int ptimeMs = 0;     // a=ptime; 0 when absent
+    int maxPtimeMs = 0;  // a=maxptime; 0 when absent
+
+    /**
+     * @brief Find the most preferred payload type of a codec
+     * @return The codec, or nullptr if the section does not offer it
+     */
+    const SdpCodec* findCodec(const std::string& codecName) const;
+};
+
+/**
+ * @brief Parse the media sections of an SDP
+ *
+ * Session-level lines are skipped, as are malformed or unknown lines: the
+ * SDP comes from the remote peer, so nothing in it is trusted to be well
+ * formed and nothing throws. Lines may end in CRLF or LF.
+ *
+ * @param sdp Session description, or a single media section
+ * @return The media sections in order
+ */
+std::vector<SdpMediaSection> parseSdpMediaSections(const std::string& sdp);
+
+/**
+ * @brief What a received audio track was negotiated with
+ *
+ * Computed once per track, so the per-frame path reads plain fields.
+ */
+struct AudioCodecDescriptor {
+    bool negotiated = false;  // False when the section offered no Opus; the rest are defaults
+    int payloadType = -1;
+    uint32_t clockRate = constants::kOpusRtpClockRate;
+    uint32_t channels = constants::kDefaultAudioChannels;  // Channels the sender sends
+    // Highest input rate the sender encodes (sprop-maxcapturerate)
+    uint32_t maxCaptureRate = constants::kOpusRtpClockRate;
+    bool inbandFec = false;  // useinbandfec=1: the sender may carry LBRR data
+    int ptimeMs = 0;         // Packet duration the sender was asked for; 0 when not signalled
+};
+
+/**
+ * @brief Describe the audio codec a media section negotiated
+ *
+ * Takes the most preferred Opus payload type. Opus always has the rtpmap
+ * "opus/48000/2" (RFC 7587), so the channel count comes from fmtp instead:
+ * sprop-stereo, which describes what the remote peer sends, and otherwise
+ * stereo. Both default to mono.
+ *
+ * @param section Media section, normally of a remote description
+ * @return The descriptor; negotiated is false if the section has no Opus
+ */
+AudioCodecDescriptor describeAudioCodec(const SdpMediaSection& section);
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,111 @@
+/**
+ * @file simd.cpp
+ * @brief Implementation of CPU SIMD capability detection
+ */
+
+#include "simd.hpp"
+
+#if defined(OBSWEBRTC_SIMD_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+#if defined(OBSWEBRTC_SIMD_X86)
+
+bool cpuHasSse2() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;  // Part of the x86-64 baseline
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // The OS must save YMM state (OSXSAVE + XCR0 bits 1 and 2)
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    // libgcc/compiler-rt check OS YMM support before reporting AVX2
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+SimdLevel probeSimdLevel() {
+#if defined(OBSWEBRTC_SIMD_X86)
+    if (cpuHasAvx2()) {
+        return SimdLevel::AVX2;
+    }
+    if (cpuHasSse2()) {
+        return SimdLevel::SSE2;
+    }
+    return SimdLevel::Scalar;
+#elif defined(OBSWEBRTC_SIMD_NEON)
+    return SimdLevel::NEON;  // Mandatory on AArch64
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+}  // namespace
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = probeSimdLevel();
+    return level;
+}
+
+bool isSimdLevelSupported(SimdLevel level) {
+    const SimdLevel best = detectSimdLevel();
+    switch (level) {
+        case SimdLevel::Scalar:
+            return true;
+        case SimdLevel::SSE2:
+            return best == SimdLevel::SSE2 || best == SimdLevel::AVX2;
+        case SimdLevel::AVX2:
+            return best == SimdLevel::AVX2;
+        case SimdLevel::NEON:
+            return best == SimdLevel::NEON;
+    }
+    return false;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar:
+            return "scalar";
+        case SimdLevel::SSE2:
+            return "sse2";
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::NEON:
+            return "neon";
+    }
+    return "unknown";
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,59 @@
+/**
+ * @file simd.hpp
+ * @brief CPU SIMD capability detection for runtime dispatch
+ *
+ * Hot loops in the core library (bitstream scanning, FEC, pixel and sample
+ * conversion) ship a scalar reference plus SSE2/AVX2 (x86) or NEON (ARM)
+ * variants. Nothing is compiled with global -mavx2-style flags: AVX2 code is
+ * marked with OBSWEBRTC_TARGET_AVX2 and only called after detectSimdLevel()
+ * confirmed support, so one binary runs on every CPU OBS supports.
+ */
+
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define OBSWEBRTC_SIMD_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define OBSWEBRTC_SIMD_NEON 1
+#endif
+
+#if defined(OBSWEBRTC_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define OBSWEBRTC_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define OBSWEBRTC_TARGET_AVX2
+#endif
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Instruction set used by a SIMD kernel
+ */
+enum class SimdLevel {
+    Scalar,  ///< Portable C++ reference implementation
+    SSE2,    ///< x86 128-bit
+    AVX2,    ///< x86 256-bit
+    NEON     ///< ARM 128-bit
+};
+
+/**
+ * @brief Get the best SIMD level supported by this CPU
+ *
+ * Detected once and cached.
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * @brief Check whether kernels for a SIMD level can run on this CPU
+ * @param level SIMD level
+ * @return true if supported (Scalar is always supported)
+ */
+bool isSimdLevelSupported(SimdLevel level);
+
+/**
+ * @brief Get a printable name for a SIMD level
+ */
+const char* simdLevelName(SimdLevel level);
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,139 @@
+/**
+ * @file spsc-ring.hpp
+ * @brief Bounded lock-free single-producer/single-consumer ring buffer
+ *
+ * This module provides:
+ * - A fixed-capacity FIFO between exactly one producer and one consumer thread
+ * - Wait-free push/pop (no locks, no allocation after construction)
+ * - Move-only element handoff, so payload handles change hands without copies
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Bounded single-producer/single-consumer ring buffer
+ *
+ * Only one thread may call tryPush() and only one (other) thread may call
+ * tryPop(). size() and empty() may be called from either side and return an
+ * approximation while the other side is running. Head and tail live on
+ * separate cache lines so producer and consumer do not false-share.
+ *
+ * Example usage:
+ * @code
+ * SpscRing<EncodedPacket> ring(256);
+ *
+ * // Producer thread
+ * if (!ring.tryPush(std::move(packet))) {
+ *     // Ring is full - apply overflow policy
+ * }
+ *
+ * // Consumer thread
+ * EncodedPacket next;
+ * while (ring.tryPop(next)) {
+ *     send(next);
+ * }
+ * @endcode
+ *
+ * @tparam T Element type; must be default constructible and move assignable
+ */
+template <typename T>
+class SpscRing {
+public:
+    /**
+     * @brief Construct a ring holding at most @p capacity elements
+     * @param capacity Maximum number of queued elements
+     * @throws std::invalid_argument if capacity is 0
+     */
+    explicit SpscRing(size_t capacity)
+        : capacity_(capacity), slots_(capacity + 1), buffer_(new T[capacity + 1]) {
+        if (capacity == 0) {
+            throw std::invalid_argument("SpscRing capacity must be positive");
+        }
+    }
+
+    // Non-copyable, non-movable (the atomics are shared between threads)
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Enqueue an element (producer side)
+     * @param item Element to move into the ring
+     * @return true if queued, false if the ring is full (item is left untouched)
+     */
+    bool tryPush(T&& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t next = increment(tail);
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        buffer_[tail] = std::move(item);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue the oldest element (consumer side)
+     * @param out Receives the element
+     * @return true if an element was dequeued, false if the ring is empty
+     */
+    bool tryPop(T& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(buffer_[head]);
+        // Leave the slot empty so resources held by the element are released now
+        buffer_[head] = T();
+        head_.store(increment(head), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get the approximate number of queued elements
+     */
+    size_t size() const {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : tail + slots_ - head;
+    }
+
+    /**
+     * @brief Check whether the ring is (approximately) empty
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the maximum number of queued elements
+     */
+    size_t capacity() const {
+        return capacity_;
+    }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    size_t increment(size_t index) const {
+        return index + 1 == slots_ ? 0 : index + 1;
+    }
+
+    const size_t capacity_;
+    const size_t slots_;  // One slot is kept free to tell full from empty
+    std::unique_ptr<T[]> buffer_;
+
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};  // Written by consumer
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};  // Written by producer
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,143 @@
+/**
+ * @file task-worker.cpp
+ * @brief Serial background task queue implementation
+ */
+
+#include "task-worker.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Private implementation of TaskWorker
+ *
+ * Each thread runs for one generation; stop() bumps the generation so the
+ * running loop exits after its current task, even when a new thread has
+ * already been started by a later post().
+ */
+class TaskWorker::Impl {
+public:
+    ~Impl() { stop(); }
+
+    void post(Task task) {
+        if (!task) {
+            throw std::invalid_argument("Task cannot be empty");
+        }
+
+        std::thread retired;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+            if (!thread_.joinable()) {
+                const uint64_t generation = generation_;
+                thread_ = std::thread([this, generation]() { workerLoop(generation); });
+            } else {
+                cv_.notify_one();
+            }
+            if (isJoinableFromHere(retired_)) {
+                retired = std::move(retired_);
+            }
+        }
+        if (retired.joinable()) {
+            retired.join();
+        }
+    }
+
+    void stop() {
+        std::thread running;
+        std::thread retired;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.clear();
+            generation_++;
+            cv_.notify_all();
+
+            if (isJoinableFromHere(retired_)) {
+                retired = std::move(retired_);
+            }
+            if (isJoinableFromHere(thread_)) {
+                running = std::move(thread_);
+            } else if (thread_.joinable()) {
+                // Stopped from inside a task: the loop exits once it returns
+                retired_ = std::move(thread_);
+            }
+        }
+        if (running.joinable()) {
+            running.join();
+        }
+        if (retired.joinable()) {
+            retired.join();
+        }
+    }
+
+    bool isWorkerThread() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto self = std::this_thread::get_id();
+        return thread_.get_id() == self || retired_.get_id() == self;
+    }
+
+private:
+    static bool isJoinableFromHere(const std::thread& thread) {
+        return thread.joinable() && thread.get_id() != std::this_thread::get_id();
+    }
+
+    void workerLoop(uint64_t generation) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this, generation]() {
+                return generation != generation_ || !tasks_.empty();
+            });
+            if (generation != generation_) {
+                return;
+            }
+
+            Task task = std::move(tasks_.front());
+            tasks_.pop_front();
+
+            lock.unlock();
+            try {
+                task();
+            } catch (...) {
+                // Tasks report their own failures
+            }
+            lock.lock();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> tasks_;
+    uint64_t generation_ = 0;
+    std::thread thread_;
+    std::thread retired_;  // Stopped from inside its own task, joined later
+};
+
+// TaskWorker implementation
+
+TaskWorker::TaskWorker()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+TaskWorker::~TaskWorker() = default;
+
+void TaskWorker::post(Task task) {
+    impl_->post(std::move(task));
+}
+
+void TaskWorker::stop() {
+    impl_->stop();
+}
+
+bool TaskWorker::isWorkerThread() const {
+    return impl_->isWorkerThread();
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,82 @@
+/**
+ * @file task-worker.hpp
+ * @brief Single background thread running tasks in submission order
+ *
+ * Used by the WHIP/WHEP clients to take HTTP signaling off libdatachannel's
+ * callback thread while keeping the offer POST ahead of the ICE candidate
+ * PATCHes that depend on its resource URL.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Serial task queue backed by one lazily started thread
+ *
+ * Tasks run one at a time, in the order they were posted. The thread is only
+ * created by the first post(), so idle owners cost nothing. Exceptions thrown
+ * by a task are swallowed; tasks that need to report failure should do so
+ * themselves (e.g. through a std::promise).
+ *
+ * Example usage:
+ * @code
+ * TaskWorker worker;
+ * worker.post([] { sendOffer(); });
+ * worker.post([] { sendCandidate(); });  // Runs after the offer
+ * worker.stop();                         // Drops pending work, waits for the running task
+ * @endcode
+ */
+class TaskWorker {
+public:
+    using Task = std::function<void()>;
+
+    TaskWorker();
+
+    /**
+     * @brief Destructor - stops the worker
+     *
+     * Must not run on the worker thread itself (from inside a task).
+     */
+    ~TaskWorker();
+
+    // Non-copyable
+    TaskWorker(const TaskWorker&) = delete;
+    TaskWorker& operator=(const TaskWorker&) = delete;
+
+    // Allow move semantics
+    TaskWorker(TaskWorker&&) noexcept = default;
+    TaskWorker& operator=(TaskWorker&&) noexcept = default;
+
+    /**
+     * @brief Queue a task behind any already posted
+     * @param task Task to run on the worker thread
+     * @throws std::invalid_argument if task is empty
+     */
+    void post(Task task);
+
+    /**
+     * @brief Discard pending tasks and wait for the running one to finish
+     *
+     * A later post() starts the worker again. Called from inside a task, it
+     * only discards the pending tasks; the thread is joined by the next stop()
+     * from another thread or by the destructor.
+     */
+    void stop();
+
+    /**
+     * @brief Check whether the calling thread is the worker thread
+     */
+    bool isWorkerThread() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -0,0 +1,149 @@
+/**
+ * @file triple-buffer.hpp
+ * @brief Lock-free latest-value handoff between one writer and one reader
+ *
+ * This module provides:
+ * - A triple buffer: the writer fills one slot while the reader holds
+ *   another, and a third slot carries the newest published value between them
+ * - Latest-value-wins semantics: a value the reader has not taken yet is
+ *   replaced by the next one, so the reader never falls behind the writer
+ * - Wait-free publish/consume (one atomic exchange each, no allocation)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace obswebrtc {
+namespace core {
+
+/**
+ * @brief Counters for a TripleBuffer
+ */
+struct TripleBufferStats {
+    uint64_t published = 0;    // Values the writer handed over
+    uint64_t consumed = 0;     // Values the reader took
+    uint64_t overwritten = 0;  // Published values replaced before the reader took them
+};
+
+/**
+ * @brief Single-writer/single-reader triple buffer
+ *
+ * Unlike SpscRing, which delivers every element in order, a TripleBuffer only
+ * delivers the newest value: it suits consumers that run at their own pace
+ * and only care about the current state, such as a renderer showing the
+ * latest decoded picture. Neither side ever waits for the other.
+ *
+ * Only one thread may use writeSlot()/publish() and only one (other) thread
+ * may use consume()/readSlot(). Slots are reused rather than reset, so a
+ * writer that fills a slot may keep its allocations from earlier rounds.
+ *
+ * Example usage:
+ * @code
+ * TripleBuffer<Picture> latest;
+ *
+ * // Writer thread
+ * latest.writeSlot().assign(decoded);
+ * latest.publish();
+ *
+ * // Reader thread
+ * if (latest.consume()) {
+ *     show(latest.readSlot());
+ * }
+ * @endcode
+ *
+ * @tparam T Slot type; must be default constructible
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    // Non-copyable, non-movable (the atomics are shared between threads)
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Get the slot the writer fills next (writer side)
+     *
+     * Holds whatever value was last written to it; it is never read until
+     * publish() hands it over.
+     */
+    T& writeSlot() {
+        return slots_[back_];
+    }
+
+    /**
+     * @brief Hand the write slot to the reader as the newest value (writer side)
+     *
+     * The writer gets the previous middle slot to fill next.
+     *
+     * @return true if this replaced a value the reader never took
+     */
+    bool publish() {
+        const uint8_t previous = middle_.exchange(back_ | kFreshBit, std::memory_order_acq_rel);
+        back_ = previous & kIndexMask;
+        published_.fetch_add(1, std::memory_order_relaxed);
+        if ((previous & kFreshBit) == 0) {
+            return false;
+        }
+        overwritten_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Take the newest published value, if there is one (reader side)
+     * @return true if readSlot() now holds a value not seen before, false if
+     *         nothing was published since the last call (readSlot() is unchanged)
+     */
+    bool consume() {
+        if ((middle_.load(std::memory_order_relaxed) & kFreshBit) == 0) {
+            return false;
+        }
+        const uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & kIndexMask;
+        consumed_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Get the value last taken by consume() (reader side)
+     *
+     * Value-initialized until the first successful consume(). Stays valid
+     * and unchanged until the next successful consume().
+     */
+    T& readSlot() {
+        return slots_[front_];
+    }
+
+    /**
+     * @brief Get the counters; may be called from any thread
+     */
+    TripleBufferStats getStats() const {
+        TripleBufferStats stats;
+        stats.published = published_.load(std::memory_order_relaxed);
+        stats.consumed = consumed_.load(std::memory_order_relaxed);
+        stats.overwritten = overwritten_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFreshBit = 0x4;  // Middle slot holds an untaken value
+
+    T slots_[3]{};
+
+    // Slot index plus kFreshBit; the only state both sides touch
+    alignas(kCacheLineSize) std::atomic<uint8_t> middle_{1};
+    alignas(kCacheLineSize) uint8_t back_ = 2;  // Writer only
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> overwritten_{0};
+    alignas(kCacheLineSize) uint8_t front_ = 0;  // Reader only
+    std::atomic<uint64_t> consumed_{0};
+};
+
+}  // namespace core
+}  // namespace obswebrtc
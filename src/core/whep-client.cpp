@@ -6,9 +6,11 @@
 #include "whep-client.hpp"
 #include "http-client.hpp"
 #include "peer-connection.hpp"
+#include "task-worker.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <atomic>
 #include <stdexcept>
 #include <regex>
 #include <mutex>
@@ -52,6 +54,9 @@ public:
     }
 
     ~Impl() {
+        // Queued requests capture this; finish them before tearing down
+        worker_.stop();
+
         if (connected_) {
             try {
                 disconnect();
@@ -121,7 +126,10 @@ public:
         // Extract Location header for resource URL
         auto locationIt = response.headers.find("Location");
         if (locationIt != response.headers.end()) {
-            resourceUrl_ = locationIt->second;
+            {
+                std::lock_guard<std::mutex> lock(resourceMutex_);
+                resourceUrl_ = locationIt->second;
+            }
             connected_ = true;
 
             if (config_.onConnected) {
@@ -133,12 +141,34 @@ public:
         return response.body;
     }
 
+    std::future<std::string> sendOfferAsync(const std::string& sdp, WHEPAnswerCallback onAnswer) {
+        if (sdp.empty()) {
+            throw std::invalid_argument("SDP offer cannot be empty");
+        }
+
+        auto promise = std::make_shared<std::promise<std::string>>();
+        std::future<std::string> answer = promise->get_future();
+        worker_.post([this, sdp, onAnswer = std::move(onAnswer), promise]() {
+            try {
+                std::string body = sendOffer(sdp);
+                if (onAnswer) {
+                    onAnswer(body);
+                }
+                promise->set_value(std::move(body));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+        return answer;
+    }
+
     void sendIceCandidate(const std::string& candidate, const std::string& mid) {
         if (!connected_) {
             throw std::runtime_error("Not connected to WHEP server");
         }
 
-        if (resourceUrl_.empty()) {
+        const std::string resourceUrl = currentResourceUrl();
+        if (resourceUrl.empty()) {
             throw std::runtime_error("No resource URL available");
         }
 
@@ -162,8 +192,16 @@ public:
 
         request.headers["Content-Type"] = "application/trickle-ice-sdpfrag";
 
-        // Send PATCH request to resource URL
-        HTTPResponse response = HTTPClient::patch(resourceUrl_, request);
+        HTTPResponse response;
+        try {
+            // Send PATCH request to resource URL
+            response = HTTPClient::patch(resourceUrl, request);
+        } catch (const std::exception& e) {
+            if (config_.onError) {
+                config_.onError("Network error: " + std::string(e.what()));
+            }
+            throw;
+        }
 
         if (response.statusCode < 200 || response.statusCode >= 300) {
             if (config_.onError) {
@@ -174,12 +212,32 @@ public:
         }
     }
 
+    void sendIceCandidateAsync(const std::string& candidate, const std::string& mid) {
+        if (candidate.empty()) {
+            throw std::invalid_argument("ICE candidate cannot be empty");
+        }
+
+        worker_.post([this, candidate, mid]() {
+            if (!connected_) {
+                return;  // The offer ahead of it failed
+            }
+            try {
+                sendIceCandidate(candidate, mid);
+            } catch (const std::exception&) {
+                // Already reported through onError
+            }
+        });
+    }
+
     void disconnect() {
+        worker_.stop();
+
         if (!connected_) {
             return;
         }
 
-        if (!resourceUrl_.empty()) {
+        const std::string resourceUrl = currentResourceUrl();
+        if (!resourceUrl.empty()) {
             // Send DELETE request to resource URL
             HTTPRequest request;
 
@@ -189,7 +247,7 @@ public:
             }
 
             try {
-                HTTPClient::del(resourceUrl_, request);
+                HTTPClient::del(resourceUrl, request);
             } catch (const std::exception& e) {
                 if (config_.onError) {
                     config_.onError("Error during disconnect: " + std::string(e.what()));
@@ -198,7 +256,10 @@ public:
         }
 
         connected_ = false;
-        resourceUrl_.clear();
+        {
+            std::lock_guard<std::mutex> lock(resourceMutex_);
+            resourceUrl_.clear();
+        }
 
         if (config_.onDisconnected) {
             config_.onDisconnected();
@@ -214,6 +275,11 @@ public:
         return peerConnection_ != nullptr;
     }
 
+    bool requestKeyframe() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return peerConnection_ && peerConnection_->requestKeyframe();
+    }
+
     void connect() {
         std::lock_guard<std::mutex> lock(mutex_);
 
@@ -249,11 +315,6 @@ private:
             handleLocalIceCandidate(candidate, mid);
         };
 
-        // Set up state change callback
-        pcConfig.stateCallback = [this](ConnectionState state) {
-            handleStateChange(state);
-        };
-
         // Set up log callback (optional)
         pcConfig.logCallback = [this](LogLevel level, const std::string& message) {
             // Could be wired to external logging if needed
@@ -267,14 +328,14 @@ private:
             return;  // WHEP client only sends offers
         }
 
+        // Runs on libdatachannel's thread: hand the POST to the worker so ICE
+        // gathering carries on while the answer is in flight
         try {
-            // Send offer to WHEP server and get answer
-            std::string answer = sendOffer(sdp);
-
-            // Apply answer to PeerConnection
-            if (!answer.empty() && peerConnection_) {
-                peerConnection_->setRemoteDescription(SdpType::Answer, answer);
-            }
+            sendOfferAsync(sdp, [this](const std::string& answer) {
+                if (!answer.empty() && peerConnection_) {
+                    peerConnection_->setRemoteDescription(SdpType::Answer, answer);
+                }
+            });
         } catch (const std::exception& e) {
             if (config_.onError) {
                 config_.onError("Failed to send offer: " + std::string(e.what()));
@@ -283,14 +344,9 @@ private:
     }
 
     void handleLocalIceCandidate(const std::string& candidate, const std::string& mid) {
-        if (!connected_) {
-            // Buffer candidate until connected
-            pendingIceCandidates_.push_back({candidate, mid});
-            return;
-        }
-
+        // Queued behind the offer, so it goes out once the resource URL is known
         try {
-            sendIceCandidate(candidate, mid);
+            sendIceCandidateAsync(candidate, mid);
         } catch (const std::exception& e) {
             if (config_.onError) {
                 config_.onError("Failed to send ICE candidate: " + std::string(e.what()));
@@ -298,28 +354,18 @@ private:
         }
     }
 
-    void handleStateChange(ConnectionState state) {
-        if (state == ConnectionState::Connected || state == ConnectionState::Completed) {
-            // Send any pending ICE candidates
-            for (const auto& pending : pendingIceCandidates_) {
-                try {
-                    sendIceCandidate(pending.first, pending.second);
-                } catch (const std::exception& e) {
-                    if (config_.onError) {
-                        config_.onError("Failed to send buffered ICE candidate: " + std::string(e.what()));
-                    }
-                }
-            }
-            pendingIceCandidates_.clear();
-        }
+    std::string currentResourceUrl() const {
+        std::lock_guard<std::mutex> lock(resourceMutex_);
+        return resourceUrl_;
     }
 
     WHEPConfig config_;
-    bool connected_;
-    std::string resourceUrl_;
+    std::atomic<bool> connected_;
+    std::string resourceUrl_;  // Written by the worker, guarded by resourceMutex_
+    mutable std::mutex resourceMutex_;
     std::unique_ptr<PeerConnection> peerConnection_;
-    std::vector<std::pair<std::string, std::string>> pendingIceCandidates_;
     mutable std::mutex mutex_;
+    TaskWorker worker_;  // Asynchronous offer and candidate requests, in order
 };
 
 // WHEPClient implementation
@@ -334,10 +380,19 @@ std::string WHEPClient::sendOffer(const std::string& sdp) {
     return impl_->sendOffer(sdp);
 }
 
+std::future<std::string> WHEPClient::sendOfferAsync(const std::string& sdp,
+                                                    WHEPAnswerCallback onAnswer) {
+    return impl_->sendOfferAsync(sdp, std::move(onAnswer));
+}
+
 void WHEPClient::sendIceCandidate(const std::string& candidate, const std::string& mid) {
     impl_->sendIceCandidate(candidate, mid);
 }
 
+void WHEPClient::sendIceCandidateAsync(const std::string& candidate, const std::string& mid) {
+    impl_->sendIceCandidateAsync(candidate, mid);
+}
+
 void WHEPClient::disconnect() {
     impl_->disconnect();
 }
@@ -350,6 +405,10 @@ bool WHEPClient::hasPeerConnection() const {
     return impl_->hasPeerConnection();
 }
 
+bool WHEPClient::requestKeyframe() {
+    return impl_->requestKeyframe();
+}
+
 void WHEPClient::connect() {
     impl_->connect();
 }
@@ -12,6 +12,7 @@
 #include "peer-connection.hpp"
 
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -33,6 +34,7 @@ using WHEPDisconnectedCallback = std::function<void()>;
 using WHEPErrorCallback = std::function<void(const std::string& error)>;
 using WHEPIceCandidateCallback =
     std::function<void(const std::string& candidate, const std::string& mid)>;
+using WHEPAnswerCallback = std::function<void(const std::string& answer)>;
 
 /**
  * @brief Configuration for WHEPClient
@@ -64,6 +66,8 @@ struct WHEPConfig {
  * - HTTP PATCH for ICE candidate trickle
  * - HTTP DELETE to terminate session
  * - Bearer token authentication support
+ * - Asynchronous variants that run the HTTP exchange on a worker thread, so
+ *   callers on libdatachannel's callback thread do not stall ICE processing
  *
  * Example usage:
  * @code
@@ -110,6 +114,25 @@ public:
      */
     std::string sendOffer(const std::string& sdp);
 
+    /**
+     * @brief Send SDP offer to WHEP server on the client's worker thread
+     *
+     * Returns at once. The POST runs on a worker shared with
+     * sendIceCandidateAsync(), so candidates queued meanwhile are trickled
+     * after the answer, once the resource URL is known. Failures are
+     * reported through onError as with sendOffer().
+     *
+     * @param sdp SDP offer string
+     * @param onAnswer Optional continuation, run on the worker thread with the
+     *        answer before the future becomes ready
+     * @return Future holding the SDP answer, or the exception sendOffer() would
+     *         have thrown; std::future_error (broken_promise) if disconnect()
+     *         cancels the exchange before it starts
+     * @throws std::invalid_argument if SDP is empty
+     */
+    std::future<std::string> sendOfferAsync(const std::string& sdp,
+                                            WHEPAnswerCallback onAnswer = nullptr);
+
     /**
      * @brief Send ICE candidate to WHEP server via PATCH
      * @param candidate ICE candidate string
@@ -118,9 +141,22 @@ public:
      */
     void sendIceCandidate(const std::string& candidate, const std::string& mid);
 
+    /**
+     * @brief Queue ICE candidate for sending on the client's worker thread
+     *
+     * Runs after any offer queued before it. Dropped if that offer failed;
+     * PATCH failures are reported through onError.
+     *
+     * @param candidate ICE candidate string
+     * @param mid Media stream identification tag
+     * @throws std::invalid_argument if candidate is empty
+     */
+    void sendIceCandidateAsync(const std::string& candidate, const std::string& mid);
+
     /**
      * @brief Disconnect from WHEP server
-     * Sends HTTP DELETE to resource URL
+     * Cancels queued asynchronous requests, waits for the one in flight,
+     * then sends HTTP DELETE to resource URL
      */
     void disconnect();
 
@@ -136,15 +172,21 @@ public:
      */
     bool hasPeerConnection() const;
 
+    /**
+     * @brief Ask the server for a keyframe on the received video track
+     * @return true if a request was sent (see PeerConnection::requestKeyframe())
+     */
+    bool requestKeyframe();
+
     /**
      * @brief Connect to WHEP server and establish WebRTC connection
      *
      * This initiates the full WHEP connection flow:
      * 1. Create internal PeerConnection (if frame callbacks are set)
      * 2. Generate SDP offer
-     * 3. Send offer to WHEP server
+     * 3. Send offer to WHEP server (on the worker thread)
      * 4. Receive and apply SDP answer
-     * 5. Exchange ICE candidates
+     * 5. Trickle ICE candidates as they are gathered
      *
      * @throws std::runtime_error if connection fails
      */
@@ -5,9 +5,12 @@
 
 #include "whip-client.hpp"
 #include "http-client.hpp"
+#include "task-worker.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <atomic>
+#include <mutex>
 #include <stdexcept>
 #include <regex>
 
@@ -45,6 +48,9 @@ public:
     }
 
     ~Impl() {
+        // Queued requests capture this; finish them before tearing down
+        worker_.stop();
+
         if (connected_) {
             try {
                 disconnect();
@@ -104,7 +110,10 @@ public:
         // Extract Location header for resource URL
         auto locationIt = response.headers.find("Location");
         if (locationIt != response.headers.end()) {
-            resourceUrl_ = locationIt->second;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                resourceUrl_ = locationIt->second;
+            }
             connected_ = true;
 
             if (config_.onConnected) {
@@ -116,12 +125,34 @@ public:
         return response.body;
     }
 
+    std::future<std::string> sendOfferAsync(const std::string& sdp, WHIPAnswerCallback onAnswer) {
+        if (sdp.empty()) {
+            throw std::invalid_argument("SDP offer cannot be empty");
+        }
+
+        auto promise = std::make_shared<std::promise<std::string>>();
+        std::future<std::string> answer = promise->get_future();
+        worker_.post([this, sdp, onAnswer = std::move(onAnswer), promise]() {
+            try {
+                std::string body = sendOffer(sdp);
+                if (onAnswer) {
+                    onAnswer(body);
+                }
+                promise->set_value(std::move(body));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+        return answer;
+    }
+
     void sendIceCandidate(const std::string& candidate, const std::string& mid) {
         if (!connected_) {
             throw std::runtime_error("Not connected to WHIP server");
         }
 
-        if (resourceUrl_.empty()) {
+        const std::string resourceUrl = currentResourceUrl();
+        if (resourceUrl.empty()) {
             throw std::runtime_error("No resource URL available");
         }
 
@@ -145,8 +176,16 @@ public:
 
         request.headers["Content-Type"] = "application/trickle-ice-sdpfrag";
 
-        // Send PATCH request to resource URL using shared HTTP client
-        HTTPResponse response = HTTPClient::patch(resourceUrl_, request);
+        HTTPResponse response;
+        try {
+            // Send PATCH request to resource URL using shared HTTP client
+            response = HTTPClient::patch(resourceUrl, request);
+        } catch (const std::exception& e) {
+            if (config_.onError) {
+                config_.onError("Network error: " + std::string(e.what()));
+            }
+            throw;
+        }
 
         if (response.statusCode < 200 || response.statusCode >= 300) {
             if (config_.onError) {
@@ -157,12 +196,32 @@ public:
         }
     }
 
+    void sendIceCandidateAsync(const std::string& candidate, const std::string& mid) {
+        if (candidate.empty()) {
+            throw std::invalid_argument("ICE candidate cannot be empty");
+        }
+
+        worker_.post([this, candidate, mid]() {
+            if (!connected_) {
+                return;  // The offer ahead of it failed
+            }
+            try {
+                sendIceCandidate(candidate, mid);
+            } catch (const std::exception&) {
+                // Already reported through onError
+            }
+        });
+    }
+
     void disconnect() {
+        worker_.stop();
+
         if (!connected_) {
             return;
         }
 
-        if (!resourceUrl_.empty()) {
+        const std::string resourceUrl = currentResourceUrl();
+        if (!resourceUrl.empty()) {
             // Send DELETE request to resource URL
             HTTPRequest request;
 
@@ -172,7 +231,7 @@ public:
             }
 
             try {
-                HTTPClient::del(resourceUrl_, request);
+                HTTPClient::del(resourceUrl, request);
             } catch (const std::exception& e) {
                 if (config_.onError) {
                     config_.onError("Error during disconnect: " + std::string(e.what()));
@@ -181,7 +240,10 @@ public:
         }
 
         connected_ = false;
-        resourceUrl_.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            resourceUrl_.clear();
+        }
 
         if (config_.onDisconnected) {
             config_.onDisconnected();
@@ -193,9 +255,16 @@ public:
     }
 
 private:
+    std::string currentResourceUrl() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return resourceUrl_;
+    }
+
     WHIPConfig config_;
-    bool connected_;
-    std::string resourceUrl_;
+    std::atomic<bool> connected_;
+    std::string resourceUrl_;  // Written by the worker, guarded by mutex_
+    mutable std::mutex mutex_;
+    TaskWorker worker_;  // Asynchronous offer and candidate requests, in order
 };
 
 // WHIPClient implementation
@@ -210,10 +279,19 @@ std::string WHIPClient::sendOffer(const std::string& sdp) {
     return impl_->sendOffer(sdp);
 }
 
+std::future<std::string> WHIPClient::sendOfferAsync(const std::string& sdp,
+                                                    WHIPAnswerCallback onAnswer) {
+    return impl_->sendOfferAsync(sdp, std::move(onAnswer));
+}
+
 void WHIPClient::sendIceCandidate(const std::string& candidate, const std::string& mid) {
     impl_->sendIceCandidate(candidate, mid);
 }
 
+void WHIPClient::sendIceCandidateAsync(const std::string& candidate, const std::string& mid) {
+    impl_->sendIceCandidateAsync(candidate, mid);
+}
+
 void WHIPClient::disconnect() {
     impl_->disconnect();
 }
@@ -12,6 +12,7 @@
 #include "http-client.hpp"
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <string>
 
@@ -26,6 +27,7 @@ using WHIPDisconnectedCallback = std::function<void()>;
 using WHIPErrorCallback = std::function<void(const std::string& error)>;
 using WHIPIceCandidateCallback =
     std::function<void(const std::string& candidate, const std::string& mid)>;
+using WHIPAnswerCallback = std::function<void(const std::string& answer)>;
 
 /**
  * @brief Configuration for WHIPClient
@@ -50,6 +52,8 @@ struct WHIPConfig {
  * - HTTP PATCH for ICE candidate trickle
  * - HTTP DELETE to terminate session
  * - Bearer token authentication support
+ * - Asynchronous variants that run the HTTP exchange on a worker thread, so
+ *   callers on libdatachannel's callback thread do not stall ICE processing
  *
  * Example usage:
  * @code
@@ -63,6 +67,12 @@ struct WHIPConfig {
  * auto client = std::make_unique<WHIPClient>(config);
  * std::string answer = client->sendOffer(myOfferSdp);
  * client->sendIceCandidate(candidate, mid);
+ *
+ * // Or, from a libdatachannel callback:
+ * client->sendOfferAsync(myOfferSdp, [&](const std::string& answer) {
+ *     peerConnection->setRemoteDescription(SdpType::Answer, answer);
+ * });
+ * client->sendIceCandidateAsync(candidate, mid);  // Sent after the offer
  * @endcode
  */
 class WHIPClient {
@@ -96,6 +106,25 @@ public:
      */
     std::string sendOffer(const std::string& sdp);
 
+    /**
+     * @brief Send SDP offer to WHIP server on the client's worker thread
+     *
+     * Returns at once. The POST runs on a worker shared with
+     * sendIceCandidateAsync(), so candidates queued meanwhile are trickled
+     * after the answer, once the resource URL is known. Failures are
+     * reported through onError as with sendOffer().
+     *
+     * @param sdp SDP offer string
+     * @param onAnswer Optional continuation, run on the worker thread with the
+     *        answer before the future becomes ready
+     * @return Future holding the SDP answer, or the exception sendOffer() would
+     *         have thrown; std::future_error (broken_promise) if disconnect()
+     *         cancels the exchange before it starts
+     * @throws std::invalid_argument if SDP is empty
+     */
+    std::future<std::string> sendOfferAsync(const std::string& sdp,
+                                            WHIPAnswerCallback onAnswer = nullptr);
+
     /**
      * @brief Send ICE candidate to WHIP server via PATCH
      * @param candidate ICE candidate string
@@ -104,9 +133,22 @@ public:
      */
     void sendIceCandidate(const std::string& candidate, const std::string& mid);
 
+    /**
+     * @brief Queue ICE candidate for sending on the client's worker thread
+     *
+     * Runs after any offer queued before it. Dropped if that offer failed;
+     * PATCH failures are reported through onError.
+     *
+     * @param candidate ICE candidate string
+     * @param mid Media stream identification tag
+     * @throws std::invalid_argument if candidate is empty
+     */
+    void sendIceCandidateAsync(const std::string& candidate, const std::string& mid);
+
     /**
      * @brief Disconnect from WHIP server
-     * Sends HTTP DELETE to resource URL
+     * Cancels queued asynchronous requests, waits for the one in flight,
+     * then sends HTTP DELETE to resource URL
      */
     void disconnect();
 
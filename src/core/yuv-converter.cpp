@@ -0,0 +1,528 @@
+/**
+ * @file yuv-converter.cpp
+ * @brief Implementation of the YUV to RGB kernels and the parallel converter
+ */
+
+#include "yuv-converter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(OBSWEBRTC_SIMD_X86)
+#include <immintrin.h>
+#elif defined(OBSWEBRTC_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace obswebrtc {
+namespace core {
+
+namespace {
+
+/**
+ * @brief Fixed-point form of a conversion, shared by every kernel
+ *
+ * All terms are 16-bit with 6 fractional bits. The luma term is
+ * (Y * 257 * yScale) >> 16, an unsigned high multiply, plus yBias (offset
+ * and rounding). Chroma terms are (C - 128) times a coefficient. Sums
+ * saturate at 16 bits, and the result is shifted down by 6 and clamped to a
+ * byte. SIMD kernels use the same operations lane by lane, so they match the
+ * scalar reference exactly.
+ */
+struct Coefficients {
+    uint16_t yScale = 0;
+    int16_t yBias = 0;
+    int16_t ub = 0;  // U to B
+    int16_t ug = 0;  // U to G (subtracted)
+    int16_t vg = 0;  // V to G (subtracted)
+    int16_t vr = 0;  // V to R
+    bool bgra = false;
+};
+
+/**
+ * @brief Converts one row; for NV12, u is the UV row and v is unused
+ */
+using RowFunction = void (*)(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst,
+                             size_t width, const Coefficients& c);
+
+Coefficients coefficientsFor(const RgbConversion& conversion) {
+    const bool bt601 = conversion.matrix == YuvMatrix::BT601;
+    const double kr = bt601 ? 0.299 : 0.2126;
+    const double kb = bt601 ? 0.114 : 0.0722;
+    const double kg = 1.0 - kr - kb;
+    const double yScale = conversion.fullRange ? 1.0 : 255.0 / 219.0;
+    const double cScale = conversion.fullRange ? 1.0 : 255.0 / 224.0;
+    const double yOffset = conversion.fullRange ? 0.0 : 16.0;
+
+    Coefficients c;
+    c.yScale = static_cast<uint16_t>(std::lround(yScale * 64.0 * 65536.0 / 257.0));
+    c.yBias = static_cast<int16_t>(32 - std::lround(yOffset * yScale * 64.0));
+    c.ub = static_cast<int16_t>(std::lround(2.0 * (1.0 - kb) * cScale * 64.0));
+    c.ug = static_cast<int16_t>(std::lround(2.0 * (1.0 - kb) * kb / kg * cScale * 64.0));
+    c.vg = static_cast<int16_t>(std::lround(2.0 * (1.0 - kr) * kr / kg * cScale * 64.0));
+    c.vr = static_cast<int16_t>(std::lround(2.0 * (1.0 - kr) * cScale * 64.0));
+    c.bgra = conversion.format == RgbFormat::BGRA;
+    return c;
+}
+
+int32_t saturate16(int32_t value) {
+    return std::min<int32_t>(std::max<int32_t>(value, INT16_MIN), INT16_MAX);
+}
+
+uint8_t toByte(int32_t value) {
+    return static_cast<uint8_t>(std::min(std::max(value >> 6, 0), 255));
+}
+
+void pixelScalar(uint8_t y, uint8_t u, uint8_t v, uint8_t* dst, const Coefficients& c) {
+    const int32_t luma = static_cast<int32_t>((y * 257u * c.yScale) >> 16) + c.yBias;
+    const int32_t cu = u - 128;
+    const int32_t cv = v - 128;
+    const int32_t b = saturate16(luma + c.ub * cu);
+    const int32_t g = saturate16(saturate16(luma - c.ug * cu) - c.vg * cv);
+    const int32_t r = saturate16(luma + c.vr * cv);
+    dst[0] = toByte(c.bgra ? b : r);
+    dst[1] = toByte(g);
+    dst[2] = toByte(c.bgra ? r : b);
+    dst[3] = 255;
+}
+
+void rowI420Scalar(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst,
+                   size_t width, const Coefficients& c) {
+    for (size_t x = 0; x < width; x++) {
+        pixelScalar(y[x], u[x / 2], v[x / 2], dst + 4 * x, c);
+    }
+}
+
+void rowNv12Scalar(const uint8_t* y, const uint8_t* uv, const uint8_t*, uint8_t* dst,
+                   size_t width, const Coefficients& c) {
+    for (size_t x = 0; x < width; x++) {
+        pixelScalar(y[x], uv[x / 2 * 2], uv[x / 2 * 2 + 1], dst + 4 * x, c);
+    }
+}
+
+#if defined(OBSWEBRTC_SIMD_X86)
+
+/**
+ * @brief Eight pixels' colour terms: Y * 257 and chroma - 128, one per pixel
+ */
+void colorSse2(__m128i y257, __m128i u, __m128i v, const Coefficients& c, __m128i& r,
+               __m128i& g, __m128i& b) {
+    const __m128i luma = _mm_add_epi16(
+        _mm_mulhi_epu16(y257, _mm_set1_epi16(static_cast<int16_t>(c.yScale))),
+        _mm_set1_epi16(c.yBias));
+    b = _mm_srai_epi16(_mm_adds_epi16(luma, _mm_mullo_epi16(u, _mm_set1_epi16(c.ub))), 6);
+    g = _mm_srai_epi16(
+        _mm_subs_epi16(_mm_subs_epi16(luma, _mm_mullo_epi16(u, _mm_set1_epi16(c.ug))),
+                       _mm_mullo_epi16(v, _mm_set1_epi16(c.vg))),
+        6);
+    r = _mm_srai_epi16(_mm_adds_epi16(luma, _mm_mullo_epi16(v, _mm_set1_epi16(c.vr))), 6);
+}
+
+/**
+ * @brief Sixteen pixels from 16 luma bytes and 8 chroma pairs (as int16 - 128)
+ */
+void pixels16Sse2(__m128i y, __m128i u, __m128i v, uint8_t* dst, const Coefficients& c) {
+    __m128i rLow, gLow, bLow, rHigh, gHigh, bHigh;
+    colorSse2(_mm_unpacklo_epi8(y, y), _mm_unpacklo_epi16(u, u), _mm_unpacklo_epi16(v, v), c,
+              rLow, gLow, bLow);
+    colorSse2(_mm_unpackhi_epi8(y, y), _mm_unpackhi_epi16(u, u), _mm_unpackhi_epi16(v, v), c,
+              rHigh, gHigh, bHigh);
+    __m128i r = _mm_packus_epi16(rLow, rHigh);
+    const __m128i g = _mm_packus_epi16(gLow, gHigh);
+    __m128i b = _mm_packus_epi16(bLow, bHigh);
+    if (c.bgra) {
+        std::swap(r, b);
+    }
+
+    const __m128i alpha = _mm_set1_epi8(-1);
+    const __m128i rgLow = _mm_unpacklo_epi8(r, g);
+    const __m128i rgHigh = _mm_unpackhi_epi8(r, g);
+    const __m128i baLow = _mm_unpacklo_epi8(b, alpha);
+    const __m128i baHigh = _mm_unpackhi_epi8(b, alpha);
+    __m128i* out = reinterpret_cast<__m128i*>(dst);
+    _mm_storeu_si128(out, _mm_unpacklo_epi16(rgLow, baLow));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rgLow, baLow));
+    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rgHigh, baHigh));
+    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rgHigh, baHigh));
+}
+
+void rowI420Sse2(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst,
+                 size_t width, const Coefficients& c) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2));
+        const __m128i v8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2));
+        pixels16Sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x)),
+                     _mm_sub_epi16(_mm_unpacklo_epi8(u8, zero), bias),
+                     _mm_sub_epi16(_mm_unpacklo_epi8(v8, zero), bias), dst + 4 * x, c);
+    }
+    rowI420Scalar(y + x, u + x / 2, v + x / 2, dst + 4 * x, width - x, c);
+}
+
+void rowNv12Sse2(const uint8_t* y, const uint8_t* uv, const uint8_t*, uint8_t* dst,
+                 size_t width, const Coefficients& c) {
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    const __m128i bias = _mm_set1_epi16(128);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i pairs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + x));
+        pixels16Sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x)),
+                     _mm_sub_epi16(_mm_and_si128(pairs, lowBytes), bias),
+                     _mm_sub_epi16(_mm_srli_epi16(pairs, 8), bias), dst + 4 * x, c);
+    }
+    rowNv12Scalar(y + x, uv + x, nullptr, dst + 4 * x, width - x, c);
+}
+
+/**
+ * @brief Sixteen pixels from 16 luma bytes and 8 chroma pairs (as int16 - 128)
+ */
+OBSWEBRTC_TARGET_AVX2
+void pixels16Avx2(__m128i y, __m128i u, __m128i v, uint8_t* dst, const Coefficients& c) {
+    // Each chroma value twice, in pixel order across both lanes
+    const __m256i u16 = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_unpacklo_epi16(u, u)), _mm_unpackhi_epi16(u, u), 1);
+    const __m256i v16 = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_unpacklo_epi16(v, v)), _mm_unpackhi_epi16(v, v), 1);
+    const __m256i y16 = _mm256_cvtepu8_epi16(y);
+    const __m256i y257 = _mm256_or_si256(y16, _mm256_slli_epi16(y16, 8));
+
+    const __m256i luma = _mm256_add_epi16(
+        _mm256_mulhi_epu16(y257, _mm256_set1_epi16(static_cast<int16_t>(c.yScale))),
+        _mm256_set1_epi16(c.yBias));
+    __m256i b = _mm256_srai_epi16(
+        _mm256_adds_epi16(luma, _mm256_mullo_epi16(u16, _mm256_set1_epi16(c.ub))), 6);
+    const __m256i g = _mm256_srai_epi16(
+        _mm256_subs_epi16(
+            _mm256_subs_epi16(luma, _mm256_mullo_epi16(u16, _mm256_set1_epi16(c.ug))),
+            _mm256_mullo_epi16(v16, _mm256_set1_epi16(c.vg))),
+        6);
+    __m256i r = _mm256_srai_epi16(
+        _mm256_adds_epi16(luma, _mm256_mullo_epi16(v16, _mm256_set1_epi16(c.vr))), 6);
+    if (c.bgra) {
+        std::swap(r, b);
+    }
+
+    // Packing works per 128-bit lane: lane 0 holds pixels 0-7, lane 1 pixels 8-15
+    const __m256i rg = _mm256_packus_epi16(r, g);
+    const __m256i ba = _mm256_packus_epi16(b, _mm256_set1_epi16(255));
+    const __m256i rb = _mm256_unpacklo_epi8(rg, ba);
+    const __m256i ga = _mm256_unpackhi_epi8(rg, ba);
+    const __m256i low = _mm256_unpacklo_epi8(rb, ga);   // Pixels 0-3 and 8-11
+    const __m256i high = _mm256_unpackhi_epi8(rb, ga);  // Pixels 4-7 and 12-15
+    __m256i* out = reinterpret_cast<__m256i*>(dst);
+    _mm256_storeu_si256(out, _mm256_permute2x128_si256(low, high, 0x20));
+    _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(low, high, 0x31));
+}
+
+OBSWEBRTC_TARGET_AVX2
+void rowI420Avx2(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst,
+                 size_t width, const Coefficients& c) {
+    const __m128i bias = _mm_set1_epi16(128);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i u8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2));
+        const __m128i v8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2));
+        pixels16Avx2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x)),
+                     _mm_sub_epi16(_mm_cvtepu8_epi16(u8), bias),
+                     _mm_sub_epi16(_mm_cvtepu8_epi16(v8), bias), dst + 4 * x, c);
+    }
+    rowI420Scalar(y + x, u + x / 2, v + x / 2, dst + 4 * x, width - x, c);
+}
+
+OBSWEBRTC_TARGET_AVX2
+void rowNv12Avx2(const uint8_t* y, const uint8_t* uv, const uint8_t*, uint8_t* dst,
+                 size_t width, const Coefficients& c) {
+    const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+    const __m128i bias = _mm_set1_epi16(128);
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i pairs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uv + x));
+        pixels16Avx2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x)),
+                     _mm_sub_epi16(_mm_and_si128(pairs, lowBytes), bias),
+                     _mm_sub_epi16(_mm_srli_epi16(pairs, 8), bias), dst + 4 * x, c);
+    }
+    rowNv12Scalar(y + x, uv + x, nullptr, dst + 4 * x, width - x, c);
+}
+
+#elif defined(OBSWEBRTC_SIMD_NEON)
+
+/**
+ * @brief Eight pixels' channels, shifted down and clamped to bytes
+ */
+void colorNeon(uint16x8_t y257, int16x8_t u, int16x8_t v, const Coefficients& c, uint8x8_t& r,
+               uint8x8_t& g, uint8x8_t& b) {
+    // Unsigned high multiply, as _mm_mulhi_epu16
+    const uint16x4_t scale = vdup_n_u16(c.yScale);
+    const uint16x8_t high = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(y257), scale), 16),
+                                         vshrn_n_u32(vmull_u16(vget_high_u16(y257), scale), 16));
+    const int16x8_t luma = vaddq_s16(vreinterpretq_s16_u16(high), vdupq_n_s16(c.yBias));
+    b = vqshrun_n_s16(vqaddq_s16(luma, vmulq_n_s16(u, c.ub)), 6);
+    g = vqshrun_n_s16(vqsubq_s16(vqsubq_s16(luma, vmulq_n_s16(u, c.ug)), vmulq_n_s16(v, c.vg)),
+                      6);
+    r = vqshrun_n_s16(vqaddq_s16(luma, vmulq_n_s16(v, c.vr)), 6);
+}
+
+/**
+ * @brief Sixteen pixels from 16 luma bytes and 8 chroma pairs
+ */
+void pixels16Neon(uint8x16_t y, uint8x8_t u8, uint8x8_t v8, uint8_t* dst, const Coefficients& c) {
+    const uint8x8_t bias = vdup_n_u8(128);
+    const int16x8x2_t u = vzipq_s16(vreinterpretq_s16_u16(vsubl_u8(u8, bias)),
+                                    vreinterpretq_s16_u16(vsubl_u8(u8, bias)));
+    const int16x8x2_t v = vzipq_s16(vreinterpretq_s16_u16(vsubl_u8(v8, bias)),
+                                    vreinterpretq_s16_u16(vsubl_u8(v8, bias)));
+    const uint16x8_t yLow = vmovl_u8(vget_low_u8(y));
+    const uint16x8_t yHigh = vmovl_u8(vget_high_u8(y));
+
+    uint8x8_t rLow, gLow, bLow, rHigh, gHigh, bHigh;
+    colorNeon(vorrq_u16(yLow, vshlq_n_u16(yLow, 8)), u.val[0], v.val[0], c, rLow, gLow, bLow);
+    colorNeon(vorrq_u16(yHigh, vshlq_n_u16(yHigh, 8)), u.val[1], v.val[1], c, rHigh, gHigh,
+              bHigh);
+
+    uint8x16x4_t pixels;
+    pixels.val[0] = vcombine_u8(rLow, rHigh);
+    pixels.val[1] = vcombine_u8(gLow, gHigh);
+    pixels.val[2] = vcombine_u8(bLow, bHigh);
+    pixels.val[3] = vdupq_n_u8(255);
+    if (c.bgra) {
+        std::swap(pixels.val[0], pixels.val[2]);
+    }
+    vst4q_u8(dst, pixels);
+}
+
+void rowI420Neon(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* dst,
+                 size_t width, const Coefficients& c) {
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        pixels16Neon(vld1q_u8(y + x), vld1_u8(u + x / 2), vld1_u8(v + x / 2), dst + 4 * x, c);
+    }
+    rowI420Scalar(y + x, u + x / 2, v + x / 2, dst + 4 * x, width - x, c);
+}
+
+void rowNv12Neon(const uint8_t* y, const uint8_t* uv, const uint8_t*, uint8_t* dst,
+                 size_t width, const Coefficients& c) {
+    size_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const uint8x8x2_t pairs = vld2_u8(uv + x);
+        pixels16Neon(vld1q_u8(y + x), pairs.val[0], pairs.val[1], dst + 4 * x, c);
+    }
+    rowNv12Scalar(y + x, uv + x, nullptr, dst + 4 * x, width - x, c);
+}
+
+#endif
+
+RowFunction rowFunctionFor(SimdLevel level, YuvFormat format) {
+    const bool nv12 = format == YuvFormat::NV12;
+    switch (level) {
+#if defined(OBSWEBRTC_SIMD_X86)
+        case SimdLevel::SSE2:
+            return nv12 ? rowNv12Sse2 : rowI420Sse2;
+        case SimdLevel::AVX2:
+            return nv12 ? rowNv12Avx2 : rowI420Avx2;
+#elif defined(OBSWEBRTC_SIMD_NEON)
+        case SimdLevel::NEON:
+            return nv12 ? rowNv12Neon : rowI420Neon;
+#endif
+        default:
+            return nv12 ? rowNv12Scalar : rowI420Scalar;
+    }
+}
+
+void validate(const YuvImage& image, const uint8_t* dst, size_t dstStride) {
+    if (image.width == 0 || image.height == 0) {
+        throw std::invalid_argument("YUV picture is empty");
+    }
+    const size_t chromaWidth = (static_cast<size_t>(image.width) + 1) / 2;
+    const bool nv12 = image.format == YuvFormat::NV12;
+    if (!image.planes[0] || !image.planes[1] || (!nv12 && !image.planes[2])) {
+        throw std::invalid_argument("YUV picture is missing a plane");
+    }
+    if (image.strides[0] < image.width || image.strides[1] < (nv12 ? 2 : 1) * chromaWidth ||
+        (!nv12 && image.strides[2] < chromaWidth)) {
+        throw std::invalid_argument("YUV plane stride is smaller than a row");
+    }
+    if (!dst) {
+        throw std::invalid_argument("RGB output buffer is null");
+    }
+    if (dstStride < static_cast<size_t>(image.width) * 4) {
+        throw std::invalid_argument("RGB output stride is smaller than a row");
+    }
+}
+
+void convertRows(const YuvImage& image, const Coefficients& c, RowFunction row, uint8_t* dst,
+                 size_t dstStride, uint32_t firstRow, uint32_t endRow) {
+    for (uint32_t line = firstRow; line < endRow; line++) {
+        const size_t chromaLine = line / 2;
+        row(image.planes[0] + line * image.strides[0],
+            image.planes[1] + chromaLine * image.strides[1],
+            image.planes[2] ? image.planes[2] + chromaLine * image.strides[2] : nullptr,
+            dst + line * dstStride, image.width, c);
+    }
+}
+
+}  // namespace
+
+void convertYuvToRgb(const YuvImage& image, const RgbConversion& conversion, uint8_t* dst,
+                     size_t dstStride) {
+    static const RowFunction i420Row = rowFunctionFor(detectSimdLevel(), YuvFormat::I420);
+    static const RowFunction nv12Row = rowFunctionFor(detectSimdLevel(), YuvFormat::NV12);
+    validate(image, dst, dstStride);
+    convertRows(image, coefficientsFor(conversion),
+                image.format == YuvFormat::NV12 ? nv12Row : i420Row, dst, dstStride, 0,
+                image.height);
+}
+
+void convertYuvToRgb(const YuvImage& image, const RgbConversion& conversion, uint8_t* dst,
+                     size_t dstStride, SimdLevel level) {
+    if (!isSimdLevelSupported(level)) {
+        throw std::invalid_argument(std::string("SIMD level not supported: ") +
+                                    simdLevelName(level));
+    }
+    validate(image, dst, dstStride);
+    convertRows(image, coefficientsFor(conversion), rowFunctionFor(level, image.format), dst,
+                dstStride, 0, image.height);
+}
+
+/**
+ * @brief Private implementation of YuvConverter
+ *
+ * Helper i converts band i of the current job. A job is published by
+ * bumping the generation; the caller waits until every helper with a band
+ * has reported back before it returns, so the job may live on its stack.
+ */
+class YuvConverter::Impl {
+public:
+    explicit Impl(size_t threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threadCount_ = std::min(threads, constants::kMaxYuvConvertThreads);
+
+        for (size_t helper = 1; helper < threadCount_; helper++) {
+            helpers_.emplace_back([this, helper]() { helperLoop(helper); });
+        }
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        jobCondition_.notify_all();
+        for (std::thread& helper : helpers_) {
+            helper.join();
+        }
+    }
+
+    void convert(const YuvImage& image, const RgbConversion& conversion, uint8_t* dst,
+                 size_t dstStride) {
+        validate(image, dst, dstStride);
+        const RowFunction row = rowFunctionFor(level_, image.format);
+        const Coefficients c = coefficientsFor(conversion);
+
+        const size_t pixels = static_cast<size_t>(image.width) * image.height;
+        const size_t bands = std::min(
+            {threadCount_, std::max<size_t>(pixels / constants::kYuvConvertMinBandPixels, 1),
+             static_cast<size_t>(image.height)});
+        if (bands == 1) {
+            convertRows(image, c, row, dst, dstStride, 0, image.height);
+            return;
+        }
+
+        std::lock_guard<std::mutex> serial(convertMutex_);
+        Job job{&image, &c, row, dst, dstStride, bands};
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &job;
+            remaining_ = bands - 1;
+            generation_++;
+        }
+        jobCondition_.notify_all();
+
+        runBand(job, 0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCondition_.wait(lock, [this]() { return remaining_ == 0; });
+        job_ = nullptr;
+    }
+
+    size_t getThreadCount() const { return threadCount_; }
+
+private:
+    struct Job {
+        const YuvImage* image;
+        const Coefficients* coefficients;
+        RowFunction row;
+        uint8_t* dst;
+        size_t dstStride;
+        size_t bands;
+    };
+
+    static void runBand(const Job& job, size_t band) {
+        const uint32_t height = job.image->height;
+        const uint32_t first = static_cast<uint32_t>(height * band / job.bands);
+        const uint32_t end = static_cast<uint32_t>(height * (band + 1) / job.bands);
+        convertRows(*job.image, *job.coefficients, job.row, job.dst, job.dstStride, first, end);
+    }
+
+    void helperLoop(size_t helper) {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            jobCondition_.wait(lock, [this, seen]() { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+            const Job* job = job_;
+            if (!job || helper >= job->bands) {
+                continue;  // Woke after the job finished, or it had fewer bands than threads
+            }
+
+            lock.unlock();
+            runBand(*job, helper);
+            lock.lock();
+            if (--remaining_ == 0) {
+                doneCondition_.notify_one();
+            }
+        }
+    }
+
+    const SimdLevel level_ = detectSimdLevel();
+    size_t threadCount_ = 1;
+    std::vector<std::thread> helpers_;
+
+    std::mutex convertMutex_;  // One job at a time
+    std::mutex mutex_;
+    std::condition_variable jobCondition_;
+    std::condition_variable doneCondition_;
+    const Job* job_ = nullptr;
+    uint64_t generation_ = 0;
+    size_t remaining_ = 0;  // Helper bands of the current job not yet converted
+    bool stopping_ = false;
+};
+
+YuvConverter::YuvConverter(size_t threads) : impl_(std::make_unique<Impl>(threads)) {}
+
+YuvConverter::~YuvConverter() = default;
+
+void YuvConverter::convert(const YuvImage& image, const RgbConversion& conversion, uint8_t* dst,
+                           size_t dstStride) {
+    impl_->convert(image, conversion, dst, dstStride);
+}
+
+size_t YuvConverter::getThreadCount() const {
+    return impl_->getThreadCount();
+}
+
+}  // namespace core
+}  // namespace obswebrtc
@@ -8,7 +8,11 @@
 
 #include "output/webrtc-output.hpp"
 #include <obs-module.h>
+#include <util/util_uint64.h>
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
 
 using namespace obswebrtc::output;
@@ -20,8 +24,80 @@ struct webrtc_output_data {
     obs_output_t* output;
     std::unique_ptr<WebRTCOutput> webrtc_output;
     bool active;
+
+    // Adaptive bitrate changes the encoder's own settings, which OBS keeps
+    // with the profile; the user's bitrate is put back when the output stops
+    std::mutex encoder_bitrate_mutex;
+    obs_encoder_t* adapted_encoder = nullptr;  // Set once a bitrate was applied
+    int64_t original_encoder_bitrate = 0;
 };
 
+/**
+ * @brief Read the bitrate the encoder is configured with, in kbps
+ * @return The bitrate, or 0 if the encoder does not use a target bitrate
+ */
+static int64_t webrtc_output_get_encoder_bitrate(obs_encoder_t* encoder) {
+    obs_data_t* settings = obs_encoder_get_settings(encoder);
+    int64_t bitrate = obs_data_get_int(settings, "bitrate");
+
+    // Quality-based rate control ignores the bitrate setting altogether
+    const char* rate_control = obs_data_get_string(settings, "rate_control");
+    if (rate_control && (strcmp(rate_control, "CQP") == 0 || strcmp(rate_control, "CRF") == 0 ||
+                         strcmp(rate_control, "ICQ") == 0 || strcmp(rate_control, "lossless") == 0)) {
+        bitrate = 0;
+    }
+    obs_data_release(settings);
+    return bitrate;
+}
+
+/**
+ * @brief Check whether obs_encoder_update() makes this encoder emit an IDR
+ *
+ * libobs has no explicit keyframe request. NVENC resets with a forced IDR
+ * when reconfigured; x264, QSV, AMF and the others apply new settings to
+ * the running stream and keep their keyframe schedule.
+ */
+static bool webrtc_output_encoder_idr_on_update(obs_encoder_t* encoder) {
+    const char* id = obs_encoder_get_id(encoder);
+    return id && strstr(id, "nvenc") != nullptr;
+}
+
+/**
+ * @brief Set the encoder's bitrate, remembering the user's value the first time
+ */
+static void webrtc_output_set_encoder_bitrate(webrtc_output_data* data, obs_encoder_t* encoder,
+                                              int bitrate_kbps) {
+    std::lock_guard<std::mutex> lock(data->encoder_bitrate_mutex);
+
+    obs_data_t* encoder_settings = obs_encoder_get_settings(encoder);
+    if (!data->adapted_encoder) {
+        data->adapted_encoder = encoder;
+        data->original_encoder_bitrate = obs_data_get_int(encoder_settings, "bitrate");
+    }
+    obs_data_set_int(encoder_settings, "bitrate", bitrate_kbps);
+    obs_encoder_update(encoder, encoder_settings);
+    obs_data_release(encoder_settings);
+}
+
+/**
+ * @brief Put back the bitrate the encoder had before adaptive bitrate changed it
+ */
+static void webrtc_output_restore_encoder_bitrate(webrtc_output_data* data) {
+    std::lock_guard<std::mutex> lock(data->encoder_bitrate_mutex);
+    if (!data->adapted_encoder) {
+        return;
+    }
+
+    obs_data_t* encoder_settings = obs_encoder_get_settings(data->adapted_encoder);
+    obs_data_set_int(encoder_settings, "bitrate", data->original_encoder_bitrate);
+    obs_encoder_update(data->adapted_encoder, encoder_settings);
+    obs_data_release(encoder_settings);
+
+    blog(LOG_INFO, "[WebRTC Output] Video encoder bitrate restored to %lld kbps",
+         static_cast<long long>(data->original_encoder_bitrate));
+    data->adapted_encoder = nullptr;
+}
+
 /**
  * @brief Get output name
  */
@@ -55,6 +131,7 @@ static void webrtc_output_destroy(void* data_ptr) {
             data->webrtc_output->stop();
         }
     }
+    webrtc_output_restore_encoder_bitrate(data);
 
     delete data;
 
@@ -72,10 +149,17 @@ static bool webrtc_output_start(void* data_ptr) {
     // Get settings
     obs_data_t* settings = obs_output_get_settings(data->output);
     const char* server_url = obs_data_get_string(settings, "server_url");
+    std::string additional_server_urls = obs_data_get_string(settings, "additional_server_urls");
     const char* video_codec = obs_data_get_string(settings, "video_codec");
     const char* audio_codec = obs_data_get_string(settings, "audio_codec");
     int64_t video_bitrate = obs_data_get_int(settings, "video_bitrate");
     int64_t audio_bitrate = obs_data_get_int(settings, "audio_bitrate");
+    bool adaptive_bitrate = obs_data_get_bool(settings, "adaptive_bitrate");
+    int64_t max_video_bitrate = obs_data_get_int(settings, "max_video_bitrate");
+    int64_t keyframe_request_interval = obs_data_get_int(settings, "keyframe_request_interval");
+    bool fec = obs_data_get_bool(settings, "fec");
+    int64_t fec_protection = obs_data_get_int(settings, "fec_protection");
+    int64_t max_fec_protection = obs_data_get_int(settings, "max_fec_protection");
     obs_data_release(settings);
 
     // Validate settings
@@ -89,7 +173,23 @@ static bool webrtc_output_start(void* data_ptr) {
     WebRTCOutputConfig config;
     config.serverUrl = server_url;
 
-    // Set video codec
+    // Fan-out: one additional WHIP endpoint per line
+    std::istringstream url_lines(additional_server_urls);
+    std::string url;
+    while (std::getline(url_lines, url)) {
+        url.erase(0, url.find_first_not_of(" \t\r"));
+        url.erase(url.find_last_not_of(" \t\r") + 1);
+        if (!url.empty()) {
+            config.additionalServerUrls.push_back(url);
+        }
+    }
+
+    // Set video codec: the encoder OBS attached wins over the setting
+    obs_encoder_t* video_encoder = obs_output_get_video_encoder(data->output);
+    if (video_encoder) {
+        video_codec = obs_encoder_get_codec(video_encoder);
+    }
+
     if (strcmp(video_codec, "h264") == 0) {
         config.videoCodec = VideoCodec::H264;
     } else if (strcmp(video_codec, "vp8") == 0) {
@@ -102,6 +202,18 @@ static bool webrtc_output_start(void* data_ptr) {
         config.videoCodec = VideoCodec::H264; // Default
     }
 
+    // H.264 encoders may keep SPS/PPS in their extradata only; the output
+    // repeats them ahead of each IDR so viewers can join mid-stream
+    if (config.videoCodec == VideoCodec::H264 && video_encoder &&
+        obs_output_initialize_encoders(data->output, 0)) {
+        uint8_t* extra_data = nullptr;
+        size_t extra_data_size = 0;
+        if (obs_encoder_get_extra_data(video_encoder, &extra_data, &extra_data_size) &&
+            extra_data && extra_data_size > 0) {
+            config.videoExtraData.assign(extra_data, extra_data + extra_data_size);
+        }
+    }
+
     // Set audio codec
     if (strcmp(audio_codec, "opus") == 0) {
         config.audioCodec = AudioCodec::Opus;
@@ -111,16 +223,73 @@ static bool webrtc_output_start(void* data_ptr) {
         config.audioCodec = AudioCodec::Opus; // Default
     }
 
-    // Set bitrates
+    // Set bitrates: the encoder's own bitrate is what is actually sent
+    const int64_t encoder_bitrate =
+        video_encoder ? webrtc_output_get_encoder_bitrate(video_encoder) : 0;
+    if (encoder_bitrate > 0) {
+        video_bitrate = encoder_bitrate;
+    }
     config.videoBitrate = video_bitrate > 0 ? static_cast<int>(video_bitrate) : 2500;
     config.audioBitrate = audio_bitrate > 0 ? static_cast<int>(audio_bitrate) : 128;
 
+    // Adaptive bitrate (opt-in): start at the encoder's bitrate, never exceed
+    // max_video_bitrate. Encoders without a target bitrate cannot follow it
+    config.enableAdaptiveBitrate = adaptive_bitrate && encoder_bitrate > 0;
+    if (adaptive_bitrate && !config.enableAdaptiveBitrate) {
+        blog(LOG_WARNING, "[WebRTC Output] Adaptive bitrate needs an encoder with a target "
+                          "bitrate (CBR/VBR); disabled");
+    }
+    if (max_video_bitrate > 0) {
+        config.maxVideoBitrate = static_cast<int>(max_video_bitrate);
+    }
+
+    // Keyframe requests: at most one forced keyframe per interval
+    config.minKeyframeRequestIntervalMs = static_cast<int>(keyframe_request_interval);
+
+    // FEC: percentages in the UI, ratios in the config; the maximum never
+    // drops below the base
+    config.enableFec = fec;
+    config.fecProtectionRatio = static_cast<double>(fec_protection) / 100.0;
+    config.maxFecProtectionRatio =
+        static_cast<double>(std::max(fec_protection, max_fec_protection)) / 100.0;
+
     // Set callbacks
     config.errorCallback = [data](const std::string& error) {
         blog(LOG_ERROR, "[WebRTC Output] Error: %s", error.c_str());
         obs_output_signal_stop(data->output, OBS_OUTPUT_ERROR);
     };
 
+    config.congestionCallback = [](size_t queued_packets) {
+        blog(LOG_WARNING, "[WebRTC Output] Send queue full (%zu packets), dropping packets",
+             queued_packets);
+    };
+
+    config.bitrateCallback = [data](int bitrate_kbps) {
+        obs_encoder_t* encoder = obs_output_get_video_encoder(data->output);
+        if (!encoder) {
+            return;
+        }
+
+        webrtc_output_set_encoder_bitrate(data, encoder, bitrate_kbps);
+
+        blog(LOG_INFO, "[WebRTC Output] Video bitrate adapted to %d kbps", bitrate_kbps);
+    };
+
+    config.keyframeRequestCallback = [data]() {
+        obs_encoder_t* encoder = obs_output_get_video_encoder(data->output);
+        if (!encoder || !webrtc_output_encoder_idr_on_update(encoder)) {
+            // Served by the encoder's next scheduled keyframe
+            return false;
+        }
+
+        obs_data_t* encoder_settings = obs_encoder_get_settings(encoder);
+        obs_encoder_update(encoder, encoder_settings);
+        obs_data_release(encoder_settings);
+
+        blog(LOG_DEBUG, "[WebRTC Output] Keyframe forced for receiver");
+        return true;
+    };
+
     config.stateCallback = [data](bool active) {
         blog(LOG_INFO, "[WebRTC Output] State changed: %s", active ? "active" : "inactive");
         if (!active && data->active) {
@@ -175,13 +344,59 @@ static void webrtc_output_stop(void* data_ptr, uint64_t ts) {
     }
 
     if (data->webrtc_output) {
+        obswebrtc::core::NetworkStats stats = data->webrtc_output->getStatistics();
+        blog(LOG_INFO,
+             "[WebRTC Output] Sent %llu frames, dropped %llu, %llu payload copies (%llu bytes), "
+             "final video bitrate %d kbps",
+             static_cast<unsigned long long>(stats.framesSent),
+             static_cast<unsigned long long>(stats.framesDropped),
+             static_cast<unsigned long long>(stats.payloadCopies),
+             static_cast<unsigned long long>(stats.payloadBytesCopied),
+             data->webrtc_output->getVideoBitrate());
+
         data->webrtc_output->stop();
         data->webrtc_output.reset();
     }
 
+    // No feedback arrives once stopped, so the bitrate stays restored
+    webrtc_output_restore_encoder_bitrate(data);
+
     blog(LOG_INFO, "[WebRTC Output] Output stopped");
 }
 
+/**
+ * @brief Take a reference on an OBS encoder packet as a refcounted payload view
+ *
+ * The packet data stays owned by OBS; the reference is dropped with
+ * obs_encoder_packet_release() once the last EncodedPacket using it is gone.
+ */
+static std::shared_ptr<const uint8_t> webrtc_output_ref_packet(struct encoder_packet* packet) {
+    auto* ref = new encoder_packet();
+    obs_encoder_packet_ref(ref, packet);
+
+    return std::shared_ptr<const uint8_t>(ref->data, [ref](const uint8_t*) {
+        obs_encoder_packet_release(ref);
+        delete ref;
+    });
+}
+
+/**
+ * @brief Convert a packet's pts to microseconds without overflowing
+ *
+ * The intermediate pts * 1000000 * timebase_num can exceed int64 for large
+ * timestamps or timebase numerators, so util_mul_div64 forms it in 128 bits.
+ */
+static int64_t webrtc_output_packet_time_us(const struct encoder_packet* packet) {
+    const uint64_t scale = 1000000ULL * static_cast<uint64_t>(packet->timebase_num);
+    const uint64_t den = static_cast<uint64_t>(packet->timebase_den);
+    if (packet->pts < 0) {
+        // Encoders with B-frames may start at a negative pts
+        const uint64_t magnitude = 0 - static_cast<uint64_t>(packet->pts);
+        return -static_cast<int64_t>(util_mul_div64(magnitude, scale, den));
+    }
+    return static_cast<int64_t>(util_mul_div64(static_cast<uint64_t>(packet->pts), scale, den));
+}
+
 /**
  * @brief Receive encoded packet (both video and audio)
  */
@@ -208,11 +423,12 @@ static void webrtc_output_encoded_packet(void* data_ptr, struct encoder_packet*
             return;
         }
 
-        webrtc_packet.data.assign(packet->data, packet->data + packet->size);
-        webrtc_packet.timestamp = packet->pts;
+        webrtc_packet.buffer = webrtc_output_ref_packet(packet);
+        webrtc_packet.bufferSize = packet->size;
+        webrtc_packet.timestamp = webrtc_output_packet_time_us(packet);
 
-        // Send packet
-        data->webrtc_output->sendPacket(webrtc_packet);
+        // Queue packet for the send thread
+        data->webrtc_output->sendPacket(std::move(webrtc_packet));
     } catch (const std::exception& e) {
         blog(LOG_ERROR, "[WebRTC Output] Failed to send packet: %s", e.what());
     }
@@ -223,10 +439,22 @@ static void webrtc_output_encoded_packet(void* data_ptr, struct encoder_packet*
  */
 static void webrtc_output_defaults(obs_data_t* settings) {
     obs_data_set_default_string(settings, "server_url", "");
+    obs_data_set_default_string(settings, "additional_server_urls", "");
     obs_data_set_default_string(settings, "video_codec", "h264");
     obs_data_set_default_string(settings, "audio_codec", "opus");
     obs_data_set_default_int(settings, "video_bitrate", 2500);
     obs_data_set_default_int(settings, "audio_bitrate", 128);
+    obs_data_set_default_bool(settings, "adaptive_bitrate", false);
+    obs_data_set_default_int(settings, "max_video_bitrate", 5000);
+    obs_data_set_default_int(settings, "keyframe_request_interval",
+                             obswebrtc::core::constants::kDefaultKeyframeRequestIntervalMs);
+    obs_data_set_default_bool(settings, "fec", false);
+    obs_data_set_default_int(settings, "fec_protection",
+                             static_cast<int64_t>(
+                                 obswebrtc::core::constants::kDefaultFecProtectionRatio * 100));
+    obs_data_set_default_int(settings, "max_fec_protection",
+                             static_cast<int64_t>(
+                                 obswebrtc::core::constants::kDefaultMaxFecProtectionRatio * 100));
 }
 
 /**
@@ -239,6 +467,8 @@ static obs_properties_t* webrtc_output_properties(void* unused) {
 
     // Server URL
     obs_properties_add_text(props, "server_url", "Server URL", OBS_TEXT_DEFAULT);
+    obs_properties_add_text(props, "additional_server_urls", "Additional Server URLs (one per line)",
+                            OBS_TEXT_MULTILINE);
 
     // Video codec
     obs_property_t* video_codec = obs_properties_add_list(props, "video_codec", "Video Codec",
@@ -257,6 +487,20 @@ static obs_properties_t* webrtc_output_properties(void* unused) {
     // Video bitrate
     obs_properties_add_int(props, "video_bitrate", "Video Bitrate (kbps)", 500, 10000, 100);
 
+    // Adaptive bitrate
+    obs_properties_add_bool(props, "adaptive_bitrate", "Adapt Video Bitrate to Network");
+    obs_properties_add_int(props, "max_video_bitrate", "Maximum Video Bitrate (kbps)", 500, 20000, 100);
+
+    // Keyframe requests from receivers (PLI/FIR)
+    obs_properties_add_int(props, "keyframe_request_interval",
+                           "Minimum Keyframe Request Interval (ms)", 0, 10000, 100);
+
+    // Forward error correction (FlexFEC)
+    obs_properties_add_bool(props, "fec", "Forward Error Correction (FlexFEC)");
+    obs_properties_add_int(props, "fec_protection", "FEC Protection (%)", 0, 100, 5);
+    obs_properties_add_int(props, "max_fec_protection", "Maximum FEC Protection Under Loss (%)",
+                           0, 100, 5);
+
     // Audio bitrate
     obs_properties_add_int(props, "audio_bitrate", "Audio Bitrate (kbps)", 64, 320, 16);
 
@@ -277,7 +521,7 @@ void register_webrtc_output() {
     webrtc_output_info.start = webrtc_output_start;
     webrtc_output_info.stop = webrtc_output_stop;
     webrtc_output_info.encoded_packet = webrtc_output_encoded_packet;
-    webrtc_output_info.encoded_video_codecs = "h264";
+    webrtc_output_info.encoded_video_codecs = "h264;vp8;vp9;av1";
     webrtc_output_info.encoded_audio_codecs = "opus";
     webrtc_output_info.get_defaults = webrtc_output_defaults;
     webrtc_output_info.get_properties = webrtc_output_properties;
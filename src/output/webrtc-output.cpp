@@ -7,8 +7,22 @@
 #include "core/whip-client.hpp"
 #include "core/peer-connection.hpp"
 #include "core/reconnection-manager.hpp"
+#include "core/constants.hpp"
+#include "core/bandwidth-estimator.hpp"
+#include "core/fec-encoder.hpp"
+#include "core/frame-drop-policy.hpp"
+#include "core/keyframe-request-throttle.hpp"
+#include "core/pacer.hpp"
+#include "core/spsc-ring.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <condition_variable>
 #include <stdexcept>
 #include <mutex>
+#include <random>
+#include <thread>
 
 namespace obswebrtc {
 namespace output {
@@ -25,6 +39,99 @@ public:
             throw std::runtime_error("Server URL cannot be empty");
         }
 
+        if (config_.sendQueueDepth == 0) {
+            throw std::runtime_error("Send queue depth must be positive");
+        }
+        sendQueue_ = std::make_unique<core::SpscRing<EncodedPacket>>(config_.sendQueueDepth);
+        audioQueue_ = std::make_unique<core::SpscRing<EncodedPacket>>(
+            core::constants::kAudioSendQueueDepth);
+
+        if (config_.overflowPolicy == SendQueueOverflowPolicy::DropNonKeyframes) {
+            if (!(config_.nonReferenceDropThreshold > 0.0 &&
+                  config_.nonReferenceDropThreshold <= config_.gopDropThreshold &&
+                  config_.gopDropThreshold <= 1.0)) {
+                throw std::runtime_error(
+                    "Frame drop thresholds must satisfy 0 < non-reference <= GOP <= 1");
+            }
+            core::FrameDropPolicyConfig dropConfig;
+            dropConfig.queueDepth = config_.sendQueueDepth;
+            dropConfig.nonReferenceThreshold = config_.nonReferenceDropThreshold;
+            dropConfig.gopThreshold = config_.gopDropThreshold;
+            dropPolicy_ = std::make_unique<core::FrameDropPolicy>(dropConfig);
+        }
+
+        if (videoBitrate_ <= 0) {
+            throw std::runtime_error("Video bitrate must be positive");
+        }
+
+        if (config_.enablePacing && (config_.pacingBatchIntervalMs < 0 ||
+                                     config_.pacingBatchIntervalMs > core::constants::kDefaultPacerMaxBurstMs)) {
+            throw std::runtime_error("Pacing batch interval must be within [0, " +
+                                     std::to_string(core::constants::kDefaultPacerMaxBurstMs) + "] ms");
+        }
+
+        // One destination per WHIP endpoint, each paced on its own link
+        std::vector<std::string> urls{config_.serverUrl};
+        for (const auto& url : config_.additionalServerUrls) {
+            if (url.empty()) {
+                throw std::runtime_error("Additional server URL cannot be empty");
+            }
+            if (std::find(urls.begin(), urls.end(), url) != urls.end()) {
+                throw std::runtime_error("Duplicate server URL: " + url);
+            }
+            urls.push_back(url);
+        }
+        for (const auto& url : urls) {
+            auto destination = std::make_unique<Destination>();
+            destination->url = url;
+            if (config_.enablePacing) {
+                core::PacerConfig pacerConfig;
+                pacerConfig.targetBitrateKbps = videoBitrate_;
+                pacerConfig.pacingMultiplier = config_.pacingMultiplier;
+                pacerConfig.batchIntervalMs = config_.pacingBatchIntervalMs;
+                pacerConfig.statistics = &statistics_;
+                destination->pacer = std::make_shared<core::Pacer>(pacerConfig);
+            }
+            destinations_.push_back(std::move(destination));
+        }
+
+        // Video is packetized once on the send thread, however many destinations
+        videoPacketizer_ = createVideoPacketizer(config_.videoCodec, config_.videoExtraData);
+
+        if (config_.enableAdaptiveBitrate) {
+            if (config_.minVideoBitrate <= 0) {
+                throw std::runtime_error("Minimum video bitrate must be positive");
+            }
+            // videoBitrate is the encoder's bitrate: start there, within the configured bounds
+            core::HardwareEncoderConfig encoderConfig;
+            encoderConfig.bitrate = videoBitrate_;
+            encoderConfig.maxBitrate = config_.maxVideoBitrate;
+            core::BandwidthEstimatorConfig estimatorConfig =
+                core::BandwidthEstimatorConfig::fromEncoderConfig(encoderConfig);
+            estimatorConfig.minBitrateKbps = std::min(config_.minVideoBitrate, videoBitrate_.load());
+            bandwidthEstimator_ = std::make_unique<core::BandwidthEstimator>(estimatorConfig);
+        }
+
+        if (config_.enableRtx && config_.rtxHistoryMs <= 0) {
+            throw std::runtime_error("Retransmission history must be positive");
+        }
+
+        if (config_.enableFec &&
+            !(config_.fecProtectionRatio >= 0.0 &&
+              config_.fecProtectionRatio <= config_.maxFecProtectionRatio &&
+              config_.maxFecProtectionRatio <= 1.0)) {
+            throw std::runtime_error("FEC protection ratios must satisfy 0 <= base <= max <= 1");
+        }
+
+        if (config_.keyframeRequestCallback) {
+            if (config_.minKeyframeRequestIntervalMs < 0) {
+                throw std::runtime_error("Keyframe request interval cannot be negative");
+            }
+            core::KeyframeRequestThrottleConfig throttleConfig;
+            throttleConfig.minIntervalMs = config_.minKeyframeRequestIntervalMs;
+            keyframeThrottle_ = std::make_unique<core::KeyframeRequestThrottle>(throttleConfig);
+        }
+
         // Initialize reconnection manager if enabled
         if (config_.enableAutoReconnect) {
             core::ReconnectionConfig reconnectConfig;
@@ -52,85 +159,17 @@ public:
         starting_ = true;
 
         try {
-            // Create WHIP client configuration
-            core::WHIPConfig whipConfig;
-            whipConfig.url = config_.serverUrl;
-            whipConfig.onConnected = [this]() {
-                if (config_.stateCallback) {
-                    config_.stateCallback(true);
-                }
-            };
-            whipConfig.onDisconnected = [this]() {
-                if (config_.stateCallback) {
-                    config_.stateCallback(false);
-                }
-                active_ = false;
-            };
-            whipConfig.onError = [this](const std::string& error) {
-                if (config_.errorCallback) {
-                    config_.errorCallback(error);
-                }
-            };
-
-            // Create WHIP client
-            whipClient_ = std::make_unique<core::WHIPClient>(whipConfig);
-
-            // Create peer connection configuration
-            core::PeerConnectionConfig pcConfig;
-            pcConfig.iceServers = {"stun:stun.l.google.com:19302"};
-            pcConfig.localDescriptionCallback = [this](core::SdpType type, const std::string& sdp) {
-                if (type == core::SdpType::Offer && whipClient_) {
-                    try {
-                        std::string answer = whipClient_->sendOffer(sdp);
-                        if (peerConnection_) {
-                            peerConnection_->setRemoteDescription(core::SdpType::Answer, answer);
-                        }
-                    } catch (const std::exception& e) {
-                        if (config_.errorCallback) {
-                            config_.errorCallback(std::string("Failed to send offer: ") + e.what());
-                        }
-                    }
-                }
-            };
-            pcConfig.iceCandidateCallback = [this](const std::string& candidate, const std::string& mid) {
-                if (whipClient_ && whipClient_->isConnected()) {
-                    try {
-                        whipClient_->sendIceCandidate(candidate, mid);
-                    } catch (const std::exception& e) {
-                        // Ignore ICE candidate errors (non-critical)
-                    }
-                }
-            };
-            pcConfig.stateCallback = [this](core::ConnectionState state) {
-                if (state == core::ConnectionState::Connected || state == core::ConnectionState::Completed) {
-                    active_ = true;
-                    if (config_.stateCallback) {
-                        config_.stateCallback(true);
-                    }
-                    // Reset reconnection manager on successful connection
-                    if (reconnectionManager_) {
-                        reconnectionManager_->onConnectionSuccess();
-                    }
-                } else if (state == core::ConnectionState::Failed || state == core::ConnectionState::Disconnected) {
-                    active_ = false;
-                    if (config_.stateCallback) {
-                        config_.stateCallback(false);
-                    }
-                    // Schedule reconnection on failure
-                    if (reconnectionManager_ && config_.enableAutoReconnect) {
-                        reconnectionManager_->scheduleReconnect();
-                    }
-                }
-            };
-
-            // Create peer connection
-            peerConnection_ = std::make_unique<core::PeerConnection>(pcConfig);
+            for (auto& destination : destinations_) {
+                connectDestination(*destination);
+            }
 
-            // Create offer to initiate connection
-            peerConnection_->createOffer();
+            startSendWorker();
 
             return true;
         } catch (const std::exception& e) {
+            for (auto& destination : destinations_) {
+                closeDestination(*destination);
+            }
             starting_ = false;
             if (config_.errorCallback) {
                 config_.errorCallback(std::string("Failed to start output: ") + e.what());
@@ -140,33 +179,37 @@ public:
     }
 
     void stop() {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        if (!active_ && !starting_) {
-            return;
-        }
+        bool running = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running = active_ || starting_;
+            // Producers check active_ first, so none queues anything from here on
+            active_ = false;
+            starting_ = false;
 
-        active_ = false;
-        starting_ = false;
+            if (running) {
+                // Cancel reconnection
+                if (reconnectionManager_) {
+                    reconnectionManager_->cancel();
+                }
 
-        // Cancel reconnection
-        if (reconnectionManager_) {
-            reconnectionManager_->cancel();
+                // Closed now, so no connection callback can set active_ again
+                for (auto& destination : destinations_) {
+                    closeDestination(*destination);
+                }
+            }
         }
 
-        // Close WHIP client
-        if (whipClient_) {
-            whipClient_->disconnect();
-            whipClient_.reset();
+        // A sendPacket() that saw active_ before it was cleared may still be
+        // pushing; wait for it, so the drain below leaves nothing for the next session
+        while (producers_.load() != 0) {
+            std::this_thread::yield();
         }
 
-        // Close peer connection
-        if (peerConnection_) {
-            peerConnection_->close();
-            peerConnection_.reset();
-        }
+        // The send worker takes mutex_ per packet, so join it without holding it
+        stopSendWorker();
 
-        if (config_.stateCallback) {
+        if (running && config_.stateCallback) {
             config_.stateCallback(false);
         }
     }
@@ -176,24 +219,52 @@ public:
         return active_;
     }
 
-    void sendPacket(const EncodedPacket& packet) {
-        std::lock_guard<std::mutex> lock(mutex_);
-
+    void sendPacket(EncodedPacket&& packet) {
+        // Runs on the OBS encoder thread: no locks, no waiting on the network.
+        // Counted before active_ is checked (both sequentially consistent), so
+        // stop() either sees this call or this call sees active_ cleared
+        ProducerScope scope(producers_);
         if (!active_) {
             throw std::runtime_error("Output is not active");
         }
 
-        // TODO: Implement actual packet sending via peer connection
-        // This will require adding track support to PeerConnection
-        // For now, just validate the packet
-        if (packet.data.empty()) {
+        if (packet.payloadSize() == 0) {
             throw std::runtime_error("Packet data is empty");
         }
+
+        // Audio has a lane of its own, so it never competes with video for room
+        if (packet.type == PacketType::Audio) {
+            if (!audioQueue_->tryPush(std::move(packet))) {
+                // Only when the send thread has stalled altogether
+                signalCongestion();
+                return;
+            }
+            wakeSendWorker();
+            return;
+        }
+
+        const core::FrameClass frameClass = classifyVideoFrame(packet);
+        if (dropPolicy_ && shedVideoFrame(frameClass)) {
+            droppedFrames_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (!sendQueue_->tryPush(std::move(packet))) {
+            handleVideoOverflow(frameClass);
+            return;
+        }
+        if (frameClass == core::FrameClass::Keyframe) {
+            queuedGop_++;
+        }
+        wakeSendWorker();
+    }
+
+    size_t getQueuedPacketCount() const {
+        return sendQueue_->size() + audioQueue_->size();
     }
 
     int getVideoBitrate() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return videoBitrate_;
+        return videoBitrate_.load();
     }
 
     int getAudioBitrate() const {
@@ -207,6 +278,7 @@ public:
             throw std::invalid_argument("Video bitrate must be positive");
         }
         videoBitrate_ = bitrate;
+        setPacerBitrate(bitrate);
     }
 
     void setAudioBitrate(int bitrate) {
@@ -217,18 +289,595 @@ public:
         audioBitrate_ = bitrate;
     }
 
+    core::NetworkStats getStatistics() const {
+        flushDroppedFrames();
+        statistics_.calculateBitrates();
+        return statistics_.getCurrentStats();
+    }
+
 private:
+    /**
+     * @brief One WHIP endpoint and its connection
+     */
+    struct Destination {
+        std::string url;
+        std::unique_ptr<core::WHIPClient> whipClient;
+        std::shared_ptr<core::PeerConnection> peerConnection;
+        std::shared_ptr<core::Pacer> pacer;  // Shared with the PeerConnection; reports to statistics_
+        std::atomic<bool> connected{false};
+
+        // Set from this destination's receiver reports, applied on the send thread
+        std::atomic<double> fecProtectionRatio{0.0};
+        std::atomic<double> appliedFecProtectionRatio{0.0};  // Last ratio given to peerConnection
+    };
+
+    /**
+     * @brief A destination's connection, taken for one dispatchPacket()
+     */
+    struct SendTarget {
+        Destination* destination;
+        std::shared_ptr<core::PeerConnection> peerConnection;  // Outlives closeDestination()
+    };
+
+    static std::unique_ptr<core::VideoRtpPacketizer> createVideoPacketizer(
+        VideoCodec codec, const std::vector<uint8_t>& extradata) {
+        switch (codec) {
+            case VideoCodec::VP8:
+                return std::make_unique<core::Vp8RtpPacketizer>();
+            case VideoCodec::VP9:
+                return std::make_unique<core::Vp9RtpPacketizer>();
+            case VideoCodec::AV1:
+                return std::make_unique<core::Av1RtpPacketizer>();
+            default: {
+                auto packetizer = std::make_unique<core::H264RtpPacketizer>();
+                packetizer->setParameterSets(extradata.data(), extradata.size());
+                return packetizer;
+            }
+        }
+    }
+
+    static int64_t steadyNowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void onVideoFeedback(Destination& destination, const core::RtcpFeedback& feedback,
+                         int64_t rttMs) {
+        // Runs on a libdatachannel thread; must not take mutex_, which is held
+        // while the PeerConnection is closed
+        const int64_t nowMs = steadyNowMs();
+        if (keyframeThrottle_ && !feedback.keyframeRequestSsrcs.empty()) {
+            onKeyframeRequest(nowMs);
+        }
+        for (const auto& block : feedback.reportBlocks) {
+            onVideoLossReport(destination, block.fractionLost / 256.0);
+        }
+        if (!bandwidthEstimator_) {
+            return;
+        }
+
+        bool changed = false;
+        for (const auto& block : feedback.reportBlocks) {
+            changed |= bandwidthEstimator_->onReceiverReport(block.fractionLost / 256.0, rttMs, nowMs);
+        }
+        if (feedback.hasRemb) {
+            changed |= bandwidthEstimator_->onRemb(feedback.rembBitrateBps, nowMs);
+        }
+        if (!changed) {
+            return;
+        }
+
+        // Skip changes too small to be worth reconfiguring the encoder for
+        const int target = bandwidthEstimator_->getTargetBitrateKbps();
+        const int current = videoBitrate_.load();
+        if (std::abs(target - current) * 100 <
+            current * core::constants::kBitrateUpdateThresholdPercent) {
+            return;
+        }
+
+        videoBitrate_.store(target);
+        setPacerBitrate(target);
+        if (config_.bitrateCallback) {
+            config_.bitrateCallback(target);
+        }
+    }
+
+    void onVideoLossReport(Destination& destination, double lossRate) {
+        statistics_.updateSendPacketLoss(lossRate * 100.0);
+        if (!config_.enableFec) {
+            return;
+        }
+
+        const double ratio = core::fecProtectionRatioForLoss(
+            lossRate, config_.fecProtectionRatio, config_.maxFecProtectionRatio);
+        if (destination.fecProtectionRatio.exchange(ratio) != ratio) {
+            statistics_.updateFecProtectionRatio(ratio);
+        }
+    }
+
+    void onKeyframeRequest(int64_t nowMs) {
+        // One request per RTCP packet, however many FIR entries named the track
+        statistics_.recordKeyframeRequestReceived();
+        if (keyframeThrottle_->onRequest(nowMs)) {
+            forwardKeyframeRequest();
+        }
+    }
+
+    void pollKeyframeRequest() {
+        if (!keyframeThrottle_ || !active_) {
+            return;
+        }
+
+        // The producer wants a fresh keyframe after shedding a GOP; otherwise
+        // release a request coalesced during the quiet period, unless a
+        // keyframe has gone out since
+        const int64_t nowMs = steadyNowMs();
+        if (congestionKeyframeRequest_.exchange(false, std::memory_order_acquire) &&
+            keyframeThrottle_->onRequest(nowMs)) {
+            forwardKeyframeRequest();
+        } else if (keyframeThrottle_->poll(nowMs)) {
+            forwardKeyframeRequest();
+        }
+    }
+
+    void forwardKeyframeRequest() {
+        if (config_.keyframeRequestCallback()) {
+            statistics_.recordKeyframeRequestForwarded();
+        } else {
+            statistics_.recordKeyframeRequestUnserved();
+        }
+    }
+
+    /**
+     * @brief Decrements a counter when a sendPacket() call returns or throws
+     */
+    class ProducerScope {
+    public:
+        explicit ProducerScope(std::atomic<int>& producers) : producers_(producers) {
+            producers_.fetch_add(1);
+        }
+        ~ProducerScope() { producers_.fetch_sub(1); }
+
+    private:
+        std::atomic<int>& producers_;
+    };
+
+    void wakeSendWorker() {
+        // Pairs with the fence in the worker so a push is never missed by a sleeping worker
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (workerIdle_.load(std::memory_order_relaxed)) {
+            wakeCondition_.notify_one();
+        }
+    }
+
+    core::FrameClass classifyVideoFrame(const EncodedPacket& packet) const {
+        // Only the codec's own headers say which frames nothing refers to; for
+        // VP8/VP9/AV1 every delta counts as a reference frame
+        if (packet.keyframe) {
+            return core::FrameClass::Keyframe;
+        }
+        if (config_.videoCodec == VideoCodec::H264) {
+            return core::classifyH264Frame(packet.payload(), packet.payloadSize());
+        }
+        return core::FrameClass::Reference;
+    }
+
+    bool shedVideoFrame(core::FrameClass frameClass) {
+        const bool drop = dropPolicy_->onVideoFrame(frameClass, sendQueue_->size()) ==
+                          core::FrameDropAction::Drop;
+        takeCongestionKeyframeRequest();
+        return drop;
+    }
+
+    void takeCongestionKeyframeRequest() {
+        // Served by the send thread through the keyframe request throttle
+        if (dropPolicy_->takeKeyframeRequest()) {
+            congestionKeyframeRequest_.store(true, std::memory_order_release);
+        }
+    }
+
+    void handleVideoOverflow(core::FrameClass frameClass) {
+        droppedFrames_.fetch_add(1, std::memory_order_relaxed);
+
+        if (!dropPolicy_) {
+            signalCongestion();
+            return;
+        }
+
+        // Nothing predicts from a disposable frame, so losing it damages no GOP
+        if (frameClass == core::FrameClass::NonReference) {
+            return;
+        }
+
+        // The rest of this GOP (or, for a lost keyframe, the GOP it started) is
+        // undecodable: stop queueing its deltas and ask for a keyframe
+        dropPolicy_->onOverflow();
+        takeCongestionKeyframeRequest();
+
+        // The damaged GOP's deltas still queued would only hold the keyframe
+        // back, so the worker discards them. Earlier GOPs are intact and still
+        // go out; a lost keyframe has nothing queued behind it
+        if (frameClass == core::FrameClass::Reference) {
+            purgeGop_.store(queuedGop_, std::memory_order_release);
+        }
+    }
+
+    void signalCongestion() {
+        if (!congested_.exchange(true, std::memory_order_acq_rel) && config_.congestionCallback) {
+            config_.congestionCallback(getQueuedPacketCount());
+        }
+    }
+
+    void startSendWorker() {
+        if (sendThread_.joinable()) {
+            return;
+        }
+
+        if (dropPolicy_) {
+            dropPolicy_->reset();
+        }
+        queuedGop_ = 0;
+        purgeGop_ = kNoPurge;
+        congestionKeyframeRequest_ = false;
+        workerRunning_ = true;
+        sendThread_ = std::thread([this]() { sendLoop(); });
+    }
+
+    void stopSendWorker() {
+        if (!sendThread_.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            workerRunning_ = false;
+        }
+        wakeCondition_.notify_one();
+        sendThread_.join();
+
+        // Release payload references still queued (e.g. OBS encoder packets)
+        EncodedPacket discarded;
+        while (sendQueue_->tryPop(discarded) || audioQueue_->tryPop(discarded)) {
+        }
+        discarded = EncodedPacket();
+
+        purgeGop_ = kNoPurge;
+        congested_ = false;
+        flushDroppedFrames();
+    }
+
+    void sendLoop() {
+        // Keyframes taken from the video lane so far: the GOP of the next delta
+        uint64_t sentGop = 0;
+
+        while (true) {
+            pollKeyframeRequest();
+
+            // Audio first: it is small, and late audio is heard
+            EncodedPacket packet;
+            if (!audioQueue_->tryPop(packet) && !sendQueue_->tryPop(packet)) {
+                congested_.store(false, std::memory_order_release);
+                flushDroppedFrames();
+
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                if (!workerRunning_) {
+                    break;
+                }
+                workerIdle_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wakeCondition_.wait_for(lock,
+                                        std::chrono::milliseconds(core::constants::kSendWorkerIdleWaitMs),
+                                        [this]() {
+                                            return !workerRunning_ || !sendQueue_->empty() ||
+                                                   !audioQueue_->empty();
+                                        });
+                workerIdle_.store(false, std::memory_order_relaxed);
+                continue;
+            }
+
+            if (packet.type == PacketType::Video) {
+                if (packet.keyframe) {
+                    sentGop++;
+                } else if (sentGop == purgeGop_.load(std::memory_order_acquire)) {
+                    // Belongs to the GOP that lost a reference frame on overflow
+                    statistics_.recordFrameDropped();
+                    continue;
+                }
+            }
+
+            dispatchPacket(packet);
+        }
+    }
+
+    void dispatchPacket(const EncodedPacket& packet) {
+        // Take the connections under the lock and send without it, so one slow
+        // SRTP send does not hold up stop() or the setters
+        sendTargets_.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!active_) {
+                return;
+            }
+            for (auto& destination : destinations_) {
+                if (destination->peerConnection) {
+                    sendTargets_.push_back({destination.get(), destination->peerConnection});
+                }
+            }
+        }
+
+        const bool video = packet.type == PacketType::Video;
+        const core::MediaType mediaType = video ? core::MediaType::Video : core::MediaType::Audio;
+
+        // Packetize once, each destination only writes its RTP headers
+        if (video) {
+            if (!videoPacketizer_->packetize(packet.payload(), packet.payloadSize(), videoFrame_)) {
+                return;
+            }
+            statistics_.recordPayloadCopy(packet.payloadSize());
+        }
+
+        size_t delivered = 0;
+        for (auto& target : sendTargets_) {
+            // A connection closed since the snapshot refuses the frame
+            core::PeerConnection& peerConnection = *target.peerConnection;
+            if (video && config_.enableFec) {
+                const double ratio = target.destination->fecProtectionRatio.load();
+                if (ratio != target.destination->appliedFecProtectionRatio) {
+                    peerConnection.setFecProtectionRatio(ratio);
+                    target.destination->appliedFecProtectionRatio = ratio;
+                }
+            }
+            const bool sent =
+                video ? peerConnection.sendPacketizedFrame(mediaType, videoFrame_, packet.timestamp)
+                      : peerConnection.sendFrame(mediaType, packet.payload(), packet.payloadSize(),
+                                                 packet.timestamp);
+            if (sent) {
+                // Each transport takes its own copy of the frame (SRTP encrypts in
+                // place); these are the only other payload copies to the wire
+                statistics_.recordPayloadCopy(packet.payloadSize());
+                statistics_.recordBytesSent(packet.payloadSize());
+                delivered++;
+            }
+        }
+
+        sendTargets_.clear();  // Don't keep closed connections alive until the next packet
+
+        if (delivered > 0 && video) {
+            statistics_.recordFrameSent();
+            if (keyframeThrottle_ && packet.keyframe) {
+                keyframeThrottle_->onKeyframeSent(steadyNowMs());
+            }
+            if (bandwidthEstimator_) {
+                bandwidthEstimator_->onPacketSent(packet.payloadSize(), steadyNowMs());
+            }
+        }
+    }
+
+    void flushDroppedFrames() const {
+        uint64_t dropped = droppedFrames_.exchange(0, std::memory_order_relaxed);
+        while (dropped-- > 0) {
+            statistics_.recordFrameDropped();
+        }
+    }
+
+    void addSendTracks(core::PeerConnection& peerConnection) {
+        std::random_device rd;
+        std::uniform_int_distribution<uint32_t> ssrcDist(1, 0xFFFFFFFF);
+
+        core::MediaTrackConfig video;
+        video.type = core::MediaType::Video;
+        switch (config_.videoCodec) {
+            case VideoCodec::VP8:
+                video.codec = core::MediaCodec::VP8;
+                break;
+            case VideoCodec::VP9:
+                video.codec = core::MediaCodec::VP9;
+                break;
+            case VideoCodec::AV1:
+                video.codec = core::MediaCodec::AV1;
+                break;
+            default:
+                video.codec = core::MediaCodec::H264;
+                break;
+        }
+        video.mid = "video";
+        video.ssrc = ssrcDist(rd);
+        video.payloadType = core::constants::kDefaultVideoPayloadType;
+        video.prepacketized = true;
+        video.extradata = config_.videoExtraData;
+        if (config_.enableRtx) {
+            do {
+                video.rtxSsrc = ssrcDist(rd);
+            } while (video.rtxSsrc == video.ssrc);
+            video.rtxPayloadType = core::constants::kDefaultRtxPayloadType;
+            // Cover the window at the highest bitrate this connection may reach
+            video.rtxHistory.windowMs = config_.rtxHistoryMs;
+            video.rtxHistory.maxBitrateKbps = std::max(
+                videoBitrate_.load(), config_.enableAdaptiveBitrate ? config_.maxVideoBitrate : 0);
+        }
+        if (config_.enableFec) {
+            do {
+                video.fecSsrc = ssrcDist(rd);
+            } while (video.fecSsrc == video.ssrc || video.fecSsrc == video.rtxSsrc);
+            video.fecPayloadType = core::constants::kDefaultFecPayloadType;
+            video.fecProtectionRatio = config_.fecProtectionRatio;
+        }
+        peerConnection.addTrack(video);
+
+        // WebRTC has no AAC payload format; OBS only hands us Opus (encoded_audio_codecs)
+        if (config_.audioCodec == AudioCodec::Opus) {
+            core::MediaTrackConfig audio;
+            audio.type = core::MediaType::Audio;
+            audio.codec = core::MediaCodec::Opus;
+            audio.mid = "audio";
+            audio.ssrc = ssrcDist(rd);
+            audio.payloadType = core::constants::kDefaultAudioPayloadType;
+            peerConnection.addTrack(audio);
+        }
+    }
+
+    void connectDestination(Destination& destination) {
+        Destination* target = &destination;
+
+        // Create WHIP client configuration
+        core::WHIPConfig whipConfig;
+        whipConfig.url = destination.url;
+        whipConfig.onConnected = [this]() {
+            if (config_.stateCallback) {
+                config_.stateCallback(true);
+            }
+        };
+        whipConfig.onDisconnected = [this, target]() {
+            target->connected = false;
+            if (anyDestinationConnected()) {
+                return;  // Other destinations keep the output alive
+            }
+            if (config_.stateCallback) {
+                config_.stateCallback(false);
+            }
+            active_ = false;
+        };
+        whipConfig.onError = [this, target](const std::string& error) {
+            reportError(*target, error);
+        };
+
+        // Create WHIP client
+        destination.whipClient = std::make_unique<core::WHIPClient>(whipConfig);
+
+        // Create peer connection configuration
+        core::PeerConnectionConfig pcConfig;
+        pcConfig.iceServers = {"stun:stun.l.google.com:19302"};
+        pcConfig.pacer = destination.pacer;
+        pcConfig.statistics = &statistics_;
+        if (bandwidthEstimator_ || keyframeThrottle_ || config_.enableFec) {
+            // Every destination reports to the one estimator and throttle, so the
+            // shared encoder follows the most constrained link and serves the
+            // receivers' keyframe requests together; FEC follows each link's loss
+            pcConfig.rtcpFeedbackCallback = [this, target](core::MediaType type,
+                                                           const core::RtcpFeedback& feedback,
+                                                           int64_t rttMs) {
+                if (type == core::MediaType::Video) {
+                    onVideoFeedback(*target, feedback, rttMs);
+                }
+            };
+        }
+        // Runs on libdatachannel's thread: the POST goes to the WHIP client's
+        // worker so ICE gathering carries on while the answer is in flight.
+        // closeDestination() stops that worker before the peer connection goes.
+        pcConfig.localDescriptionCallback = [this, target](core::SdpType type, const std::string& sdp) {
+            if (type == core::SdpType::Offer && target->whipClient) {
+                try {
+                    target->whipClient->sendOfferAsync(sdp, [this, target](const std::string& answer) {
+                        if (!target->peerConnection) {
+                            return;
+                        }
+                        try {
+                            target->peerConnection->setRemoteDescription(core::SdpType::Answer, answer);
+                        } catch (const std::exception& e) {
+                            reportError(*target, std::string("Failed to apply answer: ") + e.what());
+                        }
+                    });
+                } catch (const std::exception& e) {
+                    reportError(*target, std::string("Failed to send offer: ") + e.what());
+                }
+            }
+        };
+        // Queued behind the offer, so candidates gathered during the POST are
+        // trickled once the resource URL is known instead of being lost
+        pcConfig.iceCandidateCallback = [target](const std::string& candidate, const std::string& mid) {
+            if (target->whipClient) {
+                try {
+                    target->whipClient->sendIceCandidateAsync(candidate, mid);
+                } catch (const std::exception& e) {
+                    // Ignore ICE candidate errors (non-critical)
+                }
+            }
+        };
+        pcConfig.stateCallback = [this, target](core::ConnectionState state) {
+            if (state == core::ConnectionState::Connected || state == core::ConnectionState::Completed) {
+                target->connected = true;
+                active_ = true;
+                if (config_.stateCallback) {
+                    config_.stateCallback(true);
+                }
+                // Reset reconnection manager on successful connection
+                if (reconnectionManager_) {
+                    reconnectionManager_->onConnectionSuccess();
+                }
+            } else if (state == core::ConnectionState::Failed || state == core::ConnectionState::Disconnected) {
+                target->connected = false;
+                if (anyDestinationConnected()) {
+                    return;  // Other destinations keep the output alive
+                }
+                active_ = false;
+                if (config_.stateCallback) {
+                    config_.stateCallback(false);
+                }
+                // Schedule reconnection once every destination is down
+                if (reconnectionManager_ && config_.enableAutoReconnect) {
+                    reconnectionManager_->scheduleReconnect();
+                }
+            }
+        };
+
+        // Create peer connection; FEC starts again from the base ratio
+        destination.fecProtectionRatio = config_.fecProtectionRatio;
+        destination.appliedFecProtectionRatio = config_.fecProtectionRatio;
+        destination.peerConnection = std::make_shared<core::PeerConnection>(pcConfig);
+
+        // Send tracks must exist before the offer is generated
+        addSendTracks(*destination.peerConnection);
+
+        // Create offer to initiate connection
+        destination.peerConnection->createOffer();
+    }
+
+    void closeDestination(Destination& destination) {
+        destination.connected = false;
+
+        // Close WHIP client
+        if (destination.whipClient) {
+            destination.whipClient->disconnect();
+            destination.whipClient.reset();
+        }
+
+        // Close peer connection
+        if (destination.peerConnection) {
+            destination.peerConnection->close();
+            destination.peerConnection.reset();
+        }
+    }
+
+    bool anyDestinationConnected() const {
+        return std::any_of(destinations_.begin(), destinations_.end(),
+                           [](const std::unique_ptr<Destination>& destination) {
+                               return destination->connected.load();
+                           });
+    }
+
+    void reportError(const Destination& destination, const std::string& error) {
+        if (!config_.errorCallback) {
+            return;
+        }
+        // Name the endpoint when there is more than one
+        config_.errorCallback(destinations_.size() > 1 ? destination.url + ": " + error : error);
+    }
+
+    void setPacerBitrate(int bitrateKbps) {
+        for (auto& destination : destinations_) {
+            if (destination->pacer) {
+                destination->pacer->setTargetBitrate(bitrateKbps);
+            }
+        }
+    }
+
     void attemptReconnect() {
         std::lock_guard<std::mutex> lock(mutex_);
 
         // Clean up existing connections
-        if (whipClient_) {
-            whipClient_->disconnect();
-            whipClient_.reset();
-        }
-        if (peerConnection_) {
-            peerConnection_->close();
-            peerConnection_.reset();
+        for (auto& destination : destinations_) {
+            closeDestination(*destination);
         }
 
         // Attempt to start again
@@ -239,14 +888,36 @@ private:
     }
 
     WebRTCOutputConfig config_;
-    std::unique_ptr<core::WHIPClient> whipClient_;
-    std::unique_ptr<core::PeerConnection> peerConnection_;
+    std::vector<std::unique_ptr<Destination>> destinations_;  // Fixed after construction
     std::unique_ptr<core::ReconnectionManager> reconnectionManager_;
-    bool active_;
+    std::atomic<bool> active_;
     bool starting_;
-    int videoBitrate_;
+    std::atomic<int> videoBitrate_;  // Also updated from RTCP feedback without mutex_
     int audioBitrate_;
+    mutable core::NetworkStatisticsCollector statistics_;  // Internally synchronized
+    std::unique_ptr<core::BandwidthEstimator> bandwidthEstimator_;  // Internally synchronized
+    std::unique_ptr<core::KeyframeRequestThrottle> keyframeThrottle_;  // Internally synchronized
+    std::unique_ptr<core::VideoRtpPacketizer> videoPacketizer_;  // Send thread only
+    core::PacketizedFrame videoFrame_;                           // Reused; send thread only
+    std::vector<SendTarget> sendTargets_;                        // Reused; send thread only
     mutable std::mutex mutex_;
+
+    // Send pipeline: sendPacket() produces, sendThread_ consumes
+    static constexpr uint64_t kNoPurge = UINT64_MAX;
+    std::unique_ptr<core::SpscRing<EncodedPacket>> sendQueue_;   // Video
+    std::unique_ptr<core::SpscRing<EncodedPacket>> audioQueue_;  // Never shed for video
+    std::thread sendThread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    bool workerRunning_ = false;                    // Guarded by wakeMutex_
+    std::atomic<bool> workerIdle_{false};
+    std::atomic<int> producers_{0};                 // sendPacket() calls in progress
+    uint64_t queuedGop_ = 0;                        // Keyframes queued; producer thread only
+    std::atomic<uint64_t> purgeGop_{kNoPurge};      // GOP whose queued deltas are discarded
+    std::atomic<bool> congested_{false};            // Overflow episode under SignalCongestion
+    std::atomic<bool> congestionKeyframeRequest_{false};  // Raised by dropPolicy_ for the worker
+    std::unique_ptr<core::FrameDropPolicy> dropPolicy_;   // DropNonKeyframes; producer thread only
+    mutable std::atomic<uint64_t> droppedFrames_{0};  // Drops not yet folded into statistics_
 };
 
 // WebRTCOutput public interface implementation
@@ -269,7 +940,15 @@ bool WebRTCOutput::isActive() const {
 }
 
 void WebRTCOutput::sendPacket(const EncodedPacket& packet) {
-    impl_->sendPacket(packet);
+    impl_->sendPacket(EncodedPacket(packet));
+}
+
+void WebRTCOutput::sendPacket(EncodedPacket&& packet) {
+    impl_->sendPacket(std::move(packet));
+}
+
+size_t WebRTCOutput::getQueuedPacketCount() const {
+    return impl_->getQueuedPacketCount();
 }
 
 int WebRTCOutput::getVideoBitrate() const {
@@ -288,5 +967,9 @@ void WebRTCOutput::setAudioBitrate(int bitrate) {
     impl_->setAudioBitrate(bitrate);
 }
 
+core::NetworkStats WebRTCOutput::getStatistics() const {
+    return impl_->getStatistics();
+}
+
 } // namespace output
 } // namespace obswebrtc
@@ -9,6 +9,8 @@
 #pragma once
 
 #include "core/whip-client.hpp"
+#include "core/network-statistics.hpp"
+#include "core/constants.hpp"
 #include <functional>
 #include <memory>
 #include <string>
@@ -46,12 +48,39 @@ enum class PacketType {
 
 /**
  * @brief Encoded packet data
+ *
+ * The payload is either owned (`data`) or a refcounted view (`buffer`) into
+ * memory owned elsewhere, e.g. an OBS encoder packet kept alive with
+ * obs_encoder_packet_ref(). The view is released through its deleter when
+ * the last copy of the packet is destroyed, so packets can be handed between
+ * threads without copying the payload. When set, `buffer` takes precedence.
  */
 struct EncodedPacket {
     PacketType type;
-    std::vector<uint8_t> data;
-    int64_t timestamp;
+    std::vector<uint8_t> data;              // Annex-B access unit (video) or Opus frame (audio)
+    std::shared_ptr<const uint8_t> buffer;  // Refcounted payload view (optional)
+    size_t bufferSize = 0;                  // Size of the payload view in bytes
+    int64_t timestamp;                      // Presentation timestamp in microseconds
     bool keyframe;
+
+    /**
+     * @brief Get the payload bytes, whichever storage holds them
+     */
+    const uint8_t* payload() const { return buffer ? buffer.get() : data.data(); }
+
+    /**
+     * @brief Get the payload size in bytes
+     */
+    size_t payloadSize() const { return buffer ? bufferSize : data.size(); }
+};
+
+/**
+ * @brief What to do with packets when the send queue is full
+ */
+enum class SendQueueOverflowPolicy {
+    DropNonKeyframes,  ///< Shed video in stages as the queue fills (see WebRTCOutputConfig);
+                       ///< on overflow purge the queued rest of the damaged GOP
+    SignalCongestion   ///< Drop the incoming packet and report congestion
 };
 
 /**
@@ -64,13 +93,51 @@ using ErrorCallback = std::function<void(const std::string& error)>;
  */
 using StateCallback = std::function<void(bool active)>;
 
+/**
+ * @brief Congestion callback
+ *
+ * Called once per overflow episode on the thread calling sendPacket(), so it
+ * must return quickly. The episode ends when the send queue drains.
+ */
+using CongestionCallback = std::function<void(size_t queuedPackets)>;
+
+/**
+ * @brief Bitrate callback
+ *
+ * Called when adaptive bitrate picks a new video bitrate. Runs on a network
+ * thread; the encoder should be reconfigured to the new target.
+ */
+using BitrateCallback = std::function<void(int bitrateKbps)>;
+
+/**
+ * @brief Keyframe request callback
+ *
+ * Called when a receiver asked for a keyframe (RTCP PLI/FIR), at most once
+ * per minKeyframeRequestIntervalMs. Runs on a network thread; the encoder
+ * should produce an IDR as soon as it can. Returns false when the encoder
+ * cannot be made to emit one, so the request is left to the next scheduled
+ * keyframe (counted in keyframeRequestsUnserved rather than as forwarded).
+ */
+using KeyframeRequestCallback = std::function<bool()>;
+
 /**
  * @brief Configuration for WebRTC Output
  */
 struct WebRTCOutputConfig {
     std::string serverUrl;
+
+    // Fan-out: further WHIP endpoints that receive the same stream. Video is
+    // packetized once and every destination only adds its own RTP header
+    // (SSRC, sequence number, timestamp) and SRTP.
+    std::vector<std::string> additionalServerUrls;
+
     VideoCodec videoCodec = VideoCodec::H264;
     AudioCodec audioCodec = AudioCodec::Opus;
+
+    // H.264 encoder extradata (obs_encoder_get_extra_data, Annex-B or avcC).
+    // Its SPS/PPS, or newer in-band ones, are repeated as a STAP-A ahead of
+    // every IDR sent without them, so late subscribers can start decoding
+    std::vector<uint8_t> videoExtraData;
     int videoBitrate = 2500;  // kbps
     int audioBitrate = 128;   // kbps
     ErrorCallback errorCallback;
@@ -81,6 +148,46 @@ struct WebRTCOutputConfig {
     int maxReconnectRetries = 5;
     int reconnectInitialDelayMs = 1000;
     int reconnectMaxDelayMs = 30000;
+
+    // Send queue settings (encoder thread -> network send thread)
+    size_t sendQueueDepth = core::constants::kDefaultSendQueueDepth;  // Video packets
+    SendQueueOverflowPolicy overflowPolicy = SendQueueOverflowPolicy::DropNonKeyframes;
+    CongestionCallback congestionCallback;
+
+    // Congestion-aware dropping under DropNonKeyframes, as fractions of
+    // sendQueueDepth: above the first, disposable (nal_ref_idc == 0) H.264
+    // frames are dropped; above the second, the rest of the GOP, followed by a
+    // keyframe request through keyframeRequestCallback once the queue drains
+    double nonReferenceDropThreshold = core::constants::kDefaultNonReferenceDropThreshold;
+    double gopDropThreshold = core::constants::kDefaultGopDropThreshold;
+
+    // Pacing settings (outgoing RTP spread at videoBitrate * pacingMultiplier)
+    bool enablePacing = true;
+    double pacingMultiplier = core::constants::kDefaultPacingMultiplier;
+    // Release tick: packets due within it reach the transport together (0 = per packet)
+    int pacingBatchIntervalMs = core::constants::kDefaultPacerBatchIntervalMs;
+
+    // Adaptive bitrate (opt-in; RTCP feedback moves videoBitrate within [min, max])
+    bool enableAdaptiveBitrate = false;
+    int minVideoBitrate = core::constants::kMinVideoBitrateKbps;  // kbps
+    int maxVideoBitrate = 5000;                                   // kbps
+    BitrateCallback bitrateCallback;
+
+    // NACK retransmission: video packets are kept for rtxHistoryMs and resent
+    // on an RTX stream when a receiver reports them lost
+    bool enableRtx = true;
+    int rtxHistoryMs = core::constants::kDefaultRtxHistoryMs;
+
+    // Forward error correction: video is followed by FlexFEC packets, at
+    // fecProtectionRatio FEC packets per media packet on a clean link, rising
+    // with the loss each receiver reports up to maxFecProtectionRatio
+    bool enableFec = false;
+    double fecProtectionRatio = core::constants::kDefaultFecProtectionRatio;
+    double maxFecProtectionRatio = core::constants::kDefaultMaxFecProtectionRatio;
+
+    // Keyframe requests (PLI/FIR from any destination, coalesced and rate limited)
+    KeyframeRequestCallback keyframeRequestCallback;
+    int minKeyframeRequestIntervalMs = core::constants::kDefaultKeyframeRequestIntervalMs;
 };
 
 /**
@@ -97,6 +204,19 @@ struct WebRTCOutputConfig {
  * - Bitrate and framerate configuration
  * - Connection state monitoring
  * - Error handling and logging
+ * - Non-blocking sendPacket(): packets are queued on a lock-free ring and
+ *   sent from a dedicated network thread
+ * - Token-bucket pacing of outgoing RTP with an audio priority lane
+ * - Adaptive video bitrate from RTCP receiver reports and REMB
+ * - Rate-limited forwarding of receiver keyframe requests (PLI/FIR)
+ * - NACK-based recovery: lost video packets are resent over RTX from a
+ *   bounded history
+ * - Optional FlexFEC with a protection ratio that follows reported loss
+ * - SPS/PPS repeated ahead of every H.264 IDR that lacks them, from the
+ *   encoder extradata or the last in-band parameter sets
+ * - Fan-out to several WHIP endpoints from one encoder and one
+ *   packetization pass; the output stays active while any endpoint is
+ *   connected
  *
  * Example usage:
  * @code
@@ -171,11 +291,33 @@ public:
 
     /**
      * @brief Send an encoded packet
+     *
+     * The packet is queued for the send thread and the call returns without
+     * waiting on the network. When the queue is full the configured
+     * SendQueueOverflowPolicy decides which packets are dropped. Only one
+     * thread may call sendPacket() at a time.
+     *
      * @param packet Encoded video or audio packet
-     * @throws std::runtime_error if output is not active
+     * @throws std::runtime_error if output is not active or the packet is empty
      */
     void sendPacket(const EncodedPacket& packet);
 
+    /**
+     * @brief Send an encoded packet, taking ownership of its payload
+     *
+     * Same as sendPacket(const EncodedPacket&) without copying owned `data`.
+     *
+     * @param packet Encoded video or audio packet
+     * @throws std::runtime_error if output is not active or the packet is empty
+     */
+    void sendPacket(EncodedPacket&& packet);
+
+    /**
+     * @brief Get the number of packets waiting for the send thread
+     * @return Approximate send queue depth in packets
+     */
+    size_t getQueuedPacketCount() const;
+
     /**
      * @brief Get video bitrate
      * @return Video bitrate in kbps
@@ -190,6 +332,10 @@ public:
 
     /**
      * @brief Set video bitrate
+     *
+     * Also retargets the pacer when pacing is enabled. With adaptive bitrate
+     * enabled, later RTCP feedback may replace this value.
+     *
      * @param bitrate Video bitrate in kbps
      */
     void setVideoBitrate(int bitrate);
@@ -200,6 +346,16 @@ public:
      */
     void setAudioBitrate(int bitrate);
 
+    /**
+     * @brief Get send statistics
+     *
+     * Rates (bitrate, payload copies per second) and pacer queue delay/burst
+     * metrics are calculated over the interval since the previous call.
+     *
+     * @return Snapshot of the output's network statistics
+     */
+    core::NetworkStats getStatistics() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
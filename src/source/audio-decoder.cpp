@@ -0,0 +1,420 @@
+/**
+ * @file audio-decoder.cpp
+ * @brief libopus implementation of the receive-side audio decoder
+ */
+
+#include "audio-decoder.hpp"
+
+#include <opus.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace obswebrtc {
+namespace source {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const AudioDecoderConfig& validate(const AudioDecoderConfig& config)
+{
+    if (!config.frameCallback) {
+        throw std::invalid_argument("Audio decoder needs a frame callback");
+    }
+    if (config.queueFrames == 0) {
+        throw std::invalid_argument("Audio decoder queue must hold at least one frame");
+    }
+    if (config.channels == 0 || config.channels > core::constants::kMaxAudioDecoderChannels) {
+        throw std::invalid_argument("Audio decoder supports mono and stereo output only");
+    }
+    switch (config.sampleRate) {
+        case 8000:
+        case 12000:
+        case 16000:
+        case 24000:
+        case 48000:
+            break;
+        default:
+            throw std::invalid_argument("Opus cannot decode at " +
+                                        std::to_string(config.sampleRate) + " Hz");
+    }
+    if (config.maxConcealMs < 0) {
+        throw std::invalid_argument("Audio concealment limit cannot be negative");
+    }
+    return config;
+}
+
+}  // namespace
+
+/**
+ * @brief Private implementation of AudioDecoder
+ */
+class AudioDecoder::Impl {
+public:
+    explicit Impl(const AudioDecoderConfig& config)
+        : config_(validate(config))
+        , queue_(config.queueFrames)
+        , ticksPerSample_(core::constants::kOpusRtpClockRate / config.sampleRate)
+        , maxPacketSamples_(config.sampleRate * core::constants::kMaxOpusPacketMs / 1000)
+        , maxConcealTicks_(static_cast<int64_t>(config.maxConcealMs) *
+                           core::constants::kOpusRtpClockRate / 1000)
+        , interleaved_(static_cast<size_t>(maxPacketSamples_) * config.channels)
+        , planar_(static_cast<size_t>(maxPacketSamples_) * config.channels)
+        , channels_(config.channels)
+    {
+        // Sized for the most channels, so a mono stream can reinitialise it in place
+        int error = OPUS_OK;
+        decoder_ = opus_decoder_create(static_cast<opus_int32>(config_.sampleRate),
+                                       static_cast<int>(config_.channels), &error);
+        if (!decoder_ || error != OPUS_OK) {
+            throw std::runtime_error(std::string("Failed to create the Opus decoder: ") +
+                                     opus_strerror(error));
+        }
+
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    ~Impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            stopping_ = true;
+        }
+        wakeCondition_.notify_one();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        opus_decoder_destroy(decoder_);
+    }
+
+    void decode(const AudioFrame& frame)
+    {
+        queue_.push(frame);
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            pending_ = true;
+        }
+        wakeCondition_.notify_one();
+    }
+
+    void reset()
+    {
+        {
+            // Under the wake lock, so the thread cannot pop a packet queued
+            // after the reset before it has seen the reset
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            queue_.clear();
+            resetRequested_ = true;
+            pending_ = true;
+        }
+        wakeCondition_.notify_one();
+    }
+
+    AudioDecoderStats getStats() const
+    {
+        AudioDecoderStats stats;
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats = stats_;
+            if (stats.packetsDecoded > 0) {
+                stats.averageDecodeUs = totalDecodeUs_ / static_cast<double>(stats.packetsDecoded);
+            }
+            if (stats.samplesDecoded > 0) {
+                const double audioUs = static_cast<double>(stats.samplesDecoded) * 1e6 /
+                                       static_cast<double>(config_.sampleRate);
+                stats.cpuLoad = totalDecodeUs_ / audioUs;
+            }
+        }
+        stats.queue = queue_.getStats();
+        return stats;
+    }
+
+private:
+    void run()
+    {
+        AudioFrame frame;
+        while (true) {
+            bool flush = false;
+            bool popped = false;
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                wakeCondition_.wait(lock, [this]() { return pending_ || stopping_; });
+                if (stopping_) {
+                    return;
+                }
+                flush = resetRequested_;
+                resetRequested_ = false;
+                popped = queue_.pop(frame);
+                pending_ = popped;
+            }
+
+            if (flush) {
+                opus_decoder_ctl(decoder_, OPUS_RESET_STATE);
+                haveTimestamp_ = false;
+            }
+            if (popped) {
+                decodeOne(frame);
+                frame.data = core::BufferSlice();  // Back to the pool now
+            }
+        }
+    }
+
+    void decodeOne(const AudioFrame& frame)
+    {
+        const unsigned char* data = frame.data.data();
+        const opus_int32 size = static_cast<opus_int32>(frame.data.size());
+        if (size == 0) {
+            return;
+        }
+
+        // 0 when the channel count was not negotiated
+        const uint32_t channels =
+            frame.channels == 0 ? config_.channels : std::min(frame.channels, config_.channels);
+        if (channels != channels_ && !setChannels(channels)) {
+            return;
+        }
+
+        packetDecodeUs_ = 0.0;
+        const int64_t ticks = unwrapTimestamp(static_cast<uint32_t>(frame.timestamp));
+        if (haveEnd_) {
+            const int64_t gap = ticks - endTicks_;
+            if (gap < 0) {
+                return;  // Duplicate or older than what was already played
+            }
+            if (gap > maxConcealTicks_) {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                stats_.discontinuities++;
+            } else if (gap > 0) {
+                conceal(gap, data, size);
+            }
+        }
+
+        const int samples = decodeTimed(data, size, maxPacketSamples_, 0);
+        if (samples < 0) {
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                stats_.decodeErrors++;
+            }
+            reportError(std::string("Opus decoding failed: ") + opus_strerror(samples));
+            return;
+        }
+
+        lastPacketSamples_ = samples;
+        endTicks_ = ticks + static_cast<int64_t>(samples) * ticksPerSample_;
+        haveEnd_ = true;
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats_.packetsDecoded++;
+            stats_.lastDecodeUs = packetDecodeUs_;
+            stats_.maxDecodeUs = std::max(stats_.maxDecodeUs, packetDecodeUs_);
+            totalDecodeUs_ += packetDecodeUs_;
+        }
+        deliver(samples, ticks, false);
+    }
+
+    /**
+     * @brief Reinitialise the decoder for another channel count
+     *
+     * The decoder state is lost, so nothing is concealed across the change.
+     */
+    bool setChannels(uint32_t channels)
+    {
+        const int error = opus_decoder_init(decoder_, static_cast<opus_int32>(config_.sampleRate),
+                                            static_cast<int>(channels));
+        if (error != OPUS_OK) {
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                stats_.decodeErrors++;
+            }
+            reportError(std::string("Failed to reinitialise the Opus decoder: ") +
+                        opus_strerror(error));
+            return false;
+        }
+        channels_ = channels;
+        haveEnd_ = false;
+        return true;
+    }
+
+    /**
+     * @brief Fill @p gapTicks of lost audio before the packet in @p data
+     */
+    void conceal(int64_t gapTicks, const unsigned char* data, opus_int32 size)
+    {
+        const int gapSamples = static_cast<int>(gapTicks / ticksPerSample_);
+
+        // The packet's LBRR data, if any, is a low-bitrate copy of the frame
+        // just before it: decode that last, from the packet itself
+        int fecSamples = 0;
+        if (opus_packet_has_lbrr(data, size) == 1) {
+            const int frameSamples = opus_packet_get_samples_per_frame(
+                data, static_cast<opus_int32>(config_.sampleRate));
+            if (frameSamples <= gapSamples) {
+                fecSamples = frameSamples;
+            }
+        }
+
+        // PLC in steps of the last packet's duration, whole 2.5 ms units only
+        const int unit = static_cast<int>(config_.sampleRate / 400);
+        int64_t position = endTicks_;
+        int plcSamples = (gapSamples - fecSamples) / unit * unit;
+        while (plcSamples > 0) {
+            const int step = std::min({plcSamples, lastPacketSamples_, maxPacketSamples_});
+            const int samples = decodeTimed(nullptr, 0, step, 0);
+            if (samples <= 0) {
+                break;
+            }
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                stats_.packetsConcealed++;
+            }
+            deliver(samples, position, true);
+            position += static_cast<int64_t>(samples) * ticksPerSample_;
+            plcSamples -= samples;
+        }
+
+        if (fecSamples > 0) {
+            position = endTicks_ + gapTicks - static_cast<int64_t>(fecSamples) * ticksPerSample_;
+            const int samples = decodeTimed(data, size, fecSamples, 1);
+            if (samples > 0) {
+                {
+                    std::lock_guard<std::mutex> lock(statsMutex_);
+                    stats_.packetsRecovered++;
+                }
+                deliver(samples, position, true);
+            }
+        }
+    }
+
+    /**
+     * @brief opus_decode_float(), timed into the current packet's decode time
+     */
+    int decodeTimed(const unsigned char* data, opus_int32 size, int frameSize, int fec)
+    {
+        const Clock::time_point start = Clock::now();
+        const int samples =
+            opus_decode_float(decoder_, data, size, interleaved_.data(), frameSize, fec);
+        packetDecodeUs_ += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        return samples;
+    }
+
+    void deliver(int samples, int64_t ticks, bool concealed)
+    {
+        DecodedAudioFrame decoded;
+        decoded.frames = static_cast<uint32_t>(samples);
+        decoded.channels = channels_;
+        decoded.sampleRate = config_.sampleRate;
+        decoded.timestampNs = toNanoseconds(ticks);
+        decoded.concealed = concealed;
+
+        // libopus only writes interleaved samples; mono is already planar
+        if (channels_ == 1) {
+            decoded.planes[0] = interleaved_.data();
+        } else {
+            const size_t channels = channels_;
+            for (size_t channel = 0; channel < channels; channel++) {
+                float* plane = planar_.data() + channel * static_cast<size_t>(maxPacketSamples_);
+                const float* source = interleaved_.data() + channel;
+                for (int sample = 0; sample < samples; sample++) {
+                    plane[sample] = source[static_cast<size_t>(sample) * channels];
+                }
+                decoded.planes[channel] = plane;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats_.samplesDecoded += static_cast<uint64_t>(samples);
+            stats_.channels = channels_;
+        }
+        config_.frameCallback(decoded);
+    }
+
+    int64_t unwrapTimestamp(uint32_t rtpTimestamp)
+    {
+        if (!haveTimestamp_) {
+            extendedTimestamp_ = rtpTimestamp;
+            haveTimestamp_ = true;
+            haveEnd_ = false;
+        } else {
+            extendedTimestamp_ += static_cast<int32_t>(rtpTimestamp - lastRtpTimestamp_);
+        }
+        lastRtpTimestamp_ = rtpTimestamp;
+        return extendedTimestamp_;
+    }
+
+    static uint64_t toNanoseconds(int64_t ticks)
+    {
+        const uint64_t clamped = static_cast<uint64_t>(std::max<int64_t>(ticks, 0));
+        const uint64_t clockRate = core::constants::kOpusRtpClockRate;
+        return clamped / clockRate * 1000000000ULL +
+               clamped % clockRate * 1000000000ULL / clockRate;
+    }
+
+    void reportError(const std::string& message)
+    {
+        if (config_.errorCallback) {
+            config_.errorCallback(message);
+        }
+    }
+
+    AudioDecoderConfig config_;
+    core::FrameQueue<AudioFrame> queue_;
+
+    // Decoder state, owned by the decoder thread once it runs
+    OpusDecoder* decoder_ = nullptr;
+    const int64_t ticksPerSample_;
+    const int maxPacketSamples_;
+    const int64_t maxConcealTicks_;
+    std::vector<float> interleaved_;  // Decoder output, one packet at most
+    std::vector<float> planar_;       // Handed out, one plane after another
+    uint32_t channels_;               // Currently decoded; up to config_.channels
+    int lastPacketSamples_ = 0;
+    double packetDecodeUs_ = 0.0;  // libopus time for the packet being decoded
+    bool haveTimestamp_ = false;
+    uint32_t lastRtpTimestamp_ = 0;
+    int64_t extendedTimestamp_ = 0;
+    bool haveEnd_ = false;
+    int64_t endTicks_ = 0;  // RTP time where the last decoded packet ended
+
+    std::thread thread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    bool pending_ = false;
+    bool resetRequested_ = false;
+    bool stopping_ = false;
+
+    mutable std::mutex statsMutex_;
+    AudioDecoderStats stats_;
+    double totalDecodeUs_ = 0.0;
+};
+
+AudioDecoder::AudioDecoder(const AudioDecoderConfig& config)
+    : pImpl(std::make_unique<Impl>(config))
+{
+}
+
+AudioDecoder::~AudioDecoder() = default;
+
+void AudioDecoder::decode(const AudioFrame& frame)
+{
+    pImpl->decode(frame);
+}
+
+void AudioDecoder::reset()
+{
+    pImpl->reset();
+}
+
+AudioDecoderStats AudioDecoder::getStats() const
+{
+    return pImpl->getStats();
+}
+
+}  // namespace source
+}  // namespace obswebrtc
@@ -0,0 +1,155 @@
+/**
+ * @file audio-decoder.hpp
+ * @brief Opus decoding stage for the receive side
+ *
+ * This module provides:
+ * - A decoder thread that turns received Opus packets into planar float
+ *   samples using libopus, in buffers allocated once
+ * - Loss concealment: gaps in the RTP timestamps are filled from the next
+ *   packet's in-band FEC when it carries it, and by Opus PLC otherwise
+ * - Decode CPU instrumentation, as time per packet and as a share of real time
+ */
+
+#pragma once
+
+#include "webrtc-source.hpp"
+#include "core/constants.hpp"
+#include "core/frame-queue.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace obswebrtc {
+namespace source {
+
+/**
+ * @brief Decoded samples for one received (or concealed) packet
+ *
+ * The planes belong to the decoder and are only valid during the callback;
+ * consumers that keep the samples must copy them (obs_source_output_audio does).
+ */
+struct DecodedAudioFrame {
+    const float* planes[core::constants::kMaxAudioDecoderChannels] = {};
+    uint32_t frames = 0;      // Samples per channel
+    uint32_t channels = 0;
+    uint32_t sampleRate = 0;
+    uint64_t timestampNs = 0;  // Unwrapped from the RTP timestamp
+    bool concealed = false;    // Synthesised for lost packets (PLC or FEC)
+};
+
+/**
+ * @brief Configuration for AudioDecoder
+ */
+struct AudioDecoderConfig {
+    // Output rate; 8, 12, 16, 24 or 48 kHz. RTP timestamps are at 48 kHz regardless
+    uint32_t sampleRate = core::constants::kDefaultAudioSampleRate;
+    // Most channels decoded, 1 or 2. Streams negotiated as mono (AudioFrame::channels)
+    // decode as mono, at about half the cost
+    uint32_t channels = core::constants::kDefaultAudioChannels;
+    size_t queueFrames = core::constants::kDefaultSourceAudioQueueFrames;
+    // Longest gap filled with concealment; after longer outages the stream resumes at
+    // the next packet's timestamp instead
+    int maxConcealMs = core::constants::kDefaultAudioMaxConcealMs;
+
+    // Called on the decoder thread for every decoded or concealed packet
+    std::function<void(const DecodedAudioFrame&)> frameCallback;
+    // Called on the decoder thread when the decoder rejects input
+    std::function<void(const std::string&)> errorCallback;
+};
+
+/**
+ * @brief Counters for an AudioDecoder
+ */
+struct AudioDecoderStats {
+    uint64_t packetsDecoded = 0;
+    uint64_t decodeErrors = 0;
+    uint64_t packetsConcealed = 0;   // Lost packets filled by PLC
+    uint64_t packetsRecovered = 0;   // Lost packets rebuilt from in-band FEC
+    uint64_t samplesDecoded = 0;     // Per channel, concealment included
+    uint64_t discontinuities = 0;    // Gaps too long to conceal
+    uint32_t channels = 0;           // Channels of the last decoded packet
+
+    // Decode time per received packet, concealment included
+    double lastDecodeUs = 0.0;
+    double averageDecodeUs = 0.0;
+    double maxDecodeUs = 0.0;
+
+    // Decode time over the duration of the audio it produced: the share of one
+    // core this stream needs (0.01 = 1%)
+    double cpuLoad = 0.0;
+
+    core::FrameQueueStats queue;
+};
+
+/**
+ * @brief Decodes received Opus audio on a dedicated thread
+ *
+ * decode() only queues the packet, so the network thread never waits for the
+ * decoder. The decoder thread decodes packets in order and passes each to
+ * frameCallback as planar float. A packet whose RTP timestamp is ahead of
+ * where the previous one ended reveals lost audio: the last lost frame is
+ * rebuilt from the new packet's in-band FEC data (LBRR) when present, and
+ * the rest is concealed by Opus PLC, so the output stays continuous and the
+ * timestamps stay on the sender's clock. Packets decode with the channel
+ * count the stream negotiated, up to config.channels; DecodedAudioFrame
+ * carries it, and it changes only where the negotiation does.
+ *
+ * Example usage:
+ * @code
+ * AudioDecoderConfig config;
+ * config.frameCallback = [source](const DecodedAudioFrame& audio) {
+ *     // Wrap in an obs_source_audio and call obs_source_output_audio()
+ * };
+ * AudioDecoder decoder(config);
+ *
+ * sourceConfig.audioCallback = [&decoder](const AudioFrame& frame) {
+ *     decoder.decode(frame);
+ * };
+ * @endcode
+ */
+class AudioDecoder {
+public:
+    /**
+     * @brief Create the decoder and start its thread
+     * @param config Decoder configuration
+     * @throws std::invalid_argument if frameCallback is empty, queueFrames is 0,
+     *         the channel count is not 1 or 2, libopus does not support the sample
+     *         rate, or maxConcealMs is negative
+     * @throws std::runtime_error if the Opus decoder cannot be created
+     */
+    explicit AudioDecoder(const AudioDecoderConfig& config);
+
+    /**
+     * @brief Stop the thread and destroy the decoder; queued packets are discarded
+     */
+    ~AudioDecoder();
+
+    AudioDecoder(const AudioDecoder&) = delete;
+    AudioDecoder& operator=(const AudioDecoder&) = delete;
+
+    /**
+     * @brief Queue an Opus packet for decoding
+     * @param frame Received packet; the payload is shared, not copied
+     */
+    void decode(const AudioFrame& frame);
+
+    /**
+     * @brief Drop queued packets and decoder state, e.g. after a reconnect
+     */
+    void reset();
+
+    /**
+     * @brief Get decode counters and CPU cost
+     */
+    AudioDecoderStats getStats() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+}  // namespace source
+}  // namespace obswebrtc
@@ -5,10 +5,29 @@
 
 #include "obs-webrtc-source.hpp"
 #include "webrtc-source.hpp"
+#include "core/constants.hpp"
+#include "core/frame-queue.hpp"
 #include <obs-module.h>
-#include <graphics/graphics.h>
+#include <util/platform.h>
+#include <atomic>
+#include <memory>
+
+#ifdef ENABLE_FFMPEG_DECODER
+#include "video-decoder.hpp"
+#include "core/triple-buffer.hpp"
+#include <chrono>
+#include <cstring>
 #include <mutex>
-#include <queue>
+#include <vector>
+#endif
+
+#ifdef ENABLE_OPUS_DECODER
+#include "audio-decoder.hpp"
+#include "core/audio-resampler.hpp"
+#include "core/clock-drift.hpp"
+#include <mutex>
+#include <vector>
+#endif
 
 #ifdef ENABLE_QT_UI
 #include "ui/settings-dialog.hpp"
@@ -16,6 +35,57 @@
 #endif
 
 using namespace obswebrtc::source;
+using obswebrtc::core::FrameQueueStats;
+
+namespace constants = obswebrtc::core::constants;
+
+#ifdef ENABLE_FFMPEG_DECODER
+/**
+ * @brief A decoded picture copied out of the decoder, for low-latency mode
+ *
+ * The decoder's planes are only valid during its callback. The buffers are
+ * kept from picture to picture, so once they fit the stream nothing allocates.
+ */
+struct webrtc_latest_picture {
+    std::vector<uint8_t> planes[3];
+    DecodedVideoFrame picture;  // Plane pointers into planes
+
+    void assign(const DecodedVideoFrame &decoded)
+    {
+        picture = decoded;
+        const size_t chroma_rows = (decoded.height + 1) / 2;
+        const size_t chroma_width = (decoded.width + 1) / 2;
+        for (size_t plane = 0; plane < 3; plane++) {
+            picture.planes[plane] = nullptr;
+            if (!decoded.planes[plane] || decoded.height == 0) {
+                continue;
+            }
+            const size_t rows = plane == 0 ? decoded.height : chroma_rows;
+            size_t row_bytes = plane == 0 ? decoded.width : chroma_width;
+            if (plane == 1 && decoded.format == DecodedPixelFormat::NV12) {
+                row_bytes *= 2;  // Interleaved UV
+            }
+            // Stride padding after the last row may not exist in the source
+            const size_t size = (size_t)decoded.linesize[plane] * (rows - 1) + row_bytes;
+            if (planes[plane].size() < size) {
+                planes[plane].resize(size);
+            }
+            std::memcpy(planes[plane].data(), decoded.planes[plane], size);
+            picture.planes[plane] = planes[plane].data();
+        }
+    }
+};
+
+/**
+ * @brief Receive-to-display latency of the video handed to OBS
+ */
+struct webrtc_video_latency {
+    uint64_t frames = 0;
+    double last_ms = 0.0;
+    double total_ms = 0.0;
+    double max_ms = 0.0;
+};
+#endif
 
 /**
  * @brief Source data structure
@@ -23,15 +93,42 @@ using namespace obswebrtc::source;
 struct webrtc_source_data {
     obs_source_t *source;
     WebRTCSource *webrtc_source;
-    gs_texture_t *texture;
 
-    // Video frame queue
-    std::mutex video_mutex;
-    std::queue<VideoFrame> video_queue;
+#ifdef ENABLE_FFMPEG_DECODER
+    // Low-latency mode: the decoder thread leaves only its newest picture
+    // here and a tick callback hands it to OBS. Declared before the decoder,
+    // which writes to it, to outlive it
+    obswebrtc::core::TripleBuffer<webrtc_latest_picture> latest_video;
+    bool tick_callback_added = false;
+
+    // Since the mode last changed; written on the decoder thread (buffered)
+    // or the graphics thread (low-latency)
+    std::mutex video_latency_mutex;
+    webrtc_video_latency video_latency;
+
+    // Decodes on its own thread and feeds OBS's async video path; its input
+    // queue is bounded like the audio queue
+    std::unique_ptr<VideoDecoder> video_decoder;
+#endif
+
+#ifdef ENABLE_OPUS_DECODER
+    // Moves decoded audio from the sender's clock onto OBS's, resampling to
+    // absorb the drift between the two. Used on the decoder thread, so declared
+    // before the decoder to outlive it; the mutex guards reading the stats
+    std::mutex audio_sync_mutex;
+    std::unique_ptr<obswebrtc::core::AudioClockSync> audio_sync;
+    std::unique_ptr<obswebrtc::core::AdaptiveResampler> audio_resampler;
+    std::vector<float> resampled_audio[constants::kMaxAudioDecoderChannels];
+
+    // Decodes Opus on its own thread, with loss concealment, and outputs planar
+    // float; its input queue is bounded, so a stalled decoder drops packets
+    std::unique_ptr<AudioDecoder> audio_decoder;
+#endif
 
-    // Audio frame queue
-    std::mutex audio_mutex;
-    std::queue<AudioFrame> audio_queue;
+    // Drop counts already written to the log
+    uint64_t reported_video_drops = 0;
+    uint64_t reported_audio_drops = 0;
+    uint64_t last_queue_report_ns = 0;
 
     // Configuration
     std::string connection_mode;  // "WHEP" or "P2P"
@@ -47,10 +144,285 @@ struct webrtc_source_data {
     bool audio_only;
     std::string audio_quality;  // "Low", "Medium", "High"
 
-    uint32_t width;
-    uint32_t height;
+    // Show the newest decoded picture at the next OBS tick, without OBS's
+    // async video buffering, instead of pacing pictures by their timestamps
+    std::atomic<bool> low_latency{false};
+
+    std::atomic<uint32_t> width;
+    std::atomic<uint32_t> height;
 };
 
+#ifdef ENABLE_OPUS_DECODER
+/**
+ * @brief Log the estimated sender clock drift and how it is compensated
+ */
+static void webrtc_source_report_audio_sync(webrtc_source_data *data, int log_level)
+{
+    obswebrtc::core::AudioClockSyncStats sync;
+    {
+        std::lock_guard<std::mutex> lock(data->audio_sync_mutex);
+        if (!data->audio_sync) {
+            return;
+        }
+        sync = data->audio_sync->getStats();
+    }
+    blog(log_level,
+         "[WebRTC Source] Audio clock drift %+.1f ppm, correction %+.1f ppm; "
+         "depth %.1f ms, %llu resyncs",
+         sync.driftPpm, sync.correctionPpm, sync.depthMs, (unsigned long long)sync.resyncs);
+}
+#endif
+
+#ifdef ENABLE_FFMPEG_DECODER
+/**
+ * @brief Log the receive-to-display latency of the current mode
+ */
+static void webrtc_source_report_video_latency(webrtc_source_data *data, int log_level)
+{
+    webrtc_video_latency latency;
+    {
+        std::lock_guard<std::mutex> lock(data->video_latency_mutex);
+        latency = data->video_latency;
+    }
+    if (latency.frames == 0) {
+        return;
+    }
+
+    if (data->low_latency) {
+        blog(log_level,
+             "[WebRTC Source] Video latency %.1f ms avg / %.1f ms max, received to displayed "
+             "(low-latency mode, %llu frames, %llu superseded)",
+             latency.total_ms / latency.frames, latency.max_ms,
+             (unsigned long long)latency.frames,
+             (unsigned long long)data->latest_video.getStats().overwritten);
+    } else {
+        blog(log_level,
+             "[WebRTC Source] Video latency %.1f ms avg / %.1f ms max, received to handed to "
+             "OBS (buffered mode, %llu frames; OBS buffering comes on top)",
+             latency.total_ms / latency.frames, latency.max_ms,
+             (unsigned long long)latency.frames);
+    }
+}
+#endif
+
+/**
+ * @brief Log decode latency, plus queue depth and drops if frames were dropped
+ */
+static void webrtc_source_report_queues(webrtc_source_data *data, bool force)
+{
+    const uint64_t now = os_gettime_ns();
+    const uint64_t interval_ns = (uint64_t)constants::kSourceQueueReportIntervalMs * 1000000;
+    if (!force && now - data->last_queue_report_ns < interval_ns) {
+        return;
+    }
+
+    FrameQueueStats video;
+#ifdef ENABLE_FFMPEG_DECODER
+    if (data->video_decoder) {
+        const VideoDecoderStats decode = data->video_decoder->getStats();
+        video = decode.queue;
+        blog(LOG_DEBUG,
+             "[WebRTC Source] Decoded %llu video frames, %llu errors; "
+             "decode %.2f ms avg / %.2f ms max, queued %.2f ms avg / %.2f ms max",
+             (unsigned long long)decode.framesDecoded, (unsigned long long)decode.decodeErrors,
+             decode.averageDecodeMs, decode.maxDecodeMs, decode.averageQueueMs,
+             decode.maxQueueMs);
+        webrtc_source_report_video_latency(data, LOG_DEBUG);
+    }
+#endif
+    FrameQueueStats audio;
+#ifdef ENABLE_OPUS_DECODER
+    if (data->audio_decoder) {
+        const AudioDecoderStats decode = data->audio_decoder->getStats();
+        audio = decode.queue;
+        blog(LOG_DEBUG,
+             "[WebRTC Source] Decoded %llu audio packets, %llu concealed, %llu recovered; "
+             "decode %.1f us avg / %.1f us max, %.3f%% of a core",
+             (unsigned long long)decode.packetsDecoded,
+             (unsigned long long)decode.packetsConcealed,
+             (unsigned long long)decode.packetsRecovered, decode.averageDecodeUs,
+             decode.maxDecodeUs, decode.cpuLoad * 100.0);
+        webrtc_source_report_audio_sync(data, LOG_DEBUG);
+    }
+#endif
+    data->last_queue_report_ns = now;
+    if (video.dropped == data->reported_video_drops &&
+        audio.dropped == data->reported_audio_drops) {
+        return;
+    }
+
+    blog(LOG_WARNING,
+         "[WebRTC Source] Dropped %llu video / %llu audio frames "
+         "(queue depth video %zu/%zu, peak %zu; audio %zu/%zu, peak %zu)",
+         (unsigned long long)(video.dropped - data->reported_video_drops),
+         (unsigned long long)(audio.dropped - data->reported_audio_drops),
+         video.depth, video.capacity, video.maxDepth,
+         audio.depth, audio.capacity, audio.maxDepth);
+
+    data->reported_video_drops = video.dropped;
+    data->reported_audio_drops = audio.dropped;
+}
+
+#ifdef ENABLE_FFMPEG_DECODER
+/**
+ * @brief Hand a decoded picture to OBS, which converts it to RGB on the GPU
+ */
+static void webrtc_source_output_video(webrtc_source_data *data, const DecodedVideoFrame &picture)
+{
+    obs_source_frame frame = {};
+    for (size_t plane = 0; plane < 3; plane++) {
+        frame.data[plane] = const_cast<uint8_t *>(picture.planes[plane]);
+        frame.linesize[plane] = picture.linesize[plane];
+    }
+    frame.width = picture.width;
+    frame.height = picture.height;
+    frame.timestamp = picture.timestampNs;
+    frame.format = picture.format == DecodedPixelFormat::NV12 ? VIDEO_FORMAT_NV12 : VIDEO_FORMAT_I420;
+    frame.full_range = picture.fullRange;
+
+    const enum video_colorspace colorspace =
+        picture.colorSpace == DecodedColorSpace::BT601 ? VIDEO_CS_601 : VIDEO_CS_709;
+    const enum video_range_type range = picture.fullRange ? VIDEO_RANGE_FULL : VIDEO_RANGE_PARTIAL;
+    video_format_get_parameters(colorspace, range, frame.color_matrix,
+                                frame.color_range_min, frame.color_range_max);
+
+    data->width = picture.width;
+    data->height = picture.height;
+
+    // OBS copies the planes before returning, so the decoder may reuse them
+    obs_source_output_video(data->source, &frame);
+
+    const double latency_ms = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - picture.received)
+                                  .count();
+    std::lock_guard<std::mutex> lock(data->video_latency_mutex);
+    webrtc_video_latency &latency = data->video_latency;
+    latency.frames++;
+    latency.last_ms = latency_ms;
+    latency.total_ms += latency_ms;
+    if (latency_ms > latency.max_ms) {
+        latency.max_ms = latency_ms;
+    }
+}
+
+/**
+ * @brief Hand the newest decoded picture to OBS in low-latency mode
+ *
+ * Registered with obs_add_tick_callback(), which OBS calls at the start of
+ * each video tick, before it picks the frame every async source shows. The
+ * source's own video_tick runs after that pick, so a picture output there
+ * would wait a whole extra tick. Taking one picture per tick also means
+ * pictures OBS would skip anyway are never copied into it.
+ */
+static void webrtc_source_present_latest_video(void *param, float seconds)
+{
+    UNUSED_PARAMETER(seconds);
+
+    auto *data = static_cast<webrtc_source_data *>(param);
+    // Drained in either mode, so a picture left from before a switch is never shown late
+    if (data->latest_video.consume() && data->low_latency) {
+        webrtc_source_output_video(data, data->latest_video.readSlot().picture);
+    }
+}
+
+/**
+ * @brief "get_video_latency" procedure: receive-to-display latency of this source
+ *
+ * For scripts and tools comparing the two modes, via obs_source_get_proc_handler()
+ * and proc_handler_call(). Figures cover the time since the mode last changed.
+ */
+static void webrtc_source_get_video_latency(void *param, calldata_t *cd)
+{
+    auto *data = static_cast<webrtc_source_data *>(param);
+
+    webrtc_video_latency latency;
+    {
+        std::lock_guard<std::mutex> lock(data->video_latency_mutex);
+        latency = data->video_latency;
+    }
+    calldata_set_bool(cd, "low_latency", data->low_latency);
+    calldata_set_float(cd, "last_ms", latency.last_ms);
+    calldata_set_float(cd, "average_ms", latency.frames ? latency.total_ms / latency.frames : 0.0);
+    calldata_set_float(cd, "max_ms", latency.max_ms);
+    calldata_set_int(cd, "frames", (long long)latency.frames);
+    calldata_set_int(cd, "superseded", (long long)data->latest_video.getStats().overwritten);
+}
+#endif
+
+/**
+ * @brief Switch between low-latency and buffered video presentation
+ */
+static void webrtc_source_set_low_latency(webrtc_source_data *data, bool low_latency)
+{
+    if (data->low_latency == low_latency) {
+        return;
+    }
+
+#ifdef ENABLE_FFMPEG_DECODER
+    // Report the outgoing mode, then measure the new one from scratch
+    webrtc_source_report_video_latency(data, LOG_INFO);
+    {
+        std::lock_guard<std::mutex> lock(data->video_latency_mutex);
+        data->video_latency = webrtc_video_latency();
+    }
+#endif
+
+    data->low_latency = low_latency;
+    obs_source_set_async_unbuffered(data->source, low_latency);
+    blog(LOG_INFO, "[WebRTC Source] Video presentation: %s",
+         low_latency ? "low-latency (newest frame only)" : "buffered");
+}
+
+#ifdef ENABLE_OPUS_DECODER
+/**
+ * @brief Hand decoded (or concealed) samples to OBS
+ *
+ * The samples are resampled by the clock sync's ratio and stamped on OBS's
+ * clock, so a sender whose clock drifts neither builds up latency nor runs
+ * the source dry over a long session.
+ */
+static void webrtc_source_output_audio(webrtc_source_data *data, const DecodedAudioFrame &audio)
+{
+    obs_source_audio audio_data = {};
+    {
+        std::lock_guard<std::mutex> lock(data->audio_sync_mutex);
+        // Mono guests decode as mono; the filter history is per channel
+        if (data->audio_resampler->getChannels() != audio.channels) {
+            data->audio_resampler =
+                std::make_unique<obswebrtc::core::AdaptiveResampler>(audio.channels);
+        }
+        data->audio_resampler->setRatio(
+            data->audio_sync->update(audio.timestampNs, audio.frames, os_gettime_ns()));
+
+        // Grows to the largest packet once, then reused
+        const size_t capacity = data->audio_resampler->maxOutputFrames(audio.frames);
+        float *planes[constants::kMaxAudioDecoderChannels] = {};
+        for (uint32_t channel = 0; channel < audio.channels; channel++) {
+            std::vector<float> &plane = data->resampled_audio[channel];
+            if (plane.size() < capacity) {
+                plane.resize(capacity);
+            }
+            planes[channel] = plane.data();
+            audio_data.data[channel] = reinterpret_cast<const uint8_t *>(plane.data());
+        }
+        const size_t frames =
+            data->audio_resampler->process(audio.planes, audio.frames, planes, capacity);
+        audio_data.frames = static_cast<uint32_t>(frames);
+        audio_data.timestamp = data->audio_sync->advance(frames);
+    }
+    if (audio_data.frames == 0) {
+        return;
+    }
+
+    audio_data.speakers = audio.channels == 2 ? SPEAKERS_STEREO : SPEAKERS_MONO;
+    audio_data.samples_per_sec = audio.sampleRate;
+    audio_data.format = AUDIO_FORMAT_FLOAT_PLANAR;
+
+    // OBS copies the samples before returning
+    obs_source_output_audio(data->source, &audio_data);
+}
+#endif
+
 /**
  * @brief Get source name
  */
@@ -67,7 +439,6 @@ static void *webrtc_source_create(obs_data_t *settings, obs_source_t *source)
 {
     auto *data = new webrtc_source_data();
     data->source = source;
-    data->texture = nullptr;
     data->width = 1920;
     data->height = 1080;
 
@@ -80,6 +451,9 @@ static void *webrtc_source_create(obs_data_t *settings, obs_source_t *source)
     data->session_id = obs_data_get_string(settings, "session_id");
     data->audio_only = obs_data_get_bool(settings, "audio_only");
     data->audio_quality = obs_data_get_string(settings, "audio_quality");
+    data->low_latency = obs_data_get_bool(settings, "low_latency");
+    // Unbuffered: OBS shows each frame as soon as it has it, ignoring timestamps
+    obs_source_set_async_unbuffered(source, data->low_latency);
     const char *codec_str = obs_data_get_string(settings, "video_codec");
 
     if (strcmp(codec_str, "H264") == 0) {
@@ -119,20 +493,91 @@ static void *webrtc_source_create(obs_data_t *settings, obs_source_t *source)
     config.audioOnly = data->audio_only;
     config.audioQuality = data->audio_quality;
 
+    // Create the video decoder
+#ifdef ENABLE_FFMPEG_DECODER
+    if (!data->audio_only) {
+        VideoDecoderConfig decoder_config;
+        decoder_config.codec = data->video_codec;
+        decoder_config.frameCallback = [data](const DecodedVideoFrame& picture) {
+            if (data->low_latency) {
+                // Replaces a picture the next tick has not taken yet
+                data->latest_video.writeSlot().assign(picture);
+                data->latest_video.publish();
+            } else {
+                webrtc_source_output_video(data, picture);
+            }
+        };
+        decoder_config.errorCallback = [](const std::string& error) {
+            blog(LOG_WARNING, "[WebRTC Source] Video decoder: %s", error.c_str());
+        };
+        // Runs on the receive thread of the current connection, so the source exists
+        decoder_config.keyframeRequestCallback = [data]() {
+            if (data->webrtc_source && data->webrtc_source->requestKeyframe()) {
+                blog(LOG_DEBUG, "[WebRTC Source] Keyframe requested after queue overflow");
+            }
+        };
+
+        try {
+            data->video_decoder = std::make_unique<VideoDecoder>(decoder_config);
+        } catch (const std::exception& e) {
+            blog(LOG_ERROR, "[WebRTC Source] Video decoding unavailable: %s", e.what());
+        }
+    }
+#else
+    if (!data->audio_only) {
+        blog(LOG_WARNING, "[WebRTC Source] Built without FFmpeg; received video is not decoded");
+    }
+#endif
+
+    // Create the audio decoder
+#ifdef ENABLE_OPUS_DECODER
+    AudioDecoderConfig audio_decoder_config;
+    audio_decoder_config.frameCallback = [data](const DecodedAudioFrame& audio) {
+        webrtc_source_output_audio(data, audio);
+    };
+    audio_decoder_config.errorCallback = [](const std::string& error) {
+        blog(LOG_WARNING, "[WebRTC Source] Audio decoder: %s", error.c_str());
+    };
+
+    try {
+        obswebrtc::core::AudioClockSyncConfig sync_config;
+        sync_config.sampleRate = audio_decoder_config.sampleRate;
+        data->audio_sync = std::make_unique<obswebrtc::core::AudioClockSync>(sync_config);
+        data->audio_resampler =
+            std::make_unique<obswebrtc::core::AdaptiveResampler>(audio_decoder_config.channels);
+        data->audio_decoder = std::make_unique<AudioDecoder>(audio_decoder_config);
+    } catch (const std::exception& e) {
+        blog(LOG_ERROR, "[WebRTC Source] Audio decoding unavailable: %s", e.what());
+    }
+#else
+    blog(LOG_WARNING, "[WebRTC Source] Built without libopus; received audio is not decoded");
+#endif
+
     // Set video callback
+    // Queued frames share the received buffers; the payloads are not copied
     config.videoCallback = [data](const VideoFrame& frame) {
-        std::lock_guard<std::mutex> lock(data->video_mutex);
-        data->video_queue.push(frame);
-
-        // Update dimensions
-        data->width = frame.width;
-        data->height = frame.height;
+        // Size from the stream's SPS, known before anything is decoded
+        if (frame.width != 0 && frame.height != 0) {
+            data->width = frame.width;
+            data->height = frame.height;
+        }
+#ifdef ENABLE_FFMPEG_DECODER
+        if (data->video_decoder) {
+            data->video_decoder->decode(frame);
+        }
+#endif
     };
 
     // Set audio callback
     config.audioCallback = [data](const AudioFrame& frame) {
-        std::lock_guard<std::mutex> lock(data->audio_mutex);
-        data->audio_queue.push(frame);
+#ifdef ENABLE_OPUS_DECODER
+        if (data->audio_decoder) {
+            data->audio_decoder->decode(frame);
+        }
+#else
+        UNUSED_PARAMETER(data);
+        UNUSED_PARAMETER(frame);
+#endif
     };
 
     // Set error callback
@@ -168,6 +613,18 @@ static void *webrtc_source_create(obs_data_t *settings, obs_source_t *source)
         return nullptr;
     }
 
+#ifdef ENABLE_FFMPEG_DECODER
+    if (data->video_decoder) {
+        obs_add_tick_callback(webrtc_source_present_latest_video, data);
+        data->tick_callback_added = true;
+    }
+    proc_handler_add(obs_source_get_proc_handler(source),
+                     "void get_video_latency(out bool low_latency, out float last_ms, "
+                     "out float average_ms, out float max_ms, out int frames, "
+                     "out int superseded)",
+                     webrtc_source_get_video_latency, data);
+#endif
+
     blog(LOG_INFO, "[WebRTC Source] Source created: %s", data->server_url.c_str());
 
     return data;
@@ -180,16 +637,45 @@ static void webrtc_source_destroy(void *data)
 {
     auto *source_data = static_cast<webrtc_source_data*>(data);
 
+#ifdef ENABLE_FFMPEG_DECODER
+    // Returns once a running callback has finished
+    if (source_data->tick_callback_added) {
+        obs_remove_tick_callback(webrtc_source_present_latest_video, source_data);
+    }
+#endif
+
     if (source_data->webrtc_source) {
         source_data->webrtc_source->stop();
         delete source_data->webrtc_source;
     }
 
-    obs_enter_graphics();
-    if (source_data->texture) {
-        gs_texture_destroy(source_data->texture);
+    webrtc_source_report_queues(source_data, true);
+
+#ifdef ENABLE_FFMPEG_DECODER
+    if (source_data->video_decoder) {
+        const VideoDecoderStats stats = source_data->video_decoder->getStats();
+        blog(LOG_INFO,
+             "[WebRTC Source] Decoded %llu video frames, %llu errors; "
+             "decode %.2f ms avg / %.2f ms max, queued %.2f ms avg / %.2f ms max",
+             (unsigned long long)stats.framesDecoded, (unsigned long long)stats.decodeErrors,
+             stats.averageDecodeMs, stats.maxDecodeMs, stats.averageQueueMs, stats.maxQueueMs);
+        webrtc_source_report_video_latency(source_data, LOG_INFO);
     }
-    obs_leave_graphics();
+#endif
+
+#ifdef ENABLE_OPUS_DECODER
+    if (source_data->audio_decoder) {
+        const AudioDecoderStats stats = source_data->audio_decoder->getStats();
+        blog(LOG_INFO,
+             "[WebRTC Source] Decoded %llu audio packets, %llu concealed, %llu recovered, "
+             "%llu errors; decode %.1f us avg / %.1f us max, %.3f%% of a core",
+             (unsigned long long)stats.packetsDecoded,
+             (unsigned long long)stats.packetsConcealed,
+             (unsigned long long)stats.packetsRecovered, (unsigned long long)stats.decodeErrors,
+             stats.averageDecodeUs, stats.maxDecodeUs, stats.cpuLoad * 100.0);
+        webrtc_source_report_audio_sync(source_data, LOG_INFO);
+    }
+#endif
 
     delete source_data;
 
@@ -221,6 +707,9 @@ static void webrtc_source_update(void *data, obs_data_t *settings)
 {
     auto *source_data = static_cast<webrtc_source_data*>(data);
 
+    // Takes effect without reconnecting
+    webrtc_source_set_low_latency(source_data, obs_data_get_bool(settings, "low_latency"));
+
     const char *new_url = obs_data_get_string(settings, "server_url");
 
     if (source_data->server_url != new_url) {
@@ -231,6 +720,13 @@ static void webrtc_source_update(void *data, obs_data_t *settings)
             source_data->webrtc_source->stop();
             delete source_data->webrtc_source;
 
+#ifdef ENABLE_FFMPEG_DECODER
+            // The new stream starts from its own keyframe
+            if (source_data->video_decoder) {
+                source_data->video_decoder->reset();
+            }
+#endif
+
             WebRTCSourceConfig config;
             config.serverUrl = source_data->server_url;
             config.videoCodec = source_data->video_codec;
@@ -259,6 +755,7 @@ static void webrtc_source_get_defaults(obs_data_t *settings)
     obs_data_set_default_string(settings, "session_id", "");
     obs_data_set_default_bool(settings, "audio_only", false);
     obs_data_set_default_string(settings, "audio_quality", "Medium");
+    obs_data_set_default_bool(settings, "low_latency", false);
     obs_data_set_default_string(settings, "video_codec", "H264");
     obs_data_set_default_int(settings, "video_bitrate", 2500);
     obs_data_set_default_string(settings, "audio_codec", "opus");
@@ -432,6 +929,14 @@ static obs_properties_t *webrtc_source_get_properties(void *data)
     obs_property_list_add_string(codec, "VP8", "VP8");
     obs_property_list_add_string(codec, "VP9", "VP9");
 
+    // Low-latency presentation
+    obs_property_t *low_latency = obs_properties_add_bool(
+        props, "low_latency", obs_module_text("Low-latency Mode (newest frame only)"));
+    obs_property_set_long_description(
+        low_latency, obs_module_text("Shows each decoded frame at the next OBS frame and skips "
+                                     "frames that arrive in between, instead of buffering "
+                                     "them for smooth playback"));
+
     return props;
 }
 
@@ -470,86 +975,8 @@ static void webrtc_source_video_tick(void *data, float seconds)
 
     auto *source_data = static_cast<webrtc_source_data*>(data);
 
-    // Process audio frames
-    {
-        std::lock_guard<std::mutex> lock(source_data->audio_mutex);
-        while (!source_data->audio_queue.empty()) {
-            const AudioFrame& frame = source_data->audio_queue.front();
-
-            // Convert to OBS audio format
-            obs_source_audio audio_data = {};
-            audio_data.data[0] = frame.data.data();
-            audio_data.frames = frame.data.size() / (sizeof(float) * frame.channels);
-            audio_data.speakers = frame.channels == 2 ? SPEAKERS_STEREO : SPEAKERS_MONO;
-            audio_data.samples_per_sec = frame.sampleRate;
-            audio_data.format = AUDIO_FORMAT_FLOAT;
-            audio_data.timestamp = frame.timestamp;
-
-            obs_source_output_audio(source_data->source, &audio_data);
-
-            source_data->audio_queue.pop();
-        }
-    }
-}
-
-/**
- * @brief Video render (called every frame)
- */
-static void webrtc_source_video_render(void *data, gs_effect_t *effect)
-{
-    UNUSED_PARAMETER(effect);
-
-    auto *source_data = static_cast<webrtc_source_data*>(data);
-
-    // Process video frames
-    {
-        std::lock_guard<std::mutex> lock(source_data->video_mutex);
-        if (!source_data->video_queue.empty()) {
-            const VideoFrame& frame = source_data->video_queue.front();
-
-            // Create or update texture
-            if (!source_data->texture ||
-                gs_texture_get_width(source_data->texture) != frame.width ||
-                gs_texture_get_height(source_data->texture) != frame.height) {
-
-                if (source_data->texture) {
-                    gs_texture_destroy(source_data->texture);
-                }
-
-                source_data->texture = gs_texture_create(
-                    frame.width, frame.height,
-                    GS_RGBA, 1, nullptr, GS_DYNAMIC
-                );
-            }
-
-            // Update texture with frame data
-            if (source_data->texture) {
-                uint8_t *tex_data;
-                uint32_t linesize;
-                if (gs_texture_map(source_data->texture, &tex_data, &linesize)) {
-                    // TODO: Proper YUV to RGB conversion
-                    // For now, just copy the data
-                    memcpy(tex_data, frame.data.data(),
-                           std::min(frame.data.size(), (size_t)(linesize * frame.height)));
-                    gs_texture_unmap(source_data->texture);
-                }
-            }
-
-            source_data->video_queue.pop();
-        }
-    }
-
-    // Render texture
-    if (source_data->texture) {
-        gs_effect_t *eff = obs_get_base_effect(OBS_EFFECT_DEFAULT);
-        gs_eparam_t *image = gs_effect_get_param_by_name(eff, "image");
-        gs_effect_set_texture(image, source_data->texture);
-
-        while (gs_effect_loop(eff, "Draw")) {
-            gs_draw_sprite(source_data->texture, 0,
-                          source_data->width, source_data->height);
-        }
-    }
+    // Decoded audio goes to OBS from the decoder thread; only the report is left here
+    webrtc_source_report_queues(source_data, false);
 }
 
 /**
@@ -574,7 +1001,6 @@ void register_webrtc_source()
     info.show = webrtc_source_show;
     info.hide = webrtc_source_hide;
     info.video_tick = webrtc_source_video_tick;
-    info.video_render = webrtc_source_video_render;
 
     obs_register_source(&info);
 
@@ -0,0 +1,463 @@
+/**
+ * @file video-decoder.cpp
+ * @brief FFmpeg implementation of the receive-side video decoder
+ */
+
+#include "video-decoder.hpp"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/error.h>
+#include <libavutil/frame.h>
+#include <libavutil/pixdesc.h>
+}
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace obswebrtc {
+namespace source {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Access units inside the decoder at once, tracked by packet pts; far more
+// than slice threading ever holds back
+constexpr size_t kInFlightSlots = 64;
+
+AVCodecID codecId(VideoCodec codec)
+{
+    switch (codec) {
+        case VideoCodec::H264:
+            return AV_CODEC_ID_H264;
+        case VideoCodec::VP8:
+            return AV_CODEC_ID_VP8;
+        case VideoCodec::VP9:
+            return AV_CODEC_ID_VP9;
+        case VideoCodec::AV1:
+            return AV_CODEC_ID_AV1;
+    }
+    return AV_CODEC_ID_NONE;
+}
+
+const char* codecName(VideoCodec codec)
+{
+    switch (codec) {
+        case VideoCodec::H264:
+            return "H.264";
+        case VideoCodec::VP8:
+            return "VP8";
+        case VideoCodec::VP9:
+            return "VP9";
+        case VideoCodec::AV1:
+            return "AV1";
+    }
+    return "unknown";
+}
+
+std::string errorString(int error)
+{
+    char buffer[AV_ERROR_MAX_STRING_SIZE] = {};
+    av_strerror(error, buffer, sizeof(buffer));
+    return buffer;
+}
+
+double elapsedMs(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+DecodedColorSpace colorSpace(AVColorSpace signalled, int height)
+{
+    switch (signalled) {
+        case AVCOL_SPC_BT709:
+            return DecodedColorSpace::BT709;
+        case AVCOL_SPC_BT470BG:
+        case AVCOL_SPC_SMPTE170M:
+            return DecodedColorSpace::BT601;
+        default:
+            // Same guess as most players: SD content is BT.601
+            return height >= 720 ? DecodedColorSpace::BT709 : DecodedColorSpace::BT601;
+    }
+}
+
+const VideoDecoderConfig& validate(const VideoDecoderConfig& config)
+{
+    if (!config.frameCallback) {
+        throw std::invalid_argument("Video decoder needs a frame callback");
+    }
+    if (config.queueFrames == 0) {
+        throw std::invalid_argument("Video decoder queue must hold at least one frame");
+    }
+    return config;
+}
+
+}  // namespace
+
+/**
+ * @brief Private implementation of VideoDecoder
+ */
+class VideoDecoder::Impl {
+public:
+    explicit Impl(const VideoDecoderConfig& config)
+        : config_(validate(config))
+        , queue_(config.queueFrames)
+    {
+        const AVCodec* codec = avcodec_find_decoder(codecId(config_.codec));
+        if (!codec) {
+            throw std::runtime_error(std::string("FFmpeg has no ") + codecName(config_.codec) +
+                                     " decoder");
+        }
+
+        context_ = avcodec_alloc_context3(codec);
+        packet_ = av_packet_alloc();
+        picture_ = av_frame_alloc();
+        if (!context_ || !packet_ || !picture_) {
+            close();
+            throw std::runtime_error("Failed to allocate the video decoder");
+        }
+
+        // Slice threads decode one picture together; frame threads would each
+        // hold a picture back
+        context_->thread_count = config_.threads;
+        context_->thread_type = FF_THREAD_SLICE;
+        context_->flags |= AV_CODEC_FLAG_LOW_DELAY;
+
+        const int result = avcodec_open2(context_, codec, nullptr);
+        if (result < 0) {
+            close();
+            throw std::runtime_error(std::string("Failed to open the ") +
+                                     codecName(config_.codec) + " decoder: " +
+                                     errorString(result));
+        }
+
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    ~Impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            stopping_ = true;
+        }
+        wakeCondition_.notify_one();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        close();
+    }
+
+    void decode(const VideoFrame& frame)
+    {
+        const core::FrameClass frameClass =
+            config_.codec == VideoCodec::H264
+                ? core::classifyH264Frame(frame.data.data(), frame.data.size())
+                : (frame.keyframe ? core::FrameClass::Keyframe : core::FrameClass::Reference);
+
+        QueuedFrame queued;
+        queued.frame = frame;
+        queued.received = Clock::now();
+        if (!queue_.pushVideo(std::move(queued), frameClass) && queue_.isAwaitingKeyframe() &&
+            config_.keyframeRequestCallback) {
+            // Nothing decodes until the next keyframe; don't wait for the scheduled one
+            config_.keyframeRequestCallback();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            pending_ = true;
+        }
+        wakeCondition_.notify_one();
+    }
+
+    void reset()
+    {
+        queue_.clear();
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            resetRequested_ = true;
+            pending_ = true;
+        }
+        wakeCondition_.notify_one();
+    }
+
+    VideoDecoderStats getStats() const
+    {
+        VideoDecoderStats stats;
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats = stats_;
+            if (stats.framesDecoded > 0) {
+                const double frames = static_cast<double>(stats.framesDecoded);
+                stats.averageDecodeMs = totalDecodeMs_ / frames;
+                stats.averageQueueMs = totalQueueMs_ / frames;
+            }
+        }
+        stats.queue = queue_.getStats();
+        return stats;
+    }
+
+private:
+    struct QueuedFrame {
+        VideoFrame frame;
+        Clock::time_point received;
+    };
+
+    struct InFlight {
+        Clock::time_point received;
+        Clock::time_point submitted;
+        uint64_t timestampNs = 0;
+    };
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        while (true) {
+            wakeCondition_.wait(lock, [this]() { return pending_ || stopping_; });
+            if (stopping_) {
+                return;
+            }
+            pending_ = false;
+            const bool flush = resetRequested_;
+            resetRequested_ = false;
+            lock.unlock();
+
+            if (flush) {
+                avcodec_flush_buffers(context_);
+                haveTimestamp_ = false;
+            }
+
+            // Every queued access unit is decoded, in order: later frames
+            // predict from earlier ones
+            QueuedFrame queued;
+            while (queue_.pop(queued)) {
+                decodeOne(queued);
+                queued.frame.data = core::BufferSlice();  // Back to the pool now
+                if (stopRequested()) {
+                    return;
+                }
+            }
+
+            lock.lock();
+        }
+    }
+
+    bool stopRequested()
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        return stopping_;
+    }
+
+    void decodeOne(const QueuedFrame& queued)
+    {
+        const core::BufferSlice& data = queued.frame.data;
+        if (data.empty()) {
+            return;
+        }
+
+        // FFmpeg's bitstream readers overread, so the packet needs its zeroed
+        // padding; av_new_packet provides it
+        int result = av_new_packet(packet_, static_cast<int>(data.size()));
+        if (result < 0) {
+            reportError("Failed to allocate a decoder packet: " + errorString(result));
+            return;
+        }
+        std::memcpy(packet_->data, data.data(), data.size());
+
+        const int64_t sequence = nextSequence_++;
+        InFlight& slot = inFlight_[static_cast<size_t>(sequence) % kInFlightSlots];
+        slot.received = queued.received;
+        slot.timestampNs = unwrapTimestamp(static_cast<uint32_t>(queued.frame.timestamp));
+        slot.submitted = Clock::now();
+        packet_->pts = sequence;
+
+        result = avcodec_send_packet(context_, packet_);
+        av_packet_unref(packet_);
+        if (result < 0) {
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                stats_.decodeErrors++;
+            }
+            reportError("Decoder rejected an access unit: " + errorString(result));
+            return;
+        }
+
+        while (true) {
+            result = avcodec_receive_frame(context_, picture_);
+            if (result == AVERROR(EAGAIN) || result == AVERROR_EOF) {
+                break;
+            }
+            if (result < 0) {
+                {
+                    std::lock_guard<std::mutex> lock(statsMutex_);
+                    stats_.decodeErrors++;
+                }
+                reportError("Decoding failed: " + errorString(result));
+                break;
+            }
+            deliver(sequence);
+            av_frame_unref(picture_);
+        }
+    }
+
+    void deliver(int64_t latestSequence)
+    {
+        const Clock::time_point now = Clock::now();
+
+        // Match the picture to its access unit; slots older than the window
+        // have been reused, so fall back to the latest one
+        int64_t sequence = picture_->pts;
+        if (sequence == AV_NOPTS_VALUE || sequence > latestSequence ||
+            latestSequence - sequence >= static_cast<int64_t>(kInFlightSlots)) {
+            sequence = latestSequence;
+        }
+        const InFlight& slot = inFlight_[static_cast<size_t>(sequence) % kInFlightSlots];
+
+        DecodedVideoFrame decoded;
+        decoded.width = static_cast<uint32_t>(picture_->width);
+        decoded.height = static_cast<uint32_t>(picture_->height);
+        decoded.timestampNs = slot.timestampNs;
+        decoded.received = slot.received;
+        decoded.fullRange = picture_->color_range == AVCOL_RANGE_JPEG;
+        decoded.colorSpace = colorSpace(picture_->colorspace, picture_->height);
+
+        size_t planes = 0;
+        switch (picture_->format) {
+            case AV_PIX_FMT_YUVJ420P:
+                decoded.fullRange = true;
+                decoded.format = DecodedPixelFormat::I420;
+                planes = 3;
+                break;
+            case AV_PIX_FMT_YUV420P:
+                decoded.format = DecodedPixelFormat::I420;
+                planes = 3;
+                break;
+            case AV_PIX_FMT_NV12:
+                decoded.format = DecodedPixelFormat::NV12;
+                planes = 2;
+                break;
+            default:
+                break;
+        }
+
+        if (planes == 0) {
+            bool first = false;
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                first = stats_.unsupportedFrames++ == 0;
+            }
+            if (first) {
+                const char* name =
+                    av_get_pix_fmt_name(static_cast<AVPixelFormat>(picture_->format));
+                reportError(std::string("Unsupported decoded pixel format: ") +
+                            (name ? name : "unknown"));
+            }
+            return;
+        }
+
+        for (size_t plane = 0; plane < planes; plane++) {
+            decoded.planes[plane] = picture_->data[plane];
+            decoded.linesize[plane] = static_cast<uint32_t>(picture_->linesize[plane]);
+        }
+
+        const double decodeMs = elapsedMs(slot.submitted, now);
+        const double queueMs = elapsedMs(slot.received, slot.submitted);
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats_.framesDecoded++;
+            stats_.lastDecodeMs = decodeMs;
+            stats_.maxDecodeMs = std::max(stats_.maxDecodeMs, decodeMs);
+            stats_.maxQueueMs = std::max(stats_.maxQueueMs, queueMs);
+            totalDecodeMs_ += decodeMs;
+            totalQueueMs_ += queueMs;
+        }
+
+        config_.frameCallback(decoded);
+    }
+
+    uint64_t unwrapTimestamp(uint32_t rtpTimestamp)
+    {
+        if (!haveTimestamp_) {
+            extendedTimestamp_ = rtpTimestamp;
+            haveTimestamp_ = true;
+        } else {
+            extendedTimestamp_ += static_cast<int32_t>(rtpTimestamp - lastRtpTimestamp_);
+        }
+        lastRtpTimestamp_ = rtpTimestamp;
+
+        const uint64_t ticks = static_cast<uint64_t>(std::max<int64_t>(extendedTimestamp_, 0));
+        const uint64_t clockRate = core::constants::kVideoRtpClockRate;
+        return ticks / clockRate * 1000000000ULL + ticks % clockRate * 1000000000ULL / clockRate;
+    }
+
+    void reportError(const std::string& message)
+    {
+        if (config_.errorCallback) {
+            config_.errorCallback(message);
+        }
+    }
+
+    void close()
+    {
+        av_frame_free(&picture_);
+        av_packet_free(&packet_);
+        avcodec_free_context(&context_);
+    }
+
+    VideoDecoderConfig config_;
+    core::FrameQueue<QueuedFrame> queue_;
+
+    // Decoder state, owned by the decoder thread once it runs
+    AVCodecContext* context_ = nullptr;
+    AVPacket* packet_ = nullptr;
+    AVFrame* picture_ = nullptr;
+    std::array<InFlight, kInFlightSlots> inFlight_;
+    int64_t nextSequence_ = 0;
+    bool haveTimestamp_ = false;
+    uint32_t lastRtpTimestamp_ = 0;
+    int64_t extendedTimestamp_ = 0;
+
+    std::thread thread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    bool pending_ = false;
+    bool resetRequested_ = false;
+    bool stopping_ = false;
+
+    mutable std::mutex statsMutex_;
+    VideoDecoderStats stats_;
+    double totalDecodeMs_ = 0.0;
+    double totalQueueMs_ = 0.0;
+};
+
+VideoDecoder::VideoDecoder(const VideoDecoderConfig& config)
+    : pImpl(std::make_unique<Impl>(config))
+{
+}
+
+VideoDecoder::~VideoDecoder() = default;
+
+void VideoDecoder::decode(const VideoFrame& frame)
+{
+    pImpl->decode(frame);
+}
+
+void VideoDecoder::reset()
+{
+    pImpl->reset();
+}
+
+VideoDecoderStats VideoDecoder::getStats() const
+{
+    return pImpl->getStats();
+}
+
+}  // namespace source
+}  // namespace obswebrtc
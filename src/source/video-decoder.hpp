@@ -0,0 +1,165 @@
+/**
+ * @file video-decoder.hpp
+ * @brief Software video decoding stage for the receive side
+ *
+ * This module provides:
+ * - A decoder thread that turns received access units into planar
+ *   I420/NV12 pictures using FFmpeg's software decoders (H.264, VP8, VP9, AV1)
+ * - A bounded, keyframe-aware input queue, so a decoder that falls behind
+ *   sheds frames instead of adding latency
+ * - Per-frame latency instrumentation (queue wait and decode time)
+ */
+
+#pragma once
+
+#include "webrtc-source.hpp"
+#include "core/constants.hpp"
+#include "core/frame-queue.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace obswebrtc {
+namespace source {
+
+/**
+ * @brief Planar layouts the decoder hands out
+ */
+enum class DecodedPixelFormat {
+    I420,  ///< Y, U, V planes, chroma subsampled 2x2
+    NV12   ///< Y plane, interleaved UV plane
+};
+
+/**
+ * @brief YUV matrix of a decoded picture
+ */
+enum class DecodedColorSpace {
+    BT601,
+    BT709
+};
+
+/**
+ * @brief One decoded picture
+ *
+ * The planes belong to the decoder and are only valid during the callback;
+ * consumers that keep the picture must copy it (obs_source_output_video does).
+ */
+struct DecodedVideoFrame {
+    const uint8_t* planes[3] = {nullptr, nullptr, nullptr};
+    uint32_t linesize[3] = {0, 0, 0};
+    uint32_t width = 0;
+    uint32_t height = 0;
+    DecodedPixelFormat format = DecodedPixelFormat::I420;
+    DecodedColorSpace colorSpace = DecodedColorSpace::BT709;  // Guessed from height if unsignalled
+    bool fullRange = false;
+    uint64_t timestampNs = 0;  // Unwrapped from the RTP timestamp
+    // When decode() queued the access unit, for receive-to-display latency
+    std::chrono::steady_clock::time_point received;
+};
+
+/**
+ * @brief Configuration for VideoDecoder
+ */
+struct VideoDecoderConfig {
+    VideoCodec codec = VideoCodec::H264;
+    size_t queueFrames = core::constants::kDefaultSourceVideoQueueFrames;
+    int threads = core::constants::kDefaultVideoDecoderThreads;  // 0 = one per core
+
+    // Called on the decoder thread for every decoded picture
+    std::function<void(const DecodedVideoFrame&)> frameCallback;
+    // Called on the decoder thread when the decoder rejects input
+    std::function<void(const std::string&)> errorCallback;
+    // Called from decode() for every frame skipped while the queue waits for
+    // a keyframe after dropping a reference frame; should ask the sender for
+    // one (e.g. WebRTCSource::requestKeyframe(), which is throttled)
+    std::function<void()> keyframeRequestCallback;
+};
+
+/**
+ * @brief Counters for a VideoDecoder
+ */
+struct VideoDecoderStats {
+    uint64_t framesDecoded = 0;
+    uint64_t decodeErrors = 0;
+    uint64_t unsupportedFrames = 0;  // Decoded in a pixel format that is not handed out
+
+    // Decode time: access unit submitted to picture out
+    double lastDecodeMs = 0.0;
+    double averageDecodeMs = 0.0;
+    double maxDecodeMs = 0.0;
+
+    // Queue wait: access unit received to submitted
+    double averageQueueMs = 0.0;
+    double maxQueueMs = 0.0;
+
+    core::FrameQueueStats queue;
+};
+
+/**
+ * @brief Decodes received video on a dedicated thread
+ *
+ * decode() only queues the access unit, so the network thread never waits
+ * for the decoder. The decoder thread decodes every queued access unit in
+ * order (later frames predict from earlier ones) and passes each picture to
+ * frameCallback. Slice threading is used rather than frame threading, which
+ * would delay every picture by one frame per thread.
+ *
+ * Example usage:
+ * @code
+ * VideoDecoderConfig config;
+ * config.codec = VideoCodec::H264;
+ * config.frameCallback = [source](const DecodedVideoFrame& picture) {
+ *     // Wrap in an obs_source_frame and call obs_source_output_video()
+ * };
+ * VideoDecoder decoder(config);
+ *
+ * sourceConfig.videoCallback = [&decoder](const VideoFrame& frame) {
+ *     decoder.decode(frame);
+ * };
+ * @endcode
+ */
+class VideoDecoder {
+public:
+    /**
+     * @brief Open the decoder and start its thread
+     * @param config Decoder configuration
+     * @throws std::invalid_argument if frameCallback is empty or queueFrames is 0
+     * @throws std::runtime_error if FFmpeg has no decoder for the codec
+     */
+    explicit VideoDecoder(const VideoDecoderConfig& config);
+
+    /**
+     * @brief Stop the thread and close the decoder; queued frames are discarded
+     */
+    ~VideoDecoder();
+
+    VideoDecoder(const VideoDecoder&) = delete;
+    VideoDecoder& operator=(const VideoDecoder&) = delete;
+
+    /**
+     * @brief Queue an access unit for decoding
+     * @param frame Received access unit; the payload is shared, not copied
+     */
+    void decode(const VideoFrame& frame);
+
+    /**
+     * @brief Drop queued frames and decoder state, e.g. after a reconnect
+     */
+    void reset();
+
+    /**
+     * @brief Get decode counters and latency
+     */
+    VideoDecoderStats getStats() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+}  // namespace source
+}  // namespace obswebrtc
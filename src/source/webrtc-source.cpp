@@ -113,6 +113,20 @@ public:
         return connectionState_;
     }
 
+    bool requestKeyframe()
+    {
+        // Called from the receive thread, which stop() joins while holding
+        // mutex_: skip the request rather than wait for it
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return false;
+        }
+        if (whepClient_) {
+            return whepClient_->requestKeyframe();
+        }
+        return peerConnection_ && peerConnection_->requestKeyframe();
+    }
+
 private:
     bool startWHEPMode()
     {
@@ -147,7 +161,7 @@ private:
         // This ensures PeerConnection is only created when media reception is needed
         if (config_.videoCallback) {
             whepConfig.videoFrameCallback = [this](const core::VideoFrame& coreFrame) {
-                // Convert core::VideoFrame to source::VideoFrame
+                // Convert core::VideoFrame to source::VideoFrame; the payload is shared
                 source::VideoFrame sourceFrame;
                 sourceFrame.data = coreFrame.data;
                 sourceFrame.width = coreFrame.width;
@@ -160,7 +174,7 @@ private:
 
         if (config_.audioCallback) {
             whepConfig.audioFrameCallback = [this](const core::AudioFrame& coreFrame) {
-                // Convert core::AudioFrame to source::AudioFrame
+                // Convert core::AudioFrame to source::AudioFrame; the payload is shared
                 source::AudioFrame sourceFrame;
                 sourceFrame.data = coreFrame.data;
                 sourceFrame.sampleRate = coreFrame.sampleRate;
@@ -319,7 +333,7 @@ private:
         // Setup video frame callback
         pcConfig.videoFrameCallback = [this](const core::VideoFrame& coreFrame) {
             if (config_.videoCallback) {
-                // Convert core::VideoFrame to source::VideoFrame
+                // Convert core::VideoFrame to source::VideoFrame; the payload is shared
                 source::VideoFrame sourceFrame;
                 sourceFrame.data = coreFrame.data;
                 sourceFrame.width = coreFrame.width;
@@ -333,7 +347,7 @@ private:
         // Setup audio frame callback
         pcConfig.audioFrameCallback = [this](const core::AudioFrame& coreFrame) {
             if (config_.audioCallback) {
-                // Convert core::AudioFrame to source::AudioFrame
+                // Convert core::AudioFrame to source::AudioFrame; the payload is shared
                 source::AudioFrame sourceFrame;
                 sourceFrame.data = coreFrame.data;
                 sourceFrame.sampleRate = coreFrame.sampleRate;
@@ -446,5 +460,10 @@ ConnectionState WebRTCSource::getConnectionState() const
     return pImpl->getConnectionState();
 }
 
+bool WebRTCSource::requestKeyframe()
+{
+    return pImpl->requestKeyframe();
+}
+
 } // namespace source
 } // namespace obswebrtc
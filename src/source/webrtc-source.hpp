@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "core/buffer-pool.hpp"
+
 #include <string>
 #include <vector>
 #include <functional>
@@ -44,9 +46,12 @@ enum class ConnectionState {
 
 /**
  * @brief Video frame structure
+ *
+ * `data` shares the buffer the frame was received into, so frames can be
+ * copied and queued without copying the payload.
  */
 struct VideoFrame {
-    std::vector<uint8_t> data;
+    core::BufferSlice data;
     uint32_t width;
     uint32_t height;
     uint64_t timestamp;
@@ -55,9 +60,11 @@ struct VideoFrame {
 
 /**
  * @brief Audio frame structure
+ *
+ * `data` shares the received buffer, like VideoFrame.
  */
 struct AudioFrame {
-    std::vector<uint8_t> data;
+    core::BufferSlice data;
     uint32_t sampleRate;
     uint32_t channels;
     uint64_t timestamp;
@@ -147,6 +154,16 @@ public:
      */
     ConnectionState getConnectionState() const;
 
+    /**
+     * @brief Ask the sender for a keyframe on the received video track
+     *
+     * For consumers that skip frames until the next keyframe, such as the
+     * video decoder after its queue overflowed. Throttled by the connection.
+     *
+     * @return true if a request was sent
+     */
+    bool requestKeyframe();
+
 private:
     class Impl;
     std::unique_ptr<Impl> pImpl;
@@ -4,9 +4,51 @@
  */
 
 #include <benchmark/benchmark.h>
+#include "core/audio-resampler.hpp"
+#include "core/bitstream-inspector.hpp"
+#include "core/buffer-pool.hpp"
+#include "core/fec-encoder.hpp"
+#include "core/frame-drop-policy.hpp"
+#include "core/nal-parser.hpp"
+#include "core/pacer.hpp"
+#include "core/peer-connection.hpp"
+#include "core/rtp-packet-history.hpp"
+#include "core/rtp-packetizer.hpp"
+#include "core/yuv-converter.hpp"
+#include "source/webrtc-source.hpp"
 #include <vector>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <new>
+#include <queue>
 #include <random>
+#include <thread>
+
+using obswebrtc::core::NalUnitView;
+using obswebrtc::core::SimdLevel;
+
+// Heap allocations made by this process, for benchmarks reporting allocations per item
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
 
 // Simulate media data encoding
 static void BM_MediaDataEncoding(benchmark::State& state) {
@@ -170,3 +212,652 @@ static void BM_ConcurrentFrameProcessing(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * num_frames);
 }
 BENCHMARK(BM_ConcurrentFrameProcessing)->Range(1, 30)->Unit(benchmark::kMillisecond);
+
+// Build a synthetic H.264 keyframe: SPS, PPS and 8 IDR slices of random,
+// emulation-prevented payload (about 1.5 bits per pixel)
+static std::vector<uint8_t> MakeAnnexBKeyframe(int width, int height) {
+    const size_t frame_size = static_cast<size_t>(width) * height * 3 / 16;
+    const int slice_count = 8;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, 255);
+
+    std::vector<uint8_t> frame = {0, 0, 0, 1, 0x67, 0x64, 0x00, 0x28, 0xAC, 0xD9,
+                                  0, 0, 0, 1, 0x68, 0xEB, 0xE3, 0xCB, 0x22, 0xC0};
+    frame.reserve(frame_size + 64);
+    for (int slice = 0; slice < slice_count; slice++) {
+        frame.insert(frame.end(), {0, 0, 1, 0x65});
+        const size_t end = frame_size * (slice + 1) / slice_count;
+        while (frame.size() < end) {
+            uint8_t byte = static_cast<uint8_t>(dis(gen));
+            // Emulation prevention: no 00 00 0x inside a NAL unit
+            if (byte <= 3 && frame[frame.size() - 1] == 0 && frame[frame.size() - 2] == 0) {
+                frame.push_back(3);
+            }
+            frame.push_back(byte);
+        }
+        frame.back() |= 0x80;  // rbsp_stop_one_bit: a NAL unit never ends in 00
+    }
+    return frame;
+}
+
+// Byte-by-byte start code search for comparison
+static size_t NaiveFindStartCode(const uint8_t* data, size_t size) {
+    for (size_t i = 0; i + 2 < size; i++) {
+        if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+            return i;
+        }
+    }
+    return size;
+}
+
+// Scan a whole keyframe for start codes with the naive byte loop
+static void BM_AnnexBScanNaive(benchmark::State& state) {
+    const auto frame = MakeAnnexBKeyframe(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+        size_t count = 0;
+        size_t pos = 0;
+        while (pos < frame.size()) {
+            pos += NaiveFindStartCode(frame.data() + pos, frame.size() - pos) + 3;
+            count++;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+
+    state.SetBytesProcessed(state.iterations() * frame.size());
+}
+// 1080p and 4K keyframes
+BENCHMARK(BM_AnnexBScanNaive)->Args({1920, 1080})->Args({3840, 2160})->Unit(benchmark::kMicrosecond);
+
+// Scan a whole keyframe for start codes with a specific kernel
+static void BM_AnnexBScan(benchmark::State& state) {
+    const auto frame = MakeAnnexBKeyframe(state.range(0), state.range(1));
+    const auto level = static_cast<SimdLevel>(state.range(2));
+    if (!obswebrtc::core::isSimdLevelSupported(level)) {
+        state.SkipWithError("SIMD level not supported on this CPU");
+        return;
+    }
+    state.SetLabel(obswebrtc::core::simdLevelName(level));
+
+    for (auto _ : state) {
+        size_t count = 0;
+        size_t pos = 0;
+        while (pos < frame.size()) {
+            pos += obswebrtc::core::findAnnexBStartCode(frame.data() + pos, frame.size() - pos,
+                                                        level) + 3;
+            count++;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+
+    state.SetBytesProcessed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_AnnexBScan)
+    ->ArgsProduct({{1920}, {1080}, {0, 1, 2, 3}})
+    ->ArgsProduct({{3840}, {2160}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Split a keyframe into NAL unit views with the dispatched kernel
+static void BM_AnnexBSplit(benchmark::State& state) {
+    const auto frame = MakeAnnexBKeyframe(state.range(0), state.range(1));
+    std::vector<NalUnitView> nal_units;
+
+    for (auto _ : state) {
+        obswebrtc::core::splitAnnexB(frame.data(), frame.size(), nal_units);
+        benchmark::DoNotOptimize(nal_units.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * frame.size());
+    state.SetItemsProcessed(state.iterations() * nal_units.size());
+}
+BENCHMARK(BM_AnnexBSplit)->Args({1920, 1080})->Args({3840, 2160})->Unit(benchmark::kMicrosecond);
+
+// Build a synthetic 4K keyframe for the given codec (0 = VP8, 1 = VP9, 2 = AV1)
+static std::vector<uint8_t> MakeVideoKeyframe(int codec, int width, int height) {
+    const size_t frame_size = static_cast<size_t>(width) * height * 3 / 16;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, 255);
+
+    std::vector<uint8_t> frame;
+    frame.reserve(frame_size + 1024);
+    if (codec != 2) {
+        while (frame.size() < frame_size) {
+            frame.push_back(static_cast<uint8_t>(dis(gen)));
+        }
+        frame[0] = codec == 0 ? 0x10 : 0x80;  // Key frame flag / VP9 frame marker
+        return frame;
+    }
+
+    // AV1 temporal unit: temporal delimiter, sequence header, then 64 kB tile groups
+    auto append_obu = [&frame, &gen, &dis](uint8_t type, size_t size) {
+        frame.push_back(static_cast<uint8_t>((type << 3) | 0x02));
+        size_t value = size;
+        while (value >= 0x80) {
+            frame.push_back(static_cast<uint8_t>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        frame.push_back(static_cast<uint8_t>(value));
+        for (size_t i = 0; i < size; i++) {
+            frame.push_back(static_cast<uint8_t>(dis(gen)));
+        }
+    };
+    append_obu(2, 0);
+    append_obu(1, 12);
+    append_obu(3, 40);
+    while (frame.size() < frame_size) {
+        append_obu(4, 64 * 1024);
+    }
+    return frame;
+}
+
+// Packetize a 4K keyframe into RTP payloads (0 = VP8, 1 = VP9, 2 = AV1, 3 = H.264)
+static void BM_RtpPacketize(benchmark::State& state) {
+    const int codec = static_cast<int>(state.range(0));
+    const auto frame = codec == 3 ? MakeAnnexBKeyframe(3840, 2160) : MakeVideoKeyframe(codec, 3840, 2160);
+
+    std::unique_ptr<obswebrtc::core::VideoRtpPacketizer> packetizer;
+    switch (codec) {
+        case 0:
+            packetizer = std::make_unique<obswebrtc::core::Vp8RtpPacketizer>();
+            state.SetLabel("vp8");
+            break;
+        case 1:
+            packetizer = std::make_unique<obswebrtc::core::Vp9RtpPacketizer>();
+            state.SetLabel("vp9");
+            break;
+        case 2:
+            packetizer = std::make_unique<obswebrtc::core::Av1RtpPacketizer>();
+            state.SetLabel("av1");
+            break;
+        default:
+            packetizer = std::make_unique<obswebrtc::core::H264RtpPacketizer>();
+            state.SetLabel("h264");
+            break;
+    }
+
+    obswebrtc::core::PacketizedFrame out;
+    size_t packets = 0;
+    for (auto _ : state) {
+        packetizer->packetize(frame.data(), frame.size(), out);
+        packets += out.payloads.size();
+        benchmark::DoNotOptimize(out.buffer.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * frame.size());
+    // Items are RTP packets, so items_per_second reads as packets/second
+    state.SetItemsProcessed(packets);
+}
+BENCHMARK(BM_RtpPacketize)->DenseRange(0, 3)->Unit(benchmark::kMicrosecond);
+
+// What one destination does with a packetized frame: its own RTP header on a
+// copy of every payload (the copy SRTP then encrypts in place)
+static size_t SendToDestination(const obswebrtc::core::PacketizedFrame& frame, uint32_t ssrc,
+                                uint16_t& sequence, std::vector<std::vector<uint8_t>>& packets) {
+    size_t bytes = 0;
+    for (size_t i = 0; i < frame.payloads.size(); i++) {
+        const auto& payload = frame.payloads[i];
+        auto& packet = packets[i % packets.size()];
+        packet.resize(obswebrtc::core::constants::kRtpHeaderSize + payload.size);
+        obswebrtc::core::writeRtpHeader(packet.data(), 96, payload.marker, sequence++, 90000, ssrc);
+        std::memcpy(packet.data() + obswebrtc::core::constants::kRtpHeaderSize, frame.data(payload),
+                    payload.size);
+        bytes += packet.size();
+    }
+    return bytes;
+}
+
+// Send a 1080p H.264 keyframe to N destinations. Mode 0 runs a full
+// packetization per destination (N separate outputs), mode 1 packetizes once
+// and only rewrites headers per destination (fan-out). The difference between
+// N and N+1 destinations is the cost of one more destination.
+static void BM_RtpFanout(benchmark::State& state) {
+    const int destinations = static_cast<int>(state.range(0));
+    const bool shared = state.range(1) != 0;
+    const auto frame = MakeAnnexBKeyframe(1920, 1080);
+    state.SetLabel(shared ? "packetize once" : "packetize per destination");
+
+    std::vector<obswebrtc::core::H264RtpPacketizer> packetizers(shared ? 1 : destinations);
+    std::vector<obswebrtc::core::PacketizedFrame> frames(packetizers.size());
+    std::vector<uint16_t> sequences(destinations, 0);
+    std::vector<std::vector<uint8_t>> packets(64);
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        if (shared) {
+            packetizers[0].packetize(frame.data(), frame.size(), frames[0]);
+        }
+        for (int d = 0; d < destinations; d++) {
+            if (!shared) {
+                packetizers[d].packetize(frame.data(), frame.size(), frames[d]);
+            }
+            bytes += SendToDestination(frames[shared ? 0 : d], 0x1000 + d, sequences[d], packets);
+        }
+        benchmark::DoNotOptimize(packets.data());
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.counters["destinations"] = destinations;
+}
+BENCHMARK(BM_RtpFanout)
+    ->ArgsProduct({{1, 2, 4, 8}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Keep every packet of a 1080p H.264 keyframe in the retransmission history,
+// then answer a NACK for 5% of them with RTX. Storing is one copy into a
+// preallocated slot; nothing is allocated per packet.
+static void BM_RtpHistory(benchmark::State& state) {
+    const auto frame = MakeAnnexBKeyframe(1920, 1080);
+    obswebrtc::core::H264RtpPacketizer packetizer;
+    obswebrtc::core::PacketizedFrame packetized;
+    packetizer.packetize(frame.data(), frame.size(), packetized);
+
+    obswebrtc::core::RtpPacketHistory history;
+    std::vector<std::vector<uint8_t>> packets(64);
+    std::vector<uint8_t> rtx(obswebrtc::core::constants::kMaxRtpPacketSize +
+                             obswebrtc::core::constants::kRtxOverheadSize);
+    uint16_t sequence = 0;
+    int64_t nowMs = 0;
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        const uint16_t first = sequence;
+        SendToDestination(packetized, 0x1000, sequence, packets);
+        for (size_t i = 0; i < packetized.payloads.size(); i++) {
+            const auto& packet = packets[i % packets.size()];
+            history.store(packet.data(), packet.size(), nowMs);
+            bytes += packet.size();
+        }
+        for (size_t i = 0; i < packetized.payloads.size(); i += 20) {
+            const auto lost = static_cast<uint16_t>(first + i);
+            size_t size = 0;
+            if (const uint8_t* packet = history.find(lost, nowMs, size)) {
+                obswebrtc::core::writeRtxPacket(packet, size, 97, lost, 0x2000, rtx.data());
+            }
+        }
+        benchmark::DoNotOptimize(rtx.data());
+        nowMs += 16;
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.counters["history_packets"] = static_cast<double>(history.getCapacity());
+}
+BENCHMARK(BM_RtpHistory)->Unit(benchmark::kMicrosecond);
+
+// XOR one full-size RTP payload into a FEC parity with a specific kernel
+static void BM_FecXor(benchmark::State& state) {
+    const auto level = static_cast<SimdLevel>(state.range(0));
+    if (!obswebrtc::core::isSimdLevelSupported(level)) {
+        state.SkipWithError("SIMD level not supported on this CPU");
+        return;
+    }
+    state.SetLabel(obswebrtc::core::simdLevelName(level));
+
+    const size_t size = obswebrtc::core::constants::kMaxRtpPacketSize -
+                        obswebrtc::core::constants::kRtpHeaderSize;
+    std::vector<uint8_t> parity(size, 0x5A);
+    std::vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; i++) {
+        payload[i] = static_cast<uint8_t>(i * 31);
+    }
+
+    for (auto _ : state) {
+        obswebrtc::core::xorBytes(parity.data(), payload.data(), size, level);
+        benchmark::DoNotOptimize(parity.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_FecXor)->DenseRange(0, 3);
+
+// Protect every packet of a 1080p H.264 keyframe with FlexFEC at N% overhead
+static void BM_FecEncode(benchmark::State& state) {
+    const auto frame = MakeAnnexBKeyframe(1920, 1080);
+    obswebrtc::core::H264RtpPacketizer packetizer;
+    obswebrtc::core::PacketizedFrame packetized;
+    packetizer.packetize(frame.data(), frame.size(), packetized);
+
+    obswebrtc::core::FlexFecConfig config;
+    config.mediaSsrc = 0x1000;
+    config.fecSsrc = 0x3000;
+    config.protectionRatio = static_cast<double>(state.range(0)) / 100.0;
+    obswebrtc::core::FlexFecEncoder encoder(config);
+
+    std::vector<std::vector<uint8_t>> packets(packetized.payloads.size());
+    std::vector<uint8_t> fec;
+    uint16_t sequence = 0;
+    size_t bytes = 0;
+    size_t fecPackets = 0;
+    for (auto _ : state) {
+        bytes += SendToDestination(packetized, config.mediaSsrc, sequence, packets);
+        for (const auto& packet : packets) {
+            fecPackets += encoder.addPacket(packet.data(), packet.size(), fec) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(fec.data());
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.counters["fec_per_frame"] =
+        static_cast<double>(fecPackets) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_FecEncode)->Arg(10)->Arg(25)->Arg(50)->Unit(benchmark::kMicrosecond);
+
+// Benchmark pacer egress at 1080p60 (6 Mbps) and 4K60 (20 Mbps): one second
+// of 60 fps frames in 1200-byte RTP packets, paced at the default 2.5x.
+// rounds_per_s counts the pacer's release rounds (sends separated by a sleep),
+// i.e. how often it wakes to hand packets to the transport. Args are
+// bitrate in kbps and the release tick in ms (0 = one wakeup per packet).
+static void BM_PacerEgress(benchmark::State& state) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kFps = 60;
+    constexpr size_t kPacketSize = 1200;
+    const int bitrateKbps = static_cast<int>(state.range(0));
+    const size_t frameBytes = static_cast<size_t>(bitrateKbps) * 1000 / 8 / kFps;
+    const size_t packetsPerFrame = (frameBytes + kPacketSize - 1) / kPacketSize;
+
+    obswebrtc::core::PacerConfig config;
+    config.targetBitrateKbps = bitrateKbps;
+    config.batchIntervalMs = static_cast<int>(state.range(1));
+
+    int64_t packets = 0;
+    int64_t rounds = 0;
+    for (auto _ : state) {
+        obswebrtc::core::Pacer pacer(config);
+        std::atomic<int64_t> sent{0};
+        std::atomic<int64_t> released{0};
+        Clock::time_point lastSend;  // Only touched on the pacer thread
+
+        const auto start = Clock::now();
+        for (int frame = 0; frame < kFps; frame++) {
+            for (size_t i = 0; i < packetsPerFrame; i++) {
+                pacer.enqueue(obswebrtc::core::PacerLane::Video, kPacketSize, [&]() {
+                    const auto now = Clock::now();
+                    if (now - lastSend > std::chrono::microseconds(100)) {
+                        released++;
+                    }
+                    lastSend = now;
+                    sent++;
+                });
+            }
+            std::this_thread::sleep_until(start + std::chrono::microseconds(1000000 / kFps) * (frame + 1));
+        }
+        while (sent.load() < static_cast<int64_t>(packetsPerFrame) * kFps) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        packets += sent.load();
+        rounds += released.load();
+    }
+
+    state.SetItemsProcessed(packets);
+    state.counters["rounds_per_s"] = benchmark::Counter(static_cast<double>(rounds),
+                                                        benchmark::Counter::kAvgIterations);
+    state.counters["packets_per_round"] =
+        static_cast<double>(packets) / static_cast<double>(rounds);
+}
+BENCHMARK(BM_PacerEgress)
+    ->Args({6000, 0})->Args({6000, 2})->Args({20000, 0})->Args({20000, 2})
+    ->Iterations(1)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Frame types of the receive path before pooling: every stage owned a vector
+struct VectorVideoFrame {
+    std::vector<uint8_t> data;
+    uint64_t timestamp = 0;
+};
+
+// Carry received 1080p60 H.264 frames (a 120 KB keyframe every 60 frames,
+// 16 KB otherwise) through the receive path: PeerConnection copies out of the
+// network buffer, WebRTCSource converts to its frame type, and the OBS source
+// queues it until the render thread takes it (two frames in flight). Mode 0
+// uses a std::vector per stage, mode 1 pooled BufferSlices. Reports heap
+// allocations and payload copies per frame.
+static void BM_ReceivePath(benchmark::State& state) {
+    const bool pooled = state.range(0) == 1;
+    std::vector<uint8_t> keyframe(120 * 1024, 0x65);
+    std::vector<uint8_t> delta(16 * 1024, 0x41);
+
+    obswebrtc::core::BufferPool pool;
+    std::queue<obswebrtc::source::VideoFrame> pooledQueue;
+    std::queue<VectorVideoFrame> vectorQueue;
+
+    uint64_t frames = 0;
+    uint64_t copiedBytes = 0;
+    uint64_t receivedBytes = 0;
+    uint64_t allocations = 0;
+    for (auto _ : state) {
+        const std::vector<uint8_t>& network = frames % 60 == 0 ? keyframe : delta;
+        const uint64_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+
+        if (pooled) {
+            obswebrtc::core::VideoFrame coreFrame;
+            coreFrame.data = pool.copy(network.data(), network.size());
+            coreFrame.timestamp = frames;
+            copiedBytes += network.size();
+
+            obswebrtc::source::VideoFrame sourceFrame;
+            sourceFrame.data = coreFrame.data;
+            sourceFrame.timestamp = coreFrame.timestamp;
+
+            pooledQueue.push(sourceFrame);
+            if (pooledQueue.size() > 2) {
+                benchmark::DoNotOptimize(pooledQueue.front().data.data());
+                pooledQueue.pop();
+            }
+        } else {
+            VectorVideoFrame coreFrame;
+            coreFrame.data.assign(network.begin(), network.end());
+            coreFrame.timestamp = frames;
+
+            VectorVideoFrame sourceFrame;
+            sourceFrame.data = coreFrame.data;
+            sourceFrame.timestamp = coreFrame.timestamp;
+
+            vectorQueue.push(sourceFrame);
+            copiedBytes += 3 * network.size();
+            if (vectorQueue.size() > 2) {
+                benchmark::DoNotOptimize(vectorQueue.front().data.data());
+                vectorQueue.pop();
+            }
+        }
+
+        allocations += g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+        receivedBytes += network.size();
+        frames++;
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(frames));
+    state.counters["allocs_per_frame"] =
+        static_cast<double>(allocations) / static_cast<double>(frames);
+    state.counters["copies_per_frame"] =
+        static_cast<double>(copiedBytes) / static_cast<double>(receivedBytes);
+}
+BENCHMARK(BM_ReceivePath)->Arg(0)->Arg(1);
+
+// Keyframe flag and resolution of received 1080p60 H.264 frames (SPS, PPS and
+// a 120 KB IDR every 60 frames, 16 KB non-IDR slices otherwise). Mode 0 is the
+// keyframe-only NAL classification the receive path used before, mode 1 the
+// BitstreamInspector, which also reads the SPS resolution but parses it only
+// when it changes. Only headers are read, so the cost does not grow with the
+// frame size.
+static void BM_BitstreamInspect(benchmark::State& state) {
+    const bool inspect = state.range(0) == 1;
+    // Baseline SPS for 1920x1088 cropped to 1080
+    const std::vector<uint8_t> sps = {0x67, 0x42, 0x00, 0x28, 0xEC, 0xA0,
+                                      0x3C, 0x01, 0x13, 0xF2, 0xA0};
+    const std::vector<uint8_t> pps = {0x68, 0xCE, 0x3C, 0x80};
+
+    std::vector<uint8_t> keyframe;
+    for (const auto* nal : {&sps, &pps}) {
+        keyframe.insert(keyframe.end(), {0, 0, 0, 1});
+        keyframe.insert(keyframe.end(), nal->begin(), nal->end());
+    }
+    keyframe.insert(keyframe.end(), {0, 0, 0, 1, 0x65});
+    keyframe.resize(keyframe.size() + 120 * 1024, 0x88);
+    std::vector<uint8_t> delta = {0, 0, 0, 1, 0x41};
+    delta.resize(delta.size() + 16 * 1024, 0x9A);
+
+    obswebrtc::core::BitstreamInspector inspector(obswebrtc::core::BitstreamCodec::H264);
+    uint64_t frames = 0;
+    for (auto _ : state) {
+        const std::vector<uint8_t>& frame = frames % 60 == 0 ? keyframe : delta;
+        if (inspect) {
+            benchmark::DoNotOptimize(inspector.inspect(frame.data(), frame.size()));
+        } else {
+            benchmark::DoNotOptimize(
+                obswebrtc::core::classifyH264Frame(frame.data(), frame.size()));
+        }
+        frames++;
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(frames));
+    if (inspect) {
+        const obswebrtc::core::BitstreamInspectorStats stats = inspector.getStats();
+        state.counters["sps_parsed"] = static_cast<double>(stats.headersParsed);
+        state.counters["sps_cached"] = static_cast<double>(stats.headersCached);
+    }
+}
+BENCHMARK(BM_BitstreamInspect)->Arg(0)->Arg(1);
+
+// Resampler filter taps for one output sample with a specific kernel: two
+// dot products over kResamplerTaps, one per neighbouring filter phase
+static void BM_ResamplerDot(benchmark::State& state) {
+    const auto level = static_cast<SimdLevel>(state.range(0));
+    if (!obswebrtc::core::isSimdLevelSupported(level)) {
+        state.SkipWithError("SIMD level not supported on this CPU");
+        return;
+    }
+    state.SetLabel(obswebrtc::core::simdLevelName(level));
+
+    const size_t taps = obswebrtc::core::constants::kResamplerTaps;
+    std::vector<float> samples(taps);
+    std::vector<float> lower(taps);
+    std::vector<float> upper(taps);
+    for (size_t i = 0; i < taps; i++) {
+        samples[i] = static_cast<float>(i % 7) * 0.1f;
+        lower[i] = 1.0f / static_cast<float>(i + 1);
+        upper[i] = 1.0f / static_cast<float>(i + 2);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            obswebrtc::core::dotProduct(samples.data(), lower.data(), taps, level));
+        benchmark::DoNotOptimize(
+            obswebrtc::core::dotProduct(samples.data(), upper.data(), taps, level));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ResamplerDot)->DenseRange(0, 3);
+
+// Drift compensation of received audio: one 20 ms 48 kHz stereo Opus frame
+// through the adaptive resampler at 200 ppm. `realtime_load` is the share of
+// one core a stream takes.
+static void BM_AudioResample(benchmark::State& state) {
+    const size_t frames = 960;
+    obswebrtc::core::AdaptiveResampler resampler(2);
+    resampler.setRatio(1.0 + 200e-6);
+
+    std::vector<float> input[2];
+    std::vector<float> output[2];
+    for (size_t channel = 0; channel < 2; channel++) {
+        input[channel].resize(frames);
+        output[channel].resize(2 * frames);
+        for (size_t i = 0; i < frames; i++) {
+            input[channel][i] = static_cast<float>(std::sin(0.05 * static_cast<double>(i)));
+        }
+    }
+    const float* in[2] = {input[0].data(), input[1].data()};
+    float* out[2] = {output[0].data(), output[1].data()};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(resampler.process(in, frames, out, output[0].size()));
+    }
+
+    state.SetItemsProcessed(state.iterations() * frames);
+    state.counters["realtime_load"] = benchmark::Counter(
+        0.02, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_AudioResample)->Unit(benchmark::kMicrosecond);
+
+// A decoded picture of random samples, the Y plane followed by I420 or NV12 chroma
+static obswebrtc::core::YuvImage MakeYuvPicture(std::vector<uint8_t>& buffer, uint32_t width,
+                                                uint32_t height,
+                                                obswebrtc::core::YuvFormat format) {
+    const size_t chromaWidth = (width + 1) / 2;
+    const size_t chromaHeight = (height + 1) / 2;
+    buffer.resize(static_cast<size_t>(width) * height + 2 * chromaWidth * chromaHeight);
+    std::mt19937 random(7);
+    for (uint8_t& sample : buffer) {
+        sample = static_cast<uint8_t>(random());
+    }
+
+    obswebrtc::core::YuvImage image;
+    image.width = width;
+    image.height = height;
+    image.format = format;
+    image.planes[0] = buffer.data();
+    image.strides[0] = width;
+    image.planes[1] = buffer.data() + static_cast<size_t>(width) * height;
+    if (format == obswebrtc::core::YuvFormat::NV12) {
+        image.strides[1] = 2 * chromaWidth;
+    } else {
+        image.strides[1] = chromaWidth;
+        image.planes[2] = image.planes[1] + chromaWidth * chromaHeight;
+        image.strides[2] = chromaWidth;
+    }
+    return image;
+}
+
+// YUV to RGBA of a 1080p/4K picture on one thread per SIMD kernel (same levels
+// as BM_AnnexBScan), I420 (0) or NV12 (1); items are pixels
+static void BM_YuvToRgb(benchmark::State& state) {
+    const auto width = static_cast<uint32_t>(state.range(0));
+    const auto height = static_cast<uint32_t>(state.range(1));
+    const auto level = static_cast<SimdLevel>(state.range(2));
+    const auto format = static_cast<obswebrtc::core::YuvFormat>(state.range(3));
+    if (!obswebrtc::core::isSimdLevelSupported(level)) {
+        state.SkipWithError("SIMD level not supported on this CPU");
+        return;
+    }
+    state.SetLabel(obswebrtc::core::simdLevelName(level));
+
+    std::vector<uint8_t> buffer;
+    const auto image = MakeYuvPicture(buffer, width, height, format);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+
+    for (auto _ : state) {
+        obswebrtc::core::convertYuvToRgb(image, obswebrtc::core::RgbConversion(), rgba.data(),
+                                         width * 4, level);
+        benchmark::DoNotOptimize(rgba.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * width * height);
+}
+BENCHMARK(BM_YuvToRgb)
+    ->ArgsProduct({{1920}, {1080}, {0, 1, 2, 3}, {0, 1}})
+    ->ArgsProduct({{3840}, {2160}, {0, 1, 2, 3}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// The same through YuvConverter with the best kernel, split across
+// <threads> row bands; wall time, since the helpers do most of the work
+static void BM_YuvToRgbParallel(benchmark::State& state) {
+    const auto width = static_cast<uint32_t>(state.range(0));
+    const auto height = static_cast<uint32_t>(state.range(1));
+    const auto threads = static_cast<size_t>(state.range(2));
+
+    std::vector<uint8_t> buffer;
+    const auto image = MakeYuvPicture(buffer, width, height, obswebrtc::core::YuvFormat::I420);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    obswebrtc::core::YuvConverter converter(threads);
+
+    for (auto _ : state) {
+        converter.convert(image, obswebrtc::core::RgbConversion(), rgba.data(), width * 4);
+        benchmark::DoNotOptimize(rgba.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * width * height);
+}
+BENCHMARK(BM_YuvToRgbParallel)
+    ->ArgsProduct({{1920}, {1080}, {1, 2, 4, 8}})
+    ->ArgsProduct({{3840}, {2160}, {1, 2, 4, 8}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -5,6 +5,11 @@
 
 #include <benchmark/benchmark.h>
 #include "core/whip-client.hpp"
+#include "core/http-client.hpp"
+
+#include <chrono>
+#include <future>
+#include <thread>
 
 using namespace obswebrtc::core;
 
@@ -127,3 +132,73 @@ static void BM_WHIPConfigCopy(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations());
 }
 BENCHMARK(BM_WHIPConfigCopy);
+
+// Fake WHIP server for BM_WHIPOfferExchange: answers every request after a
+// 20 ms round trip, like a distant SFU
+static HTTPResponse slowWhipServer(const std::string& method, const std::string& url,
+                                   const HTTPRequest&) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    HTTPResponse response;
+    if (method == "POST") {
+        response.statusCode = 201;
+        response.headers["Location"] = url + "/resource/123";
+        response.headers["Content-Type"] = "application/sdp";
+        response.body = "v=0\r\no=- 789 012 IN IP4 0.0.0.0\r\n";
+    } else {
+        response.statusCode = method == "PATCH" ? 204 : 200;
+    }
+    return response;
+}
+
+// Benchmark how long the offer exchange holds libdatachannel's callback thread
+// against slowWhipServer. The callback thread delivers the offer, then the
+// candidates gathered meanwhile; callback_ms is how long it stays busy,
+// answer_ms when the answer is in.
+// Arg 0 = sendOffer/sendIceCandidate, 1 = sendOfferAsync/sendIceCandidateAsync
+static void BM_WHIPOfferExchange(benchmark::State& state) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int kCandidates = 4;
+    const bool async = state.range(0) != 0;
+
+    HTTPClient::setTransport(slowWhipServer);
+    WHIPConfig config;
+    config.url = "https://example.com/whip";
+    const std::string offer = "v=0\r\no=- 123 456 IN IP4 0.0.0.0\r\n";
+    const std::string candidate = "candidate:1 1 UDP 2130706431 192.168.1.1 54321 typ host";
+
+    double callbackSeconds = 0.0;
+    double answerSeconds = 0.0;
+    for (auto _ : state) {
+        WHIPClient client(config);
+
+        const auto start = Clock::now();
+        std::future<std::string> answer;
+        if (async) {
+            answer = client.sendOfferAsync(offer);
+            for (int i = 0; i < kCandidates; ++i) {
+                client.sendIceCandidateAsync(candidate, "0");
+            }
+        } else {
+            client.sendOffer(offer);
+            for (int i = 0; i < kCandidates; ++i) {
+                client.sendIceCandidate(candidate, "0");
+            }
+        }
+        const auto released = Clock::now();
+
+        if (async) {
+            answer.wait();
+        }
+        callbackSeconds += std::chrono::duration<double>(released - start).count();
+        answerSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        client.disconnect();
+    }
+
+    state.counters["callback_ms"] =
+        benchmark::Counter(callbackSeconds * 1000.0, benchmark::Counter::kAvgIterations);
+    state.counters["answer_ms"] =
+        benchmark::Counter(answerSeconds * 1000.0, benchmark::Counter::kAvgIterations);
+    HTTPClient::setTransport(nullptr);
+}
+BENCHMARK(BM_WHIPOfferExchange)->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,377 @@
+/**
+ * @file audio_decoder_test.cpp
+ * @brief Unit tests for the Opus audio decoding stage
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "source/audio-decoder.hpp"
+
+#include <opus.h>
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace obswebrtc::source;
+using namespace testing;
+
+namespace {
+
+constexpr int kFrameSamples = 960;  // 20 ms at 48 kHz
+constexpr uint64_t kFrameNs = 20000000;
+
+/**
+ * @brief Encodes a stereo 440 Hz tone into 20 ms Opus packets with in-band FEC
+ */
+class ToneEncoder {
+public:
+    ToneEncoder() {
+        int error = OPUS_OK;
+        encoder_ = opus_encoder_create(48000, 2, OPUS_APPLICATION_VOIP, &error);
+        if (!encoder_ || error != OPUS_OK) {
+            throw std::runtime_error("Failed to create the Opus encoder");
+        }
+        opus_encoder_ctl(encoder_, OPUS_SET_BITRATE(32000));
+        opus_encoder_ctl(encoder_, OPUS_SET_INBAND_FEC(1));
+        opus_encoder_ctl(encoder_, OPUS_SET_PACKET_LOSS_PERC(30));
+    }
+
+    ~ToneEncoder() { opus_encoder_destroy(encoder_); }
+
+    std::vector<uint8_t> next() {
+        std::vector<float> pcm(kFrameSamples * 2);
+        for (int i = 0; i < kFrameSamples; i++) {
+            const float value = 0.5f * std::sin(2.0f * 3.14159265f * 440.0f *
+                                                static_cast<float>(sample_++) / 48000.0f);
+            pcm[2 * i] = value;
+            pcm[2 * i + 1] = value;
+        }
+        std::vector<uint8_t> packet(1500);
+        const opus_int32 size =
+            opus_encode_float(encoder_, pcm.data(), kFrameSamples, packet.data(),
+                              static_cast<opus_int32>(packet.size()));
+        packet.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        return packet;
+    }
+
+private:
+    OpusEncoder* encoder_ = nullptr;
+    uint64_t sample_ = 0;
+};
+
+AudioFrame audioFrame(const std::vector<uint8_t>& packet, uint32_t rtpTimestamp,
+                      uint32_t channels = 2) {
+    AudioFrame frame;
+    frame.data = obswebrtc::core::BufferSlice::copyOf(packet.data(), packet.size());
+    frame.sampleRate = 48000;
+    frame.channels = channels;
+    frame.timestamp = rtpTimestamp;
+    return frame;
+}
+
+}  // namespace
+
+/**
+ * @brief Test fixture for AudioDecoder tests
+ */
+class AudioDecoderTest : public ::testing::Test {
+protected:
+    struct Chunk {
+        uint32_t frames;
+        uint32_t channels;
+        uint64_t timestampNs;
+        bool concealed;
+        bool planar;  // Every plane set and distinct
+        double rms;
+    };
+
+    AudioDecoderConfig config() {
+        AudioDecoderConfig config;
+        config.frameCallback = [this](const DecodedAudioFrame& decoded) {
+            Chunk chunk = {decoded.frames, decoded.channels, decoded.timestampNs,
+                           decoded.concealed, true, 0.0};
+            double energy = 0.0;
+            for (uint32_t channel = 0; channel < decoded.channels; channel++) {
+                chunk.planar = chunk.planar && decoded.planes[channel] &&
+                               (channel == 0 || decoded.planes[channel] != decoded.planes[0]);
+                for (uint32_t i = 0; decoded.planes[channel] && i < decoded.frames; i++) {
+                    energy += decoded.planes[channel][i] * decoded.planes[channel][i];
+                }
+            }
+            chunk.rms = std::sqrt(energy / (decoded.frames * decoded.channels));
+            std::lock_guard<std::mutex> lock(mutex_);
+            chunks_.push_back(chunk);
+            samples_ += decoded.frames;
+            condition_.notify_all();
+        };
+        return config;
+    }
+
+    bool waitForSamples(uint64_t count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return condition_.wait_for(lock, std::chrono::seconds(5),
+                                   [this, count]() { return samples_ >= count; });
+    }
+
+    bool waitForStats(const AudioDecoder& decoder, uint64_t packets) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            const AudioDecoderStats stats = decoder.getStats();
+            if (stats.packetsDecoded + stats.decodeErrors >= packets) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+    /**
+     * @brief Check that every chunk starts where the previous one ended
+     */
+    void expectContinuous(size_t from = 0) {
+        for (size_t i = from + 1; i < chunks_.size(); i++) {
+            const uint64_t expected =
+                chunks_[i - 1].timestampNs + chunks_[i - 1].frames * 1000000000ULL / 48000;
+            EXPECT_EQ(chunks_[i].timestampNs, expected) << "chunk " << i;
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::vector<Chunk> chunks_;
+    uint64_t samples_ = 0;
+};
+
+/**
+ * @brief Test that invalid configurations are rejected
+ */
+TEST_F(AudioDecoderTest, RejectsInvalidConfig) {
+    AudioDecoderConfig missingCallback;
+    EXPECT_THROW(AudioDecoder decoder(missingCallback), std::invalid_argument);
+
+    AudioDecoderConfig emptyQueue = config();
+    emptyQueue.queueFrames = 0;
+    EXPECT_THROW(AudioDecoder decoder(emptyQueue), std::invalid_argument);
+
+    AudioDecoderConfig surround = config();
+    surround.channels = 6;
+    EXPECT_THROW(AudioDecoder decoder(surround), std::invalid_argument);
+
+    AudioDecoderConfig cdRate = config();
+    cdRate.sampleRate = 44100;
+    EXPECT_THROW(AudioDecoder decoder(cdRate), std::invalid_argument);
+
+    AudioDecoderConfig negativeConceal = config();
+    negativeConceal.maxConcealMs = -1;
+    EXPECT_THROW(AudioDecoder decoder(negativeConceal), std::invalid_argument);
+}
+
+/**
+ * @brief Test that packets decode to planar float at the sender's timestamps
+ */
+TEST_F(AudioDecoderTest, DecodesPacketsToPlanarFloat) {
+    ToneEncoder encoder;
+    AudioDecoder decoder(config());
+    for (uint32_t i = 0; i < 5; i++) {
+        decoder.decode(audioFrame(encoder.next(), 48000 + i * kFrameSamples));
+    }
+    ASSERT_TRUE(waitForSamples(5 * kFrameSamples));
+
+    ASSERT_EQ(chunks_.size(), 5u);
+    EXPECT_EQ(chunks_[0].timestampNs, 1000000000u);
+    for (const Chunk& chunk : chunks_) {
+        EXPECT_EQ(chunk.frames, static_cast<uint32_t>(kFrameSamples));
+        EXPECT_EQ(chunk.channels, 2u);
+        EXPECT_TRUE(chunk.planar);
+        EXPECT_FALSE(chunk.concealed);
+    }
+    EXPECT_GT(chunks_.back().rms, 0.01);
+    expectContinuous();
+
+    const AudioDecoderStats stats = decoder.getStats();
+    EXPECT_EQ(stats.packetsDecoded, 5u);
+    EXPECT_EQ(stats.samplesDecoded, 5u * kFrameSamples);
+    EXPECT_EQ(stats.decodeErrors, 0u);
+    EXPECT_GE(stats.maxDecodeUs, stats.lastDecodeUs);
+    EXPECT_GT(stats.cpuLoad, 0.0);
+    EXPECT_LT(stats.cpuLoad, 1.0);
+}
+
+/**
+ * @brief Test that lost packets are filled by PLC and FEC without a timestamp gap
+ */
+TEST_F(AudioDecoderTest, ConcealsLostPackets) {
+    ToneEncoder encoder;
+    AudioDecoder decoder(config());
+    for (uint32_t i = 0; i < 10; i++) {
+        const std::vector<uint8_t> packet = encoder.next();
+        if (i == 4 || i == 5 || i == 6) {
+            continue;  // Lost
+        }
+        decoder.decode(audioFrame(packet, i * kFrameSamples));
+    }
+    ASSERT_TRUE(waitForSamples(10 * kFrameSamples));
+
+    expectContinuous();
+    EXPECT_EQ(chunks_.back().timestampNs, 9 * kFrameNs);
+    EXPECT_FALSE(chunks_.back().concealed);
+
+    const AudioDecoderStats stats = decoder.getStats();
+    EXPECT_EQ(stats.packetsDecoded, 7u);
+    EXPECT_EQ(stats.packetsConcealed + stats.packetsRecovered, 3u);
+    EXPECT_LE(stats.packetsRecovered, 1u);  // Only the frame just before a packet has FEC
+    EXPECT_EQ(stats.samplesDecoded, 10u * kFrameSamples);
+    EXPECT_EQ(stats.discontinuities, 0u);
+}
+
+/**
+ * @brief Test that an outage longer than maxConcealMs resumes without concealment
+ */
+TEST_F(AudioDecoderTest, ResumesAfterLongOutage) {
+    ToneEncoder encoder;
+    AudioDecoderConfig decoderConfig = config();
+    decoderConfig.maxConcealMs = 100;
+    AudioDecoder decoder(decoderConfig);
+
+    decoder.decode(audioFrame(encoder.next(), 0));
+    decoder.decode(audioFrame(encoder.next(), 48000));  // 980 ms later
+    ASSERT_TRUE(waitForSamples(2 * kFrameSamples));
+
+    ASSERT_EQ(chunks_.size(), 2u);
+    EXPECT_EQ(chunks_[1].timestampNs, 1000000000u);
+    const AudioDecoderStats stats = decoder.getStats();
+    EXPECT_EQ(stats.discontinuities, 1u);
+    EXPECT_EQ(stats.packetsConcealed + stats.packetsRecovered, 0u);
+}
+
+/**
+ * @brief Test that duplicate and stale packets are not played twice
+ */
+TEST_F(AudioDecoderTest, SkipsDuplicatePackets) {
+    ToneEncoder encoder;
+    AudioDecoder decoder(config());
+    const std::vector<uint8_t> first = encoder.next();
+    decoder.decode(audioFrame(first, 0));
+    decoder.decode(audioFrame(encoder.next(), kFrameSamples));
+    decoder.decode(audioFrame(first, 0));
+    decoder.decode(audioFrame(encoder.next(), 2 * kFrameSamples));
+    ASSERT_TRUE(waitForSamples(3 * kFrameSamples));
+    ASSERT_TRUE(waitForStats(decoder, 3));
+
+    EXPECT_EQ(chunks_.size(), 3u);
+    expectContinuous();
+}
+
+/**
+ * @brief Test that RTP timestamps keep increasing across a wrap
+ */
+TEST_F(AudioDecoderTest, UnwrapsRtpTimestamps) {
+    ToneEncoder encoder;
+    AudioDecoder decoder(config());
+    decoder.decode(audioFrame(encoder.next(), 0xFFFFFFFFu - kFrameSamples + 1));
+    decoder.decode(audioFrame(encoder.next(), 0));
+    ASSERT_TRUE(waitForSamples(2 * kFrameSamples));
+
+    ASSERT_EQ(chunks_.size(), 2u);
+    EXPECT_EQ(chunks_[1].timestampNs - chunks_[0].timestampNs, kFrameNs);
+}
+
+/**
+ * @brief Test mono output at a lower sample rate
+ */
+TEST_F(AudioDecoderTest, DecodesMonoAtLowerRate) {
+    ToneEncoder encoder;
+    AudioDecoderConfig decoderConfig = config();
+    decoderConfig.sampleRate = 16000;
+    decoderConfig.channels = 1;
+    AudioDecoder decoder(decoderConfig);
+
+    decoder.decode(audioFrame(encoder.next(), 0));
+    decoder.decode(audioFrame(encoder.next(), kFrameSamples));
+    ASSERT_TRUE(waitForSamples(640));
+
+    ASSERT_EQ(chunks_.size(), 2u);
+    EXPECT_EQ(chunks_[0].frames, 320u);
+    EXPECT_EQ(chunks_[0].channels, 1u);
+    EXPECT_TRUE(chunks_[0].planar);
+    EXPECT_EQ(chunks_[1].timestampNs, kFrameNs);  // Still on the 48 kHz RTP clock
+}
+
+/**
+ * @brief Test that the decoder follows the channel count the stream negotiated
+ */
+TEST_F(AudioDecoderTest, FollowsNegotiatedChannels) {
+    ToneEncoder encoder;
+    AudioDecoder decoder(config());
+
+    // Mono guest: decoded as mono although the decoder allows stereo
+    decoder.decode(audioFrame(encoder.next(), 0, 1));
+    decoder.decode(audioFrame(encoder.next(), kFrameSamples, 1));
+    ASSERT_TRUE(waitForSamples(2 * kFrameSamples));
+    EXPECT_EQ(decoder.getStats().channels, 1u);
+
+    // Renegotiated to stereo, then a frame without a negotiated count
+    decoder.decode(audioFrame(encoder.next(), 2 * kFrameSamples, 2));
+    decoder.decode(audioFrame(encoder.next(), 3 * kFrameSamples, 0));
+    ASSERT_TRUE(waitForSamples(4 * kFrameSamples));
+
+    ASSERT_EQ(chunks_.size(), 4u);
+    EXPECT_EQ(chunks_[0].channels, 1u);
+    EXPECT_EQ(chunks_[1].channels, 1u);
+    EXPECT_EQ(chunks_[2].channels, 2u);
+    EXPECT_EQ(chunks_[3].channels, 2u);
+    EXPECT_EQ(chunks_[2].timestampNs, 2 * kFrameNs);
+    EXPECT_EQ(decoder.getStats().channels, 2u);
+    EXPECT_EQ(decoder.getStats().decodeErrors, 0u);
+}
+
+/**
+ * @brief Test that a malformed packet is counted and decoding continues
+ */
+TEST_F(AudioDecoderTest, ReportsMalformedPackets) {
+    ToneEncoder encoder;
+    AudioDecoderConfig decoderConfig = config();
+    std::vector<std::string> errors;
+    std::mutex errorMutex;
+    decoderConfig.errorCallback = [&](const std::string& error) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        errors.push_back(error);
+    };
+    AudioDecoder decoder(decoderConfig);
+
+    // Code 3 packet claiming zero frames
+    decoder.decode(audioFrame({0xFB, 0x00}, 0));
+    decoder.decode(audioFrame(encoder.next(), kFrameSamples));
+    ASSERT_TRUE(waitForSamples(kFrameSamples));
+    ASSERT_TRUE(waitForStats(decoder, 2));
+
+    EXPECT_EQ(decoder.getStats().decodeErrors, 1u);
+    std::lock_guard<std::mutex> lock(errorMutex);
+    EXPECT_EQ(errors.size(), 1u);
+}
+
+/**
+ * @brief Test that the decoder starts a new timeline after a reset
+ */
+TEST_F(AudioDecoderTest, DecodesAfterReset) {
+    ToneEncoder encoder;
+    AudioDecoder decoder(config());
+    decoder.decode(audioFrame(encoder.next(), 0));
+    ASSERT_TRUE(waitForSamples(kFrameSamples));
+
+    decoder.reset();
+    decoder.decode(audioFrame(encoder.next(), 480000));
+    ASSERT_TRUE(waitForSamples(2 * kFrameSamples));
+
+    // No concealment across the reset
+    ASSERT_EQ(chunks_.size(), 2u);
+    EXPECT_EQ(chunks_[1].timestampNs, 10000000000u);
+    EXPECT_FALSE(chunks_[1].concealed);
+    EXPECT_EQ(decoder.getStats().discontinuities, 0u);
+}
@@ -0,0 +1,231 @@
+/**
+ * @file audio_resampler_test.cpp
+ * @brief Unit tests for the adaptive resampler and the dot product kernels
+ */
+
+#include <gtest/gtest.h>
+#include "core/audio-resampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace obswebrtc::core;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr double kPi = 3.14159265358979323846;
+
+}  // namespace
+
+/**
+ * @brief Test fixture for resampler tests
+ */
+class AudioResamplerTest : public ::testing::Test {
+protected:
+    static std::vector<SimdLevel> supportedLevels() {
+        std::vector<SimdLevel> levels;
+        for (SimdLevel level :
+             {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+            if (isSimdLevelSupported(level)) {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+
+    static float sine(double position, double frequency, int channel = 0) {
+        return static_cast<float>(
+            0.5 * std::sin(2.0 * kPi * frequency * position / kSampleRate + channel));
+    }
+
+    /**
+     * @brief Resample a sine in 20 ms chunks at a fixed ratio
+     * @return The output, one vector per channel
+     */
+    static std::vector<std::vector<float>> resampleSine(AdaptiveResampler& resampler,
+                                                        size_t channels, double frequency,
+                                                        size_t chunks, size_t chunkFrames = 960) {
+        std::vector<std::vector<float>> input(channels, std::vector<float>(chunkFrames));
+        std::vector<std::vector<float>> output(channels);
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            std::vector<const float*> in;
+            std::vector<float*> out;
+            const size_t capacity = resampler.maxOutputFrames(chunkFrames);
+            std::vector<std::vector<float>> buffers(channels, std::vector<float>(capacity));
+            for (size_t channel = 0; channel < channels; channel++) {
+                for (size_t i = 0; i < chunkFrames; i++) {
+                    input[channel][i] = sine(static_cast<double>(chunk * chunkFrames + i),
+                                             frequency, static_cast<int>(channel));
+                }
+                in.push_back(input[channel].data());
+                out.push_back(buffers[channel].data());
+            }
+            const size_t produced = resampler.process(in.data(), chunkFrames, out.data(), capacity);
+            EXPECT_LE(produced, capacity);
+            for (size_t channel = 0; channel < channels; channel++) {
+                output[channel].insert(output[channel].end(), buffers[channel].begin(),
+                                       buffers[channel].begin() + produced);
+            }
+        }
+        return output;
+    }
+};
+
+TEST_F(AudioResamplerTest, DotProductKernelsMatchScalar) {
+    std::vector<float> a(77);
+    std::vector<float> b(77);
+    for (size_t i = 0; i < a.size(); i++) {
+        a[i] = static_cast<float>(std::sin(0.3 * i));
+        b[i] = static_cast<float>(std::cos(0.7 * i));
+    }
+
+    for (SimdLevel level : supportedLevels()) {
+        SCOPED_TRACE(simdLevelName(level));
+        // Every tail length after the vector loops
+        for (size_t size = 0; size <= a.size(); size++) {
+            double expected = 0.0;
+            for (size_t i = 0; i < size; i++) {
+                expected += static_cast<double>(a[i]) * b[i];
+            }
+            EXPECT_NEAR(dotProduct(a.data(), b.data(), size, level), expected, 1e-4)
+                << "size " << size;
+        }
+    }
+    EXPECT_NEAR(dotProduct(a.data(), b.data(), a.size()),
+                dotProduct(a.data(), b.data(), a.size(), SimdLevel::Scalar), 1e-4);
+}
+
+TEST_F(AudioResamplerTest, RejectsInvalidArguments) {
+    EXPECT_THROW(AdaptiveResampler(0), std::invalid_argument);
+
+    AdaptiveResampler resampler(1);
+    EXPECT_EQ(resampler.getChannels(), 1u);
+    EXPECT_THROW(resampler.setRatio(0.5), std::invalid_argument);
+    EXPECT_THROW(resampler.setRatio(1.0 + 2 * constants::kMaxResamplerRatioDeviation),
+                 std::invalid_argument);
+    EXPECT_THROW(resampler.setRatio(std::nan("")), std::invalid_argument);
+    EXPECT_DOUBLE_EQ(resampler.getRatio(), 1.0);
+
+    resampler.setRatio(1.0 - constants::kMaxResamplerRatioDeviation / 2);
+    EXPECT_DOUBLE_EQ(resampler.getRatio(), 1.0 - constants::kMaxResamplerRatioDeviation / 2);
+}
+
+TEST_F(AudioResamplerTest, UnityRatioPassesSignalThrough) {
+    AdaptiveResampler resampler(2);
+    const auto output = resampleSine(resampler, 2, 1000.0, 10);
+
+    // Everything but the half filter still held back comes out, in place
+    const size_t held = constants::kResamplerTaps / 2;
+    ASSERT_EQ(output[0].size(), 10 * 960 - held);
+    for (size_t channel = 0; channel < 2; channel++) {
+        for (size_t i = 0; i < output[channel].size(); i++) {
+            // The first outputs see the silence before the stream through the filter
+            if (i >= held) {
+                ASSERT_NEAR(output[channel][i], sine(static_cast<double>(i), 1000.0,
+                                                     static_cast<int>(channel)),
+                            1e-3)
+                    << "channel " << channel << " sample " << i;
+            }
+        }
+    }
+}
+
+TEST_F(AudioResamplerTest, OutputRateFollowsRatio) {
+    for (double ratio : {1.0 + 200e-6, 1.0 - 200e-6, 1.002, 0.995}) {
+        SCOPED_TRACE(ratio);
+        AdaptiveResampler resampler(1);
+        resampler.setRatio(ratio);
+        const auto output = resampleSine(resampler, 1, 440.0, 500);  // 10 s
+
+        const double expected = 500 * 960 * ratio;
+        EXPECT_NEAR(static_cast<double>(output[0].size()), expected,
+                    constants::kResamplerTaps / 2 + 2);
+    }
+}
+
+TEST_F(AudioResamplerTest, ResampledSineStaysClean) {
+    // At ratio r, output n lies at input position n / r
+    for (double frequency : {440.0, 5000.0, 15000.0}) {
+        SCOPED_TRACE(frequency);
+        AdaptiveResampler resampler(1);
+        const double ratio = 1.0 + 500e-6;
+        resampler.setRatio(ratio);
+        const auto output = resampleSine(resampler, 1, frequency, 50);
+
+        double errorPower = 0.0;
+        double signalPower = 0.0;
+        for (size_t i = constants::kResamplerTaps; i < output[0].size(); i++) {
+            const double expected = sine(static_cast<double>(i) / ratio, frequency);
+            errorPower += (output[0][i] - expected) * (output[0][i] - expected);
+            signalPower += expected * expected;
+        }
+        const double snrDb = 10.0 * std::log10(signalPower / errorPower);
+        EXPECT_GT(snrDb, 80.0);
+    }
+}
+
+TEST_F(AudioResamplerTest, RatioChangesKeepOutputContinuous) {
+    AdaptiveResampler resampler(1);
+    std::vector<float> input(480);
+    std::vector<float> output(600);
+    double position = 0.0;  // Input position of the next output
+    double maxError = 0.0;
+    for (size_t chunk = 0; chunk < 400; chunk++) {
+        for (size_t i = 0; i < input.size(); i++) {
+            input[i] = sine(static_cast<double>(chunk * input.size() + i), 300.0);
+        }
+        // Ratio swings around 1 every chunk, like a correcting controller
+        const double ratio = 1.0 + 0.002 * std::sin(0.1 * static_cast<double>(chunk));
+        resampler.setRatio(ratio);
+        const float* in = input.data();
+        float* out = output.data();
+        const size_t produced = resampler.process(&in, input.size(), &out, output.size());
+        for (size_t i = 0; i < produced; i++) {
+            if (chunk > 0) {
+                const double expected = sine(position, 300.0);
+                maxError = std::max(maxError, std::fabs(output[i] - expected));
+            }
+            position += 1.0 / ratio;
+        }
+    }
+    EXPECT_LT(maxError, 1e-3);
+}
+
+TEST_F(AudioResamplerTest, LimitedCapacityKeepsInputForNextCall) {
+    AdaptiveResampler resampler(1);
+    std::vector<float> input(960);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = sine(static_cast<double>(i), 1000.0);
+    }
+    std::vector<float> output(2000);
+    const float* in = input.data();
+    float* out = output.data();
+
+    EXPECT_EQ(resampler.process(&in, input.size(), &out, 100), 100u);
+    out = output.data() + 100;
+    const size_t rest = resampler.process(&in, 0, &out, 2000);
+    EXPECT_EQ(100 + rest, input.size() - constants::kResamplerTaps / 2);
+    for (size_t i = constants::kResamplerTaps / 2; i < 100 + rest; i++) {
+        ASSERT_NEAR(output[i], input[i], 1e-3) << "sample " << i;
+    }
+}
+
+TEST_F(AudioResamplerTest, ResetDropsBufferedInput) {
+    AdaptiveResampler resampler(1);
+    std::vector<float> input(960, 0.9f);
+    std::vector<float> output(1000);
+    const float* in = input.data();
+    float* out = output.data();
+    resampler.process(&in, input.size(), &out, output.size());
+
+    resampler.reset();
+    std::fill(input.begin(), input.end(), 0.0f);
+    const size_t produced = resampler.process(&in, input.size(), &out, output.size());
+    EXPECT_EQ(produced, input.size() - constants::kResamplerTaps / 2);
+    for (size_t i = 0; i < produced; i++) {
+        ASSERT_EQ(output[i], 0.0f) << "sample " << i;
+    }
+}
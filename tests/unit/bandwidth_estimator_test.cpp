@@ -0,0 +1,287 @@
+/**
+ * @file bandwidth_estimator_test.cpp
+ * @brief Unit tests for BandwidthEstimator, including a simulated impaired link
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/bandwidth-estimator.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Bottleneck link with a drop-tail queue
+ *
+ * The sender pushes at the estimator's target bitrate every tick. The link
+ * drains at its capacity; bytes beyond the queue limit are lost. Receiver
+ * reports carry the loss fraction over the report interval and an RTT of
+ * base delay plus current queueing delay, like a real RTCP RR would.
+ */
+class SimulatedLink {
+public:
+    SimulatedLink(int capacityKbps, int baseRttMs, int queueLimitMs)
+        : capacityKbps_(capacityKbps), baseRttMs_(baseRttMs), queueLimitMs_(queueLimitMs) {}
+
+    void setCapacity(int capacityKbps) { capacityKbps_ = capacityKbps; }
+
+    /**
+     * @brief Send for one tick at the given rate
+     * @return Bytes handed to the link (what the sender put on the wire)
+     */
+    size_t send(int rateKbps, int tickMs) {
+        const double offered = rateKbps * tickMs / 8.0;  // kbps * ms / 8 = bytes
+        const double drained = capacityKbps_ * tickMs / 8.0;
+        const double limit = capacityKbps_ * queueLimitMs_ / 8.0;
+
+        queueBytes_ += offered;
+        queueBytes_ = std::max(0.0, queueBytes_ - drained);
+        double lost = 0.0;
+        if (queueBytes_ > limit) {
+            lost = queueBytes_ - limit;
+            queueBytes_ = limit;
+        }
+
+        offeredSinceReport_ += offered;
+        lostSinceReport_ += lost;
+        return static_cast<size_t>(offered);
+    }
+
+    double takeFractionLost() {
+        const double fraction = offeredSinceReport_ > 0 ? lostSinceReport_ / offeredSinceReport_ : 0.0;
+        offeredSinceReport_ = 0.0;
+        lostSinceReport_ = 0.0;
+        // RTCP quantizes to 1/256
+        return static_cast<int>(fraction * 256) / 256.0;
+    }
+
+    int64_t rttMs() const {
+        return baseRttMs_ + static_cast<int64_t>(queueBytes_ * 8.0 / capacityKbps_);
+    }
+
+private:
+    int capacityKbps_;
+    int baseRttMs_;
+    int queueLimitMs_;
+    double queueBytes_ = 0.0;
+    double offeredSinceReport_ = 0.0;
+    double lostSinceReport_ = 0.0;
+};
+
+/**
+ * @brief Test fixture for BandwidthEstimator tests
+ */
+class BandwidthEstimatorTest : public ::testing::Test {
+protected:
+    static constexpr int kTickMs = 10;
+    static constexpr int kReportIntervalMs = 500;
+
+    /**
+     * @brief Run the estimator against the link and record the target each tick
+     */
+    void run(BandwidthEstimator& estimator, SimulatedLink& link, int64_t& nowMs, int64_t durationMs,
+             std::vector<int>& targets) {
+        const int64_t endMs = nowMs + durationMs;
+        for (; nowMs < endMs; nowMs += kTickMs) {
+            const int target = estimator.getTargetBitrateKbps();
+            estimator.onPacketSent(link.send(target, kTickMs), nowMs);
+            if (nowMs % kReportIntervalMs == 0) {
+                estimator.onReceiverReport(link.takeFractionLost(), link.rttMs(), nowMs);
+            }
+            targets.push_back(target);
+        }
+    }
+};
+
+/**
+ * @brief Test that inconsistent bounds are rejected
+ */
+TEST_F(BandwidthEstimatorTest, InvalidBoundsThrow) {
+    BandwidthEstimatorConfig config;
+    config.minBitrateKbps = 0;
+    EXPECT_THROW({
+        BandwidthEstimator estimator(config);
+    }, std::invalid_argument);
+
+    config.minBitrateKbps = 3000;
+    config.maxBitrateKbps = 2000;
+    EXPECT_THROW({
+        BandwidthEstimator estimator(config);
+    }, std::invalid_argument);
+}
+
+/**
+ * @brief Test deriving bounds from HardwareEncoderConfig
+ */
+TEST_F(BandwidthEstimatorTest, BoundsFromEncoderConfig) {
+    HardwareEncoderConfig encoder;
+    encoder.bitrate = 4000;
+    encoder.maxBitrate = 6000;
+
+    BandwidthEstimatorConfig config = BandwidthEstimatorConfig::fromEncoderConfig(encoder);
+    EXPECT_EQ(config.startBitrateKbps, 4000);
+    EXPECT_EQ(config.maxBitrateKbps, 6000);
+    EXPECT_LE(config.minBitrateKbps, 4000);
+
+    BandwidthEstimator estimator(config);
+    EXPECT_EQ(estimator.getTargetBitrateKbps(), 4000);
+}
+
+/**
+ * @brief Test that heavy loss backs off below the delivered rate
+ */
+TEST_F(BandwidthEstimatorTest, HeavyLossBacksOff) {
+    BandwidthEstimatorConfig config;
+    config.startBitrateKbps = 4000;
+    config.maxBitrateKbps = 5000;
+    BandwidthEstimator estimator(config);
+
+    // 4000 kbps for one second
+    for (int64_t t = 0; t < 1000; t += 10) {
+        estimator.onPacketSent(5000, t);
+    }
+
+    // 50% loss: ~2000 kbps got through, target 85% of that
+    EXPECT_TRUE(estimator.onReceiverReport(0.5, 50, 1000));
+    EXPECT_NEAR(estimator.getTargetBitrateKbps(), 1700, 50);
+}
+
+/**
+ * @brief Test that low loss probes upward but stays within the maximum
+ */
+TEST_F(BandwidthEstimatorTest, LowLossIncreasesUpToMax) {
+    BandwidthEstimatorConfig config;
+    config.startBitrateKbps = 2000;
+    config.maxBitrateKbps = 2500;
+    BandwidthEstimator estimator(config);
+
+    int64_t nowMs = 0;
+    for (int i = 0; i < 40; i++) {
+        nowMs += 500;
+        estimator.onReceiverReport(0.0, 40, nowMs);
+    }
+
+    EXPECT_EQ(estimator.getTargetBitrateKbps(), 2500);
+}
+
+/**
+ * @brief Test that moderate loss holds the rate
+ */
+TEST_F(BandwidthEstimatorTest, ModerateLossHolds) {
+    BandwidthEstimatorConfig config;
+    config.startBitrateKbps = 2000;
+    BandwidthEstimator estimator(config);
+
+    estimator.onReceiverReport(0.05, 40, 0);
+    EXPECT_FALSE(estimator.onReceiverReport(0.05, 40, 500));
+    EXPECT_EQ(estimator.getTargetBitrateKbps(), 2000);
+}
+
+/**
+ * @brief Test that the target never drops below the minimum
+ */
+TEST_F(BandwidthEstimatorTest, NeverBelowMinimum) {
+    BandwidthEstimatorConfig config;
+    config.startBitrateKbps = 1000;
+    config.minBitrateKbps = 500;
+    BandwidthEstimator estimator(config);
+
+    estimator.onReceiverReport(1.0, 40, 0);
+    EXPECT_EQ(estimator.getTargetBitrateKbps(), 500);
+}
+
+/**
+ * @brief Test that REMB caps the target until it times out
+ */
+TEST_F(BandwidthEstimatorTest, RembCapsTarget) {
+    BandwidthEstimatorConfig config;
+    config.startBitrateKbps = 3000;
+    BandwidthEstimator estimator(config);
+
+    EXPECT_TRUE(estimator.onRemb(1200000, 0));
+    EXPECT_EQ(estimator.getTargetBitrateKbps(), 1200);
+
+    // Clean reports cannot push past the REMB value while it is fresh
+    estimator.onReceiverReport(0.0, 40, 500);
+    estimator.onReceiverReport(0.0, 40, 1000);
+    EXPECT_EQ(estimator.getTargetBitrateKbps(), 1200);
+}
+
+/**
+ * @brief Test that growing RTT is treated as overuse
+ */
+TEST_F(BandwidthEstimatorTest, RttGrowthBacksOff) {
+    BandwidthEstimatorConfig config;
+    config.startBitrateKbps = 3000;
+    BandwidthEstimator estimator(config);
+
+    for (int64_t t = 0; t < 1000; t += 10) {
+        estimator.onPacketSent(3750, t);  // 3000 kbps
+    }
+
+    estimator.onReceiverReport(0.0, 40, 500);
+    estimator.onReceiverReport(0.0, 200, 1000);
+    EXPECT_LT(estimator.getTargetBitrateKbps(), 3000);
+}
+
+/**
+ * @brief Impairment harness: converge within 2 s after a capacity drop
+ */
+TEST_F(BandwidthEstimatorTest, ConvergesAfterCapacityDrop) {
+    BandwidthEstimatorConfig config;
+    config.startBitrateKbps = 4000;
+    config.maxBitrateKbps = 6000;
+    BandwidthEstimator estimator(config);
+
+    SimulatedLink link(5000, 40, 200);
+    int64_t nowMs = 0;
+    std::vector<int> targets;
+
+    // Settle on a 5 Mbps path
+    run(estimator, link, nowMs, 10000, targets);
+    EXPECT_GT(estimator.getTargetBitrateKbps(), 3000);
+
+    // Capacity drops to 1.5 Mbps
+    const int kDroppedCapacity = 1500;
+    link.setCapacity(kDroppedCapacity);
+    targets.clear();
+    run(estimator, link, nowMs, 2000, targets);
+
+    // Within 2 s the target is at or below the new capacity without collapsing
+    EXPECT_LE(targets.back(), kDroppedCapacity);
+    EXPECT_GE(targets.back(), kDroppedCapacity / 2);
+
+    // And it stays in a sane band around capacity afterwards
+    targets.clear();
+    run(estimator, link, nowMs, 10000, targets);
+    double sum = 0.0;
+    for (int target : targets) {
+        sum += target;
+    }
+    const double average = sum / targets.size();
+    EXPECT_GT(average, kDroppedCapacity * 0.6);
+    EXPECT_LT(average, kDroppedCapacity * 1.1);
+}
+
+/**
+ * @brief Impairment harness: recover after capacity returns
+ */
+TEST_F(BandwidthEstimatorTest, RecoversAfterCapacityReturns) {
+    BandwidthEstimatorConfig config;
+    config.startBitrateKbps = 1000;
+    config.maxBitrateKbps = 4000;
+    BandwidthEstimator estimator(config);
+
+    SimulatedLink link(800, 40, 200);
+    int64_t nowMs = 0;
+    std::vector<int> targets;
+    run(estimator, link, nowMs, 5000, targets);
+    EXPECT_LE(estimator.getTargetBitrateKbps(), 1000);
+
+    link.setCapacity(5000);
+    run(estimator, link, nowMs, 30000, targets);
+    EXPECT_GT(estimator.getTargetBitrateKbps(), 3000);
+}
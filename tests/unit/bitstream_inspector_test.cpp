@@ -0,0 +1,486 @@
+/**
+ * @file bitstream_inspector_test.cpp
+ * @brief Unit tests for the keyframe and resolution inspector
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/bitstream-inspector.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+namespace {
+
+/**
+ * @brief MSB-first writer for hand-built codec headers
+ */
+class BitWriter {
+public:
+    void bits(uint32_t value, int count) {
+        for (int i = count - 1; i >= 0; i--) {
+            bit((value >> i) & 1);
+        }
+    }
+
+    void ue(uint32_t value) {
+        const uint32_t coded = value + 1;
+        int length = 0;
+        while ((coded >> length) > 1) {
+            length++;
+        }
+        bits(0, length);
+        bits(coded, length + 1);
+    }
+
+    void se(int32_t value) { ue(value > 0 ? 2 * value - 1 : -2 * value); }
+
+    /** Zero-padded to a whole byte (VP9, AV1) */
+    std::vector<uint8_t> bytes() {
+        while (used_ != 0) {
+            bit(0);
+        }
+        return data_;
+    }
+
+    /** rbsp_trailing_bits(), then the NAL unit with emulation prevention */
+    std::vector<uint8_t> nal(uint8_t header) {
+        bit(1);
+        std::vector<uint8_t> nal = {header};
+        int zeros = 0;
+        for (uint8_t value : bytes()) {
+            if (zeros >= 2 && value <= 3) {
+                nal.push_back(0x03);
+                zeros = 0;
+            }
+            nal.push_back(value);
+            zeros = value == 0 ? zeros + 1 : 0;
+        }
+        return nal;
+    }
+
+private:
+    void bit(uint32_t value) {
+        current_ = static_cast<uint8_t>((current_ << 1) | value);
+        if (++used_ == 8) {
+            data_.push_back(current_);
+            current_ = 0;
+            used_ = 0;
+        }
+    }
+
+    std::vector<uint8_t> data_;
+    uint8_t current_ = 0;
+    int used_ = 0;
+};
+
+/**
+ * @brief Fields of a hand-built H.264 SPS
+ */
+struct SpsFields {
+    uint32_t profileIdc = 66;
+    uint32_t widthInMbs = 120;
+    uint32_t heightInMapUnits = 68;
+    bool frameMbsOnly = true;
+    uint32_t cropRight = 0;
+    uint32_t cropBottom = 4;  // 1088 -> 1080 in 4:2:0
+    bool scalingMatrix = false;
+    uint32_t pocType = 0;
+    uint32_t maxRefFrames = 4;
+};
+
+std::vector<uint8_t> makeSps(const SpsFields& fields) {
+    BitWriter sps;
+    sps.bits(fields.profileIdc, 8);
+    sps.bits(0, 8);  // constraint flags
+    sps.bits(40, 8);  // level_idc
+    sps.ue(0);  // seq_parameter_set_id
+    if (fields.profileIdc == 100) {
+        sps.ue(1);  // chroma_format_idc: 4:2:0
+        sps.ue(0);  // bit_depth_luma_minus8
+        sps.ue(0);  // bit_depth_chroma_minus8
+        sps.bits(0, 1);  // qpprime_y_zero_transform_bypass_flag
+        sps.bits(fields.scalingMatrix ? 1 : 0, 1);
+        if (fields.scalingMatrix) {
+            for (int i = 0; i < 8; i++) {
+                sps.bits(i == 0 ? 1 : 0, 1);  // Only the first list is sent
+                if (i == 0) {
+                    for (int j = 0; j < 16; j++) {
+                        sps.se(j == 0 ? 8 : 0);
+                    }
+                }
+            }
+        }
+    }
+    sps.ue(0);  // log2_max_frame_num_minus4
+    sps.ue(fields.pocType);
+    if (fields.pocType == 0) {
+        sps.ue(2);  // log2_max_pic_order_cnt_lsb_minus4
+    } else if (fields.pocType == 1) {
+        sps.bits(0, 1);  // delta_pic_order_always_zero_flag
+        sps.se(-1);  // offset_for_non_ref_pic
+        sps.se(2);  // offset_for_top_to_bottom_field
+        sps.ue(2);  // num_ref_frames_in_pic_order_cnt_cycle
+        sps.se(3);
+        sps.se(-3);
+    }
+    sps.ue(fields.maxRefFrames);
+    sps.bits(0, 1);  // gaps_in_frame_num_value_allowed_flag
+    sps.ue(fields.widthInMbs - 1);
+    sps.ue(fields.heightInMapUnits - 1);
+    sps.bits(fields.frameMbsOnly ? 1 : 0, 1);
+    if (!fields.frameMbsOnly) {
+        sps.bits(0, 1);  // mb_adaptive_frame_field_flag
+    }
+    sps.bits(1, 1);  // direct_8x8_inference_flag
+    const bool cropping = fields.cropRight != 0 || fields.cropBottom != 0;
+    sps.bits(cropping ? 1 : 0, 1);
+    if (cropping) {
+        sps.ue(0);
+        sps.ue(fields.cropRight);
+        sps.ue(0);
+        sps.ue(fields.cropBottom);
+    }
+    sps.bits(0, 1);  // vui_parameters_present_flag
+    return sps.nal(0x67);
+}
+
+std::vector<uint8_t> annexB(const std::vector<std::vector<uint8_t>>& nalUnits) {
+    std::vector<uint8_t> accessUnit;
+    for (const auto& nal : nalUnits) {
+        accessUnit.insert(accessUnit.end(), {0, 0, 0, 1});
+        accessUnit.insert(accessUnit.end(), nal.begin(), nal.end());
+    }
+    return accessUnit;
+}
+
+const std::vector<uint8_t> kPps = {0x68, 0xCE, 0x3C, 0x80};
+const std::vector<uint8_t> kIdrSlice = {0x65, 0x88, 0x84, 0x00, 0x33};
+const std::vector<uint8_t> kNonIdrSlice = {0x41, 0x9A, 0x02, 0x04};
+
+std::vector<uint8_t> vp9Frame(bool keyframe, uint32_t profile, uint32_t width, uint32_t height) {
+    BitWriter header;
+    header.bits(2, 2);  // frame_marker
+    header.bits(profile & 1, 1);
+    header.bits(profile >> 1, 1);
+    if (profile == 3) {
+        header.bits(0, 1);  // reserved_zero
+    }
+    header.bits(0, 1);  // show_existing_frame
+    header.bits(keyframe ? 0 : 1, 1);  // frame_type
+    header.bits(1, 1);  // show_frame
+    header.bits(0, 1);  // error_resilient_mode
+    if (keyframe) {
+        header.bits(0x498342, 24);  // frame_sync_code
+        if (profile >= 2) {
+            header.bits(0, 1);  // ten_or_twelve_bit
+        }
+        header.bits(2, 3);  // color_space: CS_BT_709
+        header.bits(0, 1);  // color_range
+        if (profile == 1 || profile == 3) {
+            header.bits(0, 3);  // subsampling_x, subsampling_y, reserved_zero
+        }
+        header.bits(width - 1, 16);
+        header.bits(height - 1, 16);
+    }
+    header.bits(0, 8);  // Rest of the header
+    return header.bytes();
+}
+
+std::vector<uint8_t> av1Obu(uint8_t type, const std::vector<uint8_t>& payload,
+                            bool extension = false) {
+    std::vector<uint8_t> obu = {static_cast<uint8_t>((type << 3) | 0x02 | (extension ? 0x04 : 0))};
+    if (extension) {
+        obu.push_back(0x00);
+    }
+    size_t size = payload.size();
+    do {
+        obu.push_back(static_cast<uint8_t>((size & 0x7F) | (size > 0x7F ? 0x80 : 0)));
+        size >>= 7;
+    } while (size != 0);
+    obu.insert(obu.end(), payload.begin(), payload.end());
+    return obu;
+}
+
+std::vector<uint8_t> av1SequenceHeader(uint32_t width, uint32_t height, bool timingInfo) {
+    BitWriter header;
+    header.bits(0, 3);  // seq_profile
+    header.bits(0, 1);  // still_picture
+    header.bits(0, 1);  // reduced_still_picture_header
+    header.bits(timingInfo ? 1 : 0, 1);  // timing_info_present_flag
+    if (timingInfo) {
+        header.bits(1001, 32);  // num_units_in_display_tick
+        header.bits(60000, 32);  // time_scale
+        header.bits(1, 1);  // equal_picture_interval
+        header.bits(3, 3);  // num_ticks_per_picture_minus_1 = 2 as uvlc: 011
+        header.bits(1, 1);  // decoder_model_info_present_flag
+        header.bits(23, 5);  // buffer_delay_length_minus_1
+        header.bits(1001, 32);  // num_units_in_decoding_tick
+        header.bits(31, 5);  // buffer_removal_time_length_minus_1
+        header.bits(31, 5);  // frame_presentation_time_length_minus_1
+    }
+    header.bits(1, 1);  // initial_display_delay_present_flag
+    header.bits(1, 5);  // operating_points_cnt_minus_1
+    for (int i = 0; i < 2; i++) {
+        header.bits(i == 0 ? 0x101 : 0, 12);  // operating_point_idc
+        header.bits(i == 0 ? 12 : 4, 5);  // seq_level_idx
+        if (i == 0) {
+            header.bits(1, 1);  // seq_tier
+        }
+        if (timingInfo) {
+            header.bits(1, 1);  // decoder_model_present_for_this_op
+            header.bits(12345, 24);  // decoder_buffer_delay
+            header.bits(6789, 24);  // encoder_buffer_delay
+            header.bits(0, 1);  // low_delay_mode_flag
+        }
+        header.bits(1, 1);  // initial_display_delay_present_for_this_op
+        header.bits(9, 4);  // initial_display_delay_minus_1
+    }
+    header.bits(15, 4);  // frame_width_bits_minus_1
+    header.bits(15, 4);  // frame_height_bits_minus_1
+    header.bits(width - 1, 16);
+    header.bits(height - 1, 16);
+    header.bits(0, 8);  // Rest of the header
+    return header.bytes();
+}
+
+std::vector<uint8_t> av1TemporalUnit(const std::vector<uint8_t>& sequenceHeader, bool keyframe) {
+    std::vector<uint8_t> unit = av1Obu(2, {});  // Temporal delimiter
+    if (!sequenceHeader.empty()) {
+        const auto obu = av1Obu(1, sequenceHeader);
+        unit.insert(unit.end(), obu.begin(), obu.end());
+    }
+    // show_existing_frame = 0, frame_type = KEY_FRAME (0) or INTER_FRAME (1)
+    const auto frame = av1Obu(6, {static_cast<uint8_t>(keyframe ? 0x10 : 0x30), 0xAB, 0xCD}, true);
+    unit.insert(unit.end(), frame.begin(), frame.end());
+    return unit;
+}
+
+}  // namespace
+
+/**
+ * @brief Test fixture for BitstreamInspector tests
+ */
+class BitstreamInspectorTest : public ::testing::Test {
+protected:
+    static void expectSps(const SpsFields& fields, uint32_t width, uint32_t height) {
+        const std::vector<uint8_t> sps = makeSps(fields);
+        uint32_t parsedWidth = 0;
+        uint32_t parsedHeight = 0;
+        ASSERT_TRUE(parseH264SpsResolution(sps.data(), sps.size(), parsedWidth, parsedHeight));
+        EXPECT_EQ(parsedWidth, width);
+        EXPECT_EQ(parsedHeight, height);
+    }
+};
+
+/**
+ * @brief Test SPS resolution across profiles, cropping and interlacing
+ */
+TEST_F(BitstreamInspectorTest, ParsesH264SpsResolution) {
+    expectSps(SpsFields(), 1920, 1080);
+
+    SpsFields high;
+    high.profileIdc = 100;
+    high.scalingMatrix = true;
+    high.pocType = 1;
+    high.widthInMbs = 80;
+    high.heightInMapUnits = 45;
+    high.cropBottom = 0;
+    expectSps(high, 1280, 720);
+
+    SpsFields interlaced;
+    interlaced.frameMbsOnly = false;
+    interlaced.heightInMapUnits = 34;
+    interlaced.cropBottom = 2;  // Two field rows of chroma: 8 lines
+    expectSps(interlaced, 1920, 1080);
+
+    SpsFields cropped;
+    cropped.pocType = 2;
+    cropped.widthInMbs = 54;
+    cropped.heightInMapUnits = 30;
+    cropped.cropRight = 4;
+    cropped.cropBottom = 0;
+    expectSps(cropped, 856, 480);
+}
+
+/**
+ * @brief Test that emulation prevention bytes are skipped inside exp-Golomb codes
+ */
+TEST_F(BitstreamInspectorTest, SkipsEmulationPreventionBytes) {
+    SpsFields fields;
+    fields.maxRefFrames = (1u << 24) - 1;  // 24 leading zero bits, then 24 more
+    const std::vector<uint8_t> sps = makeSps(fields);
+    const std::vector<uint8_t> escape = {0x00, 0x00, 0x03};
+    ASSERT_NE(std::search(sps.begin(), sps.end(), escape.begin(), escape.end()), sps.end());
+    expectSps(fields, 1920, 1080);
+}
+
+/**
+ * @brief Test that truncated or foreign NAL units are rejected
+ */
+TEST_F(BitstreamInspectorTest, RejectsMalformedSps) {
+    const std::vector<uint8_t> sps = makeSps(SpsFields());
+    uint32_t width = 0;
+    uint32_t height = 0;
+    EXPECT_FALSE(parseH264SpsResolution(sps.data(), 6, width, height));
+    EXPECT_FALSE(parseH264SpsResolution(kPps.data(), kPps.size(), width, height));
+
+    SpsFields overcropped;
+    overcropped.cropBottom = 600;
+    const std::vector<uint8_t> bad = makeSps(overcropped);
+    EXPECT_FALSE(parseH264SpsResolution(bad.data(), bad.size(), width, height));
+}
+
+/**
+ * @brief Test keyframe detection and SPS caching on an H.264 stream
+ */
+TEST_F(BitstreamInspectorTest, InspectsH264Stream) {
+    BitstreamInspector inspector(BitstreamCodec::H264);
+    const std::vector<uint8_t> sps = makeSps(SpsFields());
+
+    const std::vector<uint8_t> idr = annexB({sps, kPps, kIdrSlice});
+    BitstreamFrameInfo info = inspector.inspect(idr.data(), idr.size());
+    EXPECT_TRUE(info.keyframe);
+    EXPECT_EQ(info.width, 1920u);
+    EXPECT_EQ(info.height, 1080u);
+
+    const std::vector<uint8_t> inter = annexB({kNonIdrSlice});
+    info = inspector.inspect(inter.data(), inter.size());
+    EXPECT_FALSE(info.keyframe);
+    EXPECT_EQ(info.width, 1920u);
+
+    // The repeated SPS is recognised without parsing it again
+    inspector.inspect(idr.data(), idr.size());
+    BitstreamInspectorStats stats = inspector.getStats();
+    EXPECT_EQ(stats.framesInspected, 3u);
+    EXPECT_EQ(stats.headersParsed, 1u);
+    EXPECT_EQ(stats.headersCached, 1u);
+
+    // A new SPS is parsed
+    SpsFields smaller;
+    smaller.widthInMbs = 80;
+    smaller.heightInMapUnits = 45;
+    smaller.cropBottom = 0;
+    const std::vector<uint8_t> switched = annexB({makeSps(smaller), kPps, kIdrSlice});
+    info = inspector.inspect(switched.data(), switched.size());
+    EXPECT_EQ(info.width, 1280u);
+    EXPECT_EQ(info.height, 720u);
+    EXPECT_EQ(inspector.getStats().headersParsed, 2u);
+
+    inspector.reset();
+    info = inspector.inspect(inter.data(), inter.size());
+    EXPECT_EQ(info.width, 0u);
+    EXPECT_EQ(info.height, 0u);
+}
+
+/**
+ * @brief Test that a bad SPS keeps the last resolution and is retried
+ */
+TEST_F(BitstreamInspectorTest, KeepsResolutionOnBadSps) {
+    BitstreamInspector inspector(BitstreamCodec::H264);
+    const std::vector<uint8_t> good = annexB({makeSps(SpsFields()), kPps, kIdrSlice});
+    inspector.inspect(good.data(), good.size());
+
+    const std::vector<uint8_t> truncated = {0x67, 0x42, 0x00};
+    const std::vector<uint8_t> bad = annexB({truncated, kIdrSlice});
+    BitstreamFrameInfo info = inspector.inspect(bad.data(), bad.size());
+    EXPECT_TRUE(info.keyframe);
+    EXPECT_EQ(info.width, 1920u);
+    inspector.inspect(bad.data(), bad.size());
+    EXPECT_EQ(inspector.getStats().headerErrors, 2u);
+}
+
+/**
+ * @brief Test VP8 keyframe headers and interframes
+ */
+TEST_F(BitstreamInspectorTest, InspectsVp8Frames) {
+    BitstreamInspector inspector(BitstreamCodec::VP8);
+    const std::vector<uint8_t> keyframe = {0x50, 0x42, 0x00, 0x9D, 0x01, 0x2A,
+                                           0x80, 0x02, 0xE0, 0x01, 0x00};
+    BitstreamFrameInfo info = inspector.inspect(keyframe.data(), keyframe.size());
+    EXPECT_TRUE(info.keyframe);
+    EXPECT_EQ(info.width, 640u);
+    EXPECT_EQ(info.height, 480u);
+
+    const std::vector<uint8_t> interframe = {0x31, 0x02, 0x00, 0x12};
+    info = inspector.inspect(interframe.data(), interframe.size());
+    EXPECT_FALSE(info.keyframe);
+    EXPECT_EQ(info.width, 640u);
+
+    const std::vector<uint8_t> badStartCode = {0x50, 0x42, 0x00, 0x9D, 0x01, 0x2B,
+                                               0x80, 0x02, 0xE0, 0x01};
+    inspector.inspect(badStartCode.data(), badStartCode.size());
+    EXPECT_EQ(inspector.getStats().headerErrors, 1u);
+}
+
+/**
+ * @brief Test VP9 uncompressed headers across profiles
+ */
+TEST_F(BitstreamInspectorTest, InspectsVp9Frames) {
+    for (uint32_t profile = 0; profile < 4; profile++) {
+        BitstreamInspector inspector(BitstreamCodec::VP9);
+        const std::vector<uint8_t> keyframe = vp9Frame(true, profile, 1280, 720);
+        BitstreamFrameInfo info = inspector.inspect(keyframe.data(), keyframe.size());
+        EXPECT_TRUE(info.keyframe) << "profile " << profile;
+        EXPECT_EQ(info.width, 1280u) << "profile " << profile;
+        EXPECT_EQ(info.height, 720u) << "profile " << profile;
+
+        const std::vector<uint8_t> interframe = vp9Frame(false, profile, 0, 0);
+        info = inspector.inspect(interframe.data(), interframe.size());
+        EXPECT_FALSE(info.keyframe);
+        EXPECT_EQ(info.width, 1280u);
+    }
+}
+
+/**
+ * @brief Test AV1 sequence headers, frame types and header caching
+ */
+TEST_F(BitstreamInspectorTest, InspectsAv1TemporalUnits) {
+    for (bool timingInfo : {false, true}) {
+        BitstreamInspector inspector(BitstreamCodec::AV1);
+        const std::vector<uint8_t> sequenceHeader = av1SequenceHeader(3840, 2160, timingInfo);
+
+        const std::vector<uint8_t> key = av1TemporalUnit(sequenceHeader, true);
+        BitstreamFrameInfo info = inspector.inspect(key.data(), key.size());
+        EXPECT_TRUE(info.keyframe);
+        EXPECT_EQ(info.width, 3840u) << "timing info " << timingInfo;
+        EXPECT_EQ(info.height, 2160u) << "timing info " << timingInfo;
+
+        const std::vector<uint8_t> inter = av1TemporalUnit({}, false);
+        info = inspector.inspect(inter.data(), inter.size());
+        EXPECT_FALSE(info.keyframe);
+        EXPECT_EQ(info.width, 3840u);
+
+        inspector.inspect(key.data(), key.size());
+        EXPECT_EQ(inspector.getStats().headersParsed, 1u);
+        EXPECT_EQ(inspector.getStats().headersCached, 1u);
+    }
+}
+
+/**
+ * @brief Test that truncated AV1 OBUs are reported, not read past
+ */
+TEST_F(BitstreamInspectorTest, RejectsTruncatedAv1Obu) {
+    BitstreamInspector inspector(BitstreamCodec::AV1);
+    const std::vector<uint8_t> truncated = {0x0A, 0x20, 0x00, 0x00};  // Claims 32 bytes
+    BitstreamFrameInfo info = inspector.inspect(truncated.data(), truncated.size());
+    EXPECT_FALSE(info.keyframe);
+    EXPECT_EQ(info.width, 0u);
+    EXPECT_EQ(inspector.getStats().headerErrors, 1u);
+}
+
+/**
+ * @brief Test that empty frames are harmless
+ */
+TEST_F(BitstreamInspectorTest, HandlesEmptyFrames) {
+    for (BitstreamCodec codec : {BitstreamCodec::H264, BitstreamCodec::VP8, BitstreamCodec::VP9,
+                                 BitstreamCodec::AV1}) {
+        BitstreamInspector inspector(codec);
+        BitstreamFrameInfo info = inspector.inspect(nullptr, 0);
+        EXPECT_FALSE(info.keyframe);
+        EXPECT_EQ(info.width, 0u);
+    }
+}
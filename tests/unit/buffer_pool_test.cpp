@@ -0,0 +1,194 @@
+/**
+ * @file buffer_pool_test.cpp
+ * @brief Unit tests for BufferPool and BufferSlice
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/buffer-pool.hpp"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for BufferPool tests
+ */
+class BufferPoolTest : public ::testing::Test {
+protected:
+    static std::vector<uint8_t> bytes(size_t size, uint8_t seed = 1) {
+        std::vector<uint8_t> out(size);
+        for (size_t i = 0; i < size; i++) {
+            out[i] = static_cast<uint8_t>(seed + i);
+        }
+        return out;
+    }
+};
+
+/**
+ * @brief Test that invalid size bounds are rejected
+ */
+TEST_F(BufferPoolTest, InvalidConfigThrows) {
+    BufferPoolConfig config;
+    config.minBufferSize = 0;
+    EXPECT_THROW(BufferPool pool(config), std::invalid_argument);
+
+    config.minBufferSize = 4096;
+    config.maxBufferSize = 1024;
+    EXPECT_THROW(BufferPool pool(config), std::invalid_argument);
+}
+
+/**
+ * @brief Test that copies share one buffer and keep its contents
+ */
+TEST_F(BufferPoolTest, SlicesShareTheBuffer) {
+    BufferPool pool;
+    const auto payload = bytes(1000);
+
+    BufferSlice slice = pool.copy(payload.data(), payload.size());
+    ASSERT_EQ(slice.size(), payload.size());
+    EXPECT_EQ(slice.toVector(), payload);
+    EXPECT_EQ(slice.useCount(), 1u);
+
+    BufferSlice shared = slice;
+    EXPECT_EQ(shared.data(), slice.data());
+    EXPECT_EQ(slice.useCount(), 2u);
+
+    BufferSlice middle = slice.subslice(10, 20);
+    EXPECT_EQ(middle.data(), slice.data() + 10);
+    EXPECT_EQ(middle[0], payload[10]);
+    EXPECT_EQ(slice.useCount(), 3u);
+    EXPECT_THROW(slice.subslice(990, 11), std::out_of_range);
+
+    BufferSlice moved = std::move(shared);
+    EXPECT_TRUE(shared.empty());
+    EXPECT_EQ(slice.useCount(), 3u);
+
+    EXPECT_TRUE(pool.copy(payload.data(), 0).empty());
+    EXPECT_EQ(BufferSlice().useCount(), 0u);
+}
+
+/**
+ * @brief Test that released buffers are reused instead of reallocated
+ */
+TEST_F(BufferPoolTest, ReusesReleasedBuffers) {
+    BufferPool pool;
+    const auto payload = bytes(3000);
+
+    for (int i = 0; i < 100; i++) {
+        BufferSlice slice = pool.copy(payload.data(), payload.size() - i);  // Same size class
+        EXPECT_EQ(slice.size(), payload.size() - i);
+    }
+
+    BufferPoolStats stats = pool.getStats();
+    EXPECT_EQ(stats.allocations, 1u);
+    EXPECT_EQ(stats.reuses, 99u);
+    EXPECT_EQ(stats.freeBuffers, 1u);
+
+    // A different size class needs its own buffer
+    BufferSlice small = pool.copy(payload.data(), 100);
+    EXPECT_EQ(pool.getStats().allocations, 2u);
+}
+
+/**
+ * @brief Test that each size class keeps at most maxFreeBuffers
+ */
+TEST_F(BufferPoolTest, BoundsFreeBuffers) {
+    BufferPoolConfig config;
+    config.maxFreeBuffers = 2;
+    BufferPool pool(config);
+    const auto payload = bytes(500);
+
+    {
+        std::vector<BufferSlice> held;
+        for (int i = 0; i < 5; i++) {
+            held.push_back(pool.copy(payload.data(), payload.size()));
+        }
+    }
+    EXPECT_EQ(pool.getStats().freeBuffers, 2u);
+
+    // Oversized requests bypass the pool
+    config.maxBufferSize = 1024;
+    BufferPool bounded(config);
+    const auto large = bytes(4096);
+    { BufferSlice slice = bounded.copy(large.data(), large.size()); }
+    EXPECT_EQ(bounded.getStats().freeBuffers, 0u);
+    EXPECT_EQ(bounded.getStats().allocations, 1u);
+}
+
+/**
+ * @brief Test writable acquisition, truncation and unshared release
+ */
+TEST_F(BufferPoolTest, AcquireTruncateAndShare) {
+    BufferPool pool;
+
+    {
+        PooledBuffer buffer = pool.acquire(2000);
+        ASSERT_EQ(buffer.size(), 2000u);
+        buffer.data()[0] = 0xAB;
+        buffer.truncate(10);
+        EXPECT_THROW(buffer.truncate(11), std::out_of_range);
+
+        BufferSlice slice = std::move(buffer).share();
+        EXPECT_EQ(slice.size(), 10u);
+        EXPECT_EQ(slice[0], 0xAB);
+        EXPECT_EQ(buffer.size(), 0u);
+    }
+    EXPECT_EQ(pool.getStats().freeBuffers, 1u);
+
+    { PooledBuffer unshared = pool.acquire(2000); }
+    EXPECT_EQ(pool.getStats().freeBuffers, 1u);
+    EXPECT_EQ(pool.getStats().allocations, 1u);
+}
+
+/**
+ * @brief Test that slices stay valid after the pool is destroyed
+ */
+TEST_F(BufferPoolTest, SlicesOutliveThePool) {
+    const auto payload = bytes(800);
+    BufferSlice survivor;
+    {
+        BufferPool pool;
+        survivor = pool.copy(payload.data(), payload.size());
+    }
+    EXPECT_EQ(survivor.toVector(), payload);
+
+    BufferSlice standalone = BufferSlice::copyOf(payload.data(), payload.size());
+    EXPECT_EQ(standalone.toVector(), payload);
+}
+
+/**
+ * @brief Test that slices can be released on other threads
+ */
+TEST_F(BufferPoolTest, ReleasesAcrossThreads) {
+    auto pool = std::make_unique<BufferPool>();
+    const auto payload = bytes(1500);
+    std::atomic<int> checked{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&pool, &payload, &checked]() {
+            for (int i = 0; i < 100; i++) {
+                BufferSlice slice = pool->copy(payload.data(), payload.size());
+                std::thread consumer([slice, &payload, &checked]() {
+                    if (slice.toVector() == payload) {
+                        checked++;
+                    }
+                });
+                consumer.join();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(checked.load(), 400);
+    EXPECT_LE(pool->getStats().allocations, 8u);
+    pool.reset();
+}
@@ -0,0 +1,322 @@
+/**
+ * @file clock_drift_test.cpp
+ * @brief Unit tests for clock drift estimation and audio clock sync, with a long soak
+ */
+
+#include <gtest/gtest.h>
+#include "core/audio-resampler.hpp"
+#include "core/clock-drift.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace obswebrtc::core;
+
+namespace {
+
+constexpr uint32_t kSampleRate = 48000;
+constexpr uint32_t kChunkFrames = 960;           // 20 ms Opus packets
+constexpr uint64_t kChunkNs = 20000000;          // On the sender's clock
+constexpr uint64_t kStartNs = 5000000000000ULL;  // Local clock at the first chunk
+constexpr uint64_t kMediaBaseNs = 123456789000ULL;
+
+}  // namespace
+
+/**
+ * @brief Test fixture for drift estimation and clock sync tests
+ *
+ * Simulates a sender whose clock runs `driftPpm` fast: chunk k carries media
+ * time k * 20 ms and reaches the decoder at k * 20 ms / (1 + drift) local
+ * time, plus scheduling jitter and occasional late spikes.
+ */
+class ClockDriftTest : public ::testing::Test {
+protected:
+    struct Sender {
+        explicit Sender(double driftPpm, double jitterMs = 4.0, uint32_t seed = 1)
+            : rate(1.0 + driftPpm * 1e-6), jitter(0.0, jitterMs * 1e6), random(seed) {}
+
+        uint64_t mediaNs(uint64_t chunk) const { return kMediaBaseNs + chunk * kChunkNs; }
+
+        /** Arrival of the next chunk; never before the previous one, the decoder is sequential */
+        uint64_t arrivalNs(uint64_t chunk) {
+            double delayNs = jitter(random);
+            if (spike(random) < 0.01) {
+                delayNs += 30e6;  // A late wakeup or a burst after a short stall
+            }
+            const uint64_t arrival =
+                kStartNs + stepNs +
+                static_cast<uint64_t>(static_cast<double>(chunk * kChunkNs) / rate + delayNs);
+            lastArrivalNs = std::max(lastArrivalNs, arrival);
+            return lastArrivalNs;
+        }
+
+        double rate;
+        uint64_t stepNs = 0;  // Added to every arrival, like a jitter buffer delay change
+        uint64_t lastArrivalNs = 0;
+        std::uniform_real_distribution<double> jitter;
+        std::uniform_real_distribution<double> spike{0.0, 1.0};
+        std::mt19937 random;
+    };
+
+    /**
+     * @brief Counts resampler output like AdaptiveResampler does, without the filtering
+     *
+     * Simulating hours of audio sample by sample would take minutes; the
+     * frame count per chunk is all the clock sync sees of the resampler.
+     */
+    struct ResamplerModel {
+        size_t process(uint32_t frames, double ratio) {
+            position += frames * ratio;
+            const auto total = static_cast<uint64_t>(position);
+            const size_t produced = static_cast<size_t>(total - emitted);
+            emitted = total;
+            return produced;
+        }
+
+        double position = 0.0;
+        uint64_t emitted = 0;
+    };
+
+    /** Depth of a chunk's audio ahead of the local clock, in ms */
+    static double depthMs(uint64_t timestampNs, uint64_t nowNs) {
+        return static_cast<double>(static_cast<int64_t>(timestampNs - nowNs)) / 1e6;
+    }
+};
+
+TEST_F(ClockDriftTest, EstimatorNeedsMinimumWindow) {
+    ClockDriftEstimator estimator;
+    Sender sender(100.0);
+    const uint64_t chunks =
+        (constants::kClockDriftMinIntervals - 2) * constants::kClockDriftIntervalMs / 20;
+    for (uint64_t chunk = 0; chunk < chunks; chunk++) {
+        estimator.update(sender.mediaNs(chunk), sender.arrivalNs(chunk));
+    }
+    EXPECT_FALSE(estimator.hasEstimate());
+    EXPECT_EQ(estimator.getDriftPpm(), 0.0);
+}
+
+TEST_F(ClockDriftTest, EstimatorMeasuresDriftThroughJitter) {
+    for (double driftPpm : {0.0, 150.0, -80.0, 450.0}) {
+        SCOPED_TRACE(driftPpm);
+        ClockDriftEstimator estimator;
+        Sender sender(driftPpm, 8.0);
+        for (uint64_t chunk = 0; chunk < 5 * 60 * 50; chunk++) {  // 5 minutes
+            estimator.update(sender.mediaNs(chunk), sender.arrivalNs(chunk));
+        }
+        ASSERT_TRUE(estimator.hasEstimate());
+        EXPECT_NEAR(estimator.getDriftPpm(), driftPpm, 5.0);
+        EXPECT_EQ(estimator.getRestarts(), 0u);
+    }
+}
+
+TEST_F(ClockDriftTest, EstimatorClampsImplausibleDrift) {
+    ClockDriftEstimator estimator;
+    Sender sender(-5000.0, 1.0);
+    for (uint64_t chunk = 0; chunk < 60 * 50; chunk++) {
+        estimator.update(sender.mediaNs(chunk), sender.arrivalNs(chunk));
+    }
+    EXPECT_EQ(estimator.getDriftPpm(), -constants::kMaxAudioClockDriftPpm);
+}
+
+TEST_F(ClockDriftTest, EstimatorRestartsAfterOffsetJump) {
+    ClockDriftEstimator estimator;
+    Sender sender(120.0);
+    uint64_t chunk = 0;
+    for (; chunk < 2 * 60 * 50; chunk++) {
+        estimator.update(sender.mediaNs(chunk), sender.arrivalNs(chunk));
+    }
+    const double before = estimator.getDriftPpm();
+    EXPECT_NEAR(before, 120.0, 10.0);
+
+    // The jitter buffer adds 200 ms of delay: the estimate is kept meanwhile
+    sender.stepNs = 200000000;
+    for (const uint64_t end = chunk + 10 * 50; chunk < end; chunk++) {
+        estimator.update(sender.mediaNs(chunk), sender.arrivalNs(chunk));
+    }
+    EXPECT_EQ(estimator.getRestarts(), 1u);
+    EXPECT_NEAR(estimator.getDriftPpm(), before, 1.0);
+
+    // And the new window takes over once it is long enough
+    for (const uint64_t end = chunk + 3 * 60 * 50; chunk < end; chunk++) {
+        estimator.update(sender.mediaNs(chunk), sender.arrivalNs(chunk));
+    }
+    EXPECT_NEAR(estimator.getDriftPpm(), 120.0, 6.0);
+
+    estimator.reset();
+    EXPECT_FALSE(estimator.hasEstimate());
+    EXPECT_EQ(estimator.getDriftPpm(), 0.0);
+}
+
+TEST_F(ClockDriftTest, SyncRejectsInvalidConfig) {
+    AudioClockSyncConfig config;
+    config.sampleRate = 0;
+    EXPECT_THROW(AudioClockSync{config}, std::invalid_argument);
+
+    config = AudioClockSyncConfig();
+    config.targetDepthMs = -1;
+    EXPECT_THROW(AudioClockSync{config}, std::invalid_argument);
+
+    config = AudioClockSyncConfig();
+    config.maxDepthErrorMs = 0;
+    EXPECT_THROW(AudioClockSync{config}, std::invalid_argument);
+}
+
+TEST_F(ClockDriftTest, SyncSchedulesContinuousTimelineAtTargetDepth) {
+    AudioClockSync sync;
+    Sender sender(0.0, 0.0);
+
+    const uint64_t arrival = sender.arrivalNs(0);
+    EXPECT_DOUBLE_EQ(sync.update(sender.mediaNs(0), kChunkFrames, arrival), 1.0);
+    const uint64_t first = sync.advance(kChunkFrames);
+    EXPECT_EQ(first, arrival + constants::kDefaultAudioSyncTargetMs * 1000000ULL);
+
+    // Every output frame is one sample period later, whatever the input timestamps
+    sync.update(sender.mediaNs(1), kChunkFrames, sender.arrivalNs(1));
+    EXPECT_EQ(sync.advance(kChunkFrames - 1), first + kChunkNs);
+    sync.update(sender.mediaNs(2), kChunkFrames, sender.arrivalNs(2));
+    EXPECT_EQ(sync.advance(kChunkFrames),
+              first + (2 * kChunkFrames - 1) * 1000000000ULL / kSampleRate);
+
+    const AudioClockSyncStats stats = sync.getStats();
+    EXPECT_EQ(stats.resyncs, 1u);
+    EXPECT_EQ(stats.framesIn, 3u * kChunkFrames);
+    EXPECT_EQ(stats.framesOut, 3u * kChunkFrames - 1);
+}
+
+TEST_F(ClockDriftTest, SyncResyncsAfterOutage) {
+    AudioClockSync sync;
+    Sender sender(0.0, 0.0);
+    uint64_t chunk = 0;
+    for (; chunk < 50; chunk++) {
+        sync.update(sender.mediaNs(chunk), kChunkFrames, sender.arrivalNs(chunk));
+        sync.advance(kChunkFrames);
+    }
+
+    // Half a second without audio, then the stream resumes where it was
+    sender.stepNs = 500000000;
+    const uint64_t arrival = sender.arrivalNs(chunk);
+    sync.update(sender.mediaNs(chunk), kChunkFrames, arrival);
+    EXPECT_EQ(sync.advance(kChunkFrames),
+              arrival + constants::kDefaultAudioSyncTargetMs * 1000000ULL);
+    EXPECT_EQ(sync.getStats().resyncs, 2u);
+
+    // reset() forgets the timeline: the next chunk resyncs too
+    sync.reset();
+    chunk++;
+    sync.update(sender.mediaNs(chunk), kChunkFrames, sender.arrivalNs(chunk));
+    EXPECT_EQ(sync.getStats().resyncs, 3u);
+}
+
+TEST_F(ClockDriftTest, SyncCorrectsDelayStepWithoutResync) {
+    AudioClockSync sync;
+    ResamplerModel resampler;
+    Sender sender(0.0, 2.0);
+    uint64_t chunk = 0;
+    for (; chunk < 60 * 50; chunk++) {
+        const uint64_t arrival = sender.arrivalNs(chunk);
+        sync.advance(resampler.process(kChunkFrames,
+                                       sync.update(sender.mediaNs(chunk), kChunkFrames, arrival)));
+    }
+
+    // Audio now arrives 40 ms later: the timeline is stretched until the
+    // depth is back at the target
+    sender.stepNs = 40000000;
+    double minDepthMs = 1e9;
+    for (const uint64_t end = chunk + 5 * 60 * 50; chunk < end; chunk++) {
+        const uint64_t arrival = sender.arrivalNs(chunk);
+        const double ratio = sync.update(sender.mediaNs(chunk), kChunkFrames, arrival);
+        EXPECT_LE(std::fabs(ratio - 1.0), 0.0021);
+        const uint64_t timestamp = sync.advance(resampler.process(kChunkFrames, ratio));
+        if (end - chunk < 60 * 50) {
+            minDepthMs = std::min(minDepthMs, depthMs(timestamp, arrival));
+        }
+    }
+    // Back to the target, less jitter and the 30 ms spikes
+    EXPECT_GT(minDepthMs, constants::kDefaultAudioSyncTargetMs - 35.0);
+
+    const AudioClockSyncStats stats = sync.getStats();
+    EXPECT_EQ(stats.resyncs, 1u);
+    EXPECT_NEAR(stats.depthMs, constants::kDefaultAudioSyncTargetMs, 3.0);
+}
+
+// Eight hours at ±200 ppm, twice the spread of typical crystals. Uncompensated,
+// the sender's timestamps would gain or lose 5.8 s against the local clock.
+TEST_F(ClockDriftTest, SoakHoldsLatencyOverEightHours) {
+    constexpr uint64_t kChunks = 8ULL * 3600 * 50;
+    constexpr uint64_t kWarmupChunks = 2 * 60 * 50;
+
+    for (double driftPpm : {200.0, -200.0}) {
+        SCOPED_TRACE(driftPpm);
+        AudioClockSync sync;
+        ResamplerModel resampler;
+        Sender sender(driftPpm, 4.0, driftPpm > 0 ? 7u : 11u);
+
+        double minDepthMs = 1e9;
+        double maxDepthMs = -1e9;
+        double maxSmoothedErrorMs = 0.0;
+        for (uint64_t chunk = 0; chunk < kChunks; chunk++) {
+            const uint64_t arrival = sender.arrivalNs(chunk);
+            const double ratio = sync.update(sender.mediaNs(chunk), kChunkFrames, arrival);
+            const uint64_t timestamp = sync.advance(resampler.process(kChunkFrames, ratio));
+            if (chunk < kWarmupChunks) {
+                continue;
+            }
+
+            // Latency of every chunk: how far ahead of its arrival it is scheduled
+            const double depth = depthMs(timestamp, arrival);
+            minDepthMs = std::min(minDepthMs, depth);
+            maxDepthMs = std::max(maxDepthMs, depth);
+            maxSmoothedErrorMs =
+                std::max(maxSmoothedErrorMs,
+                         std::fabs(sync.getStats().depthMs - constants::kDefaultAudioSyncTargetMs));
+        }
+
+        const AudioClockSyncStats stats = sync.getStats();
+        EXPECT_EQ(stats.resyncs, 1u);
+        EXPECT_NEAR(stats.driftPpm, driftPpm, 5.0);
+        EXPECT_LT(maxSmoothedErrorMs, 5.0);
+        // Bounded by arrival jitter (4 ms, 30 ms spikes), not by elapsed time
+        EXPECT_GT(minDepthMs, constants::kDefaultAudioSyncTargetMs - 40.0);
+        EXPECT_LT(maxDepthMs, constants::kDefaultAudioSyncTargetMs + 10.0);
+
+        // The output runs at the local rate: input frames scaled by the drift
+        const double expectedOut = static_cast<double>(stats.framesIn) / (1.0 + driftPpm * 1e-6);
+        EXPECT_NEAR(static_cast<double>(stats.framesOut), expectedOut, 0.01 * kSampleRate);
+    }
+}
+
+TEST_F(ClockDriftTest, SyncDrivesRealResampler) {
+    // 16 kHz mono keeps two minutes of filtering quick in debug builds
+    constexpr uint32_t kWidebandFrames = 320;
+    AudioClockSyncConfig config;
+    config.sampleRate = 16000;
+    AudioClockSync sync(config);
+    AdaptiveResampler resampler(1);
+    Sender sender(300.0, 4.0);
+    std::vector<float> input(kWidebandFrames, 0.25f);
+    std::vector<float> output(2 * kWidebandFrames);
+    const float* in = input.data();
+    float* out = output.data();
+
+    double minDepthMs = 1e9;
+    double maxDepthMs = -1e9;
+    for (uint64_t chunk = 0; chunk < 2 * 60 * 50; chunk++) {
+        const uint64_t arrival = sender.arrivalNs(chunk);
+        resampler.setRatio(sync.update(sender.mediaNs(chunk), kWidebandFrames, arrival));
+        const size_t frames = resampler.process(&in, kWidebandFrames, &out, output.size());
+        ASSERT_LE(frames, output.size());
+        const uint64_t timestamp = sync.advance(frames);
+        if (chunk >= 60 * 50) {
+            minDepthMs = std::min(minDepthMs, depthMs(timestamp, arrival));
+            maxDepthMs = std::max(maxDepthMs, depthMs(timestamp, arrival));
+        }
+    }
+
+    EXPECT_EQ(sync.getStats().resyncs, 1u);
+    EXPECT_GT(minDepthMs, constants::kDefaultAudioSyncTargetMs - 40.0);
+    EXPECT_LT(maxDepthMs, constants::kDefaultAudioSyncTargetMs + 10.0);
+    EXPECT_NEAR(sync.getStats().driftPpm, 300.0, 15.0);
+}
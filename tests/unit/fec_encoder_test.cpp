@@ -0,0 +1,310 @@
+/**
+ * @file fec_encoder_test.cpp
+ * @brief Unit tests for FlexFEC encoding and the XOR kernels
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/fec-encoder.hpp"
+#include "core/rtp-packetizer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+namespace {
+
+constexpr uint32_t kMediaSsrc = 0x11223344;
+constexpr uint32_t kFecSsrc = 0x55667788;
+
+}  // namespace
+
+/**
+ * @brief Test fixture for FEC encoder tests
+ */
+class FecEncoderTest : public ::testing::Test {
+protected:
+    static std::vector<SimdLevel> supportedLevels() {
+        std::vector<SimdLevel> levels;
+        for (SimdLevel level :
+             {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+            if (isSimdLevelSupported(level)) {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+
+    static FlexFecConfig config(double ratio) {
+        FlexFecConfig fecConfig;
+        fecConfig.mediaSsrc = kMediaSsrc;
+        fecConfig.fecSsrc = kFecSsrc;
+        fecConfig.protectionRatio = ratio;
+        return fecConfig;
+    }
+
+    /** Media packet with a size and contents that differ per sequence number */
+    static std::vector<uint8_t> mediaPacket(uint16_t sequenceNumber, bool marker,
+                                            uint32_t timestamp = 90000) {
+        std::vector<uint8_t> packet(constants::kRtpHeaderSize + 100 + (sequenceNumber * 37) % 900);
+        writeRtpHeader(packet.data(), 96, marker, sequenceNumber, timestamp, kMediaSsrc);
+        for (size_t i = constants::kRtpHeaderSize; i < packet.size(); i++) {
+            packet[i] = static_cast<uint8_t>(i * 7 + sequenceNumber);
+        }
+        return packet;
+    }
+
+    static uint16_t readU16(const uint8_t* data) {
+        return static_cast<uint16_t>((data[0] << 8) | data[1]);
+    }
+
+    static uint32_t readU32(const uint8_t* data) {
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+               (static_cast<uint32_t>(data[2]) << 8) | data[3];
+    }
+
+    /** Sequence numbers protected by a FEC packet, decoded from its masks */
+    static std::vector<uint16_t> protectedSequenceNumbers(const std::vector<uint8_t>& fec) {
+        const uint8_t* header = fec.data() + constants::kRtpHeaderSize;
+        const uint16_t base = readU16(header + 16);
+        std::vector<uint16_t> sequenceNumbers;
+
+        const uint16_t mask1 = readU16(header + 18);
+        for (int i = 0; i < 15; i++) {
+            if (mask1 & (1u << (14 - i))) {
+                sequenceNumbers.push_back(static_cast<uint16_t>(base + i));
+            }
+        }
+        if (!(mask1 & 0x8000)) {
+            const uint32_t mask2 = readU32(header + 20);
+            for (int i = 0; i < 31; i++) {
+                if (mask2 & (1u << (30 - i))) {
+                    sequenceNumbers.push_back(static_cast<uint16_t>(base + 15 + i));
+                }
+            }
+        }
+        return sequenceNumbers;
+    }
+
+    /**
+     * Rebuild one missing packet the way a flexfec-03 receiver does: XOR the
+     * FEC recovery fields with every other protected packet.
+     */
+    static std::vector<uint8_t> recover(const std::vector<uint8_t>& fec,
+                                        const std::vector<std::vector<uint8_t>>& received,
+                                        uint16_t missing) {
+        const uint8_t* header = fec.data() + constants::kRtpHeaderSize;
+        const size_t headerSize = (readU16(header + 18) & 0x8000) ? 20 : 24;
+        const size_t parityLength = fec.size() - constants::kRtpHeaderSize - headerSize;
+
+        uint8_t byte0 = header[0];
+        uint8_t byte1 = header[1];
+        uint16_t length = readU16(header + 2);
+        uint32_t timestamp = readU32(header + 4);
+        std::vector<uint8_t> payload(header + headerSize, header + headerSize + parityLength);
+
+        for (const auto& packet : received) {
+            byte0 ^= packet[0];
+            byte1 ^= packet[1];
+            length ^= static_cast<uint16_t>(packet.size() - constants::kRtpHeaderSize);
+            timestamp ^= readU32(packet.data() + 4);
+            for (size_t i = constants::kRtpHeaderSize; i < packet.size(); i++) {
+                payload[i - constants::kRtpHeaderSize] ^= packet[i];
+            }
+        }
+
+        std::vector<uint8_t> packet(constants::kRtpHeaderSize + length);
+        writeRtpHeader(packet.data(), byte1 & 0x7F, (byte1 & 0x80) != 0, missing, timestamp,
+                       readU32(header + 12));
+        packet[0] = static_cast<uint8_t>(0x80 | (byte0 & 0x3F));
+        std::copy(payload.begin(), payload.begin() + length,
+                  packet.begin() + constants::kRtpHeaderSize);
+        return packet;
+    }
+};
+
+/**
+ * @brief Test that every supported XOR kernel matches a byte loop
+ */
+TEST_F(FecEncoderTest, XorKernelsMatchScalar) {
+    for (size_t size : {0u, 1u, 7u, 15u, 16u, 31u, 33u, 64u, 100u, 1488u}) {
+        std::vector<uint8_t> src(size);
+        std::vector<uint8_t> expected(size);
+        for (size_t i = 0; i < size; i++) {
+            src[i] = static_cast<uint8_t>(i * 13 + 5);
+            expected[i] = static_cast<uint8_t>(i * 3) ^ src[i];
+        }
+
+        for (SimdLevel level : supportedLevels()) {
+            std::vector<uint8_t> dst(size);
+            for (size_t i = 0; i < size; i++) {
+                dst[i] = static_cast<uint8_t>(i * 3);
+            }
+            xorBytes(dst.data(), src.data(), size, level);
+            EXPECT_EQ(dst, expected) << simdLevelName(level) << " size " << size;
+        }
+
+        std::vector<uint8_t> dst(size);
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = static_cast<uint8_t>(i * 3);
+        }
+        xorBytes(dst.data(), src.data(), size);
+        EXPECT_EQ(dst, expected) << "size " << size;
+    }
+}
+
+/**
+ * @brief Test that unsupported XOR kernels are rejected
+ */
+TEST_F(FecEncoderTest, UnsupportedXorLevelThrows) {
+    uint8_t dst[4] = {};
+    const uint8_t src[4] = {};
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+        if (!isSimdLevelSupported(level)) {
+            EXPECT_THROW(xorBytes(dst, src, sizeof(dst), level), std::invalid_argument);
+        }
+    }
+}
+
+/**
+ * @brief Test the protection ratio policy
+ */
+TEST_F(FecEncoderTest, ProtectionRatioFollowsLoss) {
+    EXPECT_DOUBLE_EQ(fecProtectionRatioForLoss(0.0, 0.1, 0.5), 0.1);
+    EXPECT_DOUBLE_EQ(fecProtectionRatioForLoss(0.02, 0.1, 0.5), 0.1);
+    EXPECT_DOUBLE_EQ(fecProtectionRatioForLoss(0.1, 0.1, 0.5), 0.1 * constants::kFecLossMultiplier);
+    EXPECT_DOUBLE_EQ(fecProtectionRatioForLoss(0.4, 0.1, 0.5), 0.5);
+}
+
+/**
+ * @brief Test that invalid configurations are rejected
+ */
+TEST_F(FecEncoderTest, InvalidConfigThrows) {
+    EXPECT_THROW(FlexFecEncoder(config(-0.1)), std::invalid_argument);
+    EXPECT_THROW(FlexFecEncoder(config(1.5)), std::invalid_argument);
+
+    FlexFecConfig tiny = config(0.1);
+    tiny.maxPacketSize = constants::kRtpHeaderSize;
+    EXPECT_THROW(FlexFecEncoder{tiny}, std::invalid_argument);
+}
+
+/**
+ * @brief Test the RTP and FlexFEC headers of a FEC packet
+ */
+TEST_F(FecEncoderTest, WritesFlexFecHeader) {
+    FlexFecEncoder encoder(config(0.25));
+    std::vector<uint8_t> fec;
+    std::vector<std::vector<uint8_t>> packets;
+    for (uint16_t sequenceNumber = 1000; sequenceNumber < 1004; sequenceNumber++) {
+        packets.push_back(mediaPacket(sequenceNumber, false, 3000));
+        EXPECT_EQ(encoder.addPacket(packets.back().data(), packets.back().size(), fec),
+                  sequenceNumber == 1003);
+    }
+
+    ASSERT_GE(fec.size(), constants::kRtpHeaderSize + 20u);
+    EXPECT_EQ(fec[0], 0x80);
+    EXPECT_EQ(fec[1], constants::kDefaultFecPayloadType);
+    EXPECT_EQ(readU32(fec.data() + 4), 3000u);
+    EXPECT_EQ(readU32(fec.data() + 8), kFecSsrc);
+
+    const uint8_t* header = fec.data() + constants::kRtpHeaderSize;
+    EXPECT_EQ(header[0] & 0xC0, 0);  // R = 0, F = 0
+    EXPECT_EQ(header[8], 1);         // SSRCCount
+    EXPECT_EQ(readU32(header + 12), kMediaSsrc);
+    EXPECT_EQ(readU16(header + 16), 1000);
+    EXPECT_EQ(readU16(header + 18), 0x8000 | 0x7800);
+
+    size_t longest = 0;
+    for (const auto& packet : packets) {
+        longest = std::max(longest, packet.size() - constants::kRtpHeaderSize);
+    }
+    EXPECT_EQ(fec.size(), constants::kRtpHeaderSize + 20 + longest);
+}
+
+/**
+ * @brief Test that any single lost packet of a group is recovered exactly
+ */
+TEST_F(FecEncoderTest, RecoversAnySingleLoss) {
+    for (size_t groupSize : {2u, 5u, 15u, 16u, 40u}) {
+        FlexFecEncoder encoder(config(1.0 / groupSize));
+        std::vector<uint8_t> fec;
+        std::vector<std::vector<uint8_t>> packets;
+        for (size_t i = 0; i < groupSize; i++) {
+            // Wraps the sequence number and varies marker/timestamp
+            const auto sequenceNumber = static_cast<uint16_t>(65530 + i);
+            packets.push_back(mediaPacket(sequenceNumber, false, 90000 + 3000 * (i / 4)));
+            ASSERT_EQ(encoder.addPacket(packets.back().data(), packets.back().size(), fec),
+                      i + 1 == groupSize);
+        }
+
+        const auto sequenceNumbers = protectedSequenceNumbers(fec);
+        ASSERT_EQ(sequenceNumbers.size(), groupSize);
+        EXPECT_EQ(sequenceNumbers.front(), 65530);
+
+        for (size_t lost = 0; lost < groupSize; lost++) {
+            std::vector<std::vector<uint8_t>> received;
+            for (size_t i = 0; i < groupSize; i++) {
+                if (i != lost) {
+                    received.push_back(packets[i]);
+                }
+            }
+            EXPECT_EQ(recover(fec, received, sequenceNumbers[lost]), packets[lost])
+                << "group " << groupSize << " lost " << lost;
+        }
+    }
+}
+
+/**
+ * @brief Test that a frame end closes a group once it is half full
+ */
+TEST_F(FecEncoderTest, ClosesGroupAtFrameEnd) {
+    FlexFecEncoder encoder(config(0.1));  // Groups of 10
+    std::vector<uint8_t> fec;
+
+    // A 3-packet frame is too small, so its packets roll into the next frame
+    for (uint16_t sequenceNumber = 1; sequenceNumber <= 3; sequenceNumber++) {
+        auto packet = mediaPacket(sequenceNumber, sequenceNumber == 3);
+        EXPECT_FALSE(encoder.addPacket(packet.data(), packet.size(), fec));
+    }
+    for (uint16_t sequenceNumber = 4; sequenceNumber <= 5; sequenceNumber++) {
+        auto packet = mediaPacket(sequenceNumber, sequenceNumber == 5);
+        EXPECT_EQ(encoder.addPacket(packet.data(), packet.size(), fec), sequenceNumber == 5);
+    }
+    EXPECT_THAT(protectedSequenceNumbers(fec), ElementsAre(1, 2, 3, 4, 5));
+}
+
+/**
+ * @brief Test that a sequence gap, other SSRCs and a zero ratio stop protection
+ */
+TEST_F(FecEncoderTest, SkipsUnprotectablePackets) {
+    FlexFecEncoder encoder(config(0.5));
+    std::vector<uint8_t> fec;
+
+    auto first = mediaPacket(10, false);
+    auto afterGap = mediaPacket(12, false);
+    auto next = mediaPacket(13, false);
+    EXPECT_FALSE(encoder.addPacket(first.data(), first.size(), fec));
+    EXPECT_FALSE(encoder.addPacket(afterGap.data(), afterGap.size(), fec));
+    EXPECT_TRUE(encoder.addPacket(next.data(), next.size(), fec));
+    EXPECT_THAT(protectedSequenceNumbers(fec), ElementsAre(12, 13));
+
+    auto other = mediaPacket(14, false);
+    writeRtpHeader(other.data(), 96, false, 14, 90000, kMediaSsrc + 1);
+    EXPECT_FALSE(encoder.addPacket(other.data(), other.size(), fec));
+    EXPECT_FALSE(encoder.addPacket(other.data(), 4, fec));
+
+    encoder.setProtectionRatio(0.0);
+    EXPECT_DOUBLE_EQ(encoder.getProtectionRatio(), 0.0);
+    for (uint16_t sequenceNumber = 20; sequenceNumber < 40; sequenceNumber++) {
+        auto packet = mediaPacket(sequenceNumber, true);
+        EXPECT_FALSE(encoder.addPacket(packet.data(), packet.size(), fec));
+    }
+
+    encoder.setProtectionRatio(7.0);
+    EXPECT_DOUBLE_EQ(encoder.getProtectionRatio(), 1.0);
+    auto packet = mediaPacket(40, false);
+    EXPECT_TRUE(encoder.addPacket(packet.data(), packet.size(), fec));
+}
@@ -0,0 +1,210 @@
+/**
+ * @file frame_drop_policy_test.cpp
+ * @brief Unit tests for H.264 frame classification and FrameDropPolicy
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/frame-drop-policy.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for frame drop policy tests
+ */
+class FrameDropPolicyTest : public ::testing::Test {
+protected:
+    /** Synthetic Annex-B access unit as an H.264 encoder would emit it */
+    static std::vector<uint8_t> h264Frame(FrameClass frameClass) {
+        std::vector<uint8_t> frame = {0, 0, 0, 1, 0x09, 0xF0};  // Access unit delimiter
+        switch (frameClass) {
+            case FrameClass::Keyframe:
+                frame.insert(frame.end(), {0, 0, 0, 1, 0x67, 0x42, 0xC0, 0x1F});  // SPS
+                frame.insert(frame.end(), {0, 0, 0, 1, 0x68, 0xCE, 0x3C, 0x80});  // PPS
+                frame.insert(frame.end(), {0, 0, 1, 0x65});                        // IDR slice
+                break;
+            case FrameClass::Reference:
+                frame.insert(frame.end(), {0, 0, 0, 1, 0x06, 0x05, 0x01, 0x80});  // SEI
+                frame.insert(frame.end(), {0, 0, 1, 0x41});  // Non-IDR slice, nal_ref_idc 2
+                break;
+            case FrameClass::NonReference:
+                frame.insert(frame.end(), {0, 0, 1, 0x01});  // Non-IDR slice, nal_ref_idc 0
+                break;
+        }
+        frame.insert(frame.end(), 200, 0xA5);
+        return frame;
+    }
+
+    static FrameDropPolicyConfig config(size_t queueDepth) {
+        FrameDropPolicyConfig policyConfig;
+        policyConfig.queueDepth = queueDepth;
+        policyConfig.nonReferenceThreshold = 0.25;
+        policyConfig.gopThreshold = 0.5;
+        return policyConfig;
+    }
+};
+
+/**
+ * @brief Test that access units are classified from their first slice
+ */
+TEST_F(FrameDropPolicyTest, ClassifiesH264Frames) {
+    for (FrameClass frameClass :
+         {FrameClass::Keyframe, FrameClass::Reference, FrameClass::NonReference}) {
+        const auto frame = h264Frame(frameClass);
+        EXPECT_EQ(classifyH264Frame(frame.data(), frame.size()), frameClass);
+    }
+
+    // No slice at all, or no data, is treated as a reference frame
+    const std::vector<uint8_t> parameterSets = {0, 0, 0, 1, 0x67, 0x42, 0, 0, 1, 0x68, 0xCE};
+    EXPECT_EQ(classifyH264Frame(parameterSets.data(), parameterSets.size()), FrameClass::Reference);
+    EXPECT_EQ(classifyH264Frame(nullptr, 0), FrameClass::Reference);
+
+    // A truncated start code at the end is not read past
+    const std::vector<uint8_t> truncated = {0, 0, 1};
+    EXPECT_EQ(classifyH264Frame(truncated.data(), truncated.size()), FrameClass::Reference);
+}
+
+/**
+ * @brief Test that invalid configurations are rejected
+ */
+TEST_F(FrameDropPolicyTest, InvalidConfigThrows) {
+    EXPECT_THROW(FrameDropPolicy(config(0)), std::invalid_argument);
+
+    auto bad = config(100);
+    bad.nonReferenceThreshold = 0.0;
+    EXPECT_THROW(FrameDropPolicy{bad}, std::invalid_argument);
+
+    bad = config(100);
+    bad.nonReferenceThreshold = 0.6;
+    EXPECT_THROW(FrameDropPolicy{bad}, std::invalid_argument);
+
+    bad = config(100);
+    bad.gopThreshold = 1.5;
+    EXPECT_THROW(FrameDropPolicy{bad}, std::invalid_argument);
+}
+
+/**
+ * @brief Test the stages: disposable frames, then the GOP, then a keyframe request
+ */
+TEST_F(FrameDropPolicyTest, DropsInStages) {
+    FrameDropPolicy policy(config(100));
+
+    // Below 25%: everything goes out
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::NonReference, 24), FrameDropAction::Send);
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::Reference, 24), FrameDropAction::Send);
+
+    // 25-50%: only disposable frames are dropped
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::NonReference, 25), FrameDropAction::Drop);
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::Reference, 49), FrameDropAction::Send);
+    EXPECT_FALSE(policy.isDroppingGop());
+
+    // 50%: the rest of the GOP goes, even after the queue drains
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::Reference, 50), FrameDropAction::Drop);
+    EXPECT_TRUE(policy.isDroppingGop());
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::Reference, 30), FrameDropAction::Drop);
+    EXPECT_FALSE(policy.takeKeyframeRequest());
+
+    // Drained below 25%: ask for a fresh keyframe, once
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::Reference, 10), FrameDropAction::Drop);
+    EXPECT_TRUE(policy.takeKeyframeRequest());
+    EXPECT_FALSE(policy.takeKeyframeRequest());
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::NonReference, 0), FrameDropAction::Drop);
+    EXPECT_FALSE(policy.takeKeyframeRequest());
+
+    // The keyframe ends the episode
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::Keyframe, 10), FrameDropAction::Send);
+    EXPECT_FALSE(policy.isDroppingGop());
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::Reference, 10), FrameDropAction::Send);
+}
+
+/**
+ * @brief Test that an overflow drops the GOP and requests a keyframe at once
+ */
+TEST_F(FrameDropPolicyTest, OverflowRequestsKeyframe) {
+    FrameDropPolicy policy(config(100));
+
+    policy.onOverflow();
+    EXPECT_TRUE(policy.isDroppingGop());
+    EXPECT_TRUE(policy.takeKeyframeRequest());
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::Reference, 0), FrameDropAction::Drop);
+
+    // Further overflows in the same episode do not ask again
+    policy.onOverflow();
+    EXPECT_FALSE(policy.takeKeyframeRequest());
+
+    policy.reset();
+    EXPECT_FALSE(policy.isDroppingGop());
+    EXPECT_EQ(policy.onVideoFrame(FrameClass::Reference, 0), FrameDropAction::Send);
+}
+
+/**
+ * @brief Test a synthetic stream over a link with 40% of the needed capacity
+ *
+ * Every sent frame must stay decodable: no frame goes out after a dropped
+ * reference frame until the next keyframe, and disposable frames are shed
+ * before any reference frame.
+ */
+TEST_F(FrameDropPolicyTest, SyntheticStreamStaysDecodable) {
+    constexpr size_t kQueueDepth = 40;
+    constexpr int kGopLength = 60;
+    FrameDropPolicy policy(config(kQueueDepth));
+
+    double queued = 0.0;
+    bool referenceLost = false;
+    int nonReferenceDropped = 0;
+    int referenceDropped = 0;
+    int sent = 0;
+    int keyframeRequests = 0;
+    int firstReferenceDrop = -1;
+    int firstNonReferenceDrop = -1;
+
+    for (int i = 0; i < 10 * kGopLength; i++) {
+        // I P b P b ... with a keyframe every kGopLength frames
+        const FrameClass frameClass = i % kGopLength == 0 ? FrameClass::Keyframe
+                                      : i % 2 == 1       ? FrameClass::Reference
+                                                         : FrameClass::NonReference;
+        const auto frame = h264Frame(frameClass);
+        ASSERT_EQ(classifyH264Frame(frame.data(), frame.size()), frameClass);
+
+        queued = std::max(0.0, queued - 0.4);  // Link drains 40% of the frame rate
+        const auto action =
+            policy.onVideoFrame(classifyH264Frame(frame.data(), frame.size()),
+                                static_cast<size_t>(queued));
+        keyframeRequests += policy.takeKeyframeRequest() ? 1 : 0;
+
+        if (action == FrameDropAction::Drop) {
+            if (frameClass == FrameClass::Reference) {
+                referenceLost = true;
+                referenceDropped++;
+                if (firstReferenceDrop < 0) {
+                    firstReferenceDrop = i;
+                }
+            } else {
+                nonReferenceDropped++;
+                if (firstNonReferenceDrop < 0) {
+                    firstNonReferenceDrop = i;
+                }
+            }
+            continue;
+        }
+
+        ASSERT_LT(queued, static_cast<double>(kQueueDepth)) << "queue overflowed at frame " << i;
+        if (frameClass == FrameClass::Keyframe) {
+            referenceLost = false;
+        }
+        EXPECT_FALSE(referenceLost) << "undecodable frame sent at " << i;
+        queued += 1.0;
+        sent++;
+    }
+
+    EXPECT_GT(nonReferenceDropped, 0);
+    EXPECT_GT(referenceDropped, 0);
+    EXPECT_LT(firstNonReferenceDrop, firstReferenceDrop);
+    EXPECT_GT(keyframeRequests, 0);
+    EXPECT_GT(sent, 5 * kGopLength / 2);
+}
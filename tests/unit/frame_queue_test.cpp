@@ -0,0 +1,207 @@
+/**
+ * @file frame_queue_test.cpp
+ * @brief Unit tests for the bounded receive frame queue
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/buffer-pool.hpp"
+#include "core/frame-queue.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for FrameQueue tests
+ */
+class FrameQueueTest : public ::testing::Test {
+protected:
+    static std::vector<int> drain(FrameQueue<int>& queue) {
+        std::vector<int> frames;
+        int frame = 0;
+        while (queue.pop(frame)) {
+            frames.push_back(frame);
+        }
+        return frames;
+    }
+};
+
+/**
+ * @brief Test that a zero capacity is rejected
+ */
+TEST_F(FrameQueueTest, ZeroCapacityThrows) {
+    EXPECT_THROW(FrameQueue<int> queue(0), std::invalid_argument);
+}
+
+/**
+ * @brief Test FIFO order and counters while the queue has room
+ */
+TEST_F(FrameQueueTest, KeepsOrderBelowCapacity) {
+    FrameQueue<int> queue(4);
+    queue.pushVideo(1, FrameClass::Keyframe);
+    queue.pushVideo(2, FrameClass::Reference);
+    queue.push(3);
+    EXPECT_EQ(queue.size(), 3u);
+
+    FrameQueueStats stats = queue.getStats();
+    EXPECT_EQ(stats.depth, 3u);
+    EXPECT_EQ(stats.capacity, 4u);
+    EXPECT_EQ(stats.maxDepth, 3u);
+    EXPECT_EQ(stats.pushed, 3u);
+    EXPECT_EQ(stats.dropped, 0u);
+
+    EXPECT_THAT(drain(queue), ElementsAre(1, 2, 3));
+    EXPECT_EQ(queue.getStats().maxDepth, 3u);
+
+    int frame = 0;
+    EXPECT_FALSE(queue.pop(frame));
+}
+
+/**
+ * @brief Test that independent frames evict the oldest on overflow
+ */
+TEST_F(FrameQueueTest, PushEvictsOldest) {
+    FrameQueue<int> queue(3);
+    for (int i = 1; i <= 5; i++) {
+        queue.push(i);
+    }
+
+    EXPECT_EQ(queue.getStats().dropped, 2u);
+    EXPECT_THAT(drain(queue), ElementsAre(3, 4, 5));
+
+    // Wraps around cleanly once drained
+    queue.push(6);
+    queue.push(7);
+    EXPECT_THAT(drain(queue), ElementsAre(6, 7));
+}
+
+/**
+ * @brief Test that disposable frames are dropped before reference frames
+ */
+TEST_F(FrameQueueTest, VideoOverflowDropsNonReferenceFirst) {
+    FrameQueue<int> queue(3);
+    queue.pushVideo(1, FrameClass::Keyframe);
+    queue.pushVideo(2, FrameClass::NonReference);
+    queue.pushVideo(3, FrameClass::Reference);
+
+    // Room is made by evicting the queued disposable frame
+    EXPECT_TRUE(queue.pushVideo(4, FrameClass::Reference));
+    // An incoming disposable frame is simply dropped
+    EXPECT_FALSE(queue.pushVideo(5, FrameClass::NonReference));
+    EXPECT_FALSE(queue.isAwaitingKeyframe());
+
+    EXPECT_EQ(queue.getStats().dropped, 2u);
+    EXPECT_THAT(drain(queue), ElementsAre(1, 3, 4));
+}
+
+/**
+ * @brief Test that a lost reference frame skips the rest of the GOP
+ */
+TEST_F(FrameQueueTest, LostReferenceWaitsForKeyframe) {
+    FrameQueue<int> queue(2);
+    queue.pushVideo(1, FrameClass::Keyframe);
+    queue.pushVideo(2, FrameClass::Reference);
+
+    EXPECT_FALSE(queue.pushVideo(3, FrameClass::Reference));
+    EXPECT_TRUE(queue.isAwaitingKeyframe());
+    EXPECT_THAT(drain(queue), ElementsAre(1, 2));
+
+    // The queue has room again, but these frames predict from frame 3
+    EXPECT_FALSE(queue.pushVideo(4, FrameClass::Reference));
+    EXPECT_FALSE(queue.pushVideo(5, FrameClass::NonReference));
+    EXPECT_EQ(queue.size(), 0u);
+
+    EXPECT_TRUE(queue.pushVideo(6, FrameClass::Keyframe));
+    EXPECT_FALSE(queue.isAwaitingKeyframe());
+    EXPECT_TRUE(queue.pushVideo(7, FrameClass::Reference));
+    EXPECT_THAT(drain(queue), ElementsAre(6, 7));
+    EXPECT_EQ(queue.getStats().dropped, 3u);
+}
+
+/**
+ * @brief Test that a keyframe replaces a full backlog
+ */
+TEST_F(FrameQueueTest, KeyframeReplacesFullBacklog) {
+    FrameQueue<int> queue(3);
+    queue.pushVideo(1, FrameClass::Keyframe);
+    queue.pushVideo(2, FrameClass::Reference);
+    queue.pushVideo(3, FrameClass::Reference);
+
+    EXPECT_TRUE(queue.pushVideo(4, FrameClass::Keyframe));
+    FrameQueueStats stats = queue.getStats();
+    EXPECT_EQ(stats.depth, 1u);
+    EXPECT_EQ(stats.maxDepth, 3u);
+    EXPECT_EQ(stats.dropped, 3u);
+    EXPECT_THAT(drain(queue), ElementsAre(4));
+
+    // Below capacity a keyframe just queues behind the others
+    queue.pushVideo(5, FrameClass::Reference);
+    queue.pushVideo(6, FrameClass::Keyframe);
+    EXPECT_THAT(drain(queue), ElementsAre(5, 6));
+}
+
+/**
+ * @brief Test that frames release their buffers as soon as they leave the queue
+ */
+TEST_F(FrameQueueTest, ReleasesDroppedAndPoppedBuffers) {
+    const std::vector<uint8_t> payload(100, 0x42);
+    BufferSlice slice = BufferSlice::copyOf(payload.data(), payload.size());
+
+    FrameQueue<BufferSlice> queue(2);
+    queue.pushVideo(slice, FrameClass::Keyframe);
+    queue.pushVideo(slice, FrameClass::NonReference);
+    EXPECT_EQ(slice.useCount(), 3u);
+
+    queue.pushVideo(slice, FrameClass::Reference);  // Evicts the disposable frame
+    EXPECT_EQ(slice.useCount(), 3u);
+
+    BufferSlice out;
+    ASSERT_TRUE(queue.pop(out));
+    EXPECT_EQ(slice.useCount(), 3u);
+    out = BufferSlice();
+    EXPECT_EQ(slice.useCount(), 2u);
+
+    queue.clear();
+    EXPECT_EQ(slice.useCount(), 1u);
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+/**
+ * @brief Test a producer outrunning a slow consumer
+ */
+TEST_F(FrameQueueTest, BoundsDepthUnderConcurrentLoad) {
+    constexpr int kFrames = 2000;
+    FrameQueue<int> queue(8);
+    std::atomic<bool> done{false};
+
+    std::thread producer([&queue, &done]() {
+        for (int i = 0; i < kFrames; i++) {
+            queue.pushVideo(i, i % 30 == 0 ? FrameClass::Keyframe : FrameClass::Reference);
+        }
+        done = true;
+    });
+
+    int consumed = 0;
+    int last = -1;
+    int frame = 0;
+    while (!done || queue.size() > 0) {
+        if (queue.pop(frame)) {
+            EXPECT_GT(frame, last);
+            last = frame;
+            consumed++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    FrameQueueStats stats = queue.getStats();
+    EXPECT_LE(stats.maxDepth, 8u);
+    EXPECT_EQ(stats.pushed, static_cast<uint64_t>(kFrames));
+    EXPECT_EQ(stats.dropped + consumed, static_cast<uint64_t>(kFrames));
+}
@@ -0,0 +1,138 @@
+/**
+ * @file h264_parameter_sets_test.cpp
+ * @brief Unit tests for the H.264 SPS/PPS cache
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/h264-parameter-sets.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for H264ParameterSetCache tests
+ */
+class H264ParameterSetCacheTest : public ::testing::Test {
+protected:
+    const std::vector<uint8_t> sps_ = {0x67, 0x42, 0x00, 0x1F, 0xE9};
+    const std::vector<uint8_t> pps_ = {0x68, 0xCE, 0x38, 0x80};
+
+    /** Concatenate NAL units with 4-byte start codes */
+    static std::vector<uint8_t> annexB(const std::vector<std::vector<uint8_t>>& nalUnits) {
+        std::vector<uint8_t> out;
+        for (const auto& nal : nalUnits) {
+            out.insert(out.end(), {0, 0, 0, 1});
+            out.insert(out.end(), nal.begin(), nal.end());
+        }
+        return out;
+    }
+
+    /** Expected STAP-A for one SPS and one PPS */
+    static std::vector<uint8_t> stapA(const std::vector<uint8_t>& sps,
+                                      const std::vector<uint8_t>& pps) {
+        std::vector<uint8_t> out = {static_cast<uint8_t>(
+            std::max(sps[0] & 0x60, pps[0] & 0x60) | 24)};
+        for (const auto* nal : {&sps, &pps}) {
+            out.push_back(static_cast<uint8_t>(nal->size() >> 8));
+            out.push_back(static_cast<uint8_t>(nal->size()));
+            out.insert(out.end(), nal->begin(), nal->end());
+        }
+        return out;
+    }
+
+    bool update(H264ParameterSetCache& cache, const std::vector<uint8_t>& accessUnit) {
+        return cache.update(splitAnnexB(accessUnit.data(), accessUnit.size()));
+    }
+};
+
+/**
+ * @brief Test that Annex-B extradata seeds the cache
+ */
+TEST_F(H264ParameterSetCacheTest, ParsesAnnexBExtradata) {
+    H264ParameterSetCache cache;
+    EXPECT_FALSE(cache.hasParameterSets());
+    EXPECT_TRUE(cache.stapA().empty());
+
+    const auto extradata = annexB({sps_, pps_});
+    ASSERT_TRUE(cache.setExtradata(extradata.data(), extradata.size()));
+    EXPECT_TRUE(cache.hasParameterSets());
+    EXPECT_EQ(cache.stapA(), stapA(sps_, pps_));
+}
+
+/**
+ * @brief Test that avcC extradata seeds the cache
+ */
+TEST_F(H264ParameterSetCacheTest, ParsesAvcCExtradata) {
+    std::vector<uint8_t> avcC = {0x01, 0x42, 0x00, 0x1F, 0xFF, 0xE1};
+    avcC.insert(avcC.end(), {0x00, static_cast<uint8_t>(sps_.size())});
+    avcC.insert(avcC.end(), sps_.begin(), sps_.end());
+    avcC.insert(avcC.end(), {0x01, 0x00, static_cast<uint8_t>(pps_.size())});
+    avcC.insert(avcC.end(), pps_.begin(), pps_.end());
+
+    H264ParameterSetCache cache;
+    ASSERT_TRUE(cache.setExtradata(avcC.data(), avcC.size()));
+    EXPECT_EQ(cache.stapA(), stapA(sps_, pps_));
+
+    // Truncated records keep what parsed and report the rest missing
+    EXPECT_FALSE(cache.setExtradata(avcC.data(), avcC.size() - 2));
+    EXPECT_FALSE(cache.hasParameterSets());
+}
+
+/**
+ * @brief Test that unusable extradata leaves the cache empty
+ */
+TEST_F(H264ParameterSetCacheTest, RejectsIncompleteExtradata) {
+    H264ParameterSetCache cache;
+    EXPECT_FALSE(cache.setExtradata(nullptr, 0));
+
+    const auto spsOnly = annexB({sps_});
+    EXPECT_FALSE(cache.setExtradata(spsOnly.data(), spsOnly.size()));
+    EXPECT_FALSE(cache.hasParameterSets());
+    EXPECT_TRUE(cache.stapA().empty());
+}
+
+/**
+ * @brief Test that only IDRs lacking SPS/PPS ask for injection
+ */
+TEST_F(H264ParameterSetCacheTest, RequestsInjectionForBareIdrOnly) {
+    H264ParameterSetCache cache;
+    const auto extradata = annexB({sps_, pps_});
+    ASSERT_TRUE(cache.setExtradata(extradata.data(), extradata.size()));
+
+    const std::vector<uint8_t> idr = {0x65, 0x88, 0x84, 0x00};
+    const std::vector<uint8_t> delta = {0x41, 0x9A, 0x22};
+
+    EXPECT_TRUE(update(cache, annexB({idr})));
+    EXPECT_FALSE(update(cache, annexB({delta})));
+    EXPECT_FALSE(update(cache, annexB({sps_, pps_, idr})));
+    EXPECT_TRUE(update(cache, annexB({sps_, idr})));  // PPS missing
+
+    // Nothing to inject without a cache
+    H264ParameterSetCache empty;
+    EXPECT_FALSE(update(empty, annexB({idr})));
+}
+
+/**
+ * @brief Test that in-band parameter sets replace the cached ones
+ */
+TEST_F(H264ParameterSetCacheTest, TracksInBandUpdates) {
+    H264ParameterSetCache cache;
+    const std::vector<uint8_t> idr = {0x65, 0x88, 0x84, 0x00};
+
+    // Learned from the stream alone
+    EXPECT_FALSE(update(cache, annexB({sps_, pps_, idr})));
+    EXPECT_EQ(cache.stapA(), stapA(sps_, pps_));
+
+    // A resolution change brings a new SPS
+    const std::vector<uint8_t> newSps = {0x67, 0x64, 0x00, 0x28, 0xAC, 0xD9};
+    EXPECT_FALSE(update(cache, annexB({newSps, pps_, idr})));
+    EXPECT_EQ(cache.stapA(), stapA(newSps, pps_));
+    EXPECT_TRUE(update(cache, annexB({idr})));
+
+    cache.reset();
+    EXPECT_FALSE(cache.hasParameterSets());
+    EXPECT_FALSE(update(cache, annexB({idr})));
+}
@@ -0,0 +1,701 @@
+/**
+ * @file jitter_buffer_test.cpp
+ * @brief Unit tests for the adaptive receive jitter buffer
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/jitter-buffer.hpp"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+namespace {
+
+/**
+ * @brief One packet as it reaches the receiver
+ */
+struct Packet {
+    uint16_t sequence;
+    uint32_t timestamp;
+    bool marker;
+    int64_t arrivalMs;
+};
+
+/**
+ * @brief Network impairments applied to a packet stream
+ */
+struct Impairment {
+    int baseDelayMs = 20;
+    int jitterMs = 0;              // Extra delay, uniform in [0, jitterMs]
+    double lossRate = 0.0;
+    double duplicateRate = 0.0;
+};
+
+/**
+ * @brief Deterministic (seeded) generator of impaired RTP streams
+ *
+ * Frames are sent every 33 ms (2970 ticks at 90 kHz), all packets of a
+ * frame at once. Each packet gets its own random delay, which reorders
+ * packets whenever the jitter exceeds the spacing between them.
+ */
+class ImpairedStream {
+public:
+    ImpairedStream(uint32_t seed, const Impairment& impairment)
+        : random_(seed), impairment_(impairment) {}
+
+    std::vector<Packet> video(int frames, int packetsPerFrame, uint16_t firstSequence = 0,
+                              uint32_t firstTimestamp = 0) {
+        std::vector<Packet> packets;
+        uint16_t sequence = firstSequence;
+        for (int frame = 0; frame < frames; frame++) {
+            const uint32_t timestamp = firstTimestamp + static_cast<uint32_t>(frame) * 2970;
+            const int64_t sentMs = 1000 + frame * 33;
+            for (int packet = 0; packet < packetsPerFrame; packet++) {
+                send(packets, {sequence++, timestamp, packet == packetsPerFrame - 1, sentMs});
+            }
+        }
+        std::stable_sort(packets.begin(), packets.end(), [](const Packet& a, const Packet& b) {
+            return a.arrivalMs < b.arrivalMs;
+        });
+        return packets;
+    }
+
+private:
+    void send(std::vector<Packet>& packets, Packet packet) {
+        std::uniform_real_distribution<double> chance(0.0, 1.0);
+        std::uniform_int_distribution<int> jitter(0, impairment_.jitterMs);
+        const int64_t sentMs = packet.arrivalMs;
+
+        if (chance(random_) < impairment_.lossRate) {
+            return;
+        }
+        packet.arrivalMs = sentMs + impairment_.baseDelayMs + jitter(random_);
+        packets.push_back(packet);
+        if (chance(random_) < impairment_.duplicateRate) {
+            packet.arrivalMs = sentMs + impairment_.baseDelayMs + jitter(random_);
+            packets.push_back(packet);
+        }
+    }
+
+    std::mt19937 random_;
+    Impairment impairment_;
+};
+
+BufferSlice sequencePayload(uint16_t sequence) {
+    const uint8_t bytes[2] = {static_cast<uint8_t>(sequence >> 8),
+                              static_cast<uint8_t>(sequence & 0xFF)};
+    return BufferSlice::copyOf(bytes, sizeof(bytes));
+}
+
+uint16_t payloadSequence(const BufferSlice& payload) {
+    return static_cast<uint16_t>((payload[0] << 8) | payload[1]);
+}
+
+/**
+ * @brief A released frame and when it came out
+ */
+struct Released {
+    uint32_t timestamp;
+    std::vector<uint16_t> sequences;
+    bool discontinuity;
+    int64_t releasedMs;
+};
+
+/**
+ * @brief Feed packets in arrival order, popping every millisecond
+ */
+std::vector<Released> play(JitterBuffer& buffer, const std::vector<Packet>& packets) {
+    std::vector<Released> released;
+    JitterFrame frame;
+    size_t next = 0;
+    const int64_t endMs = packets.back().arrivalMs + 1000;
+    for (int64_t nowMs = packets.front().arrivalMs; nowMs <= endMs; nowMs++) {
+        for (; next < packets.size() && packets[next].arrivalMs <= nowMs; next++) {
+            const Packet& packet = packets[next];
+            buffer.insert(packet.sequence, packet.timestamp, packet.marker,
+                          sequencePayload(packet.sequence), nowMs);
+        }
+        while (buffer.pop(nowMs, frame)) {
+            Released out = {frame.timestamp, {}, frame.discontinuity, nowMs};
+            for (const BufferSlice& payload : frame.payloads) {
+                out.sequences.push_back(payloadSequence(payload));
+            }
+            released.push_back(out);
+        }
+    }
+    return released;
+}
+
+/**
+ * @brief Check that every frame is whole and frames come out in order
+ */
+void expectWholeFramesInOrder(const std::vector<Released>& frames, size_t packetsPerFrame) {
+    for (size_t i = 0; i < frames.size(); i++) {
+        ASSERT_EQ(frames[i].sequences.size(), packetsPerFrame) << "frame " << i;
+        for (size_t j = 1; j < packetsPerFrame; j++) {
+            EXPECT_EQ(static_cast<uint16_t>(frames[i].sequences[j] - frames[i].sequences[j - 1]),
+                      1u);
+        }
+        if (i > 0) {
+            EXPECT_GT(static_cast<int32_t>(frames[i].timestamp - frames[i - 1].timestamp), 0);
+        }
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Test fixture for JitterBuffer tests
+ */
+class JitterBufferTest : public ::testing::Test {
+protected:
+    static JitterBufferConfig config(int minDelayMs = 0, int maxDelayMs = 500) {
+        JitterBufferConfig config;
+        config.minDelayMs = minDelayMs;
+        config.maxDelayMs = maxDelayMs;
+        return config;
+    }
+
+    static void insert(JitterBuffer& buffer, uint16_t sequence, uint32_t timestamp, bool marker,
+                       int64_t arrivalMs = 0) {
+        buffer.insert(sequence, timestamp, marker, sequencePayload(sequence), arrivalMs);
+    }
+};
+
+/**
+ * @brief Test that invalid configurations are rejected
+ */
+TEST_F(JitterBufferTest, RejectsInvalidConfig) {
+    EXPECT_THROW(JitterBuffer buffer(config(-1, 100)), std::invalid_argument);
+    EXPECT_THROW(JitterBuffer buffer(config(200, 100)), std::invalid_argument);
+
+    JitterBufferConfig noClock = config();
+    noClock.clockRate = 0;
+    EXPECT_THROW(JitterBuffer buffer(noClock), std::invalid_argument);
+
+    JitterBufferConfig noCapacity = config();
+    noCapacity.capacity = 0;
+    EXPECT_THROW(JitterBuffer buffer(noCapacity), std::invalid_argument);
+}
+
+/**
+ * @brief Test that a reordered stream comes out whole and in order
+ */
+TEST_F(JitterBufferTest, ReordersIntoCompleteFrames) {
+    Impairment impairment;
+    impairment.jitterMs = 40;
+    const std::vector<Packet> packets = ImpairedStream(1, impairment).video(300, 4);
+
+    JitterBuffer buffer(config());
+    const std::vector<Released> frames = play(buffer, packets);
+
+    // The first frame cannot be told from a partially received one
+    ASSERT_EQ(frames.size(), 299u);
+    expectWholeFramesInOrder(frames, 4);
+    EXPECT_EQ(frames.front().timestamp, 2970u);
+    for (size_t i = 1; i < frames.size(); i++) {
+        EXPECT_FALSE(frames[i].discontinuity);
+    }
+
+    const JitterBufferStats stats = buffer.getStats();
+    EXPECT_EQ(stats.packetsReceived, 1200u);
+    EXPECT_GT(stats.packetsReordered, 0u);
+    EXPECT_EQ(stats.framesReleased, 299u);
+    EXPECT_EQ(stats.framesLost, 0u);
+}
+
+/**
+ * @brief Test that frames leave as soon as they are complete on a clean network
+ */
+TEST_F(JitterBufferTest, CleanNetworkAddsNoDelay) {
+    const std::vector<Packet> packets = ImpairedStream(2, Impairment()).video(60, 3);
+
+    JitterBuffer buffer(config());
+    const std::vector<Released> frames = play(buffer, packets);
+
+    ASSERT_EQ(frames.size(), 59u);
+    for (size_t i = 0; i < frames.size(); i++) {
+        EXPECT_EQ(frames[i].releasedMs, packets[i * 3 + 5].arrivalMs);
+    }
+    EXPECT_EQ(buffer.getStats().targetDelayMs, 0);
+    EXPECT_EQ(buffer.getStats().currentDelayMs, 0);
+    EXPECT_EQ(buffer.getStats().packetsReordered, 0u);
+}
+
+/**
+ * @brief Test that output starts after the first marker bit
+ */
+TEST_F(JitterBufferTest, StartsAtFirstCertainFrameStart) {
+    JitterBuffer buffer(config());
+    insert(buffer, 5, 0, false);  // Possibly the middle of a frame
+    insert(buffer, 6, 0, true);
+
+    JitterFrame frame;
+    EXPECT_FALSE(buffer.pop(100, frame));
+    EXPECT_EQ(buffer.nextReleaseMs(), -1);
+
+    insert(buffer, 7, 3000, true, 33);
+    ASSERT_TRUE(buffer.pop(33, frame));
+    EXPECT_EQ(frame.timestamp, 3000u);
+    EXPECT_TRUE(frame.discontinuity);
+    EXPECT_EQ(buffer.getStats().framesLost, 0u);
+}
+
+/**
+ * @brief Test that a frame-start check lets output begin with the first frame
+ */
+TEST_F(JitterBufferTest, FrameStartCheckStartsAtFirstFrame) {
+    Impairment impairment;
+    impairment.jitterMs = 40;
+    const std::vector<Packet> packets = ImpairedStream(9, impairment).video(100, 4);
+
+    JitterBufferConfig checked = config();
+    checked.isFrameStart = [](const uint8_t* payload, size_t) {
+        return ((payload[0] << 8) | payload[1]) % 4 == 0;
+    };
+    JitterBuffer buffer(checked);
+    const std::vector<Released> frames = play(buffer, packets);
+
+    ASSERT_EQ(frames.size(), 100u);
+    expectWholeFramesInOrder(frames, 4);
+    EXPECT_EQ(frames.front().timestamp, 0u);
+    EXPECT_FALSE(frames.front().discontinuity);
+}
+
+/**
+ * @brief Test that a frame-start check resumes output right after a loss
+ */
+TEST_F(JitterBufferTest, FrameStartCheckResumesAfterLostMarker) {
+    JitterBufferConfig checked = config();
+    checked.isFrameStart = [](const uint8_t* payload, size_t) { return payload[1] % 2 == 1; };
+    JitterBuffer buffer(checked);
+
+    insert(buffer, 1, 0, false);
+    insert(buffer, 2, 0, true);
+    insert(buffer, 3, 3000, false, 33);  // 4, carrying the marker, is lost
+    insert(buffer, 5, 6000, false, 67);
+    insert(buffer, 6, 6000, true, 67);
+
+    JitterFrame frame;
+    ASSERT_TRUE(buffer.pop(0, frame));
+    EXPECT_EQ(frame.timestamp, 0u);
+    ASSERT_TRUE(buffer.pop(67, frame));
+    EXPECT_EQ(frame.timestamp, 6000u);
+    EXPECT_TRUE(frame.discontinuity);
+    EXPECT_EQ(buffer.getStats().framesLost, 1u);
+}
+
+/**
+ * @brief Test the late and duplicate counters
+ */
+TEST_F(JitterBufferTest, CountsLateAndDuplicatePackets) {
+    JitterBuffer buffer(config());
+    insert(buffer, 9, 0, true);
+    insert(buffer, 10, 3000, false);
+    insert(buffer, 11, 3000, true);
+
+    JitterFrame frame;
+    ASSERT_TRUE(buffer.pop(0, frame));
+    EXPECT_EQ(frame.timestamp, 3000u);
+    EXPECT_EQ(frame.payloads.size(), 2u);
+
+    // Retransmission of a released packet
+    EXPECT_FALSE(buffer.insert(11, 3000, true, sequencePayload(11), 5));
+    insert(buffer, 12, 6000, true, 33);
+    EXPECT_FALSE(buffer.insert(12, 6000, true, sequencePayload(12), 34));
+
+    const JitterBufferStats stats = buffer.getStats();
+    EXPECT_EQ(stats.packetsReceived, 6u);
+    EXPECT_EQ(stats.packetsLate, 1u);
+    EXPECT_EQ(stats.packetsDuplicate, 1u);
+}
+
+/**
+ * @brief Test that duplicated packets do not disturb the output
+ */
+TEST_F(JitterBufferTest, IgnoresDuplicatedPackets) {
+    Impairment impairment;
+    impairment.jitterMs = 30;
+    impairment.duplicateRate = 0.1;
+    const std::vector<Packet> packets = ImpairedStream(3, impairment).video(200, 3);
+
+    JitterBuffer buffer(config());
+    const std::vector<Released> frames = play(buffer, packets);
+
+    ASSERT_EQ(frames.size(), 199u);
+    expectWholeFramesInOrder(frames, 3);
+
+    const JitterBufferStats stats = buffer.getStats();
+    EXPECT_EQ(stats.packetsDuplicate + stats.packetsLate, packets.size() - 600);
+    EXPECT_GT(stats.packetsDuplicate, 0u);
+    EXPECT_EQ(stats.framesLost, 0u);
+}
+
+/**
+ * @brief Test that a frame missing a packet is skipped and flagged
+ */
+TEST_F(JitterBufferTest, SkipsIncompleteFrameWithDiscontinuity) {
+    JitterBuffer buffer(config(10, 100));
+    insert(buffer, 0, 0, true);
+    insert(buffer, 1, 3000, false, 33);
+    insert(buffer, 2, 3000, true, 33);
+    insert(buffer, 3, 6000, false, 67);
+    insert(buffer, 5, 6000, true, 67);  // 4 is lost
+    insert(buffer, 6, 9000, true, 100);
+
+    JitterFrame frame;
+    ASSERT_TRUE(buffer.pop(43, frame));
+    EXPECT_EQ(frame.timestamp, 3000u);
+
+    // The third frame is held until its playout time in case 4 shows up
+    EXPECT_EQ(buffer.nextReleaseMs(), 76);
+    EXPECT_FALSE(buffer.pop(75, frame));
+
+    ASSERT_TRUE(buffer.pop(110, frame));
+    EXPECT_EQ(frame.timestamp, 9000u);
+    EXPECT_TRUE(frame.discontinuity);
+    ASSERT_EQ(frame.payloads.size(), 1u);
+    EXPECT_EQ(payloadSequence(frame.payloads[0]), 6u);
+
+    insert(buffer, 4, 6000, false, 115);
+    const JitterBufferStats stats = buffer.getStats();
+    EXPECT_EQ(stats.framesReleased, 2u);
+    EXPECT_EQ(stats.framesLost, 1u);
+    EXPECT_EQ(stats.packetsLate, 1u);
+}
+
+/**
+ * @brief Test that a late packet completes its frame if it beats the playout time
+ */
+TEST_F(JitterBufferTest, WaitsForMissingPacketUntilPlayout) {
+    JitterBuffer buffer(config(30, 100));
+    insert(buffer, 0, 0, true);
+    insert(buffer, 1, 3000, false, 33);
+    insert(buffer, 3, 3000, true, 33);
+    insert(buffer, 4, 6000, true, 67);
+
+    JitterFrame frame;
+    EXPECT_FALSE(buffer.pop(50, frame));
+    insert(buffer, 2, 3000, false, 55);
+
+    ASSERT_TRUE(buffer.pop(buffer.nextReleaseMs(), frame));
+    EXPECT_EQ(frame.timestamp, 3000u);
+    EXPECT_EQ(frame.payloads.size(), 3u);
+    EXPECT_EQ(buffer.getStats().framesLost, 0u);
+}
+
+/**
+ * @brief Test that a lossy, jittery stream only ever releases whole frames
+ */
+TEST_F(JitterBufferTest, LossyStreamReleasesOnlyWholeFrames) {
+    Impairment impairment;
+    impairment.jitterMs = 60;
+    impairment.lossRate = 0.02;
+    const std::vector<Packet> packets = ImpairedStream(4, impairment).video(600, 5);
+
+    JitterBuffer buffer(config());
+    const std::vector<Released> frames = play(buffer, packets);
+    expectWholeFramesInOrder(frames, 5);
+
+    const JitterBufferStats stats = buffer.getStats();
+    EXPECT_GT(stats.framesLost, 0u);
+    EXPECT_LE(stats.framesReleased + stats.framesLost, 600u);
+    EXPECT_GT(stats.framesReleased, 450u);
+
+    size_t flagged = 0;
+    for (size_t i = 1; i < frames.size(); i++) {
+        flagged += frames[i].discontinuity ? 1 : 0;
+    }
+    EXPECT_GT(flagged, 0u);
+    EXPECT_LE(flagged, stats.framesLost);
+}
+
+/**
+ * @brief Test that the target delay follows jitter within its bounds
+ */
+TEST_F(JitterBufferTest, AdaptsTargetDelayToJitter) {
+    Impairment calm;
+    calm.jitterMs = 4;
+    Impairment rough;
+    rough.jitterMs = 80;
+
+    JitterBuffer calmBuffer(config());
+    play(calmBuffer, ImpairedStream(5, calm).video(300, 2));
+    JitterBuffer roughBuffer(config());
+    play(roughBuffer, ImpairedStream(5, rough).video(300, 2));
+
+    const JitterBufferStats calmStats = calmBuffer.getStats();
+    const JitterBufferStats roughStats = roughBuffer.getStats();
+    EXPECT_LE(calmStats.targetDelayMs, 4);
+    EXPECT_GE(roughStats.targetDelayMs, 60);
+    EXPECT_LE(roughStats.targetDelayMs, 80);
+    EXPECT_GT(roughStats.jitterMs, calmStats.jitterMs);
+    EXPECT_EQ(calmStats.framesLost, 0u);
+
+    // The bounds win over the measurement
+    JitterBuffer floored(config(60, 500));
+    play(floored, ImpairedStream(5, calm).video(300, 2));
+    EXPECT_EQ(floored.getStats().targetDelayMs, 60);
+
+    JitterBuffer capped(config(0, 20));
+    play(capped, ImpairedStream(5, rough).video(300, 2));
+    EXPECT_EQ(capped.getStats().targetDelayMs, 20);
+    EXPECT_GT(capped.getStats().framesLost, 0u);
+}
+
+/**
+ * @brief Test that the target delay comes back down once jitter subsides
+ */
+TEST_F(JitterBufferTest, TargetDelayDecaysAfterJitterSubsides) {
+    Impairment rough;
+    rough.jitterMs = 80;
+    std::vector<Packet> packets = ImpairedStream(6, rough).video(100, 1);
+
+    // Then 30 s of a clean network, continuing the same stream
+    for (Packet packet : ImpairedStream(7, Impairment()).video(900, 1, 100, 297000)) {
+        packet.arrivalMs += 100 * 33;
+        packets.push_back(packet);
+    }
+
+    JitterBuffer buffer(config());
+    play(buffer, packets);
+    EXPECT_LE(buffer.getStats().targetDelayMs, 5);
+}
+
+/**
+ * @brief Test that sequence numbers and timestamps unwrap
+ */
+TEST_F(JitterBufferTest, HandlesSequenceAndTimestampWrap) {
+    Impairment impairment;
+    impairment.jitterMs = 20;
+    const std::vector<Packet> packets =
+        ImpairedStream(8, impairment).video(100, 4, 65500, 0xFFFFFFFFu - 29699);
+
+    JitterBuffer buffer(config());
+    const std::vector<Released> frames = play(buffer, packets);
+
+    ASSERT_EQ(frames.size(), 99u);
+    expectWholeFramesInOrder(frames, 4);
+    EXPECT_EQ(frames.back().sequences.back(), static_cast<uint16_t>(65500 + 399));
+    EXPECT_EQ(buffer.getStats().framesLost, 0u);
+}
+
+/**
+ * @brief Test audio framing: one packet per frame, losses skipped without delay
+ */
+TEST_F(JitterBufferTest, SinglePacketFrames) {
+    JitterBufferConfig audio = config();
+    audio.clockRate = 48000;
+    audio.singlePacketFrames = true;
+    JitterBuffer buffer(audio);
+
+    insert(buffer, 0, 0, false, 0);
+    insert(buffer, 2, 1920, false, 40);  // 1 is lost
+    insert(buffer, 3, 2880, false, 60);
+
+    JitterFrame frame;
+    ASSERT_TRUE(buffer.pop(0, frame));
+    EXPECT_EQ(frame.timestamp, 0u);
+    EXPECT_FALSE(frame.discontinuity);
+    ASSERT_TRUE(buffer.pop(40, frame));
+    EXPECT_EQ(frame.timestamp, 1920u);
+    EXPECT_TRUE(frame.discontinuity);
+    ASSERT_TRUE(buffer.pop(60, frame));
+    EXPECT_FALSE(frame.discontinuity);
+    EXPECT_EQ(buffer.getStats().framesLost, 1u);
+}
+
+/**
+ * @brief Test that a jump far ahead drops the backlog instead of overflowing
+ */
+TEST_F(JitterBufferTest, JumpBeyondCapacityResynchronizes) {
+    JitterBufferConfig small = config();
+    small.capacity = 16;
+    JitterBuffer buffer(small);
+
+    insert(buffer, 0, 0, true);
+    insert(buffer, 1, 3000, true);
+    JitterFrame frame;
+    ASSERT_TRUE(buffer.pop(0, frame));
+
+    insert(buffer, 2, 6000, false, 67);
+    insert(buffer, 100, 9000, true, 100);
+    insert(buffer, 101, 12000, true, 133);
+
+    // Nothing says 100 begins a frame; 101 follows its marker
+    ASSERT_TRUE(buffer.pop(133, frame));
+    EXPECT_EQ(frame.timestamp, 12000u);
+    EXPECT_TRUE(frame.discontinuity);
+    EXPECT_EQ(buffer.getStats().framesLost, 1u);
+}
+
+/**
+ * @brief Test that a jump far ahead with nothing buffered still counts as a
+ *        loss and waits for a certain frame start
+ */
+TEST_F(JitterBufferTest, JumpBeyondCapacityWhileEmptyWaitsForFrameStart) {
+    JitterBufferConfig checked = config();
+    checked.isFrameStart = [](const uint8_t* payload, size_t) { return payload[1] % 4 == 0; };
+    JitterBuffer buffer(checked);
+
+    insert(buffer, 100, 0, true);
+    JitterFrame frame;
+    ASSERT_TRUE(buffer.pop(0, frame));
+
+    // The middle and end of a frame whose start was lost in a long burst
+    insert(buffer, 2101, 3000, false, 33);
+    insert(buffer, 2102, 3000, true, 33);
+    EXPECT_FALSE(buffer.pop(33, frame));
+
+    insert(buffer, 2104, 6000, true, 67);
+    ASSERT_TRUE(buffer.pop(67, frame));
+    EXPECT_EQ(frame.timestamp, 6000u);
+    ASSERT_EQ(frame.payloads.size(), 1u);
+    EXPECT_EQ(payloadSequence(frame.payloads[0]), 2104);
+    EXPECT_TRUE(frame.discontinuity);
+    EXPECT_EQ(buffer.getStats().framesLost, 1u);
+}
+
+/**
+ * @brief Test that reset() starts a new stream but keeps the counters
+ */
+TEST_F(JitterBufferTest, ResetStartsOver) {
+    JitterBuffer buffer(config());
+    insert(buffer, 500, 0, true);
+    insert(buffer, 501, 3000, false);
+    buffer.reset();
+    EXPECT_EQ(buffer.nextReleaseMs(), -1);
+
+    insert(buffer, 7, 90000, true, 10);
+    insert(buffer, 8, 93000, true, 43);
+    JitterFrame frame;
+    ASSERT_TRUE(buffer.pop(43, frame));
+    EXPECT_EQ(frame.timestamp, 93000u);
+    EXPECT_EQ(buffer.getStats().packetsReceived, 4u);
+    EXPECT_EQ(buffer.getStats().framesLost, 0u);
+}
+
+/**
+ * @brief Test reassembly of single NAL unit, STAP-A and FU-A payloads
+ */
+TEST_F(JitterBufferTest, AssemblesH264AccessUnit) {
+    const std::vector<uint8_t> stapA = {0x78, 0x00, 0x03, 0x67, 0x42, 0x1F,
+                                        0x00, 0x02, 0x68, 0xCE};
+    const std::vector<uint8_t> fuStart = {0x7C, 0x85, 0x11, 0x22};
+    const std::vector<uint8_t> fuMiddle = {0x7C, 0x05, 0x33};
+    const std::vector<uint8_t> fuEnd = {0x7C, 0x45, 0x44};
+    const std::vector<uint8_t> single = {0x06, 0x05, 0x01};
+
+    JitterFrame frame;
+    for (const auto& payload : {stapA, fuStart, fuMiddle, fuEnd, single}) {
+        frame.payloads.push_back(BufferSlice::copyOf(payload.data(), payload.size()));
+    }
+
+    BufferPool pool;
+    const BufferSlice accessUnit = assembleH264AccessUnit(frame, pool);
+    EXPECT_THAT(accessUnit.toVector(),
+                ElementsAre(0, 0, 0, 1, 0x67, 0x42, 0x1F,       // SPS
+                            0, 0, 0, 1, 0x68, 0xCE,             // PPS
+                            0, 0, 0, 1, 0x65, 0x11, 0x22, 0x33, 0x44,  // IDR, from FU-A
+                            0, 0, 0, 1, 0x06, 0x05, 0x01));     // SEI
+}
+
+/**
+ * @brief Test recognition of H.264 payloads that begin an access unit
+ */
+TEST_F(JitterBufferTest, RecognizesH264FrameStarts) {
+    const std::vector<uint8_t> stapA = {0x78, 0x00, 0x02, 0x67, 0x42};
+    const std::vector<uint8_t> sps = {0x67, 0x42};
+    const std::vector<uint8_t> firstSlice = {0x41, 0x9A};
+    const std::vector<uint8_t> laterSlice = {0x41, 0x24};   // first_mb_in_slice != 0
+    const std::vector<uint8_t> fuStart = {0x7C, 0x85, 0x88};
+    const std::vector<uint8_t> fuLaterSlice = {0x7C, 0x85, 0x24};
+    const std::vector<uint8_t> fuMiddle = {0x7C, 0x05, 0x88};
+
+    EXPECT_TRUE(isH264FrameStart(stapA.data(), stapA.size()));
+    EXPECT_TRUE(isH264FrameStart(sps.data(), sps.size()));
+    EXPECT_TRUE(isH264FrameStart(firstSlice.data(), firstSlice.size()));
+    EXPECT_FALSE(isH264FrameStart(laterSlice.data(), laterSlice.size()));
+    EXPECT_TRUE(isH264FrameStart(fuStart.data(), fuStart.size()));
+    EXPECT_FALSE(isH264FrameStart(fuLaterSlice.data(), fuLaterSlice.size()));
+    EXPECT_FALSE(isH264FrameStart(fuMiddle.data(), fuMiddle.size()));
+    EXPECT_FALSE(isH264FrameStart(nullptr, 0));
+}
+
+/**
+ * @brief Test that malformed payloads are skipped
+ */
+TEST_F(JitterBufferTest, AssemblySkipsMalformedPayloads) {
+    const std::vector<uint8_t> truncatedStap = {0x78, 0x00, 0x09, 0x67};
+    const std::vector<uint8_t> orphanFragment = {0x7C, 0x05, 0x33};
+    const std::vector<uint8_t> reserved = {0x1E, 0x01};
+
+    JitterFrame frame;
+    for (const auto& payload : {truncatedStap, orphanFragment, reserved}) {
+        frame.payloads.push_back(BufferSlice::copyOf(payload.data(), payload.size()));
+    }
+    frame.payloads.push_back(BufferSlice());
+
+    BufferPool pool;
+    EXPECT_TRUE(assembleH264AccessUnit(frame, pool).empty());
+}
+
+/**
+ * @brief Test that VP8 payload descriptors are stripped, short and extended
+ */
+TEST_F(JitterBufferTest, AssemblesVp8Frame) {
+    // S=1, PID=0 with a 15-bit picture ID, TL0PICIDX and TID/KEYIDX
+    const std::vector<uint8_t> first = {0x90, 0xE0, 0x81, 0x23, 0x05, 0x40, 0x10, 0x02, 0x9D};
+    // Continuation with the minimal descriptor
+    const std::vector<uint8_t> second = {0x00, 0x01, 0x2A};
+    // Descriptor only: nothing to recover
+    const std::vector<uint8_t> empty = {0x80, 0x80};
+
+    JitterFrame frame;
+    for (const auto& payload : {first, second, empty}) {
+        frame.payloads.push_back(BufferSlice::copyOf(payload.data(), payload.size()));
+    }
+
+    BufferPool pool;
+    EXPECT_THAT(assembleVp8Frame(frame, pool).toVector(),
+                ElementsAre(0x10, 0x02, 0x9D, 0x01, 0x2A));
+
+    EXPECT_TRUE(isVp8FrameStart(first.data(), first.size()));
+    EXPECT_FALSE(isVp8FrameStart(second.data(), second.size()));
+    const std::vector<uint8_t> laterPartition = {0x11, 0x00};
+    EXPECT_FALSE(isVp8FrameStart(laterPartition.data(), laterPartition.size()));
+    EXPECT_FALSE(isVp8FrameStart(nullptr, 0));
+}
+
+/**
+ * @brief Test that VP9 payload descriptors are stripped, including the
+ *        scalability structure of a keyframe
+ */
+TEST_F(JitterBufferTest, AssemblesVp9Frame) {
+    // I, B, V: 7-bit picture ID, then one spatial layer with its resolution
+    // and a picture group of one picture with one reference
+    const std::vector<uint8_t> keyframeStart = {0x8A, 0x11, 0x18, 0x05, 0x00, 0x02, 0xD0,
+                                                0x01, 0x04, 0x01, 0x82, 0x49};
+    // I, P, F, E: 15-bit picture ID and two P_DIFF bytes
+    const std::vector<uint8_t> interFrame = {0xD4, 0x80, 0x12, 0x03, 0x02, 0x86};
+    // P_DIFF runs past the payload
+    const std::vector<uint8_t> truncated = {0x50, 0x03};
+
+    JitterFrame frame;
+    for (const auto& payload : {keyframeStart, interFrame, truncated}) {
+        frame.payloads.push_back(BufferSlice::copyOf(payload.data(), payload.size()));
+    }
+
+    BufferPool pool;
+    EXPECT_THAT(assembleVp9Frame(frame, pool).toVector(), ElementsAre(0x82, 0x49, 0x86));
+
+    EXPECT_TRUE(isVp9FrameStart(keyframeStart.data(), keyframeStart.size()));
+    EXPECT_FALSE(isVp9FrameStart(interFrame.data(), interFrame.size()));
+    EXPECT_FALSE(isVp9FrameStart(nullptr, 0));
+}
@@ -0,0 +1,79 @@
+/**
+ * @file keyframe_request_throttle_test.cpp
+ * @brief Unit tests for KeyframeRequestThrottle
+ */
+
+#include <gtest/gtest.h>
+#include "core/keyframe-request-throttle.hpp"
+#include <stdexcept>
+
+using namespace obswebrtc::core;
+
+namespace {
+
+KeyframeRequestThrottleConfig intervalMs(int ms) {
+    KeyframeRequestThrottleConfig config;
+    config.minIntervalMs = ms;
+    return config;
+}
+
+}  // namespace
+
+TEST(KeyframeRequestThrottleTest, NegativeIntervalThrows) {
+    EXPECT_THROW(KeyframeRequestThrottle(intervalMs(-1)), std::invalid_argument);
+}
+
+TEST(KeyframeRequestThrottleTest, FirstRequestIsForwarded) {
+    KeyframeRequestThrottle throttle(intervalMs(500));
+    EXPECT_TRUE(throttle.onRequest(1000));
+    EXPECT_FALSE(throttle.hasPendingRequest());
+}
+
+TEST(KeyframeRequestThrottleTest, BurstIsCoalescedIntoOneDeferredRequest) {
+    KeyframeRequestThrottle throttle(intervalMs(500));
+    ASSERT_TRUE(throttle.onRequest(1000));
+
+    // Ten receivers ask again while the first keyframe is on its way
+    for (int i = 1; i <= 10; ++i) {
+        EXPECT_FALSE(throttle.onRequest(1000 + i * 10));
+    }
+    EXPECT_TRUE(throttle.hasPendingRequest());
+
+    EXPECT_FALSE(throttle.poll(1499));
+    EXPECT_TRUE(throttle.poll(1500));
+    EXPECT_FALSE(throttle.poll(1501));
+    EXPECT_FALSE(throttle.hasPendingRequest());
+}
+
+TEST(KeyframeRequestThrottleTest, SentKeyframeSatisfiesPendingRequest) {
+    KeyframeRequestThrottle throttle(intervalMs(500));
+    ASSERT_TRUE(throttle.onRequest(1000));
+    ASSERT_FALSE(throttle.onRequest(1100));
+
+    throttle.onKeyframeSent(1200);
+    EXPECT_FALSE(throttle.hasPendingRequest());
+    EXPECT_FALSE(throttle.poll(2000));
+}
+
+TEST(KeyframeRequestThrottleTest, ScheduledKeyframeStartsQuietPeriod) {
+    KeyframeRequestThrottle throttle(intervalMs(500));
+    throttle.onKeyframeSent(1000);
+
+    EXPECT_FALSE(throttle.onRequest(1200));
+    EXPECT_TRUE(throttle.poll(1500));
+    EXPECT_TRUE(throttle.onRequest(2000));
+}
+
+TEST(KeyframeRequestThrottleTest, PollWithoutRequestDoesNothing) {
+    KeyframeRequestThrottle throttle(intervalMs(500));
+    EXPECT_FALSE(throttle.poll(0));
+    EXPECT_FALSE(throttle.poll(10000));
+}
+
+TEST(KeyframeRequestThrottleTest, ZeroIntervalForwardsEveryRequest) {
+    KeyframeRequestThrottle throttle(intervalMs(0));
+    EXPECT_TRUE(throttle.onRequest(1000));
+    EXPECT_TRUE(throttle.onRequest(1000));
+    throttle.onKeyframeSent(1000);
+    EXPECT_TRUE(throttle.onRequest(1000));
+}
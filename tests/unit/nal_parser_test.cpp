@@ -0,0 +1,200 @@
+/**
+ * @file nal_parser_test.cpp
+ * @brief Unit tests for Annex-B start code scanning and NAL unit splitting
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/nal-parser.hpp"
+#include <random>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for NAL parser tests
+ */
+class NalParserTest : public ::testing::Test {
+protected:
+    /**
+     * @brief Byte-by-byte reference scanner
+     */
+    static size_t naiveFind(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i + 2 < size; i++) {
+            if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    /**
+     * @brief All kernels that can run on this CPU
+     */
+    static std::vector<SimdLevel> supportedLevels() {
+        std::vector<SimdLevel> levels;
+        for (SimdLevel level :
+             {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+            if (isSimdLevelSupported(level)) {
+                levels.push_back(level);
+            }
+        }
+        return levels;
+    }
+
+    static void append(std::vector<uint8_t>& out, std::initializer_list<uint8_t> bytes) {
+        out.insert(out.end(), bytes);
+    }
+};
+
+/**
+ * @brief Test that the detected level is supported and has a name
+ */
+TEST_F(NalParserTest, DetectedSimdLevelIsSupported) {
+    EXPECT_TRUE(isSimdLevelSupported(detectSimdLevel()));
+    EXPECT_TRUE(isSimdLevelSupported(SimdLevel::Scalar));
+    EXPECT_STRNE(simdLevelName(detectSimdLevel()), "unknown");
+}
+
+/**
+ * @brief Test that requesting an unsupported kernel throws
+ */
+TEST_F(NalParserTest, UnsupportedLevelThrows) {
+    const uint8_t data[] = {0, 0, 1};
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+        if (!isSimdLevelSupported(level)) {
+            EXPECT_THROW(findAnnexBStartCode(data, sizeof(data), level), std::invalid_argument);
+        }
+    }
+}
+
+/**
+ * @brief Test start codes at every offset around vector block boundaries
+ */
+TEST_F(NalParserTest, FindsStartCodeAtEveryOffset) {
+    for (SimdLevel level : supportedLevels()) {
+        for (size_t offset = 0; offset < 80; offset++) {
+            std::vector<uint8_t> data(100, 0xAB);
+            data[offset] = 0;
+            data[offset + 1] = 0;
+            data[offset + 2] = 1;
+
+            EXPECT_EQ(findAnnexBStartCode(data.data(), data.size(), level), offset)
+                << simdLevelName(level) << " offset " << offset;
+        }
+    }
+}
+
+/**
+ * @brief Test buffers without a start code and too-short buffers
+ */
+TEST_F(NalParserTest, ReturnsSizeWhenNoStartCode) {
+    for (SimdLevel level : supportedLevels()) {
+        std::vector<uint8_t> data(257, 0);
+        EXPECT_EQ(findAnnexBStartCode(data.data(), data.size(), level), data.size());
+
+        // 00 00 02 and 00 01 are not start codes
+        const uint8_t nearMisses[] = {0, 0, 2, 0, 1, 0xFF, 0, 0};
+        EXPECT_EQ(findAnnexBStartCode(nearMisses, sizeof(nearMisses), level), sizeof(nearMisses));
+
+        const uint8_t tooShort[] = {0, 0};
+        EXPECT_EQ(findAnnexBStartCode(tooShort, sizeof(tooShort), level), 2u);
+        EXPECT_EQ(findAnnexBStartCode(tooShort, 0, level), 0u);
+    }
+}
+
+/**
+ * @brief Differential test of every kernel against the naive scanner
+ */
+TEST_F(NalParserTest, MatchesNaiveScannerOnRandomData) {
+    std::mt19937 gen(1234);
+    // Mostly 0 and 1 so start codes and near misses are frequent
+    std::discrete_distribution<int> dis({40, 20, 1, 1});
+
+    for (int round = 0; round < 200; round++) {
+        std::vector<uint8_t> data(1 + gen() % 300);
+        for (auto& byte : data) {
+            const int pick = dis(gen);
+            byte = static_cast<uint8_t>(pick == 3 ? 0x80 + gen() % 0x80 : pick);
+        }
+
+        for (SimdLevel level : supportedLevels()) {
+            size_t pos = 0;
+            while (pos < data.size()) {
+                const size_t expected = naiveFind(data.data() + pos, data.size() - pos);
+                ASSERT_EQ(findAnnexBStartCode(data.data() + pos, data.size() - pos, level), expected)
+                    << simdLevelName(level) << " round " << round << " pos " << pos;
+                pos += expected + 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Test splitting an access unit with 3 and 4 byte start codes
+ */
+TEST_F(NalParserTest, SplitsAccessUnit) {
+    std::vector<uint8_t> au;
+    append(au, {0, 0, 0, 1, 0x67, 0x42, 0x00, 0x1F});  // SPS, 4-byte start code
+    append(au, {0, 0, 0, 1, 0x68, 0xCE, 0x3C, 0x80});  // PPS
+    append(au, {0, 0, 1, 0x65, 0x88, 0x84, 0x00, 0x21});  // IDR slice, 3-byte start code
+
+    auto nalUnits = splitAnnexB(au.data(), au.size());
+    ASSERT_EQ(nalUnits.size(), 3u);
+
+    EXPECT_EQ(nalUnits[0].h264Type(), 7);
+    EXPECT_EQ(nalUnits[0].data, au.data() + 4);
+    EXPECT_EQ(nalUnits[0].size, 4u);
+
+    EXPECT_EQ(nalUnits[1].h264Type(), 8);
+    EXPECT_EQ(nalUnits[1].size, 4u);
+
+    EXPECT_EQ(nalUnits[2].h264Type(), 5);
+    EXPECT_EQ(nalUnits[2].data, au.data() + 19);
+    EXPECT_EQ(nalUnits[2].size, 5u);
+}
+
+/**
+ * @brief Test that leading bytes, empty NAL units and trailing zeros are dropped
+ */
+TEST_F(NalParserTest, SplitSkipsPaddingAndEmptyUnits) {
+    std::vector<uint8_t> au;
+    append(au, {0xFF, 0xEE});                     // Garbage before the first start code
+    append(au, {0, 0, 1, 0, 0, 1});               // Empty NAL unit
+    append(au, {0x41, 0x9A, 0, 0, 0, 0});         // Slice followed by trailing zeros
+    append(au, {0, 0, 1, 0x09, 0xF0, 0, 0});      // AUD with trailing zeros at the end
+
+    std::vector<NalUnitView> nalUnits;
+    splitAnnexB(au.data(), au.size(), nalUnits);
+    ASSERT_EQ(nalUnits.size(), 2u);
+    EXPECT_EQ(nalUnits[0].h264Type(), 1);
+    EXPECT_EQ(nalUnits[0].size, 2u);
+    EXPECT_EQ(nalUnits[1].h264Type(), 9);
+    EXPECT_EQ(nalUnits[1].size, 2u);
+}
+
+/**
+ * @brief Test buffers that are not Annex-B
+ */
+TEST_F(NalParserTest, SplitReturnsNothingWithoutStartCode) {
+    const uint8_t data[] = {0x00, 0x00, 0x00, 0x05, 0x65, 0x88};  // Length-prefixed
+    EXPECT_TRUE(splitAnnexB(data, sizeof(data)).empty());
+    EXPECT_TRUE(splitAnnexB(nullptr, 0).empty());
+}
+
+/**
+ * @brief Test that the output vector is reused across calls
+ */
+TEST_F(NalParserTest, SplitClearsOutputVector) {
+    const uint8_t first[] = {0, 0, 1, 0x67, 0, 0, 1, 0x68, 0, 0, 1, 0x65};
+    const uint8_t second[] = {0, 0, 1, 0x41, 0x9A};
+
+    std::vector<NalUnitView> nalUnits;
+    splitAnnexB(first, sizeof(first), nalUnits);
+    EXPECT_EQ(nalUnits.size(), 3u);
+
+    splitAnnexB(second, sizeof(second), nalUnits);
+    ASSERT_EQ(nalUnits.size(), 1u);
+    EXPECT_EQ(nalUnits[0].h264Type(), 1);
+}
@@ -242,6 +242,125 @@ TEST_F(NetworkStatisticsTest, RecordDroppedFrames) {
     EXPECT_EQ(stats.framesDropped, 1);
 }
 
+/**
+ * @brief Test recording keyframe requests
+ */
+TEST_F(NetworkStatisticsTest, RecordKeyframeRequests) {
+    NetworkStatisticsCollector collector;
+
+    collector.recordKeyframeRequestReceived();
+    collector.recordKeyframeRequestReceived();
+    collector.recordKeyframeRequestForwarded();
+    collector.recordKeyframeRequestUnserved();
+
+    NetworkStats stats = collector.getCurrentStats();
+    EXPECT_EQ(stats.keyframeRequestsReceived, 2);
+    EXPECT_EQ(stats.keyframeRequestsForwarded, 1);
+    EXPECT_EQ(stats.keyframeRequestsUnserved, 1);
+}
+
+/**
+ * @brief Test recording retransmission hits and misses
+ */
+TEST_F(NetworkStatisticsTest, RecordRetransmissions) {
+    NetworkStatisticsCollector collector;
+
+    collector.recordRetransmission(1200);
+    collector.recordRetransmission(300);
+    collector.recordRetransmissionMiss();
+
+    NetworkStats stats = collector.getCurrentStats();
+    EXPECT_EQ(stats.retransmissionHits, 2);
+    EXPECT_EQ(stats.retransmissionMisses, 1);
+    EXPECT_EQ(stats.bytesRetransmitted, 1500);
+}
+
+/**
+ * @brief Test recording FEC packets and the loss they follow
+ */
+TEST_F(NetworkStatisticsTest, RecordFec) {
+    NetworkStatisticsCollector collector;
+
+    collector.recordFecPacketSent(1000);
+    collector.recordFecPacketSent(200);
+    collector.updateFecProtectionRatio(0.2);
+    collector.updateSendPacketLoss(7.5);
+
+    NetworkStats stats = collector.getCurrentStats();
+    EXPECT_EQ(stats.fecPacketsSent, 2);
+    EXPECT_EQ(stats.fecBytesSent, 1200);
+    EXPECT_DOUBLE_EQ(stats.fecProtectionRatio, 0.2);
+    EXPECT_DOUBLE_EQ(stats.sendPacketLossRate, 7.5);
+    EXPECT_THAT(NetworkStatisticsFormatter::formatStats(stats), HasSubstr("FEC Packets: 2"));
+}
+
+/**
+ * @brief Test recording payload copies
+ */
+TEST_F(NetworkStatisticsTest, RecordPayloadCopies) {
+    NetworkStatisticsCollector collector;
+
+    collector.recordPayloadCopy(4000000);
+    collector.recordPayloadCopy(1000);
+
+    NetworkStats stats = collector.getCurrentStats();
+    EXPECT_EQ(stats.payloadCopies, 2);
+    EXPECT_EQ(stats.payloadBytesCopied, 4001000);
+}
+
+/**
+ * @brief Test payload copy rate calculation
+ */
+TEST_F(NetworkStatisticsTest, PayloadCopyRateCalculation) {
+    NetworkStatisticsCollector collector;
+
+    // 10 copies of 100 KB in ~100ms: ~100 copies/s, ~10 MB/s
+    for (int i = 0; i < 10; i++) {
+        collector.recordPayloadCopy(100000);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    collector.calculateBitrates();
+    NetworkStats stats = collector.getCurrentStats();
+
+    // Allow wide range due to timing variance on CI
+    EXPECT_GT(stats.payloadCopiesPerSecond, 25.0);
+    EXPECT_LT(stats.payloadCopiesPerSecond, 110.0);
+    EXPECT_GT(stats.payloadBytesCopiedPerSecond, 2500000.0);
+    EXPECT_LT(stats.payloadBytesCopiedPerSecond, 11000000.0);
+}
+
+/**
+ * @brief Test pacer queue delay and burst metrics
+ */
+TEST_F(NetworkStatisticsTest, PacerMetricsPerInterval) {
+    NetworkStatisticsCollector collector;
+
+    collector.recordPacerQueueDelay(2.0);
+    collector.recordPacerQueueDelay(4.0);
+    collector.recordPacerQueueDelay(12.0);
+    collector.recordPacerBurst(3000);
+    collector.recordPacerBurst(1200);
+
+    // Published only when the interval is closed
+    EXPECT_DOUBLE_EQ(collector.getCurrentStats().pacerQueueDelayMs, 0.0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    collector.calculateBitrates();
+    NetworkStats stats = collector.getCurrentStats();
+    EXPECT_DOUBLE_EQ(stats.pacerQueueDelayMs, 6.0);
+    EXPECT_DOUBLE_EQ(stats.pacerMaxQueueDelayMs, 12.0);
+    EXPECT_EQ(stats.pacerMaxBurstBytes, 3000u);
+
+    // An idle interval reports zero
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    collector.calculateBitrates();
+    stats = collector.getCurrentStats();
+    EXPECT_DOUBLE_EQ(stats.pacerQueueDelayMs, 0.0);
+    EXPECT_EQ(stats.pacerMaxBurstBytes, 0u);
+}
+
 /**
  * @brief Test resetting statistics
  */
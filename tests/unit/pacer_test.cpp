@@ -0,0 +1,280 @@
+/**
+ * @file pacer_test.cpp
+ * @brief Unit tests for Pacer
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/pacer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for Pacer tests
+ */
+class PacerTest : public ::testing::Test {
+protected:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Wait until a predicate holds or the timeout expires
+     */
+    template <typename Predicate>
+    bool waitFor(Predicate predicate, std::chrono::milliseconds timeout) {
+        auto deadline = Clock::now() + timeout;
+        while (!predicate()) {
+            if (Clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Test that invalid rates are rejected
+ */
+TEST_F(PacerTest, InvalidConfigThrows) {
+    PacerConfig config;
+    config.targetBitrateKbps = 0;
+    EXPECT_THROW({
+        Pacer pacer(config);
+    }, std::invalid_argument);
+
+    config.targetBitrateKbps = 2500;
+    config.pacingMultiplier = 0.0;
+    EXPECT_THROW({
+        Pacer pacer(config);
+    }, std::invalid_argument);
+
+    config.pacingMultiplier = 1.0;
+    config.maxBurstMs = 5;
+    config.batchIntervalMs = 6;
+    EXPECT_THROW({
+        Pacer pacer(config);
+    }, std::invalid_argument);
+
+    config.batchIntervalMs = -1;
+    EXPECT_THROW({
+        Pacer pacer(config);
+    }, std::invalid_argument);
+}
+
+/**
+ * @brief Test pacing rate getters and setters
+ */
+TEST_F(PacerTest, PacingRateFollowsTargetAndMultiplier) {
+    PacerConfig config;
+    config.targetBitrateKbps = 2000;
+    config.pacingMultiplier = 2.0;
+    Pacer pacer(config);
+
+    EXPECT_EQ(pacer.getTargetBitrate(), 2000);
+    EXPECT_DOUBLE_EQ(pacer.getPacingRateKbps(), 4000.0);
+
+    pacer.setTargetBitrate(1000);
+    pacer.setPacingMultiplier(1.5);
+    EXPECT_DOUBLE_EQ(pacer.getPacingRateKbps(), 1500.0);
+
+    EXPECT_THROW(pacer.setTargetBitrate(-1), std::invalid_argument);
+    EXPECT_THROW(pacer.setPacingMultiplier(0.0), std::invalid_argument);
+}
+
+/**
+ * @brief Test that a large video frame is spread over time
+ */
+TEST_F(PacerTest, SpreadsVideoAtPacingRate) {
+    // 8000 kbps = 1000 bytes/ms: 100 packets of 1000 bytes take ~100 ms
+    PacerConfig config;
+    config.targetBitrateKbps = 8000;
+    config.pacingMultiplier = 1.0;
+    config.maxBurstMs = 5;
+    Pacer pacer(config);
+
+    std::atomic<int> sent{0};
+    auto start = Clock::now();
+    for (int i = 0; i < 100; i++) {
+        pacer.enqueue(PacerLane::Video, 1000, [&sent]() { sent++; });
+    }
+
+    ASSERT_TRUE(waitFor([&sent]() { return sent == 100; }, std::chrono::milliseconds(2000)));
+    auto elapsedMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+    // The first 5 ms worth leaves immediately, the rest at the pacing rate
+    EXPECT_GE(elapsedMs, 80);
+    EXPECT_LT(elapsedMs, 1000);
+}
+
+/**
+ * @brief Test that audio is not stuck behind queued video
+ */
+TEST_F(PacerTest, AudioLaneBypassesVideoBacklog) {
+    // 800 kbps = 100 bytes/ms: 50 KB of video takes ~500 ms
+    PacerConfig config;
+    config.targetBitrateKbps = 800;
+    config.pacingMultiplier = 1.0;
+    Pacer pacer(config);
+
+    std::mutex orderMutex;
+    std::vector<char> order;
+    auto record = [&orderMutex, &order](char c) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back(c);
+    };
+
+    for (int i = 0; i < 50; i++) {
+        pacer.enqueue(PacerLane::Video, 1000, [&record]() { record('v'); });
+    }
+
+    std::atomic<bool> audioSent{false};
+    auto audioQueued = Clock::now();
+    pacer.enqueue(PacerLane::Audio, 160, [&record, &audioSent]() {
+        record('a');
+        audioSent = true;
+    });
+
+    ASSERT_TRUE(waitFor([&audioSent]() { return audioSent.load(); }, std::chrono::milliseconds(200)));
+    auto audioDelayMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - audioQueued).count();
+    EXPECT_LT(audioDelayMs, 50);
+
+    pacer.clear();
+
+    std::lock_guard<std::mutex> lock(orderMutex);
+    ASSERT_FALSE(order.empty());
+    EXPECT_LT(std::count(order.begin(), order.end(), 'v'), 50);
+    EXPECT_EQ(std::count(order.begin(), order.end(), 'a'), 1);
+}
+
+/**
+ * @brief Test that clear() discards queued packets
+ */
+TEST_F(PacerTest, ClearDiscardsQueuedPackets) {
+    PacerConfig config;
+    config.targetBitrateKbps = 100;
+    config.pacingMultiplier = 1.0;
+    Pacer pacer(config);
+
+    std::atomic<int> sent{0};
+    for (int i = 0; i < 20; i++) {
+        pacer.enqueue(PacerLane::Video, 1200, [&sent]() { sent++; });
+    }
+
+    pacer.clear();
+    int sentAtClear = sent;
+    EXPECT_EQ(pacer.getQueuedPackets(), 0u);
+    EXPECT_EQ(pacer.getQueuedBytes(), 0u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(sent, sentAtClear);
+    EXPECT_LT(sentAtClear, 20);
+}
+
+/**
+ * @brief Test that a packet over the queue delay cap drains without pacing
+ */
+TEST_F(PacerTest, DrainsWhenQueueDelayExceeded) {
+    // 80 kbps = 10 bytes/ms: 10 x 1000 bytes would take ~1 s when paced
+    PacerConfig config;
+    config.targetBitrateKbps = 80;
+    config.pacingMultiplier = 1.0;
+    config.maxQueueDelayMs = 50;
+    Pacer pacer(config);
+
+    std::atomic<int> sent{0};
+    for (int i = 0; i < 10; i++) {
+        pacer.enqueue(PacerLane::Video, 1000, [&sent]() { sent++; });
+    }
+
+    EXPECT_TRUE(waitFor([&sent]() { return sent == 10; }, std::chrono::milliseconds(500)));
+}
+
+/**
+ * @brief Test that queue delay and burst size reach the statistics collector
+ */
+TEST_F(PacerTest, ReportsQueueDelayAndBurst) {
+    NetworkStatisticsCollector statistics;
+
+    PacerConfig config;
+    config.targetBitrateKbps = 8000;
+    config.pacingMultiplier = 1.0;
+    config.maxBurstMs = 5;
+    config.statistics = &statistics;
+    Pacer pacer(config);
+
+    std::atomic<int> sent{0};
+    for (int i = 0; i < 50; i++) {
+        pacer.enqueue(PacerLane::Video, 1000, [&sent]() { sent++; });
+    }
+    ASSERT_TRUE(waitFor([&sent]() { return sent == 50; }, std::chrono::milliseconds(2000)));
+
+    // Let the pacer go idle so the final burst is reported
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    statistics.calculateBitrates();
+    NetworkStats stats = statistics.getCurrentStats();
+
+    // The last packet waited ~45 ms; no burst exceeds the bucket plus one packet
+    EXPECT_GT(stats.pacerMaxQueueDelayMs, 20.0);
+    EXPECT_GT(stats.pacerQueueDelayMs, 0.0);
+    EXPECT_LT(stats.pacerQueueDelayMs, stats.pacerMaxQueueDelayMs);
+    EXPECT_GE(stats.pacerMaxBurstBytes, 1000u);
+    EXPECT_LE(stats.pacerMaxBurstBytes, 6000u);
+}
+
+/**
+ * @brief Test that batching wakes once per tick without slowing the stream
+ */
+TEST_F(PacerTest, BatchesPacketsPerTick) {
+    // 8000 kbps = 1000 bytes/ms: a 5 ms tick releases ~5 packets at a time
+    PacerConfig config;
+    config.targetBitrateKbps = 8000;
+    config.pacingMultiplier = 1.0;
+    config.maxBurstMs = 5;
+
+    for (int batchIntervalMs : {0, 5}) {
+        config.batchIntervalMs = batchIntervalMs;
+        Pacer pacer(config);
+
+        std::mutex mutex;
+        std::vector<Clock::time_point> sendTimes;
+        auto start = Clock::now();
+        for (int i = 0; i < 100; i++) {
+            pacer.enqueue(PacerLane::Video, 1000, [&mutex, &sendTimes]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                sendTimes.push_back(Clock::now());
+            });
+        }
+
+        ASSERT_TRUE(waitFor([&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return sendTimes.size() == 100;
+        }, std::chrono::milliseconds(2000)));
+        auto elapsedMs =
+            std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+
+        // A release round starts after a gap: the pacer slept in between
+        int rounds = 1;
+        for (size_t i = 1; i < sendTimes.size(); i++) {
+            if (sendTimes[i] - sendTimes[i - 1] > std::chrono::microseconds(500)) {
+                rounds++;
+            }
+        }
+
+        EXPECT_GE(elapsedMs, 80) << "tick " << batchIntervalMs;
+        EXPECT_LT(elapsedMs, 1000) << "tick " << batchIntervalMs;
+        if (batchIntervalMs == 0) {
+            EXPECT_GT(rounds, 60);  // Roughly one wakeup per packet after the bucket
+        } else {
+            EXPECT_LT(rounds, 30);  // Roughly one wakeup per 5 packets
+        }
+    }
+}
@@ -821,3 +821,387 @@ TEST_F(PeerConnectionTest, MultipleTracksCanBeReceivedSimultaneously) {
     pc->close();
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
 }
+
+// ========== Media Track Send Tests ==========
+
+namespace {
+
+// Wait until predicate holds or the timeout expires
+template <typename Predicate>
+bool waitFor(Predicate predicate, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return predicate();
+}
+
+// Build an Annex-B access unit (SPS, PPS, slice) with 4-byte start codes.
+// Payload bytes are never zero so no start code emulation can occur.
+std::vector<uint8_t> makeAccessUnit(size_t sliceSize, uint8_t seed, bool idr) {
+    std::vector<uint8_t> au;
+    auto appendNal = [&au](uint8_t header, size_t size, uint8_t fill) {
+        au.insert(au.end(), {0x00, 0x00, 0x00, 0x01, header});
+        for (size_t i = 0; i < size; ++i) {
+            au.push_back(static_cast<uint8_t>(1 + (fill + i * 31) % 255));
+        }
+    };
+
+    if (idr) {
+        appendNal(0x67, 12, seed);  // SPS
+        appendNal(0x68, 4, seed);   // PPS
+        appendNal(0x65, sliceSize, seed);
+    } else {
+        appendNal(0x41, sliceSize, seed);
+    }
+    return au;
+}
+
+}  // namespace
+
+// Test: Adding a track with a codec that does not match the media type throws
+TEST_F(PeerConnectionTest, AddTrackWithMismatchedCodecThrows) {
+    auto config = createTestConfig();
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    MediaTrackConfig trackConfig;
+    trackConfig.type = MediaType::Audio;
+    trackConfig.codec = MediaCodec::H264;
+    trackConfig.mid = "audio";
+    trackConfig.ssrc = 1;
+
+    EXPECT_THROW(pc->addTrack(trackConfig), std::invalid_argument);
+
+    pc->close();
+}
+
+// Test: Send tracks appear in the generated offer
+TEST_F(PeerConnectionTest, SendTracksAppearInOffer) {
+    CallbackState state;
+    auto config = createTestConfigWithState(state);
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    MediaTrackConfig video;
+    video.type = MediaType::Video;
+    video.codec = MediaCodec::H264;
+    video.mid = "video";
+    video.ssrc = 1111;
+    pc->addTrack(video);
+
+    MediaTrackConfig audio;
+    audio.type = MediaType::Audio;
+    audio.codec = MediaCodec::Opus;
+    audio.mid = "audio";
+    audio.ssrc = 2222;
+    audio.payloadType = 111;
+    pc->addTrack(audio);
+
+    pc->createOffer();
+    ASSERT_TRUE(waitFor([&state]() {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        return !state.localDescriptions.empty();
+    }, std::chrono::milliseconds(1000)));
+
+    std::string offer = pc->getLocalDescription();
+    EXPECT_NE(offer.find("m=video"), std::string::npos);
+    EXPECT_NE(offer.find("H264"), std::string::npos);
+    EXPECT_NE(offer.find("m=audio"), std::string::npos);
+    EXPECT_NE(offer.find("opus"), std::string::npos);
+    EXPECT_NE(offer.find("sendonly"), std::string::npos);
+
+    pc->close();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+// Test: VP8, VP9 and AV1 send tracks advertise their codecs in the offer
+TEST_F(PeerConnectionTest, VideoCodecsAppearInOffer) {
+    const std::pair<MediaCodec, const char*> codecs[] = {
+        {MediaCodec::VP8, "VP8"}, {MediaCodec::VP9, "VP9"}, {MediaCodec::AV1, "AV1"}};
+
+    for (const auto& codec : codecs) {
+        CallbackState state;
+        auto config = createTestConfigWithState(state);
+        auto pc = std::make_unique<PeerConnection>(config);
+
+        MediaTrackConfig video;
+        video.type = MediaType::Video;
+        video.codec = codec.first;
+        video.mid = "video";
+        video.ssrc = 1111;
+        pc->addTrack(video);
+
+        pc->createOffer();
+        ASSERT_TRUE(waitFor([&state]() {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            return !state.localDescriptions.empty();
+        }, std::chrono::milliseconds(1000)));
+
+        EXPECT_NE(pc->getLocalDescription().find(codec.second), std::string::npos) << codec.second;
+
+        pc->close();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+// Test: Sending without a track (or before it is open) is rejected
+TEST_F(PeerConnectionTest, SendFrameWithoutOpenTrackReturnsFalse) {
+    auto config = createTestConfig();
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    std::vector<uint8_t> au = makeAccessUnit(100, 1, true);
+    EXPECT_FALSE(pc->sendFrame(MediaType::Video, au.data(), au.size(), 0));
+
+    MediaTrackConfig video;
+    video.type = MediaType::Video;
+    video.codec = MediaCodec::H264;
+    video.mid = "video";
+    video.ssrc = 1111;
+    pc->addTrack(video);
+
+    // Not negotiated yet, so the track cannot be open
+    EXPECT_FALSE(pc->sendFrame(MediaType::Video, au.data(), au.size(), 0));
+
+    pc->close();
+}
+
+// Test: Keyframe requests need a received video track; the interval cannot be negative
+TEST_F(PeerConnectionTest, RequestKeyframeWithoutReceivedTrackReturnsFalse) {
+    auto config = createTestConfig();
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    EXPECT_FALSE(pc->requestKeyframe());
+    pc->close();
+
+    config.minKeyframeRequestIntervalMs = -1;
+    EXPECT_THROW(PeerConnection invalid(config), std::invalid_argument);
+}
+
+// Test: Only video tracks can use RTX
+TEST_F(PeerConnectionTest, RtxAudioTrackThrows) {
+    auto config = createTestConfig();
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    MediaTrackConfig audio;
+    audio.type = MediaType::Audio;
+    audio.codec = MediaCodec::Opus;
+    audio.mid = "audio";
+    audio.ssrc = 1;
+    audio.rtxSsrc = 2;
+
+    EXPECT_THROW(pc->addTrack(audio), std::invalid_argument);
+
+    pc->close();
+}
+
+// Test: RTX must use its own SSRC and payload type
+TEST_F(PeerConnectionTest, RtxMustDifferFromMedia) {
+    auto config = createTestConfig();
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    MediaTrackConfig video;
+    video.mid = "video";
+    video.ssrc = 1;
+    video.rtxSsrc = 1;
+    EXPECT_THROW(pc->addTrack(video), std::invalid_argument);
+
+    video.rtxSsrc = 2;
+    video.rtxPayloadType = video.payloadType;
+    EXPECT_THROW(pc->addTrack(video), std::invalid_argument);
+
+    video.rtxPayloadType = 97;
+    EXPECT_NO_THROW(pc->addTrack(video));
+
+    pc->close();
+}
+
+// Test: Only video tracks can use FEC
+TEST_F(PeerConnectionTest, FecAudioTrackThrows) {
+    auto config = createTestConfig();
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    MediaTrackConfig audio;
+    audio.type = MediaType::Audio;
+    audio.codec = MediaCodec::Opus;
+    audio.mid = "audio";
+    audio.ssrc = 1;
+    audio.payloadType = 111;
+    audio.fecSsrc = 2;
+    EXPECT_THROW(pc->addTrack(audio), std::invalid_argument);
+
+    pc->close();
+}
+
+// Test: FEC must use its own SSRC and payload type, distinct from RTX's
+TEST_F(PeerConnectionTest, FecMustDifferFromMediaAndRtx) {
+    auto config = createTestConfig();
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    MediaTrackConfig video;
+    video.mid = "video";
+    video.ssrc = 1;
+    video.rtxSsrc = 2;
+    video.fecSsrc = 1;
+    EXPECT_THROW(pc->addTrack(video), std::invalid_argument);
+
+    video.fecSsrc = 2;
+    EXPECT_THROW(pc->addTrack(video), std::invalid_argument);
+
+    video.fecSsrc = 3;
+    video.fecPayloadType = video.rtxPayloadType;
+    EXPECT_THROW(pc->addTrack(video), std::invalid_argument);
+
+    video.fecPayloadType = 98;
+    EXPECT_NO_THROW(pc->addTrack(video));
+    pc->setFecProtectionRatio(0.3);
+
+    pc->close();
+}
+
+// Test: Only video tracks can take prepacketized frames
+TEST_F(PeerConnectionTest, PrepacketizedAudioTrackThrows) {
+    auto config = createTestConfig();
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    MediaTrackConfig audio;
+    audio.type = MediaType::Audio;
+    audio.codec = MediaCodec::Opus;
+    audio.mid = "audio";
+    audio.ssrc = 1;
+    audio.prepacketized = true;
+
+    EXPECT_THROW(pc->addTrack(audio), std::invalid_argument);
+
+    pc->close();
+}
+
+// Test: sendFrame() and sendPacketizedFrame() only accept their own kind of track
+TEST_F(PeerConnectionTest, PrepacketizedTrackRejectsRawFrames) {
+    auto config = createTestConfig();
+    auto pc = std::make_unique<PeerConnection>(config);
+
+    std::vector<uint8_t> au = makeAccessUnit(100, 1, true);
+    H264RtpPacketizer packetizer;
+    PacketizedFrame frame;
+    ASSERT_TRUE(packetizer.packetize(au.data(), au.size(), frame));
+
+    // No track yet
+    EXPECT_FALSE(pc->sendPacketizedFrame(MediaType::Video, frame, 0));
+
+    MediaTrackConfig video;
+    video.type = MediaType::Video;
+    video.codec = MediaCodec::H264;
+    video.mid = "video";
+    video.ssrc = 2222;
+    video.prepacketized = true;
+    pc->addTrack(video);
+
+    EXPECT_FALSE(pc->sendFrame(MediaType::Video, au.data(), au.size(), 0));
+    // Not negotiated yet, so the track cannot be open
+    EXPECT_FALSE(pc->sendPacketizedFrame(MediaType::Video, frame, 0));
+
+    pc->close();
+}
+
+// Test: H.264 access units sent on a send track are reassembled byte-exact by a second PeerConnection
+TEST_F(PeerConnectionTest, SendTrackLoopbackReassemblesAccessUnitsByteExact) {
+    CallbackState senderState, receiverState;
+
+    auto senderConfig = createTestConfigWithState(senderState);
+    senderConfig.iceServers.clear();  // Host candidates are enough on loopback
+    auto receiverConfig = createTestConfigWithState(receiverState);
+    receiverConfig.iceServers.clear();
+
+    auto sender = std::make_unique<PeerConnection>(senderConfig);
+    auto receiver = std::make_unique<PeerConnection>(receiverConfig);
+
+    MediaTrackConfig video;
+    video.type = MediaType::Video;
+    video.codec = MediaCodec::H264;
+    video.mid = "video";
+    video.ssrc = 0x12345678;
+    sender->addTrack(video);
+
+    // Offer / answer
+    sender->createOffer();
+    ASSERT_TRUE(waitFor([&senderState]() {
+        std::lock_guard<std::mutex> lock(senderState.mutex);
+        return !senderState.localDescriptions.empty();
+    }, std::chrono::milliseconds(2000)));
+
+    std::string offer;
+    {
+        std::lock_guard<std::mutex> lock(senderState.mutex);
+        offer = senderState.localDescriptions[0].second;
+    }
+    receiver->setRemoteDescription(SdpType::Offer, offer);
+    receiver->createAnswer();
+
+    ASSERT_TRUE(waitFor([&receiverState]() {
+        std::lock_guard<std::mutex> lock(receiverState.mutex);
+        return !receiverState.localDescriptions.empty();
+    }, std::chrono::milliseconds(2000)));
+
+    std::string answer;
+    {
+        std::lock_guard<std::mutex> lock(receiverState.mutex);
+        answer = receiverState.localDescriptions[0].second;
+    }
+    sender->setRemoteDescription(SdpType::Answer, answer);
+
+    // Trickle candidates in both directions until connected
+    auto forwardCandidates = [](CallbackState& from, PeerConnection& to, size_t& forwarded) {
+        std::vector<std::pair<std::string, std::string>> pending;
+        {
+            std::lock_guard<std::mutex> lock(from.mutex);
+            pending.assign(from.iceCandidates.begin() + forwarded, from.iceCandidates.end());
+            forwarded = from.iceCandidates.size();
+        }
+        for (const auto& candidate : pending) {
+            to.addIceCandidate(candidate.first, candidate.second);
+        }
+    };
+
+    size_t senderForwarded = 0;
+    size_t receiverForwarded = 0;
+    ASSERT_TRUE(waitFor([&]() {
+        forwardCandidates(senderState, *receiver, senderForwarded);
+        forwardCandidates(receiverState, *sender, receiverForwarded);
+        return sender->isConnected() && receiver->isConnected();
+    }, std::chrono::milliseconds(10000)));
+
+    // 1080p60-sized access units: a large IDR followed by P-frames
+    constexpr int kFrameCount = 6;
+    constexpr int64_t kFrameDurationUs = 16667;
+    std::vector<std::vector<uint8_t>> sent;
+    for (int i = 0; i < kFrameCount; ++i) {
+        sent.push_back(makeAccessUnit(i == 0 ? 120 * 1024 : 16 * 1024, static_cast<uint8_t>(i), i == 0));
+    }
+
+    for (int i = 0; i < kFrameCount; ++i) {
+        const auto& au = sent[i];
+        // The track opens asynchronously once DTLS completes; retry until accepted
+        ASSERT_TRUE(waitFor([&]() {
+            return sender->sendFrame(MediaType::Video, au.data(), au.size(), i * kFrameDurationUs);
+        }, std::chrono::milliseconds(5000)));
+    }
+
+    // The depacketizer may hold back the last frame until the next timestamp arrives
+    ASSERT_TRUE(waitFor([&receiverState]() {
+        std::lock_guard<std::mutex> lock(receiverState.mutex);
+        return receiverState.videoFrames.size() >= static_cast<size_t>(kFrameCount - 1);
+    }, std::chrono::milliseconds(5000)));
+
+    {
+        std::lock_guard<std::mutex> lock(receiverState.mutex);
+        for (int i = 0; i < kFrameCount - 1; ++i) {
+            EXPECT_EQ(receiverState.videoFrames[i].data.toVector(), sent[i]) << "Access unit " << i << " differs";
+        }
+    }
+
+    sender->close();
+    receiver->close();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
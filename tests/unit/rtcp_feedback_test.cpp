@@ -0,0 +1,277 @@
+/**
+ * @file rtcp_feedback_test.cpp
+ * @brief Unit tests for RTCP feedback parsing
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/rtcp-feedback.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for RTCP feedback tests
+ */
+class RtcpFeedbackTest : public ::testing::Test {
+protected:
+    static void putU32(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static void putHeader(std::vector<uint8_t>& out, uint8_t count, uint8_t packetType,
+                          size_t totalBytes) {
+        const uint16_t length = static_cast<uint16_t>(totalBytes / 4 - 1);
+        out.push_back(static_cast<uint8_t>(0x80 | count));
+        out.push_back(packetType);
+        out.push_back(static_cast<uint8_t>(length >> 8));
+        out.push_back(static_cast<uint8_t>(length));
+    }
+
+    static void putReportBlock(std::vector<uint8_t>& out, uint32_t ssrc, uint8_t fractionLost,
+                               uint32_t lsr, uint32_t dlsr) {
+        putU32(out, ssrc);
+        putU32(out, (static_cast<uint32_t>(fractionLost) << 24) | 42);  // 42 packets lost
+        putU32(out, 1000);  // Highest sequence
+        putU32(out, 7);     // Jitter
+        putU32(out, lsr);
+        putU32(out, dlsr);
+    }
+
+    static std::vector<uint8_t> receiverReport(uint32_t ssrc, uint8_t fractionLost,
+                                               uint32_t lsr = 0, uint32_t dlsr = 0) {
+        std::vector<uint8_t> packet;
+        putHeader(packet, 1, 201, 8 + 24);
+        putU32(packet, 0x11111111);  // Reporter SSRC
+        putReportBlock(packet, ssrc, fractionLost, lsr, dlsr);
+        return packet;
+    }
+
+    static std::vector<uint8_t> remb(uint8_t exponent, uint32_t mantissa,
+                                     const std::vector<uint32_t>& ssrcs) {
+        std::vector<uint8_t> packet;
+        putHeader(packet, 15, 206, 12 + 8 + ssrcs.size() * 4);
+        putU32(packet, 0x11111111);  // Sender SSRC
+        putU32(packet, 0);           // Media SSRC (unused by REMB)
+        packet.insert(packet.end(), {'R', 'E', 'M', 'B'});
+        packet.push_back(static_cast<uint8_t>(ssrcs.size()));
+        packet.push_back(static_cast<uint8_t>((exponent << 2) | ((mantissa >> 16) & 0x03)));
+        packet.push_back(static_cast<uint8_t>(mantissa >> 8));
+        packet.push_back(static_cast<uint8_t>(mantissa));
+        for (uint32_t ssrc : ssrcs) {
+            putU32(packet, ssrc);
+        }
+        return packet;
+    }
+
+    static std::vector<uint8_t> pli(uint32_t mediaSsrc) {
+        std::vector<uint8_t> packet;
+        putHeader(packet, 1, 206, 12);
+        putU32(packet, 0x11111111);  // Sender SSRC
+        putU32(packet, mediaSsrc);
+        return packet;
+    }
+
+    static std::vector<uint8_t> nack(uint32_t mediaSsrc,
+                                     const std::vector<std::pair<uint16_t, uint16_t>>& items) {
+        std::vector<uint8_t> packet;
+        putHeader(packet, 1, 205, 12 + items.size() * 4);
+        putU32(packet, 0x11111111);  // Sender SSRC
+        putU32(packet, mediaSsrc);
+        for (const auto& item : items) {
+            putU32(packet, (static_cast<uint32_t>(item.first) << 16) | item.second);
+        }
+        return packet;
+    }
+
+    static std::vector<uint8_t> fir(const std::vector<uint32_t>& ssrcs) {
+        std::vector<uint8_t> packet;
+        putHeader(packet, 4, 206, 12 + ssrcs.size() * 8);
+        putU32(packet, 0x11111111);  // Sender SSRC
+        putU32(packet, 0);           // Media SSRC (unused by FIR)
+        uint8_t seq = 1;
+        for (uint32_t ssrc : ssrcs) {
+            putU32(packet, ssrc);
+            putU32(packet, static_cast<uint32_t>(seq++) << 24);  // Seq nr + reserved
+        }
+        return packet;
+    }
+};
+
+/**
+ * @brief Test parsing a receiver report block
+ */
+TEST_F(RtcpFeedbackTest, ParsesReceiverReport) {
+    auto packet = receiverReport(0xABCDEF01, 64, 0x12345678, 0x00010000);
+
+    RtcpFeedback feedback;
+    ASSERT_TRUE(parseRtcpFeedback(packet.data(), packet.size(), feedback));
+    ASSERT_EQ(feedback.reportBlocks.size(), 1u);
+
+    const auto& block = feedback.reportBlocks[0];
+    EXPECT_EQ(block.ssrc, 0xABCDEF01u);
+    EXPECT_EQ(block.fractionLost, 64);
+    EXPECT_EQ(block.cumulativeLost, 42);
+    EXPECT_EQ(block.highestSequence, 1000u);
+    EXPECT_EQ(block.jitter, 7u);
+    EXPECT_EQ(block.lastSenderReport, 0x12345678u);
+    EXPECT_EQ(block.delaySinceLastSr, 0x00010000u);
+    EXPECT_FALSE(feedback.hasRemb);
+}
+
+/**
+ * @brief Test parsing report blocks from a sender report
+ */
+TEST_F(RtcpFeedbackTest, ParsesSenderReportBlocks) {
+    std::vector<uint8_t> packet;
+    putHeader(packet, 2, 200, 8 + 20 + 2 * 24);
+    putU32(packet, 0x22222222);  // Sender SSRC
+    for (int i = 0; i < 5; i++) {
+        putU32(packet, 0);  // Sender info
+    }
+    putReportBlock(packet, 1, 10, 0, 0);
+    putReportBlock(packet, 2, 20, 0, 0);
+
+    RtcpFeedback feedback;
+    ASSERT_TRUE(parseRtcpFeedback(packet.data(), packet.size(), feedback));
+    ASSERT_EQ(feedback.reportBlocks.size(), 2u);
+    EXPECT_EQ(feedback.reportBlocks[0].fractionLost, 10);
+    EXPECT_EQ(feedback.reportBlocks[1].ssrc, 2u);
+}
+
+/**
+ * @brief Test parsing a compound packet with RR and REMB
+ */
+TEST_F(RtcpFeedbackTest, ParsesCompoundPacket) {
+    auto packet = receiverReport(0x1234, 0);
+    // 1500 * 2^10 = 1536000 bps
+    auto rembPacket = remb(10, 1500, {0x1234, 0x5678});
+    packet.insert(packet.end(), rembPacket.begin(), rembPacket.end());
+
+    RtcpFeedback feedback;
+    ASSERT_TRUE(parseRtcpFeedback(packet.data(), packet.size(), feedback));
+    EXPECT_EQ(feedback.reportBlocks.size(), 1u);
+    ASSERT_TRUE(feedback.hasRemb);
+    EXPECT_EQ(feedback.rembBitrateBps, 1536000u);
+    EXPECT_THAT(feedback.rembSsrcs, ElementsAre(0x1234u, 0x5678u));
+}
+
+/**
+ * @brief Test parsing PLI and FIR keyframe requests
+ */
+TEST_F(RtcpFeedbackTest, ParsesKeyframeRequests) {
+    auto packet = receiverReport(0x1234, 0);
+    auto pliPacket = pli(0x1234);
+    packet.insert(packet.end(), pliPacket.begin(), pliPacket.end());
+    auto firPacket = fir({0x1234, 0x5678});
+    packet.insert(packet.end(), firPacket.begin(), firPacket.end());
+
+    RtcpFeedback feedback;
+    ASSERT_TRUE(parseRtcpFeedback(packet.data(), packet.size(), feedback));
+    EXPECT_THAT(feedback.keyframeRequestSsrcs, ElementsAre(0x1234u, 0x1234u, 0x5678u));
+    EXPECT_FALSE(feedback.hasRemb);
+}
+
+/**
+ * @brief Test expanding generic NACK PID/BLP pairs into lost packets
+ */
+TEST_F(RtcpFeedbackTest, ParsesGenericNack) {
+    // PID 100 with BLP bits 0 and 2 (101, 103); PID 65535 with bit 0 (wraps to 0)
+    auto packet = nack(0x1234, {{100, 0x0005}, {65535, 0x0001}});
+
+    RtcpFeedback feedback;
+    ASSERT_TRUE(parseRtcpFeedback(packet.data(), packet.size(), feedback));
+    std::vector<uint16_t> sequenceNumbers;
+    for (const auto& lost : feedback.nacks) {
+        EXPECT_EQ(lost.mediaSsrc, 0x1234u);
+        sequenceNumbers.push_back(lost.sequenceNumber);
+    }
+    EXPECT_THAT(sequenceNumbers, ElementsAre(100, 101, 103, 65535, 0));
+}
+
+/**
+ * @brief Test that a truncated PLI is ignored
+ */
+TEST_F(RtcpFeedbackTest, IgnoresTruncatedPli) {
+    std::vector<uint8_t> packet;
+    putHeader(packet, 1, 206, 8);
+    putU32(packet, 0x11111111);  // Sender SSRC only
+
+    RtcpFeedback feedback;
+    parseRtcpFeedback(packet.data(), packet.size(), feedback);
+    EXPECT_TRUE(feedback.keyframeRequestSsrcs.empty());
+}
+
+/**
+ * @brief Test that unknown RTCP types are skipped
+ */
+TEST_F(RtcpFeedbackTest, SkipsUnknownPacketTypes) {
+    std::vector<uint8_t> packet;
+    putHeader(packet, 1, 202, 8);  // SDES
+    putU32(packet, 0);
+    auto rr = receiverReport(7, 5);
+    packet.insert(packet.end(), rr.begin(), rr.end());
+
+    RtcpFeedback feedback;
+    ASSERT_TRUE(parseRtcpFeedback(packet.data(), packet.size(), feedback));
+    ASSERT_EQ(feedback.reportBlocks.size(), 1u);
+    EXPECT_EQ(feedback.reportBlocks[0].ssrc, 7u);
+}
+
+/**
+ * @brief Test that malformed input is rejected without reading out of bounds
+ */
+TEST_F(RtcpFeedbackTest, RejectsMalformedInput) {
+    RtcpFeedback feedback;
+    EXPECT_FALSE(parseRtcpFeedback(nullptr, 0, feedback));
+
+    uint8_t shortPacket[] = {0x81, 201};
+    EXPECT_FALSE(parseRtcpFeedback(shortPacket, sizeof(shortPacket), feedback));
+
+    // Length field claims more than is present
+    auto packet = receiverReport(1, 1);
+    packet.resize(packet.size() - 4);
+    EXPECT_FALSE(parseRtcpFeedback(packet.data(), packet.size(), feedback));
+
+    // Wrong version
+    packet = receiverReport(1, 1);
+    packet[0] = 0x41;
+    EXPECT_FALSE(parseRtcpFeedback(packet.data(), packet.size(), feedback));
+
+    EXPECT_TRUE(feedback.reportBlocks.empty());
+}
+
+/**
+ * @brief Test RTT calculation from LSR/DLSR
+ */
+TEST_F(RtcpFeedbackTest, CalculatesRtt) {
+    RtcpReportBlock block;
+    block.lastSenderReport = 0x00100000;  // 16 s
+    block.delaySinceLastSr = 0x00008000;  // 0.5 s
+
+    // Arrival at 16.6 s: 100 ms RTT
+    const uint32_t arrival = 0x00100000 + 0x00008000 + 6554;
+    EXPECT_NEAR(calculateRttMs(block, arrival), 100, 1);
+
+    // No SR reference
+    block.lastSenderReport = 0;
+    EXPECT_EQ(calculateRttMs(block, arrival), -1);
+}
+
+/**
+ * @brief Test RTT calculation across the compact NTP wrap
+ */
+TEST_F(RtcpFeedbackTest, CalculatesRttAcrossWrap) {
+    RtcpReportBlock block;
+    block.lastSenderReport = 0xFFFF0000;
+    block.delaySinceLastSr = 0x00008000;
+
+    const uint32_t arrival = 0xFFFF0000u + 0x00008000u + 0x00010000u;  // Wraps to 0x00008000
+    EXPECT_EQ(calculateRttMs(block, arrival), 1000);
+}
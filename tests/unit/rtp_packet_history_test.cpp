@@ -0,0 +1,191 @@
+/**
+ * @file rtp_packet_history_test.cpp
+ * @brief Unit tests for RtpPacketHistory and RTX packet construction
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/rtp-packet-history.hpp"
+#include "core/rtp-packetizer.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for RTP packet history tests
+ */
+class RtpPacketHistoryTest : public ::testing::Test {
+protected:
+    static std::vector<uint8_t> rtpPacket(uint16_t sequenceNumber, size_t payloadSize,
+                                          uint8_t fill = 0xAB) {
+        std::vector<uint8_t> packet(constants::kRtpHeaderSize + payloadSize, fill);
+        writeRtpHeader(packet.data(), 96, true, sequenceNumber, 90000, 0x1234);
+        return packet;
+    }
+
+    static RtpPacketHistoryConfig config(int windowMs, int maxBitrateKbps) {
+        RtpPacketHistoryConfig historyConfig;
+        historyConfig.windowMs = windowMs;
+        historyConfig.maxBitrateKbps = maxBitrateKbps;
+        return historyConfig;
+    }
+};
+
+/**
+ * @brief Test that invalid configurations are rejected
+ */
+TEST_F(RtpPacketHistoryTest, InvalidConfigThrows) {
+    EXPECT_THROW(RtpPacketHistory(config(0, 5000)), std::invalid_argument);
+    EXPECT_THROW(RtpPacketHistory(config(1000, 0)), std::invalid_argument);
+
+    RtpPacketHistoryConfig tiny;
+    tiny.maxPacketSize = 4;
+    EXPECT_THROW(RtpPacketHistory{tiny}, std::invalid_argument);
+}
+
+/**
+ * @brief Test that the capacity follows the window and bitrate within bounds
+ */
+TEST_F(RtpPacketHistoryTest, CapacityCoversWindow) {
+    // 5 Mbps for 1 s = 625 kB = 521 full packets -> 1024 slots
+    EXPECT_EQ(RtpPacketHistory(config(1000, 5000)).getCapacity(), 1024u);
+    EXPECT_EQ(RtpPacketHistory(config(100, 100)).getCapacity(), constants::kMinRtxHistoryPackets);
+    EXPECT_EQ(RtpPacketHistory(config(60000, 100000)).getCapacity(),
+              constants::kMaxRtxHistoryPackets);
+}
+
+/**
+ * @brief Test storing and finding packets
+ */
+TEST_F(RtpPacketHistoryTest, FindsStoredPackets) {
+    RtpPacketHistory history(config(1000, 5000));
+    auto first = rtpPacket(10, 100, 0x01);
+    auto second = rtpPacket(11, 1200, 0x02);
+    history.store(first.data(), first.size(), 0);
+    history.store(second.data(), second.size(), 5);
+
+    size_t size = 0;
+    const uint8_t* found = history.find(11, 10, size);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(std::vector<uint8_t>(found, found + size), second);
+
+    found = history.find(10, 10, size);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(std::vector<uint8_t>(found, found + size), first);
+
+    EXPECT_EQ(history.find(12, 10, size), nullptr);
+}
+
+/**
+ * @brief Test that packets older than the window are not returned
+ */
+TEST_F(RtpPacketHistoryTest, ExpiresPacketsOutsideWindow) {
+    RtpPacketHistory history(config(1000, 5000));
+    auto packet = rtpPacket(500, 100);
+    history.store(packet.data(), packet.size(), 1000);
+
+    size_t size = 0;
+    EXPECT_NE(history.find(500, 2000, size), nullptr);
+    EXPECT_EQ(history.find(500, 2001, size), nullptr);
+}
+
+/**
+ * @brief Test that a slot reused by a newer sequence number misses, across wrap
+ */
+TEST_F(RtpPacketHistoryTest, OverwrittenSlotMisses) {
+    RtpPacketHistory history(config(100, 100));
+    const size_t capacity = history.getCapacity();
+
+    for (size_t i = 0; i <= capacity; i++) {
+        auto packet = rtpPacket(static_cast<uint16_t>(65535 + i), 100);
+        history.store(packet.data(), packet.size(), 0);
+    }
+
+    size_t size = 0;
+    EXPECT_EQ(history.find(65535, 0, size), nullptr);  // Replaced by 65535 + capacity
+    EXPECT_NE(history.find(0, 0, size), nullptr);
+    EXPECT_NE(history.find(static_cast<uint16_t>(65535 + capacity), 0, size), nullptr);
+
+    history.clear();
+    EXPECT_EQ(history.find(0, 0, size), nullptr);
+}
+
+/**
+ * @brief Test that oversized and truncated packets are not stored
+ */
+TEST_F(RtpPacketHistoryTest, IgnoresUnstorablePackets) {
+    RtpPacketHistory history(config(1000, 5000));
+    auto oversized = rtpPacket(1, constants::kMaxRtpPacketSize);
+    history.store(oversized.data(), oversized.size(), 0);
+    history.store(oversized.data(), 4, 0);
+
+    size_t size = 0;
+    EXPECT_EQ(history.find(1, 0, size), nullptr);
+}
+
+/**
+ * @brief Test RTX packet layout (RFC 4588)
+ */
+TEST_F(RtpPacketHistoryTest, WritesRtxPacket) {
+    auto original = rtpPacket(0x1234, 3, 0x00);
+    original[12] = 0xAA;
+    original[13] = 0xBB;
+    original[14] = 0xCC;
+
+    std::vector<uint8_t> rtx(original.size() + 2);
+    ASSERT_EQ(writeRtxPacket(original.data(), original.size(), 97, 7, 0xCAFEBABE, rtx.data()),
+              rtx.size());
+
+    EXPECT_EQ(rtx[0], 0x80);
+    EXPECT_EQ(rtx[1], 0x80 | 97);  // Marker kept
+    EXPECT_EQ(rtx[2], 0x00);
+    EXPECT_EQ(rtx[3], 0x07);
+    EXPECT_THAT(std::vector<uint8_t>(rtx.begin() + 4, rtx.begin() + 8),
+                ElementsAreArray(original.begin() + 4, original.begin() + 8));  // Timestamp
+    EXPECT_THAT(std::vector<uint8_t>(rtx.begin() + 8, rtx.end()),
+                ElementsAre(0xCA, 0xFE, 0xBA, 0xBE, 0x12, 0x34, 0xAA, 0xBB, 0xCC));
+}
+
+/**
+ * @brief Test that RTX keeps header extensions and drops padding
+ */
+TEST_F(RtpPacketHistoryTest, RtxKeepsExtensionDropsPadding) {
+    // Header with a one-word extension, 2 payload bytes and 2 padding bytes
+    std::vector<uint8_t> original(12 + 8 + 2 + 2);
+    writeRtpHeader(original.data(), 96, false, 1, 0, 0x1234);
+    original[0] |= 0x30;  // X and P
+    original[12] = 0xBE;
+    original[13] = 0xDE;
+    original[15] = 1;
+    original[20] = 0x55;
+    original[21] = 0x66;
+    original[23] = 2;
+
+    std::vector<uint8_t> rtx(original.size() + 2);
+    const size_t written = writeRtxPacket(original.data(), original.size(), 97, 0, 1, rtx.data());
+    ASSERT_EQ(written, 12u + 8 + 2 + 2);
+    EXPECT_EQ(rtx[0], 0x90);  // X kept, P cleared
+    EXPECT_EQ(rtx[12], 0xBE);
+    EXPECT_EQ(rtx[20], 0x00);  // OSN
+    EXPECT_EQ(rtx[21], 0x01);
+    EXPECT_EQ(rtx[22], 0x55);
+    EXPECT_EQ(rtx[23], 0x66);
+}
+
+/**
+ * @brief Test that malformed originals are rejected
+ */
+TEST_F(RtpPacketHistoryTest, RtxRejectsMalformedPacket) {
+    std::vector<uint8_t> out(64);
+    uint8_t shortPacket[4] = {0x80, 96, 0, 1};
+    EXPECT_EQ(writeRtxPacket(shortPacket, sizeof(shortPacket), 97, 0, 1, out.data()), 0u);
+    EXPECT_EQ(writeRtxPacket(nullptr, 0, 97, 0, 1, out.data()), 0u);
+
+    auto packet = rtpPacket(1, 2);
+    packet[0] |= 0x20;
+    packet.back() = 200;  // Padding longer than the payload
+    EXPECT_EQ(writeRtxPacket(packet.data(), packet.size(), 97, 0, 1, out.data()), 0u);
+}
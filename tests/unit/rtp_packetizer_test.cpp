@@ -0,0 +1,417 @@
+/**
+ * @file rtp_packetizer_test.cpp
+ * @brief Unit tests for the H.264, VP8, VP9 and AV1 RTP packetizers
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/rtp-packetizer.hpp"
+#include <random>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for RTP packetizer tests
+ */
+class RtpPacketizerTest : public ::testing::Test {
+protected:
+    static std::vector<uint8_t> randomBytes(size_t size, uint32_t seed = 7) {
+        std::mt19937 gen(seed);
+        std::vector<uint8_t> bytes(size);
+        for (auto& byte : bytes) {
+            byte = static_cast<uint8_t>(gen());
+        }
+        return bytes;
+    }
+
+    static void expectWithinLimit(const PacketizedFrame& out, size_t maxPayloadSize) {
+        for (const auto& payload : out.payloads) {
+            EXPECT_LE(payload.size, maxPayloadSize);
+            EXPECT_GT(payload.size, 0u);
+        }
+    }
+
+    static void expectMarkerOnLastOnly(const PacketizedFrame& out) {
+        ASSERT_FALSE(out.payloads.empty());
+        for (size_t i = 0; i < out.payloads.size(); i++) {
+            EXPECT_EQ(out.payloads[i].marker, i == out.payloads.size() - 1);
+        }
+    }
+
+    /**
+     * @brief Strip descriptors of fixed size and concatenate the payloads
+     */
+    static std::vector<uint8_t> reassemble(const PacketizedFrame& out,
+                                           size_t (*descriptorSize)(const uint8_t*)) {
+        std::vector<uint8_t> frame;
+        for (const auto& payload : out.payloads) {
+            const uint8_t* data = out.data(payload);
+            const size_t skip = descriptorSize(data);
+            frame.insert(frame.end(), data + skip, data + payload.size);
+        }
+        return frame;
+    }
+
+    static size_t vp8DescriptorSize(const uint8_t*) { return 4; }
+
+    static size_t vp9DescriptorSize(const uint8_t* data) { return (data[0] & 0x40) ? 4 : 3; }
+
+    /**
+     * @brief Build an OBU with a size field
+     */
+    static std::vector<uint8_t> obu(uint8_t type, const std::vector<uint8_t>& payload) {
+        std::vector<uint8_t> out = {static_cast<uint8_t>((type << 3) | 0x02)};
+        size_t size = payload.size();
+        while (size >= 0x80) {
+            out.push_back(static_cast<uint8_t>((size & 0x7F) | 0x80));
+            size >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(size));
+        out.insert(out.end(), payload.begin(), payload.end());
+        return out;
+    }
+
+    /**
+     * @brief Reference AV1 depacketizer: returns the OBU elements (header + payload)
+     */
+    static std::vector<std::vector<uint8_t>> av1Elements(const PacketizedFrame& out) {
+        std::vector<std::vector<uint8_t>> elements;
+        bool continuing = false;
+        for (const auto& payload : out.payloads) {
+            const uint8_t* data = out.data(payload);
+            const bool z = (data[0] & 0x80) != 0;
+            const bool y = (data[0] & 0x40) != 0;
+            EXPECT_EQ(z, continuing);
+            EXPECT_EQ((data[0] >> 4) & 0x03, 0);  // W = 0
+
+            size_t offset = 1;
+            bool first = true;
+            while (offset < payload.size) {
+                size_t length = 0;
+                int shift = 0;
+                uint8_t byte;
+                do {
+                    byte = data[offset++];
+                    length |= static_cast<size_t>(byte & 0x7F) << shift;
+                    shift += 7;
+                } while (byte & 0x80);
+
+                if (first && z) {
+                    elements.back().insert(elements.back().end(), data + offset,
+                                           data + offset + length);
+                } else {
+                    elements.emplace_back(data + offset, data + offset + length);
+                }
+                offset += length;
+                first = false;
+            }
+            EXPECT_EQ(offset, payload.size);
+            continuing = y;
+        }
+        EXPECT_FALSE(continuing);
+        return elements;
+    }
+};
+
+/**
+ * @brief Test that a too small payload limit is rejected
+ */
+TEST_F(RtpPacketizerTest, TooSmallPayloadSizeThrows) {
+    EXPECT_THROW(H264RtpPacketizer(2), std::invalid_argument);
+    EXPECT_THROW(Vp8RtpPacketizer(4), std::invalid_argument);
+    EXPECT_THROW(Vp9RtpPacketizer(8), std::invalid_argument);
+    EXPECT_THROW(Av1RtpPacketizer(1), std::invalid_argument);
+}
+
+/**
+ * @brief Test that empty frames produce nothing
+ */
+TEST_F(RtpPacketizerTest, EmptyFrameProducesNothing) {
+    PacketizedFrame out;
+    H264RtpPacketizer h264;
+    Vp8RtpPacketizer vp8;
+    Vp9RtpPacketizer vp9;
+    Av1RtpPacketizer av1;
+    EXPECT_FALSE(h264.packetize(nullptr, 0, out));
+    EXPECT_FALSE(vp8.packetize(nullptr, 0, out));
+    EXPECT_FALSE(vp9.packetize(nullptr, 0, out));
+    EXPECT_FALSE(av1.packetize(nullptr, 0, out));
+    EXPECT_TRUE(out.payloads.empty());
+}
+
+/**
+ * @brief Test the fixed RTP header layout
+ */
+TEST_F(RtpPacketizerTest, WritesRtpHeader) {
+    uint8_t header[12];
+    writeRtpHeader(header, 96, true, 0xABCD, 0x01020304, 0xDEADBEEF);
+
+    const uint8_t expected[12] = {0x80, 0xE0, 0xAB, 0xCD, 0x01, 0x02,
+                                  0x03, 0x04, 0xDE, 0xAD, 0xBE, 0xEF};
+    EXPECT_EQ(std::vector<uint8_t>(header, header + 12), std::vector<uint8_t>(expected, expected + 12));
+
+    writeRtpHeader(header, 111, false, 0, 0, 0);
+    EXPECT_EQ(header[1], 111);
+}
+
+/**
+ * @brief Test H.264 single NAL unit packets and FU-A fragmentation
+ */
+TEST_F(RtpPacketizerTest, H264SingleNalAndFuA) {
+    const std::vector<uint8_t> sps = {0x67, 0x42, 0x00, 0x1F};
+    auto idr = randomBytes(3000);
+    idr[0] = 0x65;
+
+    std::vector<uint8_t> frame = {0, 0, 0, 1};
+    frame.insert(frame.end(), sps.begin(), sps.end());
+    frame.insert(frame.end(), {0, 0, 1});
+    frame.insert(frame.end(), idr.begin(), idr.end());
+
+    H264RtpPacketizer packetizer(1200);
+    PacketizedFrame out;
+    ASSERT_TRUE(packetizer.packetize(frame.data(), frame.size(), out));
+
+    EXPECT_TRUE(out.keyframe);
+    ASSERT_EQ(out.payloads.size(), 4u);  // SPS + 3 FU-A fragments
+    expectWithinLimit(out, 1200);
+    expectMarkerOnLastOnly(out);
+
+    const uint8_t* first = out.data(out.payloads[0]);
+    EXPECT_EQ(std::vector<uint8_t>(first, first + out.payloads[0].size), sps);
+
+    // Reassemble the IDR from its fragments
+    std::vector<uint8_t> nal;
+    for (size_t i = 1; i < out.payloads.size(); i++) {
+        const uint8_t* data = out.data(out.payloads[i]);
+        EXPECT_EQ(data[0], 0x60 | 28);  // NRI of the IDR, type FU-A
+        EXPECT_EQ(data[1] & 0x1F, 5);
+        EXPECT_EQ((data[1] & 0x80) != 0, i == 1);                       // S
+        EXPECT_EQ((data[1] & 0x40) != 0, i == out.payloads.size() - 1);  // E
+        if (i == 1) {
+            nal.push_back(static_cast<uint8_t>((data[0] & 0xE0) | (data[1] & 0x1F)));
+        }
+        nal.insert(nal.end(), data + 2, data + out.payloads[i].size);
+    }
+    EXPECT_EQ(nal, idr);
+}
+
+/**
+ * @brief Test that H.264 delta frames and non-Annex-B input are handled
+ */
+TEST_F(RtpPacketizerTest, H264DeltaFrameAndMissingStartCode) {
+    const uint8_t delta[] = {0, 0, 1, 0x41, 0x9A, 0x22};
+    H264RtpPacketizer packetizer;
+    PacketizedFrame out;
+    ASSERT_TRUE(packetizer.packetize(delta, sizeof(delta), out));
+    EXPECT_FALSE(out.keyframe);
+    ASSERT_EQ(out.payloads.size(), 1u);
+    EXPECT_TRUE(out.payloads[0].marker);
+
+    const uint8_t lengthPrefixed[] = {0, 0, 0, 2, 0x41, 0x9A};
+    EXPECT_FALSE(packetizer.packetize(lengthPrefixed, sizeof(lengthPrefixed), out));
+    EXPECT_TRUE(out.payloads.empty());
+}
+
+/**
+ * @brief Test that an IDR without SPS/PPS is preceded by a STAP-A
+ */
+TEST_F(RtpPacketizerTest, H264InjectsParameterSetsAheadOfIdr) {
+    const uint8_t extradata[] = {0, 0, 0, 1, 0x67, 0x42, 0x00, 0x1F, 0, 0, 0, 1, 0x68, 0xCE, 0x38};
+    const uint8_t idr[] = {0, 0, 1, 0x65, 0x88, 0x84};
+    const uint8_t delta[] = {0, 0, 1, 0x41, 0x9A, 0x22};
+
+    H264RtpPacketizer packetizer;
+    ASSERT_TRUE(packetizer.setParameterSets(extradata, sizeof(extradata)));
+
+    PacketizedFrame out;
+    ASSERT_TRUE(packetizer.packetize(idr, sizeof(idr), out));
+    EXPECT_TRUE(out.keyframe);
+    ASSERT_EQ(out.payloads.size(), 2u);
+    expectMarkerOnLastOnly(out);
+
+    const std::vector<uint8_t> stapA = {0x78, 0, 4, 0x67, 0x42, 0x00, 0x1F, 0, 3, 0x68, 0xCE, 0x38};
+    const uint8_t* first = out.data(out.payloads[0]);
+    EXPECT_EQ(std::vector<uint8_t>(first, first + out.payloads[0].size), stapA);
+    const uint8_t* second = out.data(out.payloads[1]);
+    EXPECT_EQ(std::vector<uint8_t>(second, second + out.payloads[1].size),
+              std::vector<uint8_t>(idr + 3, idr + sizeof(idr)));
+
+    // Delta frames are left alone
+    ASSERT_TRUE(packetizer.packetize(delta, sizeof(delta), out));
+    EXPECT_EQ(out.payloads.size(), 1u);
+}
+
+/**
+ * @brief Test VP8 descriptors, fragmentation and reassembly
+ */
+TEST_F(RtpPacketizerTest, Vp8FragmentsWithDescriptor) {
+    auto frame = randomBytes(5000);
+    frame[0] &= ~0x01;  // Keyframe
+
+    Vp8RtpPacketizer packetizer(1200);
+    PacketizedFrame out;
+    ASSERT_TRUE(packetizer.packetize(frame.data(), frame.size(), out));
+
+    EXPECT_TRUE(out.keyframe);
+    EXPECT_EQ(out.payloads.size(), 5u);
+    expectWithinLimit(out, 1200);
+    expectMarkerOnLastOnly(out);
+
+    for (size_t i = 0; i < out.payloads.size(); i++) {
+        const uint8_t* data = out.data(out.payloads[i]);
+        EXPECT_EQ(data[0], i == 0 ? 0x90 : 0x80);  // X, S only on the first
+        EXPECT_EQ(data[1], 0x80);                   // I
+        EXPECT_EQ(data[2], 0x80);                   // M, PictureID 0
+        EXPECT_EQ(data[3], 0x00);
+    }
+    EXPECT_EQ(reassemble(out, vp8DescriptorSize), frame);
+}
+
+/**
+ * @brief Test that the VP8 PictureID advances and wraps at 15 bits
+ */
+TEST_F(RtpPacketizerTest, Vp8PictureIdWraps) {
+    auto frame = randomBytes(100);
+    frame[0] |= 0x01;  // Inter frame
+
+    Vp8RtpPacketizer packetizer;
+    PacketizedFrame out;
+    for (int i = 0; i < 0x8000; i++) {
+        packetizer.packetize(frame.data(), frame.size(), out);
+    }
+    EXPECT_FALSE(out.keyframe);
+    EXPECT_EQ(out.data(out.payloads[0])[2], 0xFF);
+    EXPECT_EQ(out.data(out.payloads[0])[3], 0xFF);
+
+    packetizer.packetize(frame.data(), frame.size(), out);
+    EXPECT_EQ(out.data(out.payloads[0])[2], 0x80);
+    EXPECT_EQ(out.data(out.payloads[0])[3], 0x00);
+}
+
+/**
+ * @brief Test VP9 flexible mode descriptors on key and inter frames
+ */
+TEST_F(RtpPacketizerTest, Vp9FlexibleModeDescriptors) {
+    // frame_marker=2, profile 0, show_existing_frame=0, frame_type=0 (key)
+    auto keyframe = randomBytes(3000);
+    keyframe[0] = 0x80;
+    // frame_type=1 (inter)
+    auto interFrame = randomBytes(3000, 9);
+    interFrame[0] = 0x84;
+
+    Vp9RtpPacketizer packetizer(1000);
+    PacketizedFrame out;
+
+    ASSERT_TRUE(packetizer.packetize(keyframe.data(), keyframe.size(), out));
+    EXPECT_TRUE(out.keyframe);
+    expectWithinLimit(out, 1000);
+    expectMarkerOnLastOnly(out);
+    ASSERT_EQ(out.payloads.size(), 4u);
+    EXPECT_EQ(out.data(out.payloads[0])[0], 0x80 | 0x10 | 0x08);         // I F B
+    EXPECT_EQ(out.data(out.payloads[1])[0], 0x80 | 0x10);                // I F
+    EXPECT_EQ(out.data(out.payloads[3])[0], 0x80 | 0x10 | 0x04);         // I F E
+    EXPECT_EQ(reassemble(out, vp9DescriptorSize), keyframe);
+
+    ASSERT_TRUE(packetizer.packetize(interFrame.data(), interFrame.size(), out));
+    EXPECT_FALSE(out.keyframe);
+    const uint8_t* first = out.data(out.payloads[0]);
+    EXPECT_EQ(first[0], 0x80 | 0x40 | 0x10 | 0x08);  // I P F B
+    EXPECT_EQ(first[2], 0x01);                        // PictureID 1
+    EXPECT_EQ(first[3], 0x02);                        // P_DIFF 1, N 0
+    EXPECT_EQ(reassemble(out, vp9DescriptorSize), interFrame);
+}
+
+/**
+ * @brief Test that small AV1 OBUs are aggregated into one packet without size fields
+ */
+TEST_F(RtpPacketizerTest, Av1AggregatesSmallObus) {
+    const std::vector<uint8_t> sequenceHeader = {0x00, 0x00, 0x00, 0x0A, 0x0B};
+    const std::vector<uint8_t> frameData = randomBytes(300);
+
+    std::vector<uint8_t> tu = obu(2, {});  // Temporal delimiter
+    auto seq = obu(1, sequenceHeader);
+    auto frame = obu(6, frameData);
+    tu.insert(tu.end(), seq.begin(), seq.end());
+    tu.insert(tu.end(), frame.begin(), frame.end());
+
+    Av1RtpPacketizer packetizer;
+    PacketizedFrame out;
+    ASSERT_TRUE(packetizer.packetize(tu.data(), tu.size(), out));
+
+    EXPECT_TRUE(out.keyframe);
+    ASSERT_EQ(out.payloads.size(), 1u);
+    EXPECT_TRUE(out.payloads[0].marker);
+    EXPECT_EQ(out.data(out.payloads[0])[0], 0x08);  // N only
+
+    auto elements = av1Elements(out);
+    ASSERT_EQ(elements.size(), 2u);  // Temporal delimiter dropped
+    EXPECT_EQ(elements[0][0], 1 << 3);  // obu_has_size_field cleared
+    EXPECT_EQ(std::vector<uint8_t>(elements[0].begin() + 1, elements[0].end()), sequenceHeader);
+    EXPECT_EQ(elements[1][0], 6 << 3);
+    EXPECT_EQ(std::vector<uint8_t>(elements[1].begin() + 1, elements[1].end()), frameData);
+}
+
+/**
+ * @brief Test AV1 fragmentation of large OBUs across packets
+ */
+TEST_F(RtpPacketizerTest, Av1FragmentsLargeObus) {
+    const auto tileGroup1 = randomBytes(5000, 1);
+    const auto tileGroup2 = randomBytes(2500, 2);
+
+    std::vector<uint8_t> tu = obu(3, randomBytes(20, 3));  // Frame header
+    auto tg1 = obu(4, tileGroup1);
+    auto padding = obu(15, randomBytes(50, 4));
+    auto tg2 = obu(4, tileGroup2);
+    tu.insert(tu.end(), tg1.begin(), tg1.end());
+    tu.insert(tu.end(), padding.begin(), padding.end());
+    tu.insert(tu.end(), tg2.begin(), tg2.end());
+
+    Av1RtpPacketizer packetizer(1200);
+    PacketizedFrame out;
+    ASSERT_TRUE(packetizer.packetize(tu.data(), tu.size(), out));
+
+    EXPECT_FALSE(out.keyframe);
+    EXPECT_EQ(out.data(out.payloads[0])[0] & 0x08, 0);  // No N on inter frames
+    expectWithinLimit(out, 1200);
+    expectMarkerOnLastOnly(out);
+    EXPECT_EQ(out.payloads.size(), 7u);  // 7.5 kB in as few 1200 byte packets as fit
+
+    auto elements = av1Elements(out);
+    ASSERT_EQ(elements.size(), 3u);  // Padding dropped
+    EXPECT_EQ(std::vector<uint8_t>(elements[1].begin() + 1, elements[1].end()), tileGroup1);
+    EXPECT_EQ(std::vector<uint8_t>(elements[2].begin() + 1, elements[2].end()), tileGroup2);
+}
+
+/**
+ * @brief Test AV1 OBUs with extension headers and without size fields
+ */
+TEST_F(RtpPacketizerTest, Av1KeepsExtensionAndLastObuWithoutSize) {
+    // Frame OBU with extension (temporal id 1) and no size field: runs to the end
+    std::vector<uint8_t> tu = {static_cast<uint8_t>((6 << 3) | 0x04), 0x20, 0xAA, 0xBB, 0xCC};
+
+    Av1RtpPacketizer packetizer;
+    PacketizedFrame out;
+    ASSERT_TRUE(packetizer.packetize(tu.data(), tu.size(), out));
+
+    auto elements = av1Elements(out);
+    ASSERT_EQ(elements.size(), 1u);
+    EXPECT_EQ(elements[0], tu);
+}
+
+/**
+ * @brief Test that truncated AV1 temporal units are rejected
+ */
+TEST_F(RtpPacketizerTest, Av1RejectsTruncatedObu) {
+    auto tu = obu(6, randomBytes(100));
+    tu.resize(50);
+
+    Av1RtpPacketizer packetizer;
+    PacketizedFrame out;
+    EXPECT_FALSE(packetizer.packetize(tu.data(), tu.size(), out));
+
+    // Only a temporal delimiter: nothing to send
+    auto td = obu(2, {});
+    EXPECT_FALSE(packetizer.packetize(td.data(), td.size(), out));
+}
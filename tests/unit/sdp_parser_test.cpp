@@ -0,0 +1,217 @@
+/**
+ * @file sdp_parser_test.cpp
+ * @brief Unit tests for the SDP media section parser and the audio codec descriptor
+ */
+
+#include <gtest/gtest.h>
+#include "core/sdp-parser.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace obswebrtc::core;
+
+namespace {
+
+/**
+ * @brief Answer of a browser sending mono speech, video and a data channel
+ */
+const char* const kBrowserSdp =
+    "v=0\r\n"
+    "o=- 4611731400430051336 2 IN IP4 127.0.0.1\r\n"
+    "s=-\r\n"
+    "t=0 0\r\n"
+    "a=group:BUNDLE 0 1 2\r\n"
+    "a=ptime:40\r\n"
+    "m=audio 9 UDP/TLS/RTP/SAVPF 111 63 9 0 8\r\n"
+    "c=IN IP4 0.0.0.0\r\n"
+    "a=mid:0\r\n"
+    "a=sendonly\r\n"
+    "a=rtpmap:111 opus/48000/2\r\n"
+    "a=rtcp-fb:111 transport-cc\r\n"
+    "a=fmtp:111 minptime=10;useinbandfec=1;sprop-maxcapturerate=16000\r\n"
+    "a=rtpmap:63 red/48000/2\r\n"
+    "a=fmtp:63 111/111\r\n"
+    "a=rtpmap:9 G722/8000\r\n"
+    "a=ptime:20\r\n"
+    "m=video 9 UDP/TLS/RTP/SAVPF 96 97\r\n"
+    "a=mid:1\r\n"
+    "a=rtpmap:96 H264/90000\r\n"
+    "a=fmtp:96 level-asymmetry-allowed=1;packetization-mode=1;profile-level-id=42e01f\r\n"
+    "a=rtpmap:97 rtx/90000\r\n"
+    "a=fmtp:97 apt=96\r\n"
+    "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\r\n"
+    "a=mid:2\r\n";
+
+SdpMediaSection audioSection(const std::string& fmtp, const std::string& extra = "") {
+    const std::vector<SdpMediaSection> sections = parseSdpMediaSections(
+        "m=audio 9 UDP/TLS/RTP/SAVPF 111\r\n"
+        "a=rtpmap:111 opus/48000/2\r\n"
+        "a=fmtp:111 " + fmtp + "\r\n" + extra);
+    return sections.empty() ? SdpMediaSection() : sections.front();
+}
+
+}  // namespace
+
+TEST(SdpParserTest, ParsesMediaSections) {
+    const std::vector<SdpMediaSection> sections = parseSdpMediaSections(kBrowserSdp);
+    ASSERT_EQ(sections.size(), 3u);
+
+    const SdpMediaSection& audio = sections[0];
+    EXPECT_EQ(audio.type, "audio");
+    EXPECT_EQ(audio.mid, "0");
+    EXPECT_EQ(audio.ptimeMs, 20);  // The session-level ptime is not the section's
+    ASSERT_EQ(audio.codecs.size(), 5u);
+    EXPECT_EQ(audio.codecs[0].payloadType, 111);
+    EXPECT_EQ(audio.codecs[0].name, "opus");
+    EXPECT_EQ(audio.codecs[0].clockRate, 48000u);
+    EXPECT_EQ(audio.codecs[0].channels, 2u);
+    EXPECT_EQ(audio.codecs[2].name, "G722");
+    EXPECT_EQ(audio.codecs[2].clockRate, 8000u);
+    EXPECT_EQ(audio.codecs[2].channels, 1u);
+    // Static payload types without a=rtpmap keep their place, unnamed
+    EXPECT_EQ(audio.codecs[3].payloadType, 0);
+    EXPECT_TRUE(audio.codecs[3].name.empty());
+
+    const SdpCodec& opus = audio.codecs[0];
+    ASSERT_EQ(opus.parameters.size(), 3u);
+    ASSERT_NE(opus.parameter("useinbandfec"), nullptr);
+    EXPECT_EQ(*opus.parameter("useinbandfec"), "1");
+    EXPECT_EQ(*opus.parameter("sprop-maxcapturerate"), "16000");
+    EXPECT_EQ(opus.parameter("stereo"), nullptr);
+
+    const SdpMediaSection& video = sections[1];
+    EXPECT_EQ(video.type, "video");
+    ASSERT_NE(video.findCodec("h264"), nullptr);
+    EXPECT_EQ(video.findCodec("h264")->clockRate, 90000u);
+    EXPECT_EQ(*video.findCodec("H264")->parameter("profile-level-id"), "42e01f");
+    EXPECT_EQ(*video.findCodec("rtx")->parameter("apt"), "96");
+
+    EXPECT_EQ(sections[2].type, "application");
+    EXPECT_EQ(sections[2].mid, "2");
+    EXPECT_TRUE(sections[2].codecs.empty());
+}
+
+TEST(SdpParserTest, AcceptsBareLineFeedsAndSpacing) {
+    const std::vector<SdpMediaSection> sections = parseSdpMediaSections(
+        "m=audio 9 RTP/AVP 100\n"
+        "a=rtpmap:100 OPUS/48000/2\n"
+        "a=fmtp:100 Stereo=1 ; sprop-stereo = 1;;\n");
+    ASSERT_EQ(sections.size(), 1u);
+    const SdpCodec* opus = sections[0].findCodec("opus");
+    ASSERT_NE(opus, nullptr);
+    ASSERT_EQ(opus->parameters.size(), 2u);
+    EXPECT_EQ(opus->parameters[0].first, "stereo");
+    EXPECT_EQ(opus->parameters[0].second, "1");
+    EXPECT_EQ(*opus->parameter("sprop-stereo"), "1");
+}
+
+TEST(SdpParserTest, SkipsMalformedLines) {
+    const std::vector<SdpMediaSection> sections = parseSdpMediaSections(
+        "a=rtpmap:111 opus/48000/2\r\n"  // Before any m= line
+        "m=audio 9 UDP/TLS/RTP/SAVPF 111 112 abc 300\r\n"
+        "garbage\r\n"
+        "a=\r\n"
+        "a=rtpmap:\r\n"
+        "a=rtpmap:112\r\n"
+        "a=rtpmap:112 /48000\r\n"
+        "a=rtpmap:112 telephone-event/\r\n"
+        "a=rtpmap:112 telephone-event/8000/0\r\n"
+        "a=rtpmap:113 opus/48000/2\r\n"  // Not in the m= line
+        "a=rtpmap:111 opus/99999999999999999999/2\r\n"
+        "a=rtpmap:111 opus/0/2\r\n"
+        "a=fmtp:111\r\n"
+        "a=fmtp:x stereo=1\r\n"
+        "a=ptime:abc\r\n"
+        "m=\r\n");
+    ASSERT_EQ(sections.size(), 2u);
+    const SdpMediaSection& audio = sections[0];
+    ASSERT_EQ(audio.codecs.size(), 2u);
+    for (const SdpCodec& codec : audio.codecs) {
+        EXPECT_TRUE(codec.name.empty()) << codec.payloadType;
+        EXPECT_TRUE(codec.parameters.empty()) << codec.payloadType;
+    }
+    EXPECT_EQ(audio.ptimeMs, 0);
+    EXPECT_EQ(audio.findCodec("opus"), nullptr);
+    EXPECT_TRUE(parseSdpMediaSections("").empty());
+}
+
+TEST(SdpParserTest, DescribesBrowserAudio) {
+    const AudioCodecDescriptor codec = describeAudioCodec(parseSdpMediaSections(kBrowserSdp)[0]);
+    EXPECT_TRUE(codec.negotiated);
+    EXPECT_EQ(codec.payloadType, 111);
+    EXPECT_EQ(codec.clockRate, 48000u);
+    EXPECT_EQ(codec.channels, 1u);  // Neither stereo nor sprop-stereo: mono (RFC 7587)
+    EXPECT_EQ(codec.maxCaptureRate, 16000u);
+    EXPECT_TRUE(codec.inbandFec);
+    EXPECT_EQ(codec.ptimeMs, 20);
+}
+
+TEST(SdpParserTest, StereoFollowsWhatTheSenderSends) {
+    EXPECT_EQ(describeAudioCodec(audioSection("stereo=1")).channels, 2u);
+    EXPECT_EQ(describeAudioCodec(audioSection("stereo=0")).channels, 1u);
+    EXPECT_EQ(describeAudioCodec(audioSection("sprop-stereo=1")).channels, 2u);
+    // sprop-stereo describes the remote sender, stereo only what it would like to receive
+    EXPECT_EQ(describeAudioCodec(audioSection("stereo=1;sprop-stereo=0")).channels, 1u);
+    EXPECT_EQ(describeAudioCodec(audioSection("stereo=0;sprop-stereo=1")).channels, 2u);
+    // libdatachannel's default Opus profile
+    const AudioCodecDescriptor codec = describeAudioCodec(
+        audioSection("minptime=10;maxaveragebitrate=96000;stereo=1;sprop-stereo=1;useinbandfec=1"));
+    EXPECT_EQ(codec.channels, 2u);
+    EXPECT_TRUE(codec.inbandFec);
+    EXPECT_EQ(codec.maxCaptureRate, 48000u);
+}
+
+TEST(SdpParserTest, ReadsPacketDurationAndCaptureRate) {
+    EXPECT_EQ(describeAudioCodec(audioSection("ptime=60")).ptimeMs, 60);
+    EXPECT_EQ(describeAudioCodec(audioSection("ptime=60", "a=ptime:20.0\r\n")).ptimeMs, 20);
+    EXPECT_EQ(describeAudioCodec(audioSection("useinbandfec=0")).ptimeMs, 0);
+    EXPECT_FALSE(describeAudioCodec(audioSection("useinbandfec=0")).inbandFec);
+
+    EXPECT_EQ(describeAudioCodec(audioSection("sprop-maxcapturerate=8000")).maxCaptureRate,
+              8000u);
+    // Above the codec's clock rate, or unparsable: the clock rate
+    EXPECT_EQ(describeAudioCodec(audioSection("sprop-maxcapturerate=96000")).maxCaptureRate,
+              48000u);
+    EXPECT_EQ(describeAudioCodec(audioSection("sprop-maxcapturerate=high")).maxCaptureRate,
+              48000u);
+}
+
+TEST(SdpParserTest, KeepsDefaultsWithoutOpus) {
+    const std::vector<SdpMediaSection> sections = parseSdpMediaSections(
+        "m=audio 9 RTP/AVP 0 8\r\n"
+        "a=rtpmap:0 PCMU/8000\r\n");
+    ASSERT_EQ(sections.size(), 1u);
+
+    const AudioCodecDescriptor codec = describeAudioCodec(sections[0]);
+    const AudioCodecDescriptor defaults;
+    EXPECT_FALSE(codec.negotiated);
+    EXPECT_EQ(codec.payloadType, -1);
+    EXPECT_EQ(codec.clockRate, defaults.clockRate);
+    EXPECT_EQ(codec.channels, static_cast<uint32_t>(constants::kDefaultAudioChannels));
+    EXPECT_FALSE(codec.inbandFec);
+}
+
+TEST(SdpParserTest, KeepsDefaultsForZeroClockRate) {
+    const std::vector<SdpMediaSection> sections = parseSdpMediaSections(
+        "m=audio 9 UDP/TLS/RTP/SAVPF 111\r\n"
+        "a=rtpmap:111 opus/0/2\r\n");
+    ASSERT_EQ(sections.size(), 1u);
+
+    const AudioCodecDescriptor codec = describeAudioCodec(sections[0]);
+    EXPECT_FALSE(codec.negotiated);
+    EXPECT_EQ(codec.clockRate, constants::kOpusRtpClockRate);
+}
+
+TEST(SdpParserTest, PrefersFirstListedOpusPayloadType) {
+    const std::vector<SdpMediaSection> sections = parseSdpMediaSections(
+        "m=audio 9 UDP/TLS/RTP/SAVPF 109 111\r\n"
+        "a=rtpmap:111 opus/48000/2\r\n"
+        "a=fmtp:111 stereo=1\r\n"
+        "a=rtpmap:109 opus/48000/2\r\n"
+        "a=fmtp:109 stereo=0\r\n");
+    ASSERT_EQ(sections.size(), 1u);
+    const AudioCodecDescriptor codec = describeAudioCodec(sections[0]);
+    EXPECT_EQ(codec.payloadType, 109);
+    EXPECT_EQ(codec.channels, 1u);
+}
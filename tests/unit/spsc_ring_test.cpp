@@ -0,0 +1,171 @@
+/**
+ * @file spsc_ring_test.cpp
+ * @brief Unit tests for SpscRing
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/spsc-ring.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for SpscRing tests
+ */
+class SpscRingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Setup code if needed
+    }
+
+    void TearDown() override {
+        // Cleanup code if needed
+    }
+};
+
+/**
+ * @brief Test that zero capacity is rejected
+ */
+TEST_F(SpscRingTest, ZeroCapacityThrows) {
+    EXPECT_THROW({
+        SpscRing<int> ring(0);
+    }, std::invalid_argument);
+}
+
+/**
+ * @brief Test that a new ring is empty
+ */
+TEST_F(SpscRingTest, StartsEmpty) {
+    SpscRing<int> ring(4);
+
+    int value = 0;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.size(), 0u);
+    EXPECT_EQ(ring.capacity(), 4u);
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+/**
+ * @brief Test FIFO ordering
+ */
+TEST_F(SpscRingTest, PreservesOrder) {
+    SpscRing<int> ring(8);
+
+    for (int i = 0; i < 5; i++) {
+        EXPECT_TRUE(ring.tryPush(int(i)));
+    }
+    EXPECT_EQ(ring.size(), 5u);
+
+    for (int i = 0; i < 5; i++) {
+        int value = -1;
+        EXPECT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+/**
+ * @brief Test that push fails once capacity is reached
+ */
+TEST_F(SpscRingTest, PushFailsWhenFull) {
+    SpscRing<int> ring(3);
+
+    EXPECT_TRUE(ring.tryPush(1));
+    EXPECT_TRUE(ring.tryPush(2));
+    EXPECT_TRUE(ring.tryPush(3));
+    EXPECT_FALSE(ring.tryPush(4));
+    EXPECT_EQ(ring.size(), 3u);
+
+    int value = 0;
+    EXPECT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(ring.tryPush(4));
+    EXPECT_EQ(ring.size(), 3u);
+}
+
+/**
+ * @brief Test that indices wrap around correctly
+ */
+TEST_F(SpscRingTest, WrapsAround) {
+    SpscRing<int> ring(3);
+
+    for (int i = 0; i < 100; i++) {
+        int value = -1;
+        EXPECT_TRUE(ring.tryPush(int(i)));
+        EXPECT_TRUE(ring.tryPush(int(i + 1000)));
+        EXPECT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i);
+        EXPECT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(value, i + 1000);
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+/**
+ * @brief Test that a failed push leaves the item with the caller
+ */
+TEST_F(SpscRingTest, FailedPushDoesNotConsumeItem) {
+    SpscRing<std::unique_ptr<int>> ring(1);
+
+    EXPECT_TRUE(ring.tryPush(std::make_unique<int>(1)));
+
+    auto item = std::make_unique<int>(2);
+    EXPECT_FALSE(ring.tryPush(std::move(item)));
+    ASSERT_NE(item, nullptr);
+    EXPECT_EQ(*item, 2);
+}
+
+/**
+ * @brief Test that popped slots release their resources immediately
+ */
+TEST_F(SpscRingTest, PopReleasesSlot) {
+    SpscRing<std::shared_ptr<int>> ring(2);
+    auto shared = std::make_shared<int>(42);
+
+    EXPECT_TRUE(ring.tryPush(std::shared_ptr<int>(shared)));
+    EXPECT_EQ(shared.use_count(), 2);
+
+    std::shared_ptr<int> out;
+    EXPECT_TRUE(ring.tryPop(out));
+    out.reset();
+
+    // Only the local reference remains; the ring no longer holds one
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+/**
+ * @brief Test concurrent producer and consumer
+ */
+TEST_F(SpscRingTest, ConcurrentProducerConsumer) {
+    SpscRing<uint64_t> ring(64);
+    constexpr uint64_t kCount = 200000;
+
+    std::thread producer([&ring]() {
+        for (uint64_t i = 0; i < kCount; i++) {
+            while (!ring.tryPush(uint64_t(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < kCount) {
+        uint64_t value = 0;
+        if (ring.tryPop(value)) {
+            ordered = ordered && value == expected;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.empty());
+}
@@ -0,0 +1,152 @@
+/**
+ * @file task_worker_test.cpp
+ * @brief Unit tests for TaskWorker
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "core/task-worker.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace obswebrtc::core;
+using namespace testing;
+
+/**
+ * @brief Test fixture for TaskWorker tests
+ */
+class TaskWorkerTest : public ::testing::Test {
+protected:
+    /** Post a marker task and wait until everything before it has run */
+    static void drain(TaskWorker& worker) {
+        std::promise<void> done;
+        worker.post([&done]() { done.set_value(); });
+        ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    }
+};
+
+/**
+ * @brief Test that tasks run off the calling thread, in submission order
+ */
+TEST_F(TaskWorkerTest, RunsTasksInOrder) {
+    TaskWorker worker;
+    std::vector<int> order;
+    std::thread::id workerThread;
+
+    for (int i = 0; i < 100; i++) {
+        worker.post([&order, &workerThread, &worker, i]() {
+            EXPECT_TRUE(worker.isWorkerThread());
+            workerThread = std::this_thread::get_id();
+            order.push_back(i);
+        });
+    }
+    drain(worker);
+
+    ASSERT_EQ(order.size(), 100u);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+    EXPECT_NE(workerThread, std::this_thread::get_id());
+    EXPECT_FALSE(worker.isWorkerThread());
+}
+
+/**
+ * @brief Test that empty tasks are rejected
+ */
+TEST_F(TaskWorkerTest, EmptyTaskThrows) {
+    TaskWorker worker;
+    EXPECT_THROW(worker.post(TaskWorker::Task()), std::invalid_argument);
+}
+
+/**
+ * @brief Test that a throwing task does not stop the worker
+ */
+TEST_F(TaskWorkerTest, ExceptionsAreContained) {
+    TaskWorker worker;
+    std::atomic<bool> ran{false};
+
+    worker.post([]() { throw std::runtime_error("task failed"); });
+    worker.post([&ran]() { ran = true; });
+    drain(worker);
+
+    EXPECT_TRUE(ran);
+}
+
+/**
+ * @brief Test that stop() waits for the running task and drops the rest
+ */
+TEST_F(TaskWorkerTest, StopWaitsForRunningTaskAndDropsPending) {
+    TaskWorker worker;
+    std::promise<void> started;
+    std::atomic<bool> finished{false};
+    std::atomic<bool> pendingRan{false};
+
+    worker.post([&started, &finished]() {
+        started.set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    });
+    worker.post([&pendingRan]() { pendingRan = true; });
+
+    started.get_future().wait();
+    worker.stop();
+
+    EXPECT_TRUE(finished);
+    EXPECT_FALSE(pendingRan);
+
+    // The worker starts again on demand
+    drain(worker);
+    EXPECT_FALSE(pendingRan);
+}
+
+/**
+ * @brief Test that a task may stop its own worker
+ */
+TEST_F(TaskWorkerTest, StopFromInsideTask) {
+    TaskWorker worker;
+    std::promise<void> queued;
+    std::promise<void> stopped;
+    std::atomic<bool> pendingRan{false};
+
+    worker.post([&worker, &queued, &stopped]() {
+        queued.get_future().wait();
+        worker.stop();
+        stopped.set_value();
+    });
+    worker.post([&pendingRan]() { pendingRan = true; });
+    queued.set_value();
+
+    ASSERT_EQ(stopped.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    drain(worker);
+    EXPECT_FALSE(pendingRan);
+
+    worker.stop();
+}
+
+/**
+ * @brief Test that the destructor finishes the running task and drops the rest
+ */
+TEST_F(TaskWorkerTest, DestructorStops) {
+    std::atomic<int> ran{0};
+    {
+        TaskWorker worker;
+        std::promise<void> started;
+
+        worker.post([&started, &ran]() {
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            ran++;
+        });
+        for (int i = 0; i < 10; i++) {
+            worker.post([&ran]() { ran++; });
+        }
+        started.get_future().wait();
+    }
+    EXPECT_EQ(ran.load(), 1);
+}
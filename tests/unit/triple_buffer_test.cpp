@@ -0,0 +1,166 @@
+/**
+ * @file triple_buffer_test.cpp
+ * @brief Unit tests for TripleBuffer
+ */
+
+#include <gtest/gtest.h>
+#include "core/triple-buffer.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace obswebrtc::core;
+
+/**
+ * @brief Test that nothing is consumed before the first publish
+ */
+TEST(TripleBufferTest, StartsEmpty) {
+    TripleBuffer<int> buffer;
+
+    EXPECT_FALSE(buffer.consume());
+    EXPECT_EQ(buffer.readSlot(), 0);
+
+    const TripleBufferStats stats = buffer.getStats();
+    EXPECT_EQ(stats.published, 0u);
+    EXPECT_EQ(stats.consumed, 0u);
+    EXPECT_EQ(stats.overwritten, 0u);
+}
+
+/**
+ * @brief Test that a published value is consumed exactly once
+ */
+TEST(TripleBufferTest, HandsOverPublishedValue) {
+    TripleBuffer<int> buffer;
+
+    buffer.writeSlot() = 7;
+    EXPECT_FALSE(buffer.publish());
+
+    ASSERT_TRUE(buffer.consume());
+    EXPECT_EQ(buffer.readSlot(), 7);
+
+    // Nothing new: the read slot keeps the value
+    EXPECT_FALSE(buffer.consume());
+    EXPECT_EQ(buffer.readSlot(), 7);
+}
+
+/**
+ * @brief Test that only the newest of several published values is delivered
+ */
+TEST(TripleBufferTest, NewestValueWins) {
+    TripleBuffer<int> buffer;
+
+    for (int value = 1; value <= 5; value++) {
+        buffer.writeSlot() = value;
+        EXPECT_EQ(buffer.publish(), value > 1);  // Each replaces the untaken one before
+    }
+
+    ASSERT_TRUE(buffer.consume());
+    EXPECT_EQ(buffer.readSlot(), 5);
+    EXPECT_FALSE(buffer.consume());
+
+    const TripleBufferStats stats = buffer.getStats();
+    EXPECT_EQ(stats.published, 5u);
+    EXPECT_EQ(stats.consumed, 1u);
+    EXPECT_EQ(stats.overwritten, 4u);
+}
+
+/**
+ * @brief Test that the writer never writes into the slot the reader holds
+ */
+TEST(TripleBufferTest, WriterNeverTouchesReadSlot) {
+    TripleBuffer<int> buffer;
+
+    buffer.writeSlot() = 1;
+    buffer.publish();
+    ASSERT_TRUE(buffer.consume());
+    const int* held = &buffer.readSlot();
+
+    for (int value = 2; value < 10; value++) {
+        EXPECT_NE(&buffer.writeSlot(), held);
+        buffer.writeSlot() = value;
+        buffer.publish();
+    }
+    EXPECT_EQ(*held, 1);
+
+    ASSERT_TRUE(buffer.consume());
+    EXPECT_EQ(buffer.readSlot(), 9);
+}
+
+/**
+ * @brief Test that slots are reused without being reset
+ */
+TEST(TripleBufferTest, KeepsSlotAllocations) {
+    TripleBuffer<std::vector<int>> buffer;
+
+    // Fill all three slots once
+    for (int round = 0; round < 3; round++) {
+        buffer.writeSlot().assign(1000, round);
+        buffer.publish();
+        ASSERT_TRUE(buffer.consume());
+    }
+
+    // From now on every slot handed to the writer has kept its capacity
+    for (int round = 0; round < 6; round++) {
+        std::vector<int>& slot = buffer.writeSlot();
+        EXPECT_GE(slot.capacity(), 1000u);
+        slot.assign(1000, round);
+        buffer.publish();
+        if (round % 2 == 0) {
+            ASSERT_TRUE(buffer.consume());
+            EXPECT_EQ(buffer.readSlot().front(), round);
+        }
+    }
+}
+
+/**
+ * @brief Test a writer and a reader running at different rates
+ *
+ * Each value is a run of identical words, so a torn read would show up as a
+ * mixed run; the reader must also never see a value go backwards.
+ */
+TEST(TripleBufferTest, ConcurrentWriterAndReader) {
+    constexpr uint64_t kCount = 100000;
+    constexpr size_t kWords = 64;
+    TripleBuffer<std::vector<uint64_t>> buffer;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&]() {
+        for (uint64_t value = 1; value <= kCount; value++) {
+            buffer.writeSlot().assign(kWords, value);
+            buffer.publish();
+        }
+        done = true;
+    });
+
+    uint64_t last = 0;
+    uint64_t taken = 0;
+    bool intact = true;
+    bool ordered = true;
+    while (true) {
+        const bool finished = done;
+        if (buffer.consume()) {
+            const std::vector<uint64_t>& value = buffer.readSlot();
+            for (uint64_t word : value) {
+                intact = intact && word == value.front();
+            }
+            ordered = ordered && value.front() > last;
+            last = value.front();
+            taken++;
+        } else if (finished) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    writer.join();
+
+    EXPECT_TRUE(intact);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(last, kCount);  // The final value is always delivered
+
+    const TripleBufferStats stats = buffer.getStats();
+    EXPECT_EQ(stats.published, kCount);
+    EXPECT_EQ(stats.consumed, taken);
+    EXPECT_EQ(stats.consumed + stats.overwritten, kCount);
+}
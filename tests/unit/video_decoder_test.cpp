@@ -0,0 +1,317 @@
+/**
+ * @file video_decoder_test.cpp
+ * @brief Unit tests for the FFmpeg video decoding stage
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "source/video-decoder.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace obswebrtc::source;
+using namespace testing;
+
+namespace {
+
+/**
+ * @brief Minimal RBSP writer for hand-built H.264 NAL units
+ */
+class BitWriter {
+public:
+    void bits(uint32_t value, int count) {
+        for (int i = count - 1; i >= 0; i--) {
+            bit((value >> i) & 1);
+        }
+    }
+
+    void ue(uint32_t value) {
+        const uint32_t coded = value + 1;
+        int length = 0;
+        while ((coded >> length) > 1) {
+            length++;
+        }
+        bits(0, length);
+        bits(coded, length + 1);
+    }
+
+    void se(int32_t value) { ue(value > 0 ? 2 * value - 1 : -2 * value); }
+
+    void align() {
+        while (used_ != 0) {
+            bit(0);
+        }
+    }
+
+    void byte(uint8_t value) { bits(value, 8); }
+
+    /** rbsp_trailing_bits(), then the NAL unit with emulation prevention */
+    std::vector<uint8_t> finish(uint8_t header) {
+        bit(1);
+        align();
+        std::vector<uint8_t> nal = {header};
+        int zeros = 0;
+        for (uint8_t value : rbsp_) {
+            if (zeros >= 2 && value <= 3) {
+                nal.push_back(0x03);
+                zeros = 0;
+            }
+            nal.push_back(value);
+            zeros = value == 0 ? zeros + 1 : 0;
+        }
+        return nal;
+    }
+
+private:
+    void bit(uint32_t value) {
+        current_ = static_cast<uint8_t>((current_ << 1) | value);
+        if (++used_ == 8) {
+            rbsp_.push_back(current_);
+            current_ = 0;
+            used_ = 0;
+        }
+    }
+
+    std::vector<uint8_t> rbsp_;
+    uint8_t current_ = 0;
+    int used_ = 0;
+};
+
+constexpr uint8_t kLuma = 200;
+constexpr uint8_t kCb = 100;
+constexpr uint8_t kCr = 150;
+
+/**
+ * @brief One 16x16 Baseline IDR whose only macroblock is I_PCM (lossless)
+ */
+std::vector<uint8_t> pcmAccessUnit(uint32_t idrPicId) {
+    BitWriter sps;
+    sps.byte(66);  // profile_idc: Baseline
+    sps.byte(0xC0);  // constraint_set0/1
+    sps.byte(10);  // level_idc
+    sps.ue(0);  // seq_parameter_set_id
+    sps.ue(0);  // log2_max_frame_num_minus4
+    sps.ue(2);  // pic_order_cnt_type
+    sps.ue(1);  // max_num_ref_frames
+    sps.bits(0, 1);  // gaps_in_frame_num_value_allowed_flag
+    sps.ue(0);  // pic_width_in_mbs_minus1
+    sps.ue(0);  // pic_height_in_map_units_minus1
+    sps.bits(1, 1);  // frame_mbs_only_flag
+    sps.bits(1, 1);  // direct_8x8_inference_flag
+    sps.bits(0, 1);  // frame_cropping_flag
+    sps.bits(0, 1);  // vui_parameters_present_flag
+
+    BitWriter pps;
+    pps.ue(0);  // pic_parameter_set_id
+    pps.ue(0);  // seq_parameter_set_id
+    pps.bits(0, 1);  // entropy_coding_mode_flag: CAVLC
+    pps.bits(0, 1);  // bottom_field_pic_order_in_frame_present_flag
+    pps.ue(0);  // num_slice_groups_minus1
+    pps.ue(0);  // num_ref_idx_l0_default_active_minus1
+    pps.ue(0);  // num_ref_idx_l1_default_active_minus1
+    pps.bits(0, 1);  // weighted_pred_flag
+    pps.bits(0, 2);  // weighted_bipred_idc
+    pps.se(0);  // pic_init_qp_minus26
+    pps.se(0);  // pic_init_qs_minus26
+    pps.se(0);  // chroma_qp_index_offset
+    pps.bits(1, 1);  // deblocking_filter_control_present_flag
+    pps.bits(0, 1);  // constrained_intra_pred_flag
+    pps.bits(0, 1);  // redundant_pic_cnt_present_flag
+
+    BitWriter slice;
+    slice.ue(0);  // first_mb_in_slice
+    slice.ue(7);  // slice_type: I
+    slice.ue(0);  // pic_parameter_set_id
+    slice.bits(0, 4);  // frame_num
+    slice.ue(idrPicId);  // idr_pic_id
+    slice.bits(0, 1);  // no_output_of_prior_pics_flag
+    slice.bits(0, 1);  // long_term_reference_flag
+    slice.se(0);  // slice_qp_delta
+    slice.ue(1);  // disable_deblocking_filter_idc
+    slice.ue(25);  // mb_type: I_PCM
+    slice.align();  // pcm_alignment_zero_bit
+    for (int i = 0; i < 256; i++) {
+        slice.byte(kLuma);
+    }
+    for (int i = 0; i < 64; i++) {
+        slice.byte(kCb);
+    }
+    for (int i = 0; i < 64; i++) {
+        slice.byte(kCr);
+    }
+
+    std::vector<uint8_t> accessUnit;
+    for (const auto& nal : {sps.finish(0x67), pps.finish(0x68), slice.finish(0x65)}) {
+        accessUnit.insert(accessUnit.end(), {0, 0, 0, 1});
+        accessUnit.insert(accessUnit.end(), nal.begin(), nal.end());
+    }
+    return accessUnit;
+}
+
+VideoFrame videoFrame(const std::vector<uint8_t>& accessUnit, uint32_t rtpTimestamp) {
+    VideoFrame frame;
+    frame.data = obswebrtc::core::BufferSlice::copyOf(accessUnit.data(), accessUnit.size());
+    frame.width = 0;
+    frame.height = 0;
+    frame.timestamp = rtpTimestamp;
+    frame.keyframe = true;
+    return frame;
+}
+
+}  // namespace
+
+/**
+ * @brief Test fixture for VideoDecoder tests
+ */
+class VideoDecoderTest : public ::testing::Test {
+protected:
+    struct Picture {
+        uint32_t width;
+        uint32_t height;
+        DecodedPixelFormat format;
+        uint8_t y;
+        uint8_t u;
+        uint8_t v;
+        uint64_t timestampNs;
+    };
+
+    VideoDecoderConfig config() {
+        VideoDecoderConfig config;
+        config.codec = VideoCodec::H264;
+        config.frameCallback = [this](const DecodedVideoFrame& decoded) {
+            Picture picture = {decoded.width, decoded.height, decoded.format,
+                               decoded.planes[0][0], decoded.planes[1][0],
+                               decoded.planes[2] ? decoded.planes[2][0] : uint8_t(0),
+                               decoded.timestampNs};
+            std::lock_guard<std::mutex> lock(mutex_);
+            pictures_.push_back(picture);
+            condition_.notify_all();
+        };
+        return config;
+    }
+
+    bool waitForPictures(size_t count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return condition_.wait_for(lock, std::chrono::seconds(5),
+                                   [this, count]() { return pictures_.size() >= count; });
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::vector<Picture> pictures_;
+};
+
+/**
+ * @brief Test that invalid configurations are rejected
+ */
+TEST_F(VideoDecoderTest, RejectsInvalidConfig) {
+    VideoDecoderConfig missingCallback;
+    EXPECT_THROW(VideoDecoder decoder(missingCallback), std::invalid_argument);
+
+    VideoDecoderConfig emptyQueue = config();
+    emptyQueue.queueFrames = 0;
+    EXPECT_THROW(VideoDecoder decoder(emptyQueue), std::invalid_argument);
+}
+
+/**
+ * @brief Test that an access unit decodes to the expected I420 picture
+ */
+TEST_F(VideoDecoderTest, DecodesAccessUnitToI420) {
+    VideoDecoder decoder(config());
+    decoder.decode(videoFrame(pcmAccessUnit(0), 90000));
+    ASSERT_TRUE(waitForPictures(1));
+
+    const Picture picture = pictures_[0];
+    EXPECT_EQ(picture.width, 16u);
+    EXPECT_EQ(picture.height, 16u);
+    EXPECT_EQ(picture.format, DecodedPixelFormat::I420);
+    EXPECT_EQ(picture.y, kLuma);
+    EXPECT_EQ(picture.u, kCb);
+    EXPECT_EQ(picture.v, kCr);
+    EXPECT_EQ(picture.timestampNs, 1000000000u);
+
+    VideoDecoderStats stats = decoder.getStats();
+    EXPECT_EQ(stats.framesDecoded, 1u);
+    EXPECT_EQ(stats.decodeErrors, 0u);
+    EXPECT_GE(stats.averageDecodeMs, 0.0);
+    EXPECT_GE(stats.maxDecodeMs, stats.lastDecodeMs);
+    EXPECT_EQ(stats.queue.pushed, 1u);
+}
+
+/**
+ * @brief Test that RTP timestamps keep increasing across a wrap
+ */
+TEST_F(VideoDecoderTest, UnwrapsRtpTimestamps) {
+    VideoDecoder decoder(config());
+    decoder.decode(videoFrame(pcmAccessUnit(0), 0xFFFFFFFFu - 2999));
+    decoder.decode(videoFrame(pcmAccessUnit(1), 0));
+    ASSERT_TRUE(waitForPictures(2));
+
+    // 3000 ticks at 90 kHz
+    EXPECT_EQ(pictures_[1].timestampNs - pictures_[0].timestampNs, 33333333u);
+}
+
+/**
+ * @brief Test that the decoder keeps working after a reset
+ */
+TEST_F(VideoDecoderTest, DecodesAfterReset) {
+    VideoDecoder decoder(config());
+    decoder.decode(videoFrame(pcmAccessUnit(0), 0));
+    ASSERT_TRUE(waitForPictures(1));
+
+    decoder.reset();
+    decoder.decode(videoFrame(pcmAccessUnit(1), 3000));
+    ASSERT_TRUE(waitForPictures(2));
+    EXPECT_EQ(pictures_[1].y, kLuma);
+    EXPECT_EQ(decoder.getStats().framesDecoded, 2u);
+}
+
+/**
+ * @brief Test that frames skipped after a lost reference frame ask for a keyframe
+ */
+TEST_F(VideoDecoderTest, RequestsKeyframeWhileSkippingToNextKeyframe) {
+    std::mutex gateMutex;
+    std::condition_variable gateCondition;
+    bool decoding = false;
+    bool released = false;
+
+    VideoDecoderConfig decoderConfig = config();
+    decoderConfig.queueFrames = 1;
+    decoderConfig.frameCallback = [&](const DecodedVideoFrame&) {
+        // Hold the decoder thread so the queue fills up behind it
+        std::unique_lock<std::mutex> lock(gateMutex);
+        decoding = true;
+        gateCondition.notify_all();
+        gateCondition.wait(lock, [&]() { return released; });
+    };
+    std::atomic<int> keyframeRequests{0};
+    decoderConfig.keyframeRequestCallback = [&keyframeRequests]() { keyframeRequests++; };
+
+    VideoDecoder decoder(decoderConfig);
+    decoder.decode(videoFrame(pcmAccessUnit(0), 0));
+    {
+        std::unique_lock<std::mutex> lock(gateMutex);
+        ASSERT_TRUE(gateCondition.wait_for(lock, std::chrono::seconds(5),
+                                           [&]() { return decoding; }));
+    }
+
+    // Non-IDR reference slices (nal_ref_idc 2, type 1)
+    const std::vector<uint8_t> pSlice = {0x00, 0x00, 0x00, 0x01, 0x41, 0x9A, 0x00, 0x10};
+    decoder.decode(videoFrame(pSlice, 3000));  // Fills the queue
+    EXPECT_EQ(keyframeRequests, 0);
+    decoder.decode(videoFrame(pSlice, 6000));  // Lost reference frame
+    EXPECT_EQ(keyframeRequests, 1);
+    decoder.decode(videoFrame(pSlice, 9000));  // Skipped until the next keyframe
+    EXPECT_EQ(keyframeRequests, 2);
+
+    {
+        std::lock_guard<std::mutex> lock(gateMutex);
+        released = true;
+    }
+    gateCondition.notify_all();
+}
@@ -199,3 +199,316 @@ TEST_F(WebRTCOutputTest, CannotStartTwice) {
 
     output.stop();
 }
+
+/**
+ * @brief Test that a refcounted payload view takes precedence over owned data
+ */
+TEST_F(WebRTCOutputTest, EncodedPacketPayloadViewTakesPrecedence) {
+    auto storage = std::make_shared<std::vector<uint8_t>>(4096, 0xAB);
+    bool released = false;
+
+    {
+        EncodedPacket packet;
+        packet.type = PacketType::Video;
+        packet.timestamp = 0;
+        packet.keyframe = true;
+
+        EXPECT_EQ(packet.payloadSize(), 0u);
+
+        // Custom deleter stands in for obs_encoder_packet_release()
+        packet.buffer = std::shared_ptr<const uint8_t>(
+            storage->data(), [storage, &released](const uint8_t*) { released = true; });
+        packet.bufferSize = storage->size();
+
+        EXPECT_EQ(packet.payload(), storage->data());
+        EXPECT_EQ(packet.payloadSize(), 4096u);
+
+        // Copying the packet shares the view instead of copying the payload
+        EncodedPacket copy = packet;
+        EXPECT_EQ(copy.payload(), storage->data());
+        EXPECT_FALSE(released);
+    }
+
+    EXPECT_TRUE(released);
+}
+
+/**
+ * @brief Test that statistics start empty
+ */
+TEST_F(WebRTCOutputTest, StatisticsStartEmpty) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+
+    WebRTCOutput output(config);
+
+    auto stats = output.getStatistics();
+    EXPECT_EQ(stats.framesSent, 0u);
+    EXPECT_EQ(stats.payloadCopies, 0u);
+    EXPECT_EQ(stats.payloadBytesCopied, 0u);
+}
+
+/**
+ * @brief Test that a zero-depth send queue is rejected
+ */
+TEST_F(WebRTCOutputTest, ZeroSendQueueDepthThrows) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.sendQueueDepth = 0;
+
+    EXPECT_THROW({
+        WebRTCOutput output(config);
+    }, std::runtime_error);
+}
+
+/**
+ * @brief Test that the send queue starts empty
+ */
+TEST_F(WebRTCOutputTest, SendQueueStartsEmpty) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.sendQueueDepth = 16;
+    config.overflowPolicy = SendQueueOverflowPolicy::SignalCongestion;
+
+    WebRTCOutput output(config);
+
+    EXPECT_EQ(output.getQueuedPacketCount(), 0u);
+}
+
+/**
+ * @brief Test that moved-in packets are rejected while inactive
+ */
+TEST_F(WebRTCOutputTest, MovedPacketThrowsWhenInactive) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+
+    WebRTCOutput output(config);
+
+    EncodedPacket packet;
+    packet.type = PacketType::Video;
+    packet.data = std::vector<uint8_t>(1024, 0x00);
+    packet.timestamp = 0;
+    packet.keyframe = true;
+
+    EXPECT_THROW({
+        output.sendPacket(std::move(packet));
+    }, std::runtime_error);
+    EXPECT_EQ(output.getQueuedPacketCount(), 0u);
+}
+
+/**
+ * @brief Test that a non-positive video bitrate is rejected
+ */
+TEST_F(WebRTCOutputTest, InvalidVideoBitrateThrows) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.videoBitrate = 0;
+
+    EXPECT_THROW({
+        WebRTCOutput output(config);
+    }, std::runtime_error);
+}
+
+/**
+ * @brief Test that pacing can be disabled and bitrate changes still apply
+ */
+TEST_F(WebRTCOutputTest, PacingCanBeDisabled) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.enablePacing = false;
+
+    WebRTCOutput output(config);
+    output.setVideoBitrate(4000);
+
+    EXPECT_EQ(output.getVideoBitrate(), 4000);
+}
+
+/**
+ * @brief Test that a non-positive minimum video bitrate is rejected
+ */
+TEST_F(WebRTCOutputTest, InvalidMinVideoBitrateThrows) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.enableAdaptiveBitrate = true;
+    config.minVideoBitrate = 0;
+
+    EXPECT_THROW({
+        WebRTCOutput output(config);
+    }, std::runtime_error);
+}
+
+/**
+ * @brief Test that adaptive bitrate can be disabled
+ */
+TEST_F(WebRTCOutputTest, AdaptiveBitrateCanBeDisabled) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.enableAdaptiveBitrate = false;
+    config.minVideoBitrate = 0;  // Ignored when disabled
+
+    WebRTCOutput output(config);
+    EXPECT_EQ(output.getVideoBitrate(), 2500);
+}
+
+/**
+ * @brief Test that a fan-out output can be constructed for several endpoints
+ */
+TEST_F(WebRTCOutputTest, CanConstructWithAdditionalServerUrls) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.additionalServerUrls = {"http://localhost:8081/whip", "http://localhost:8082/whip"};
+
+    WebRTCOutput output(config);
+    EXPECT_FALSE(output.isActive());
+}
+
+/**
+ * @brief Test that H.264 extradata is accepted, usable or not
+ */
+TEST_F(WebRTCOutputTest, CanConstructWithVideoExtraData) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.videoExtraData = {0, 0, 0, 1, 0x67, 0x42, 0x00, 0x1F, 0, 0, 0, 1, 0x68, 0xCE, 0x38};
+
+    EXPECT_NO_THROW({
+        WebRTCOutput output(config);
+    });
+
+    // Fan-out packetizes once, with the same parameter sets
+    config.additionalServerUrls = {"http://localhost:8081/whip"};
+    EXPECT_NO_THROW({
+        WebRTCOutput output(config);
+    });
+
+    // Without SPS/PPS only in-band parameter sets are repeated
+    config.videoExtraData = {0x01, 0x02};
+    EXPECT_NO_THROW({
+        WebRTCOutput output(config);
+    });
+}
+
+/**
+ * @brief Test that empty or duplicate fan-out URLs are rejected
+ */
+TEST_F(WebRTCOutputTest, InvalidAdditionalServerUrlThrows) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+
+    config.additionalServerUrls = {""};
+    EXPECT_THROW({
+        WebRTCOutput output(config);
+    }, std::runtime_error);
+
+    config.additionalServerUrls = {"http://localhost:8080/whip"};
+    EXPECT_THROW({
+        WebRTCOutput output(config);
+    }, std::runtime_error);
+}
+
+/**
+ * @brief Test that a negative keyframe request interval is rejected
+ */
+TEST_F(WebRTCOutputTest, InvalidKeyframeRequestIntervalThrows) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.keyframeRequestCallback = []() { return true; };
+    config.minKeyframeRequestIntervalMs = -1;
+
+    EXPECT_THROW({
+        WebRTCOutput output(config);
+    }, std::runtime_error);
+
+    config.keyframeRequestCallback = nullptr;  // Ignored without a callback
+    WebRTCOutput output(config);
+    EXPECT_EQ(output.getStatistics().keyframeRequestsReceived, 0u);
+}
+
+/**
+ * @brief Test that a non-positive retransmission history is rejected
+ */
+TEST_F(WebRTCOutputTest, InvalidRtxHistoryThrows) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.rtxHistoryMs = 0;
+
+    EXPECT_THROW({
+        WebRTCOutput output(config);
+    }, std::runtime_error);
+
+    config.enableRtx = false;  // Ignored when disabled
+    WebRTCOutput output(config);
+    EXPECT_EQ(output.getStatistics().retransmissionHits, 0u);
+}
+
+/**
+ * @brief Test that FEC protection ratios outside 0 <= base <= max <= 1 are rejected
+ */
+TEST_F(WebRTCOutputTest, InvalidFecRatioThrows) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.enableFec = true;
+
+    config.fecProtectionRatio = -0.1;
+    EXPECT_THROW({ WebRTCOutput output(config); }, std::runtime_error);
+
+    config.fecProtectionRatio = 0.3;
+    config.maxFecProtectionRatio = 0.2;
+    EXPECT_THROW({ WebRTCOutput output(config); }, std::runtime_error);
+
+    config.maxFecProtectionRatio = 1.5;
+    EXPECT_THROW({ WebRTCOutput output(config); }, std::runtime_error);
+
+    config.maxFecProtectionRatio = 0.5;
+    WebRTCOutput output(config);
+    EXPECT_EQ(output.getStatistics().fecPacketsSent, 0u);
+}
+
+/**
+ * @brief Test that frame drop thresholds are validated under DropNonKeyframes
+ */
+TEST_F(WebRTCOutputTest, InvalidFrameDropThresholdsThrows) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+    config.overflowPolicy = SendQueueOverflowPolicy::DropNonKeyframes;
+
+    config.nonReferenceDropThreshold = 0.0;
+    EXPECT_THROW({ WebRTCOutput output(config); }, std::runtime_error);
+
+    config.nonReferenceDropThreshold = 0.6;
+    config.gopDropThreshold = 0.5;
+    EXPECT_THROW({ WebRTCOutput output(config); }, std::runtime_error);
+
+    config.nonReferenceDropThreshold = 0.25;
+    config.gopDropThreshold = 1.5;
+    EXPECT_THROW({ WebRTCOutput output(config); }, std::runtime_error);
+
+    // Only the dropping policy uses the thresholds
+    config.overflowPolicy = SendQueueOverflowPolicy::SignalCongestion;
+    EXPECT_NO_THROW({ WebRTCOutput output(config); });
+
+    config.overflowPolicy = SendQueueOverflowPolicy::DropNonKeyframes;
+    config.gopDropThreshold = 0.5;
+    WebRTCOutput output(config);
+    EXPECT_EQ(output.getStatistics().framesDropped, 0u);
+}
+
+/**
+ * @brief Test that the pacing batch interval is validated
+ */
+TEST_F(WebRTCOutputTest, InvalidPacingBatchIntervalThrows) {
+    WebRTCOutputConfig config;
+    config.serverUrl = "http://localhost:8080/whip";
+
+    config.pacingBatchIntervalMs = -1;
+    EXPECT_THROW({ WebRTCOutput output(config); }, std::runtime_error);
+
+    config.pacingBatchIntervalMs = 100;
+    EXPECT_THROW({ WebRTCOutput output(config); }, std::runtime_error);
+
+    // Ignored without pacing
+    config.enablePacing = false;
+    EXPECT_NO_THROW({ WebRTCOutput output(config); });
+
+    config.enablePacing = true;
+    config.pacingBatchIntervalMs = 0;
+    EXPECT_NO_THROW({ WebRTCOutput output(config); });
+}
@@ -4,9 +4,11 @@
  */
 
 #include "core/whep-client.hpp"
+#include "core/http-client.hpp"
 #include "core/peer-connection.hpp"
 
 #include <chrono>
+#include <future>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <thread>
@@ -14,6 +16,33 @@
 using namespace obswebrtc::core;
 using namespace testing;
 
+/**
+ * @brief Fake WHEP server answering after a 20 ms round trip, installed while in scope
+ */
+class SlowServer {
+public:
+    SlowServer() {
+        HTTPClient::setTransport([](const std::string& method, const std::string& url,
+                                    const HTTPRequest&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            HTTPResponse response;
+            if (method == "POST") {
+                response.statusCode = 201;
+                response.headers["Location"] = url + "/resource/123";
+                response.headers["Content-Type"] = "application/sdp";
+                response.body = "v=0\r\no=- 789 012 IN IP4 0.0.0.0\r\n";
+            } else {
+                response.statusCode = method == "PATCH" ? 204 : 200;
+            }
+            return response;
+        });
+    }
+
+    ~SlowServer() {
+        HTTPClient::setTransport(nullptr);
+    }
+};
+
 class WHEPClientTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -470,3 +499,42 @@ TEST_F(WHEPClientTest, ConnectInitiatesWebRTCConnection) {
     // connect() should create an offer and send it to WHEP server
     EXPECT_NO_THROW({ client->connect(); });
 }
+
+/**
+ * @brief Test that sendOfferAsync returns at once and delivers the answer
+ */
+TEST_F(WHEPClientTest, SendOfferAsync) {
+    SlowServer server;
+    auto client = std::make_unique<WHEPClient>(config_);
+
+    const std::string testOffer = "v=0\r\no=- 123 456 IN IP4 0.0.0.0\r\n";
+    std::string continuationAnswer;
+
+    auto answer = client->sendOfferAsync(testOffer, [&](const std::string& sdp) {
+        continuationAnswer = sdp;
+    });
+    EXPECT_NE(answer.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+
+    // Queued behind the offer and trickled once the resource URL is known
+    EXPECT_NO_THROW(client->sendIceCandidateAsync(
+        "candidate:1 1 UDP 2130706431 192.168.1.1 54321 typ host", "0"));
+
+    const std::string receivedAnswer = answer.get();
+    EXPECT_FALSE(receivedAnswer.empty());
+    EXPECT_EQ(continuationAnswer, receivedAnswer);
+    EXPECT_TRUE(client->isConnected());
+}
+
+/**
+ * @brief Test that asynchronous failures reach both the future and onError
+ */
+TEST_F(WHEPClientTest, SendOfferAsyncFailure) {
+    config_.url = "https://sfu.example.com/error-endpoint";
+    auto client = std::make_unique<WHEPClient>(config_);
+
+    const std::string testOffer = "v=0\r\no=- 123 456 IN IP4 0.0.0.0\r\n";
+    EXPECT_THROW(client->sendOfferAsync(testOffer).get(), std::runtime_error);
+    EXPECT_NE(lastError_.find("500"), std::string::npos);
+    EXPECT_FALSE(client->isConnected());
+    EXPECT_THROW({ client->sendOfferAsync(""); }, std::invalid_argument);
+}
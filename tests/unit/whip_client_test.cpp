@@ -4,8 +4,10 @@
  */
 
 #include "core/whip-client.hpp"
+#include "core/http-client.hpp"
 
 #include <chrono>
+#include <future>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <thread>
@@ -25,6 +27,33 @@ public:
     MOCK_METHOD(HTTPResponse, del, (const std::string& url, const HTTPRequest& request), ());
 };
 
+/**
+ * @brief Fake WHIP server answering after a 20 ms round trip, installed while in scope
+ */
+class SlowServer {
+public:
+    SlowServer() {
+        HTTPClient::setTransport([](const std::string& method, const std::string& url,
+                                    const HTTPRequest&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            HTTPResponse response;
+            if (method == "POST") {
+                response.statusCode = 201;
+                response.headers["Location"] = url + "/resource/123";
+                response.headers["Content-Type"] = "application/sdp";
+                response.body = "v=0\r\no=- 789 012 IN IP4 0.0.0.0\r\n";
+            } else {
+                response.statusCode = method == "PATCH" ? 204 : 200;
+            }
+            return response;
+        });
+    }
+
+    ~SlowServer() {
+        HTTPClient::setTransport(nullptr);
+    }
+};
+
 class WHIPClientTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -612,3 +641,112 @@ TEST_F(WHIPClientTest, VerifyBearerTokenFormat) {
     // Should properly format Authorization: Bearer <token>
     EXPECT_NO_THROW({ client->sendOffer(testOffer); });
 }
+
+/**
+ * @brief Test that sendOfferAsync returns at once and delivers the answer
+ */
+TEST_F(WHIPClientTest, SendOfferAsync) {
+    SlowServer server;
+    auto client = std::make_unique<WHIPClient>(config_);
+
+    const std::string testOffer = "v=0\r\no=- 123 456 IN IP4 0.0.0.0\r\n";
+    std::string continuationAnswer;
+    std::thread::id continuationThread;
+
+    auto answer = client->sendOfferAsync(testOffer, [&](const std::string& sdp) {
+        continuationAnswer = sdp;
+        continuationThread = std::this_thread::get_id();
+    });
+
+    // The server takes 20 ms to answer; the call must not wait
+    EXPECT_NE(answer.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+
+    const std::string receivedAnswer = answer.get();
+    EXPECT_FALSE(receivedAnswer.empty());
+    EXPECT_EQ(continuationAnswer, receivedAnswer);
+    EXPECT_NE(continuationThread, std::this_thread::get_id());
+    EXPECT_TRUE(client->isConnected());
+    EXPECT_TRUE(connected_);
+}
+
+/**
+ * @brief Test that sendOfferAsync validates the SDP up front
+ */
+TEST_F(WHIPClientTest, SendOfferAsyncWithInvalidSDP) {
+    auto client = std::make_unique<WHIPClient>(config_);
+
+    EXPECT_THROW({ client->sendOfferAsync(""); }, std::invalid_argument);
+    EXPECT_THROW({ client->sendIceCandidateAsync("", "0"); }, std::invalid_argument);
+}
+
+/**
+ * @brief Test that asynchronous failures reach both the future and onError
+ */
+TEST_F(WHIPClientTest, SendOfferAsyncFailure) {
+    config_.url = "https://192.0.2.1/whip";
+    auto client = std::make_unique<WHIPClient>(config_);
+
+    const std::string testOffer = "v=0\r\no=- 123 456 IN IP4 0.0.0.0\r\n";
+    bool continuationCalled = false;
+    auto answer = client->sendOfferAsync(testOffer, [&](const std::string&) {
+        continuationCalled = true;
+    });
+
+    // Candidates queued behind a failed offer are dropped quietly
+    client->sendIceCandidateAsync("candidate:1 1 UDP 2130706431 192.168.1.1 54321 typ host", "0");
+
+    EXPECT_THROW(answer.get(), std::runtime_error);
+    EXPECT_FALSE(continuationCalled);
+    EXPECT_NE(lastError_.find("Network timeout"), std::string::npos);
+
+    client->disconnect();
+    EXPECT_NE(lastError_.find("Network timeout"), std::string::npos);
+    EXPECT_FALSE(client->isConnected());
+}
+
+/**
+ * @brief Test that candidates queued during the POST are trickled after it
+ */
+TEST_F(WHIPClientTest, IceCandidatesQueuedBehindOffer) {
+    SlowServer server;
+    auto client = std::make_unique<WHIPClient>(config_);
+
+    const std::string testOffer = "v=0\r\no=- 123 456 IN IP4 0.0.0.0\r\n";
+    auto answer = client->sendOfferAsync(testOffer);
+
+    // Not connected yet: the synchronous call would fail, the queued one waits
+    EXPECT_THROW(client->sendIceCandidate("candidate:1 1 UDP 2130706431 192.168.1.1 54321 typ host", "0"),
+                 std::runtime_error);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_NO_THROW(client->sendIceCandidateAsync(
+            "candidate:" + std::to_string(i) + " 1 UDP 2130706431 192.168.1.1 54321 typ host", "0"));
+    }
+
+    answer.get();
+    EXPECT_TRUE(client->isConnected());
+
+    // A later offer runs after the candidates, so its answer proves they went out
+    client->sendOfferAsync(testOffer).get();
+    EXPECT_TRUE(lastError_.empty());
+}
+
+/**
+ * @brief Test that disconnect waits for an offer in flight
+ */
+TEST_F(WHIPClientTest, DisconnectDuringAsyncOffer) {
+    SlowServer server;
+    auto client = std::make_unique<WHIPClient>(config_);
+
+    const std::string testOffer = "v=0\r\no=- 123 456 IN IP4 0.0.0.0\r\n";
+    auto first = client->sendOfferAsync(testOffer);
+    auto second = client->sendOfferAsync(testOffer);
+
+    // Let the first POST start, then disconnect while it is in flight
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    client->disconnect();
+
+    EXPECT_EQ(first.wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    EXPECT_NO_THROW(first.get());
+    EXPECT_THROW(second.get(), std::future_error);
+    EXPECT_FALSE(client->isConnected());
+}
@@ -0,0 +1,355 @@
+/**
+ * @file yuv_converter_test.cpp
+ * @brief Unit tests for the YUV to RGB kernels and the parallel converter
+ */
+
+#include <gtest/gtest.h>
+#include "core/yuv-converter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace obswebrtc::core;
+
+namespace {
+
+/**
+ * @brief A YUV picture with padded strides, in I420 and NV12 layouts
+ */
+struct TestPicture {
+    TestPicture(uint32_t width, uint32_t height, uint32_t seed = 1)
+        : width(width)
+        , height(height)
+        , chromaWidth((width + 1) / 2)
+        , chromaHeight((height + 1) / 2)
+        , yStride(width + 13)
+        , chromaStride(chromaWidth + 7)
+        , y(yStride * height)
+        , u(chromaStride * chromaHeight)
+        , v(chromaStride * chromaHeight)
+        , uv(2 * chromaStride * chromaHeight) {
+        std::mt19937 random(seed);
+        for (uint8_t& sample : y) {
+            sample = static_cast<uint8_t>(random());
+        }
+        for (size_t i = 0; i < u.size(); i++) {
+            u[i] = static_cast<uint8_t>(random());
+            v[i] = static_cast<uint8_t>(random());
+        }
+        for (size_t row = 0; row < chromaHeight; row++) {
+            for (size_t x = 0; x < chromaWidth; x++) {
+                uv[row * 2 * chromaStride + 2 * x] = u[row * chromaStride + x];
+                uv[row * 2 * chromaStride + 2 * x + 1] = v[row * chromaStride + x];
+            }
+        }
+    }
+
+    YuvImage image(YuvFormat format) const {
+        YuvImage image;
+        image.width = width;
+        image.height = height;
+        image.format = format;
+        image.planes[0] = y.data();
+        image.strides[0] = yStride;
+        if (format == YuvFormat::I420) {
+            image.planes[1] = u.data();
+            image.planes[2] = v.data();
+            image.strides[1] = chromaStride;
+            image.strides[2] = chromaStride;
+        } else {
+            image.planes[1] = uv.data();
+            image.strides[1] = 2 * chromaStride;
+        }
+        return image;
+    }
+
+    uint32_t width;
+    uint32_t height;
+    size_t chromaWidth;
+    size_t chromaHeight;
+    size_t yStride;
+    size_t chromaStride;
+    std::vector<uint8_t> y;
+    std::vector<uint8_t> u;
+    std::vector<uint8_t> v;
+    std::vector<uint8_t> uv;
+};
+
+/**
+ * @brief Every matrix, range and byte order
+ */
+std::vector<RgbConversion> allConversions() {
+    std::vector<RgbConversion> conversions;
+    for (YuvMatrix matrix : {YuvMatrix::BT601, YuvMatrix::BT709}) {
+        for (bool fullRange : {false, true}) {
+            for (RgbFormat format : {RgbFormat::RGBA, RgbFormat::BGRA}) {
+                RgbConversion conversion;
+                conversion.matrix = matrix;
+                conversion.fullRange = fullRange;
+                conversion.format = format;
+                conversions.push_back(conversion);
+            }
+        }
+    }
+    return conversions;
+}
+
+std::vector<SimdLevel> supportedLevels() {
+    std::vector<SimdLevel> levels;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+        if (isSimdLevelSupported(level)) {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+/**
+ * @brief Exact conversion of one pixel, R G B
+ */
+void referencePixel(uint8_t y, uint8_t u, uint8_t v, const RgbConversion& conversion,
+                    double rgb[3]) {
+    const bool bt601 = conversion.matrix == YuvMatrix::BT601;
+    const double kr = bt601 ? 0.299 : 0.2126;
+    const double kb = bt601 ? 0.114 : 0.0722;
+    const double kg = 1.0 - kr - kb;
+    const double luma = conversion.fullRange ? y : (y - 16.0) * 255.0 / 219.0;
+    const double scale = conversion.fullRange ? 1.0 : 255.0 / 224.0;
+    const double cb = (u - 128.0) * scale;
+    const double cr = (v - 128.0) * scale;
+    rgb[0] = luma + 2.0 * (1.0 - kr) * cr;
+    rgb[1] = luma - 2.0 * (1.0 - kb) * kb / kg * cb - 2.0 * (1.0 - kr) * kr / kg * cr;
+    rgb[2] = luma + 2.0 * (1.0 - kb) * cb;
+    for (int channel = 0; channel < 3; channel++) {
+        rgb[channel] = std::min(std::max(rgb[channel], 0.0), 255.0);
+    }
+}
+
+std::vector<uint8_t> convert(const YuvImage& image, const RgbConversion& conversion,
+                             SimdLevel level, size_t stride) {
+    std::vector<uint8_t> rgb(stride * image.height, 0xAB);
+    convertYuvToRgb(image, conversion, rgb.data(), stride, level);
+    return rgb;
+}
+
+}  // namespace
+
+TEST(YuvConverterTest, KernelsMatchScalarReference) {
+    // Every tail length after the 16-pixel vector loops, odd heights included
+    for (uint32_t width = 1; width <= 70; width++) {
+        const TestPicture picture(width, 5, width);
+        for (YuvFormat format : {YuvFormat::I420, YuvFormat::NV12}) {
+            const YuvImage image = picture.image(format);
+            for (const RgbConversion& conversion : allConversions()) {
+                const size_t stride = width * 4 + 12;
+                const std::vector<uint8_t> expected =
+                    convert(image, conversion, SimdLevel::Scalar, stride);
+                for (SimdLevel level : supportedLevels()) {
+                    ASSERT_EQ(convert(image, conversion, level, stride), expected)
+                        << simdLevelName(level) << ", width " << width;
+                }
+            }
+        }
+    }
+}
+
+TEST(YuvConverterTest, MatchesExactConversion) {
+    const TestPicture picture(64, 64);
+    const YuvImage image = picture.image(YuvFormat::I420);
+    for (const RgbConversion& conversion : allConversions()) {
+        const std::vector<uint8_t> rgb(convert(image, conversion, SimdLevel::Scalar, 64 * 4));
+        const bool bgra = conversion.format == RgbFormat::BGRA;
+
+        double maxError = 0.0;
+        for (uint32_t row = 0; row < 64; row++) {
+            for (uint32_t x = 0; x < 64; x++) {
+                const size_t chroma = (row / 2) * picture.chromaStride + x / 2;
+                double expected[3];
+                referencePixel(picture.y[row * picture.yStride + x], picture.u[chroma],
+                               picture.v[chroma], conversion, expected);
+                const uint8_t* pixel = rgb.data() + (row * 64 + x) * 4;
+                maxError = std::max({maxError, std::fabs(pixel[bgra ? 2 : 0] - expected[0]),
+                                     std::fabs(pixel[1] - expected[1]),
+                                     std::fabs(pixel[bgra ? 0 : 2] - expected[2])});
+                ASSERT_EQ(pixel[3], 255);
+            }
+        }
+        EXPECT_LE(maxError, 2.0) << "BT." << (conversion.matrix == YuvMatrix::BT601 ? 601 : 709)
+                                 << (conversion.fullRange ? " full" : " limited");
+    }
+}
+
+TEST(YuvConverterTest, ConvertsReferenceColors) {
+    struct Case {
+        uint8_t y, u, v;
+        YuvMatrix matrix;
+        bool fullRange;
+        uint8_t r, g, b;
+    };
+    const Case cases[] = {
+        {16, 128, 128, YuvMatrix::BT709, false, 0, 0, 0},        // Black
+        {235, 128, 128, YuvMatrix::BT709, false, 255, 255, 255},  // White
+        {0, 128, 128, YuvMatrix::BT601, true, 0, 0, 0},
+        {255, 128, 128, YuvMatrix::BT601, true, 255, 255, 255},
+        {126, 128, 128, YuvMatrix::BT709, false, 128, 128, 128},  // Mid grey
+        {81, 90, 240, YuvMatrix::BT601, false, 255, 0, 0},        // Red
+        {145, 54, 34, YuvMatrix::BT601, false, 0, 255, 0},        // Green
+        {41, 240, 110, YuvMatrix::BT601, false, 0, 0, 255},       // Blue
+        {63, 102, 240, YuvMatrix::BT709, false, 255, 0, 0},
+        {173, 42, 26, YuvMatrix::BT709, false, 0, 255, 0},
+        {32, 240, 118, YuvMatrix::BT709, false, 0, 0, 255},
+    };
+
+    for (const Case& test : cases) {
+        // Wide enough for the vector loops of every kernel
+        std::vector<uint8_t> y(32, test.y);
+        std::vector<uint8_t> u(16, test.u);
+        std::vector<uint8_t> v(16, test.v);
+        YuvImage image;
+        image.width = 32;
+        image.height = 1;
+        image.planes[0] = y.data();
+        image.planes[1] = u.data();
+        image.planes[2] = v.data();
+        image.strides[0] = 32;
+        image.strides[1] = 16;
+        image.strides[2] = 16;
+        RgbConversion conversion;
+        conversion.matrix = test.matrix;
+        conversion.fullRange = test.fullRange;
+
+        std::vector<uint8_t> rgba(32 * 4);
+        convertYuvToRgb(image, conversion, rgba.data(), rgba.size());
+        for (size_t x = 0; x < 32; x++) {
+            SCOPED_TRACE(testing::Message() << "YUV " << int(test.y) << "," << int(test.u) << ","
+                                            << int(test.v) << " pixel " << x);
+            EXPECT_NEAR(rgba[4 * x], test.r, 2);
+            EXPECT_NEAR(rgba[4 * x + 1], test.g, 2);
+            EXPECT_NEAR(rgba[4 * x + 2], test.b, 2);
+            EXPECT_EQ(rgba[4 * x + 3], 255);
+        }
+    }
+}
+
+TEST(YuvConverterTest, Nv12MatchesI420AndBgraSwapsChannels) {
+    const TestPicture picture(37, 9);
+    RgbConversion rgbaConversion;
+    RgbConversion bgraConversion;
+    bgraConversion.format = RgbFormat::BGRA;
+
+    std::vector<uint8_t> i420(37 * 4 * 9);
+    std::vector<uint8_t> nv12(i420.size());
+    std::vector<uint8_t> bgra(i420.size());
+    convertYuvToRgb(picture.image(YuvFormat::I420), rgbaConversion, i420.data(), 37 * 4);
+    convertYuvToRgb(picture.image(YuvFormat::NV12), rgbaConversion, nv12.data(), 37 * 4);
+    convertYuvToRgb(picture.image(YuvFormat::NV12), bgraConversion, bgra.data(), 37 * 4);
+
+    EXPECT_EQ(nv12, i420);
+    for (size_t pixel = 0; pixel < i420.size(); pixel += 4) {
+        ASSERT_EQ(bgra[pixel], i420[pixel + 2]);
+        ASSERT_EQ(bgra[pixel + 1], i420[pixel + 1]);
+        ASSERT_EQ(bgra[pixel + 2], i420[pixel]);
+        ASSERT_EQ(bgra[pixel + 3], 255);
+    }
+}
+
+TEST(YuvConverterTest, LeavesStridePaddingAlone) {
+    const TestPicture picture(20, 4);
+    const size_t stride = 20 * 4 + 16;
+    const std::vector<uint8_t> rgb =
+        convert(picture.image(YuvFormat::NV12), RgbConversion(), SimdLevel::Scalar, stride);
+    for (size_t row = 0; row < 4; row++) {
+        for (size_t i = 20 * 4; i < stride; i++) {
+            ASSERT_EQ(rgb[row * stride + i], 0xAB) << "row " << row << " byte " << i;
+        }
+    }
+}
+
+TEST(YuvConverterTest, RejectsInvalidArguments) {
+    const TestPicture picture(16, 2);
+    std::vector<uint8_t> rgba(16 * 4 * 2);
+    const RgbConversion conversion;
+
+    YuvImage empty = picture.image(YuvFormat::I420);
+    empty.height = 0;
+    EXPECT_THROW(convertYuvToRgb(empty, conversion, rgba.data(), 64), std::invalid_argument);
+
+    YuvImage noV = picture.image(YuvFormat::I420);
+    noV.planes[2] = nullptr;
+    EXPECT_THROW(convertYuvToRgb(noV, conversion, rgba.data(), 64), std::invalid_argument);
+    noV.format = YuvFormat::NV12;  // Only two planes needed, but the UV stride is too small
+    EXPECT_THROW(convertYuvToRgb(noV, conversion, rgba.data(), 64), std::invalid_argument);
+
+    YuvImage narrow = picture.image(YuvFormat::I420);
+    narrow.strides[0] = 15;
+    EXPECT_THROW(convertYuvToRgb(narrow, conversion, rgba.data(), 64), std::invalid_argument);
+
+    const YuvImage image = picture.image(YuvFormat::I420);
+    EXPECT_THROW(convertYuvToRgb(image, conversion, nullptr, 64), std::invalid_argument);
+    EXPECT_THROW(convertYuvToRgb(image, conversion, rgba.data(), 63), std::invalid_argument);
+
+    YuvConverter converter(2);
+    EXPECT_THROW(converter.convert(empty, conversion, rgba.data(), 64), std::invalid_argument);
+
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+        if (!isSimdLevelSupported(level)) {
+            EXPECT_THROW(convertYuvToRgb(image, conversion, rgba.data(), 64, level),
+                         std::invalid_argument);
+        }
+    }
+}
+
+TEST(YuvConverterTest, ParallelConversionMatchesSingleThreaded) {
+    // 4K, and a size whose rows do not split evenly into bands
+    for (const auto& size : {std::make_pair(3840u, 2160u), std::make_pair(1001u, 1999u)}) {
+        const TestPicture picture(size.first, size.second);
+        for (YuvFormat format : {YuvFormat::I420, YuvFormat::NV12}) {
+            const YuvImage image = picture.image(format);
+            const size_t stride = size.first * 4;
+            std::vector<uint8_t> expected(stride * size.second);
+            convertYuvToRgb(image, RgbConversion(), expected.data(), stride);
+
+            for (size_t threads : {1u, 3u, 8u}) {
+                YuvConverter converter(threads);
+                EXPECT_EQ(converter.getThreadCount(), threads);
+                // Twice: the helpers must pick up the second job too
+                for (int repeat = 0; repeat < 2; repeat++) {
+                    std::vector<uint8_t> rgba(expected.size());
+                    converter.convert(image, RgbConversion(), rgba.data(), stride);
+                    ASSERT_EQ(rgba, expected) << threads << " threads, " << size.first << "x"
+                                              << size.second;
+                }
+            }
+        }
+    }
+}
+
+TEST(YuvConverterTest, ConverterLimitsThreadsAndSerializesCallers) {
+    EXPECT_EQ(YuvConverter(100).getThreadCount(), constants::kMaxYuvConvertThreads);
+    EXPECT_GE(YuvConverter().getThreadCount(), 1u);
+
+    const TestPicture picture(1920, 1080);
+    const YuvImage image = picture.image(YuvFormat::I420);
+    std::vector<uint8_t> expected(1920 * 4 * 1080);
+    convertYuvToRgb(image, RgbConversion(), expected.data(), 1920 * 4);
+
+    YuvConverter converter(4);
+    std::vector<uint8_t> first(expected.size());
+    std::vector<uint8_t> second(expected.size());
+    std::thread other([&]() {
+        for (int i = 0; i < 5; i++) {
+            converter.convert(image, RgbConversion(), second.data(), 1920 * 4);
+        }
+    });
+    for (int i = 0; i < 5; i++) {
+        converter.convert(image, RgbConversion(), first.data(), 1920 * 4);
+    }
+    other.join();
+    EXPECT_EQ(first, expected);
+    EXPECT_EQ(second, expected);
+}